@@ -106,6 +106,22 @@ if(BUILD_TUTORIALS)
   endif()
 endif()
 
+# ----------------------------------------------------------------------------
+#   Benchmark target, for make visp_benchmark
+#   Runs the core kernels benchmark suite and writes visp-benchmark.json
+# ----------------------------------------------------------------------------
+if(BUILD_TESTS AND WITH_CATCH2)
+  add_custom_target(visp_benchmark
+    COMMAND perfCoreKernels --benchmark --json "${CMAKE_BINARY_DIR}/visp-benchmark.json"
+    WORKING_DIRECTORY "${CMAKE_BINARY_DIR}"
+    COMMENT "Running the core kernels benchmark suite"
+    VERBATIM
+  )
+  if(ENABLE_SOLUTION_FOLDERS)
+    set_target_properties(visp_benchmark PROPERTIES FOLDER "extra")
+  endif()
+endif()
+
 # ----------------------------------------------------------------------------
 #   Target building all ViSP modules
 # ----------------------------------------------------------------------------
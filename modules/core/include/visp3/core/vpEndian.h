@@ -99,7 +99,7 @@ VISP_EXPORT float swapFloat(float f);
 
 VISP_EXPORT double swapDouble(double d);
 
-VISP_EXPORT uint16_t reinterpret_cast_uchar_to_uint16_LE(unsigned char * const ptr);
+VISP_EXPORT uint16_t reinterpret_cast_uchar_to_uint16_LE(const unsigned char *const ptr);
 }
 
 #endif
@@ -95,6 +95,7 @@ class VISP_EXPORT vpExponentialMap
 public:
   static vpHomogeneousMatrix direct(const vpColVector &v);
   static vpHomogeneousMatrix direct(const vpColVector &v, const double &delta_t);
+  static void direct(const vpColVector &v, const double &delta_t, vpHomogeneousMatrix &Delta);
   static vpColVector inverse(const vpHomogeneousMatrix &M);
   static vpColVector inverse(const vpHomogeneousMatrix &M, const double &delta_t);
 };
@@ -239,6 +239,8 @@ public:
   };
 
   void calculate(const vpImage<unsigned char> &I, unsigned int nbins = 256, unsigned int nbThreads = 1);
+  static void calculateRegion(const vpImage<unsigned char> &I, unsigned int top, unsigned int left,
+                              unsigned int height, unsigned int width, unsigned int *histogram);
 
   void display(const vpImage<unsigned char> &I, const vpColor &color = vpColor::white, unsigned int thickness = 2,
                unsigned int maxValue_ = 0);
@@ -48,6 +48,7 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpEndian.h>
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpImageAllocator.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpRGBa.h>
@@ -56,10 +57,12 @@
 #include <visp3/core/vpThread.h>
 #endif
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip> // std::setw
 #include <iostream>
 #include <math.h>
+#include <new>
 #include <string.h>
 
 // Visual Studio 2010 or previous is missing inttypes.h
@@ -96,6 +99,25 @@ class vpDisplay;
   if i is the ith rows and j the jth columns the value of this pixel
   is given by I[i][j] (that is equivalent to row[i][j]).
 
+  <h3>Memory layout</h3>
+
+  By default the rows are stored one after the other, so that the bitmap is a
+  continuous array of width*height elements. Two consecutive rows may
+  nevertheless be separated by a stride larger than the width:
+  - when a row alignment is requested with setRowAlignment(), each row starts
+    on an address multiple of the alignment, which suits SIMD processing;
+  - when the image is a view on a region of interest of another image, see
+    initView(), or on external memory with a pitch, see
+    init(Type *const, unsigned int, unsigned int, unsigned int, bool).
+
+  The stride is given by getStride(). Row access with I[i] or the row pointers
+  always works, whereas a linear access to the bitmap over getSize() elements
+  is only valid when isContiguous() returns true.
+
+  The bitmap is allocated with \c new[], unless an allocator is set with
+  setAllocator() to recycle the memory of the temporary images of a processing
+  loop, see vpImagePoolAllocator.
+
   <h3>Example</h3>
   The following example available in tutorial-image-manipulation.cpp shows how
   to create gray level and color images and how to access to the pixels.
@@ -226,6 +248,21 @@ public:
    */
   inline unsigned int getSize() const { return width * height; }
 
+  /*!
+    Get the number of elements between the beginning of two consecutive rows.
+    It is equal to the image width, unless the rows are aligned or the image
+    is a view on a larger image.
+
+    \sa isContiguous(), setRowAlignment()
+  */
+  inline unsigned int getStride() const { return stride; }
+
+  /*!
+    Get the row alignment in bytes requested with setRowAlignment(), 0 if
+    none.
+  */
+  inline unsigned int getRowAlignment() const { return rowAlignment; }
+
   // Gets the value of a pixel at a location.
   Type getValue(unsigned int i, unsigned int j) const;
   // Gets the value of a pixel at a location with bilinear interpolation.
@@ -254,8 +291,18 @@ public:
   void init(unsigned int height, unsigned int width, Type value);
   //! init from an image stored as a continuous array in memory
   void init(Type *const array, unsigned int height, unsigned int width, bool copyData = false);
+  //! init from an image stored in memory with a given stride between rows
+  void init(Type *const array, unsigned int height, unsigned int width, unsigned int stride, bool copyData);
+  void initView(vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int height, unsigned int width);
   void insert(const vpImage<Type> &src, const vpImagePoint &topLeft);
 
+  /*!
+    Return true if the rows are stored one after the other without padding,
+    that is if the bitmap can be accessed as a continuous array of getSize()
+    elements.
+  */
+  inline bool isContiguous() const { return stride == width || height <= 1; }
+
   //------------------------------------------------------------------
   //         Acces to the image
 
@@ -273,13 +320,13 @@ public:
 
     \return Value of the image point (i, j).
   */
-  inline Type operator()(unsigned int i, unsigned int j) const { return bitmap[i * width + j]; }
+  inline Type operator()(unsigned int i, unsigned int j) const { return row[i][j]; }
 
   /*!
     Set the value \e v of an image point with coordinates (i, j), with i the
     row position and j the column position.
   */
-  inline void operator()(unsigned int i, unsigned int j, const Type &v) { bitmap[i * width + j] = v; }
+  inline void operator()(unsigned int i, unsigned int j, const Type &v) { row[i][j] = v; }
 
   /*!
     Get the value of an image point.
@@ -296,7 +343,7 @@ public:
     unsigned int i = (unsigned int)ip.get_i();
     unsigned int j = (unsigned int)ip.get_j();
 
-    return bitmap[i * width + j];
+    return row[i][j];
   }
 
   /*!
@@ -312,7 +359,7 @@ public:
     unsigned int i = (unsigned int)ip.get_i();
     unsigned int j = (unsigned int)ip.get_j();
 
-    bitmap[i * width + j] = v;
+    row[i][j] = v;
   }
 
   vpImage<Type> operator-(const vpImage<Type> &B);
@@ -340,6 +387,9 @@ public:
   // set the size of the image and initialize it.
   void resize(unsigned int h, unsigned int w, const Type &val);
 
+  void setAllocator(vpImageAllocator *allocator);
+  void setRowAlignment(unsigned int alignment);
+
   void sub(const vpImage<Type> &B, vpImage<Type> &C);
   void sub(const vpImage<Type> &A, const vpImage<Type> &B, vpImage<Type> &C);
   void subsample(unsigned int v_scale, unsigned int h_scale, vpImage<Type> &sampled) const;
@@ -349,11 +399,21 @@ public:
   //@}
 
 private:
+  void allocateBitmap();
+  unsigned int computeStride(unsigned int w) const;
+  void freeBitmap();
+  void initRows();
+
   unsigned int npixels; ///! number of pixel in the image
   unsigned int width;   ///! number of columns
   unsigned int height;  ///! number of rows
   Type **row;           ///! points the row pointer array
   bool hasOwnership;    ///! true if this instance owns the bitmap, false otherwise (e.g. copyData=false)
+  unsigned int stride;  ///! number of elements between two consecutive rows
+  unsigned int rowAlignment;        ///! requested row alignment in bytes, 0 if none
+  vpImageAllocator *allocator;      ///! allocator used for the next bitmap allocations, NULL for new[]
+  vpImageAllocator *bitmapAllocator; ///! allocator of the owned bitmap, NULL if allocated with new[]
+  size_t bitmapSize;                ///! size in bytes of the owned bitmap
 };
 
 template <class Type> std::ostream &operator<<(std::ostream &s, const vpImage<Type> &I)
@@ -642,9 +702,13 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w, T
 {
   init(h, w);
 
-  //  for (unsigned int i = 0; i < npixels; i++)
-  //    bitmap[i] = value;
-  std::fill(bitmap, bitmap + npixels, value);
+  if (isContiguous()) {
+    std::fill(bitmap, bitmap + npixels, value);
+  } else {
+    for (unsigned int i = 0; i < height; i++) {
+      std::fill(row[i], row[i] + width, value);
+    }
+  }
 }
 
 /*!
@@ -674,14 +738,11 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
     }
   }
 
-  if ((h != this->height) || (w != this->width)) {
-    if (bitmap != NULL) {
-      vpDEBUG_TRACE(10, "Destruction bitmap[]");
-      if (hasOwnership) {
-        delete[] bitmap;
-      }
-      bitmap = NULL;
-    }
+  // Reallocate when the size changes, or when the requested row alignment
+  // leads to another stride
+  if ((h != this->height) || (w != this->width) || (hasOwnership && computeStride(w) != stride)) {
+    vpDEBUG_TRACE(10, "Destruction bitmap[]");
+    freeBitmap();
   }
 
   this->width = w;
@@ -690,12 +751,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
   npixels = width * height;
 
   if (bitmap == NULL) {
-    bitmap = new Type[npixels];
-    hasOwnership = true;
-  }
-
-  if (bitmap == NULL) {
-    throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
+    allocateBitmap();
   }
 
   if (row == NULL)
@@ -704,8 +760,7 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
     throw(vpException(vpException::memoryAllocationError, "cannot allocate row "));
   }
 
-  for (unsigned int i = 0; i < height; i++)
-    row[i] = bitmap + i * width;
+  initRows();
 }
 
 /*!
@@ -724,6 +779,36 @@ template <class Type> void vpImage<Type>::init(unsigned int h, unsigned int w)
 template <class Type>
 void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool copyData)
 {
+  init(array, h, w, w, copyData);
+}
+
+/*!
+  \brief Image initialization
+
+  Init from image data stored in memory with a stride between the beginning
+  of two consecutive rows, as for instance the buffers of some frame grabbers
+  whose rows are padded.
+
+  \param array : Image data, the element (i, j) being at array[i * s + j].
+  \param h : Image height.
+  \param w : Image width.
+  \param s : Number of elements between two consecutive rows, greater or
+  equal to \e w.
+  \param copyData : If false only the memory address is copied and the image
+  keeps the stride \e s, otherwise the data are copied in a bitmap owned by
+  the image.
+
+  \exception vpException::dimensionError : If the stride is lower than the
+  width.
+  \exception vpException::memoryAllocationError
+*/
+template <class Type>
+void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, unsigned int s, bool copyData)
+{
+  if (s < w) {
+    throw(vpException(vpException::dimensionError, "Stride %u lower than the image width %u", s, w));
+  }
+
   if (h != this->height) {
     if (row != NULL) {
       delete[] row;
@@ -731,17 +816,11 @@ void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool
     }
   }
 
-  // Delete bitmap if copyData==false, otherwise only if the dimension differs
-  if ((copyData && ((h != this->height) || (w != this->width))) || !copyData) {
-    if (bitmap != NULL) {
-      if (hasOwnership) {
-        delete[] bitmap;
-      }
-      bitmap = NULL;
-    }
+  // Delete bitmap if copyData==false, otherwise only if it cannot be reused
+  if (!copyData || !hasOwnership || (h != this->height) || (w != this->width) || computeStride(w) != stride) {
+    freeBitmap();
   }
 
-  hasOwnership = copyData;
   this->width = w;
   this->height = h;
 
@@ -749,17 +828,27 @@ void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool
 
   if (copyData) {
     if (bitmap == NULL)
-      bitmap = new Type[npixels];
+      allocateBitmap();
 
     if (bitmap == NULL) {
       throw(vpException(vpException::memoryAllocationError, "cannot allocate bitmap "));
     }
 
-    // Copy the image data
-    memcpy(static_cast<void*>(bitmap), static_cast<void*>(array), (size_t)(npixels * sizeof(Type)));
+    // Copy the image data, without reading past the end of the last row
+    if (s == stride && height > 0) {
+      memcpy(static_cast<void *>(bitmap), static_cast<void *>(array),
+             ((size_t)(height - 1) * stride + width) * sizeof(Type));
+    } else {
+      for (unsigned int i = 0; i < height; i++) {
+        memcpy(static_cast<void *>(bitmap + (size_t)i * stride), static_cast<void *>(array + (size_t)i * s),
+               (size_t)width * sizeof(Type));
+      }
+    }
   } else {
     // Copy the address of the array in the bitmap
     bitmap = array;
+    hasOwnership = false;
+    stride = s;
   }
 
   if (row == NULL)
@@ -768,9 +857,45 @@ void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool
     throw(vpException(vpException::memoryAllocationError, "cannot allocate row "));
   }
 
-  for (unsigned int i = 0; i < height; i++) {
-    row[i] = bitmap + i * width;
+  initRows();
+}
+
+/*!
+  \brief Image initialization
+
+  Make the image a view on a region of interest of another image, without
+  copying the data. The pixels of the view are shared with \e I, so that
+  modifying one modifies the other. The view keeps the stride of \e I and
+  must not be used after \e I has been resized or destroyed.
+
+  \code
+  vpImage<unsigned char> I(480, 640, 0);
+  vpImage<unsigned char> roi;
+  roi.initView(I, 100, 200, 50, 80); // 50x80 region with top-left corner at (100, 200)
+  roi = 255;                         // Modifies the pixels of I
+  \endcode
+
+  \param I : Image on which the view is made.
+  \param top : Row of the top-left corner of the region in \e I.
+  \param left : Column of the top-left corner of the region in \e I.
+  \param h : Height of the region.
+  \param w : Width of the region.
+
+  \exception vpException::dimensionError : If the region is not inside \e I.
+  \exception vpException::badValue : If \e I is the image itself.
+*/
+template <class Type>
+void vpImage<Type>::initView(vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int h, unsigned int w)
+{
+  if (&I == this) {
+    throw(vpException(vpException::badValue, "Cannot make a view on the image itself"));
+  }
+  if ((top + h > I.height) || (left + w > I.width)) {
+    throw(vpException(vpException::dimensionError, "Region (%u, %u) of size %ux%u outside of the %ux%u image", top,
+                      left, w, h, I.width, I.height));
   }
+
+  init(I.bitmap + (size_t)top * I.stride + left, h, w, I.stride, false);
 }
 
 /*!
@@ -793,7 +918,8 @@ void vpImage<Type>::init(Type *const array, unsigned int h, unsigned int w, bool
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true),
+    stride(0), rowAlignment(0), allocator(NULL), bitmapAllocator(NULL), bitmapSize(0)
 {
   init(h, w, 0);
 }
@@ -817,7 +943,8 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w)
 */
 template <class Type>
 vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true),
+    stride(0), rowAlignment(0), allocator(NULL), bitmapAllocator(NULL), bitmapSize(0)
 {
   init(h, w, value);
 }
@@ -839,7 +966,8 @@ vpImage<Type>::vpImage(unsigned int h, unsigned int w, Type value)
 */
 template <class Type>
 vpImage<Type>::vpImage(Type *const array, unsigned int h, unsigned int w, bool copyData)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true),
+    stride(0), rowAlignment(0), allocator(NULL), bitmapAllocator(NULL), bitmapSize(0)
 {
   init(array, h, w, copyData);
 }
@@ -854,7 +982,8 @@ vpImage<Type>::vpImage(Type *const array, unsigned int h, unsigned int w, bool c
   \sa vpImage::resize(height, width) for memory allocation
 */
 template <class Type> vpImage<Type>::vpImage() :
-  bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true),
+  stride(0), rowAlignment(0), allocator(NULL), bitmapAllocator(NULL), bitmapSize(0)
 {
 }
 
@@ -911,14 +1040,7 @@ template <class Type> void vpImage<Type>::destroy()
 {
   //   vpERROR_TRACE("Deallocate ");
 
-  if (bitmap != NULL) {
-    //  vpERROR_TRACE("Deallocate bitmap memory %p",bitmap);
-    //    vpDEBUG_TRACE(20,"Deallocate bitmap memory %p",bitmap);
-    if (hasOwnership) {
-      delete[] bitmap;
-    }
-    bitmap = NULL;
-  }
+  freeBitmap();
 
   if (row != NULL) {
     //   vpERROR_TRACE("Deallocate row memory %p",row);
@@ -941,10 +1063,17 @@ template <class Type> vpImage<Type>::~vpImage() { destroy(); }
 */
 template <class Type>
 vpImage<Type>::vpImage(const vpImage<Type> &I)
-  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true)
+  : bitmap(NULL), display(NULL), npixels(0), width(0), height(0), row(NULL), hasOwnership(true),
+    stride(0), rowAlignment(I.rowAlignment), allocator(NULL), bitmapAllocator(NULL), bitmapSize(0)
 {
   resize(I.getHeight(), I.getWidth());
-  memcpy(static_cast<void*>(bitmap), static_cast<void*>(I.bitmap), I.npixels * sizeof(Type));
+  if (isContiguous() && I.isContiguous()) {
+    memcpy(static_cast<void*>(bitmap), static_cast<void*>(I.bitmap), I.npixels * sizeof(Type));
+  } else {
+    for (unsigned int i = 0; i < height; i++) {
+      memcpy(static_cast<void *>(row[i]), static_cast<void *>(I.row[i]), (size_t)width * sizeof(Type));
+    }
+  }
 }
 
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
@@ -953,7 +1082,8 @@ vpImage<Type>::vpImage(const vpImage<Type> &I)
 */
 template <class Type>
 vpImage<Type>::vpImage(vpImage<Type> &&I)
-  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row), hasOwnership(I.hasOwnership)
+  : bitmap(I.bitmap), display(I.display), npixels(I.npixels), width(I.width), height(I.height), row(I.row), hasOwnership(I.hasOwnership),
+    stride(I.stride), rowAlignment(I.rowAlignment), allocator(I.allocator), bitmapAllocator(I.bitmapAllocator), bitmapSize(I.bitmapSize)
 {
   I.bitmap = NULL;
   I.display = NULL;
@@ -962,6 +1092,9 @@ vpImage<Type>::vpImage(vpImage<Type> &&I)
   I.height = 0;
   I.row = NULL;
   I.hasOwnership = false;
+  I.stride = 0;
+  I.bitmapAllocator = NULL;
+  I.bitmapSize = 0;
 }
 #endif
 
@@ -975,9 +1108,12 @@ template <class Type> Type vpImage<Type>::getMaxValue() const
   if (npixels == 0)
     throw(vpException(vpException::fatalError, "Cannot compute maximum value of an empty image"));
   Type m = bitmap[0];
-  for (unsigned int i = 0; i < npixels; i++) {
-    if (bitmap[i] > m)
-      m = bitmap[i];
+  for (unsigned int i = 0; i < height; i++) {
+    const Type *r = row[i];
+    for (unsigned int j = 0; j < width; j++) {
+      if (r[j] > m)
+        m = r[j];
+    }
   }
   return m;
 }
@@ -1003,9 +1139,13 @@ template <class Type> Type vpImage<Type>::getMinValue() const
   if (npixels == 0)
     throw(vpException(vpException::fatalError, "Cannot compute minimum value of an empty image"));
   Type m = bitmap[0];
-  for (unsigned int i = 0; i < npixels; i++)
-    if (bitmap[i] < m)
-      m = bitmap[i];
+  for (unsigned int i = 0; i < height; i++) {
+    const Type *r = row[i];
+    for (unsigned int j = 0; j < width; j++) {
+      if (r[j] < m)
+        m = r[j];
+    }
+  }
   return m;
 }
 
@@ -1022,11 +1162,14 @@ template <class Type> void vpImage<Type>::getMinMaxValue(Type &min, Type &max) c
     throw(vpException(vpException::fatalError, "Cannot get minimum/maximum values of an empty image"));
 
   min = max = bitmap[0];
-  for (unsigned int i = 0; i < npixels; i++) {
-    if (bitmap[i] < min)
-      min = bitmap[i];
-    if (bitmap[i] > max)
-      max = bitmap[i];
+  for (unsigned int i = 0; i < height; i++) {
+    const Type *r = row[i];
+    for (unsigned int j = 0; j < width; j++) {
+      if (r[j] < min)
+        min = r[j];
+      if (r[j] > max)
+        max = r[j];
+    }
   }
 }
 
@@ -1092,7 +1235,18 @@ void vpImage<Type>::getMinMaxLoc(vpImagePoint *minLoc, vpImagePoint *maxLoc, Typ
 */
 template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> other)
 {
-  swap(*this, other);
+  if (allocator == NULL && rowAlignment <= 1 && other.isContiguous()) {
+    swap(*this, other);
+  } else {
+    // Copy the pixels in a bitmap that respects the allocator and the row
+    // alignment of this image
+    resize(other.height, other.width);
+    for (unsigned int i = 0; i < height; i++) {
+      std::copy(other.row[i], other.row[i] + width, row[i]);
+    }
+    using std::swap;
+    swap(display, other.display);
+  }
   // Swap back display pointer if it was not null
   // vpImage<unsigned char> I2(480, 640);
   // vpDisplayX d(I2);
@@ -1111,8 +1265,11 @@ template <class Type> vpImage<Type> &vpImage<Type>::operator=(vpImage<Type> othe
 */
 template <class Type> vpImage<Type> &vpImage<Type>::operator=(const Type &v)
 {
-  for (unsigned int i = 0; i < npixels; i++)
-    bitmap[i] = v;
+  for (unsigned int i = 0; i < height; i++) {
+    Type *r = row[i];
+    for (unsigned int j = 0; j < width; j++)
+      r[j] = v;
+  }
 
   return *this;
 }
@@ -1131,11 +1288,12 @@ template <class Type> bool vpImage<Type>::operator==(const vpImage<Type> &I)
 
   //  printf("wxh: %dx%d bitmap: %p I.bitmap %p\n", width, height, bitmap,
   //  I.bitmap);
-  for (unsigned int i = 0; i < npixels; i++) {
-    if (bitmap[i] != I.bitmap[i]) {
-      //      std::cout << "differ for pixel " << i << " (" << i%this->height
-      //      << ", " << i - i%this->height << ")" << std::endl;
-      return false;
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      if (row[i][j] != I.row[i][j]) {
+        //      std::cout << "differ for pixel (" << i << ", " << j << ")" << std::endl;
+        return false;
+      }
     }
   }
   return true;
@@ -1233,8 +1391,8 @@ template <class Type> void vpImage<Type>::insert(const vpImage<Type> &src, const
     hsize = src_h - src_ibegin;
 
   for (int i = 0; i < hsize; i++) {
-    Type *srcBitmap = src.bitmap + ((src_ibegin + i) * src_w + src_jbegin);
-    Type *destBitmap = this->bitmap + ((dest_ibegin + i) * dest_w + dest_jbegin);
+    Type *srcBitmap = src.row[src_ibegin + i] + src_jbegin;
+    Type *destBitmap = this->row[dest_ibegin + i] + dest_jbegin;
 
     memcpy(static_cast<void*>(destBitmap), static_cast<void*>(srcBitmap), (size_t)wsize * sizeof(Type));
   }
@@ -1530,15 +1688,15 @@ template <> inline unsigned char vpImage<unsigned char>::getValue(double i, doub
   int64_t y_ = y >> 16;
 
   if (y_ + 1 < height && x_ + 1 < width) {
-    uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(bitmap + y_ * width + x_);
-    uint16_t down = vpEndian::reinterpret_cast_uchar_to_uint16_LE(bitmap + (y_ + 1) * width + x_);
+    uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(row[y_] + x_);
+    uint16_t down = vpEndian::reinterpret_cast_uchar_to_uint16_LE(row[y_ + 1] + x_);
 
     return static_cast<unsigned char>((((up & 0x00FF) * rfrac + (down & 0x00FF) * rratio) * cfrac +
                                        ((up >> 8) * rfrac + (down >> 8) * rratio) * cratio) >> 32);
   } else if (y_ + 1 < height) {
     return static_cast<unsigned char>(((row[y_][x_] * rfrac + row[y_ + 1][x_] * rratio)) >> 16);
   } else if (x_ + 1 < width) {
-    uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(bitmap + y_ * width + x_);
+    uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(row[y_] + x_);
     return static_cast<unsigned char>(((up & 0x00FF) * cfrac + (up >> 8) * cratio) >> 16);
   } else {
     return row[y_][x_];
@@ -1658,8 +1816,11 @@ template <class Type> inline double vpImage<Type>::getSum() const
     return 0.0;
 
   double res = 0.0;
-  for (unsigned int i = 0; i < height * width; ++i) {
-    res += static_cast<double>(bitmap[i]);
+  for (unsigned int i = 0; i < height; ++i) {
+    const Type *r = row[i];
+    for (unsigned int j = 0; j < width; ++j) {
+      res += static_cast<double>(r[j]);
+    }
   }
   return res;
 }
@@ -1708,8 +1869,10 @@ template <class Type> void vpImage<Type>::sub(const vpImage<Type> &B, vpImage<Ty
     throw(vpException(vpException::memoryAllocationError, "vpImage mismatch in vpImage/vpImage substraction "));
   }
 
-  for (unsigned int i = 0; i < this->getWidth() * this->getHeight(); i++) {
-    *(C.bitmap + i) = *(bitmap + i) - *(B.bitmap + i);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      C.row[i][j] = row[i][j] - B.row[i][j];
+    }
   }
 }
 
@@ -1739,8 +1902,10 @@ template <class Type> void vpImage<Type>::sub(const vpImage<Type> &A, const vpIm
     throw(vpException(vpException::memoryAllocationError, "vpImage mismatch in vpImage/vpImage substraction "));
   }
 
-  for (unsigned int i = 0; i < A.getWidth() * A.getHeight(); i++) {
-    *(C.bitmap + i) = *(A.bitmap + i) - *(B.bitmap + i);
+  for (unsigned int i = 0; i < A.getHeight(); i++) {
+    for (unsigned int j = 0; j < A.getWidth(); j++) {
+      C.row[i][j] = A.row[i][j] - B.row[i][j];
+    }
   }
 }
 
@@ -1769,6 +1934,14 @@ template <class Type> void vpImage<Type>::performLut(const Type (&)[256], unsign
 */
 template <> inline void vpImage<unsigned char>::performLut(const unsigned char (&lut)[256], unsigned int nbThreads)
 {
+  if (!isContiguous()) {
+    for (unsigned int i = 0; i < height; i++) {
+      vpImage<unsigned char> I_row(row[i], 1, width);
+      I_row.performLut(lut, 1);
+    }
+    return;
+  }
+
   unsigned int size = getWidth() * getHeight();
   unsigned char *ptrStart = (unsigned char *)bitmap;
   unsigned char *ptrEnd = ptrStart + size;
@@ -1848,6 +2021,14 @@ template <> inline void vpImage<unsigned char>::performLut(const unsigned char (
 */
 template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa (&lut)[256], unsigned int nbThreads)
 {
+  if (!isContiguous()) {
+    for (unsigned int i = 0; i < height; i++) {
+      vpImage<vpRGBa> I_row(row[i], 1, width);
+      I_row.performLut(lut, 1);
+    }
+    return;
+  }
+
   unsigned int size = getWidth() * getHeight();
   unsigned char *ptrStart = (unsigned char *)bitmap;
   unsigned char *ptrEnd = ptrStart + size * 4;
@@ -1922,6 +2103,114 @@ template <> inline void vpImage<vpRGBa>::performLut(const vpRGBa (&lut)[256], un
   }
 }
 
+/*!
+  Set the allocator used for the next allocations of the bitmap, for instance
+  a vpImagePoolAllocator shared by the temporary images of a processing loop.
+  The current bitmap, if any, is kept.
+
+  \param alloc : Allocator, that must outlive the image. NULL restores the
+  default allocation with \c new[].
+
+  \sa setRowAlignment()
+*/
+template <class Type> void vpImage<Type>::setAllocator(vpImageAllocator *alloc) { allocator = alloc; }
+
+/*!
+  Request each row of the image to start on an address multiple of \e
+  alignment bytes, by padding the rows. The alignment is taken into account by
+  the next call to resize() or init(), that reallocates the bitmap if the stride
+  changes. Pixel values are then not preserved.
+
+  \code
+  vpImage<unsigned char> I;
+  I.setRowAlignment(32);
+  I.resize(480, 636); // getStride() returns 640
+  \endcode
+
+  \param alignment : Alignment in bytes, a power of two. 0 or 1 to store the
+  rows contiguously.
+
+  \exception vpException::badValue : If the alignment is not a power of two.
+
+  \sa getStride(), isContiguous()
+*/
+template <class Type> void vpImage<Type>::setRowAlignment(unsigned int alignment)
+{
+  if ((alignment & (alignment - 1)) != 0) {
+    throw(vpException(vpException::badValue, "Row alignment %u is not a power of two", alignment));
+  }
+  rowAlignment = alignment;
+}
+
+/*!
+  Allocate a bitmap of height rows of computeStride(width) elements, with
+  \c new[] or with the allocator of the image.
+*/
+template <class Type> void vpImage<Type>::allocateBitmap()
+{
+  stride = computeStride(width);
+  size_t size = (size_t)stride * height;
+
+  if (allocator == NULL && rowAlignment <= 1) {
+    bitmap = new Type[size];
+    bitmapAllocator = NULL;
+    bitmapSize = 0;
+  } else {
+    bitmapAllocator = (allocator != NULL) ? allocator : vpImageAllocator::getDefault();
+    bitmapSize = size * sizeof(Type);
+    bitmap = static_cast<Type *>(bitmapAllocator->allocate(bitmapSize, (std::max)(rowAlignment, 16u)));
+    for (size_t i = 0; i < size; i++) {
+      new (bitmap + i) Type;
+    }
+  }
+  hasOwnership = true;
+}
+
+/*!
+  Return the smallest stride greater or equal to \e w such that the rows
+  respect the requested row alignment.
+*/
+template <class Type> unsigned int vpImage<Type>::computeStride(unsigned int w) const
+{
+  unsigned int s = w;
+  if (rowAlignment > 1) {
+    while ((s * sizeof(Type)) % rowAlignment != 0) {
+      s++;
+    }
+  }
+  return s;
+}
+
+/*!
+  Release the bitmap if it is owned by the image.
+*/
+template <class Type> void vpImage<Type>::freeBitmap()
+{
+  if (bitmap != NULL && hasOwnership) {
+    if (bitmapAllocator != NULL) {
+      size_t size = bitmapSize / sizeof(Type);
+      for (size_t i = 0; i < size; i++) {
+        bitmap[i].~Type();
+      }
+      bitmapAllocator->deallocate(bitmap, bitmapSize);
+    } else {
+      delete[] bitmap;
+    }
+  }
+  bitmap = NULL;
+  bitmapAllocator = NULL;
+  bitmapSize = 0;
+}
+
+/*!
+  Update the row pointers from the bitmap and the stride.
+*/
+template <class Type> void vpImage<Type>::initRows()
+{
+  for (unsigned int i = 0; i < height; i++)
+    row[i] = bitmap + (size_t)i * stride;
+}
+
 template <class Type> void swap(vpImage<Type> &first, vpImage<Type> &second)
 {
   using std::swap;
@@ -1931,6 +2220,10 @@ template <class Type> void swap(vpImage<Type> &first, vpImage<Type> &second)
   swap(first.width, second.width);
   swap(first.height, second.height);
   swap(first.row, second.row);
+  swap(first.hasOwnership, second.hasOwnership);
+  swap(first.stride, second.stride);
+  swap(first.bitmapAllocator, second.bitmapAllocator);
+  swap(first.bitmapSize, second.bitmapSize);
 }
 
 #endif
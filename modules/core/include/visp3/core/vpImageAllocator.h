@@ -0,0 +1,165 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Image memory allocators.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImageAllocator_h_
+#define _vpImageAllocator_h_
+
+/*!
+  \file vpImageAllocator.h
+  \brief Image memory allocators.
+*/
+
+#include <stddef.h>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpMutex.h>
+
+/*!
+  \class vpImageAllocator
+
+  \ingroup group_core_image
+
+  \brief Interface of the allocators used by vpImage to allocate its bitmap.
+
+  An image uses an allocator when one is set with vpImage::setAllocator() or
+  when a row alignment is requested with vpImage::setRowAlignment(). Otherwise
+  the bitmap is allocated with \c new[] as usual.
+
+  The allocator must outlive the images that use it.
+
+  \sa vpImagePoolAllocator
+*/
+class VISP_EXPORT vpImageAllocator
+{
+public:
+  virtual ~vpImageAllocator() {}
+
+  /*!
+    Allocate a memory block.
+
+    \param size : Size of the block in bytes.
+    \param alignment : Alignment of the block in bytes, a power of two.
+
+    \return Pointer to the block.
+
+    \exception vpException::memoryAllocationError : If the allocation fails.
+  */
+  virtual void *allocate(size_t size, size_t alignment) = 0;
+
+  /*!
+    Release a memory block returned by allocate().
+
+    \param ptr : Pointer to the block.
+    \param size : Size of the block in bytes, as given to allocate().
+  */
+  virtual void deallocate(void *ptr, size_t size) = 0;
+
+  static void *alignedMalloc(size_t size, size_t alignment);
+  static void alignedFree(void *ptr);
+  static vpImageAllocator *getDefault();
+};
+
+/*!
+  \class vpImagePoolAllocator
+
+  \ingroup group_core_image
+
+  \brief Allocator that recycles the released memory blocks.
+
+  Released blocks are kept in a pool and returned by the next allocations of
+  the same size, so that the temporary images of a processing loop do not hit
+  the system allocator at each frame. The allocator is thread-safe.
+
+  The bookkeeping does not allocate: each block starts with a header that
+  links it in the free list of its size class when it is released. Taking a
+  block from the pool and giving it back thus never calls the system
+  allocator.
+
+  \code
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageAllocator.h>
+
+int main()
+{
+  vpImagePoolAllocator pool;
+  for (int frame = 0; frame < 100; frame++) {
+    vpImage<unsigned char> I;
+    I.setAllocator(&pool);
+    I.resize(480, 640); // Memory allocated once, then taken from the pool
+    // ...
+  }
+}
+  \endcode
+*/
+class VISP_EXPORT vpImagePoolAllocator : public vpImageAllocator
+{
+public:
+  explicit vpImagePoolAllocator(size_t maxCachedSize = 0);
+  virtual ~vpImagePoolAllocator();
+
+  void *allocate(size_t size, size_t alignment);
+  void clear();
+  void deallocate(void *ptr, size_t size);
+
+  size_t getCachedSize() const;
+  /*!
+    Return the maximum number of bytes kept in the pool, 0 meaning no limit.
+  */
+  size_t getMaxCachedSize() const { return m_maxCachedSize; }
+  unsigned int getNbReuses() const;
+
+private:
+  // Non copyable
+  vpImagePoolAllocator(const vpImagePoolAllocator &);
+  vpImagePoolAllocator &operator=(const vpImagePoolAllocator &);
+
+  struct vpBlockHeader;
+
+  //! Number of lists of released blocks, the blocks being spread by size
+  static const unsigned int nb_size_classes = 61;
+
+  static unsigned int getSizeClass(size_t size);
+
+  //! Blocks available for reuse, linked through their header
+  vpBlockHeader *m_freeBlocks[nb_size_classes];
+  size_t m_cachedSize;
+  size_t m_maxCachedSize;
+  unsigned int m_nbReuses;
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+  mutable vpMutex m_mutex;
+#endif
+};
+
+#endif
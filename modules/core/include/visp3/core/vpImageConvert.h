@@ -210,6 +210,13 @@ public:
   static void YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height);
   static void YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
 
+  static void YUYVToRGBaHalfSize(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height);
+  static void YUYVToGreyHalfSize(unsigned char *yuyv, unsigned char *grey, unsigned int width, unsigned int height);
+  static void YUV422ToRGBaHalfSize(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
+  static void YUV422ToGreyHalfSize(unsigned char *yuv, unsigned char *grey, unsigned int width, unsigned int height);
+  static void YUV420ToRGBaHalfSize(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height);
+  static void YUV420ToGreyHalfSize(unsigned char *yuv, unsigned char *grey, unsigned int width, unsigned int height);
+
   static void YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size);
   static void YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size);
   static void YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size);
@@ -641,10 +641,14 @@ public:
 
   static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<double> &GI, unsigned int size = 7,
                            double sigma = 0., bool normalize = true);
+  static void gaussianBlur(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size = 7,
+                           double sigma = 0., bool normalize = true);
   static void gaussianBlur(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &GI, unsigned int size = 7,
                            double sigma = 0., bool normalize = true);
   static void gaussianBlur(const vpImage<double> &I, vpImage<double> &GI, unsigned int size = 7, double sigma = 0.,
                            bool normalize = true);
+  static void gaussianBlurRecursive(const vpImage<unsigned char> &I, vpImage<double> &GI, double sigma);
+  static void gaussianBlurRecursive(const vpImage<double> &I, vpImage<double> &GI, double sigma);
   /*!
    Apply a 5x5 Gaussian filter to an image pixel.
 
@@ -47,6 +47,7 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageException.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpStructuringElement.h>
 
 #include <fstream>
 #include <iostream>
@@ -87,6 +88,15 @@ public:
 
   static void erosion(vpImage<unsigned char> &I, const vpConnexityType &connexity = CONNEXITY_4);
   static void dilatation(vpImage<unsigned char> &I, const vpConnexityType &connexity = CONNEXITY_4);
+
+  static void erosion(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se);
+  static void dilatation(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                         const vpStructuringElement &se);
+  static void opening(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se);
+  static void closing(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se);
+  static void gradient(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se);
+  static void topHat(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se,
+                     bool white = true);
 };
 
 /*!
@@ -48,24 +48,21 @@
 
 #include <visp3/core/vpImage.h>
 
-#ifdef VISP_HAVE_PTHREAD
-#include <pthread.h>
-#endif
-
 #include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImageException.h>
+#include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/core/vpRect.h>
 #include <visp3/core/vpRectOriented.h>
+#include <visp3/core/vpUndistortMap.h>
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <math.h>
 #include <string.h>
-
-#if defined _OPENMP
-#include <omp.h>
-#endif
+#include <vector>
 
 /*!
   \class vpImageTools
@@ -82,12 +79,16 @@ public:
   enum vpImageInterpolationType {
     INTERPOLATION_NEAREST, /*!< Nearest neighbor interpolation (fastest). */
     INTERPOLATION_LINEAR,  /*!< Bi-linear interpolation. */
-    INTERPOLATION_CUBIC    /*!< Bi-cubic interpolation. */
+    INTERPOLATION_CUBIC,   /*!< Bi-cubic interpolation. */
+    INTERPOLATION_AREA     /*!< Area averaging: each pixel of the resized image is the mean of the input pixels that
+                              it covers, weighted by the covered area. Recommended to downscale since it does not
+                              alias. Only available to resize unsigned char and vpRGBa images. */
   };
 
   template <class Type>
   static inline void binarise(vpImage<Type> &I, Type threshold1, Type threshold2, Type value1, Type value2, Type value3,
                               bool useLUT = true);
+  static void boxFilter(const vpImage<unsigned char> &I, vpImage<double> &I_mean, unsigned int size);
   static void changeLUT(vpImage<unsigned char> &I, unsigned char A, unsigned char newA, unsigned char B,
                         unsigned char newB);
 
@@ -137,6 +138,12 @@ public:
                             const vpImageInterpolationType &method = INTERPOLATION_NEAREST);
 
   static void integralImage(const vpImage<unsigned char> &I, vpImage<double> &II, vpImage<double> &IIsq);
+  static void integralImage(const vpImage<unsigned char> &I, vpImage<uint32_t> &II);
+  static void integralImage(const vpImage<unsigned char> &I, vpImage<uint32_t> &II, vpImage<uint64_t> &IIsq);
+  static void integralImageTilted(const vpImage<unsigned char> &I, vpImage<uint32_t> &IIt);
+
+  static void localMeanVariance(const vpImage<unsigned char> &I, vpImage<double> &I_mean, vpImage<double> &I_variance,
+                                unsigned int size);
 
   static double normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2,
                                       bool useOptimized = true);
@@ -147,6 +154,8 @@ public:
                     const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<unsigned char> &Iundist);
   static void remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
                     const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist);
+  static void remap(const vpImage<unsigned char> &I, const vpUndistortMap &map, vpImage<unsigned char> &Iundist);
+  static void remap(const vpImage<vpRGBa> &I, const vpUndistortMap &map, vpImage<vpRGBa> &Iundist);
 
   template <class Type>
   static void resize(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int width, unsigned int height,
@@ -159,6 +168,12 @@ public:
   static void templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
                                bool useOptimized = true);
+  static double templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                 vpImagePoint &ip, unsigned int nbLevels = 3, unsigned int nbCandidates = 16,
+                                 bool subPixel = false);
+  static void templateMatching(const vpImage<unsigned char> &I, const std::vector<vpImage<unsigned char> > &I_tpls,
+                               std::vector<vpImagePoint> &ips, std::vector<double> &scores, unsigned int nbLevels = 3,
+                               unsigned int nbCandidates = 16, bool subPixel = false);
 
   template <class Type>
   static void undistort(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &newI,
@@ -191,6 +206,10 @@ private:
 
   static int coordCast(double x);
 
+  static void computeResizeCoefficients(unsigned int srcSize, unsigned int dstSize,
+                                        const vpImageInterpolationType &method, std::vector<unsigned int> &first,
+                                        std::vector<float> &weights, unsigned int &nbTaps);
+
   // Linear interpolation
   static double lerp(double A, double B, double t);
   static float lerp(float A, float B, float t);
@@ -213,12 +232,36 @@ private:
                             float u, float v);
 
   template <class Type>
-  static void warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner, bool fixedPoint);
+  static void warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner,
+                     bool fixedPoint, unsigned int rowBegin, unsigned int rowEnd);
 
   template <class Type>
-  static void warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner, bool fixedPoint);
+  static void warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine,
+                         bool centerCorner, bool fixedPoint, unsigned int rowBegin, unsigned int rowEnd);
 
   static bool checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine);
+
+  template <class Type>
+  static void resizeRows(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
+                         unsigned int rowBegin, unsigned int rowEnd);
+
+  template <class Type>
+  static void resizeImage(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
+                          unsigned int nThreads);
+  static void resizeSeparable(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                              const vpImageInterpolationType &method, unsigned int nThreads);
+  static void resizeSeparable(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires, const vpImageInterpolationType &method,
+                              unsigned int nThreads);
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+  // Stripe bodies executed by vpParallel::parallelFor()
+  class RemapBody;
+  class RemapRGBaBody;
+  class TemplateMatchingBody;
+  template <class Type> class ResizeBody;
+  template <class Type> class UndistortBody;
+  template <class Type> class WarpBody;
+#endif
 };
 
 #if defined(VISP_BUILD_DEPRECATED_FUNCTIONS)
@@ -371,6 +414,7 @@ void vpImageTools::crop(const vpImage<Type> &I, const vpImagePoint &topLeft, uns
   \param v_scale [in] : Vertical subsampling factor applied to the ROI.
   \param h_scale [in] : Horizontal subsampling factor applied to the ROI.
 
+  \sa vpImageView to process a region of interest without copying it.
 */
 template <class Type>
 void vpImageTools::crop(const vpImage<Type> &I, const vpRect &roi, vpImage<Type> &crop, unsigned int v_scale,
@@ -457,16 +501,18 @@ inline void vpImageTools::binarise(vpImage<Type> &I, Type threshold1, Type thres
   }
 
   Type v;
-  Type *p = I.bitmap;
-  Type *pend = I.bitmap + I.getWidth() * I.getHeight();
-  for (; p < pend; p++) {
-    v = *p;
-    if (v < threshold1)
-      *p = value1;
-    else if (v > threshold2)
-      *p = value3;
-    else
-      *p = value2;
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    Type *p = I[i];
+    Type *pend = p + I.getWidth();
+    for (; p < pend; p++) {
+      v = *p;
+      if (v < threshold1)
+        *p = value1;
+      else if (v > threshold2)
+        *p = value3;
+      else
+        *p = value2;
+    }
   }
 }
 
@@ -493,123 +539,138 @@ inline void vpImageTools::binarise(vpImage<unsigned char> &I, unsigned char thre
 
     I.performLut(lut);
   } else {
-    unsigned char *p = I.bitmap;
-    unsigned char *pend = I.bitmap + I.getWidth() * I.getHeight();
-    for (; p < pend; p++) {
-      unsigned char v = *p;
-      if (v < threshold1)
-        *p = value1;
-      else if (v > threshold2)
-        *p = value3;
-      else
-        *p = value2;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      unsigned char *p = I[i];
+      unsigned char *pend = p + I.getWidth();
+      for (; p < pend; p++) {
+        unsigned char v = *p;
+        if (v < threshold1)
+          *p = value1;
+        else if (v > threshold2)
+          *p = value3;
+        else
+          *p = value2;
+      }
     }
   }
 }
 
-#ifdef VISP_HAVE_PTHREAD
-
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
-template <class Type> class vpUndistortInternalType
+template <class Type> class vpImageTools::ResizeBody : public vpParallelBody
 {
 public:
-  Type *src;
-  Type *dst;
-  unsigned int width;
-  unsigned int height;
-  vpCameraParameters cam;
-  unsigned int nthreads;
-  unsigned int threadid;
+  ResizeBody(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method)
+    : m_I(I), m_Ires(Ires), m_method(method)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const { resizeRows(m_I, m_Ires, m_method, begin, end); }
 
+private:
+  const vpImage<Type> &m_I;
+  vpImage<Type> &m_Ires;
+  vpImageInterpolationType m_method;
+};
+
+template <class Type> class vpImageTools::WarpBody : public vpParallelBody
+{
 public:
-  vpUndistortInternalType() : src(NULL), dst(NULL), width(0), height(0), cam(), nthreads(0), threadid(0) {}
+  WarpBody(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine, bool centerCorner,
+           bool fixedPoint, bool nearest)
+    : m_src(src), m_T(T), m_dst(dst), m_affine(affine), m_centerCorner(centerCorner), m_fixedPoint(fixedPoint),
+      m_nearest(nearest)
+  {
+  }
 
-  vpUndistortInternalType(const vpUndistortInternalType<Type> &u) { *this = u; }
-  vpUndistortInternalType &operator=(const vpUndistortInternalType<Type> &u)
+  void operator()(unsigned int begin, unsigned int end) const
   {
-    src = u.src;
-    dst = u.dst;
-    width = u.width;
-    height = u.height;
-    cam = u.cam;
-    nthreads = u.nthreads;
-    threadid = u.threadid;
-
-    return *this;
+    if (m_nearest) {
+      warpNN(m_src, m_T, m_dst, m_affine, m_centerCorner, m_fixedPoint, begin, end);
+    } else {
+      warpLinear(m_src, m_T, m_dst, m_affine, m_centerCorner, m_fixedPoint, begin, end);
+    }
   }
 
-  static void *vpUndistort_threaded(void *arg);
+private:
+  const vpImage<Type> &m_src;
+  const vpMatrix &m_T;
+  vpImage<Type> &m_dst;
+  bool m_affine;
+  bool m_centerCorner;
+  bool m_fixedPoint;
+  bool m_nearest;
 };
 
-template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(void *arg)
+template <class Type> class vpImageTools::UndistortBody : public vpParallelBody
 {
-  vpUndistortInternalType<Type> *undistortSharedData = static_cast<vpUndistortInternalType<Type> *>(arg);
-  int offset = (int)undistortSharedData->threadid;
-  int width = (int)undistortSharedData->width;
-  int height = (int)undistortSharedData->height;
-  int nthreads = (int)undistortSharedData->nthreads;
-
-  double u0 = undistortSharedData->cam.get_u0();
-  double v0 = undistortSharedData->cam.get_v0();
-  double px = undistortSharedData->cam.get_px();
-  double py = undistortSharedData->cam.get_py();
-  double kud = undistortSharedData->cam.get_kud();
-
-  double invpx = 1.0 / px;
-  double invpy = 1.0 / py;
-
-  double kud_px2 = kud * invpx * invpx;
-  double kud_py2 = kud * invpy * invpy;
-
-  Type *dst = undistortSharedData->dst + (height / nthreads * offset) * width;
-  Type *src = undistortSharedData->src;
-
-  for (double v = height / nthreads * offset; v < height / nthreads * (offset + 1); v++) {
-    double deltav = v - v0;
-    // double fr1 = 1.0 + kd * (vpMath::sqr(deltav * invpy));
-    double fr1 = 1.0 + kud_py2 * deltav * deltav;
-
-    for (double u = 0; u < width; u++) {
-      // computation of u,v : corresponding pixel coordinates in I.
-      double deltau = u - u0;
-      // double fr2 = fr1 + kd * (vpMath::sqr(deltau * invpx));
-      double fr2 = fr1 + kud_px2 * deltau * deltau;
-
-      double u_double = deltau * fr2 + u0;
-      double v_double = deltav * fr2 + v0;
-
-      // computation of the bilinear interpolation
-
-      // declarations
-      int u_round = (int)(u_double);
-      int v_round = (int)(v_double);
-      if (u_round < 0.f)
-        u_round = -1;
-      if (v_round < 0.f)
-        v_round = -1;
-      double du_double = (u_double) - (double)u_round;
-      double dv_double = (v_double) - (double)v_round;
-      Type v01;
-      Type v23;
-      if ((0 <= u_round) && (0 <= v_round) && (u_round < ((width)-1)) && (v_round < ((height)-1))) {
-        // process interpolation
-        const Type *_mp = &src[v_round * width + u_round];
-        v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        _mp += width;
-        v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        *dst = (Type)(v01 + ((v23 - v01) * dv_double));
-      } else {
-        *dst = 0;
+public:
+  UndistortBody(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &undistI)
+    : m_I(I), m_undistI(undistI), m_u0(cam.get_u0()), m_v0(cam.get_v0()), m_kud_px2(0), m_kud_py2(0)
+  {
+    double invpx = 1.0 / cam.get_px();
+    double invpy = 1.0 / cam.get_py();
+
+    m_kud_px2 = cam.get_kud() * invpx * invpx;
+    m_kud_py2 = cam.get_kud() * invpy * invpy;
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const int width = static_cast<int>(m_I.getWidth());
+    const int height = static_cast<int>(m_I.getHeight());
+
+    for (unsigned int i = begin; i < end; i++) {
+      Type *dst = m_undistI[i];
+      double deltav = i - m_v0;
+      // double fr1 = 1.0 + kd * (vpMath::sqr(deltav * invpy));
+      double fr1 = 1.0 + m_kud_py2 * deltav * deltav;
+
+      for (int u = 0; u < width; u++) {
+        // computation of u,v : corresponding pixel coordinates in I.
+        double deltau = u - m_u0;
+        // double fr2 = fr1 + kd * (vpMath::sqr(deltau * invpx));
+        double fr2 = fr1 + m_kud_px2 * deltau * deltau;
+
+        double u_double = deltau * fr2 + m_u0;
+        double v_double = deltav * fr2 + m_v0;
+
+        // computation of the bilinear interpolation
+
+        // declarations
+        int u_round = (int)(u_double);
+        int v_round = (int)(v_double);
+        if (u_round < 0.f)
+          u_round = -1;
+        if (v_round < 0.f)
+          v_round = -1;
+        double du_double = (u_double) - (double)u_round;
+        double dv_double = (v_double) - (double)v_round;
+        Type v01;
+        Type v23;
+        if ((0 <= u_round) && (0 <= v_round) && (u_round < (width - 1)) && (v_round < (height - 1))) {
+          // process interpolation
+          const Type *_mp = &m_I[(unsigned int)v_round][(unsigned int)u_round];
+          v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
+          _mp = &m_I[(unsigned int)v_round + 1][(unsigned int)u_round];
+          v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
+          *dst = (Type)(v01 + ((v23 - v01) * dv_double));
+        } else {
+          *dst = 0;
+        }
+        dst++;
       }
-      dst++;
     }
   }
 
-  pthread_exit((void *)0);
-  return NULL;
-}
+private:
+  const vpImage<Type> &m_I;
+  vpImage<Type> &m_undistI;
+  double m_u0;
+  double m_v0;
+  double m_kud_px2;
+  double m_kud_py2;
+};
 #endif // DOXYGEN_SHOULD_SKIP_THIS
-#endif // VISP_HAVE_PTHREAD
 
 /*!
   Undistort an image
@@ -623,7 +684,9 @@ template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(
   parameter \f$K_d\f$ is null (see cam.get_kd_mp()), \e undistI is
   just a copy of \e I.
 
-  \param nThreads : Number of threads to use if pthreads library is available.
+  \param nThreads : Maximum number of threads to use, 0 to use vpParallel::getNumThreads(),
+  that is by default all the hardware threads. Use 1, or vpParallel::setNumThreads(1), to
+  process the image in the calling thread only.
 
   \warning This function works only with Types authorizing "+,-,
   multiplication by a scalar" operators.
@@ -634,76 +697,19 @@ template <class Type> void *vpUndistortInternalType<Type>::vpUndistort_threaded(
 
   \note If you want to undistort multiple images, you should call `vpImageTools::initUndistortMap()`
   once and then `vpImageTools::remap()` to undistort the images. This will be less time consuming.
+  A vpUndistortMap built once is even faster since it relies on fixed-point weights.
 
-  \sa initUndistortMap, remap
+  \sa initUndistortMap, remap, vpUndistortMap
 */
 template <class Type>
 void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &cam, vpImage<Type> &undistI,
                              unsigned int nThreads)
 {
-#ifdef VISP_HAVE_PTHREAD
-  //
-  // Optimized version using pthreads
-  //
-  unsigned int width = I.getWidth();
-  unsigned int height = I.getHeight();
-
-  undistI.resize(height, width);
-
-  double kud = cam.get_kud();
-
-  // if (kud == 0) {
-  if (std::fabs(kud) <= std::numeric_limits<double>::epsilon()) {
-    // There is no need to undistort the image
-    undistI = I;
-    return;
-  }
-
-  unsigned int nthreads = nThreads;
-  pthread_attr_t attr;
-  pthread_t *callThd = new pthread_t[nthreads];
-  pthread_attr_init(&attr);
-  pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
-
-  vpUndistortInternalType<Type> *undistortSharedData;
-  undistortSharedData = new vpUndistortInternalType<Type>[nthreads];
-
-  for (unsigned int i = 0; i < nthreads; i++) {
-    // Each thread works on a different set of data.
-    //    vpTRACE("create thread %d", i);
-    undistortSharedData[i].src = I.bitmap;
-    undistortSharedData[i].dst = undistI.bitmap;
-    undistortSharedData[i].width = I.getWidth();
-    undistortSharedData[i].height = I.getHeight();
-    undistortSharedData[i].cam = cam;
-    undistortSharedData[i].nthreads = nthreads;
-    undistortSharedData[i].threadid = i;
-    pthread_create(&callThd[i], &attr, &vpUndistortInternalType<Type>::vpUndistort_threaded, &undistortSharedData[i]);
-  }
-  pthread_attr_destroy(&attr);
-  /* Wait on the other threads */
-
-  for (unsigned int i = 0; i < nthreads; i++) {
-    //  vpTRACE("join thread %d", i);
-    pthread_join(callThd[i], NULL);
-  }
-
-  delete[] callThd;
-  delete[] undistortSharedData;
-#else  // VISP_HAVE_PTHREAD
-  (void)nThreads;
-  //
-  // optimized version without pthreads
-  //
   unsigned int width = I.getWidth();
   unsigned int height = I.getHeight();
 
   undistI.resize(height, width);
 
-  double u0 = cam.get_u0();
-  double v0 = cam.get_v0();
-  double px = cam.get_px();
-  double py = cam.get_py();
   double kud = cam.get_kud();
 
   // if (kud == 0) {
@@ -713,87 +719,7 @@ void vpImageTools::undistort(const vpImage<Type> &I, const vpCameraParameters &c
     return;
   }
 
-  double invpx = 1.0 / px;
-  double invpy = 1.0 / py;
-
-  double kud_px2 = kud * invpx * invpx;
-  double kud_py2 = kud * invpy * invpy;
-
-  Type *dst = undistI.bitmap;
-  for (double v = 0; v < height; v++) {
-    double deltav = v - v0;
-    // double fr1 = 1.0 + kd * (vpMath::sqr(deltav * invpy));
-    double fr1 = 1.0 + kud_py2 * deltav * deltav;
-
-    for (double u = 0; u < width; u++) {
-      // computation of u,v : corresponding pixel coordinates in I.
-      double deltau = u - u0;
-      // double fr2 = fr1 + kd * (vpMath::sqr(deltau * invpx));
-      double fr2 = fr1 + kud_px2 * deltau * deltau;
-
-      double u_double = deltau * fr2 + u0;
-      double v_double = deltav * fr2 + v0;
-
-      // printf("[%g][%g] %g %g : ", u, v, u_double, v_double );
-
-      // computation of the bilinear interpolation
-
-      // declarations
-      int u_round = (int)(u_double);
-      int v_round = (int)(v_double);
-      if (u_round < 0.f)
-        u_round = -1;
-      if (v_round < 0.f)
-        v_round = -1;
-      double du_double = (u_double) - (double)u_round;
-      double dv_double = (v_double) - (double)v_round;
-      Type v01;
-      Type v23;
-      if ((0 <= u_round) && (0 <= v_round) && (u_round < (((int)width) - 1)) && (v_round < (((int)height) - 1))) {
-        // process interpolation
-        const Type *_mp = &I[(unsigned int)v_round][(unsigned int)u_round];
-        v01 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        _mp += width;
-        v23 = (Type)(_mp[0] + ((_mp[1] - _mp[0]) * du_double));
-        *dst = (Type)(v01 + ((v23 - v01) * dv_double));
-        // printf("R %d G %d B %d\n", dst->R, dst->G, dst->B);
-      } else {
-        *dst = 0;
-      }
-      dst++;
-    }
-  }
-#endif // VISP_HAVE_PTHREAD
-
-#if 0
-  // non optimized version
-  int width = I.getWidth();
-  int height = I.getHeight();
-
-  undistI.resize(height,width);
-
-  double u0 = cam.get_u0();
-  double v0 = cam.get_v0();
-  double px = cam.get_px();
-  double py = cam.get_py();
-  double kd = cam.get_kud();
-
-  if (kd == 0) {
-    // There is no need to undistort the image
-    undistI = I;
-    return;
-  }
-
-  for(int v = 0 ; v < height; v++){
-    for(int u = 0; u < height; u++){
-      double r2 = vpMath::sqr(((double)u - u0)/px) +
-                  vpMath::sqr(((double)v-v0)/py);
-      double u_double = ((double)u - u0)*(1.0+kd*r2) + u0;
-      double v_double = ((double)v - v0)*(1.0+kd*r2) + v0;
-      undistI[v][u] = I.getPixelBI((float)u_double,(float)v_double);
-    }
-  }
-#endif
+  vpParallel::parallelFor(0, height, UndistortBody<Type>(I, cam, undistI), nThreads);
 }
 
 /*!
@@ -812,7 +738,7 @@ template <class Type> void vpImageTools::flip(const vpImage<Type> &I, vpImage<Ty
   newI.resize(height, width);
 
   for (unsigned int i = 0; i < height; i++) {
-    memcpy(newI.bitmap + i * width, I.bitmap + (height - 1 - i) * width, width * sizeof(Type));
+    memcpy(newI[i], I[height - 1 - i], width * sizeof(Type));
   }
 }
 
@@ -858,10 +784,10 @@ template <class Type> void vpImageTools::flip(vpImage<Type> &I)
   Ibuf.resize(1, width);
 
   for (i = 0; i < height / 2; i++) {
-    memcpy(Ibuf.bitmap, I.bitmap + i * width, width * sizeof(Type));
+    memcpy(Ibuf.bitmap, I[i], width * sizeof(Type));
 
-    memcpy(I.bitmap + i * width, I.bitmap + (height - 1 - i) * width, width * sizeof(Type));
-    memcpy(I.bitmap + (height - 1 - i) * width, Ibuf.bitmap, width * sizeof(Type));
+    memcpy(I[i], I[height - 1 - i], width * sizeof(Type));
+    memcpy(I[height - 1 - i], Ibuf.bitmap, width * sizeof(Type));
   }
 }
 
@@ -1040,7 +966,9 @@ void vpImageTools::resizeNearest(const vpImage<Type> &I, vpImage<Type> &Ires, un
   \param width : Resized width.
   \param height : Resized height.
   \param method : Interpolation method.
-  \param nThreads : Number of threads to use if OpenMP is available.
+  \param nThreads : Maximum number of threads to use, 0 to use vpParallel::getNumThreads(),
+  that is by default all the hardware threads. Use 1, or vpParallel::setNumThreads(1), to
+  process the image in the calling thread only.
 
   \warning The input \e I and output \e Ires images must be different.
 */
@@ -1058,27 +986,82 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned
   Resize the image using one interpolation method (by default it uses the
   nearest neighbor interpolation).
 
+  The bi-cubic and area interpolations of the unsigned char and vpRGBa images
+  are separable: the coefficients of the rows and of the columns are computed
+  once, then each resized row is obtained by combining the input rows and
+  then the columns, with SSE2 or NEON kernels. Downscaling by a factor of 2 or
+  4 with INTERPOLATION_AREA averages blocks of pixels with exact integer
+  arithmetic. INTERPOLATION_AREA is not available for the other types of
+  images.
+
   \param I : Input image.
   \param Ires : Output image resized (you have to init the image \e Ires at
   the desired size).
   \param method : Interpolation method.
-  \param nThreads : Number of threads to use if OpenMP is available.
+  \param nThreads : Maximum number of threads to use, 0 to use vpParallel::getNumThreads(),
+  that is by default all the hardware threads. Use 1, or vpParallel::setNumThreads(1), to
+  process the image in the calling thread only.
 
   \warning The input \e I and output \e Ires images must be different.
 */
 template <class Type>
 void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
-                          unsigned int
-                        #if defined _OPENMP
-                          nThreads
-                        #endif
-                          )
+                          unsigned int nThreads)
 {
+  if (method == INTERPOLATION_AREA) {
+    std::cerr << "Area interpolation is only available for unsigned char and vpRGBa images!" << std::endl;
+    return;
+  }
+
   if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
     std::cerr << "Input or output image is too small!" << std::endl;
     return;
   }
 
+  vpParallel::parallelFor(0, Ires.getHeight(), ResizeBody<Type>(I, Ires, method), nThreads);
+}
+
+template <>
+inline void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                 const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  resizeImage(I, Ires, method, nThreads);
+}
+
+template <>
+inline void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                                 const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  resizeImage(I, Ires, method, nThreads);
+}
+
+// Resize of the unsigned char and vpRGBa images, that have separable kernels
+// for the bi-cubic and area interpolations
+template <class Type>
+void vpImageTools::resizeImage(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
+                               unsigned int nThreads)
+{
+  if (method == INTERPOLATION_AREA) {
+    if (I.getSize() == 0 || Ires.getSize() == 0) {
+      std::cerr << "Input or output image is too small!" << std::endl;
+      return;
+    }
+  } else if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
+    std::cerr << "Input or output image is too small!" << std::endl;
+    return;
+  }
+
+  if (method == INTERPOLATION_AREA || method == INTERPOLATION_CUBIC) {
+    resizeSeparable(I, Ires, method, nThreads);
+  } else {
+    vpParallel::parallelFor(0, Ires.getHeight(), ResizeBody<Type>(I, Ires, method), nThreads);
+  }
+}
+
+template <class Type>
+void vpImageTools::resizeRows(const vpImage<Type> &I, vpImage<Type> &Ires, const vpImageInterpolationType &method,
+                              unsigned int rowBegin, unsigned int rowEnd)
+{
   float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
   float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
 
@@ -1087,13 +1070,7 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpI
     scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
   }
 
-#if defined _OPENMP
-  if (nThreads > 0) {
-    omp_set_num_threads(static_cast<int>(nThreads));
-  }
-  #pragma omp parallel for schedule(dynamic)
-#endif
-  for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+  for (unsigned int i = rowBegin; i < rowEnd; i++) {
     float v = i * scaleY;
     float yFrac = v - static_cast<int>(v);
 
@@ -1102,29 +1079,20 @@ void vpImageTools::resize(const vpImage<Type> &I, vpImage<Type> &Ires, const vpI
       float xFrac = u - static_cast<int>(u);
 
       if (method == INTERPOLATION_NEAREST) {
-        resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
+        resizeNearest(I, Ires, i, j, u, v);
       } else if (method == INTERPOLATION_LINEAR) {
-        resizeBilinear(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
+        resizeBilinear(I, Ires, i, j, u, v, xFrac, yFrac);
       } else if (method == INTERPOLATION_CUBIC) {
-        resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
+        resizeBicubic(I, Ires, i, j, u, v, xFrac, yFrac);
       }
     }
   }
 }
 
 template <> inline
-void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
-                          const vpImageInterpolationType &method, unsigned int
-                                                                  #if defined _OPENMP
-                                                                    nThreads
-                                                                  #endif
-                          )
+void vpImageTools::resizeRows(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                              const vpImageInterpolationType &method, unsigned int rowBegin, unsigned int rowEnd)
 {
-  if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
-    std::cerr << "Input or output image is too small!" << std::endl;
-    return;
-  }
-
   if (method == INTERPOLATION_NEAREST || method == INTERPOLATION_CUBIC) {
     float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
     float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
@@ -1134,13 +1102,7 @@ void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char
       scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
     }
 
-  #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-    #pragma omp parallel for schedule(dynamic)
-  #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       float v = i * scaleY;
       float yFrac = v - static_cast<int>(v);
 
@@ -1149,9 +1111,9 @@ void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char
         float xFrac = u - static_cast<int>(u);
 
         if (method == INTERPOLATION_NEAREST) {
-          resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
+          resizeNearest(I, Ires, i, j, u, v);
         } else if (method == INTERPOLATION_CUBIC) {
-          resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
+          resizeBicubic(I, Ires, i, j, u, v, xFrac, yFrac);
         }
       }
     }
@@ -1160,17 +1122,12 @@ void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char
     int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
     int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
 
-#if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       int64_t v = i * scaleY;
       int64_t vround = v & (~0xFFFF);
       int64_t rratio = v - vround;
       int64_t y_ = v >> 16;
+      const unsigned int row = static_cast<unsigned int>(y_);
       int64_t rfrac = precision - rratio;
 
       for (unsigned int j = 0; j < Ires.getWidth(); j++) {
@@ -1181,19 +1138,19 @@ void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char
         int64_t cfrac = precision - cratio;
 
         if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + y_ * I.getWidth() + x_);
-          uint16_t down = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + (y_ + 1) * I.getWidth() + x_);
+          uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I[row] + x_);
+          uint16_t down = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I[row + 1] + x_);
 
           Ires[i][j] = static_cast<unsigned char>((((up & 0x00FF) * rfrac + (down & 0x00FF) * rratio) * cfrac +
                                                   ((up >> 8) * rfrac + (down >> 8) * rratio) * cratio) >> 32);
         } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
-          Ires[i][j] = static_cast<unsigned char>(((*(I.bitmap + y_ * I.getWidth() + x_)
-                                                  * rfrac + *(I.bitmap + (y_ + 1) * I.getWidth() + x_) * rratio)) >> 16);
+          Ires[i][j] = static_cast<unsigned char>(((*(I[row] + x_)
+                                                  * rfrac + *(I[row + 1] + x_) * rratio)) >> 16);
         } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I.bitmap + y_ * I.getWidth() + x_);
+          uint16_t up = vpEndian::reinterpret_cast_uchar_to_uint16_LE(I[row] + x_);
           Ires[i][j] = static_cast<unsigned char>(((up & 0x00FF) * cfrac + (up >> 8) * cratio) >> 16);
         } else {
-          Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
+          Ires[i][j] = *(I[row] + x_);
         }
       }
     }
@@ -1201,18 +1158,9 @@ void vpImageTools::resize(const vpImage<unsigned char> &I, vpImage<unsigned char
 }
 
 template <> inline
-void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
-                          const vpImageInterpolationType &method, unsigned int
-                                                                  #if defined _OPENMP
-                                                                    nThreads
-                                                                  #endif
-                          )
+void vpImageTools::resizeRows(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                              const vpImageInterpolationType &method, unsigned int rowBegin, unsigned int rowEnd)
 {
-  if (I.getWidth() < 2 || I.getHeight() < 2 || Ires.getWidth() < 2 || Ires.getHeight() < 2) {
-    std::cerr << "Input or output image is too small!" << std::endl;
-    return;
-  }
-
   if (method == INTERPOLATION_NEAREST || method == INTERPOLATION_CUBIC) {
     float scaleY = (I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1);
     float scaleX = (I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1);
@@ -1222,13 +1170,7 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
       scaleX = I.getWidth() / static_cast<float>(Ires.getWidth() - 1);
     }
 
-  #if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-    #pragma omp parallel for schedule(dynamic)
-  #endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       float v = i * scaleY;
       float yFrac = v - static_cast<int>(v);
 
@@ -1237,9 +1179,9 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
         float xFrac = u - static_cast<int>(u);
 
         if (method == INTERPOLATION_NEAREST) {
-          resizeNearest(I, Ires, static_cast<unsigned int>(i), j, u, v);
+          resizeNearest(I, Ires, i, j, u, v);
         } else if (method == INTERPOLATION_CUBIC) {
-          resizeBicubic(I, Ires, static_cast<unsigned int>(i), j, u, v, xFrac, yFrac);
+          resizeBicubic(I, Ires, i, j, u, v, xFrac, yFrac);
         }
       }
     }
@@ -1248,17 +1190,12 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
     int64_t scaleY = static_cast<int64_t>((I.getHeight() - 1) / static_cast<float>(Ires.getHeight() - 1) * precision);
     int64_t scaleX = static_cast<int64_t>((I.getWidth() - 1) / static_cast<float>(Ires.getWidth() - 1) * precision);
 
-#if defined _OPENMP
-    if (nThreads > 0) {
-      omp_set_num_threads(static_cast<int>(nThreads));
-    }
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i = 0; i < static_cast<int>(Ires.getHeight()); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       int64_t v = i * scaleY;
       int64_t vround = v & (~0xFFFF);
       int64_t rratio = v - vround;
       int64_t y_ = v >> 16;
+      const unsigned int row = static_cast<unsigned int>(y_);
       int64_t rfrac = precision - rratio;
 
       for (unsigned int j = 0; j < Ires.getWidth(); j++) {
@@ -1269,39 +1206,39 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
         int64_t cfrac = precision - cratio;
 
         if (y_ + 1 < static_cast<int64_t>(I.getHeight()) && x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
-          int64_t col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->R, rratio, rfrac);
+          int64_t col0 = lerp2((I[row] + x_)->R, (I[row + 1] + x_)->R, rratio, rfrac);
+          int64_t col1 = lerp2((I[row] + x_ + 1)->R, (I[row + 1] + x_ + 1)->R, rratio, rfrac);
           int64_t valueR = lerp2(col0, col1, cratio, cfrac);
 
-          col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
-          col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->G, rratio, rfrac);
+          col0 = lerp2((I[row] + x_)->G, (I[row + 1] + x_)->G, rratio, rfrac);
+          col1 = lerp2((I[row] + x_ + 1)->G, (I[row + 1] + x_ + 1)->G, rratio, rfrac);
           int64_t valueG = lerp2(col0, col1, cratio, cfrac);
 
-          col0 = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
-          col1 = lerp2((I.bitmap + y_ * I.getWidth() + x_ + 1)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_ + 1)->B, rratio, rfrac);
+          col0 = lerp2((I[row] + x_)->B, (I[row + 1] + x_)->B, rratio, rfrac);
+          col1 = lerp2((I[row] + x_ + 1)->B, (I[row + 1] + x_ + 1)->B, rratio, rfrac);
           int64_t valueB = lerp2(col0, col1, cratio, cfrac);
 
           Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 32),
                               static_cast<unsigned char>(valueG >> 32),
                               static_cast<unsigned char>(valueB >> 32));
         } else if (y_ + 1 < static_cast<int64_t>(I.getHeight())) {
-          int64_t valueR = lerp2((I.bitmap + y_ * I.getWidth() + x_)->R, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->R, rratio, rfrac);
-          int64_t valueG = lerp2((I.bitmap + y_ * I.getWidth() + x_)->G, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->G, rratio, rfrac);
-          int64_t valueB = lerp2((I.bitmap + y_ * I.getWidth() + x_)->B, (I.bitmap + (y_ + 1) * I.getWidth() + x_)->B, rratio, rfrac);
+          int64_t valueR = lerp2((I[row] + x_)->R, (I[row + 1] + x_)->R, rratio, rfrac);
+          int64_t valueG = lerp2((I[row] + x_)->G, (I[row + 1] + x_)->G, rratio, rfrac);
+          int64_t valueB = lerp2((I[row] + x_)->B, (I[row + 1] + x_)->B, rratio, rfrac);
 
           Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
                               static_cast<unsigned char>(valueG >> 16),
                               static_cast<unsigned char>(valueB >> 16));
         } else if (x_ + 1 < static_cast<int64_t>(I.getWidth())) {
-          int64_t valueR = lerp2((I.bitmap + x_)->R, (I.bitmap + x_ + 1)->R, cratio, cfrac);
-          int64_t valueG = lerp2((I.bitmap + x_)->G, (I.bitmap + x_ + 1)->G, cratio, cfrac);
-          int64_t valueB = lerp2((I.bitmap + x_)->B, (I.bitmap + x_ + 1)->B, cratio, cfrac);
+          int64_t valueR = lerp2((I[row] + x_)->R, (I[row] + x_ + 1)->R, cratio, cfrac);
+          int64_t valueG = lerp2((I[row] + x_)->G, (I[row] + x_ + 1)->G, cratio, cfrac);
+          int64_t valueB = lerp2((I[row] + x_)->B, (I[row] + x_ + 1)->B, cratio, cfrac);
 
           Ires[i][j] = vpRGBa(static_cast<unsigned char>(valueR >> 16),
                               static_cast<unsigned char>(valueG >> 16),
                               static_cast<unsigned char>(valueB >> 16));
         } else {
-          Ires[i][j] = *(I.bitmap + y_ * I.getWidth() + x_);
+          Ires[i][j] = *(I[row] + x_);
         }
       }
     }
@@ -1316,11 +1253,16 @@ void vpImageTools::resize(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
   or a `3x3` matrix for a perspective transformation (homography).
   \param dst : Output image, if empty it will be of the same size than src and zero-initialized.
   \param interpolation : Interpolation method (only INTERPOLATION_NEAREST and INTERPOLATION_LINEAR
-  are accepted, if INTERPOLATION_CUBIC is passed, INTERPOLATION_NEAREST will be used instead).
+  are accepted, if INTERPOLATION_CUBIC is passed, INTERPOLATION_NEAREST will be used instead, and
+  INTERPOLATION_AREA is handled as INTERPOLATION_LINEAR).
   \param fixedPointArithmetic : If true and if `pixelCenter` is false, fixed-point arithmetic is used if
   possible. Otherwise (e.g. the input image is too big) it fallbacks to the default implementation.
   \param pixelCenter : If true, pixel coordinates are at (0.5, 0.5), otherwise at (0,0). Fixed-point
   arithmetic cannot be used with `pixelCenter` option.
+
+  \note The rows of \e dst are computed with vpParallel::getNumThreads() threads, that is by
+  default all the hardware threads. Call vpParallel::setNumThreads(1) to warp the image in the
+  calling thread only.
 */
 template <class Type>
 void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst,
@@ -1364,18 +1306,14 @@ void vpImageTools::warpImage(const vpImage<Type> &src, const vpMatrix &T, vpImag
                            checkFixedPoint(dst.getWidth() - 1, dst.getHeight() - 1, M, affine);
   }
 
-  if (interp_NN) {
-    //nearest neighbor interpolation
-    warpNN(src, M, dst, affine, pixelCenter, fixedPointArithmetic);
-  } else {
-    //bilinear interpolation
-    warpLinear(src, M, dst, affine, pixelCenter, fixedPointArithmetic);
-  }
+  // nearest neighbor or bilinear interpolation
+  vpParallel::parallelFor(0, dst.getHeight(), WarpBody<Type>(src, M, dst, affine, pixelCenter, fixedPointArithmetic,
+                                                             interp_NN));
 }
 
 template <class Type>
 void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine,
-                          bool centerCorner, bool fixedPoint)
+                          bool centerCorner, bool fixedPoint, unsigned int rowBegin, unsigned int rowEnd)
 {
   if (fixedPoint && !centerCorner) {
     const int nbits = 16;
@@ -1395,8 +1333,13 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
     int32_t height_1_i32 = static_cast<int32_t>((src.getHeight() - 1) * precision) + 0x8000;
     int32_t width_1_i32 = static_cast<int32_t>((src.getWidth() - 1) * precision) + 0x8000;
 
+    // Start at the first row of the stripe
+    a2_i32 += static_cast<int32_t>(rowBegin) * a1_i32;
+    a5_i32 += static_cast<int32_t>(rowBegin) * a4_i32;
+    a8_i32 += static_cast<int32_t>(rowBegin) * a7_i32;
+
     if (affine) {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      for (unsigned int i = rowBegin; i < rowEnd; i++) {
         int32_t xi = a2_i32;
         int32_t yi = a5_i32;
 
@@ -1418,7 +1361,7 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
         a5_i32 += a4_i32;
       }
     } else {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      for (unsigned int i = rowBegin; i < rowEnd; i++) {
         int64_t xi = a2_i32;
         int64_t yi = a5_i32;
         int64_t wi = a8_i32;
@@ -1453,7 +1396,7 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
     double a7 = affine ? 0.0 : T[2][1];
     double a8 = affine ? 1.0 : T[2][2];
 
-    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       for (unsigned int j = 0; j < dst.getWidth(); j++) {
         double x = a0 * (centerCorner ? j + 0.5 : j) + a1 * (centerCorner ? i + 0.5 : i) + a2;
         double y = a3 * (centerCorner ? j + 0.5 : j) + a4 * (centerCorner ? i + 0.5 : i) + a5;
@@ -1477,7 +1420,7 @@ void vpImageTools::warpNN(const vpImage<Type> &src, const vpMatrix &T, vpImage<T
 
 template <class Type>
 void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpImage<Type> &dst, bool affine,
-                              bool centerCorner, bool fixedPoint)
+                              bool centerCorner, bool fixedPoint, unsigned int rowBegin, unsigned int rowEnd)
 {
   if (fixedPoint && !centerCorner) {
     const int nbits = 16;
@@ -1499,8 +1442,13 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
     int64_t height_i64 = static_cast<int64_t>(src.getHeight() * precision);
     int64_t width_i64 = static_cast<int64_t>(src.getWidth() * precision);
 
+    // Start at the first row of the stripe
+    a2_i64 += static_cast<int64_t>(rowBegin) * a1_i64;
+    a5_i64 += static_cast<int64_t>(rowBegin) * a4_i64;
+    a8_i64 += static_cast<int64_t>(rowBegin) * a7_i64;
+
     if (affine) {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      for (unsigned int i = rowBegin; i < rowEnd; i++) {
         int64_t xi_ = a2_i64;
         int64_t yi_ = a5_i64;
 
@@ -1550,7 +1498,7 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
         a5_i64 += a4_i64;
       }
     } else {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      for (unsigned int i = rowBegin; i < rowEnd; i++) {
         int64_t xi = a2_i64;
         int64_t yi = a5_i64;
         int64_t wi = a8_i64;
@@ -1609,7 +1557,7 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
     double a7 = affine ? 0.0 : T[2][1];
     double a8 = affine ? 1.0 : T[2][2];
 
-    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       for (unsigned int j = 0; j < dst.getWidth(); j++) {
         double x = a0 * (centerCorner ? j + 0.5 : j) + a1 * (centerCorner ? i + 0.5 : i) + a2;
         double y = a3 * (centerCorner ? j + 0.5 : j) + a4 * (centerCorner ? i + 0.5 : i) + a5;
@@ -1661,7 +1609,7 @@ void vpImageTools::warpLinear(const vpImage<Type> &src, const vpMatrix &T, vpIma
 
 template <> inline
 void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpImage<vpRGBa> &dst, bool affine,
-                              bool centerCorner, bool fixedPoint)
+                              bool centerCorner, bool fixedPoint, unsigned int rowBegin, unsigned int rowEnd)
 {
   if (fixedPoint && !centerCorner) {
     const int nbits = 16;
@@ -1683,8 +1631,13 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
     int64_t height_i64 = static_cast<int64_t>(src.getHeight() * precision);
     int64_t width_i64 = static_cast<int64_t>(src.getWidth() * precision);
 
+    // Start at the first row of the stripe
+    a2_i64 += static_cast<int64_t>(rowBegin) * a1_i64;
+    a5_i64 += static_cast<int64_t>(rowBegin) * a4_i64;
+    a8_i64 += static_cast<int64_t>(rowBegin) * a7_i64;
+
     if (affine) {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      for (unsigned int i = rowBegin; i < rowEnd; i++) {
         int64_t xi = a2_i64;
         int64_t yi = a5_i64;
 
@@ -1764,7 +1717,7 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
         a5_i64 += a4_i64;
       }
     } else {
-      for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      for (unsigned int i = rowBegin; i < rowEnd; i++) {
         int64_t xi = a2_i64;
         int64_t yi = a5_i64;
         int64_t wi = a8_i64;
@@ -1847,7 +1800,7 @@ void vpImageTools::warpLinear(const vpImage<vpRGBa> &src, const vpMatrix &T, vpI
     double a7 = affine ? 0.0 : T[2][1];
     double a8 = affine ? 1.0 : T[2][2];
 
-    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+    for (unsigned int i = rowBegin; i < rowEnd; i++) {
       for (unsigned int j = 0; j < dst.getWidth(); j++) {
         double x = a0 * (centerCorner ? j + 0.5 : j) + a1 * (centerCorner ? i + 0.5 : i) + a2;
         double y = a3 * (centerCorner ? j + 0.5 : j) + a4 * (centerCorner ? i + 0.5 : i) + a5;
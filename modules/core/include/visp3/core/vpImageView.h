@@ -0,0 +1,221 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ *
+ * Description:
+ * Zero-copy view on a region of interest of an image.
+ *
+ *****************************************************************************/
+
+#ifndef _vpImageView_h_
+#define _vpImageView_h_
+
+/*!
+  \file vpImageView.h
+  \brief Zero-copy view on a region of interest of an image.
+*/
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRect.h>
+
+/*!
+  \class vpImageView
+
+  \ingroup group_core_image
+
+  \brief Image that refers to a rectangular region of another image without
+  copying its pixels.
+
+  A view is a vpImage whose rows point inside the bitmap of the parent image,
+  so that it can be given to the functions that access the pixels through the
+  rows, such as the vpImageFilter, vpImageMorphology, vpImageTools and
+  vpImageConvert functions on vpImage or the imgproc module functions. Reading
+  a view costs no allocation, and functions that modify an image in place
+  modify the region of the parent image. The functions that exchange a raw
+  buffer with another library, as the OpenCV conversions, still expect a
+  contiguous bitmap.
+
+  \code
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageView.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640, 0);
+
+  // Smooth only a region of I
+  vpImageView<unsigned char> roi(I, vpRect(100, 50, 200, 150));
+  vpImage<unsigned char> Iblur;
+  vpImageFilter::gaussianBlur(roi, Iblur, 5);
+  roi = Iblur; // Copy the smoothed pixels back in I
+}
+  \endcode
+
+  The view keeps the stride of the parent image: its rows are not contiguous,
+  see vpImage::isContiguous(). It must not be used after the parent image has
+  been resized or destroyed.
+
+  Assigning an image to a view with operator=() copies the pixels in the region
+  of the parent image. On the other hand a function that takes a view as a
+  vpImage output and assigns it a new image, instead of writing its pixels,
+  detaches the view from the parent image.
+
+  \sa vpImage::initView(), vpImageTools::crop()
+*/
+template <class Type> class vpImageView : public vpImage<Type>
+{
+public:
+  vpImageView(vpImage<Type> &I, const vpRect &roi);
+  vpImageView(vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int height, unsigned int width);
+  vpImageView(const vpImageView<Type> &view);
+  virtual ~vpImageView() {}
+
+  /*!
+    Return the column of the top-left corner of the view in the parent image.
+  */
+  unsigned int getLeft() const { return m_left; }
+  /*!
+    Return the region of the parent image covered by the view.
+  */
+  vpRect getRect() const { return vpRect(m_left, m_top, this->getWidth(), this->getHeight()); }
+  /*!
+    Return the row of the top-left corner of the view in the parent image.
+  */
+  unsigned int getTop() const { return m_top; }
+
+  vpImageView<Type> &operator=(const vpImageView<Type> &view);
+  vpImageView<Type> &operator=(const vpImage<Type> &I);
+  vpImageView<Type> &operator=(const Type &v);
+
+private:
+  void copyPixels(const vpImage<Type> &I);
+
+  unsigned int m_top;
+  unsigned int m_left;
+};
+
+/*!
+  Create a view on a region of interest of an image. The region is clipped to
+  the image, its corners being rounded as in vpImageTools::crop().
+
+  \param I : Parent image.
+  \param roi : Region of interest in the parent image.
+*/
+template <class Type>
+vpImageView<Type>::vpImageView(vpImage<Type> &I, const vpRect &roi) : vpImage<Type>(), m_top(0), m_left(0)
+{
+  int i_min = (std::max)((int)(ceil(roi.getTop())), 0);
+  int j_min = (std::max)((int)(ceil(roi.getLeft())), 0);
+  int i_max = (std::min)((int)(ceil(roi.getTop() + roi.getHeight())), (int)I.getHeight());
+  int j_max = (std::min)((int)(ceil(roi.getLeft() + roi.getWidth())), (int)I.getWidth());
+
+  m_top = static_cast<unsigned int>((std::min)(i_min, (int)I.getHeight()));
+  m_left = static_cast<unsigned int>((std::min)(j_min, (int)I.getWidth()));
+  unsigned int h = i_max > (int)m_top ? static_cast<unsigned int>(i_max) - m_top : 0;
+  unsigned int w = j_max > (int)m_left ? static_cast<unsigned int>(j_max) - m_left : 0;
+
+  this->initView(I, m_top, m_left, h, w);
+}
+
+/*!
+  Create a view on a region of interest of an image.
+
+  \param I : Parent image.
+  \param top : Row of the top-left corner of the region in \e I.
+  \param left : Column of the top-left corner of the region in \e I.
+  \param height : Height of the region.
+  \param width : Width of the region.
+
+  \exception vpException::dimensionError : If the region is not inside \e I.
+*/
+template <class Type>
+vpImageView<Type>::vpImageView(vpImage<Type> &I, unsigned int top, unsigned int left, unsigned int height,
+                               unsigned int width)
+  : vpImage<Type>(), m_top(top), m_left(left)
+{
+  this->initView(I, top, left, height, width);
+}
+
+/*!
+  Copy constructor. The new view refers to the same pixels.
+*/
+template <class Type>
+vpImageView<Type>::vpImageView(const vpImageView<Type> &view)
+  : vpImage<Type>(), m_top(view.m_top), m_left(view.m_left)
+{
+  this->init(view.bitmap, view.getHeight(), view.getWidth(), view.getStride(), false);
+}
+
+/*!
+  Copy the pixels of \e view in the region of the parent image.
+
+  \exception vpException::dimensionError : If the sizes differ.
+*/
+template <class Type> vpImageView<Type> &vpImageView<Type>::operator=(const vpImageView<Type> &view)
+{
+  copyPixels(view);
+  return *this;
+}
+
+/*!
+  Copy the pixels of \e I in the region of the parent image.
+
+  \exception vpException::dimensionError : If the sizes differ.
+*/
+template <class Type> vpImageView<Type> &vpImageView<Type>::operator=(const vpImage<Type> &I)
+{
+  copyPixels(I);
+  return *this;
+}
+
+/*!
+  Set all the pixels of the region of the parent image to \e v.
+*/
+template <class Type> vpImageView<Type> &vpImageView<Type>::operator=(const Type &v)
+{
+  vpImage<Type>::operator=(v);
+  return *this;
+}
+
+template <class Type> void vpImageView<Type>::copyPixels(const vpImage<Type> &I)
+{
+  if (I.getHeight() != this->getHeight() || I.getWidth() != this->getWidth()) {
+    throw(vpException(vpException::dimensionError, "Cannot copy a %ux%u image in a %ux%u view", I.getWidth(),
+                      I.getHeight(), this->getWidth(), this->getHeight()));
+  }
+  if (this->getHeight() == 0 || I[0] == (*this)[0]) {
+    return;
+  }
+  for (unsigned int i = 0; i < this->getHeight(); i++) {
+    memmove(static_cast<void *>((*this)[i]), static_cast<const void *>(I[i]), this->getWidth() * sizeof(Type));
+  }
+}
+
+#endif
@@ -57,6 +57,7 @@ class vpTranslationVector;
 class vpHomogeneousMatrix;
 class vpVelocityTwistMatrix;
 class vpForceTwistMatrix;
+class vpMatrixWorkspace;
 
 /*!
   \file vpMatrix.h
@@ -487,6 +488,7 @@ vpMatrix M(R);
   unsigned int pseudoInverse(vpMatrix &Ap, vpColVector &sv, double svThreshold, vpMatrix &imA, vpMatrix &imAt) const;
   unsigned int pseudoInverse(vpMatrix &Ap, vpColVector &sv, double svThreshold, vpMatrix &imA, vpMatrix &imAt,
                              vpMatrix &kerAt) const;
+  unsigned int pseudoInverse(vpMatrix &Ap, vpMatrixWorkspace &workspace, double svThreshold = 1e-6) const;
 
 #if defined(VISP_HAVE_LAPACK)
   vpMatrix pseudoInverseLapack(double svThreshold = 1e-6) const;
@@ -527,6 +529,7 @@ vpMatrix M(R);
 
   // singular value decomposition SVD
   void svd(vpColVector &w, vpMatrix &V);
+  void svdJacobi(vpColVector &w, vpMatrix &V);
 #ifdef VISP_HAVE_EIGEN3
   void svdEigen3(vpColVector &w, vpMatrix &V);
 #endif
@@ -644,6 +647,8 @@ vpMatrix M(R);
   static void mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpHomogeneousMatrix &C);
   static void mult2Matrices(const vpMatrix &A, const vpColVector &B, vpColVector &C);
   static void multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVector &w);
+  static void multTransposeMatrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C);
+  static void multTransposeMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVector &w);
   static void negateMatrix(const vpMatrix &A, vpMatrix &C);
   static void sub2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C);
   static void sub2Matrices(const vpColVector &A, const vpColVector &B, vpColVector &C);
@@ -954,6 +959,14 @@ private:
                          double *w_data, double *work_data, unsigned int lwork_, int &info_);
 #endif
 
+  static void builtin_dgemm(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int a_rs,
+                            unsigned int a_cs, const double *b_data, unsigned int b_rs, unsigned int b_cs,
+                            double *c_data, unsigned int ldc, bool upper = false);
+  static void builtin_dgemv(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                            const double *x_data, double *y_data);
+  static void builtin_dsyrk(unsigned int N, unsigned int K, const double *x_data, unsigned int x_rs,
+                            unsigned int x_cs, double *c_data, unsigned int ldc);
+
   static void computeCovarianceMatrixVVS(const vpHomogeneousMatrix &cMo, const vpColVector &deltaS, const vpMatrix &Ls,
                                          vpMatrix &Js, vpColVector &deltaP);
 };
@@ -0,0 +1,372 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Fixed-size matrix with stack storage.
+ *
+ *****************************************************************************/
+
+#ifndef _vpMatrixFixed_h_
+#define _vpMatrixFixed_h_
+
+/*!
+  \file vpMatrixFixed.h
+  \brief Fixed-size matrix with stack storage.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+
+#include <visp3/core/vpArray2D.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpException.h>
+
+/*!
+  \class vpMatrixFixed
+
+  \ingroup group_core_matrices
+
+  \brief Matrix of doubles whose size is known at compile time.
+
+  Contrary to vpMatrix and the classes derived from vpArray2D, the elements are
+  stored in the object itself, so that creating and destroying a
+  vpMatrixFixed never allocates memory. All the loops have compile-time bounds
+  and are unrolled by the compiler. It is intended for the small matrices of the
+  geometry computations (rotations, homogeneous transformations, twists,
+  interaction matrix rows), and converts from and to vpArray2D<double> when a
+  dynamic matrix is needed.
+
+  \code
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
+
+int main()
+{
+  vpHomogeneousMatrix cMo(0.1, 0.2, 1, 0, 0, M_PI / 4);
+  vpMatrixFixed<4, 4> M(cMo); // No heap allocation
+  vpMatrixFixed<4, 1> oP;
+  oP[3][0] = 1;
+  vpMatrixFixed<4, 1> cP = M * oP;
+  std::cout << "cP: " << cP.t() << std::endl;
+}
+  \endcode
+*/
+template <unsigned int R, unsigned int C> class vpMatrixFixed
+{
+public:
+  //! Elements of the matrix, row by row
+  double data[R * C];
+
+  /*!
+    Build a matrix filled with zeros.
+  */
+  vpMatrixFixed()
+  {
+    for (unsigned int i = 0; i < R * C; i++) {
+      data[i] = 0.0;
+    }
+  }
+
+  /*!
+    Build a matrix from \e R x \e C values given row by row.
+  */
+  explicit vpMatrixFixed(const double *values)
+  {
+    for (unsigned int i = 0; i < R * C; i++) {
+      data[i] = values[i];
+    }
+  }
+
+  /*!
+    Build a matrix from a dynamic array. The homogeneous matrices, rotation
+    matrices, twist matrices and vectors can be given there.
+
+    \exception vpException::dimensionError : If the size of \e A is not \e R x \e C.
+  */
+  explicit vpMatrixFixed(const vpArray2D<double> &A)
+  {
+    if (A.getRows() != R || A.getCols() != C) {
+      throw(vpException(vpException::dimensionError, "Cannot build a (%dx%d) fixed-size matrix from a (%dx%d) array",
+                        R, C, A.getRows(), A.getCols()));
+    }
+    for (unsigned int i = 0; i < R * C; i++) {
+      data[i] = A.data[i];
+    }
+  }
+
+  /*!
+    Copy the elements, row by row, in \e values that should hold \e R x \e C values.
+  */
+  void copyTo(double *values) const
+  {
+    for (unsigned int i = 0; i < R * C; i++) {
+      values[i] = data[i];
+    }
+  }
+
+  /*!
+    Copy the elements in the dynamic array \e A, that is resized only if its
+    size differs.
+  */
+  void copyTo(vpArray2D<double> &A) const
+  {
+    if (A.getRows() != R || A.getCols() != C) {
+      A.resize(R, C, false, false);
+    }
+    copyTo(A.data);
+  }
+
+  /*!
+    Set the matrix to identity (ones on the main diagonal, zeros elsewhere).
+  */
+  void eye()
+  {
+    for (unsigned int i = 0; i < R; i++) {
+      for (unsigned int j = 0; j < C; j++) {
+        data[i * C + j] = (i == j) ? 1.0 : 0.0;
+      }
+    }
+  }
+
+  //! Return the number of columns.
+  static unsigned int getCols() { return C; }
+  //! Return the number of rows.
+  static unsigned int getRows() { return R; }
+  //! Return the number of elements.
+  static unsigned int size() { return R * C; }
+
+  /*!
+    Return the inverse of the matrix, computed in closed form for 2x2 and 3x3
+    matrices and by Gauss-Jordan elimination with partial pivoting otherwise.
+
+    \exception vpException::dimensionError : If the matrix is not square.
+    \exception vpException::fatalError : If the matrix is singular.
+  */
+  vpMatrixFixed<R, C> inverse() const
+  {
+    if (R != C) {
+      throw(vpException(vpException::dimensionError, "Cannot invert a non square (%dx%d) matrix", R, C));
+    }
+    vpMatrixFixed<R, C> Ai;
+    invert(data, Ai.data, SizeTag<R>());
+    return Ai;
+  }
+
+  /*!
+    Return the transposed matrix.
+  */
+  vpMatrixFixed<C, R> t() const
+  {
+    vpMatrixFixed<C, R> At;
+    for (unsigned int i = 0; i < R; i++) {
+      for (unsigned int j = 0; j < C; j++) {
+        At.data[j * R + i] = data[i * C + j];
+      }
+    }
+    return At;
+  }
+
+  //! Return a pointer to the first element of row \e i.
+  double *operator[](unsigned int i) { return data + i * C; }
+  //! Return a pointer to the first element of row \e i.
+  const double *operator[](unsigned int i) const { return data + i * C; }
+
+  /*!
+    Matrix product.
+  */
+  template <unsigned int K> vpMatrixFixed<R, K> operator*(const vpMatrixFixed<C, K> &B) const
+  {
+    vpMatrixFixed<R, K> AB;
+    for (unsigned int i = 0; i < R; i++) {
+      for (unsigned int k = 0; k < C; k++) {
+        const double a_ik = data[i * C + k];
+        for (unsigned int j = 0; j < K; j++) {
+          AB.data[i * K + j] += a_ik * B.data[k * K + j];
+        }
+      }
+    }
+    return AB;
+  }
+
+  //! Multiply each element by \e x.
+  vpMatrixFixed<R, C> operator*(double x) const
+  {
+    vpMatrixFixed<R, C> Ax(*this);
+    Ax *= x;
+    return Ax;
+  }
+
+  //! Multiply each element by \e x.
+  vpMatrixFixed<R, C> &operator*=(double x)
+  {
+    for (unsigned int i = 0; i < R * C; i++) {
+      data[i] *= x;
+    }
+    return *this;
+  }
+
+  //! Element-wise sum.
+  vpMatrixFixed<R, C> operator+(const vpMatrixFixed<R, C> &B) const
+  {
+    vpMatrixFixed<R, C> S(*this);
+    S += B;
+    return S;
+  }
+
+  //! Element-wise sum.
+  vpMatrixFixed<R, C> &operator+=(const vpMatrixFixed<R, C> &B)
+  {
+    for (unsigned int i = 0; i < R * C; i++) {
+      data[i] += B.data[i];
+    }
+    return *this;
+  }
+
+  //! Element-wise difference.
+  vpMatrixFixed<R, C> operator-(const vpMatrixFixed<R, C> &B) const
+  {
+    vpMatrixFixed<R, C> D(*this);
+    D -= B;
+    return D;
+  }
+
+  //! Element-wise difference.
+  vpMatrixFixed<R, C> &operator-=(const vpMatrixFixed<R, C> &B)
+  {
+    for (unsigned int i = 0; i < R * C; i++) {
+      data[i] -= B.data[i];
+    }
+    return *this;
+  }
+
+  //! Opposite of the matrix.
+  vpMatrixFixed<R, C> operator-() const { return (*this) * -1.0; }
+
+  /*!
+    Print the matrix row by row, the elements of a row being separated by a space.
+  */
+  friend std::ostream &operator<<(std::ostream &os, const vpMatrixFixed<R, C> &A)
+  {
+    for (unsigned int i = 0; i < R; i++) {
+      for (unsigned int j = 0; j < C; j++) {
+        os << A.data[i * C + j];
+        if (j + 1 < C) {
+          os << " ";
+        }
+      }
+      if (i + 1 < R) {
+        os << std::endl;
+      }
+    }
+    return os;
+  }
+
+private:
+  template <unsigned int N> struct SizeTag {
+  };
+
+  static void invert(const double *a, double *ai, SizeTag<2>)
+  {
+    const double det = a[0] * a[3] - a[1] * a[2];
+    checkDeterminant(det);
+    ai[0] = a[3] / det;
+    ai[1] = -a[1] / det;
+    ai[2] = -a[2] / det;
+    ai[3] = a[0] / det;
+  }
+
+  static void invert(const double *a, double *ai, SizeTag<3>)
+  {
+    const double c00 = a[4] * a[8] - a[5] * a[7];
+    const double c01 = a[5] * a[6] - a[3] * a[8];
+    const double c02 = a[3] * a[7] - a[4] * a[6];
+    const double det = a[0] * c00 + a[1] * c01 + a[2] * c02;
+    checkDeterminant(det);
+    ai[0] = c00 / det;
+    ai[1] = (a[2] * a[7] - a[1] * a[8]) / det;
+    ai[2] = (a[1] * a[5] - a[2] * a[4]) / det;
+    ai[3] = c01 / det;
+    ai[4] = (a[0] * a[8] - a[2] * a[6]) / det;
+    ai[5] = (a[2] * a[3] - a[0] * a[5]) / det;
+    ai[6] = c02 / det;
+    ai[7] = (a[1] * a[6] - a[0] * a[7]) / det;
+    ai[8] = (a[0] * a[4] - a[1] * a[3]) / det;
+  }
+
+  // Gauss-Jordan elimination with partial pivoting
+  template <unsigned int N> static void invert(const double *a_, double *ai, SizeTag<N>)
+  {
+    double a[N * N];
+    for (unsigned int i = 0; i < N * N; i++) {
+      a[i] = a_[i];
+      ai[i] = (i % (N + 1) == 0) ? 1.0 : 0.0;
+    }
+    for (unsigned int k = 0; k < N; k++) {
+      unsigned int pivot = k;
+      for (unsigned int i = k + 1; i < N; i++) {
+        if (std::fabs(a[i * N + k]) > std::fabs(a[pivot * N + k])) {
+          pivot = i;
+        }
+      }
+      checkDeterminant(a[pivot * N + k]);
+      if (pivot != k) {
+        for (unsigned int j = 0; j < N; j++) {
+          std::swap(a[k * N + j], a[pivot * N + j]);
+          std::swap(ai[k * N + j], ai[pivot * N + j]);
+        }
+      }
+      const double inv_pivot = 1.0 / a[k * N + k];
+      for (unsigned int j = 0; j < N; j++) {
+        a[k * N + j] *= inv_pivot;
+        ai[k * N + j] *= inv_pivot;
+      }
+      for (unsigned int i = 0; i < N; i++) {
+        if (i != k) {
+          const double f = a[i * N + k];
+          for (unsigned int j = 0; j < N; j++) {
+            a[i * N + j] -= f * a[k * N + j];
+            ai[i * N + j] -= f * ai[k * N + j];
+          }
+        }
+      }
+    }
+  }
+
+  static void checkDeterminant(double det)
+  {
+    if (std::fabs(det) < std::numeric_limits<double>::epsilon()) {
+      throw(vpException(vpException::fatalError, "Cannot invert a singular (%dx%d) matrix", R, C));
+    }
+  }
+};
+
+#endif
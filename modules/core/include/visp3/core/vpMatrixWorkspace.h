@@ -0,0 +1,110 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Reusable buffers for allocation-free matrix decompositions.
+ *
+ *****************************************************************************/
+
+#ifndef _vpMatrixWorkspace_h_
+#define _vpMatrixWorkspace_h_
+
+/*!
+  \file vpMatrixWorkspace.h
+  \brief Reusable buffers for allocation-free matrix decompositions.
+*/
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpMatrix.h>
+
+/*!
+  \class vpMatrixWorkspace
+  \ingroup group_core_matrices
+
+  \brief Buffers reused from one call to the next by the vpMatrix functions
+  that take a workspace, such as vpMatrix::pseudoInverse(vpMatrix &,
+  vpMatrixWorkspace &, double) const.
+
+  The buffers are only reallocated when the size of the decomposed matrix
+  changes. Keeping a workspace alive across the iterations of an iterative
+  solver, like the virtual visual servoing loops of the trackers, thus removes
+  all the heap allocations of the decomposition once the first iteration is
+  done.
+
+  \code
+#include <visp3/core/vpMatrixWorkspace.h>
+
+int main()
+{
+  vpMatrix A(6, 6), Ap;
+  vpMatrixWorkspace workspace;
+  for (unsigned int iter = 0; iter < 10; iter++) {
+    // ... fill A
+    A.pseudoInverse(Ap, workspace, 1e-10); // no allocation after the first iteration
+  }
+}
+  \endcode
+
+  A workspace must not be shared between threads.
+*/
+class VISP_EXPORT vpMatrixWorkspace
+{
+  friend class vpMatrix;
+
+public:
+  vpMatrixWorkspace() : m_U(), m_V(), m_sv() {}
+
+  /*!
+    Release the memory held by the workspace.
+  */
+  void clear()
+  {
+    m_U.clear();
+    m_V.clear();
+    m_sv.clear();
+  }
+
+  /*!
+    Return the singular values computed by the last decomposition, sorted in
+    decreasing order.
+  */
+  const vpColVector &getSingularValues() const { return m_sv; }
+
+private:
+  //! Left singular vectors, the decomposed matrix being copied in it first
+  vpMatrix m_U;
+  //! Right singular vectors
+  vpMatrix m_V;
+  //! Singular values
+  vpColVector m_sv;
+};
+
+#endif
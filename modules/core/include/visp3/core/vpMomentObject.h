@@ -260,6 +260,7 @@ public:
                  const vpCameraParameters &cam); // Binary version
   void fromImage(const vpImage<unsigned char> &image, const vpCameraParameters &cam, vpCameraImgBckGrndType bg_type,
                  bool normalize_with_pix_size = true); // Photometric version
+  void fromPixelMoments(const std::vector<double> &pixelMoments, const vpCameraParameters &cam);
 
   void fromVector(std::vector<vpPoint> &points);
   const std::vector<double> &get() const;
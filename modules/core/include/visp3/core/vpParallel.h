@@ -0,0 +1,135 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Stripe-parallel executor based on a persistent thread pool.
+ *
+ *****************************************************************************/
+
+#ifndef _vpParallel_h_
+#define _vpParallel_h_
+
+/*!
+  \file vpParallel.h
+  \brief Stripe-parallel executor based on a persistent thread pool.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpParallelBody
+
+  \ingroup group_core_threading
+
+  \brief Interface of the work executed by vpParallel::parallelFor().
+
+  The operator() is called with half-open ranges [begin, end[ that partition
+  the whole iteration range. It may be called concurrently from several
+  threads, thus an implementation must only write data that is owned by the
+  given range.
+*/
+class VISP_EXPORT vpParallelBody
+{
+public:
+  virtual ~vpParallelBody() {}
+
+  /*!
+    Process the iterations in [begin, end[.
+  */
+  virtual void operator()(unsigned int begin, unsigned int end) const = 0;
+};
+
+/*!
+  \class vpParallel
+
+  \ingroup group_core_threading
+
+  \brief Stripe-parallel executor shared by the image processing functions.
+
+  The work is executed by a persistent pool of threads that is created the
+  first time it is needed, thus no thread is spawned per call. The iteration
+  range is cut into stripes whose size only depends on the range and on the
+  grain size, never on the number of threads, so that a body that only writes
+  in its own stripe gives bit-for-bit identical results whatever the thread
+  count.
+
+  By default getNumThreads() is the number of concurrent threads supported by
+  the hardware, and the functions that run through parallelFor(), for
+  instance vpImageTools::resize(), vpImageTools::warpImage() or
+  vpImageTools::undistort(), use all of them. Call setNumThreads(1) to process
+  the images sequentially in the calling thread.
+
+  The pool is never destroyed, so that no thread is joined during the
+  destruction of the static objects: call shutdown() to join its threads
+  explicitly.
+
+  The pool needs C++11 threading support and pthread (or Windows). Otherwise,
+  or when called from a thread of the pool (nested parallelism) or when the
+  pool is already used by another thread, the stripes are processed
+  sequentially by the calling thread.
+
+  \code
+#include <visp3/core/vpParallel.h>
+
+class SquareBody : public vpParallelBody
+{
+public:
+  SquareBody(const std::vector<double> &in, std::vector<double> &out) : m_in(in), m_out(out) {}
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++)
+      m_out[i] = m_in[i] * m_in[i];
+  }
+
+private:
+  const std::vector<double> &m_in;
+  std::vector<double> &m_out;
+};
+
+int main()
+{
+  std::vector<double> in(1000, 2.0), out(in.size());
+  vpParallel::setNumThreads(4);
+  vpParallel::parallelFor(0, static_cast<unsigned int>(in.size()), SquareBody(in, out));
+}
+  \endcode
+*/
+class VISP_EXPORT vpParallel
+{
+public:
+  static unsigned int getNumThreads();
+  static void setNumThreads(unsigned int nThreads);
+  static void shutdown();
+
+  static void parallelFor(unsigned int begin, unsigned int end, const vpParallelBody &body, unsigned int nThreads = 0,
+                          unsigned int grainSize = 0);
+};
+
+#endif
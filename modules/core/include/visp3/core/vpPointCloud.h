@@ -0,0 +1,154 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Organized point cloud stored as packed floats.
+ *
+ *****************************************************************************/
+
+#ifndef _vpPointCloud_h_
+#define _vpPointCloud_h_
+
+/*!
+  \file vpPointCloud.h
+  \brief Organized point cloud stored as packed floats.
+*/
+
+#include <vector>
+
+#include <visp3/core/vpColVector.h>
+#include <visp3/core/vpConfig.h>
+
+/*!
+  \class vpPointCloud
+
+  \ingroup group_core_image
+
+  \brief Organized point cloud, that is a \e height x \e width grid of 3D
+  points \f$(X, Y, Z)\f$ expressed in the camera frame, stored in a single
+  contiguous buffer of floats.
+
+  The point at row \e i and column \e j is <tt>cloud[i * getWidth() + j]</tt>,
+  a pointer to its three coordinates. Consecutive points are separated by
+  getStep() floats, so that the buffers of the sensors can be used without
+  any copy:
+  - the vertices of a <tt>rs2::points</tt> computed by librealsense are
+    packed <tt>(X, Y, Z)</tt> floats, that is a step of 3;
+  - the points of a <tt>pcl::PointCloud<pcl::PointXYZ></tt> are aligned on 16
+    bytes, that is a step of 4.
+
+  A point whose depth \e Z is not strictly positive is considered as invalid.
+
+  A point cloud either owns its buffer (resize(), buildFrom()) or wraps an
+  external buffer (init() or the corresponding constructor). In the latter
+  case the buffer must outlive the point cloud and the points can only be
+  read. The points of an owned buffer are written through getWritableData().
+
+  \code
+#include <visp3/core/vpPointCloud.h>
+
+int main()
+{
+  const unsigned int height = 480, width = 640;
+  std::vector<float> buffer(3 * height * width);
+  // ... fill the buffer with the (X, Y, Z) coordinates of each pixel
+
+  // No copy of the buffer
+  vpPointCloud cloud(&buffer[0], height, width);
+  const float *p = cloud[240 * width + 320];
+  std::cout << "Z: " << p[2] << std::endl;
+}
+  \endcode
+*/
+class VISP_EXPORT vpPointCloud
+{
+public:
+  vpPointCloud();
+  vpPointCloud(unsigned int height, unsigned int width);
+  vpPointCloud(const float *data, unsigned int height, unsigned int width, unsigned int step = 3);
+  vpPointCloud(const vpPointCloud &cloud);
+
+  vpPointCloud &operator=(const vpPointCloud &cloud);
+
+  void buildFrom(const std::vector<vpColVector> &point_cloud, unsigned int height, unsigned int width);
+  void convert(std::vector<vpColVector> &point_cloud) const;
+
+  /*!
+    Return a pointer to the first point of the point cloud, or NULL if the
+    point cloud is empty.
+  */
+  inline const float *getData() const { return m_data; }
+  /*!
+    Return the number of rows of the point cloud.
+  */
+  inline unsigned int getHeight() const { return m_height; }
+  /*!
+    Return the number of points of the point cloud.
+  */
+  inline unsigned int getSize() const { return m_height * m_width; }
+  /*!
+    Return the number of floats between two consecutive points.
+  */
+  inline unsigned int getStep() const { return m_step; }
+  /*!
+    Return the number of columns of the point cloud.
+  */
+  inline unsigned int getWidth() const { return m_width; }
+  /*!
+    Return a pointer to the first point of the buffer owned by the point
+    cloud, to fill the points after resize(). Return NULL if the point cloud
+    wraps an external buffer or is empty.
+  */
+  inline float *getWritableData() { return m_storage.empty() ? NULL : &m_storage[0]; }
+
+  void init(const float *data, unsigned int height, unsigned int width, unsigned int step = 3);
+
+  /*!
+    Return true if the point cloud owns its buffer, false if it wraps an
+    external buffer.
+  */
+  inline bool isOwner() const { return m_data == NULL || !m_storage.empty(); }
+
+  /*!
+    Return a pointer to the coordinates \f$(X, Y, Z)\f$ of the point \e n.
+  */
+  inline const float *operator[](unsigned int n) const { return m_data + static_cast<size_t>(n) * m_step; }
+
+  void resize(unsigned int height, unsigned int width);
+
+private:
+  std::vector<float> m_storage;
+  const float *m_data;
+  unsigned int m_height;
+  unsigned int m_width;
+  unsigned int m_step;
+};
+
+#endif
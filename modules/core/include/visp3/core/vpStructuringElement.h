@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Flat structuring element for mathematical morphology.
+ *
+ *****************************************************************************/
+
+#ifndef _vpStructuringElement_h_
+#define _vpStructuringElement_h_
+
+/*!
+  \file vpStructuringElement.h
+  \brief Flat structuring element for mathematical morphology.
+*/
+
+#include <vector>
+
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpImage.h>
+
+/*!
+  \class vpStructuringElement
+
+  \ingroup group_core_image
+
+  \brief Flat structuring element used by the erosion, dilatation, opening,
+  closing, top-hat and gradient operators of vpImageMorphology.
+
+  A structuring element is a binary mask (non-zero values belong to the
+  element) with an anchor, that is the position of the mask that is aligned
+  with the processed pixel. The factory functions build the usual shapes with
+  an anchor at the center:
+  - rectangle(), horizontalLine() and verticalLine() are processed with the
+    van Herk / Gil-Werman algorithm, whose cost per pixel does not depend on
+    the size of the element;
+  - cross() is processed as the union of a horizontal and a vertical line;
+  - disk() and user-defined elements are decomposed into horizontal runs, each
+    run being processed with the van Herk / Gil-Werman algorithm.
+
+  \code
+#include <visp3/core/vpImageMorphology.h>
+
+int main()
+{
+  vpImage<unsigned char> I(480, 640, 0), I_open;
+  // ...
+  vpImageMorphology::opening(I, I_open, vpStructuringElement::rectangle(15, 15));
+}
+  \endcode
+*/
+class VISP_EXPORT vpStructuringElement
+{
+public:
+  /*! Shape of the structuring element. */
+  typedef enum {
+    SHAPE_RECTANGLE, /*!< Rectangle, including horizontal and vertical lines. */
+    SHAPE_CROSS,     /*!< Union of a horizontal and a vertical line. */
+    SHAPE_DISK,      /*!< Digital disk. */
+    SHAPE_CUSTOM     /*!< User-defined mask. */
+  } vpShapeType;
+
+  /*! Horizontal run of consecutive pixels of the mask. */
+  struct vpRun {
+    int di;              //!< Row of the run relative to the anchor.
+    int dj;              //!< First column of the run relative to the anchor.
+    unsigned int length; //!< Number of pixels of the run.
+  };
+
+  vpStructuringElement();
+  explicit vpStructuringElement(const vpImage<unsigned char> &mask);
+  vpStructuringElement(const vpImage<unsigned char> &mask, unsigned int anchor_i, unsigned int anchor_j);
+
+  static vpStructuringElement cross(unsigned int size);
+  static vpStructuringElement disk(unsigned int radius);
+  static vpStructuringElement horizontalLine(unsigned int length);
+  static vpStructuringElement rectangle(unsigned int width, unsigned int height);
+  static vpStructuringElement verticalLine(unsigned int length);
+
+  /*!
+    Return the row of the anchor in the mask.
+  */
+  unsigned int getAnchorI() const { return m_anchor_i; }
+  /*!
+    Return the column of the anchor in the mask.
+  */
+  unsigned int getAnchorJ() const { return m_anchor_j; }
+  /*!
+    Return the height of the mask.
+  */
+  unsigned int getHeight() const { return m_mask.getHeight(); }
+  /*!
+    Return the mask, non-zero values belong to the structuring element.
+  */
+  const vpImage<unsigned char> &getMask() const { return m_mask; }
+  /*!
+    Return the horizontal runs of the mask, in raster order.
+  */
+  const std::vector<vpRun> &getRuns() const { return m_runs; }
+  /*!
+    Return the shape of the structuring element.
+  */
+  vpShapeType getShape() const { return m_shape; }
+  /*!
+    Return the width of the mask.
+  */
+  unsigned int getWidth() const { return m_mask.getWidth(); }
+
+  vpStructuringElement reflect() const;
+
+private:
+  void init(const vpImage<unsigned char> &mask, unsigned int anchor_i, unsigned int anchor_j, vpShapeType shape);
+
+  vpImage<unsigned char> m_mask;
+  unsigned int m_anchor_i;
+  unsigned int m_anchor_j;
+  vpShapeType m_shape;
+  std::vector<vpRun> m_runs;
+};
+
+#endif
@@ -0,0 +1,144 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed fixed-point undistortion map.
+ *
+ *****************************************************************************/
+
+#ifndef _vpUndistortMap_h_
+#define _vpUndistortMap_h_
+
+/*!
+  \file vpUndistortMap.h
+  \brief Precomputed fixed-point undistortion map.
+*/
+
+#include <string>
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpRGBa.h>
+#include <visp3/core/vpRect.h>
+
+/*!
+  \class vpUndistortMap
+
+  \ingroup group_core_image
+
+  \brief Precomputed undistortion map with fixed-point bilinear weights.
+
+  For each pixel of the output image the map stores the row and the column of
+  the top-left source pixel used for the bilinear interpolation and the four
+  interpolation weights quantized on 16-bit integers (1/128 pixel sub-pixel
+  accuracy, the four weights summing to \f$ 2^{14} \f$). The source pixels are
+  reached through the row pointers of the input image, so that images with a
+  row stride or views are remapped as fast as contiguous images. The data of a
+  row are contiguous, so that
+  remap() only performs integer multiply-accumulate operations that are
+  processed with SSE2 when available, and rows are processed in parallel with
+  vpParallel.
+
+  Besides the plain undistortion, the map can combine the undistortion with a
+  resize and a crop of a region of interest of the undistorted image, all in a
+  single pass. The map can be saved to disk and reloaded to avoid recomputing it
+  at startup.
+
+  \code
+#include <visp3/core/vpUndistortMap.h>
+
+int main()
+{
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(600, 600, 320, 240, -0.2, 0.21);
+
+  vpUndistortMap map(cam, 640, 480);
+  map.save("undistort-640x480.map");
+
+  vpImage<unsigned char> I(480, 640), Iundist;
+  // ... acquire I
+  map.remap(I, Iundist);
+}
+  \endcode
+
+  \sa vpImageTools::initUndistortMap(), vpImageTools::remap()
+*/
+class VISP_EXPORT vpUndistortMap
+{
+public:
+  vpUndistortMap();
+  vpUndistortMap(const vpCameraParameters &cam, unsigned int width, unsigned int height);
+
+  /*!
+    Return the height of the images produced by remap().
+  */
+  unsigned int getHeight() const { return m_dstHeight; }
+  /*!
+    Return the height of the images expected by remap().
+  */
+  unsigned int getSourceHeight() const { return m_srcHeight; }
+  /*!
+    Return the width of the images expected by remap().
+  */
+  unsigned int getSourceWidth() const { return m_srcWidth; }
+  /*!
+    Return the width of the images produced by remap().
+  */
+  unsigned int getWidth() const { return m_dstWidth; }
+
+  void init(const vpCameraParameters &cam, unsigned int width, unsigned int height);
+  void init(const vpCameraParameters &cam, unsigned int srcWidth, unsigned int srcHeight, unsigned int dstWidth,
+            unsigned int dstHeight, const vpRect &roi = vpRect());
+
+  void load(const std::string &filename);
+
+  void remap(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist) const;
+  void remap(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist) const;
+
+  void save(const std::string &filename) const;
+
+private:
+  void checkSourceSize(unsigned int width, unsigned int height) const;
+
+  unsigned int m_srcWidth;
+  unsigned int m_srcHeight;
+  unsigned int m_dstWidth;
+  unsigned int m_dstHeight;
+  //! Column of the top-left source pixel, for each output pixel
+  std::vector<int> m_cols;
+  //! Row of the top-left source pixel, for each output pixel. The source
+  //! pixel is reached through the row pointers, whatever the stride of the image
+  std::vector<int> m_rows;
+  //! Top-left, top-right, bottom-left and bottom-right weights, for each output pixel
+  std::vector<short> m_weights;
+};
+
+#endif
@@ -0,0 +1,276 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Image memory allocators.
+ *
+ *****************************************************************************/
+
+#include <cassert>
+#include <stdlib.h>
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpImageAllocator.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+#define VP_POOL_LOCK vpMutex::vpScopedLock lock(m_mutex)
+#else
+#define VP_POOL_LOCK
+#endif
+
+namespace
+{
+class vpAlignedAllocator : public vpImageAllocator
+{
+public:
+  void *allocate(size_t size, size_t alignment) { return alignedMalloc(size, alignment); }
+  void deallocate(void *ptr, size_t /* size */) { alignedFree(ptr); }
+};
+} // namespace
+
+/*!
+  Allocate a memory block aligned on \e alignment bytes.
+
+  \param size : Size of the block in bytes.
+  \param alignment : Alignment in bytes, a power of two.
+
+  \return Pointer to the block, to release with alignedFree().
+
+  \exception vpException::memoryAllocationError : If the allocation fails.
+*/
+void *vpImageAllocator::alignedMalloc(size_t size, size_t alignment)
+{
+  if (alignment < sizeof(void *)) {
+    alignment = sizeof(void *);
+  }
+  if ((alignment & (alignment - 1)) != 0) {
+    throw(vpException(vpException::badValue, "Alignment %u is not a power of two",
+                      static_cast<unsigned int>(alignment)));
+  }
+  if (size == 0) {
+    size = 1;
+  }
+
+  void *ptr = NULL;
+#if defined(_WIN32)
+  ptr = _aligned_malloc(size, alignment);
+#else
+  if (posix_memalign(&ptr, alignment, size) != 0) {
+    ptr = NULL;
+  }
+#endif
+  if (ptr == NULL) {
+    throw(vpException(vpException::memoryAllocationError, "Cannot allocate %u bytes",
+                      static_cast<unsigned int>(size)));
+  }
+  return ptr;
+}
+
+/*!
+  Release a memory block allocated with alignedMalloc().
+*/
+void vpImageAllocator::alignedFree(void *ptr)
+{
+#if defined(_WIN32)
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+/*!
+  Return the allocator used by the images that request a row alignment without
+  setting an allocator. It allocates aligned blocks on the heap.
+*/
+vpImageAllocator *vpImageAllocator::getDefault()
+{
+  static vpAlignedAllocator allocator;
+  return &allocator;
+}
+
+/*!
+  Header stored in front of each block of a vpImagePoolAllocator.
+*/
+struct vpImagePoolAllocator::vpBlockHeader {
+  //! Pool that allocated the block
+  const vpImagePoolAllocator *owner;
+  //! Pointer returned by alignedMalloc()
+  void *base;
+  //! Size of the block given to allocate()
+  size_t size;
+  //! Alignment of the block
+  size_t alignment;
+  //! Next released block of the same size class
+  vpBlockHeader *next;
+};
+
+/*!
+  Return the index of the list of released blocks of \e size bytes.
+*/
+unsigned int vpImagePoolAllocator::getSizeClass(size_t size)
+{
+  return static_cast<unsigned int>((size ^ (size >> 12)) % nb_size_classes);
+}
+
+/*!
+  Create a pool allocator.
+
+  \param maxCachedSize : Maximum number of bytes kept in the pool for reuse.
+  Released blocks that would exceed this amount are freed. 0 means no limit.
+*/
+vpImagePoolAllocator::vpImagePoolAllocator(size_t maxCachedSize)
+  : m_cachedSize(0), m_maxCachedSize(maxCachedSize), m_nbReuses(0)
+#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
+    , m_mutex()
+#endif
+{
+  for (unsigned int i = 0; i < nb_size_classes; i++) {
+    m_freeBlocks[i] = NULL;
+  }
+}
+
+/*!
+  Destructor. Free the blocks of the pool. The images using this allocator
+  must have been destroyed before.
+*/
+vpImagePoolAllocator::~vpImagePoolAllocator() { clear(); }
+
+/*!
+  Return a block of the pool of the requested size and alignment if any,
+  otherwise allocate a new one.
+
+  \param size : Size of the block in bytes.
+  \param alignment : Alignment of the block in bytes, a power of two.
+
+  \exception vpException::memoryAllocationError : If the allocation fails.
+*/
+void *vpImagePoolAllocator::allocate(size_t size, size_t alignment)
+{
+  if (alignment < sizeof(void *)) {
+    alignment = sizeof(void *);
+  }
+
+  {
+    VP_POOL_LOCK;
+
+    vpBlockHeader **prev = &m_freeBlocks[getSizeClass(size)];
+    for (vpBlockHeader *header = *prev; header != NULL; prev = &header->next, header = header->next) {
+      if (header->size == size && header->alignment >= alignment) {
+        *prev = header->next;
+        header->next = NULL;
+        m_cachedSize -= size;
+        m_nbReuses++;
+        return header + 1;
+      }
+    }
+  }
+
+  // The header is just before the returned pointer, that keeps the alignment
+  const size_t offset = ((sizeof(vpBlockHeader) + alignment - 1) / alignment) * alignment;
+  void *base = alignedMalloc(offset + size, alignment);
+  vpBlockHeader *header = reinterpret_cast<vpBlockHeader *>(static_cast<unsigned char *>(base) + offset) - 1;
+  header->owner = this;
+  header->base = base;
+  header->size = size;
+  header->alignment = alignment;
+  header->next = NULL;
+  return header + 1;
+}
+
+/*!
+  Free all the blocks kept in the pool.
+*/
+void vpImagePoolAllocator::clear()
+{
+  VP_POOL_LOCK;
+
+  for (unsigned int i = 0; i < nb_size_classes; i++) {
+    vpBlockHeader *header = m_freeBlocks[i];
+    while (header != NULL) {
+      vpBlockHeader *next = header->next;
+      alignedFree(header->base);
+      header = next;
+    }
+    m_freeBlocks[i] = NULL;
+  }
+  m_cachedSize = 0;
+}
+
+/*!
+  Give back a block to the pool, or free it if the pool is full.
+
+  This function does not throw and does not allocate, since it is called from
+  the destructor of the images.
+
+  \param ptr : Pointer to the block, returned by allocate() of this pool.
+  \param size : Size of the block in bytes.
+*/
+void vpImagePoolAllocator::deallocate(void *ptr, size_t size)
+{
+  vpBlockHeader *header = static_cast<vpBlockHeader *>(ptr) - 1;
+  assert(header->owner == this && header->size == size && "Memory block not allocated by this pool");
+
+  try {
+    VP_POOL_LOCK;
+
+    if (m_maxCachedSize == 0 || m_cachedSize + size <= m_maxCachedSize) {
+      vpBlockHeader *&head = m_freeBlocks[getSizeClass(size)];
+      header->next = head;
+      head = header;
+      m_cachedSize += size;
+      return;
+    }
+  } catch (...) {
+    // The mutex could not be locked: the block is freed
+  }
+  alignedFree(header->base);
+}
+
+/*!
+  Return the number of bytes kept in the pool for reuse.
+*/
+size_t vpImagePoolAllocator::getCachedSize() const
+{
+  VP_POOL_LOCK;
+  return m_cachedSize;
+}
+
+/*!
+  Return the number of allocations served with a block of the pool.
+*/
+unsigned int vpImagePoolAllocator::getNbReuses() const
+{
+  VP_POOL_LOCK;
+  return m_nbReuses;
+}
@@ -43,12 +43,16 @@
   \brief Convert image types
 */
 
+#include <algorithm>
 #include <map>
 #include <sstream>
+#include <string.h>
+#include <vector>
 
 // image
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpParallel.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
@@ -64,12 +68,501 @@
 #endif
 #endif
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
 bool vpImageConvert::YCbCrLUTcomputed = false;
 int vpImageConvert::vpCrr[256];
 int vpImageConvert::vpCgb[256];
 int vpImageConvert::vpCgr[256];
 int vpImageConvert::vpCbb[256];
 
+namespace
+{
+/*
+  Row kernels shared by the YUV to RGB(a) conversions.
+
+  A row is converted in two steps: the contributions of the chroma to R, G and
+  B are first computed once per chroma sample, then added to the luminance of
+  the pixels sharing this sample, with saturation. Both steps reproduce the
+  integer arithmetic of the original per-pixel loops, so that the SIMD and
+  scalar paths give the same results.
+*/
+
+bool useSIMD()
+{
+#if VISP_HAVE_SSE2
+  return vpCPUFeatures::checkSSE2();
+#elif VISP_HAVE_NEON
+  return vpCPUFeatures::checkNEON();
+#else
+  return false;
+#endif
+}
+
+enum vpYuvCoefficients {
+  //! R = Y + 2 V, G = Y - U - V, B = Y + 5 U with U = 0.354 (u - 128) and V = 0.707 (v - 128)
+  YUV_COEFF_DEFAULT,
+  //! Coefficients of the YUYV conversions
+  YUV_COEFF_YUYV
+};
+
+// Number of extra elements of the row buffers, to allow vector loads at the end of a row
+const unsigned int yuv_row_padding = 16;
+
+// Chroma contributions for n chroma samples: R = Y + cr, G = Y + cg, B = Y + cb
+void yuvChromaTerms(const unsigned char *u, const unsigned char *v, unsigned int n, short *cr, short *cg, short *cb,
+                    vpYuvCoefficients coeffs, bool simd)
+{
+  unsigned int i = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i offset = _mm_set1_epi16(128);
+    for (; i + 8 <= n; i += 8) {
+      const __m128i du = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(u + i)), zero), offset);
+      const __m128i dv = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(v + i)), zero), offset);
+      __m128i r, g, b;
+      if (coeffs == YUV_COEFF_DEFAULT) {
+        // (int)(0.354 du) and (int)(0.707 dv) computed on the absolute values, exact for |d| <= 128
+        const __m128i su = _mm_srai_epi16(du, 15);
+        const __m128i sv = _mm_srai_epi16(dv, 15);
+        __m128i U = _mm_mulhi_epu16(_mm_sub_epi16(_mm_xor_si128(du, su), su), _mm_set1_epi16(23200));
+        __m128i V = _mm_mulhi_epu16(_mm_sub_epi16(_mm_xor_si128(dv, sv), sv), _mm_set1_epi16((short)46334));
+        U = _mm_sub_epi16(_mm_xor_si128(U, su), su);
+        V = _mm_sub_epi16(_mm_xor_si128(V, sv), sv);
+        r = _mm_add_epi16(V, V);
+        g = _mm_sub_epi16(_mm_sub_epi16(zero, U), V);
+        b = _mm_add_epi16(_mm_slli_epi16(U, 2), U);
+      } else {
+        // (d * c) >> 8 written as ((4 d) * (64 c)) >> 16
+        r = _mm_mulhi_epi16(_mm_slli_epi16(dv, 2), _mm_set1_epi16(359 * 64));
+        b = _mm_mulhi_epi16(_mm_slli_epi16(du, 2), _mm_set1_epi16(454 * 64));
+        const __m128i coeff_g = _mm_set1_epi32((183 << 16) | 88);
+        const __m128i g_lo = _mm_srai_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(du, dv), coeff_g), 8);
+        const __m128i g_hi = _mm_srai_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(du, dv), coeff_g), 8);
+        g = _mm_sub_epi16(zero, _mm_packs_epi32(g_lo, g_hi));
+      }
+      _mm_storeu_si128((__m128i *)(cr + i), r);
+      _mm_storeu_si128((__m128i *)(cg + i), g);
+      _mm_storeu_si128((__m128i *)(cb + i), b);
+    }
+#elif VISP_HAVE_NEON
+    for (; i + 8 <= n; i += 8) {
+      const int16x8_t du = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(u + i), vdup_n_u8(128)));
+      const int16x8_t dv = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(v + i), vdup_n_u8(128)));
+      int16x8_t r, g, b;
+      if (coeffs == YUV_COEFF_DEFAULT) {
+        // (int)(0.354 du) and (int)(0.707 dv) computed on the absolute values, exact for |d| <= 128
+        const uint16x8_t au = vreinterpretq_u16_s16(vabsq_s16(du));
+        const uint16x8_t av = vreinterpretq_u16_s16(vabsq_s16(dv));
+        const int16x8_t Ua = vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(au), 23200), 16),
+                                                                vshrn_n_u32(vmull_n_u16(vget_high_u16(au), 23200), 16)));
+        const int16x8_t Va = vreinterpretq_s16_u16(vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(av), 46334), 16),
+                                                                vshrn_n_u32(vmull_n_u16(vget_high_u16(av), 46334), 16)));
+        const int16x8_t U = vbslq_s16(vcltq_s16(du, vdupq_n_s16(0)), vnegq_s16(Ua), Ua);
+        const int16x8_t V = vbslq_s16(vcltq_s16(dv, vdupq_n_s16(0)), vnegq_s16(Va), Va);
+        r = vaddq_s16(V, V);
+        g = vnegq_s16(vaddq_s16(U, V));
+        b = vaddq_s16(vshlq_n_s16(U, 2), U);
+      } else {
+        r = vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(dv), 359), 8),
+                         vshrn_n_s32(vmull_n_s16(vget_high_s16(dv), 359), 8));
+        b = vcombine_s16(vshrn_n_s32(vmull_n_s16(vget_low_s16(du), 454), 8),
+                         vshrn_n_s32(vmull_n_s16(vget_high_s16(du), 454), 8));
+        const int32x4_t g_lo = vmlal_n_s16(vmull_n_s16(vget_low_s16(du), 88), vget_low_s16(dv), 183);
+        const int32x4_t g_hi = vmlal_n_s16(vmull_n_s16(vget_high_s16(du), 88), vget_high_s16(dv), 183);
+        g = vnegq_s16(vcombine_s16(vshrn_n_s32(g_lo, 8), vshrn_n_s32(g_hi, 8)));
+      }
+      vst1q_s16(cr + i, r);
+      vst1q_s16(cg + i, g);
+      vst1q_s16(cb + i, b);
+    }
+#endif
+  }
+
+  for (; i < n; i++) {
+    const int du = u[i] - 128;
+    const int dv = v[i] - 128;
+    if (coeffs == YUV_COEFF_DEFAULT) {
+      const int U = (int)(du * 0.354);
+      const int V = (int)(dv * 0.707);
+      cr[i] = static_cast<short>(2 * V);
+      cg[i] = static_cast<short>(-U - V);
+      cb[i] = static_cast<short>(5 * U);
+    } else {
+      cr[i] = static_cast<short>((dv * 359) >> 8);
+      cg[i] = static_cast<short>(-((du * 88 + dv * 183) >> 8));
+      cb[i] = static_cast<short>((du * 454) >> 8);
+    }
+  }
+}
+
+#if VISP_HAVE_SSE2
+// Load the chroma contributions of 8 consecutive pixels, a chroma sample being shared by 1 << shift pixels
+inline __m128i yuvLoadTerms(const short *t, unsigned int shift)
+{
+  if (shift == 0) {
+    return _mm_loadu_si128((const __m128i *)t);
+  }
+  if (shift == 1) {
+    const __m128i t4 = _mm_loadl_epi64((const __m128i *)t);
+    return _mm_unpacklo_epi16(t4, t4);
+  }
+  int t2;
+  memcpy(&t2, t, sizeof(t2));
+  const __m128i t22 = _mm_unpacklo_epi16(_mm_cvtsi32_si128(t2), _mm_cvtsi32_si128(t2));
+  return _mm_unpacklo_epi32(t22, t22);
+}
+#elif VISP_HAVE_NEON
+inline int16x8_t yuvLoadTerms(const short *t, unsigned int shift)
+{
+  if (shift == 0) {
+    return vld1q_s16(t);
+  }
+  const int16x4_t t4 = vld1_s16(t);
+  const int16x4x2_t t44 = vzip_s16(t4, t4);
+  if (shift == 1) {
+    return vcombine_s16(t44.val[0], t44.val[1]);
+  }
+  const int16x4x2_t t4444 = vzip_s16(t44.val[0], t44.val[0]);
+  return vcombine_s16(t4444.val[0], t4444.val[1]);
+}
+#endif
+
+inline unsigned char yuvSaturate(int c) { return static_cast<unsigned char>(c < 0 ? 0 : (c > 255 ? 255 : c)); }
+
+// Convert n pixels whose chroma contributions are shared by 1 << shift consecutive pixels to RGBa or RGB
+void yuvToRGBRow(const unsigned char *y, const short *cr, const short *cg, const short *cb, unsigned int n,
+                 unsigned int shift, unsigned char *dst, bool alpha, bool simd)
+{
+  const unsigned int nc = alpha ? 4 : 3;
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+    for (; j + 8 <= n; j += 8) {
+      const unsigned int c = j >> shift;
+      const __m128i yv = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(y + j)), zero);
+      const __m128i r = _mm_packus_epi16(_mm_add_epi16(yv, yuvLoadTerms(cr + c, shift)), zero);
+      const __m128i g = _mm_packus_epi16(_mm_add_epi16(yv, yuvLoadTerms(cg + c, shift)), zero);
+      const __m128i b = _mm_packus_epi16(_mm_add_epi16(yv, yuvLoadTerms(cb + c, shift)), zero);
+      const __m128i rg = _mm_unpacklo_epi8(r, g);
+      const __m128i ba = _mm_unpacklo_epi8(b, a);
+      const __m128i rgba_lo = _mm_unpacklo_epi16(rg, ba);
+      const __m128i rgba_hi = _mm_unpackhi_epi16(rg, ba);
+      if (alpha) {
+        _mm_storeu_si128((__m128i *)(dst + 4 * j), rgba_lo);
+        _mm_storeu_si128((__m128i *)(dst + 4 * j + 16), rgba_hi);
+      } else {
+        unsigned char buf[32];
+        _mm_storeu_si128((__m128i *)buf, rgba_lo);
+        _mm_storeu_si128((__m128i *)(buf + 16), rgba_hi);
+        for (unsigned int k = 0; k < 8; k++) {
+          dst[3 * (j + k)] = buf[4 * k];
+          dst[3 * (j + k) + 1] = buf[4 * k + 1];
+          dst[3 * (j + k) + 2] = buf[4 * k + 2];
+        }
+      }
+    }
+#elif VISP_HAVE_NEON
+    for (; j + 8 <= n; j += 8) {
+      const unsigned int c = j >> shift;
+      const int16x8_t yv = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(y + j)));
+      const uint8x8_t r = vqmovun_s16(vaddq_s16(yv, yuvLoadTerms(cr + c, shift)));
+      const uint8x8_t g = vqmovun_s16(vaddq_s16(yv, yuvLoadTerms(cg + c, shift)));
+      const uint8x8_t b = vqmovun_s16(vaddq_s16(yv, yuvLoadTerms(cb + c, shift)));
+      if (alpha) {
+        uint8x8x4_t px;
+        px.val[0] = r;
+        px.val[1] = g;
+        px.val[2] = b;
+        px.val[3] = vdup_n_u8(vpRGBa::alpha_default);
+        vst4_u8(dst + 4 * j, px);
+      } else {
+        uint8x8x3_t px;
+        px.val[0] = r;
+        px.val[1] = g;
+        px.val[2] = b;
+        vst3_u8(dst + 3 * j, px);
+      }
+    }
+#endif
+  }
+
+  for (; j < n; j++) {
+    const int Y = y[j];
+    const unsigned int c = j >> shift;
+    unsigned char *d = dst + nc * j;
+    d[0] = yuvSaturate(Y + cr[c]);
+    d[1] = yuvSaturate(Y + cg[c]);
+    d[2] = yuvSaturate(Y + cb[c]);
+    if (alpha) {
+      d[3] = vpRGBa::alpha_default;
+    }
+  }
+}
+
+// Per-row buffers used to deinterleave the packed formats and to store the chroma contributions
+struct vpYuvRowBuffers {
+  explicit vpYuvRowBuffers(unsigned int n)
+    : y(n + yuv_row_padding), u(n + yuv_row_padding), v(n + yuv_row_padding), cr(n + yuv_row_padding),
+      cg(n + yuv_row_padding), cb(n + yuv_row_padding)
+  {
+  }
+
+  std::vector<unsigned char> y, u, v;
+  std::vector<short> cr, cg, cb;
+};
+
+enum vpYuvFormat {
+  YUV_FORMAT_YUYV,   //!< y0 u01 y1 v01
+  YUV_FORMAT_YUV411, //!< u y0 y1 v y2 y3
+  YUV_FORMAT_YUV422, //!< u y0 v y1
+  YUV_FORMAT_YUV444, //!< u y v
+  YUV_FORMAT_YUV420, //!< planar Y, U(1/2 x 1/2), V(1/2 x 1/2)
+  YUV_FORMAT_YV12,   //!< planar Y, V(1/2 x 1/2), U(1/2 x 1/2)
+  YUV_FORMAT_YVU9    //!< planar Y, V(1/4 x 1/4), U(1/4 x 1/4)
+};
+
+// Number of pixels of the chunks used to process the packed formats
+const unsigned int yuv_chunk_size = 4096;
+
+/*
+  Full resolution conversion. Packed formats are processed by chunks of
+  yuv_chunk_size pixels, the index range being the chunk index; planar
+  formats are processed by rows.
+*/
+class vpYuvToRGBBody : public vpParallelBody
+{
+public:
+  vpYuvToRGBBody(vpYuvFormat format, const unsigned char *yuv, unsigned char *dst, unsigned int width,
+                 unsigned int height, bool alpha)
+    : m_format(format), m_yuv(yuv), m_dst(dst), m_width(width), m_height(height), m_alpha(alpha), m_simd(useSIMD())
+  {
+  }
+
+  // Number of indices of the parallel range
+  unsigned int size() const
+  {
+    switch (m_format) {
+    case YUV_FORMAT_YUV420:
+    case YUV_FORMAT_YV12:
+      return m_height & ~1u;
+    case YUV_FORMAT_YVU9:
+      return m_height & ~3u;
+    default:
+      return (m_width * m_height + yuv_chunk_size - 1) / yuv_chunk_size;
+    }
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int nc = m_alpha ? 4 : 3;
+    const bool planar = m_format == YUV_FORMAT_YUV420 || m_format == YUV_FORMAT_YV12 || m_format == YUV_FORMAT_YVU9;
+    vpYuvRowBuffers buf(planar ? m_width : yuv_chunk_size);
+    const unsigned int npixels = m_width * m_height;
+
+    for (unsigned int i = begin; i < end; i++) {
+      if (planar) {
+        const unsigned int shift = m_format == YUV_FORMAT_YVU9 ? 2 : 1;
+        const unsigned int cw = m_width >> shift;
+        const unsigned int csize = cw * (m_height >> shift);
+        const unsigned char *y = m_yuv + i * m_width;
+        const unsigned char *u = m_yuv + npixels + (m_format == YUV_FORMAT_YUV420 ? 0 : csize);
+        const unsigned char *v = m_yuv + npixels + (m_format == YUV_FORMAT_YUV420 ? csize : 0);
+        u += (i >> shift) * cw;
+        v += (i >> shift) * cw;
+        yuvChromaTerms(u, v, cw, &buf.cr[0], &buf.cg[0], &buf.cb[0], YUV_COEFF_DEFAULT, m_simd);
+        yuvToRGBRow(y, &buf.cr[0], &buf.cg[0], &buf.cb[0], cw << shift, shift, m_dst + nc * i * m_width, m_alpha,
+                    m_simd);
+        continue;
+      }
+
+      const unsigned int first = i * yuv_chunk_size;
+      unsigned int n = std::min(yuv_chunk_size, npixels - first);
+      unsigned char *yb = &buf.y[0], *ub = &buf.u[0], *vb = &buf.v[0];
+      unsigned int shift = 1;
+      vpYuvCoefficients coeffs = YUV_COEFF_DEFAULT;
+      switch (m_format) {
+      case YUV_FORMAT_YUYV: {
+        n &= ~1u;
+        const unsigned char *s = m_yuv + 2 * first;
+        for (unsigned int k = 0; k < n / 2; k++, s += 4) {
+          yb[2 * k] = s[0];
+          ub[k] = s[1];
+          yb[2 * k + 1] = s[2];
+          vb[k] = s[3];
+        }
+        coeffs = YUV_COEFF_YUYV;
+        break;
+      }
+      case YUV_FORMAT_YUV411: {
+        n &= ~3u;
+        const unsigned char *s = m_yuv + 3 * first / 2;
+        for (unsigned int k = 0; k < n / 4; k++, s += 6) {
+          ub[k] = s[0];
+          yb[4 * k] = s[1];
+          yb[4 * k + 1] = s[2];
+          vb[k] = s[3];
+          yb[4 * k + 2] = s[4];
+          yb[4 * k + 3] = s[5];
+        }
+        shift = 2;
+        break;
+      }
+      case YUV_FORMAT_YUV422: {
+        n &= ~1u;
+        const unsigned char *s = m_yuv + 2 * first;
+        for (unsigned int k = 0; k < n / 2; k++, s += 4) {
+          ub[k] = s[0];
+          yb[2 * k] = s[1];
+          vb[k] = s[2];
+          yb[2 * k + 1] = s[3];
+        }
+        break;
+      }
+      default: { // YUV_FORMAT_YUV444
+        const unsigned char *s = m_yuv + 3 * first;
+        for (unsigned int k = 0; k < n; k++, s += 3) {
+          ub[k] = s[0];
+          yb[k] = s[1];
+          vb[k] = s[2];
+        }
+        shift = 0;
+        break;
+      }
+      }
+      yuvChromaTerms(ub, vb, n >> shift, &buf.cr[0], &buf.cg[0], &buf.cb[0], coeffs, m_simd);
+      yuvToRGBRow(yb, &buf.cr[0], &buf.cg[0], &buf.cb[0], n, shift, m_dst + nc * first, m_alpha, m_simd);
+    }
+  }
+
+private:
+  vpYuvFormat m_format;
+  const unsigned char *m_yuv;
+  unsigned char *m_dst;
+  unsigned int m_width;
+  unsigned int m_height;
+  bool m_alpha;
+  bool m_simd;
+};
+
+void yuvToRGB(vpYuvFormat format, const unsigned char *yuv, unsigned char *dst, unsigned int width,
+              unsigned int height, bool alpha)
+{
+  vpYuvToRGBBody body(format, yuv, dst, width, height, alpha);
+  vpParallel::parallelFor(0, body.size(), body);
+}
+
+/*
+  Conversion fused with a downscale by 2: each output pixel is computed from
+  the average of a 2x2 block of luminance samples and the chroma of the block.
+  Processed by output rows.
+*/
+class vpYuvToRGBHalfSizeBody : public vpParallelBody
+{
+public:
+  vpYuvToRGBHalfSizeBody(vpYuvFormat format, const unsigned char *yuv, unsigned char *dst, unsigned int width,
+                         unsigned int height, bool grey)
+    : m_format(format), m_yuv(yuv), m_dst(dst), m_width(width), m_height(height), m_grey(grey), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int w = m_width / 2;
+    vpYuvRowBuffers buf(w);
+    unsigned char *yb = &buf.y[0], *ub = &buf.u[0], *vb = &buf.v[0];
+
+    for (unsigned int i = begin; i < end; i++) {
+      unsigned char *dst = m_dst + (m_grey ? 1 : 4) * i * w;
+      if (m_format == YUV_FORMAT_YUV420) {
+        const unsigned char *y0 = m_yuv + 2 * i * m_width;
+        const unsigned char *y1 = y0 + m_width;
+        for (unsigned int j = 0; j < w; j++) {
+          yb[j] = static_cast<unsigned char>((y0[2 * j] + y0[2 * j + 1] + y1[2 * j] + y1[2 * j + 1] + 2) >> 2);
+        }
+        if (!m_grey) {
+          const unsigned int csize = w * (m_height / 2);
+          ub = const_cast<unsigned char *>(m_yuv) + m_width * m_height + i * w;
+          vb = ub + csize;
+        }
+      } else {
+        // YUYV (y0 u y1 v) or YUV422 (u y0 v y1) rows of 2 * width bytes
+        const unsigned int yo = m_format == YUV_FORMAT_YUYV ? 0 : 1;
+        const unsigned int uo = m_format == YUV_FORMAT_YUYV ? 1 : 0;
+        const unsigned char *s0 = m_yuv + 4 * i * m_width;
+        const unsigned char *s1 = s0 + 2 * m_width;
+        for (unsigned int j = 0; j < w; j++) {
+          const unsigned int k = 4 * j;
+          yb[j] = static_cast<unsigned char>((s0[k + yo] + s0[k + yo + 2] + s1[k + yo] + s1[k + yo + 2] + 2) >> 2);
+          ub[j] = static_cast<unsigned char>((s0[k + uo] + s1[k + uo] + 1) >> 1);
+          vb[j] = static_cast<unsigned char>((s0[k + uo + 2] + s1[k + uo + 2] + 1) >> 1);
+        }
+      }
+
+      if (m_grey) {
+        memcpy(dst, yb, w);
+      } else {
+        const vpYuvCoefficients coeffs = m_format == YUV_FORMAT_YUYV ? YUV_COEFF_YUYV : YUV_COEFF_DEFAULT;
+        yuvChromaTerms(ub, vb, w, &buf.cr[0], &buf.cg[0], &buf.cb[0], coeffs, m_simd);
+        yuvToRGBRow(yb, &buf.cr[0], &buf.cg[0], &buf.cb[0], w, 0, dst, true, m_simd);
+      }
+    }
+  }
+
+private:
+  vpYuvFormat m_format;
+  const unsigned char *m_yuv;
+  unsigned char *m_dst;
+  unsigned int m_width;
+  unsigned int m_height;
+  bool m_grey;
+  bool m_simd;
+};
+
+void yuvToRGBHalfSize(vpYuvFormat format, const unsigned char *yuv, unsigned char *dst, unsigned int width,
+                      unsigned int height, bool grey)
+{
+  vpParallel::parallelFor(0, height / 2, vpYuvToRGBHalfSizeBody(format, yuv, dst, width, height, grey));
+}
+
+// Extract one byte every 2 bytes, starting at offset (0 or 1)
+void extractEvenOdd(const unsigned char *src, unsigned char *dst, unsigned int n, unsigned int offset)
+{
+  unsigned int i = 0;
+  if (useSIMD()) {
+#if VISP_HAVE_SSE2
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    for (; i + 16 <= n; i += 16) {
+      __m128i a = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+      __m128i b = _mm_loadu_si128((const __m128i *)(src + 2 * i + 16));
+      if (offset) {
+        a = _mm_srli_epi16(a, 8);
+        b = _mm_srli_epi16(b, 8);
+      } else {
+        a = _mm_and_si128(a, mask);
+        b = _mm_and_si128(b, mask);
+      }
+      _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(a, b));
+    }
+#elif VISP_HAVE_NEON
+    for (; i + 16 <= n; i += 16) {
+      const uint8x16x2_t v = vld2q_u8(src + 2 * i);
+      vst1q_u8(dst + i, offset ? v.val[1] : v.val[0]);
+    }
+#endif
+  }
+  for (; i < n; i++) {
+    dst[i] = src[2 * i + offset];
+  }
+}
+} // namespace
+
 /*!
   Convert a vpImage\<unsigned char\> to a vpImage\<vpRGBa\>.
   Tha alpha component is set to vpRGBa::alpha_default.
@@ -80,7 +573,13 @@ void vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<vpRGBa>
 {
   dest.resize(src.getHeight(), src.getWidth());
 
-  GreyToRGBa(src.bitmap, (unsigned char *)dest.bitmap, src.getHeight() * src.getWidth());
+  if (src.isContiguous() && dest.isContiguous()) {
+    GreyToRGBa(src.bitmap, (unsigned char *)dest.bitmap, src.getHeight() * src.getWidth());
+  } else {
+    for (unsigned int i = 0; i < src.getHeight(); i++) {
+      GreyToRGBa(const_cast<unsigned char *>(src[i]), (unsigned char *)dest[i], src.getWidth());
+    }
+  }
 }
 
 /*!
@@ -92,7 +591,13 @@ void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char>
 {
   dest.resize(src.getHeight(), src.getWidth());
 
-  RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
+  if (src.isContiguous() && dest.isContiguous()) {
+    RGBaToGrey((unsigned char *)src.bitmap, dest.bitmap, src.getHeight() * src.getWidth());
+  } else {
+    for (unsigned int i = 0; i < src.getHeight(); i++) {
+      RGBaToGrey((unsigned char *)src[i], dest[i], src.getWidth());
+    }
+  }
 }
 
 /*!
@@ -102,19 +607,20 @@ void vpImageConvert::convert(const vpImage<vpRGBa> &src, vpImage<unsigned char>
 void vpImageConvert::convert(const vpImage<float> &src, vpImage<unsigned char> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth());
-  unsigned int max_xy = src.getWidth() * src.getHeight();
   float min, max;
 
   src.getMinMaxValue(min, max);
 
-  for (unsigned int i = 0; i < max_xy; i++) {
-    float val = 255.f * (src.bitmap[i] - min) / (max - min);
-    if (val < 0)
-      dest.bitmap[i] = 0;
-    else if (val > 255)
-      dest.bitmap[i] = 255;
-    else
-      dest.bitmap[i] = (unsigned char)val;
+  for (unsigned int i = 0; i < src.getHeight(); i++) {
+    for (unsigned int j = 0; j < src.getWidth(); j++) {
+      float val = 255.f * (src[i][j] - min) / (max - min);
+      if (val < 0)
+        dest[i][j] = 0;
+      else if (val > 255)
+        dest[i][j] = 255;
+      else
+        dest[i][j] = (unsigned char)val;
+    }
   }
 }
 
@@ -126,8 +632,9 @@ Convert a vpImage\<unsigned char\> to a vpImage\<float\> by basic casting.
 void vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<float> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth());
-  for (unsigned int i = 0; i < src.getHeight() * src.getWidth(); i++)
-    dest.bitmap[i] = (float)src.bitmap[i];
+  for (unsigned int i = 0; i < src.getHeight(); i++)
+    for (unsigned int j = 0; j < src.getWidth(); j++)
+      dest[i][j] = (float)src[i][j];
 }
 
 /*!
@@ -137,19 +644,20 @@ between 0 and 255. \param src : source image \param dest : destination image
 void vpImageConvert::convert(const vpImage<double> &src, vpImage<unsigned char> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth());
-  unsigned int max_xy = src.getWidth() * src.getHeight();
   double min, max;
 
   src.getMinMaxValue(min, max);
 
-  for (unsigned int i = 0; i < max_xy; i++) {
-    double val = 255. * (src.bitmap[i] - min) / (max - min);
-    if (val < 0)
-      dest.bitmap[i] = 0;
-    else if (val > 255)
-      dest.bitmap[i] = 255;
-    else
-      dest.bitmap[i] = (unsigned char)val;
+  for (unsigned int i = 0; i < src.getHeight(); i++) {
+    for (unsigned int j = 0; j < src.getWidth(); j++) {
+      double val = 255. * (src[i][j] - min) / (max - min);
+      if (val < 0)
+        dest[i][j] = 0;
+      else if (val > 255)
+        dest[i][j] = 255;
+      else
+        dest[i][j] = (unsigned char)val;
+    }
   }
 }
 
@@ -162,8 +670,9 @@ void vpImageConvert::convert(const vpImage<uint16_t> &src, vpImage<unsigned char
 {
   dest.resize(src.getHeight(), src.getWidth());
 
-  for (unsigned int i = 0; i < src.getSize(); i++)
-    dest.bitmap[i] = (src.bitmap[i] >> 8);
+  for (unsigned int i = 0; i < src.getHeight(); i++)
+    for (unsigned int j = 0; j < src.getWidth(); j++)
+      dest[i][j] = (src[i][j] >> 8);
 }
 
 /*!
@@ -175,8 +684,9 @@ void vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<uint16_t
 {
   dest.resize(src.getHeight(), src.getWidth());
 
-  for (unsigned int i = 0; i < src.getSize(); i++)
-    dest.bitmap[i] = (src.bitmap[i] << 8);
+  for (unsigned int i = 0; i < src.getHeight(); i++)
+    for (unsigned int j = 0; j < src.getWidth(); j++)
+      dest[i][j] = (src[i][j] << 8);
 }
 
 /*!
@@ -187,8 +697,9 @@ Convert a vpImage\<unsigned char\> to a vpImage\<double\> by basic casting.
 void vpImageConvert::convert(const vpImage<unsigned char> &src, vpImage<double> &dest)
 {
   dest.resize(src.getHeight(), src.getWidth());
-  for (unsigned int i = 0; i < src.getHeight() * src.getWidth(); i++)
-    dest.bitmap[i] = (double)src.bitmap[i];
+  for (unsigned int i = 0; i < src.getHeight(); i++)
+    for (unsigned int j = 0; j < src.getWidth(); j++)
+      dest[i][j] = (double)src[i][j];
 }
 
 /*!
@@ -204,25 +715,28 @@ void vpImageConvert::createDepthHistogram(const vpImage<uint16_t> &src_depth, vp
   static uint32_t histogram[0x10000];
   memset(histogram, 0, sizeof(histogram));
 
-  for (unsigned int i = 0; i < src_depth.getSize(); ++i)
-    ++histogram[src_depth.bitmap[i]];
+  for (unsigned int i = 0; i < src_depth.getHeight(); ++i)
+    for (unsigned int j = 0; j < src_depth.getWidth(); ++j)
+      ++histogram[src_depth[i][j]];
   for (int i = 2; i < 0x10000; ++i)
     histogram[i] += histogram[i - 1]; // Build a cumulative histogram for the
                                       // indices in [1,0xFFFF]
 
-  for (unsigned int i = 0; i < src_depth.getSize(); ++i) {
-    uint16_t d = src_depth.bitmap[i];
-    if (d) {
-      int f = (int)(histogram[d] * 255 / histogram[0xFFFF]); // 0-255 based on histogram location
-      dest_rgba.bitmap[i].R = 255 - f;
-      dest_rgba.bitmap[i].G = 0;
-      dest_rgba.bitmap[i].B = f;
-      dest_rgba.bitmap[i].A = vpRGBa::alpha_default;
-    } else {
-      dest_rgba.bitmap[i].R = 20;
-      dest_rgba.bitmap[i].G = 5;
-      dest_rgba.bitmap[i].B = 0;
-      dest_rgba.bitmap[i].A = vpRGBa::alpha_default;
+  for (unsigned int i = 0; i < src_depth.getHeight(); ++i) {
+    for (unsigned int j = 0; j < src_depth.getWidth(); ++j) {
+      uint16_t d = src_depth[i][j];
+      if (d) {
+        int f = (int)(histogram[d] * 255 / histogram[0xFFFF]); // 0-255 based on histogram location
+        dest_rgba[i][j].R = 255 - f;
+        dest_rgba[i][j].G = 0;
+        dest_rgba[i][j].B = f;
+        dest_rgba[i][j].A = vpRGBa::alpha_default;
+      } else {
+        dest_rgba[i][j].R = 20;
+        dest_rgba[i][j].G = 5;
+        dest_rgba[i][j].B = 0;
+        dest_rgba[i][j].A = vpRGBa::alpha_default;
+      }
     }
   }
 }
@@ -239,19 +753,22 @@ void vpImageConvert::createDepthHistogram(const vpImage<uint16_t> &src_depth, vp
   static uint32_t histogram2[0x10000];
   memset(histogram2, 0, sizeof(histogram2));
 
-  for (unsigned int i = 0; i < src_depth.getSize(); ++i)
-    ++histogram2[src_depth.bitmap[i]];
+  for (unsigned int i = 0; i < src_depth.getHeight(); ++i)
+    for (unsigned int j = 0; j < src_depth.getWidth(); ++j)
+      ++histogram2[src_depth[i][j]];
   for (int i = 2; i < 0x10000; ++i)
     histogram2[i] += histogram2[i - 1]; // Build a cumulative histogram for
                                         // the indices in [1,0xFFFF]
 
-  for (unsigned int i = 0; i < src_depth.getSize(); ++i) {
-    uint16_t d = src_depth.bitmap[i];
-    if (d) {
-      unsigned char f = static_cast<unsigned char>(histogram2[d] * 255 / histogram2[0xFFFF]); // 0-255 based on histogram location
-      dest_depth.bitmap[i] = f;
-    } else {
-      dest_depth.bitmap[i] = 0;
+  for (unsigned int i = 0; i < src_depth.getHeight(); ++i) {
+    for (unsigned int j = 0; j < src_depth.getWidth(); ++j) {
+      uint16_t d = src_depth[i][j];
+      if (d) {
+        unsigned char f = static_cast<unsigned char>(histogram2[d] * 255 / histogram2[0xFFFF]); // 0-255 based on histogram location
+        dest_depth[i][j] = f;
+      } else {
+        dest_depth[i][j] = 0;
+      }
     }
   }
 }
@@ -878,7 +1395,8 @@ int main()
 */
 void vpImageConvert::convert(const vpImage<vpRGBa> &src, cv::Mat &dest)
 {
-  cv::Mat vpToMat((int)src.getRows(), (int)src.getCols(), CV_8UC4, (void *)src.bitmap);
+  cv::Mat vpToMat((int)src.getRows(), (int)src.getCols(), CV_8UC4, (void *)src.bitmap,
+                  (size_t)src.getStride() * sizeof(vpRGBa));
   cv::cvtColor(vpToMat, dest, cv::COLOR_RGBA2BGR);
 }
 
@@ -923,10 +1441,10 @@ int main()
 void vpImageConvert::convert(const vpImage<unsigned char> &src, cv::Mat &dest, bool copyData)
 {
   if (copyData) {
-    cv::Mat tmpMap((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void *)src.bitmap);
+    cv::Mat tmpMap((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void *)src.bitmap, (size_t)src.getStride());
     dest = tmpMap.clone();
   } else {
-    dest = cv::Mat((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void *)src.bitmap);
+    dest = cv::Mat((int)src.getRows(), (int)src.getCols(), CV_8UC1, (void *)src.bitmap, (size_t)src.getStride());
   }
 }
 
@@ -1215,13 +1733,6 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 
 #endif
 
-#define vpSAT(c)                                                                                                       \
-  if (c & (~255)) {                                                                                                    \
-    if (c < 0)                                                                                                         \
-      c = 0;                                                                                                           \
-    else                                                                                                               \
-      c = 255;                                                                                                         \
-  }
 /*!
   Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to RGB32.
   Destination rgba memory area has to be allocated before.
@@ -1232,50 +1743,7 @@ void vpImageConvert::convert(const yarp::sig::ImageOf<yarp::sig::PixelRgb> *src,
 */
 void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int w, h;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgba;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-      *d++ = vpRGBa::alpha_default;
-    }
-  }
+  yuvToRGB(YUV_FORMAT_YUYV, yuyv, rgba, width, height, true);
 }
 
 /*!
@@ -1287,48 +1755,7 @@ void vpImageConvert::YUYVToRGBa(unsigned char *yuyv, unsigned char *rgba, unsign
 */
 void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned int width, unsigned int height)
 {
-  unsigned char *s;
-  unsigned char *d;
-  int h, w;
-  int r, g, b, cr, cg, cb, y1, y2;
-
-  h = (int)height;
-  w = (int)width;
-  s = yuyv;
-  d = rgb;
-  while (h--) {
-    int c = w >> 1;
-    while (c--) {
-      y1 = *s++;
-      cb = ((*s - 128) * 454) >> 8;
-      cg = (*s++ - 128) * 88;
-      y2 = *s++;
-      cr = ((*s - 128) * 359) >> 8;
-      cg = (cg + (*s++ - 128) * 183) >> 8;
-
-      r = y1 + cr;
-      b = y1 + cb;
-      g = y1 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-
-      r = y2 + cr;
-      b = y2 + cb;
-      g = y2 - cg;
-      vpSAT(r);
-      vpSAT(g);
-      vpSAT(b);
-
-      *d++ = static_cast<unsigned char>(r);
-      *d++ = static_cast<unsigned char>(g);
-      *d++ = static_cast<unsigned char>(b);
-    }
-  }
+  yuvToRGB(YUV_FORMAT_YUYV, yuyv, rgb, width, height, false);
 }
 /*!
 
@@ -1339,13 +1766,7 @@ void vpImageConvert::YUYVToRGB(unsigned char *yuyv, unsigned char *rgb, unsigned
 */
 void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuyv[j];
-    grey[i++] = yuyv[j + 2];
-    j += 4;
-  }
+  extractEvenOdd(yuyv, grey, (size + 1) & ~1u, 0);
 }
 
 /*!
@@ -1356,155 +1777,7 @@ void vpImageConvert::YUYVToGrey(unsigned char *yuyv, unsigned char *grey, unsign
 */
 void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-#if 1
-  //  std::cout << "call optimized ConvertYUV411ToRGBa()" << std::endl;
-  for (unsigned int i = size / 4; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int Y1 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y2 = *yuv++;
-    int Y3 = *yuv++;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y2 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y2 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y2 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y3 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y3 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y3 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-  }
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-  while (j < numpixels * 3 / 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 3], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    YUVToRGB(yuv[j + 2], yuv[j], yuv[j + 3], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    YUVToRGB(yuv[j + 4], yuv[j], yuv[j + 3], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    YUVToRGB(yuv[j + 5], yuv[j], yuv[j + 3], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    j += 6;
-  }
-#endif
+  yuvToRGB(YUV_FORMAT_YUV411, yuv, rgba, size, 1, true);
 }
 
 /*!
@@ -1517,90 +1790,7 @@ void vpImageConvert::YUV411ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
 */
 void vpImageConvert::YUV422ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGBa()" << std::endl;
-  for (unsigned int i = size / 2; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y1 = *yuv++;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-  }
-
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 2], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-
-    YUVToRGB(yuv[j + 3], yuv[j], yuv[j + 2], r, g, b);
-    rgba[i] = r;
-    rgba[i + 1] = g;
-    rgba[i + 2] = b;
-    rgba[i + 3] = vpRGBa::alpha_default;
-    i += 4;
-    j += 4;
-  }
-#endif
+  yuvToRGB(YUV_FORMAT_YUV422, yuv, rgba, size, 1, true);
 }
 
 /*!
@@ -1634,85 +1824,7 @@ void vpImageConvert::YUV411ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
-#if 1
-  //  std::cout << "call optimized convertYUV422ToRGB()" << std::endl;
-  for (unsigned int i = size / 2; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y1 = *yuv++;
-    int UV = -U - V;
-
-    //---
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-  }
-
-#else
-  // tres tres lent ....
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 2) {
-
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 2], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-
-    YUVToRGB(yuv[j + 3], yuv[j], yuv[j + 2], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-    j += 4;
-  }
-#endif
+  yuvToRGB(YUV_FORMAT_YUV422, yuv, rgb, size, 1, false);
 }
 
 /*!
@@ -1725,13 +1837,7 @@ void vpImageConvert::YUV422ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV422ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size)
 {
-  unsigned int i = 0, j = 0;
-
-  while (j < size * 2) {
-    grey[i++] = yuv[j + 1];
-    grey[i++] = yuv[j + 3];
-    j += 4;
-  }
+  extractEvenOdd(yuv, grey, (size + 1) & ~1u, 1);
 }
 
 /*!
@@ -1742,149 +1848,7 @@ yuv411 : u y1 y2 v y3 y4
 */
 void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
-#if 1
-  //  std::cout << "call optimized ConvertYUV411ToRGB()" << std::endl;
-  for (unsigned int i = size / 4; i; i--) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y0 = *yuv++;
-    int Y1 = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int Y2 = *yuv++;
-    int Y3 = *yuv++;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y0 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y0 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y0 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-
-    //---
-    R = Y1 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y1 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y1 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-
-    //---
-    R = Y2 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y2 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y2 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-
-    //---
-    R = Y3 + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    G = Y3 + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    B = Y3 + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-  }
-#else
-  // tres tres lent ....
-
-  unsigned int i = 0, j = 0;
-  unsigned char r, g, b;
-
-  while (j < size * 3 / 2) {
-    YUVToRGB(yuv[j + 1], yuv[j], yuv[j + 3], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-
-    YUVToRGB(yuv[j + 2], yuv[j], yuv[j + 3], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-
-    YUVToRGB(yuv[j + 4], yuv[j], yuv[j + 3], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-
-    YUVToRGB(yuv[j + 5], yuv[j], yuv[j + 3], r, g, b);
-    rgb[i] = r;
-    rgb[i + 1] = g;
-    rgb[i + 2] = b;
-    i += 3;
-    // TRACE("r= %d g=%d b=%d", r, g, b);
-
-    j += 6;
-  }
-#endif
+  yuvToRGB(YUV_FORMAT_YUV411, yuv, rgb, size, 1, false);
 }
 
 /*!
@@ -1896,130 +1860,7 @@ void vpImageConvert::YUV411ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYUV420ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  yuvToRGB(YUV_FORMAT_YUV420, yuv, rgba, width, height, true);
 }
 /*!
 
@@ -2028,126 +1869,7 @@ void vpImageConvert::YUV420ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
 */
 void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYUV420ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iU = yuv + size;
-  unsigned char *iV = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 5;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb - 3 * width + 1;
-    }
-    yuv += width;
-    rgb += 3 * width;
-  }
+  yuvToRGB(YUV_FORMAT_YUV420, yuv, rgb, width, height, false);
 }
 
 /*!
@@ -2157,9 +1879,127 @@ void vpImageConvert::YUV420ToRGB(unsigned char *yuv, unsigned char *rgb, unsigne
 */
 void vpImageConvert::YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsigned int size)
 {
-  for (unsigned int i = 0; i < size; i++) {
-    *grey++ = *yuv++;
-  }
+  memcpy(grey, yuv, size);
+}
+
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to a
+  RGBa image of half the resolution, in a single pass.
+
+  Each destination pixel is computed from the average luminance of a 2x2
+  block and from the average chroma of its two rows.
+
+  \param yuyv : Source image of size \e width x \e height.
+  \param rgba : Destination memory area of (\e width / 2) x (\e height / 2)
+  pixels, that has to be allocated before.
+  \param width : Width of the source image.
+  \param height : Height of the source image.
+
+  \sa YUYVToRGBa()
+*/
+void vpImageConvert::YUYVToRGBaHalfSize(unsigned char *yuyv, unsigned char *rgba, unsigned int width,
+                                        unsigned int height)
+{
+  yuvToRGBHalfSize(YUV_FORMAT_YUYV, yuyv, rgba, width, height, false);
+}
+
+/*!
+  Convert an image from YUYV 4:2:2 (y0 u01 y1 v01 y2 u23 y3 v23 ...) to a
+  grey image of half the resolution, each destination pixel being the average
+  luminance of a 2x2 block.
+
+  \param yuyv : Source image of size \e width x \e height.
+  \param grey : Destination memory area of (\e width / 2) x (\e height / 2)
+  pixels, that has to be allocated before.
+  \param width : Width of the source image.
+  \param height : Height of the source image.
+
+  \sa YUYVToGrey()
+*/
+void vpImageConvert::YUYVToGreyHalfSize(unsigned char *yuyv, unsigned char *grey, unsigned int width,
+                                        unsigned int height)
+{
+  yuvToRGBHalfSize(YUV_FORMAT_YUYV, yuyv, grey, width, height, true);
+}
+
+/*!
+  Convert an image from YUV 4:2:2 (u01 y0 v01 y1 u23 y2 v23 y3 ...) to a RGBa
+  image of half the resolution, in a single pass.
+
+  Each destination pixel is computed from the average luminance of a 2x2
+  block and from the average chroma of its two rows.
+
+  \param yuv : Source image of size \e width x \e height.
+  \param rgba : Destination memory area of (\e width / 2) x (\e height / 2)
+  pixels, that has to be allocated before.
+  \param width : Width of the source image.
+  \param height : Height of the source image.
+
+  \sa YUV422ToRGBa()
+*/
+void vpImageConvert::YUV422ToRGBaHalfSize(unsigned char *yuv, unsigned char *rgba, unsigned int width,
+                                          unsigned int height)
+{
+  yuvToRGBHalfSize(YUV_FORMAT_YUV422, yuv, rgba, width, height, false);
+}
+
+/*!
+  Convert an image from YUV 4:2:2 (u01 y0 v01 y1 u23 y2 v23 y3 ...) to a grey
+  image of half the resolution, each destination pixel being the average
+  luminance of a 2x2 block.
+
+  \param yuv : Source image of size \e width x \e height.
+  \param grey : Destination memory area of (\e width / 2) x (\e height / 2)
+  pixels, that has to be allocated before.
+  \param width : Width of the source image.
+  \param height : Height of the source image.
+
+  \sa YUV422ToGrey()
+*/
+void vpImageConvert::YUV422ToGreyHalfSize(unsigned char *yuv, unsigned char *grey, unsigned int width,
+                                          unsigned int height)
+{
+  yuvToRGBHalfSize(YUV_FORMAT_YUV422, yuv, grey, width, height, true);
+}
+
+/*!
+  Convert a YUV420 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image to a RGBa image of
+  half the resolution, in a single pass.
+
+  Each destination pixel is computed from the average luminance of a 2x2
+  block and from the chroma sample of this block.
+
+  \param yuv : Source image of size \e width x \e height.
+  \param rgba : Destination memory area of (\e width / 2) x (\e height / 2)
+  pixels, that has to be allocated before.
+  \param width : Width of the source image.
+  \param height : Height of the source image.
+
+  \sa YUV420ToRGBa()
+*/
+void vpImageConvert::YUV420ToRGBaHalfSize(unsigned char *yuv, unsigned char *rgba, unsigned int width,
+                                          unsigned int height)
+{
+  yuvToRGBHalfSize(YUV_FORMAT_YUV420, yuv, rgba, width, height, false);
+}
+
+/*!
+  Convert a YUV420 [Y(NxM), U(N/2xM/2), V(N/2xM/2)] image to a grey image of
+  half the resolution, each destination pixel being the average luminance of
+  a 2x2 block.
+
+  \param yuv : Source image of size \e width x \e height.
+  \param grey : Destination memory area of (\e width / 2) x (\e height / 2)
+  pixels, that has to be allocated before.
+  \param width : Width of the source image.
+  \param height : Height of the source image.
+
+  \sa YUV420ToGrey()
+*/
+void vpImageConvert::YUV420ToGreyHalfSize(unsigned char *yuv, unsigned char *grey, unsigned int width,
+                                          unsigned int height)
+{
+  yuvToRGBHalfSize(YUV_FORMAT_YUV420, yuv, grey, width, height, true);
 }
 /*!
 
@@ -2170,41 +2010,7 @@ void vpImageConvert::YUV420ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int size)
 {
-  for (unsigned int i = 0; i < size; i++) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgba++ = (unsigned char)R;
-    *rgba++ = (unsigned char)G;
-    *rgba++ = (unsigned char)B;
-    *rgba++ = vpRGBa::alpha_default;
-  }
+  yuvToRGB(YUV_FORMAT_YUV444, yuv, rgba, size, 1, true);
 }
 /*!
 
@@ -2213,40 +2019,7 @@ void vpImageConvert::YUV444ToRGBa(unsigned char *yuv, unsigned char *rgba, unsig
 */
 void vpImageConvert::YUV444ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int size)
 {
-  for (unsigned int i = 0; i < size; i++) {
-    int U = (int)((*yuv++ - 128) * 0.354);
-    int U5 = 5 * U;
-    int Y = *yuv++;
-    int V = (int)((*yuv++ - 128) * 0.707);
-    int V2 = 2 * V;
-    int UV = -U - V;
-
-    // Original equations
-    // R = Y           + 1.402 V
-    // G = Y - 0.344 U - 0.714 V
-    // B = Y + 1.772 U
-    int R = Y + V2;
-    if ((R >> 8) > 0)
-      R = 255;
-    else if (R < 0)
-      R = 0;
-
-    int G = Y + UV;
-    if ((G >> 8) > 0)
-      G = 255;
-    else if (G < 0)
-      G = 0;
-
-    int B = Y + U5;
-    if ((B >> 8) > 0)
-      B = 255;
-    else if (B < 0)
-      B = 0;
-
-    *rgb++ = (unsigned char)R;
-    *rgb++ = (unsigned char)G;
-    *rgb++ = (unsigned char)B;
-  }
+  yuvToRGB(YUV_FORMAT_YUV444, yuv, rgb, size, 1, false);
 }
 
 /*!
@@ -2272,130 +2045,7 @@ void vpImageConvert::YUV444ToGrey(unsigned char *yuv, unsigned char *grey, unsig
 */
 void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = 0;
-      rgba = rgba + 4 * width - 7;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 4 * width + 1;
-    }
-    yuv += width;
-    rgba += 4 * width;
-  }
+  yuvToRGB(YUV_FORMAT_YV12, yuv, rgba, width, height, true);
 }
 /*!
 
@@ -2404,126 +2054,7 @@ void vpImageConvert::YV12ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
 */
 void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int height, unsigned int width)
 {
-  //  std::cout << "call optimized ConvertYV12ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 5 * size / 4;
-  for (unsigned int i = 0; i < height / 2; i++) {
-    for (unsigned int j = 0; j < width / 2; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv;
-      yuv = yuv + width - 1;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv - width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 5;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb - 3 * width + 1;
-    }
-    yuv += width;
-    rgb += 3 * width;
-  }
+  yuvToRGB(YUV_FORMAT_YV12, yuv, rgb, width, height, false);
 }
 
 /*!
@@ -2535,431 +2066,7 @@ void vpImageConvert::YV12ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned
 */
 void vpImageConvert::YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigned int width, unsigned int height)
 {
-  //  std::cout << "call optimized ConvertYVU9ToRGBa()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3, Y4, Y5, Y6, Y7, Y8, Y9, Y10, Y11, Y12, Y13, Y14, Y15;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 17 * size / 16;
-  for (unsigned int i = 0; i < height / 4; i++) {
-    for (unsigned int j = 0; j < width / 4; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv++;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv + width - 3;
-      Y4 = *yuv++;
-      Y5 = *yuv++;
-      Y6 = *yuv++;
-      Y7 = *yuv;
-      yuv = yuv + width - 3;
-      Y8 = *yuv++;
-      Y9 = *yuv++;
-      Y10 = *yuv++;
-      Y11 = *yuv;
-      yuv = yuv + width - 3;
-      Y12 = *yuv++;
-      Y13 = *yuv++;
-      Y14 = *yuv++;
-      Y15 = *yuv;
-      yuv = yuv - 3 * width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 15;
-
-      R = Y4 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y4 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y4 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y5 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y5 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y5 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y6 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y6 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y6 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y7 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y7 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y7 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 15;
-
-      R = Y8 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y8 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y8 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y9 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y9 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y9 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y10 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y10 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y10 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y11 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y11 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y11 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba + 4 * width - 15;
-
-      R = Y12 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y12 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y12 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y13 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y13 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y13 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y14 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y14 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y14 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba++ = vpRGBa::alpha_default;
-
-      //---
-      R = Y15 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y15 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y15 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgba++ = (unsigned char)R;
-      *rgba++ = (unsigned char)G;
-      *rgba++ = (unsigned char)B;
-      *rgba = vpRGBa::alpha_default;
-      rgba = rgba - 12 * width + 1;
-    }
-    yuv += 3 * width;
-    rgba += 12 * width;
-  }
+  yuvToRGB(YUV_FORMAT_YVU9, yuv, rgba, width, height, true);
 }
 /*!
 
@@ -2968,415 +2075,7 @@ void vpImageConvert::YVU9ToRGBa(unsigned char *yuv, unsigned char *rgba, unsigne
 */
 void vpImageConvert::YVU9ToRGB(unsigned char *yuv, unsigned char *rgb, unsigned int height, unsigned int width)
 {
-  //  std::cout << "call optimized ConvertYVU9ToRGB()" << std::endl;
-  int U, V, R, G, B, V2, U5, UV;
-  int Y0, Y1, Y2, Y3, Y4, Y5, Y6, Y7, Y8, Y9, Y10, Y11, Y12, Y13, Y14, Y15;
-  unsigned int size = width * height;
-  unsigned char *iV = yuv + size;
-  unsigned char *iU = yuv + 17 * size / 16;
-  for (unsigned int i = 0; i < height / 4; i++) {
-    for (unsigned int j = 0; j < width / 4; j++) {
-      U = (int)((*iU++ - 128) * 0.354);
-      U5 = 5 * U;
-      V = (int)((*iV++ - 128) * 0.707);
-      V2 = 2 * V;
-      UV = -U - V;
-      Y0 = *yuv++;
-      Y1 = *yuv++;
-      Y2 = *yuv++;
-      Y3 = *yuv;
-      yuv = yuv + width - 3;
-      Y4 = *yuv++;
-      Y5 = *yuv++;
-      Y6 = *yuv++;
-      Y7 = *yuv;
-      yuv = yuv + width - 3;
-      Y8 = *yuv++;
-      Y9 = *yuv++;
-      Y10 = *yuv++;
-      Y11 = *yuv;
-      yuv = yuv + width - 3;
-      Y12 = *yuv++;
-      Y13 = *yuv++;
-      Y14 = *yuv++;
-      Y15 = *yuv;
-      yuv = yuv - 3 * width + 1;
-
-      // Original equations
-      // R = Y           + 1.402 V
-      // G = Y - 0.344 U - 0.714 V
-      // B = Y + 1.772 U
-      R = Y0 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y0 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y0 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y1 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y1 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y1 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y2 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y2 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y2 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y3 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y3 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y3 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 11;
-
-      R = Y4 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y4 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y4 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y5 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y5 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y5 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y6 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y6 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y6 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y7 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y7 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y7 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 11;
-
-      R = Y8 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y8 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y8 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y9 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y9 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y9 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y10 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y10 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y10 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y11 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y11 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y11 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb = (unsigned char)B;
-      rgb = rgb + 3 * width - 11;
-
-      R = Y12 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y12 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y12 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y13 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y13 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y13 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y14 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y14 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y14 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-
-      //---
-      R = Y15 + V2;
-      if ((R >> 8) > 0)
-        R = 255;
-      else if (R < 0)
-        R = 0;
-
-      G = Y15 + UV;
-      if ((G >> 8) > 0)
-        G = 255;
-      else if (G < 0)
-        G = 0;
-
-      B = Y15 + U5;
-      if ((B >> 8) > 0)
-        B = 255;
-      else if (B < 0)
-        B = 0;
-
-      *rgb++ = (unsigned char)R;
-      *rgb++ = (unsigned char)G;
-      *rgb++ = (unsigned char)B;
-      rgb = rgb - 9 * width + 1;
-    }
-    yuv += 3 * width;
-    rgb += 9 * width;
-  }
+  yuvToRGB(YUV_FORMAT_YVU9, yuv, rgb, width, height, false);
 }
 
 /*!
@@ -3508,6 +2207,24 @@ void vpImageConvert::RGBToGrey(unsigned char *rgb, unsigned char *grey, unsigned
     unsigned char *pt_end = rgb + size * 3;
     unsigned char *pt_output = grey;
 
+#if VISP_HAVE_NEON
+    if (vpCPUFeatures::checkNEON()) {
+      // Same fixed-point weights than the SSSE3 implementation
+      for (unsigned int i = 0; i + 8 <= size; i += 8) {
+        const uint8x8x3_t px = vld3_u8(pt_input);
+        const uint16x8_t r = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(px.val[0])), 13933), 8),
+                                          vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(px.val[0])), 13933), 8));
+        const uint16x8_t g = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(px.val[1])), 46871), 8),
+                                          vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(px.val[1])), 46871), 8));
+        const uint16x8_t b = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(px.val[2])), 4732), 8),
+                                          vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(px.val[2])), 4732), 8));
+        vst1_u8(pt_output, vshrn_n_u16(vqaddq_u16(r, vqaddq_u16(g, b)), 8));
+        pt_input += 8 * 3;
+        pt_output += 8;
+      }
+    }
+#endif
+
     while (pt_input != pt_end) {
       *pt_output = (unsigned char)(0.2126 * (*pt_input) + 0.7152 * (*(pt_input + 1)) + 0.0722 * (*(pt_input + 2)));
       pt_input += 3;
@@ -3601,6 +2318,24 @@ void vpImageConvert::RGBaToGrey(unsigned char *rgba, unsigned char *grey, unsign
     unsigned char *pt_end = rgba + size * 4;
     unsigned char *pt_output = grey;
 
+#if VISP_HAVE_NEON
+    if (vpCPUFeatures::checkNEON()) {
+      // Same fixed-point weights than the SSSE3 implementation
+      for (unsigned int i = 0; i + 8 <= size; i += 8) {
+        const uint8x8x4_t px = vld4_u8(pt_input);
+        const uint16x8_t r = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(px.val[0])), 13933), 8),
+                                          vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(px.val[0])), 13933), 8));
+        const uint16x8_t g = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(px.val[1])), 46871), 8),
+                                          vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(px.val[1])), 46871), 8));
+        const uint16x8_t b = vcombine_u16(vshrn_n_u32(vmull_n_u16(vget_low_u16(vmovl_u8(px.val[2])), 4732), 8),
+                                          vshrn_n_u32(vmull_n_u16(vget_high_u16(vmovl_u8(px.val[2])), 4732), 8));
+        vst1_u8(pt_output, vshrn_n_u16(vqaddq_u16(r, vqaddq_u16(g, b)), 8));
+        pt_input += 8 * 4;
+        pt_output += 8;
+      }
+    }
+#endif
+
     while (pt_input != pt_end) {
       *pt_output = (unsigned char)(0.2126 * (*pt_input) + 0.7152 * (*(pt_input + 1)) + 0.0722 * (*(pt_input + 2)));
       pt_input += 4;
@@ -3620,6 +2355,34 @@ void vpImageConvert::GreyToRGBa(unsigned char *grey, unsigned char *rgba, unsign
   unsigned char *pt_end = grey + size;
   unsigned char *pt_output = rgba;
 
+  if (useSIMD()) {
+#if VISP_HAVE_SSE2
+    const __m128i a = _mm_set1_epi8(static_cast<char>(vpRGBa::alpha_default));
+    for (unsigned int i = 0; i + 16 <= size; i += 16) {
+      const __m128i g = _mm_loadu_si128((const __m128i *)pt_input);
+      const __m128i gg_lo = _mm_unpacklo_epi8(g, g);
+      const __m128i gg_hi = _mm_unpackhi_epi8(g, g);
+      const __m128i ga_lo = _mm_unpacklo_epi8(g, a);
+      const __m128i ga_hi = _mm_unpackhi_epi8(g, a);
+      _mm_storeu_si128((__m128i *)pt_output, _mm_unpacklo_epi16(gg_lo, ga_lo));
+      _mm_storeu_si128((__m128i *)(pt_output + 16), _mm_unpackhi_epi16(gg_lo, ga_lo));
+      _mm_storeu_si128((__m128i *)(pt_output + 32), _mm_unpacklo_epi16(gg_hi, ga_hi));
+      _mm_storeu_si128((__m128i *)(pt_output + 48), _mm_unpackhi_epi16(gg_hi, ga_hi));
+      pt_input += 16;
+      pt_output += 64;
+    }
+#elif VISP_HAVE_NEON
+    for (unsigned int i = 0; i + 16 <= size; i += 16) {
+      uint8x16x4_t px;
+      px.val[0] = px.val[1] = px.val[2] = vld1q_u8(pt_input);
+      px.val[3] = vdupq_n_u8(vpRGBa::alpha_default);
+      vst4q_u8(pt_output, px);
+      pt_input += 16;
+      pt_output += 64;
+    }
+#endif
+  }
+
   while (pt_input != pt_end) {
     unsigned char p = *pt_input;
     *(pt_output) = p;                         // R
@@ -4353,7 +3116,6 @@ int main()
 void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *pR, vpImage<unsigned char> *pG,
                            vpImage<unsigned char> *pB, vpImage<unsigned char> *pa)
 {
-  size_t n = src.getNumberOfPixel();
   unsigned int height = src.getHeight();
   unsigned int width = src.getWidth();
   unsigned char *input;
@@ -4372,40 +3134,44 @@ void vpImageConvert::split(const vpImage<vpRGBa> &src, vpImage<unsigned char> *p
   tabChannel[2] = pB;
   tabChannel[3] = pa;
 
-  size_t i; /* ordre    */
   for (unsigned int j = 0; j < 4; j++) {
     if (tabChannel[j] != NULL) {
       if (tabChannel[j]->getHeight() != height || tabChannel[j]->getWidth() != width) {
         tabChannel[j]->resize(height, width);
       }
-      dst = (unsigned char *)tabChannel[j]->bitmap;
 
-      input = (unsigned char *)src.bitmap + j;
-      i = 0;
+      // Process the image as a single row when there is no padding
+      bool contiguous = src.isContiguous() && tabChannel[j]->isContiguous();
+      unsigned int nb_rows = contiguous ? (height > 0 ? 1 : 0) : height;
+      size_t n = contiguous ? src.getNumberOfPixel() : width;
+
+      for (unsigned int r = 0; r < nb_rows; r++) {
+        dst = (unsigned char *)(*tabChannel[j])[r];
+        input = (unsigned char *)src[r] + j;
+        size_t i = 0;
 #if 1               // optimization
-      if (n >= 4) { /* boucle deroulee lsize fois    */
-        n -= 3;
-        for (; i < n; i += 4) {
-          *dst = *input;
-          input += 4;
-          dst++;
-          *dst = *input;
-          input += 4;
-          dst++;
-          *dst = *input;
-          input += 4;
-          dst++;
+        if (n >= 4) { /* boucle deroulee lsize fois    */
+          for (; i + 3 < n; i += 4) {
+            *dst = *input;
+            input += 4;
+            dst++;
+            *dst = *input;
+            input += 4;
+            dst++;
+            *dst = *input;
+            input += 4;
+            dst++;
+            *dst = *input;
+            input += 4;
+            dst++;
+          }
+        }
+#endif
+        for (; i < n; i++) {
           *dst = *input;
           input += 4;
           dst++;
         }
-        n += 3;
-      }
-#endif
-      for (; i < n; i++) {
-        *dst = *input;
-        input += 4;
-        dst++;
       }
     }
   }
@@ -4450,22 +3216,24 @@ void vpImageConvert::merge(const vpImage<unsigned char> *R, const vpImage<unsign
 
     RGBa.resize(height, width);
 
-    unsigned int size = width * height;
-    for (unsigned int i = 0; i < size; i++) {
-      if (R != NULL) {
-        RGBa.bitmap[i].R = R->bitmap[i];
-      }
+    for (unsigned int i = 0; i < height; i++) {
+      vpRGBa *dst = RGBa[i];
+      for (unsigned int j = 0; j < width; j++) {
+        if (R != NULL) {
+          dst[j].R = (*R)[i][j];
+        }
 
-      if (G != NULL) {
-        RGBa.bitmap[i].G = G->bitmap[i];
-      }
+        if (G != NULL) {
+          dst[j].G = (*G)[i][j];
+        }
 
-      if (B != NULL) {
-        RGBa.bitmap[i].B = B->bitmap[i];
-      }
+        if (B != NULL) {
+          dst[j].B = (*B)[i][j];
+        }
 
-      if (a != NULL) {
-        RGBa.bitmap[i].A = a->bitmap[i];
+        if (a != NULL) {
+          dst[j].A = (*a)[i][j];
+        }
       }
     }
   } else {
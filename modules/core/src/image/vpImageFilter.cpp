@@ -36,8 +36,14 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/core/vpRGBa.h>
 #if defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020408)
 #include <opencv2/imgproc/imgproc.hpp>
@@ -47,6 +53,875 @@
 #include <cv.h>
 #endif
 
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
+namespace
+{
+/*
+  Row-oriented separable filtering engine.
+
+  Borders are resolved once per row (horizontal pass) or once per output row
+  (vertical pass) so that the inner loops are branch free. Left and top borders
+  are mirrored around the first pixel, right and bottom borders around the image
+  edge, exactly like filterXLeftBorder(), filterXRightBorder(), filterYTopBorder()
+  and filterYBottomBorder(). Double precision kernels accumulate the taps in the
+  same order as the per-pixel functions, so that the results are bit-exact
+  whatever the SIMD path. The vertical passes widen 8-bit pixels to doubles with
+  loadPd4(), so that unsigned char and double images share the same SIMD column
+  kernels; the horizontal passes work on a double row buffer. There is no float
+  accumulation: all the entry points return double images that must match the
+  per-pixel functions, and the fast approximated path is the fixed-point one.
+*/
+
+bool useSIMD()
+{
+#if VISP_HAVE_SSE2
+  return vpCPUFeatures::checkSSE2();
+#elif VISP_HAVE_NEON
+  return vpCPUFeatures::checkNEON();
+#else
+  return false;
+#endif
+}
+
+unsigned int reflectIndex(int i, unsigned int n)
+{
+  if (i < 0) {
+    return std::min(static_cast<unsigned int>(-i), n - 1);
+  }
+  if (i >= static_cast<int>(n)) {
+    int k = 2 * static_cast<int>(n) - i - 1;
+    return k < 0 ? 0 : static_cast<unsigned int>(k);
+  }
+  return static_cast<unsigned int>(i);
+}
+
+template <class Type, class BufType>
+void reflectRow(const Type *src, BufType *buf, unsigned int width, unsigned int half)
+{
+  for (unsigned int j = 0; j < width; j++) {
+    buf[half + j] = static_cast<BufType>(src[j]);
+  }
+  for (unsigned int k = 1; k <= half; k++) {
+    buf[half - k] = static_cast<BufType>(src[reflectIndex(-static_cast<int>(k), width)]);
+    buf[half + width - 1 + k] = static_cast<BufType>(src[reflectIndex(static_cast<int>(width - 1 + k), width)]);
+  }
+}
+
+// src[-half .. width - 1 + half] must be readable
+void filterRowSymmetric(const double *src, double *dst, unsigned int width, const double *filter, unsigned int half,
+                        bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128d f0 = _mm_set1_pd(filter[0]);
+    for (; j + 4 <= width; j += 4) {
+      __m128d acc0 = _mm_setzero_pd();
+      __m128d acc1 = _mm_setzero_pd();
+      for (unsigned int i = 1; i <= half; i++) {
+        const __m128d fi = _mm_set1_pd(filter[i]);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(fi, _mm_add_pd(_mm_loadu_pd(src + j + i), _mm_loadu_pd(src + j - i))));
+        acc1 = _mm_add_pd(acc1,
+                          _mm_mul_pd(fi, _mm_add_pd(_mm_loadu_pd(src + j + 2 + i), _mm_loadu_pd(src + j + 2 - i))));
+      }
+      _mm_storeu_pd(dst + j, _mm_add_pd(acc0, _mm_mul_pd(f0, _mm_loadu_pd(src + j))));
+      _mm_storeu_pd(dst + j + 2, _mm_add_pd(acc1, _mm_mul_pd(f0, _mm_loadu_pd(src + j + 2))));
+    }
+#elif VISP_HAVE_NEON
+    const float64x2_t f0 = vdupq_n_f64(filter[0]);
+    for (; j + 4 <= width; j += 4) {
+      float64x2_t acc0 = vdupq_n_f64(0.0);
+      float64x2_t acc1 = vdupq_n_f64(0.0);
+      for (unsigned int i = 1; i <= half; i++) {
+        const float64x2_t fi = vdupq_n_f64(filter[i]);
+        acc0 = vaddq_f64(acc0, vmulq_f64(fi, vaddq_f64(vld1q_f64(src + j + i), vld1q_f64(src + j - i))));
+        acc1 = vaddq_f64(acc1, vmulq_f64(fi, vaddq_f64(vld1q_f64(src + j + 2 + i), vld1q_f64(src + j + 2 - i))));
+      }
+      vst1q_f64(dst + j, vaddq_f64(acc0, vmulq_f64(f0, vld1q_f64(src + j))));
+      vst1q_f64(dst + j + 2, vaddq_f64(acc1, vmulq_f64(f0, vld1q_f64(src + j + 2))));
+    }
+#endif
+  }
+  for (; j < width; j++) {
+    double result = 0;
+    for (unsigned int i = 1; i <= half; i++) {
+      result += filter[i] * (src[j + i] + src[j - i]);
+    }
+    dst[j] = result + filter[0] * src[j];
+  }
+}
+
+// Only pixels in [half, width - half[ are computed
+void filterRowAntiSymmetric(const double *src, double *dst, unsigned int width, const double *filter,
+                            unsigned int half, bool simd)
+{
+  unsigned int j = half;
+  const unsigned int end = width - half;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    for (; j + 2 <= end; j += 2) {
+      __m128d acc = _mm_setzero_pd();
+      for (unsigned int i = 1; i <= half; i++) {
+        acc = _mm_add_pd(acc, _mm_mul_pd(_mm_set1_pd(filter[i]),
+                                         _mm_sub_pd(_mm_loadu_pd(src + j + i), _mm_loadu_pd(src + j - i))));
+      }
+      _mm_storeu_pd(dst + j, acc);
+    }
+#elif VISP_HAVE_NEON
+    for (; j + 2 <= end; j += 2) {
+      float64x2_t acc = vdupq_n_f64(0.0);
+      for (unsigned int i = 1; i <= half; i++) {
+        acc = vaddq_f64(acc,
+                        vmulq_f64(vdupq_n_f64(filter[i]), vsubq_f64(vld1q_f64(src + j + i), vld1q_f64(src + j - i))));
+      }
+      vst1q_f64(dst + j, acc);
+    }
+#endif
+  }
+  for (; j < end; j++) {
+    double result = 0;
+    for (unsigned int i = 1; i <= half; i++) {
+      result += filter[i] * (src[j + i] - src[j - i]);
+    }
+    dst[j] = result;
+  }
+}
+
+#if VISP_HAVE_SSE2
+// Load 4 consecutive pixels as two pairs of doubles
+inline void loadPd4(const double *p, __m128d &lo, __m128d &hi)
+{
+  lo = _mm_loadu_pd(p);
+  hi = _mm_loadu_pd(p + 2);
+}
+
+inline void loadPd4(const unsigned char *p, __m128d &lo, __m128d &hi)
+{
+  int v;
+  memcpy(&v, p, sizeof(v));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i x = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(v), zero), zero);
+  lo = _mm_cvtepi32_pd(x);
+  hi = _mm_cvtepi32_pd(_mm_shuffle_epi32(x, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+#elif VISP_HAVE_NEON
+inline void loadPd4(const double *p, float64x2_t &lo, float64x2_t &hi)
+{
+  lo = vld1q_f64(p);
+  hi = vld1q_f64(p + 2);
+}
+
+inline void loadPd4(const unsigned char *p, float64x2_t &lo, float64x2_t &hi)
+{
+  uint32_t v;
+  memcpy(&v, p, sizeof(v));
+  const uint32x4_t x = vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(v)))));
+  lo = vcvtq_f64_u64(vmovl_u32(vget_low_u32(x)));
+  hi = vcvtq_f64_u64(vmovl_u32(vget_high_u32(x)));
+}
+#endif
+
+// rows[half + k] (resp. rows[half - k]) points to the row k pixels below (resp. above) the output row
+template <class Type>
+void filterColumnsSymmetric(const Type *const *rows, double *dst, unsigned int width, const double *filter,
+                            unsigned int half, bool simd)
+{
+  const Type *center = rows[half];
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128d f0 = _mm_set1_pd(filter[0]);
+    __m128d up0, up1, down0, down1;
+    for (; j + 4 <= width; j += 4) {
+      __m128d acc0 = _mm_setzero_pd();
+      __m128d acc1 = _mm_setzero_pd();
+      for (unsigned int i = 1; i <= half; i++) {
+        const __m128d fi = _mm_set1_pd(filter[i]);
+        loadPd4(rows[half - i] + j, up0, up1);
+        loadPd4(rows[half + i] + j, down0, down1);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(fi, _mm_add_pd(down0, up0)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(fi, _mm_add_pd(down1, up1)));
+      }
+      loadPd4(center + j, up0, up1);
+      _mm_storeu_pd(dst + j, _mm_add_pd(acc0, _mm_mul_pd(f0, up0)));
+      _mm_storeu_pd(dst + j + 2, _mm_add_pd(acc1, _mm_mul_pd(f0, up1)));
+    }
+#elif VISP_HAVE_NEON
+    const float64x2_t f0 = vdupq_n_f64(filter[0]);
+    float64x2_t up0, up1, down0, down1;
+    for (; j + 4 <= width; j += 4) {
+      float64x2_t acc0 = vdupq_n_f64(0.0);
+      float64x2_t acc1 = vdupq_n_f64(0.0);
+      for (unsigned int i = 1; i <= half; i++) {
+        const float64x2_t fi = vdupq_n_f64(filter[i]);
+        loadPd4(rows[half - i] + j, up0, up1);
+        loadPd4(rows[half + i] + j, down0, down1);
+        acc0 = vaddq_f64(acc0, vmulq_f64(fi, vaddq_f64(down0, up0)));
+        acc1 = vaddq_f64(acc1, vmulq_f64(fi, vaddq_f64(down1, up1)));
+      }
+      loadPd4(center + j, up0, up1);
+      vst1q_f64(dst + j, vaddq_f64(acc0, vmulq_f64(f0, up0)));
+      vst1q_f64(dst + j + 2, vaddq_f64(acc1, vmulq_f64(f0, up1)));
+    }
+#endif
+  }
+  for (; j < width; j++) {
+    double result = 0;
+    for (unsigned int i = 1; i <= half; i++) {
+      result += filter[i] * (rows[half + i][j] + rows[half - i][j]);
+    }
+    dst[j] = result + filter[0] * center[j];
+  }
+}
+
+template <class Type>
+void filterColumnsAntiSymmetric(const Type *const *rows, double *dst, unsigned int width, const double *filter,
+                                unsigned int half, bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    __m128d up0, up1, down0, down1;
+    for (; j + 4 <= width; j += 4) {
+      __m128d acc0 = _mm_setzero_pd();
+      __m128d acc1 = _mm_setzero_pd();
+      for (unsigned int i = 1; i <= half; i++) {
+        const __m128d fi = _mm_set1_pd(filter[i]);
+        loadPd4(rows[half - i] + j, up0, up1);
+        loadPd4(rows[half + i] + j, down0, down1);
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(fi, _mm_sub_pd(down0, up0)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(fi, _mm_sub_pd(down1, up1)));
+      }
+      _mm_storeu_pd(dst + j, acc0);
+      _mm_storeu_pd(dst + j + 2, acc1);
+    }
+#elif VISP_HAVE_NEON
+    float64x2_t up0, up1, down0, down1;
+    for (; j + 4 <= width; j += 4) {
+      float64x2_t acc0 = vdupq_n_f64(0.0);
+      float64x2_t acc1 = vdupq_n_f64(0.0);
+      for (unsigned int i = 1; i <= half; i++) {
+        const float64x2_t fi = vdupq_n_f64(filter[i]);
+        loadPd4(rows[half - i] + j, up0, up1);
+        loadPd4(rows[half + i] + j, down0, down1);
+        acc0 = vaddq_f64(acc0, vmulq_f64(fi, vsubq_f64(down0, up0)));
+        acc1 = vaddq_f64(acc1, vmulq_f64(fi, vsubq_f64(down1, up1)));
+      }
+      vst1q_f64(dst + j, acc0);
+      vst1q_f64(dst + j + 2, acc1);
+    }
+#endif
+  }
+  for (; j < width; j++) {
+    double result = 0;
+    for (unsigned int i = 1; i <= half; i++) {
+      result += filter[i] * (rows[half + i][j] - rows[half - i][j]);
+    }
+    dst[j] = result;
+  }
+}
+
+template <class Type> class vpSeparableFilterXBody : public vpParallelBody
+{
+public:
+  vpSeparableFilterXBody(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int half)
+    : m_I(I), m_dIx(dIx), m_filter(filter), m_half(half), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_I.getWidth();
+    std::vector<double> buf(width + 2 * m_half);
+    for (unsigned int i = begin; i < end; i++) {
+      reflectRow(m_I[i], &buf[0], width, m_half);
+      filterRowSymmetric(&buf[m_half], m_dIx[i], width, m_filter, m_half, m_simd);
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<double> &m_dIx;
+  const double *m_filter;
+  unsigned int m_half;
+  bool m_simd;
+};
+
+template <class Type> class vpSeparableFilterYBody : public vpParallelBody
+{
+public:
+  vpSeparableFilterYBody(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int half)
+    : m_I(I), m_dIy(dIy), m_filter(filter), m_half(half), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int height = m_I.getHeight();
+    std::vector<const Type *> rows(2 * m_half + 1);
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int k = 0; k <= 2 * m_half; k++) {
+        rows[k] = m_I[reflectIndex(static_cast<int>(i + k) - static_cast<int>(m_half), height)];
+      }
+      filterColumnsSymmetric(&rows[0], m_dIy[i], m_I.getWidth(), m_filter, m_half, m_simd);
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<double> &m_dIy;
+  const double *m_filter;
+  unsigned int m_half;
+  bool m_simd;
+};
+
+template <class Type> class vpSeparableGradXBody : public vpParallelBody
+{
+public:
+  vpSeparableGradXBody(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int half)
+    : m_I(I), m_dIx(dIx), m_filter(filter), m_half(half), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_I.getWidth();
+    std::vector<double> buf(width);
+    for (unsigned int i = begin; i < end; i++) {
+      const Type *src = m_I[i];
+      for (unsigned int j = 0; j < width; j++) {
+        buf[j] = src[j];
+      }
+      filterRowAntiSymmetric(&buf[0], m_dIx[i], width, m_filter, m_half, m_simd);
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<double> &m_dIx;
+  const double *m_filter;
+  unsigned int m_half;
+  bool m_simd;
+};
+
+template <class Type> class vpSeparableGradYBody : public vpParallelBody
+{
+public:
+  vpSeparableGradYBody(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int half)
+    : m_I(I), m_dIy(dIy), m_filter(filter), m_half(half), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    std::vector<const Type *> rows(2 * m_half + 1);
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int k = 0; k <= 2 * m_half; k++) {
+        rows[k] = m_I[i + k - m_half];
+      }
+      filterColumnsAntiSymmetric(&rows[0], m_dIy[i], m_I.getWidth(), m_filter, m_half, m_simd);
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<double> &m_dIy;
+  const double *m_filter;
+  unsigned int m_half;
+  bool m_simd;
+};
+
+template <class Type>
+void separableFilterX(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  const unsigned int half = (size - 1) / 2;
+  dIx.resize(I.getHeight(), I.getWidth());
+  if (I.getWidth() == 0) {
+    return;
+  }
+
+  vpParallel::parallelFor(0, I.getHeight(), vpSeparableFilterXBody<Type>(I, dIx, filter, half));
+}
+
+template <class Type>
+void separableFilterY(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  const unsigned int half = (size - 1) / 2;
+  dIy.resize(I.getHeight(), I.getWidth());
+  if (I.getHeight() == 0) {
+    return;
+  }
+
+  vpParallel::parallelFor(0, I.getHeight(), vpSeparableFilterYBody<Type>(I, dIy, filter, half));
+}
+
+template <class Type>
+void separableGradX(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  const unsigned int half = (size - 1) / 2;
+  dIx.resize(I.getHeight(), I.getWidth(), 0.0);
+  if (I.getWidth() <= 2 * half) {
+    return;
+  }
+
+  vpParallel::parallelFor(0, I.getHeight(), vpSeparableGradXBody<Type>(I, dIx, filter, half));
+}
+
+template <class Type>
+void separableGradY(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  const unsigned int half = (size - 1) / 2;
+  dIy.resize(I.getHeight(), I.getWidth(), 0.0);
+  if (I.getHeight() <= 2 * half) {
+    return;
+  }
+
+  vpParallel::parallelFor(half, I.getHeight() - half, vpSeparableGradYBody<Type>(I, dIy, filter, half));
+}
+
+/*
+  Fixed-point Gaussian blur: the horizontal pass uses a kernel quantized on 8
+  bits (sum of the coefficients equal to 256) and accumulates in 16-bit unsigned
+  integers, the vertical pass uses a kernel quantized on 12 bits and accumulates
+  in 32-bit integers before rounding back to 8 bits.
+*/
+bool quantizeKernel(const double *filter, unsigned int half, unsigned int bits, std::vector<unsigned short> &weights)
+{
+  const int one = 1 << bits;
+  weights.resize(half + 1);
+  int sum = 0;
+  for (unsigned int i = 1; i <= half; i++) {
+    if (filter[i] < 0) {
+      return false;
+    }
+    weights[i] = static_cast<unsigned short>(vpMath::round(filter[i] * one));
+    sum += 2 * weights[i];
+  }
+  if (sum > one || filter[0] < 0) {
+    return false;
+  }
+  weights[0] = static_cast<unsigned short>(one - sum);
+  return true;
+}
+
+void fixedPointRow(const unsigned char *src, unsigned short *dst, unsigned int width,
+                   const std::vector<unsigned short> &w, unsigned int half, bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i w0 = _mm_set1_epi16(static_cast<short>(w[0]));
+    for (; j + 8 <= width; j += 8) {
+      __m128i acc =
+          _mm_mullo_epi16(w0, _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + j)), zero));
+      for (unsigned int i = 1; i <= half; i++) {
+        const __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + j + i)), zero);
+        const __m128i b = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(src + j - i)), zero);
+        acc = _mm_add_epi16(acc, _mm_mullo_epi16(_mm_set1_epi16(static_cast<short>(w[i])), _mm_add_epi16(a, b)));
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), acc);
+    }
+#elif VISP_HAVE_NEON
+    for (; j + 8 <= width; j += 8) {
+      uint16x8_t acc = vmulq_n_u16(vmovl_u8(vld1_u8(src + j)), w[0]);
+      for (unsigned int i = 1; i <= half; i++) {
+        acc = vmlaq_n_u16(acc, vaddl_u8(vld1_u8(src + j + i), vld1_u8(src + j - i)), w[i]);
+      }
+      vst1q_u16(dst + j, acc);
+    }
+#endif
+  }
+  for (; j < width; j++) {
+    unsigned int acc = w[0] * src[j];
+    for (unsigned int i = 1; i <= half; i++) {
+      acc += w[i] * (src[j + i] + src[j - i]);
+    }
+    dst[j] = static_cast<unsigned short>(acc);
+  }
+}
+
+void fixedPointColumns(const unsigned short *const *rows, unsigned char *dst, unsigned int width,
+                       const std::vector<unsigned short> &w, unsigned int half, bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i round = _mm_set1_epi32(1 << 19);
+    for (; j + 8 <= width; j += 8) {
+      __m128i acc_lo = round, acc_hi = round;
+      for (unsigned int k = 0; k <= 2 * half; k++) {
+        const __m128i wk = _mm_set1_epi16(static_cast<short>(w[k > half ? k - half : half - k]));
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + j));
+        const __m128i lo = _mm_mullo_epi16(v, wk);
+        const __m128i hi = _mm_mulhi_epu16(v, wk);
+        acc_lo = _mm_add_epi32(acc_lo, _mm_unpacklo_epi16(lo, hi));
+        acc_hi = _mm_add_epi32(acc_hi, _mm_unpackhi_epi16(lo, hi));
+      }
+      const __m128i res = _mm_packs_epi32(_mm_srli_epi32(acc_lo, 20), _mm_srli_epi32(acc_hi, 20));
+      _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(res, res));
+    }
+#elif VISP_HAVE_NEON
+    for (; j + 8 <= width; j += 8) {
+      uint32x4_t acc_lo = vdupq_n_u32(0), acc_hi = vdupq_n_u32(0);
+      for (unsigned int k = 0; k <= 2 * half; k++) {
+        const unsigned short wk = w[k > half ? k - half : half - k];
+        const uint16x8_t v = vld1q_u16(rows[k] + j);
+        acc_lo = vmlal_n_u16(acc_lo, vget_low_u16(v), wk);
+        acc_hi = vmlal_n_u16(acc_hi, vget_high_u16(v), wk);
+      }
+      const uint16x8_t res = vcombine_u16(vmovn_u32(vrshrq_n_u32(acc_lo, 20)), vmovn_u32(vrshrq_n_u32(acc_hi, 20)));
+      vst1_u8(dst + j, vqmovn_u16(res));
+    }
+#endif
+  }
+  for (; j < width; j++) {
+    unsigned int acc = 1 << 19;
+    for (unsigned int k = 0; k <= 2 * half; k++) {
+      acc += w[k > half ? k - half : half - k] * rows[k][j];
+    }
+    dst[j] = static_cast<unsigned char>(std::min(acc >> 20, 255u));
+  }
+}
+
+class vpFixedPointRowBody : public vpParallelBody
+{
+public:
+  vpFixedPointRowBody(const vpImage<unsigned char> &I, vpImage<unsigned short> &GIx,
+                      const std::vector<unsigned short> &weights, unsigned int half)
+    : m_I(I), m_GIx(GIx), m_weights(weights), m_half(half), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_I.getWidth();
+    std::vector<unsigned char> buf(width + 2 * m_half);
+    for (unsigned int i = begin; i < end; i++) {
+      reflectRow(m_I[i], &buf[0], width, m_half);
+      fixedPointRow(&buf[m_half], m_GIx[i], width, m_weights, m_half, m_simd);
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<unsigned short> &m_GIx;
+  const std::vector<unsigned short> &m_weights;
+  unsigned int m_half;
+  bool m_simd;
+};
+
+class vpFixedPointColumnsBody : public vpParallelBody
+{
+public:
+  vpFixedPointColumnsBody(const vpImage<unsigned short> &GIx, vpImage<unsigned char> &GI,
+                          const std::vector<unsigned short> &weights, unsigned int half)
+    : m_GIx(GIx), m_GI(GI), m_weights(weights), m_half(half), m_simd(useSIMD())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int height = m_GIx.getHeight();
+    std::vector<const unsigned short *> rows(2 * m_half + 1);
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int k = 0; k <= 2 * m_half; k++) {
+        rows[k] = m_GIx[reflectIndex(static_cast<int>(i + k) - static_cast<int>(m_half), height)];
+      }
+      fixedPointColumns(&rows[0], m_GI[i], m_GIx.getWidth(), m_weights, m_half, m_simd);
+    }
+  }
+
+private:
+  const vpImage<unsigned short> &m_GIx;
+  vpImage<unsigned char> &m_GI;
+  const std::vector<unsigned short> &m_weights;
+  unsigned int m_half;
+  bool m_simd;
+};
+
+// Horizontal pass of vpImageFilter::sepFilter(), only pixels fully covered by the kernel are computed
+class vpSepFilterRowBody : public vpParallelBody
+{
+public:
+  vpSepFilterRowBody(const vpImage<unsigned char> &I, vpImage<double> &I_filter, const vpColVector &kernel)
+    : m_I(I), m_I_filter(I_filter), m_kernel(kernel)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int half_size = m_kernel.size() / 2;
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int j = half_size; j < m_I.getWidth() - half_size; j++) {
+        double conv = 0.0;
+        for (unsigned int a = 0; a < m_kernel.size(); a++) {
+          conv += m_kernel[a] * m_I[i][j + half_size - a];
+        }
+
+        m_I_filter[i][j] = conv;
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<double> &m_I_filter;
+  const vpColVector &m_kernel;
+};
+
+// Vertical pass of vpImageFilter::sepFilter()
+class vpSepFilterColumnBody : public vpParallelBody
+{
+public:
+  vpSepFilterColumnBody(const vpImage<double> &I_filter, vpImage<double> &If, const vpColVector &kernel,
+                        unsigned int half_size)
+    : m_I_filter(I_filter), m_If(If), m_kernel(kernel), m_half_size(half_size)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int j = 0; j < m_I_filter.getWidth(); j++) {
+        double conv = 0.0;
+        for (unsigned int a = 0; a < m_kernel.size(); a++) {
+          conv += m_kernel[a] * m_I_filter[i + m_half_size - a][j];
+        }
+
+        m_If[i][j] = conv;
+      }
+    }
+  }
+
+private:
+  const vpImage<double> &m_I_filter;
+  vpImage<double> &m_If;
+  const vpColVector &m_kernel;
+  unsigned int m_half_size;
+};
+
+/*
+  Fourth order recursive approximation of the Gaussian filter of Deriche
+  (1993), "Recursively implementing the Gaussian and its derivatives", as the
+  sum of a causal and an anti-causal part:
+    y+[n] = n0 x[n] + n1 x[n-1] + n2 x[n-2] + n3 x[n-3] - sum_k d_k y+[n-k]
+    y-[n] = m1 x[n+1] + m2 x[n+2] + m3 x[n+3] + m4 x[n+4] - sum_k d_k y-[n+k]
+    y[n] = y+[n] + y-[n]
+  The coefficients are normalized to a unit gain. Since the two parts are
+  independent, replicating the signal beyond its ends is exactly handled by
+  starting each part from its steady state on the border value.
+*/
+struct vpRecursiveGaussian {
+  double n[4]; // n0, n1, n2, n3
+  double m[4]; // m1, m2, m3, m4
+  double d[4]; // d1, d2, d3, d4
+  double gain_causal, gain_anticausal;
+
+  explicit vpRecursiveGaussian(double sigma)
+  {
+    const double a1 = 1.3530, b1 = 1.8151, w1 = 0.6681, l1 = -1.3932;
+    const double a2 = -0.3531, b2 = 0.0902, w2 = 2.0787, l2 = -1.3732;
+    const double sin1 = sin(w1 / sigma), sin2 = sin(w2 / sigma), cos1 = cos(w1 / sigma), cos2 = cos(w2 / sigma);
+    const double exp1 = exp(l1 / sigma), exp2 = exp(l2 / sigma);
+
+    n[0] = a1 + a2;
+    n[1] = exp2 * (b2 * sin2 - (a2 + 2 * a1) * cos2) + exp1 * (b1 * sin1 - (a1 + 2 * a2) * cos1);
+    n[2] = 2 * exp1 * exp2 * ((a1 + a2) * cos2 * cos1 - b1 * cos2 * sin1 - b2 * cos1 * sin2) + a2 * exp1 * exp1 +
+           a1 * exp2 * exp2;
+    n[3] = exp2 * exp1 * exp1 * (b2 * sin2 - a2 * cos2) + exp1 * exp2 * exp2 * (b1 * sin1 - a1 * cos1);
+
+    d[0] = -2 * (exp2 * cos2 + exp1 * cos1);
+    d[1] = 4 * cos2 * cos1 * exp1 * exp2 + exp1 * exp1 + exp2 * exp2;
+    d[2] = -2 * cos1 * exp1 * exp2 * exp2 - 2 * cos2 * exp2 * exp1 * exp1;
+    d[3] = exp1 * exp1 * exp2 * exp2;
+
+    // Symmetric filter
+    m[0] = n[1] - d[0] * n[0];
+    m[1] = n[2] - d[1] * n[0];
+    m[2] = n[3] - d[2] * n[0];
+    m[3] = -d[3] * n[0];
+
+    const double sum_n = n[0] + n[1] + n[2] + n[3], sum_m = m[0] + m[1] + m[2] + m[3];
+    const double sum_d = 1.0 + d[0] + d[1] + d[2] + d[3];
+    const double alpha = (sum_n + sum_m) / sum_d;
+    for (unsigned int k = 0; k < 4; k++) {
+      n[k] /= alpha;
+      m[k] /= alpha;
+    }
+
+    // Output of each part for a constant unit signal
+    gain_causal = sum_n / alpha / sum_d;
+    gain_anticausal = sum_m / alpha / sum_d;
+  }
+};
+
+template <class Type>
+void recursiveGaussianRow(const Type *src, double *dst, unsigned int size, const vpRecursiveGaussian &g)
+{
+  const int last = static_cast<int>(size) - 1;
+
+  // Causal part, the signal is constant before its first sample
+  double x1 = src[0], x2 = x1, x3 = x1;
+  double y1 = g.gain_causal * src[0], y2 = y1, y3 = y1, y4 = y1;
+  for (int i = 0; i <= last; i++) {
+    const double x0 = src[i];
+    const double y = g.n[0] * x0 + g.n[1] * x1 + g.n[2] * x2 + g.n[3] * x3 - g.d[0] * y1 - g.d[1] * y2 -
+                     g.d[2] * y3 - g.d[3] * y4;
+    x3 = x2;
+    x2 = x1;
+    x1 = x0;
+    y4 = y3;
+    y3 = y2;
+    y2 = y1;
+    y1 = y;
+    dst[i] = y;
+  }
+
+  // Anti-causal part, the signal is constant after its last sample
+  x1 = src[last];
+  x2 = x1;
+  x3 = x1;
+  double x4 = x1;
+  y1 = g.gain_anticausal * src[last];
+  y2 = y1;
+  y3 = y1;
+  y4 = y1;
+  for (int i = last; i >= 0; i--) {
+    const double y = g.m[0] * x1 + g.m[1] * x2 + g.m[2] * x3 + g.m[3] * x4 - g.d[0] * y1 - g.d[1] * y2 -
+                     g.d[2] * y3 - g.d[3] * y4;
+    x4 = x3;
+    x3 = x2;
+    x2 = x1;
+    x1 = src[i];
+    y4 = y3;
+    y3 = y2;
+    y2 = y1;
+    y1 = y;
+    dst[i] += y;
+  }
+}
+
+template <class Type> class vpRecursiveGaussianRowBody : public vpParallelBody
+{
+public:
+  vpRecursiveGaussianRowBody(const vpImage<Type> &I, vpImage<double> &GI, const vpRecursiveGaussian &g)
+    : m_I(I), m_GI(GI), m_g(g)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      recursiveGaussianRow(m_I[i], m_GI[i], m_I.getWidth(), m_g);
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<double> &m_GI;
+  const vpRecursiveGaussian &m_g;
+};
+
+// The columns [begin, end[ are filtered together, row by row, to access the
+// memory contiguously
+class vpRecursiveGaussianColumnsBody : public vpParallelBody
+{
+public:
+  vpRecursiveGaussianColumnsBody(const vpImage<double> &I, vpImage<double> &GI, const vpRecursiveGaussian &g)
+    : m_I(I), m_GI(GI), m_g(g)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const int last = static_cast<int>(m_I.getHeight()) - 1;
+    const unsigned int n = end - begin;
+
+    // Causal part, the previous outputs are read in the output image, or in
+    // the steady state before the first row
+    std::vector<double> y_init(n);
+    for (unsigned int j = 0; j < n; j++) {
+      y_init[j] = m_g.gain_causal * m_I[0][begin + j];
+    }
+    for (int i = 0; i <= last; i++) {
+      const double *x[4], *y[4];
+      for (int k = 0; k < 4; k++) {
+        x[k] = m_I[std::max(i - k, 0)] + begin;
+        y[k] = i - k - 1 >= 0 ? m_GI[i - k - 1] + begin : &y_init[0];
+      }
+      double *dst = m_GI[i] + begin;
+      for (unsigned int j = 0; j < n; j++) {
+        dst[j] = m_g.n[0] * x[0][j] + m_g.n[1] * x[1][j] + m_g.n[2] * x[2][j] + m_g.n[3] * x[3][j] -
+                 m_g.d[0] * y[0][j] - m_g.d[1] * y[1][j] - m_g.d[2] * y[2][j] - m_g.d[3] * y[3][j];
+      }
+    }
+
+    // Anti-causal part, added to the causal part: its previous outputs are
+    // kept in 4 rotating rows
+    std::vector<double> buffer(4 * n);
+    double *y[4];
+    for (int k = 0; k < 4; k++) {
+      y[k] = &buffer[k * n];
+      for (unsigned int j = 0; j < n; j++) {
+        y[k][j] = m_g.gain_anticausal * m_I[last][begin + j];
+      }
+    }
+    for (int i = last; i >= 0; i--) {
+      const double *x[4];
+      for (int k = 0; k < 4; k++) {
+        x[k] = m_I[std::min(i + k + 1, last)] + begin;
+      }
+      double *y_new = y[3];
+      double *dst = m_GI[i] + begin;
+      for (unsigned int j = 0; j < n; j++) {
+        y_new[j] = m_g.m[0] * x[0][j] + m_g.m[1] * x[1][j] + m_g.m[2] * x[2][j] + m_g.m[3] * x[3][j] -
+                   m_g.d[0] * y[0][j] - m_g.d[1] * y[1][j] - m_g.d[2] * y[2][j] - m_g.d[3] * y[3][j];
+        dst[j] += y_new[j];
+      }
+      y[3] = y[2];
+      y[2] = y[1];
+      y[1] = y[0];
+      y[0] = y_new;
+    }
+  }
+
+private:
+  const vpImage<double> &m_I;
+  vpImage<double> &m_GI;
+  const vpRecursiveGaussian &m_g;
+};
+
+template <class Type> void recursiveGaussianBlur(const vpImage<Type> &I, vpImage<double> &GI, double sigma)
+{
+  if (sigma < 0.5) {
+    throw vpImageException(vpImageException::incorrectInitializationError,
+                           "The recursive Gaussian filter needs sigma >= 0.5");
+  }
+
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  if (height == 0 || width == 0) {
+    GI.resize(height, width);
+    return;
+  }
+
+  const vpRecursiveGaussian g(sigma);
+  vpImage<double> GIx(height, width);
+  vpParallel::parallelFor(0, height, vpRecursiveGaussianRowBody<Type>(I, GIx, g));
+  GI.resize(height, width);
+  vpParallel::parallelFor(0, width, vpRecursiveGaussianColumnsBody(GIx, GI, g));
+}
+} // namespace
+
 /*!
   Apply a filter to an image.
   \param I : Image to filter
@@ -231,26 +1106,11 @@ void vpImageFilter::sepFilter(const vpImage<unsigned char> &I, vpImage<double> &
   If.resize(I.getHeight(), I.getWidth(), 0.0);
   vpImage<double> I_filter(I.getHeight(), I.getWidth(), 0.0);
 
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = half_size; j < I.getWidth() - half_size; j++) {
-      double conv = 0.0;
-      for (unsigned int a = 0; a < kernelH.size(); a++) {
-        conv += kernelH[a] * I[i][j + half_size - a];
-      }
-
-      I_filter[i][j] = conv;
-    }
+  if (I.getWidth() > 2 * half_size) {
+    vpParallel::parallelFor(0, I.getHeight(), vpSepFilterRowBody(I, I_filter, kernelH));
   }
-
-  for (unsigned int i = half_size; i < I.getHeight() - half_size; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      double conv = 0.0;
-      for (unsigned int a = 0; a < kernelV.size(); a++) {
-        conv += kernelV[a] * I_filter[i + half_size - a][j];
-      }
-
-      If[i][j] = conv;
-    }
+  if (I.getHeight() > 2 * half_size) {
+    vpParallel::parallelFor(half_size, I.getHeight() - half_size, vpSepFilterColumnBody(I_filter, If, kernelV, half_size));
   }
 }
 
@@ -347,20 +1207,7 @@ void vpImageFilter::filter(const vpImage<double> &I, vpImage<double> &GI, const
 void vpImageFilter::filterX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
                             unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-  }
+  separableFilterX(I, dIx, filter, size);
 }
 void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, const double *filter,
                             unsigned int size)
@@ -386,40 +1233,12 @@ void vpImageFilter::filterX(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIx, cons
 }
 void vpImageFilter::filterX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
-      // dIx[i][j]=0;
-    }
-  }
+  separableFilterX(I, dIx, filter, size);
 }
 void vpImageFilter::filterY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
                             unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
-    }
-  }
+  separableFilterY(I, dIy, filter, size);
 }
 void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, const double *filter,
                             unsigned int size)
@@ -449,22 +1268,7 @@ void vpImageFilter::filterY(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &dIy, cons
 }
 void vpImageFilter::filterY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
-    }
-  }
+  separableFilterY(I, dIy, filter, size);
 }
 
 /*!
@@ -491,6 +1295,56 @@ void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<double
   delete[] fg;
 }
 
+/*!
+  Apply a Gaussian blur to a grayscale image and store the result as an 8-bit image.
+
+  The kernel coefficients are quantized (8 bits for the horizontal pass, 12 bits
+  for the vertical one) and the separable passes use a fixed-point 16-bit / 32-bit
+  accumulation, which allows SIMD processing of 8 pixels at once. The result stays
+  within about one gray level of the double precision gaussianBlur(). When the kernel cannot be
+  quantized (non normalized kernel), the double precision path is used instead.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param size : Filter size. This value should be odd.
+  \param sigma : Gaussian standard deviation. If it is equal to zero or
+  negative, it is computed from filter size as sigma = (size-1)/6.
+  \param normalize : Flag indicating whether to normalize the filter coefficients or
+  not.
+
+  \sa getGaussianKernel() to know which kernel is used.
+ */
+void vpImageFilter::gaussianBlur(const vpImage<unsigned char> &I, vpImage<unsigned char> &GI, unsigned int size,
+                                 double sigma, bool normalize)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int half = (size - 1) / 2;
+  std::vector<double> fg((size + 1) / 2);
+  vpImageFilter::getGaussianKernel(&fg[0], size, sigma, normalize);
+
+  std::vector<unsigned short> weightsX, weightsY;
+  if (!quantizeKernel(&fg[0], half, 8, weightsX) || !quantizeKernel(&fg[0], half, 12, weightsY)) {
+    vpImage<double> GId;
+    vpImageFilter::gaussianBlur(I, GId, size, sigma, normalize);
+    GI.resize(height, width);
+    for (unsigned int i = 0; i < height; i++) {
+      for (unsigned int j = 0; j < width; j++) {
+        GI[i][j] = vpMath::saturate<unsigned char>(GId[i][j]);
+      }
+    }
+    return;
+  }
+
+  GI.resize(height, width);
+  if (width == 0 || height == 0) {
+    return;
+  }
+
+  vpImage<unsigned short> GIx(height, width);
+  vpParallel::parallelFor(0, height, vpFixedPointRowBody(I, GIx, weightsX, half));
+  vpParallel::parallelFor(0, height, vpFixedPointColumnsBody(GIx, GI, weightsY, half));
+}
+
 /*!
   Apply a Gaussian blur to RGB color image.
   \param I : Input image.
@@ -537,6 +1391,45 @@ void vpImageFilter::gaussianBlur(const vpImage<double> &I, vpImage<double> &GI,
   delete[] fg;
 }
 
+/*!
+  Apply a Gaussian blur to a grayscale image with a recursive (IIR) filter,
+  whose cost does not depend on \e sigma. This is the filter to use for large
+  \e sigma, where the convolution with gaussianBlur() becomes too expensive.
+
+  The fourth order recursive filter of Deriche \cite Deriche1993 is applied
+  on the rows then on the columns, in parallel with vpParallel. The pixels
+  outside of the image are replicated from the border. On 8-bit images, the
+  result differs from the exact convolution with the same border handling by
+  less than 1 gray level.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param sigma : Gaussian standard deviation, greater or equal to 0.5.
+
+  \sa gaussianBlur() for the direct convolution with a truncated kernel.
+*/
+void vpImageFilter::gaussianBlurRecursive(const vpImage<unsigned char> &I, vpImage<double> &GI, double sigma)
+{
+  recursiveGaussianBlur(I, GI, sigma);
+}
+
+/*!
+  Apply a Gaussian blur to a double image with a recursive (IIR) filter,
+  whose cost does not depend on \e sigma. \e I and \e GI can be the same
+  image.
+
+  \param I : Input image.
+  \param GI : Filtered image.
+  \param sigma : Gaussian standard deviation, greater or equal to 0.5.
+
+  \sa gaussianBlurRecursive(const vpImage<unsigned char> &, vpImage<double> &, double)
+  for the accuracy.
+*/
+void vpImageFilter::gaussianBlurRecursive(const vpImage<double> &I, vpImage<double> &GI, double sigma)
+{
+  recursiveGaussianBlur(I, GI, sigma);
+}
+
 /*!
   Return the coefficients \f$G_i\f$ of a Gaussian filter.
 
@@ -662,80 +1555,22 @@ void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &d
 void vpImageFilter::getGradX(const vpImage<unsigned char> &I, vpImage<double> &dIx, const double *filter,
                              unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  separableGradX(I, dIx, filter, size);
 }
 void vpImageFilter::getGradX(const vpImage<double> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
 {
-  dIx.resize(I.getHeight(), I.getWidth());
-  // dIx=0;
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
-      dIx[i][j] = 0;
-    }
-    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
-      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
-    }
-    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
-      dIx[i][j] = 0;
-    }
-  }
+  separableGradX(I, dIx, filter, size);
 }
 
 void vpImageFilter::getGradY(const vpImage<unsigned char> &I, vpImage<double> &dIy, const double *filter,
                              unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  //#pragma omp parallel for
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  //#pragma omp parallel for
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  separableGradY(I, dIy, filter, size);
 }
 
 void vpImageFilter::getGradY(const vpImage<double> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
 {
-  dIy.resize(I.getHeight(), I.getWidth());
-  // dIy=0;
-  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
-  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
-    }
-  }
-  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      dIy[i][j] = 0;
-    }
-  }
+  separableGradY(I, dIy, filter, size);
 }
 
 /*!
@@ -36,14 +36,237 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <vector>
+
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpParallel.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
 #define VISP_HAVE_SSE2 1
 #endif
 
+namespace
+{
+struct vpMinOp {
+  static unsigned char neutral() { return 255; }
+  static unsigned char apply(unsigned char a, unsigned char b) { return a < b ? a : b; }
+#if VISP_HAVE_SSE2
+  static __m128i apply(const __m128i &a, const __m128i &b) { return _mm_min_epu8(a, b); }
+#endif
+};
+
+struct vpMaxOp {
+  static unsigned char neutral() { return 0; }
+  static unsigned char apply(unsigned char a, unsigned char b) { return a > b ? a : b; }
+#if VISP_HAVE_SSE2
+  static __m128i apply(const __m128i &a, const __m128i &b) { return _mm_max_epu8(a, b); }
+#endif
+};
+
+// dst = op(a, b) on n pixels
+template <class Op>
+void combineRows(const unsigned char *a, const unsigned char *b, unsigned char *dst, unsigned int n, bool simd)
+{
+  unsigned int j = 0;
+#if VISP_HAVE_SSE2
+  if (simd) {
+    for (; j + 16 <= n; j += 16) {
+      const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + j));
+      const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + j));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), Op::apply(va, vb));
+    }
+  }
+#else
+  (void)simd;
+#endif
+  for (; j < n; j++) {
+    dst[j] = Op::apply(a[j], b[j]);
+  }
+}
+
+// van Herk / Gil-Werman running min / max over windows of length L: the
+// sequence is split into blocks of L values, and the result of a window is
+// combined from the suffix of the block where it starts and the prefix of the
+// block where it ends. 3 operations per value, whatever L.
+template <class Op>
+void vhgwRow(const unsigned char *src, unsigned int n, unsigned int L, unsigned char *dst, unsigned char *prefix,
+             unsigned char *suffix)
+{
+  for (unsigned int b = 0; b < n; b += L) {
+    const unsigned int e = std::min(b + L, n);
+    prefix[b] = src[b];
+    for (unsigned int x = b + 1; x < e; x++) {
+      prefix[x] = Op::apply(prefix[x - 1], src[x]);
+    }
+    suffix[e - 1] = src[e - 1];
+    for (unsigned int x = e - 1; x > b; x--) {
+      suffix[x - 1] = Op::apply(suffix[x], src[x - 1]);
+    }
+  }
+  for (unsigned int x = 0; x + L <= n; x++) {
+    dst[x] = Op::apply(suffix[x], prefix[x + L - 1]);
+  }
+}
+
+// Horizontal windows of length L on the rows of src: dst has src.getWidth() - L + 1 columns
+template <class Op> class vpHorizontalBody : public vpParallelBody
+{
+public:
+  vpHorizontalBody(const vpImage<unsigned char> &src, unsigned int L, vpImage<unsigned char> &dst)
+    : m_src(src), m_L(L), m_dst(dst)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    std::vector<unsigned char> prefix(m_src.getWidth()), suffix(m_src.getWidth());
+    for (unsigned int i = begin; i < end; i++) {
+      vhgwRow<Op>(m_src[i], m_src.getWidth(), m_L, m_dst[i], &prefix[0], &suffix[0]);
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_src;
+  unsigned int m_L;
+  vpImage<unsigned char> &m_dst;
+};
+
+// Prefix and suffix rows of the blocks of L rows of the columns [j0, j0 + width[ of src
+template <class Op> class vpVerticalBlocksBody : public vpParallelBody
+{
+public:
+  vpVerticalBlocksBody(const vpImage<unsigned char> &src, unsigned int j0, unsigned int L,
+                       vpImage<unsigned char> &prefix, vpImage<unsigned char> &suffix, bool simd)
+    : m_src(src), m_j0(j0), m_L(L), m_prefix(prefix), m_suffix(suffix), m_simd(simd)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int n = m_src.getHeight(), width = m_prefix.getWidth();
+    for (unsigned int block = begin; block < end; block++) {
+      const unsigned int b = block * m_L, e = std::min(b + m_L, n);
+      memcpy(m_prefix[b], m_src[b] + m_j0, width);
+      for (unsigned int x = b + 1; x < e; x++) {
+        combineRows<Op>(m_prefix[x - 1], m_src[x] + m_j0, m_prefix[x], width, m_simd);
+      }
+      memcpy(m_suffix[e - 1], m_src[e - 1] + m_j0, width);
+      for (unsigned int x = e - 1; x > b; x--) {
+        combineRows<Op>(m_suffix[x], m_src[x - 1] + m_j0, m_suffix[x - 1], width, m_simd);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_src;
+  unsigned int m_j0;
+  unsigned int m_L;
+  vpImage<unsigned char> &m_prefix;
+  vpImage<unsigned char> &m_suffix;
+  bool m_simd;
+};
+
+template <class Op> class vpVerticalCombineBody : public vpParallelBody
+{
+public:
+  vpVerticalCombineBody(const vpImage<unsigned char> &prefix, const vpImage<unsigned char> &suffix, unsigned int L,
+                        vpImage<unsigned char> &dst, bool simd)
+    : m_prefix(prefix), m_suffix(suffix), m_L(L), m_dst(dst), m_simd(simd)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int x = begin; x < end; x++) {
+      combineRows<Op>(m_suffix[x], m_prefix[x + m_L - 1], m_dst[x], m_dst.getWidth(), m_simd);
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_prefix;
+  const vpImage<unsigned char> &m_suffix;
+  unsigned int m_L;
+  vpImage<unsigned char> &m_dst;
+  bool m_simd;
+};
+
+// Vertical windows of length L on the columns [j0, j0 + dst.getWidth()[ of src:
+// dst has src.getHeight() - L + 1 rows. Whole rows are combined with SIMD min / max.
+template <class Op>
+void vhgwVertical(const vpImage<unsigned char> &src, unsigned int j0, unsigned int L, vpImage<unsigned char> &dst,
+                  bool simd)
+{
+  if (L == 1) {
+    for (unsigned int i = 0; i < dst.getHeight(); i++) {
+      memcpy(dst[i], src[i] + j0, dst.getWidth());
+    }
+    return;
+  }
+  vpImage<unsigned char> prefix(src.getHeight(), dst.getWidth()), suffix(src.getHeight(), dst.getWidth());
+  vpParallel::parallelFor(0, (src.getHeight() + L - 1) / L,
+                          vpVerticalBlocksBody<Op>(src, j0, L, prefix, suffix, simd));
+  vpParallel::parallelFor(0, dst.getHeight(), vpVerticalCombineBody<Op>(prefix, suffix, L, dst, simd));
+}
+
+// Flat erosion (vpMinOp) or dilatation (vpMaxOp) of I by the structuring
+// element se, whose runs are the ones of the mask for an erosion and of the
+// reflected mask for a dilatation. The image is padded with the neutral value
+// of the operator.
+template <class Op>
+void morphology(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  const unsigned int top = se.getAnchorI(), left = se.getAnchorJ();
+  const unsigned int se_h = se.getHeight(), se_w = se.getWidth();
+  const vpStructuringElement::vpShapeType shape = se.getShape();
+  const std::vector<vpStructuringElement::vpRun> &runs = se.getRuns();
+  const bool simd = vpCPUFeatures::checkSSE2();
+
+  vpImage<unsigned char> P(height + se_h - 1, width + se_w - 1, Op::neutral());
+  for (unsigned int i = 0; i < height; i++) {
+    memcpy(P[top + i] + left, I[i], width);
+  }
+  Ires.resize(height, width);
+
+  if (shape == vpStructuringElement::SHAPE_RECTANGLE) {
+    vpImage<unsigned char> H(P.getHeight(), width);
+    vpParallel::parallelFor(0, P.getHeight(), vpHorizontalBody<Op>(P, se_w, H));
+    vhgwVertical<Op>(H, 0, se_h, Ires, simd);
+  } else if (shape == vpStructuringElement::SHAPE_CROSS) {
+    vpImage<unsigned char> H(P.getHeight(), width), V(height, width);
+    vpParallel::parallelFor(top, top + height, vpHorizontalBody<Op>(P, se_w, H));
+    vhgwVertical<Op>(P, left, se_h, V, simd);
+    for (unsigned int i = 0; i < height; i++) {
+      combineRows<Op>(H[top + i], V[i], Ires[i], width, simd);
+    }
+  } else {
+    // Runs of the same length share the same horizontal pass
+    Ires = Op::neutral();
+    std::map<unsigned int, std::vector<size_t> > lengths;
+    for (size_t k = 0; k < runs.size(); k++) {
+      lengths[runs[k].length].push_back(k);
+    }
+    vpImage<unsigned char> H;
+    for (std::map<unsigned int, std::vector<size_t> >::const_iterator it = lengths.begin(); it != lengths.end();
+         ++it) {
+      H.resize(P.getHeight(), P.getWidth() - it->first + 1);
+      vpParallel::parallelFor(0, P.getHeight(), vpHorizontalBody<Op>(P, it->first, H));
+      for (size_t k = 0; k < it->second.size(); k++) {
+        const int di = runs[it->second[k]].di, dj = runs[it->second[k]].dj;
+        for (unsigned int i = 0; i < height; i++) {
+          combineRows<Op>(Ires[i], H[static_cast<int>(top + i) + di] + static_cast<int>(left) + dj, Ires[i], width,
+                          simd);
+        }
+      }
+    }
+  }
+}
+} // namespace
+
 /*!
   Erode a grayscale image using the given structuring element.
 
@@ -98,8 +321,8 @@ void vpImageMorphology::erosion(vpImage<unsigned char> &I, const vpConnexityType
 
     for (unsigned int i = 0; i < I.getHeight(); i++) {
       unsigned int j = 0;
-      unsigned char *ptr_curr_J = J.bitmap + i * J.getWidth();
-      unsigned char *ptr_curr_I = I.bitmap + i * I.getWidth();
+      unsigned char *ptr_curr_J = J[i];
+      unsigned char *ptr_curr_I = I[i];
 
 #if VISP_HAVE_SSE2
       if (checkSSE2 && I.getWidth() >= 16) {
@@ -141,8 +364,8 @@ void vpImageMorphology::erosion(vpImage<unsigned char> &I, const vpConnexityType
 
     for (unsigned int i = 0; i < I.getHeight(); i++) {
       unsigned int j = 0;
-      unsigned char *ptr_curr_J = J.bitmap + i * J.getWidth();
-      unsigned char *ptr_curr_I = I.bitmap + i * I.getWidth();
+      unsigned char *ptr_curr_J = J[i];
+      unsigned char *ptr_curr_I = I[i];
 
 #if VISP_HAVE_SSE2
       if (checkSSE2 && I.getWidth() >= 16) {
@@ -228,8 +451,8 @@ void vpImageMorphology::dilatation(vpImage<unsigned char> &I, const vpConnexityT
 
     for (unsigned int i = 0; i < I.getHeight(); i++) {
       unsigned int j = 0;
-      unsigned char *ptr_curr_J = J.bitmap + i * J.getWidth();
-      unsigned char *ptr_curr_I = I.bitmap + i * I.getWidth();
+      unsigned char *ptr_curr_J = J[i];
+      unsigned char *ptr_curr_I = I[i];
 
 #if VISP_HAVE_SSE2
       if (checkSSE2 && I.getWidth() >= 16) {
@@ -271,8 +494,8 @@ void vpImageMorphology::dilatation(vpImage<unsigned char> &I, const vpConnexityT
 
     for (unsigned int i = 0; i < I.getHeight(); i++) {
       unsigned int j = 0;
-      unsigned char *ptr_curr_J = J.bitmap + i * J.getWidth();
-      unsigned char *ptr_curr_I = I.bitmap + i * I.getWidth();
+      unsigned char *ptr_curr_J = J[i];
+      unsigned char *ptr_curr_I = I[i];
 
 #if VISP_HAVE_SSE2
       if (checkSSE2 && I.getWidth() >= 16) {
@@ -303,3 +526,130 @@ void vpImageMorphology::dilatation(vpImage<unsigned char> &I, const vpConnexityT
     }
   }
 }
+
+/*!
+  Erode a grayscale image with a flat structuring element: each pixel is set
+  to the minimum of the pixels covered by the element. Pixels outside of the
+  image are considered as \f$ + \infty \f$.
+
+  The cost per pixel does not depend on the size of rectangular and line
+  elements, and only depends on the number of rows of the other elements (see
+  vpStructuringElement).
+
+  \param I : Image to process.
+  \param Ires : Eroded image. It can be the same image than \e I.
+  \param se : Structuring element.
+
+  \sa dilatation(const vpImage<unsigned char> &, vpImage<unsigned char> &, const vpStructuringElement &)
+*/
+void vpImageMorphology::erosion(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                const vpStructuringElement &se)
+{
+  if (I.getSize() == 0) {
+    Ires.resize(0, 0);
+    return;
+  }
+  morphology<vpMinOp>(I, Ires, se);
+}
+
+/*!
+  Dilate a grayscale image with a flat structuring element: each pixel is set
+  to the maximum of the pixels covered by the reflected element. Pixels outside
+  of the image are considered as \f$ - \infty \f$.
+
+  \param I : Image to process.
+  \param Ires : Dilated image. It can be the same image than \e I.
+  \param se : Structuring element.
+
+  \sa erosion(const vpImage<unsigned char> &, vpImage<unsigned char> &, const vpStructuringElement &)
+*/
+void vpImageMorphology::dilatation(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                   const vpStructuringElement &se)
+{
+  if (I.getSize() == 0) {
+    Ires.resize(0, 0);
+    return;
+  }
+  morphology<vpMaxOp>(I, Ires, se.reflect());
+}
+
+/*!
+  Morphological opening: erosion followed by a dilatation. It removes the
+  bright details smaller than the structuring element.
+
+  \param I : Image to process.
+  \param Ires : Opened image. It can be the same image than \e I.
+  \param se : Structuring element.
+*/
+void vpImageMorphology::opening(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                const vpStructuringElement &se)
+{
+  vpImage<unsigned char> I_erode;
+  erosion(I, I_erode, se);
+  dilatation(I_erode, Ires, se);
+}
+
+/*!
+  Morphological closing: dilatation followed by an erosion. It removes the
+  dark details smaller than the structuring element.
+
+  \param I : Image to process.
+  \param Ires : Closed image. It can be the same image than \e I.
+  \param se : Structuring element.
+*/
+void vpImageMorphology::closing(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                const vpStructuringElement &se)
+{
+  vpImage<unsigned char> I_dilate;
+  dilatation(I, I_dilate, se);
+  erosion(I_dilate, Ires, se);
+}
+
+/*!
+  Morphological gradient: difference between the dilatation and the erosion.
+
+  \param I : Image to process.
+  \param Ires : Gradient image. It can be the same image than \e I.
+  \param se : Structuring element.
+*/
+void vpImageMorphology::gradient(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                 const vpStructuringElement &se)
+{
+  vpImage<unsigned char> I_dilate, I_erode;
+  dilatation(I, I_dilate, se);
+  erosion(I, I_erode, se);
+  Ires.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < Ires.getHeight(); i++) {
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      Ires[i][j] = I_dilate[i][j] - I_erode[i][j];
+    }
+  }
+}
+
+/*!
+  Top-hat transform. The white top-hat is the difference between the image and
+  its opening, it extracts the bright details smaller than the structuring
+  element. The black top-hat is the difference between the closing and the
+  image, it extracts the dark details.
+
+  \param I : Image to process.
+  \param Ires : Top-hat image. It can be the same image than \e I.
+  \param se : Structuring element.
+  \param white : If true the white top-hat is computed, otherwise the black top-hat.
+*/
+void vpImageMorphology::topHat(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                               const vpStructuringElement &se, bool white)
+{
+  vpImage<unsigned char> I_filtered;
+  if (white) {
+    opening(I, I_filtered, se);
+  } else {
+    closing(I, I_filtered, se);
+  }
+  Ires.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < Ires.getHeight(); i++) {
+    for (unsigned int j = 0; j < Ires.getWidth(); j++) {
+      Ires[i][j] = white ? I[i][j] - I_filtered[i][j] : I_filtered[i][j] - I[i][j];
+    }
+  }
+}
@@ -36,9 +36,14 @@
  *
  *****************************************************************************/
 
+#include <algorithm>
+#include <limits>
+
 #include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpParallel.h>
 
 #if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
 #include <emmintrin.h>
@@ -54,6 +59,976 @@
 #endif
 #endif
 
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
+namespace
+{
+class vpImageDifferenceBody : public vpParallelBody
+{
+public:
+  vpImageDifferenceBody(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2, vpImage<unsigned char> &Idiff,
+                        bool checkSSSE3)
+    : m_I1(I1), m_I2(I2), m_Idiff(Idiff), m_checkSSSE3(checkSSSE3)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int r = begin; r < end; r++) {
+      differenceRow(m_I1[r], m_I2[r], m_Idiff[r], m_I1.getWidth());
+    }
+  }
+
+private:
+  void differenceRow(const unsigned char *src1, const unsigned char *src2, unsigned char *dst,
+                     unsigned int last) const
+  {
+    unsigned int i = 0;
+    if (m_checkSSSE3) {
+#if VISP_HAVE_SSSE3
+      if (last - i >= 16) {
+        const __m128i mask1 = _mm_set_epi8(-1, 14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0);
+        const __m128i mask2 = _mm_set_epi8(-1, 15, -1, 13, -1, 11, -1, 9, -1, 7, -1, 5, -1, 3, -1, 1);
+
+        const __m128i mask_out2 = _mm_set_epi8(14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0, -1);
+
+        for (; i + 16 <= last; i += 16) {
+          const __m128i vdata1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + i));
+          const __m128i vdata2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + i));
+
+          __m128i vdata1_reorg = _mm_shuffle_epi8(vdata1, mask1);
+          __m128i vdata2_reorg = _mm_shuffle_epi8(vdata2, mask1);
+
+          const __m128i vshift = _mm_set1_epi16(128);
+          __m128i vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
+
+          const __m128i v255 = _mm_set1_epi16(255);
+          const __m128i vzero = _mm_setzero_si128();
+          const __m128i vdata_diff_min_max1 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
+
+          vdata1_reorg = _mm_shuffle_epi8(vdata1, mask2);
+          vdata2_reorg = _mm_shuffle_epi8(vdata2, mask2);
+
+          vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
+          const __m128i vdata_diff_min_max2 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
+
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                           _mm_or_si128(_mm_shuffle_epi8(vdata_diff_min_max1, mask1),
+                                        _mm_shuffle_epi8(vdata_diff_min_max2, mask_out2)));
+        }
+      }
+#endif
+    }
+
+    for (; i < last; i++) {
+      int diff = src1[i] - src2[i] + 128;
+      dst[i] = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diff, 255), 0));
+    }
+  }
+
+  const vpImage<unsigned char> &m_I1;
+  const vpImage<unsigned char> &m_I2;
+  vpImage<unsigned char> &m_Idiff;
+  bool m_checkSSSE3;
+};
+
+class vpImageDifferenceRGBaBody : public vpParallelBody
+{
+public:
+  vpImageDifferenceRGBaBody(const vpImage<vpRGBa> &I1, const vpImage<vpRGBa> &I2, vpImage<vpRGBa> &Idiff,
+                            bool checkSSSE3)
+    : m_I1(I1), m_I2(I2), m_Idiff(Idiff), m_checkSSSE3(checkSSSE3)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int r = begin; r < end; r++) {
+      differenceRow(m_I1[r], m_I2[r], m_Idiff[r], m_I1.getWidth());
+    }
+  }
+
+private:
+  void differenceRow(const vpRGBa *src1, const vpRGBa *src2, vpRGBa *dst, unsigned int last) const
+  {
+    unsigned int i = 0;
+    if (m_checkSSSE3) {
+#if VISP_HAVE_SSSE3
+      if (last - i >= 4) {
+        const __m128i mask1 = _mm_set_epi8(-1, 14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0);
+        const __m128i mask2 = _mm_set_epi8(-1, 15, -1, 13, -1, 11, -1, 9, -1, 7, -1, 5, -1, 3, -1, 1);
+
+        const __m128i mask_out2 = _mm_set_epi8(14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0, -1);
+
+        for (; i + 4 <= last; i += 4) {
+          const __m128i vdata1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src1 + i));
+          const __m128i vdata2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src2 + i));
+
+          __m128i vdata1_reorg = _mm_shuffle_epi8(vdata1, mask1);
+          __m128i vdata2_reorg = _mm_shuffle_epi8(vdata2, mask1);
+
+          const __m128i vshift = _mm_set1_epi16(128);
+          __m128i vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
+
+          const __m128i v255 = _mm_set1_epi16(255);
+          const __m128i vzero = _mm_setzero_si128();
+          const __m128i vdata_diff_min_max1 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
+
+          vdata1_reorg = _mm_shuffle_epi8(vdata1, mask2);
+          vdata2_reorg = _mm_shuffle_epi8(vdata2, mask2);
+
+          vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
+          const __m128i vdata_diff_min_max2 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
+
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i),
+                           _mm_or_si128(_mm_shuffle_epi8(vdata_diff_min_max1, mask1),
+                                        _mm_shuffle_epi8(vdata_diff_min_max2, mask_out2)));
+        }
+      }
+#endif
+    }
+
+    for (; i < last; i++) {
+      int diffR = src1[i].R - src2[i].R + 128;
+      int diffG = src1[i].G - src2[i].G + 128;
+      int diffB = src1[i].B - src2[i].B + 128;
+      int diffA = src1[i].A - src2[i].A + 128;
+      dst[i].R = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffR, 255), 0));
+      dst[i].G = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffG, 255), 0));
+      dst[i].B = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffB, 255), 0));
+      dst[i].A = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffA, 255), 0));
+    }
+  }
+
+  const vpImage<vpRGBa> &m_I1;
+  const vpImage<vpRGBa> &m_I2;
+  vpImage<vpRGBa> &m_Idiff;
+  bool m_checkSSSE3;
+};
+
+class vpIntegralImageRowBody : public vpParallelBody
+{
+public:
+  vpIntegralImageRowBody(const vpImage<unsigned char> &I, vpImage<double> &II, vpImage<double> &IIsq)
+    : m_I(I), m_II(II), m_IIsq(IIsq)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      const unsigned char *src = m_I[i - 1];
+      double *ii = m_II[i], *iisq = m_IIsq[i];
+      for (unsigned int j = 1; j < m_II.getWidth(); j++) {
+        ii[j] = ii[j - 1] + src[j - 1];
+        iisq[j] = iisq[j - 1] + vpMath::sqr(src[j - 1]);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<double> &m_II;
+  vpImage<double> &m_IIsq;
+};
+
+class vpIntegralImageColumnBody : public vpParallelBody
+{
+public:
+  vpIntegralImageColumnBody(vpImage<double> &II, vpImage<double> &IIsq) : m_II(II), m_IIsq(IIsq) {}
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = 2; i < m_II.getHeight(); i++) {
+      const double *ii_prev = m_II[i - 1], *iisq_prev = m_IIsq[i - 1];
+      double *ii = m_II[i], *iisq = m_IIsq[i];
+      for (unsigned int j = begin; j < end; j++) {
+        ii[j] += ii_prev[j];
+        iisq[j] += iisq_prev[j];
+      }
+    }
+  }
+
+private:
+  vpImage<double> &m_II;
+  vpImage<double> &m_IIsq;
+};
+
+// Row prefix sums of the integer integral images. Four rows are processed
+// at a time to interleave their independent dependency chains.
+class vpIntegralImageIntRowBody : public vpParallelBody
+{
+public:
+  vpIntegralImageIntRowBody(const vpImage<unsigned char> &I, vpImage<uint32_t> &II, vpImage<uint64_t> *IIsq)
+    : m_I(I), m_II(II), m_IIsq(IIsq)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_I.getWidth();
+    unsigned int i = begin;
+    for (; i + 4 <= end; i += 4) {
+      const unsigned char *src0 = m_I[i - 1], *src1 = m_I[i], *src2 = m_I[i + 1], *src3 = m_I[i + 2];
+      uint32_t *ii0 = m_II[i], *ii1 = m_II[i + 1], *ii2 = m_II[i + 2], *ii3 = m_II[i + 3];
+      uint32_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+      for (unsigned int j = 0; j < width; j++) {
+        sum0 += src0[j];
+        sum1 += src1[j];
+        sum2 += src2[j];
+        sum3 += src3[j];
+        ii0[j + 1] = sum0;
+        ii1[j + 1] = sum1;
+        ii2[j + 1] = sum2;
+        ii3[j + 1] = sum3;
+      }
+
+      if (m_IIsq != NULL) {
+        uint64_t *iisq0 = (*m_IIsq)[i], *iisq1 = (*m_IIsq)[i + 1], *iisq2 = (*m_IIsq)[i + 2],
+                 *iisq3 = (*m_IIsq)[i + 3];
+        uint64_t sqsum0 = 0, sqsum1 = 0, sqsum2 = 0, sqsum3 = 0;
+        for (unsigned int j = 0; j < width; j++) {
+          sqsum0 += static_cast<uint32_t>(src0[j] * src0[j]);
+          sqsum1 += static_cast<uint32_t>(src1[j] * src1[j]);
+          sqsum2 += static_cast<uint32_t>(src2[j] * src2[j]);
+          sqsum3 += static_cast<uint32_t>(src3[j] * src3[j]);
+          iisq0[j + 1] = sqsum0;
+          iisq1[j + 1] = sqsum1;
+          iisq2[j + 1] = sqsum2;
+          iisq3[j + 1] = sqsum3;
+        }
+      }
+    }
+
+    for (; i < end; i++) {
+      const unsigned char *src = m_I[i - 1];
+      uint32_t *ii = m_II[i];
+      uint32_t sum = 0;
+      for (unsigned int j = 0; j < width; j++) {
+        sum += src[j];
+        ii[j + 1] = sum;
+      }
+
+      if (m_IIsq != NULL) {
+        uint64_t *iisq = (*m_IIsq)[i];
+        uint64_t sqsum = 0;
+        for (unsigned int j = 0; j < width; j++) {
+          sqsum += static_cast<uint32_t>(src[j] * src[j]);
+          iisq[j + 1] = sqsum;
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<uint32_t> &m_II;
+  vpImage<uint64_t> *m_IIsq;
+};
+
+// Column prefix sums of the integer integral images, over a stripe of columns
+class vpIntegralImageIntColumnBody : public vpParallelBody
+{
+public:
+  vpIntegralImageIntColumnBody(vpImage<uint32_t> &II, vpImage<uint64_t> *IIsq, bool checkSSE2)
+    : m_II(II), m_IIsq(IIsq), m_checkSSE2(checkSSE2)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = 2; i < m_II.getHeight(); i++) {
+      const uint32_t *ii_prev = m_II[i - 1];
+      uint32_t *ii = m_II[i];
+      unsigned int j = begin;
+#if VISP_HAVE_SSE2
+      if (m_checkSSE2) {
+        for (; j + 4 <= end; j += 4) {
+          const __m128i vprev = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ii_prev + j));
+          const __m128i vcur = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ii + j));
+          _mm_storeu_si128(reinterpret_cast<__m128i *>(ii + j), _mm_add_epi32(vcur, vprev));
+        }
+      }
+#endif
+      for (; j < end; j++) {
+        ii[j] += ii_prev[j];
+      }
+
+      if (m_IIsq != NULL) {
+        const uint64_t *iisq_prev = (*m_IIsq)[i - 1];
+        uint64_t *iisq = (*m_IIsq)[i];
+        j = begin;
+#if VISP_HAVE_SSE2
+        if (m_checkSSE2) {
+          for (; j + 2 <= end; j += 2) {
+            const __m128i vprev = _mm_loadu_si128(reinterpret_cast<const __m128i *>(iisq_prev + j));
+            const __m128i vcur = _mm_loadu_si128(reinterpret_cast<const __m128i *>(iisq + j));
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(iisq + j), _mm_add_epi64(vcur, vprev));
+          }
+        }
+#endif
+        for (; j < end; j++) {
+          iisq[j] += iisq_prev[j];
+        }
+      }
+    }
+  }
+
+private:
+  vpImage<uint32_t> &m_II;
+  vpImage<uint64_t> *m_IIsq;
+  bool m_checkSSE2;
+};
+
+void computeIntegralImage(const vpImage<unsigned char> &I, vpImage<uint32_t> &II, vpImage<uint64_t> *IIsq)
+{
+  // The sum of all the pixels must fit in 32 bits
+  if (I.getSize() > std::numeric_limits<uint32_t>::max() / 255) {
+    throw vpException(vpException::dimensionError, "Image %ux%u too large for a 32 bits integral image",
+                      I.getHeight(), I.getWidth());
+  }
+
+  II.resize(I.getHeight() + 1, I.getWidth() + 1, 0);
+  if (IIsq != NULL) {
+    IIsq->resize(I.getHeight() + 1, I.getWidth() + 1, 0);
+  }
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  vpParallel::parallelFor(1, II.getHeight(), vpIntegralImageIntRowBody(I, II, IIsq));
+  vpParallel::parallelFor(1, II.getWidth(), vpIntegralImageIntColumnBody(II, IIsq, vpCPUFeatures::checkSSE2()));
+}
+
+// Mean and variance of the pixels in the windows of size x size pixels
+// clipped to the image, from the integral images
+class vpLocalMeanVarianceBody : public vpParallelBody
+{
+public:
+  vpLocalMeanVarianceBody(const vpImage<uint32_t> &II, const vpImage<uint64_t> *IIsq, unsigned int size,
+                          vpImage<double> &I_mean, vpImage<double> *I_variance)
+    : m_II(II), m_IIsq(IIsq), m_half_size(size / 2), m_I_mean(I_mean), m_I_variance(I_variance)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int height = m_I_mean.getHeight(), width = m_I_mean.getWidth();
+    for (unsigned int i = begin; i < end; i++) {
+      const unsigned int top = i > m_half_size ? i - m_half_size : 0;
+      const unsigned int bottom = std::min(i + m_half_size + 1, height);
+      const uint32_t *ii_top = m_II[top], *ii_bottom = m_II[bottom];
+      for (unsigned int j = 0; j < width; j++) {
+        const unsigned int left = j > m_half_size ? j - m_half_size : 0;
+        const unsigned int right = std::min(j + m_half_size + 1, width);
+        const double area = static_cast<double>((bottom - top) * (right - left));
+        // Unsigned arithmetic is exact modulo 2^32 and the sum fits in 32 bits
+        const uint32_t sum = ii_bottom[right] - ii_bottom[left] - ii_top[right] + ii_top[left];
+        const double mean = sum / area;
+        m_I_mean[i][j] = mean;
+
+        if (m_I_variance != NULL) {
+          const uint64_t sqsum =
+              (*m_IIsq)[bottom][right] - (*m_IIsq)[bottom][left] - (*m_IIsq)[top][right] + (*m_IIsq)[top][left];
+          (*m_I_variance)[i][j] = std::max(sqsum / area - mean * mean, 0.0);
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<uint32_t> &m_II;
+  const vpImage<uint64_t> *m_IIsq;
+  unsigned int m_half_size;
+  vpImage<double> &m_I_mean;
+  vpImage<double> *m_I_variance;
+};
+
+// Level of the image pyramid with the integral images of the pixel values and
+// of their squared values, of size (height + 1) x (width + 1), computed with
+// exact integer arithmetic
+struct vpMatchingLevel {
+  vpMatchingLevel() : I(), sum(), sqsum() {}
+
+  void init(const vpImage<unsigned char> &I_)
+  {
+    I = I_;
+    const unsigned int w = I.getWidth() + 1;
+    sum.assign(static_cast<size_t>(I.getHeight() + 1) * w, 0);
+    sqsum.assign(sum.size(), 0);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      const unsigned char *row = I[i];
+      int64_t row_sum = 0, row_sqsum = 0;
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        row_sum += row[j];
+        row_sqsum += row[j] * row[j];
+        sum[(i + 1) * w + j + 1] = sum[i * w + j + 1] + row_sum;
+        sqsum[(i + 1) * w + j + 1] = sqsum[i * w + j + 1] + row_sqsum;
+      }
+    }
+  }
+
+  // Sum over the window of size h x w whose top-left corner is (i, j)
+  static int64_t window(const std::vector<int64_t> &II, unsigned int stride, unsigned int i, unsigned int j,
+                        unsigned int h, unsigned int w)
+  {
+    return II[(i + h) * stride + j + w] + II[i * stride + j] - II[i * stride + j + w] - II[(i + h) * stride + j];
+  }
+
+  vpImage<unsigned char> I;
+  std::vector<int64_t> sum;
+  std::vector<int64_t> sqsum;
+};
+
+// Sum of the products of the template pixels with the image pixels under the
+// template located at (i0, j0)
+int64_t crossCorrelation(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl, unsigned int i0,
+                         unsigned int j0, bool simd)
+{
+  const unsigned int width = I_tpl.getWidth();
+  int64_t sum = 0;
+  for (unsigned int i = 0; i < I_tpl.getHeight(); i++) {
+    const unsigned char *ptr_I = I[i0 + i] + j0;
+    const unsigned char *ptr_tpl = I_tpl[i];
+    unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+    if (simd && width >= 16) {
+      // 16-bit products accumulated by pairs in 32-bit lanes: no overflow for rows up to 130000 pixels
+      const __m128i zero = _mm_setzero_si128();
+      __m128i acc = _mm_setzero_si128();
+      for (; j + 16 <= width; j += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I + j));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_tpl + j));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero)));
+        acc = _mm_add_epi32(acc, _mm_madd_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero)));
+      }
+      int lanes[4];
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(lanes), acc);
+      sum += static_cast<int64_t>(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+    }
+#else
+    (void)simd;
+#endif
+
+    for (; j < width; j++) {
+      sum += ptr_I[j] * ptr_tpl[j];
+    }
+  }
+  return sum;
+}
+
+// Template of one level of the pyramid, with its precomputed statistics
+struct vpMatchingTemplate {
+  vpImage<unsigned char> I;
+  int64_t size;
+  int64_t sum;
+  double variance; // size^2 times the variance of the template
+};
+
+// Zero-mean normalized cross-correlation of the template located at (i, j)
+double zncc(const vpMatchingLevel &level, const vpMatchingTemplate &tpl, unsigned int i, unsigned int j, bool simd)
+{
+  const unsigned int stride = level.I.getWidth() + 1;
+  const unsigned int h = tpl.I.getHeight(), w = tpl.I.getWidth();
+  const int64_t sum = vpMatchingLevel::window(level.sum, stride, i, j, h, w);
+  const int64_t sqsum = vpMatchingLevel::window(level.sqsum, stride, i, j, h, w);
+  const double variance = static_cast<double>(tpl.size * sqsum - sum * sum);
+  if (variance <= 0 || tpl.variance <= 0) {
+    return 0;
+  }
+  const int64_t cross = crossCorrelation(level.I, tpl.I, i, j, simd);
+  return static_cast<double>(tpl.size * cross - tpl.sum * sum) / sqrt(variance * tpl.variance);
+}
+
+// Score of the positions of a level that have not been evaluated
+const double score_unknown = -2.0;
+
+struct vpMatchingCandidate {
+  vpMatchingCandidate(unsigned int i_, unsigned int j_, double score_) : i(i_), j(j_), score(score_) {}
+
+  // Decreasing scores, positions in raster order for equal scores
+  bool operator<(const vpMatchingCandidate &c) const
+  {
+    if (score != c.score) {
+      return score > c.score;
+    }
+    return i != c.i ? i < c.i : j < c.j;
+  }
+
+  unsigned int i;
+  unsigned int j;
+  double score;
+};
+
+class vpMatchingExhaustiveBody : public vpParallelBody
+{
+public:
+  vpMatchingExhaustiveBody(const vpMatchingLevel &level, const vpMatchingTemplate &tpl, vpImage<double> &scores,
+                           bool simd)
+    : m_level(level), m_tpl(tpl), m_scores(scores), m_simd(simd)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int j = 0; j < m_scores.getWidth(); j++) {
+        m_scores[i][j] = zncc(m_level, m_tpl, i, j, m_simd);
+      }
+    }
+  }
+
+private:
+  const vpMatchingLevel &m_level;
+  const vpMatchingTemplate &m_tpl;
+  vpImage<double> &m_scores;
+  bool m_simd;
+};
+
+// Keep the nbCandidates best evaluated positions. The local maxima of the
+// scores come first, so that the candidates do not all gather around the
+// highest peak
+void selectCandidates(const vpImage<double> &scores, std::vector<vpMatchingCandidate> &evaluated,
+                      unsigned int nbCandidates, std::vector<vpMatchingCandidate> &candidates)
+{
+  std::vector<vpMatchingCandidate> others;
+  candidates.clear();
+  for (size_t k = 0; k < evaluated.size(); k++) {
+    const vpMatchingCandidate &c = evaluated[k];
+    bool is_max = true;
+    for (int di = -1; di <= 1 && is_max; di++) {
+      for (int dj = -1; dj <= 1 && is_max; dj++) {
+        const int i = static_cast<int>(c.i) + di, j = static_cast<int>(c.j) + dj;
+        if (i >= 0 && j >= 0 && i < static_cast<int>(scores.getHeight()) && j < static_cast<int>(scores.getWidth()) &&
+            scores[i][j] > c.score) {
+          is_max = false;
+        }
+      }
+    }
+    (is_max ? candidates : others).push_back(c);
+  }
+
+  std::sort(candidates.begin(), candidates.end());
+  if (candidates.size() < nbCandidates) {
+    const size_t nb_others = std::min(others.size(), static_cast<size_t>(nbCandidates) - candidates.size());
+    std::partial_sort(others.begin(), others.begin() + nb_others, others.end());
+    candidates.insert(candidates.end(), others.begin(), others.begin() + nb_others);
+  } else {
+    candidates.erase(candidates.begin() + nbCandidates, candidates.end());
+  }
+}
+
+// Sub-pixel offset of the maximum of the parabola going through 3 scores
+double parabolaPeak(double s_prev, double s, double s_next)
+{
+  const double denom = s_prev - 2 * s + s_next;
+  if (denom >= 0) {
+    return 0;
+  }
+  return std::max(-0.5, std::min(0.5, 0.5 * (s_prev - s_next) / denom));
+}
+
+// Whether the SIMD resize kernels can be used
+bool useResizeSIMD()
+{
+#if VISP_HAVE_SSE2
+  return vpCPUFeatures::checkSSE2();
+#elif VISP_HAVE_NEON
+  return vpCPUFeatures::checkNEON();
+#else
+  return false;
+#endif
+}
+
+// Vertical pass of the separable resampling: combination of nbTaps rows of n
+// bytes into a row of floats
+void resizeVerticalPass(const unsigned char *const *rows, const float *weights, unsigned int nbTaps, unsigned int n,
+                        float *dst, bool simd)
+{
+  unsigned int x = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 16 <= n; x += 16) {
+      __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps(), acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+      for (unsigned int k = 0; k < nbTaps; k++) {
+        const __m128 w = _mm_set1_ps(weights[k]);
+        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + x));
+        const __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), w));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), w));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), w));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), w));
+      }
+      _mm_storeu_ps(dst + x, acc0);
+      _mm_storeu_ps(dst + x + 4, acc1);
+      _mm_storeu_ps(dst + x + 8, acc2);
+      _mm_storeu_ps(dst + x + 12, acc3);
+    }
+#elif VISP_HAVE_NEON
+    for (; x + 16 <= n; x += 16) {
+      float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0), acc2 = vdupq_n_f32(0), acc3 = vdupq_n_f32(0);
+      for (unsigned int k = 0; k < nbTaps; k++) {
+        const float32x4_t w = vdupq_n_f32(weights[k]);
+        const uint8x16_t v = vld1q_u8(rows[k] + x);
+        const uint16x8_t lo = vmovl_u8(vget_low_u8(v)), hi = vmovl_u8(vget_high_u8(v));
+        acc0 = vaddq_f32(acc0, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(lo))), w));
+        acc1 = vaddq_f32(acc1, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(lo))), w));
+        acc2 = vaddq_f32(acc2, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_low_u16(hi))), w));
+        acc3 = vaddq_f32(acc3, vmulq_f32(vcvtq_f32_u32(vmovl_u16(vget_high_u16(hi))), w));
+      }
+      vst1q_f32(dst + x, acc0);
+      vst1q_f32(dst + x + 4, acc1);
+      vst1q_f32(dst + x + 8, acc2);
+      vst1q_f32(dst + x + 12, acc3);
+    }
+#endif
+  }
+
+  for (; x < n; x++) {
+    float value = 0.0f;
+    for (unsigned int k = 0; k < nbTaps; k++) {
+      value += weights[k] * rows[k][x];
+    }
+    dst[x] = value;
+  }
+}
+
+// Rounding to the nearest integer and saturation, as done by the SIMD paths
+inline unsigned char resizeSaturate(float value)
+{
+  value += 0.5f;
+  return value <= 0.0f ? 0 : (value >= 255.0f ? 255 : static_cast<unsigned char>(value));
+}
+
+// Horizontal pass of the separable resampling of a grey row
+void resizeHorizontalPass(const float *src, const unsigned int *first, const float *weights, unsigned int nbTaps,
+                          unsigned int width, unsigned char *dst)
+{
+  for (unsigned int j = 0; j < width; j++) {
+    const float *s = src + first[j];
+    const float *w = weights + j * nbTaps;
+    float value = 0.0f;
+    for (unsigned int k = 0; k < nbTaps; k++) {
+      value += w[k] * s[k];
+    }
+    dst[j] = resizeSaturate(value);
+  }
+}
+
+// Horizontal pass of the separable resampling of a RGBa row, the 4 channels
+// of a pixel being processed together
+void resizeHorizontalPassRGBa(const float *src, const unsigned int *first, const float *weights, unsigned int nbTaps,
+                              unsigned int width, unsigned char *dst, bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128 half = _mm_set1_ps(0.5f);
+    for (; j < width; j++) {
+      const float *s = src + 4 * first[j];
+      const float *w = weights + j * nbTaps;
+      __m128 acc = _mm_setzero_ps();
+      for (unsigned int k = 0; k < nbTaps; k++) {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(s + 4 * k), _mm_set1_ps(w[k])));
+      }
+      const __m128i v = _mm_cvttps_epi32(_mm_add_ps(acc, half));
+      const __m128i v16 = _mm_packs_epi32(v, v);
+      const int rgba = _mm_cvtsi128_si32(_mm_packus_epi16(v16, v16));
+      memcpy(dst + 4 * j, &rgba, 4);
+    }
+#elif VISP_HAVE_NEON
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    for (; j < width; j++) {
+      const float *s = src + 4 * first[j];
+      const float *w = weights + j * nbTaps;
+      float32x4_t acc = vdupq_n_f32(0);
+      for (unsigned int k = 0; k < nbTaps; k++) {
+        acc = vaddq_f32(acc, vmulq_f32(vld1q_f32(s + 4 * k), vdupq_n_f32(w[k])));
+      }
+      const uint16x4_t v16 = vqmovn_u32(vcvtq_u32_f32(vaddq_f32(acc, half)));
+      const uint8x8_t v8 = vqmovn_u16(vcombine_u16(v16, v16));
+      vst1_lane_u32(reinterpret_cast<uint32_t *>(dst + 4 * j), vreinterpret_u32_u8(v8), 0);
+    }
+#endif
+  }
+
+  for (; j < width; j++) {
+    const float *s = src + 4 * first[j];
+    const float *w = weights + j * nbTaps;
+    for (unsigned int c = 0; c < 4; c++) {
+      float value = 0.0f;
+      for (unsigned int k = 0; k < nbTaps; k++) {
+        value += w[k] * s[4 * k + c];
+      }
+      dst[4 * j + c] = resizeSaturate(value);
+    }
+  }
+}
+
+// Separable resampling of the unsigned char and vpRGBa images: the input rows
+// are combined in a row of floats, whose columns are then combined
+template <class Type> class vpResizeSeparableBody : public vpParallelBody
+{
+public:
+  vpResizeSeparableBody(const vpImage<Type> &I, vpImage<Type> &Ires, const std::vector<unsigned int> &firstX,
+                        const std::vector<float> &weightsX, unsigned int nbTapsX,
+                        const std::vector<unsigned int> &firstY, const std::vector<float> &weightsY,
+                        unsigned int nbTapsY, bool simd)
+    : m_I(I), m_Ires(Ires), m_firstX(firstX), m_weightsX(weightsX), m_nbTapsX(nbTapsX), m_firstY(firstY),
+      m_weightsY(weightsY), m_nbTapsY(nbTapsY), m_simd(simd)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int nb_channels = sizeof(Type);
+    std::vector<float> buffer(m_I.getWidth() * nb_channels);
+    std::vector<const unsigned char *> rows(m_nbTapsY);
+
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int k = 0; k < m_nbTapsY; k++) {
+        rows[k] = reinterpret_cast<const unsigned char *>(m_I[m_firstY[i] + k]);
+      }
+      resizeVerticalPass(&rows[0], &m_weightsY[i * m_nbTapsY], m_nbTapsY, m_I.getWidth() * nb_channels, &buffer[0],
+                         m_simd);
+
+      unsigned char *dst = reinterpret_cast<unsigned char *>(m_Ires[i]);
+      if (nb_channels == 4) {
+        resizeHorizontalPassRGBa(&buffer[0], &m_firstX[0], &m_weightsX[0], m_nbTapsX, m_Ires.getWidth(), dst, m_simd);
+      } else {
+        resizeHorizontalPass(&buffer[0], &m_firstX[0], &m_weightsX[0], m_nbTapsX, m_Ires.getWidth(), dst);
+      }
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<Type> &m_Ires;
+  const std::vector<unsigned int> &m_firstX;
+  const std::vector<float> &m_weightsX;
+  unsigned int m_nbTapsX;
+  const std::vector<unsigned int> &m_firstY;
+  const std::vector<float> &m_weightsY;
+  unsigned int m_nbTapsY;
+  bool m_simd;
+};
+
+// Mean of the factor x factor blocks of a grey row (factor 2 or 4), rounded to
+// the nearest integer
+void decimateRow(const unsigned char *const *rows, unsigned int factor, unsigned int width, unsigned char *dst,
+                 bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i mask = _mm_set1_epi16(0x00FF);
+    if (factor == 2) {
+      for (; j + 16 <= width; j += 16) {
+        __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128();
+        for (unsigned int k = 0; k < 2; k++) {
+          const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + 2 * j));
+          const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + 2 * j + 16));
+          s0 = _mm_add_epi16(s0, _mm_add_epi16(_mm_and_si128(a, mask), _mm_srli_epi16(a, 8)));
+          s1 = _mm_add_epi16(s1, _mm_add_epi16(_mm_and_si128(b, mask), _mm_srli_epi16(b, 8)));
+        }
+        const __m128i round = _mm_set1_epi16(2);
+        s0 = _mm_srli_epi16(_mm_add_epi16(s0, round), 2);
+        s1 = _mm_srli_epi16(_mm_add_epi16(s1, round), 2);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(s0, s1));
+      }
+    } else {
+      const __m128i ones = _mm_set1_epi16(1);
+      for (; j + 8 <= width; j += 8) {
+        __m128i s0 = _mm_setzero_si128(), s1 = _mm_setzero_si128();
+        for (unsigned int k = 0; k < 4; k++) {
+          const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + 4 * j));
+          const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + 4 * j + 16));
+          s0 = _mm_add_epi16(s0, _mm_add_epi16(_mm_and_si128(a, mask), _mm_srli_epi16(a, 8)));
+          s1 = _mm_add_epi16(s1, _mm_add_epi16(_mm_and_si128(b, mask), _mm_srli_epi16(b, 8)));
+        }
+        const __m128i round = _mm_set1_epi32(8);
+        const __m128i q0 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(s0, ones), round), 4);
+        const __m128i q1 = _mm_srli_epi32(_mm_add_epi32(_mm_madd_epi16(s1, ones), round), 4);
+        const __m128i q = _mm_packs_epi32(q0, q1);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + j), _mm_packus_epi16(q, q));
+      }
+    }
+#elif VISP_HAVE_NEON
+    if (factor == 2) {
+      for (; j + 16 <= width; j += 16) {
+        uint16x8_t s0 = vpaddlq_u8(vld1q_u8(rows[0] + 2 * j));
+        uint16x8_t s1 = vpaddlq_u8(vld1q_u8(rows[0] + 2 * j + 16));
+        s0 = vpadalq_u8(s0, vld1q_u8(rows[1] + 2 * j));
+        s1 = vpadalq_u8(s1, vld1q_u8(rows[1] + 2 * j + 16));
+        vst1q_u8(dst + j, vcombine_u8(vrshrn_n_u16(s0, 2), vrshrn_n_u16(s1, 2)));
+      }
+    } else {
+      for (; j + 8 <= width; j += 8) {
+        uint16x8_t s0 = vpaddlq_u8(vld1q_u8(rows[0] + 4 * j));
+        uint16x8_t s1 = vpaddlq_u8(vld1q_u8(rows[0] + 4 * j + 16));
+        for (unsigned int k = 1; k < 4; k++) {
+          s0 = vpadalq_u8(s0, vld1q_u8(rows[k] + 4 * j));
+          s1 = vpadalq_u8(s1, vld1q_u8(rows[k] + 4 * j + 16));
+        }
+        const uint16x8_t q = vcombine_u16(vrshrn_n_u32(vpaddlq_u16(s0), 4), vrshrn_n_u32(vpaddlq_u16(s1), 4));
+        vst1_u8(dst + j, vmovn_u16(q));
+      }
+    }
+#endif
+  }
+
+  const unsigned int area = factor * factor;
+  for (; j < width; j++) {
+    unsigned int sum = area / 2;
+    for (unsigned int k = 0; k < factor; k++) {
+      for (unsigned int l = 0; l < factor; l++) {
+        sum += rows[k][factor * j + l];
+      }
+    }
+    dst[j] = static_cast<unsigned char>(sum / area);
+  }
+}
+
+// Mean of the factor x factor blocks of a RGBa row (factor 2 or 4), channel by
+// channel
+void decimateRowRGBa(const unsigned char *const *rows, unsigned int factor, unsigned int width, unsigned char *dst,
+                     bool simd)
+{
+  unsigned int j = 0;
+  if (simd) {
+#if VISP_HAVE_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    if (factor == 2) {
+      // Two output pixels from four input pixels per row
+      for (; j + 2 <= width; j += 2) {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        for (unsigned int k = 0; k < 2; k++) {
+          const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + 8 * j));
+          lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+          hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+        }
+        __m128i s = _mm_add_epi16(_mm_unpacklo_epi64(lo, hi), _mm_unpackhi_epi64(lo, hi));
+        s = _mm_srli_epi16(_mm_add_epi16(s, _mm_set1_epi16(2)), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + 4 * j), _mm_packus_epi16(s, s));
+      }
+    } else {
+      for (; j < width; j++) {
+        __m128i lo = _mm_setzero_si128(), hi = _mm_setzero_si128();
+        for (unsigned int k = 0; k < 4; k++) {
+          const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(rows[k] + 16 * j));
+          lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(v, zero));
+          hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(v, zero));
+        }
+        __m128i s = _mm_add_epi16(lo, hi);
+        s = _mm_add_epi16(s, _mm_srli_si128(s, 8));
+        s = _mm_srli_epi16(_mm_add_epi16(s, _mm_set1_epi16(8)), 4);
+        const int rgba = _mm_cvtsi128_si32(_mm_packus_epi16(s, s));
+        memcpy(dst + 4 * j, &rgba, 4);
+      }
+    }
+#elif VISP_HAVE_NEON
+    if (factor == 2) {
+      for (; j + 2 <= width; j += 2) {
+        const uint8x16_t a = vld1q_u8(rows[0] + 8 * j), b = vld1q_u8(rows[1] + 8 * j);
+        const uint16x8_t lo = vaddl_u8(vget_low_u8(a), vget_low_u8(b));
+        const uint16x8_t hi = vaddl_u8(vget_high_u8(a), vget_high_u8(b));
+        const uint16x8_t s = vcombine_u16(vadd_u16(vget_low_u16(lo), vget_high_u16(lo)),
+                                          vadd_u16(vget_low_u16(hi), vget_high_u16(hi)));
+        vst1_u8(dst + 4 * j, vrshrn_n_u16(s, 2));
+      }
+    } else {
+      for (; j < width; j++) {
+        uint16x8_t lo = vdupq_n_u16(0), hi = vdupq_n_u16(0);
+        for (unsigned int k = 0; k < 4; k++) {
+          const uint8x16_t v = vld1q_u8(rows[k] + 16 * j);
+          lo = vaddw_u8(lo, vget_low_u8(v));
+          hi = vaddw_u8(hi, vget_high_u8(v));
+        }
+        const uint16x8_t s = vaddq_u16(lo, hi);
+        const uint16x4_t s4 = vadd_u16(vget_low_u16(s), vget_high_u16(s));
+        const uint8x8_t v8 = vrshrn_n_u16(vcombine_u16(s4, s4), 4);
+        vst1_lane_u32(reinterpret_cast<uint32_t *>(dst + 4 * j), vreinterpret_u32_u8(v8), 0);
+      }
+    }
+#endif
+  }
+
+  const unsigned int area = factor * factor;
+  for (; j < width; j++) {
+    for (unsigned int c = 0; c < 4; c++) {
+      unsigned int sum = area / 2;
+      for (unsigned int k = 0; k < factor; k++) {
+        for (unsigned int l = 0; l < factor; l++) {
+          sum += rows[k][4 * (factor * j + l) + c];
+        }
+      }
+      dst[4 * j + c] = static_cast<unsigned char>(sum / area);
+    }
+  }
+}
+
+// Area resampling by a factor of 2 or 4 in both directions
+template <class Type> class vpResizeDecimateBody : public vpParallelBody
+{
+public:
+  vpResizeDecimateBody(const vpImage<Type> &I, vpImage<Type> &Ires, unsigned int factor, bool simd)
+    : m_I(I), m_Ires(Ires), m_factor(factor), m_simd(simd)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned char *rows[4];
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int k = 0; k < m_factor; k++) {
+        rows[k] = reinterpret_cast<const unsigned char *>(m_I[m_factor * i + k]);
+      }
+      unsigned char *dst = reinterpret_cast<unsigned char *>(m_Ires[i]);
+      if (sizeof(Type) == 4) {
+        decimateRowRGBa(rows, m_factor, m_Ires.getWidth(), dst, m_simd);
+      } else {
+        decimateRow(rows, m_factor, m_Ires.getWidth(), dst, m_simd);
+      }
+    }
+  }
+
+private:
+  const vpImage<Type> &m_I;
+  vpImage<Type> &m_Ires;
+  unsigned int m_factor;
+  bool m_simd;
+};
+
+// Factor of an exact decimation by 2 or 4 in both directions, 0 otherwise
+template <class Type> unsigned int decimationFactor(const vpImage<Type> &I, const vpImage<Type> &Ires)
+{
+  const unsigned int factors[2] = {2, 4};
+  for (int k = 0; k < 2; k++) {
+    if (I.getWidth() == factors[k] * Ires.getWidth() && I.getHeight() == factors[k] * Ires.getHeight()) {
+      return factors[k];
+    }
+  }
+  return 0;
+}
+
+template <class Type>
+void resizeSeparableImage(const vpImage<Type> &I, vpImage<Type> &Ires, const std::vector<unsigned int> &firstX,
+                          const std::vector<float> &weightsX, unsigned int nbTapsX,
+                          const std::vector<unsigned int> &firstY, const std::vector<float> &weightsY,
+                          unsigned int nbTapsY, unsigned int nThreads)
+{
+  vpParallel::parallelFor(0, Ires.getHeight(),
+                          vpResizeSeparableBody<Type>(I, Ires, firstX, weightsX, nbTapsX, firstY, weightsY, nbTapsY,
+                                                      useResizeSIMD()),
+                          nThreads);
+}
+} // namespace
+
 /*!
   Change the look up table (LUT) of an image. Considering pixel gray
   level values \f$ l \f$ in the range \f$[A, B]\f$, this method allows
@@ -162,46 +1137,7 @@ void vpImageTools::imageDifference(const vpImage<unsigned char> &I1, const vpIma
   checkSSSE3 = false;
 #endif
 
-  unsigned int i = 0;
-  if (checkSSSE3) {
-#if VISP_HAVE_SSSE3
-    if (I1.getSize() >= 16) {
-      const __m128i mask1 = _mm_set_epi8(-1, 14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0);
-      const __m128i mask2 = _mm_set_epi8(-1, 15, -1, 13, -1, 11, -1, 9, -1, 7, -1, 5, -1, 3, -1, 1);
-
-      const __m128i mask_out2 = _mm_set_epi8(14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0, -1);
-
-      for (; i <= I1.getSize()-16; i+= 16) {
-        const __m128i vdata1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(I1.bitmap + i));
-        const __m128i vdata2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(I2.bitmap + i));
-
-        __m128i vdata1_reorg = _mm_shuffle_epi8(vdata1, mask1);
-        __m128i vdata2_reorg = _mm_shuffle_epi8(vdata2, mask1);
-
-        const __m128i vshift = _mm_set1_epi16(128);
-        __m128i vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
-
-        const __m128i v255 = _mm_set1_epi16(255);
-        const __m128i vzero = _mm_setzero_si128();
-        const __m128i vdata_diff_min_max1 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
-
-        vdata1_reorg = _mm_shuffle_epi8(vdata1, mask2);
-        vdata2_reorg = _mm_shuffle_epi8(vdata2, mask2);
-
-        vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
-        const __m128i vdata_diff_min_max2 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
-
-        _mm_storeu_si128(reinterpret_cast<__m128i *>(Idiff.bitmap + i), _mm_or_si128(_mm_shuffle_epi8(vdata_diff_min_max1, mask1),
-                                                                                     _mm_shuffle_epi8(vdata_diff_min_max2, mask_out2)));
-      }
-    }
-#endif
-  }
-
-  for (; i < I1.getSize(); i++) {
-    int diff = I1.bitmap[i] - I2.bitmap[i] + 128;
-    Idiff.bitmap[i] = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diff, 255), 0));
-  }
+  vpParallel::parallelFor(0, I1.getHeight(), vpImageDifferenceBody(I1, I2, Idiff, checkSSSE3));
 }
 
 /*!
@@ -233,52 +1169,7 @@ void vpImageTools::imageDifference(const vpImage<vpRGBa> &I1, const vpImage<vpRG
   checkSSSE3 = false;
 #endif
 
-  unsigned int i = 0;
-  if (checkSSSE3) {
-#if VISP_HAVE_SSSE3
-    if (I1.getSize() >= 4) {
-      const __m128i mask1 = _mm_set_epi8(-1, 14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0);
-      const __m128i mask2 = _mm_set_epi8(-1, 15, -1, 13, -1, 11, -1, 9, -1, 7, -1, 5, -1, 3, -1, 1);
-
-      const __m128i mask_out2 = _mm_set_epi8(14, -1, 12, -1, 10, -1, 8, -1, 6, -1, 4, -1, 2, -1, 0, -1);
-
-      for (; i <= I1.getSize()-4; i+= 4) {
-        const __m128i vdata1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(I1.bitmap + i));
-        const __m128i vdata2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(I2.bitmap + i));
-
-        __m128i vdata1_reorg = _mm_shuffle_epi8(vdata1, mask1);
-        __m128i vdata2_reorg = _mm_shuffle_epi8(vdata2, mask1);
-
-        const __m128i vshift = _mm_set1_epi16(128);
-        __m128i vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
-
-        const __m128i v255 = _mm_set1_epi16(255);
-        const __m128i vzero = _mm_setzero_si128();
-        const __m128i vdata_diff_min_max1 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
-
-        vdata1_reorg = _mm_shuffle_epi8(vdata1, mask2);
-        vdata2_reorg = _mm_shuffle_epi8(vdata2, mask2);
-
-        vdata_diff = _mm_add_epi16(_mm_sub_epi16(vdata1_reorg, vdata2_reorg), vshift);
-        const __m128i vdata_diff_min_max2 = _mm_max_epi16(_mm_min_epi16(vdata_diff, v255), vzero);
-
-        _mm_storeu_si128(reinterpret_cast<__m128i *>(Idiff.bitmap + i), _mm_or_si128(_mm_shuffle_epi8(vdata_diff_min_max1, mask1),
-                                                                                     _mm_shuffle_epi8(vdata_diff_min_max2, mask_out2)));
-      }
-    }
-#endif
-  }
-
-  for (; i < I1.getSize(); i++) {
-    int diffR = I1.bitmap[i].R - I2.bitmap[i].R + 128;
-    int diffG = I1.bitmap[i].G - I2.bitmap[i].G + 128;
-    int diffB = I1.bitmap[i].B - I2.bitmap[i].B + 128;
-    int diffA = I1.bitmap[i].A - I2.bitmap[i].A + 128;
-    Idiff.bitmap[i].R = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffR, 255), 0));
-    Idiff.bitmap[i].G = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffG, 255), 0));
-    Idiff.bitmap[i].B = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffB, 255), 0));
-    Idiff.bitmap[i].A = static_cast<unsigned char>(vpMath::maximum(vpMath::minimum(diffA, 255), 0));
-  }
+  vpParallel::parallelFor(0, I1.getHeight(), vpImageDifferenceRGBaBody(I1, I2, Idiff, checkSSSE3));
 }
 
 /*!
@@ -301,10 +1192,13 @@ void vpImageTools::imageDifferenceAbsolute(const vpImage<unsigned char> &I1, con
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth();
-  for (unsigned int b = 0; b < n; b++) {
-    int diff = I1.bitmap[b] - I2.bitmap[b];
-    Idiff.bitmap[b] = static_cast<unsigned char>(vpMath::abs(diff));
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    const unsigned char *src1 = I1[i], *src2 = I2[i];
+    unsigned char *dst = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++) {
+      int diff = src1[j] - src2[j];
+      dst[j] = static_cast<unsigned char>(vpMath::abs(diff));
+    }
   }
 }
 
@@ -324,9 +1218,12 @@ void vpImageTools::imageDifferenceAbsolute(const vpImage<double> &I1, const vpIm
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth();
-  for (unsigned int b = 0; b < n; b++) {
-    Idiff.bitmap[b] = vpMath::abs(I1.bitmap[b] - I2.bitmap[b]);
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    const double *src1 = I1[i], *src2 = I2[i];
+    double *dst = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++) {
+      dst[j] = vpMath::abs(src1[j] - src2[j]);
+    }
   }
 }
 
@@ -352,17 +1249,20 @@ void vpImageTools::imageDifferenceAbsolute(const vpImage<vpRGBa> &I1, const vpIm
   if ((I1.getHeight() != Idiff.getHeight()) || (I1.getWidth() != Idiff.getWidth()))
     Idiff.resize(I1.getHeight(), I1.getWidth());
 
-  unsigned int n = I1.getHeight() * I1.getWidth();
-  for (unsigned int b = 0; b < n; b++) {
-    int diffR = I1.bitmap[b].R - I2.bitmap[b].R;
-    int diffG = I1.bitmap[b].G - I2.bitmap[b].G;
-    int diffB = I1.bitmap[b].B - I2.bitmap[b].B;
-    // int diffA = I1.bitmap[b].A - I2.bitmap[b].A;
-    Idiff.bitmap[b].R = static_cast<unsigned char>(vpMath::abs(diffR));
-    Idiff.bitmap[b].G = static_cast<unsigned char>(vpMath::abs(diffG));
-    Idiff.bitmap[b].B = static_cast<unsigned char>(vpMath::abs(diffB));
-    // Idiff.bitmap[b].A = diffA;
-    Idiff.bitmap[b].A = 0;
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    const vpRGBa *src1 = I1[i], *src2 = I2[i];
+    vpRGBa *dst = Idiff[i];
+    for (unsigned int j = 0; j < I1.getWidth(); j++) {
+      int diffR = src1[j].R - src2[j].R;
+      int diffG = src1[j].G - src2[j].G;
+      int diffB = src1[j].B - src2[j].B;
+      // int diffA = src1[j].A - src2[j].A;
+      dst[j].R = static_cast<unsigned char>(vpMath::abs(diffR));
+      dst[j].G = static_cast<unsigned char>(vpMath::abs(diffG));
+      dst[j].B = static_cast<unsigned char>(vpMath::abs(diffB));
+      // dst[j].A = diffA;
+      dst[j].A = 0;
+    }
   }
 }
 
@@ -386,25 +1286,31 @@ void vpImageTools::imageAdd(const vpImage<unsigned char> &I1, const vpImage<unsi
     Ires.resize(I1.getHeight(), I1.getWidth());
   }
 
-  unsigned char *ptr_I1 = I1.bitmap;
-  unsigned char *ptr_I2 = I2.bitmap;
-  unsigned char *ptr_Ires = Ires.bitmap;
-  unsigned int cpt = 0;
+  const unsigned int width = Ires.getWidth();
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+  for (unsigned int i = 0; i < Ires.getHeight(); i++) {
+    const unsigned char *ptr_I1 = I1[i];
+    const unsigned char *ptr_I2 = I2[i];
+    unsigned char *ptr_Ires = Ires[i];
+    unsigned int cpt = 0;
 
 #if VISP_HAVE_SSE2
-  if (vpCPUFeatures::checkSSE2() && Ires.getSize() >= 16) {
-    for (; cpt <= Ires.getSize() - 16; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
-      const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I1));
-      const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I2));
-      const __m128i vres = saturate ? _mm_adds_epu8(v1, v2) : _mm_add_epi8(v1, v2);
+    if (useSSE2 && width >= 16) {
+      for (; cpt <= width - 16; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I1));
+        const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I2));
+        const __m128i vres = saturate ? _mm_adds_epu8(v1, v2) : _mm_add_epi8(v1, v2);
 
-      _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr_Ires), vres);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr_Ires), vres);
+      }
     }
-  }
 #endif
 
-  for (; cpt < Ires.getSize(); cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
-    *ptr_Ires = saturate ? vpMath::saturate<unsigned char>((short int)*ptr_I1 + (short int)*ptr_I2) : *ptr_I1 + *ptr_I2;
+    for (; cpt < width; cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
+      *ptr_Ires = saturate ? vpMath::saturate<unsigned char>((short int)*ptr_I1 + (short int)*ptr_I2) : *ptr_I1 + *ptr_I2;
+    }
   }
 }
 
@@ -428,27 +1334,33 @@ void vpImageTools::imageSubtract(const vpImage<unsigned char> &I1, const vpImage
     Ires.resize(I1.getHeight(), I1.getWidth());
   }
 
-  unsigned char *ptr_I1 = I1.bitmap;
-  unsigned char *ptr_I2 = I2.bitmap;
-  unsigned char *ptr_Ires = Ires.bitmap;
-  unsigned int cpt = 0;
+  const unsigned int width = Ires.getWidth();
+#if VISP_HAVE_SSE2
+  const bool useSSE2 = vpCPUFeatures::checkSSE2();
+#endif
+  for (unsigned int i = 0; i < Ires.getHeight(); i++) {
+    const unsigned char *ptr_I1 = I1[i];
+    const unsigned char *ptr_I2 = I2[i];
+    unsigned char *ptr_Ires = Ires[i];
+    unsigned int cpt = 0;
 
 #if VISP_HAVE_SSE2
-  if (vpCPUFeatures::checkSSE2() && Ires.getSize() >= 16) {
-    for (; cpt <= Ires.getSize() - 16; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
-      const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I1));
-      const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I2));
-      const __m128i vres = saturate ? _mm_subs_epu8(v1, v2) : _mm_sub_epi8(v1, v2);
+    if (useSSE2 && width >= 16) {
+      for (; cpt <= width - 16; cpt += 16, ptr_I1 += 16, ptr_I2 += 16, ptr_Ires += 16) {
+        const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I1));
+        const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr_I2));
+        const __m128i vres = saturate ? _mm_subs_epu8(v1, v2) : _mm_sub_epi8(v1, v2);
 
-      _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr_Ires), vres);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(ptr_Ires), vres);
+      }
     }
-  }
 #endif
 
-  for (; cpt < Ires.getSize(); cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
-    *ptr_Ires = saturate ?
-          vpMath::saturate<unsigned char>(static_cast<short int>(*ptr_I1) - static_cast<short int>(*ptr_I2)) :
-          *ptr_I1 - *ptr_I2;
+    for (; cpt < width; cpt++, ++ptr_I1, ++ptr_I2, ++ptr_Ires) {
+      *ptr_Ires = saturate ?
+            vpMath::saturate<unsigned char>(static_cast<short int>(*ptr_I1) - static_cast<short int>(*ptr_I2)) :
+            *ptr_I1 - *ptr_I2;
+    }
   }
 }
 
@@ -462,6 +1374,8 @@ void vpImageTools::imageSubtract(const vpImage<unsigned char> &I1, const vpImage
   \param mapV : 2D array that contains at each coordinate the v-coordinate in the distorted image.
   \param mapDu : 2D array that contains at each coordinate the \f$ \Delta u \f$ for the interpolation.
   \param mapDv : 2D array that contains at each coordinate the \f$ \Delta v \f$ for the interpolation.
+
+  \sa vpUndistortMap for a compact fixed-point map that can also be saved to disk.
 */
 void vpImageTools::initUndistortMap(const vpCameraParameters &cam, unsigned int width, unsigned int height,
                                     vpArray2D<int> &mapU, vpArray2D<int> &mapV,
@@ -543,12 +1457,144 @@ void vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<double
   II.resize(I.getHeight() + 1, I.getWidth() + 1, 0.0);
   IIsq.resize(I.getHeight() + 1, I.getWidth() + 1, 0.0);
 
-  for (unsigned int i = 1; i < II.getHeight(); i++) {
-    for (unsigned int j = 1; j < II.getWidth(); j++) {
-      II[i][j] = I[i - 1][j - 1] + II[i - 1][j] + II[i][j - 1] - II[i - 1][j - 1];
-      IIsq[i][j] = vpMath::sqr(I[i - 1][j - 1]) + IIsq[i - 1][j] + IIsq[i][j - 1] - IIsq[i - 1][j - 1];
+  // Row prefix sums followed by column prefix sums. All the partial sums are
+  // integers exactly represented by a double, thus the result does not depend
+  // on the summation order.
+  vpParallel::parallelFor(1, II.getHeight(), vpIntegralImageRowBody(I, II, IIsq));
+  vpParallel::parallelFor(1, II.getWidth(), vpIntegralImageColumnBody(II, IIsq));
+}
+
+/*!
+  Compute the integral image with 32 bits unsigned integers, of size
+  (height + 1) x (width + 1) like integralImage(const vpImage<unsigned char>
+  &, vpImage<double> &, vpImage<double> &), with half the memory and exact
+  integer arithmetic:
+
+  \f$ II(u,v)=\sum_{u^{'}\leq u, v^{'}\leq v}I(u,v) \f$
+
+  The row sums are computed four rows at a time, and the column sums with
+  SSE2 when available, in parallel with vpParallel.
+
+  \param I : Input image, with at most \f$ (2^{32}-1) / 255 \f$ pixels so that
+  the sum of all the pixels fits in 32 bits. Otherwise a vpException is
+  thrown.
+  \param II : Integral image II.
+*/
+void vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<uint32_t> &II)
+{
+  computeIntegralImage(I, II, NULL);
+}
+
+/*!
+  Compute the integral images of the pixel values and of the squared pixel
+  values with unsigned integers.
+
+  \param I : Input image, with at most \f$ (2^{32}-1) / 255 \f$ pixels.
+  \param II : Integral image II.
+  \param IIsq : Integral image IIsq, on 64 bits.
+
+  \sa integralImage(const vpImage<unsigned char> &, vpImage<uint32_t> &)
+*/
+void vpImageTools::integralImage(const vpImage<unsigned char> &I, vpImage<uint32_t> &II, vpImage<uint64_t> &IIsq)
+{
+  computeIntegralImage(I, II, &IIsq);
+}
+
+/*!
+  Compute the tilted (rotated by 45 degrees) integral image of Lienhart and
+  Maydt, of size (height + 1) x (width + 1):
+
+  \f$ IIt(v,u)=\sum_{v^{'} < v, |u^{'} - u + 1| \leq v - v^{'} - 1}I(v^{'},u^{'}) \f$
+
+  that is the sum of the pixels in the triangle whose apex is the pixel
+  \f$(v-1,u-1)\f$ and that widens towards the top of the image. It gives the
+  sum of the pixels in any rectangle rotated by 45 degrees with 4 lookups.
+  The rows are computed one after the other since each row depends on the two
+  previous ones.
+
+  \param I : Input image, with at most \f$ (2^{32}-1) / 255 \f$ pixels.
+  \param IIt : Tilted integral image.
+*/
+void vpImageTools::integralImageTilted(const vpImage<unsigned char> &I, vpImage<uint32_t> &IIt)
+{
+  if (I.getSize() > std::numeric_limits<uint32_t>::max() / 255) {
+    throw vpException(vpException::dimensionError, "Image %ux%u too large for a 32 bits integral image",
+                      I.getHeight(), I.getWidth());
+  }
+
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  IIt.resize(height + 1, width + 1, 0);
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  // The triangles whose apex is outside of the image are equal to triangles
+  // whose apex is on the first or last column of a previous row
+  std::vector<uint32_t> zeros(width + 1, 0);
+  std::vector<unsigned char> zeros_uc(width, 0);
+  for (unsigned int v = 1; v <= height; v++) {
+    const uint32_t *prev = IIt[v - 1];
+    const uint32_t *prev2 = v >= 2 ? IIt[v - 2] : &zeros[0];
+    const unsigned char *src = I[v - 1];
+    const unsigned char *src_prev = v >= 2 ? I[v - 2] : &zeros_uc[0];
+    uint32_t *iit = IIt[v];
+
+    for (unsigned int u = 1; u < width; u++) {
+      iit[u] = prev[u - 1] + prev[u + 1] - prev2[u] + src[u - 1] + src_prev[u - 1];
     }
+    // The triangle with the apex on the right of the last column of the
+    // previous row is the one of the row before
+    iit[width] = prev[width - 1] + src[width - 1] + src_prev[width - 1];
+    iit[0] = prev[1];
+  }
+}
+
+/*!
+  Apply a normalized box filter with the integral image, whose cost does not
+  depend on the size of the filter. Near the borders, the mean is computed
+  on the part of the window that is inside the image.
+
+  \param I : Input image.
+  \param I_mean : Mean of the pixels in the size x size window centered on
+  each pixel.
+  \param size : Size of the filter, must be odd.
+*/
+void vpImageTools::boxFilter(const vpImage<unsigned char> &I, vpImage<double> &I_mean, unsigned int size)
+{
+  if (size % 2 != 1) {
+    throw vpException(vpException::badValue, "Box filter size %u must be odd", size);
+  }
+
+  vpImage<uint32_t> II;
+  integralImage(I, II);
+  I_mean.resize(I.getHeight(), I.getWidth());
+  vpParallel::parallelFor(0, I.getHeight(), vpLocalMeanVarianceBody(II, NULL, size, I_mean, NULL));
+}
+
+/*!
+  Compute the local mean and variance of the pixels with the integral images,
+  whose cost does not depend on the size of the window. Near the borders, the
+  statistics are computed on the part of the window that is inside the image.
+
+  \param I : Input image.
+  \param I_mean : Mean of the pixels in the size x size window centered on
+  each pixel.
+  \param I_variance : Variance of the pixels in the same window.
+  \param size : Size of the window, must be odd.
+*/
+void vpImageTools::localMeanVariance(const vpImage<unsigned char> &I, vpImage<double> &I_mean,
+                                     vpImage<double> &I_variance, unsigned int size)
+{
+  if (size % 2 != 1) {
+    throw vpException(vpException::badValue, "Window size %u must be odd", size);
   }
+
+  vpImage<uint32_t> II;
+  vpImage<uint64_t> IIsq;
+  integralImage(I, II, IIsq);
+  I_mean.resize(I.getHeight(), I.getWidth());
+  I_variance.resize(I.getHeight(), I.getWidth());
+  vpParallel::parallelFor(0, I.getHeight(), vpLocalMeanVarianceBody(II, &IIsq, size, I_mean, &I_variance));
 }
 
 /*!
@@ -578,46 +1624,60 @@ double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpIm
   double a2 = 0.0;
   double b2 = 0.0;
 
-  unsigned int cpt = 0;
+  // The pixels are processed by rows, or all at once when both images are
+  // contiguous
+  const bool contiguous = I1.isContiguous() && I2.isContiguous();
+  const unsigned int nbRows = contiguous ? std::min(I1.getHeight(), 1u) : I1.getHeight();
+  const unsigned int length = contiguous ? I1.getSize() : I1.getWidth();
 
 #if VISP_HAVE_SSE2
-  if (vpCPUFeatures::checkSSE2() && I1.getSize() >= 2 && useOptimized) {
-    const double *ptr_I1 = I1.bitmap;
-    const double *ptr_I2 = I2.bitmap;
+  const bool useSSE2 = vpCPUFeatures::checkSSE2() && length >= 2 && useOptimized;
+  const __m128d v_mean_a = _mm_set1_pd(a);
+  const __m128d v_mean_b = _mm_set1_pd(b);
+  __m128d v_ab = _mm_setzero_pd();
+  __m128d v_a2 = _mm_setzero_pd();
+  __m128d v_b2 = _mm_setzero_pd();
+#endif
 
-    const __m128d v_mean_a = _mm_set1_pd(a);
-    const __m128d v_mean_b = _mm_set1_pd(b);
-    __m128d v_ab = _mm_setzero_pd();
-    __m128d v_a2 = _mm_setzero_pd();
-    __m128d v_b2 = _mm_setzero_pd();
+  for (unsigned int i = 0; i < nbRows; i++) {
+    const double *ptr_I1 = I1[i];
+    const double *ptr_I2 = I2[i];
+    unsigned int cpt = 0;
 
-    for (; cpt <= I1.getSize() - 2; cpt += 2, ptr_I1 += 2, ptr_I2 += 2) {
-      const __m128d v1 = _mm_loadu_pd(ptr_I1);
-      const __m128d v2 = _mm_loadu_pd(ptr_I2);
-      const __m128d norm_a = _mm_sub_pd(v1, v_mean_a);
-      const __m128d norm_b = _mm_sub_pd(v2, v_mean_b);
-      v_ab = _mm_add_pd(v_ab, _mm_mul_pd(norm_a, norm_b));
-      v_a2 = _mm_add_pd(v_a2, _mm_mul_pd(norm_a, norm_a));
-      v_b2 = _mm_add_pd(v_b2, _mm_mul_pd(norm_b, norm_b));
+#if VISP_HAVE_SSE2
+    if (useSSE2) {
+      for (; cpt <= length - 2; cpt += 2, ptr_I1 += 2, ptr_I2 += 2) {
+        const __m128d v1 = _mm_loadu_pd(ptr_I1);
+        const __m128d v2 = _mm_loadu_pd(ptr_I2);
+        const __m128d norm_a = _mm_sub_pd(v1, v_mean_a);
+        const __m128d norm_b = _mm_sub_pd(v2, v_mean_b);
+        v_ab = _mm_add_pd(v_ab, _mm_mul_pd(norm_a, norm_b));
+        v_a2 = _mm_add_pd(v_a2, _mm_mul_pd(norm_a, norm_a));
+        v_b2 = _mm_add_pd(v_b2, _mm_mul_pd(norm_b, norm_b));
+      }
     }
+#endif
+
+    for (; cpt < length; cpt++, ptr_I1++, ptr_I2++) {
+      ab += (*ptr_I1 - a) * (*ptr_I2 - b);
+      a2 += vpMath::sqr(*ptr_I1 - a);
+      b2 += vpMath::sqr(*ptr_I2 - b);
+    }
+  }
 
+#if VISP_HAVE_SSE2
+  if (useSSE2) {
     double v_res_ab[2], v_res_a2[2], v_res_b2[2];
     _mm_storeu_pd(v_res_ab, v_ab);
     _mm_storeu_pd(v_res_a2, v_a2);
     _mm_storeu_pd(v_res_b2, v_b2);
 
-    ab = v_res_ab[0] + v_res_ab[1];
-    a2 = v_res_a2[0] + v_res_a2[1];
-    b2 = v_res_b2[0] + v_res_b2[1];
+    ab += v_res_ab[0] + v_res_ab[1];
+    a2 += v_res_a2[0] + v_res_a2[1];
+    b2 += v_res_b2[0] + v_res_b2[1];
   }
 #endif
 
-  for (; cpt < I1.getSize(); cpt++) {
-    ab += (I1.bitmap[cpt] - a) * (I2.bitmap[cpt] - b);
-    a2 += vpMath::sqr(I1.bitmap[cpt] - a);
-    b2 += vpMath::sqr(I2.bitmap[cpt] - b);
-  }
-
   return ab / sqrt(a2 * b2);
 }
 
@@ -737,6 +1797,42 @@ void vpImageTools::extract(const vpImage<unsigned char> &Src, vpImage<double> &D
   }
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+// Each stripe index corresponds to the row index * step_v of the score image
+class vpImageTools::TemplateMatchingBody : public vpParallelBody
+{
+public:
+  TemplateMatchingBody(const vpImage<double> &I, const vpImage<double> &I_tpl, const vpImage<double> &II,
+                       const vpImage<double> &IIsq, const vpImage<double> &II_tpl, const vpImage<double> &IIsq_tpl,
+                       vpImage<double> &I_score, unsigned int step_u, unsigned int step_v)
+    : m_I(I), m_I_tpl(I_tpl), m_II(II), m_IIsq(IIsq), m_II_tpl(II_tpl), m_IIsq_tpl(IIsq_tpl), m_I_score(I_score),
+      m_step_u(step_u), m_step_v(step_v)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int idx = begin; idx < end; idx++) {
+      const unsigned int i = idx * m_step_v;
+      for (unsigned int j = 0; j < m_I.getWidth() - m_I_tpl.getWidth(); j += m_step_u) {
+        m_I_score[i][j] = normalizedCorrelation(m_I, m_I_tpl, m_II, m_IIsq, m_II_tpl, m_IIsq_tpl, i, j);
+      }
+    }
+  }
+
+private:
+  const vpImage<double> &m_I;
+  const vpImage<double> &m_I_tpl;
+  const vpImage<double> &m_II;
+  const vpImage<double> &m_IIsq;
+  const vpImage<double> &m_II_tpl;
+  const vpImage<double> &m_IIsq_tpl;
+  vpImage<double> &m_I_score;
+  unsigned int m_step_u;
+  unsigned int m_step_v;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Match a template image into another image using zero-mean normalized cross-correlation:
 
@@ -749,7 +1845,7 @@ void vpImageTools::extract(const vpImage<unsigned char> &Src, vpImage<double> &D
   \param I_score : Output template matching score.
   \param step_u : Step in u-direction to speed-up the computation.
   \param step_v : Step in v-direction to speed-up the computation.
-  \param useOptimized : Use optimized version (SSE, OpenMP, integral images, ...) if true and available.
+  \param useOptimized : Use optimized version (SSE, multi-threading, integral images, ...) if true and available.
 */
 void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
                                     vpImage<double> &I_score, unsigned int step_u, unsigned int step_v,
@@ -791,30 +1887,9 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
       I_tpl_double.bitmap[cpt] -= mean2;
     }
 
-#if defined _OPENMP && _OPENMP >= 200711 // OpenMP 3.1
-#pragma omp parallel for schedule(dynamic)
-    for (unsigned int i = 0; i < I.getHeight() - height_tpl; i += step_v) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[i][j] = normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, i, j);
-      }
-    }
-#else
-    // error C3016: 'i': index variable in OpenMP 'for' statement must have signed integral type
-    int end = (int)((I.getHeight() - height_tpl) / step_v) + 1;
-    std::vector<unsigned int> vec_step_v((size_t)end);
-    for (unsigned int cpt = 0, idx = 0; cpt < I.getHeight() - height_tpl; cpt += step_v, idx++) {
-      vec_step_v[(size_t)idx] = cpt;
-    }
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int cpt = 0; cpt < end; cpt++) {
-      for (unsigned int j = 0; j < I.getWidth() - width_tpl; j += step_u) {
-        I_score[vec_step_v[cpt]][j] =
-            normalizedCorrelation(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl, vec_step_v[cpt], j);
-      }
-    }
-#endif
+    const unsigned int nb_rows = (I.getHeight() - height_tpl + step_v - 1) / step_v;
+    vpParallel::parallelFor(0, nb_rows, TemplateMatchingBody(I_double, I_tpl_double, II, IIsq, II_tpl, IIsq_tpl,
+                                                             I_score, step_u, step_v));
   } else {
     vpImage<double> I_cur;
 
@@ -829,6 +1904,202 @@ void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpIma
   }
 }
 
+/*!
+  Coarse-to-fine template matching with the zero-mean normalized
+  cross-correlation (see templateMatching()).
+
+  \param I : Input image.
+  \param I_tpl : Template image.
+  \param ip : Location in \e I of the top-left corner of the best match.
+  \param nbLevels : Maximum number of levels of the Gaussian pyramid. The
+  number of levels is reduced so that the template is at least 8x8 at the
+  coarsest level. 1 corresponds to an exhaustive search.
+  \param nbCandidates : Number of candidates kept at each level.
+  \param subPixel : If true, the location is refined with a sub-pixel
+  accuracy by fitting a parabola on the scores around the best match.
+
+  \return The score of the best match.
+
+  \sa templateMatching(const vpImage<unsigned char> &, const std::vector<vpImage<unsigned char> > &,
+  std::vector<vpImagePoint> &, std::vector<double> &, unsigned int, unsigned int, bool)
+*/
+double vpImageTools::templateMatching(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl,
+                                      vpImagePoint &ip, unsigned int nbLevels, unsigned int nbCandidates,
+                                      bool subPixel)
+{
+  std::vector<vpImage<unsigned char> > I_tpls(1, I_tpl);
+  std::vector<vpImagePoint> ips;
+  std::vector<double> scores;
+  templateMatching(I, I_tpls, ips, scores, nbLevels, nbCandidates, subPixel);
+  ip = ips[0];
+  return scores[0];
+}
+
+/*!
+  Coarse-to-fine matching of several templates into an image with the
+  zero-mean normalized cross-correlation (see templateMatching()).
+
+  The pyramids of the image and of the templates are built with
+  vpImageFilter::getGaussPyramidal(). All the positions are scored at the
+  coarsest level, then only the neighborhoods of the \e nbCandidates best
+  positions (local maxima first) are scored at the finer levels. The image
+  pyramid and its integral images are shared by all the templates. The
+  computations are performed on the 8-bit images with integer sums, the
+  cross-correlation being accumulated with SSE2 when available.
+
+  The searched positions are the same than the ones of the exhaustive
+  templateMatching(): the best match is the same as soon as \e nbCandidates is
+  larger than the number of positions of the coarsest level.
+
+  \param I : Input image.
+  \param I_tpls : Template images.
+  \param ips : Location in \e I of the top-left corner of the best match of each template.
+  \param scores : Score of the best match of each template.
+  \param nbLevels : Maximum number of levels of the Gaussian pyramid. The
+  number of levels is reduced so that the templates are at least 8x8 at the
+  coarsest level. 1 corresponds to an exhaustive search.
+  \param nbCandidates : Number of candidates kept at each level.
+  \param subPixel : If true, the locations are refined with a sub-pixel
+  accuracy by fitting parabolas on the scores around the best matches.
+
+  \exception vpException::dimensionError : If the image is empty, a template
+  is empty or a template is not smaller than the image.
+  \exception vpException::badValue : If \e nbLevels or \e nbCandidates is 0.
+*/
+void vpImageTools::templateMatching(const vpImage<unsigned char> &I, const std::vector<vpImage<unsigned char> > &I_tpls,
+                                    std::vector<vpImagePoint> &ips, std::vector<double> &scores,
+                                    unsigned int nbLevels, unsigned int nbCandidates, bool subPixel)
+{
+  if (nbLevels == 0 || nbCandidates == 0) {
+    throw vpException(vpException::badValue, "Cannot match templates with %u levels and %u candidates", nbLevels,
+                      nbCandidates);
+  }
+  for (size_t t = 0; t < I_tpls.size(); t++) {
+    if (I_tpls[t].getSize() == 0 || I_tpls[t].getHeight() >= I.getHeight() ||
+        I_tpls[t].getWidth() >= I.getWidth()) {
+      throw vpException(vpException::dimensionError, "Template %u (%ux%u) must be smaller than the image (%ux%u)",
+                        static_cast<unsigned int>(t), I_tpls[t].getHeight(), I_tpls[t].getWidth(), I.getHeight(),
+                        I.getWidth());
+    }
+  }
+
+  const bool simd = vpCPUFeatures::checkSSE2();
+  const unsigned int min_tpl_size = 8;
+  const unsigned int search_radius = 2;
+  ips.resize(I_tpls.size());
+  scores.resize(I_tpls.size());
+
+  std::vector<vpMatchingLevel> levels(1);
+  levels[0].init(I);
+  std::vector<vpMatchingTemplate> tpl_levels;
+  vpImage<double> I_score;
+  std::vector<vpMatchingCandidate> evaluated, candidates;
+
+  for (size_t t = 0; t < I_tpls.size(); t++) {
+    // Template pyramid, limited by the template size
+    tpl_levels.assign(1, vpMatchingTemplate());
+    tpl_levels[0].I = I_tpls[t];
+    for (unsigned int l = 1; l < nbLevels; l++) {
+      vpMatchingTemplate tpl;
+      vpImageFilter::getGaussPyramidal(tpl_levels[l - 1].I, tpl.I);
+      if (tpl.I.getHeight() < min_tpl_size || tpl.I.getWidth() < min_tpl_size) {
+        break;
+      }
+      if (levels.size() <= l) {
+        levels.push_back(vpMatchingLevel());
+        vpImage<unsigned char> I_down;
+        vpImageFilter::getGaussPyramidal(levels[l - 1].I, I_down);
+        levels[l].init(I_down);
+      }
+      if (tpl.I.getHeight() >= levels[l].I.getHeight() || tpl.I.getWidth() >= levels[l].I.getWidth()) {
+        break;
+      }
+      tpl_levels.push_back(tpl);
+    }
+    for (size_t l = 0; l < tpl_levels.size(); l++) {
+      vpMatchingTemplate &tpl = tpl_levels[l];
+      tpl.size = static_cast<int64_t>(tpl.I.getSize());
+      tpl.sum = 0;
+      int64_t sqsum = 0;
+      for (unsigned int i = 0; i < tpl.I.getHeight(); i++) {
+        for (unsigned int j = 0; j < tpl.I.getWidth(); j++) {
+          tpl.sum += tpl.I[i][j];
+          sqsum += tpl.I[i][j] * tpl.I[i][j];
+        }
+      }
+      tpl.variance = static_cast<double>(tpl.size * sqsum - tpl.sum * tpl.sum);
+    }
+
+    // Exhaustive search at the coarsest level
+    unsigned int l = static_cast<unsigned int>(tpl_levels.size()) - 1;
+    I_score.resize(levels[l].I.getHeight() - tpl_levels[l].I.getHeight(),
+                   levels[l].I.getWidth() - tpl_levels[l].I.getWidth(), score_unknown);
+    vpParallel::parallelFor(0, I_score.getHeight(), vpMatchingExhaustiveBody(levels[l], tpl_levels[l], I_score, simd));
+    evaluated.clear();
+    for (unsigned int i = 0; i < I_score.getHeight(); i++) {
+      for (unsigned int j = 0; j < I_score.getWidth(); j++) {
+        evaluated.push_back(vpMatchingCandidate(i, j, I_score[i][j]));
+      }
+    }
+    selectCandidates(I_score, evaluated, l > 0 ? nbCandidates : 1, candidates);
+
+    // Refinement around the candidates of the previous level
+    while (l > 0) {
+      l--;
+      I_score.resize(levels[l].I.getHeight() - tpl_levels[l].I.getHeight(),
+                     levels[l].I.getWidth() - tpl_levels[l].I.getWidth(), score_unknown);
+      evaluated.clear();
+      for (size_t k = 0; k < candidates.size(); k++) {
+        // The size of the finer level may be rounded down
+        const unsigned int ci = std::min(2 * candidates[k].i, I_score.getHeight() - 1);
+        const unsigned int cj = std::min(2 * candidates[k].j, I_score.getWidth() - 1);
+        const unsigned int i_min = std::max(ci, search_radius) - search_radius;
+        const unsigned int j_min = std::max(cj, search_radius) - search_radius;
+        const unsigned int i_max = std::min(ci + search_radius, I_score.getHeight() - 1);
+        const unsigned int j_max = std::min(cj + search_radius, I_score.getWidth() - 1);
+        for (unsigned int i = i_min; i <= i_max; i++) {
+          for (unsigned int j = j_min; j <= j_max; j++) {
+            if (I_score[i][j] == score_unknown) {
+              I_score[i][j] = zncc(levels[l], tpl_levels[l], i, j, simd);
+              evaluated.push_back(vpMatchingCandidate(i, j, I_score[i][j]));
+            }
+          }
+        }
+      }
+      selectCandidates(I_score, evaluated, l > 0 ? nbCandidates : 1, candidates);
+    }
+
+    // Only the best position is kept at the finest level
+    const vpMatchingCandidate best = *std::min_element(evaluated.begin(), evaluated.end());
+    double di = 0, dj = 0;
+    if (subPixel) {
+      // No refinement along a direction where the best match is on the border of the search area
+      const int offsets[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+      double s[4] = {0, 0, 0, 0};
+      bool valid[4];
+      for (int k = 0; k < 4; k++) {
+        const int i = static_cast<int>(best.i) + offsets[k][0], j = static_cast<int>(best.j) + offsets[k][1];
+        valid[k] = i >= 0 && j >= 0 && i < static_cast<int>(I_score.getHeight()) &&
+                   j < static_cast<int>(I_score.getWidth());
+        if (valid[k]) {
+          if (I_score[i][j] == score_unknown) {
+            I_score[i][j] = zncc(levels[0], tpl_levels[0], i, j, simd);
+          }
+          s[k] = I_score[i][j];
+        }
+      }
+      if (valid[0] && valid[1]) {
+        di = parabolaPeak(s[0], best.score, s[1]);
+      }
+      if (valid[2] && valid[3]) {
+        dj = parabolaPeak(s[2], best.score, s[3]);
+      }
+    }
+    ips[t].set_ij(best.i + di, best.j + dj);
+    scores[t] = best.score;
+  }
+}
+
 // Reference:
 // http://blog.demofox.org/2015/08/15/resizing-images-with-bicubic-interpolation/
 // t is a value that goes from 0 to 1 to interpolate in a C1 continuous way
@@ -863,6 +2134,123 @@ int64_t vpImageTools::lerp2(int64_t A, int64_t B, int64_t t, int64_t t_1) {
   return A * t_1 + B * t;
 }
 
+/*!
+  Compute the coefficients of the separable resampling of a row or of a
+  column of \e srcSize pixels into \e dstSize pixels. The pixel \e j of the
+  resized row is \f$ \sum_{k} weights[j \times nbTaps + k] \times src[first[j] + k] \f$,
+  with \f$ first[j] + nbTaps \leq srcSize \f$.
+
+  With INTERPOLATION_AREA, the weight of an input pixel is the part of the
+  resized pixel that it covers. With INTERPOLATION_CUBIC, the weights are the
+  ones of the cubic Hermite spline of resizeBicubic(), with the same mapping
+  of the coordinates and clamping at the borders.
+*/
+void vpImageTools::computeResizeCoefficients(unsigned int srcSize, unsigned int dstSize,
+                                             const vpImageInterpolationType &method, std::vector<unsigned int> &first,
+                                             std::vector<float> &weights, unsigned int &nbTaps)
+{
+  // Taps of each resized pixel, possibly with repeated clamped indexes
+  std::vector<unsigned int> idx_first(dstSize), idx_last(dstSize);
+  std::vector<std::vector<std::pair<unsigned int, double> > > taps(dstSize);
+
+  if (method == INTERPOLATION_AREA) {
+    // The resized pixel j covers [j * srcSize / dstSize, (j + 1) * srcSize / dstSize[
+    // in the input row. The bounds are computed with integers, the overlaps
+    // being scaled by dstSize.
+    for (unsigned int j = 0; j < dstSize; j++) {
+      const uint64_t begin = static_cast<uint64_t>(j) * srcSize, end = static_cast<uint64_t>(j + 1) * srcSize;
+      const unsigned int k0 = static_cast<unsigned int>(begin / dstSize);
+      const unsigned int k1 = static_cast<unsigned int>((end - 1) / dstSize);
+      for (unsigned int k = k0; k <= k1; k++) {
+        const uint64_t overlap = std::min(static_cast<uint64_t>(k + 1) * dstSize, end) -
+                                 std::max(static_cast<uint64_t>(k) * dstSize, begin);
+        taps[j].push_back(std::make_pair(k, static_cast<double>(overlap) / srcSize));
+      }
+    }
+  } else {
+    const float scale = (srcSize - 1) / static_cast<float>(dstSize - 1);
+    for (unsigned int j = 0; j < dstSize; j++) {
+      const float u = j * scale;
+      const int u0 = static_cast<int>(u);
+      const double t = u - u0;
+      const double w[4] = {(-t * t * t + 2 * t * t - t) / 2, (3 * t * t * t - 5 * t * t + 2) / 2,
+                           (-3 * t * t * t + 4 * t * t + t) / 2, (t * t * t - t * t) / 2};
+      for (int k = 0; k < 4; k++) {
+        const int idx = std::max(0, std::min(u0 - 1 + k, static_cast<int>(srcSize) - 1));
+        taps[j].push_back(std::make_pair(static_cast<unsigned int>(idx), w[k]));
+      }
+    }
+  }
+
+  // The taps of a resized pixel are in a window of nbTaps consecutive pixels
+  nbTaps = 1;
+  for (unsigned int j = 0; j < dstSize; j++) {
+    idx_first[j] = taps[j].front().first;
+    idx_last[j] = taps[j].front().first;
+    for (size_t k = 1; k < taps[j].size(); k++) {
+      idx_first[j] = std::min(idx_first[j], taps[j][k].first);
+      idx_last[j] = std::max(idx_last[j], taps[j][k].first);
+    }
+    nbTaps = std::max(nbTaps, idx_last[j] - idx_first[j] + 1);
+  }
+
+  first.resize(dstSize);
+  weights.assign(dstSize * nbTaps, 0.0f);
+  for (unsigned int j = 0; j < dstSize; j++) {
+    first[j] = std::min(idx_first[j], srcSize - nbTaps);
+    for (size_t k = 0; k < taps[j].size(); k++) {
+      weights[j * nbTaps + taps[j][k].first - first[j]] += static_cast<float>(taps[j][k].second);
+    }
+  }
+}
+
+/*!
+  Area or bi-cubic resampling of a grey image with the separable kernels.
+*/
+void vpImageTools::resizeSeparable(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                   const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (method == INTERPOLATION_AREA) {
+    const unsigned int factor = decimationFactor(I, Ires);
+    if (factor != 0) {
+      vpParallel::parallelFor(0, Ires.getHeight(),
+                              vpResizeDecimateBody<unsigned char>(I, Ires, factor, useResizeSIMD()), nThreads);
+      return;
+    }
+  }
+
+  std::vector<unsigned int> firstX, firstY;
+  std::vector<float> weightsX, weightsY;
+  unsigned int nbTapsX, nbTapsY;
+  computeResizeCoefficients(I.getWidth(), Ires.getWidth(), method, firstX, weightsX, nbTapsX);
+  computeResizeCoefficients(I.getHeight(), Ires.getHeight(), method, firstY, weightsY, nbTapsY);
+  resizeSeparableImage(I, Ires, firstX, weightsX, nbTapsX, firstY, weightsY, nbTapsY, nThreads);
+}
+
+/*!
+  Area or bi-cubic resampling of a color image with the separable kernels.
+  The alpha channel is resampled like the other channels.
+*/
+void vpImageTools::resizeSeparable(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires,
+                                   const vpImageInterpolationType &method, unsigned int nThreads)
+{
+  if (method == INTERPOLATION_AREA) {
+    const unsigned int factor = decimationFactor(I, Ires);
+    if (factor != 0) {
+      vpParallel::parallelFor(0, Ires.getHeight(), vpResizeDecimateBody<vpRGBa>(I, Ires, factor, useResizeSIMD()),
+                              nThreads);
+      return;
+    }
+  }
+
+  std::vector<unsigned int> firstX, firstY;
+  std::vector<float> weightsX, weightsY;
+  unsigned int nbTapsX, nbTapsY;
+  computeResizeCoefficients(I.getWidth(), Ires.getWidth(), method, firstX, weightsX, nbTapsX);
+  computeResizeCoefficients(I.getHeight(), Ires.getHeight(), method, firstY, weightsY, nbTapsY);
+  resizeSeparableImage(I, Ires, firstX, weightsX, nbTapsX, firstY, weightsY, nbTapsY, nThreads);
+}
+
 double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpImage<double> &I2,
                                            const vpImage<double> &II, const vpImage<double> &IIsq,
                                            const vpImage<double> &II_tpl, const vpImage<double> &IIsq_tpl,
@@ -872,14 +2260,12 @@ double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpIm
 #if VISP_HAVE_SSE2
   bool use_sse_version = true;
   if (vpCPUFeatures::checkSSE2() && I2.getWidth() >= 2) {
-    const double *ptr_I1 = I1.bitmap;
-    const double *ptr_I2 = I2.bitmap;
-
     __m128d v_ab = _mm_setzero_pd();
 
     for (unsigned int i = 0; i < I2.getHeight(); i++) {
       unsigned int j = 0;
-      ptr_I1 = &I1.bitmap[(i0 + i) * I1.getWidth() + j0];
+      const double *ptr_I1 = I1[i0 + i] + j0;
+      const double *ptr_I2 = I2[i];
 
       for (; j <= I2.getWidth() - 2; j += 2, ptr_I1 += 2, ptr_I2 += 2) {
         const __m128d v1 = _mm_loadu_pd(ptr_I1);
@@ -926,6 +2312,169 @@ double vpImageTools::normalizedCorrelation(const vpImage<double> &I1, const vpIm
   return ab / sqrt(a2 * b2);
 }
 
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+class vpImageTools::RemapBody : public vpParallelBody
+{
+public:
+  RemapBody(const vpImage<unsigned char> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+            const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<unsigned char> &Iundist)
+    : m_I(I), m_mapU(mapU), m_mapV(mapV), m_mapDu(mapDu), m_mapDv(mapDv), m_Iundist(Iundist)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      for (unsigned int j = 0; j < m_I.getWidth(); j++) {
+
+        int u_round = m_mapU[i][j];
+        int v_round = m_mapV[i][j];
+
+        float du = m_mapDu[i][j];
+        float dv = m_mapDv[i][j];
+
+        if (0 <= u_round && 0 <= v_round && u_round < static_cast<int>(m_I.getWidth()) - 1
+            && v_round < static_cast<int>(m_I.getHeight()) - 1) {
+          // process interpolation
+          float col0 = lerp(m_I[v_round][u_round], m_I[v_round][u_round + 1], du);
+          float col1 = lerp(m_I[v_round + 1][u_round], m_I[v_round + 1][u_round + 1], du);
+          float value = lerp(col0, col1, dv);
+
+          m_Iundist[i][j] = static_cast<unsigned char>(value);
+        } else {
+          m_Iundist[i][j] = 0;
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  const vpArray2D<int> &m_mapU;
+  const vpArray2D<int> &m_mapV;
+  const vpArray2D<float> &m_mapDu;
+  const vpArray2D<float> &m_mapDv;
+  vpImage<unsigned char> &m_Iundist;
+};
+
+class vpImageTools::RemapRGBaBody : public vpParallelBody
+{
+public:
+  RemapRGBaBody(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, const vpArray2D<int> &mapV,
+                const vpArray2D<float> &mapDu, const vpArray2D<float> &mapDv, vpImage<vpRGBa> &Iundist,
+                bool checkSSE2)
+    : m_I(I), m_mapU(mapU), m_mapV(mapV), m_mapDu(mapDu), m_mapDv(mapDv), m_Iundist(Iundist),
+      m_checkSSE2(checkSSE2)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    if (m_checkSSE2) {
+#if defined VISP_HAVE_SSE2
+      for (unsigned int i = begin; i < end; i++) {
+        for (unsigned int j = 0; j < m_I.getWidth(); j++) {
+
+          int u_round = m_mapU[i][j];
+          int v_round = m_mapV[i][j];
+
+          const __m128 vdu = _mm_set1_ps(m_mapDu[i][j]);
+          const __m128 vdv = _mm_set1_ps(m_mapDv[i][j]);
+
+          if (0 <= u_round && 0 <= v_round && u_round < static_cast<int>(m_I.getWidth()) - 1
+              && v_round < static_cast<int>(m_I.getHeight()) - 1) {
+    #define VLERP(va, vb, vt) _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vt));
+
+            // process interpolation
+            const __m128 vdata1 =
+                _mm_set_ps(static_cast<float>(m_I[v_round][u_round].A), static_cast<float>(m_I[v_round][u_round].B),
+                           static_cast<float>(m_I[v_round][u_round].G), static_cast<float>(m_I[v_round][u_round].R));
+
+            const __m128 vdata2 =
+                _mm_set_ps(static_cast<float>(m_I[v_round][u_round + 1].A), static_cast<float>(m_I[v_round][u_round + 1].B),
+                           static_cast<float>(m_I[v_round][u_round + 1].G), static_cast<float>(m_I[v_round][u_round + 1].R));
+
+            const __m128 vdata3 =
+                _mm_set_ps(static_cast<float>(m_I[v_round + 1][u_round].A), static_cast<float>(m_I[v_round + 1][u_round].B),
+                           static_cast<float>(m_I[v_round + 1][u_round].G), static_cast<float>(m_I[v_round + 1][u_round].R));
+
+            const __m128 vdata4 = _mm_set_ps(
+                static_cast<float>(m_I[v_round + 1][u_round + 1].A), static_cast<float>(m_I[v_round + 1][u_round + 1].B),
+                static_cast<float>(m_I[v_round + 1][u_round + 1].G), static_cast<float>(m_I[v_round + 1][u_round + 1].R));
+
+            const __m128 vcol0 = VLERP(vdata1, vdata2, vdu);
+            const __m128 vcol1 = VLERP(vdata3, vdata4, vdu);
+            const __m128 vvalue = VLERP(vcol0, vcol1, vdv);
+
+    #undef VLERP
+
+            float values[4];
+            _mm_storeu_ps(values, vvalue);
+            m_Iundist[i][j].R = static_cast<unsigned char>(values[0]);
+            m_Iundist[i][j].G = static_cast<unsigned char>(values[1]);
+            m_Iundist[i][j].B = static_cast<unsigned char>(values[2]);
+            m_Iundist[i][j].A = static_cast<unsigned char>(values[3]);
+          } else {
+            m_Iundist[i][j] = 0;
+          }
+        }
+      }
+#endif
+    } else {
+      for (unsigned int i = begin; i < end; i++) {
+        for (unsigned int j = 0; j < m_I.getWidth(); j++) {
+
+          int u_round = m_mapU[i][j];
+          int v_round = m_mapV[i][j];
+
+          float du = m_mapDu[i][j];
+          float dv = m_mapDv[i][j];
+
+          if (0 <= u_round && 0 <= v_round && u_round < static_cast<int>(m_I.getWidth()) - 1
+              && v_round < static_cast<int>(m_I.getHeight()) - 1) {
+            // process interpolation
+            float col0 = lerp(m_I[v_round][u_round].R, m_I[v_round][u_round + 1].R, du);
+            float col1 = lerp(m_I[v_round + 1][u_round].R, m_I[v_round + 1][u_round + 1].R, du);
+            float value = lerp(col0, col1, dv);
+
+            m_Iundist[i][j].R = static_cast<unsigned char>(value);
+
+            col0 = lerp(m_I[v_round][u_round].G, m_I[v_round][u_round + 1].G, du);
+            col1 = lerp(m_I[v_round + 1][u_round].G, m_I[v_round + 1][u_round + 1].G, du);
+            value = lerp(col0, col1, dv);
+
+            m_Iundist[i][j].G = static_cast<unsigned char>(value);
+
+            col0 = lerp(m_I[v_round][u_round].B, m_I[v_round][u_round + 1].B, du);
+            col1 = lerp(m_I[v_round + 1][u_round].B, m_I[v_round + 1][u_round + 1].B, du);
+            value = lerp(col0, col1, dv);
+
+            m_Iundist[i][j].B = static_cast<unsigned char>(value);
+
+            col0 = lerp(m_I[v_round][u_round].A, m_I[v_round][u_round + 1].A, du);
+            col1 = lerp(m_I[v_round + 1][u_round].A, m_I[v_round + 1][u_round + 1].A, du);
+            value = lerp(col0, col1, dv);
+
+            m_Iundist[i][j].A = static_cast<unsigned char>(value);
+          } else {
+            m_Iundist[i][j] = 0;
+          }
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<vpRGBa> &m_I;
+  const vpArray2D<int> &m_mapU;
+  const vpArray2D<int> &m_mapV;
+  const vpArray2D<float> &m_mapDu;
+  const vpArray2D<float> &m_mapDv;
+  vpImage<vpRGBa> &m_Iundist;
+  bool m_checkSSE2;
+};
+#endif // DOXYGEN_SHOULD_SKIP_THIS
+
 /*!
   Apply the transformation map to the image.
 
@@ -941,32 +2490,7 @@ void vpImageTools::remap(const vpImage<unsigned char> &I, const vpArray2D<int> &
 {
   Iundist.resize(I.getHeight(), I.getWidth());
 
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-  for (int i_ = 0; i_ < static_cast<int>(I.getHeight()); i_++) {
-    const unsigned int i = static_cast<unsigned int>(i_);
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-
-      int u_round = mapU[i][j];
-      int v_round = mapV[i][j];
-
-      float du = mapDu[i][j];
-      float dv = mapDv[i][j];
-
-      if (0 <= u_round && 0 <= v_round && u_round < static_cast<int>(I.getWidth()) - 1
-          && v_round < static_cast<int>(I.getHeight()) - 1) {
-        // process interpolation
-        float col0 = lerp(I[v_round][u_round], I[v_round][u_round + 1], du);
-        float col1 = lerp(I[v_round + 1][u_round], I[v_round + 1][u_round + 1], du);
-        float value = lerp(col0, col1, dv);
-
-        Iundist[i][j] = static_cast<unsigned char>(value);
-      } else {
-        Iundist[i][j] = 0;
-      }
-    }
-  }
+  vpParallel::parallelFor(0, I.getHeight(), RemapBody(I, mapU, mapV, mapDu, mapDv, Iundist));
 }
 
 /*!
@@ -989,106 +2513,37 @@ void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpArray2D<int> &mapU, c
   checkSSE2 = false;
 #endif
 
-  if (checkSSE2) {
-#if defined VISP_HAVE_SSE2
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i_ = 0; i_ < static_cast<int>(I.getHeight()); i_++) {
-      const unsigned int i = static_cast<unsigned int>(i_);
-      for (unsigned int j = 0; j < I.getWidth(); j++) {
-
-        int u_round = mapU[i][j];
-        int v_round = mapV[i][j];
-
-        const __m128 vdu = _mm_set1_ps(mapDu[i][j]);
-        const __m128 vdv = _mm_set1_ps(mapDv[i][j]);
-
-        if (0 <= u_round && 0 <= v_round && u_round < static_cast<int>(I.getWidth()) - 1
-            && v_round < static_cast<int>(I.getHeight()) - 1) {
-  #define VLERP(va, vb, vt) _mm_add_ps(va, _mm_mul_ps(_mm_sub_ps(vb, va), vt));
-
-          // process interpolation
-          const __m128 vdata1 =
-              _mm_set_ps(static_cast<float>(I[v_round][u_round].A), static_cast<float>(I[v_round][u_round].B),
-                         static_cast<float>(I[v_round][u_round].G), static_cast<float>(I[v_round][u_round].R));
-
-          const __m128 vdata2 =
-              _mm_set_ps(static_cast<float>(I[v_round][u_round + 1].A), static_cast<float>(I[v_round][u_round + 1].B),
-                         static_cast<float>(I[v_round][u_round + 1].G), static_cast<float>(I[v_round][u_round + 1].R));
-
-          const __m128 vdata3 =
-              _mm_set_ps(static_cast<float>(I[v_round + 1][u_round].A), static_cast<float>(I[v_round + 1][u_round].B),
-                         static_cast<float>(I[v_round + 1][u_round].G), static_cast<float>(I[v_round + 1][u_round].R));
-
-          const __m128 vdata4 = _mm_set_ps(
-              static_cast<float>(I[v_round + 1][u_round + 1].A), static_cast<float>(I[v_round + 1][u_round + 1].B),
-              static_cast<float>(I[v_round + 1][u_round + 1].G), static_cast<float>(I[v_round + 1][u_round + 1].R));
-
-          const __m128 vcol0 = VLERP(vdata1, vdata2, vdu);
-          const __m128 vcol1 = VLERP(vdata3, vdata4, vdu);
-          const __m128 vvalue = VLERP(vcol0, vcol1, vdv);
-
-  #undef VLERP
-
-          float values[4];
-          _mm_storeu_ps(values, vvalue);
-          Iundist[i][j].R = static_cast<unsigned char>(values[0]);
-          Iundist[i][j].G = static_cast<unsigned char>(values[1]);
-          Iundist[i][j].B = static_cast<unsigned char>(values[2]);
-          Iundist[i][j].A = static_cast<unsigned char>(values[3]);
-        } else {
-          Iundist[i][j] = 0;
-        }
-      }
-    }
-#endif
-  } else {
-#if defined _OPENMP // only to disable warning: ignoring #pragma omp parallel [-Wunknown-pragmas]
-#pragma omp parallel for schedule(dynamic)
-#endif
-    for (int i_ = 0; i_ < static_cast<int>(I.getHeight()); i_++) {
-      const unsigned int i = static_cast<unsigned int>(i_);
-      for (unsigned int j = 0; j < I.getWidth(); j++) {
-
-        int u_round = mapU[i][j];
-        int v_round = mapV[i][j];
-
-        float du = mapDu[i][j];
-        float dv = mapDv[i][j];
-
-        if (0 <= u_round && 0 <= v_round && u_round < static_cast<int>(I.getWidth()) - 1
-            && v_round < static_cast<int>(I.getHeight()) - 1) {
-          // process interpolation
-          float col0 = lerp(I[v_round][u_round].R, I[v_round][u_round + 1].R, du);
-          float col1 = lerp(I[v_round + 1][u_round].R, I[v_round + 1][u_round + 1].R, du);
-          float value = lerp(col0, col1, dv);
-
-          Iundist[i][j].R = static_cast<unsigned char>(value);
+  vpParallel::parallelFor(0, I.getHeight(), RemapRGBaBody(I, mapU, mapV, mapDu, mapDv, Iundist, checkSSE2));
+}
 
-          col0 = lerp(I[v_round][u_round].G, I[v_round][u_round + 1].G, du);
-          col1 = lerp(I[v_round + 1][u_round].G, I[v_round + 1][u_round + 1].G, du);
-          value = lerp(col0, col1, dv);
+/*!
+  Apply a precomputed fixed-point undistortion map to the image.
 
-          Iundist[i][j].G = static_cast<unsigned char>(value);
+  \param I : Input grayscale image, its size must match vpUndistortMap::getSourceWidth() and
+  vpUndistortMap::getSourceHeight().
+  \param map : Undistortion map.
+  \param Iundist : Output transformed grayscale image.
 
-          col0 = lerp(I[v_round][u_round].B, I[v_round][u_round + 1].B, du);
-          col1 = lerp(I[v_round + 1][u_round].B, I[v_round + 1][u_round + 1].B, du);
-          value = lerp(col0, col1, dv);
+  \sa vpUndistortMap::remap()
+*/
+void vpImageTools::remap(const vpImage<unsigned char> &I, const vpUndistortMap &map, vpImage<unsigned char> &Iundist)
+{
+  map.remap(I, Iundist);
+}
 
-          Iundist[i][j].B = static_cast<unsigned char>(value);
+/*!
+  Apply a precomputed fixed-point undistortion map to the image.
 
-          col0 = lerp(I[v_round][u_round].A, I[v_round][u_round + 1].A, du);
-          col1 = lerp(I[v_round + 1][u_round].A, I[v_round + 1][u_round + 1].A, du);
-          value = lerp(col0, col1, dv);
+  \param I : Input color image, its size must match vpUndistortMap::getSourceWidth() and
+  vpUndistortMap::getSourceHeight().
+  \param map : Undistortion map.
+  \param Iundist : Output transformed color image.
 
-          Iundist[i][j].A = static_cast<unsigned char>(value);
-        } else {
-          Iundist[i][j] = 0;
-        }
-      }
-    }
-  }
+  \sa vpUndistortMap::remap()
+*/
+void vpImageTools::remap(const vpImage<vpRGBa> &I, const vpUndistortMap &map, vpImage<vpRGBa> &Iundist)
+{
+  map.remap(I, Iundist);
 }
 
 bool vpImageTools::checkFixedPoint(unsigned int x, unsigned int y, const vpMatrix &T, bool affine)
@@ -0,0 +1,194 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Organized point cloud stored as packed floats.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpPointCloud.h>
+
+/*!
+  Default constructor: empty point cloud.
+*/
+vpPointCloud::vpPointCloud() : m_storage(), m_data(NULL), m_height(0), m_width(0), m_step(3) {}
+
+/*!
+  Build a point cloud that owns a buffer of \e height x \e width points,
+  initialized to zero, that is invalid points.
+
+  \param height : Number of rows.
+  \param width : Number of columns.
+*/
+vpPointCloud::vpPointCloud(unsigned int height, unsigned int width)
+  : m_storage(), m_data(NULL), m_height(0), m_width(0), m_step(3)
+{
+  resize(height, width);
+}
+
+/*!
+  Wrap an external buffer without copying it.
+
+  \param data : Pointer to the coordinates \f$(X, Y, Z)\f$ of the first point.
+  \param height : Number of rows.
+  \param width : Number of columns.
+  \param step : Number of floats between two consecutive points, at least 3.
+
+  \sa init()
+*/
+vpPointCloud::vpPointCloud(const float *data, unsigned int height, unsigned int width, unsigned int step)
+  : m_storage(), m_data(NULL), m_height(0), m_width(0), m_step(3)
+{
+  init(data, height, width, step);
+}
+
+/*!
+  Copy constructor. A point cloud that wraps an external buffer is copied as
+  a point cloud that wraps the same buffer.
+*/
+vpPointCloud::vpPointCloud(const vpPointCloud &cloud)
+  : m_storage(), m_data(NULL), m_height(0), m_width(0), m_step(3)
+{
+  *this = cloud;
+}
+
+/*!
+  Copy operator. A point cloud that wraps an external buffer is copied as a
+  point cloud that wraps the same buffer.
+*/
+vpPointCloud &vpPointCloud::operator=(const vpPointCloud &cloud)
+{
+  if (this != &cloud) {
+    m_storage = cloud.m_storage;
+    m_data = cloud.m_storage.empty() ? cloud.m_data : &m_storage[0];
+    m_height = cloud.m_height;
+    m_width = cloud.m_width;
+    m_step = cloud.m_step;
+  }
+  return *this;
+}
+
+/*!
+  Copy a point cloud stored as a vector of column vectors, as given by
+  vpRealSense2::acquire() or vpRealSense::acquire(), into a buffer owned by
+  this point cloud.
+
+  \param point_cloud : Vector of \e height x \e width points, each point having
+  at least three coordinates.
+  \param height : Number of rows.
+  \param width : Number of columns.
+
+  \exception vpException::dimensionError : If the size of the vector does not
+  match the dimensions.
+*/
+void vpPointCloud::buildFrom(const std::vector<vpColVector> &point_cloud, unsigned int height, unsigned int width)
+{
+  if (point_cloud.size() != static_cast<size_t>(height) * width) {
+    throw vpException(vpException::dimensionError, "Point cloud of %d points cannot be a %dx%d point cloud",
+                      static_cast<int>(point_cloud.size()), height, width);
+  }
+
+  resize(height, width);
+  float *p = getWritableData();
+  for (unsigned int n = 0; n < getSize(); n++, p += 3) {
+    p[0] = static_cast<float>(point_cloud[n][0]);
+    p[1] = static_cast<float>(point_cloud[n][1]);
+    p[2] = static_cast<float>(point_cloud[n][2]);
+  }
+}
+
+/*!
+  Copy the point cloud into a vector of column vectors \f$(X, Y, Z, 1)\f$, as
+  given by vpRealSense2::acquire().
+
+  \param point_cloud : Vector of getSize() points.
+*/
+void vpPointCloud::convert(std::vector<vpColVector> &point_cloud) const
+{
+  point_cloud.resize(getSize());
+  for (unsigned int n = 0; n < getSize(); n++) {
+    const float *p = (*this)[n];
+    point_cloud[n].resize(4, false);
+    point_cloud[n][0] = p[0];
+    point_cloud[n][1] = p[1];
+    point_cloud[n][2] = p[2];
+    point_cloud[n][3] = 1.0;
+  }
+}
+
+/*!
+  Wrap an external buffer without copying it. The buffer must outlive the
+  point cloud, or the next call to init(), resize() or buildFrom().
+
+  \param data : Pointer to the coordinates \f$(X, Y, Z)\f$ of the first point.
+  \param height : Number of rows.
+  \param width : Number of columns.
+  \param step : Number of floats between two consecutive points, at least 3.
+
+  \exception vpException::badValue : If \e data is NULL while the point cloud
+  is not empty, or if \e step is lower than 3.
+*/
+void vpPointCloud::init(const float *data, unsigned int height, unsigned int width, unsigned int step)
+{
+  if (step < 3) {
+    throw vpException(vpException::badValue, "The step between two points must be at least 3 floats");
+  }
+  if (data == NULL && height * width != 0) {
+    throw vpException(vpException::badValue, "Cannot wrap a NULL buffer");
+  }
+
+  std::vector<float>().swap(m_storage);
+  m_data = height * width != 0 ? data : NULL;
+  m_height = height;
+  m_width = width;
+  m_step = step;
+}
+
+/*!
+  Resize the point cloud to \e height x \e width points owned by the point
+  cloud. The points are packed, that is getStep() is 3. The buffer is reused
+  when the size does not change, otherwise the points are set to zero.
+
+  \param height : Number of rows.
+  \param width : Number of columns.
+*/
+void vpPointCloud::resize(unsigned int height, unsigned int width)
+{
+  const size_t size = 3 * static_cast<size_t>(height) * width;
+  if (!isOwner() || m_step != 3 || m_storage.size() != size) {
+    m_storage.assign(size, 0.0f);
+  }
+
+  m_data = size != 0 ? &m_storage[0] : NULL;
+  m_height = height;
+  m_width = width;
+  m_step = 3;
+}
@@ -0,0 +1,202 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Flat structuring element for mathematical morphology.
+ *
+ *****************************************************************************/
+
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpStructuringElement.h>
+
+/*!
+  Default constructor: 3x3 square, equivalent to the 8-connexity.
+*/
+vpStructuringElement::vpStructuringElement()
+  : m_mask(), m_anchor_i(0), m_anchor_j(0), m_shape(SHAPE_RECTANGLE), m_runs()
+{
+  init(vpImage<unsigned char>(3, 3, 255), 1, 1, SHAPE_RECTANGLE);
+}
+
+/*!
+  Build a user-defined structuring element, the anchor being at the center of
+  the mask.
+
+  \param mask : Mask of the structuring element, non-zero values belong to the element.
+
+  \exception vpException::dimensionError : If the mask is empty.
+  \exception vpException::badValue : If the mask has no non-zero value.
+*/
+vpStructuringElement::vpStructuringElement(const vpImage<unsigned char> &mask)
+  : m_mask(), m_anchor_i(0), m_anchor_j(0), m_shape(SHAPE_CUSTOM), m_runs()
+{
+  init(mask, mask.getHeight() / 2, mask.getWidth() / 2, SHAPE_CUSTOM);
+}
+
+/*!
+  Build a user-defined structuring element.
+
+  \param mask : Mask of the structuring element, non-zero values belong to the element.
+  \param anchor_i : Row of the anchor in the mask.
+  \param anchor_j : Column of the anchor in the mask.
+
+  \exception vpException::dimensionError : If the mask is empty or the anchor
+  is outside of the mask.
+  \exception vpException::badValue : If the mask has no non-zero value.
+*/
+vpStructuringElement::vpStructuringElement(const vpImage<unsigned char> &mask, unsigned int anchor_i,
+                                           unsigned int anchor_j)
+  : m_mask(), m_anchor_i(0), m_anchor_j(0), m_shape(SHAPE_CUSTOM), m_runs()
+{
+  init(mask, anchor_i, anchor_j, SHAPE_CUSTOM);
+}
+
+void vpStructuringElement::init(const vpImage<unsigned char> &mask, unsigned int anchor_i, unsigned int anchor_j,
+                                vpShapeType shape)
+{
+  if (mask.getSize() == 0 || anchor_i >= mask.getHeight() || anchor_j >= mask.getWidth()) {
+    throw(vpException(vpException::dimensionError,
+                      "Invalid structuring element of size (%ux%u) with an anchor at (%u, %u)", mask.getHeight(),
+                      mask.getWidth(), anchor_i, anchor_j));
+  }
+
+  m_mask = mask;
+  m_anchor_i = anchor_i;
+  m_anchor_j = anchor_j;
+  m_shape = shape;
+
+  m_runs.clear();
+  for (unsigned int i = 0; i < mask.getHeight(); i++) {
+    unsigned int j = 0;
+    while (j < mask.getWidth()) {
+      if (mask[i][j] == 0) {
+        j++;
+        continue;
+      }
+      const unsigned int start = j;
+      while (j < mask.getWidth() && mask[i][j] != 0) {
+        j++;
+      }
+      vpRun run;
+      run.di = static_cast<int>(i) - static_cast<int>(anchor_i);
+      run.dj = static_cast<int>(start) - static_cast<int>(anchor_j);
+      run.length = j - start;
+      m_runs.push_back(run);
+    }
+  }
+
+  if (m_runs.empty()) {
+    throw(vpException(vpException::badValue, "Empty structuring element"));
+  }
+}
+
+/*!
+  Cross made of a horizontal and a vertical line of \e size pixels centered on
+  the anchor.
+
+  \param size : Length of the lines, it should be odd to be centered.
+*/
+vpStructuringElement vpStructuringElement::cross(unsigned int size)
+{
+  vpImage<unsigned char> mask(size, size, 0);
+  for (unsigned int k = 0; k < size; k++) {
+    mask[size / 2][k] = 255;
+    mask[k][size / 2] = 255;
+  }
+  vpStructuringElement se;
+  se.init(mask, size / 2, size / 2, SHAPE_CROSS);
+  return se;
+}
+
+/*!
+  Digital disk of size (2 \e radius + 1) x (2 \e radius + 1): the pixels whose
+  distance to the center is lower or equal to \e radius + 0.5.
+
+  \param radius : Radius of the disk.
+*/
+vpStructuringElement vpStructuringElement::disk(unsigned int radius)
+{
+  const unsigned int size = 2 * radius + 1;
+  const double r2 = (radius + 0.5) * (radius + 0.5);
+  vpImage<unsigned char> mask(size, size, 0);
+  for (unsigned int i = 0; i < size; i++) {
+    for (unsigned int j = 0; j < size; j++) {
+      const double di = static_cast<double>(i) - radius, dj = static_cast<double>(j) - radius;
+      if (di * di + dj * dj <= r2) {
+        mask[i][j] = 255;
+      }
+    }
+  }
+  vpStructuringElement se;
+  se.init(mask, radius, radius, SHAPE_DISK);
+  return se;
+}
+
+/*!
+  Horizontal line of \e length pixels centered on the anchor.
+*/
+vpStructuringElement vpStructuringElement::horizontalLine(unsigned int length) { return rectangle(length, 1); }
+
+/*!
+  Rectangle of size \e width x \e height, the anchor being at the center. For
+  an even size, the anchor is at the right / bottom of the center.
+
+  \param width : Width of the rectangle.
+  \param height : Height of the rectangle.
+*/
+vpStructuringElement vpStructuringElement::rectangle(unsigned int width, unsigned int height)
+{
+  vpStructuringElement se;
+  se.init(vpImage<unsigned char>(height, width, 255), height / 2, width / 2, SHAPE_RECTANGLE);
+  return se;
+}
+
+/*!
+  Vertical line of \e length pixels centered on the anchor.
+*/
+vpStructuringElement vpStructuringElement::verticalLine(unsigned int length) { return rectangle(1, length); }
+
+/*!
+  Return the structuring element reflected with respect to its anchor, that is
+  the element used to compute a dilatation.
+*/
+vpStructuringElement vpStructuringElement::reflect() const
+{
+  const unsigned int h = m_mask.getHeight(), w = m_mask.getWidth();
+  vpImage<unsigned char> mask(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      mask[i][j] = m_mask[h - 1 - i][w - 1 - j];
+    }
+  }
+  vpStructuringElement se;
+  se.init(mask, h - 1 - m_anchor_i, w - 1 - m_anchor_j, m_shape);
+  return se;
+}
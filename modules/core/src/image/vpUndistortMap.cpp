@@ -0,0 +1,489 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Precomputed fixed-point undistortion map.
+ *
+ *****************************************************************************/
+
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpEndian.h>
+#include <visp3/core/vpException.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpMath.h>
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpUndistortMap.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+namespace
+{
+// Sub-pixel accuracy of the interpolation: 1/128 pixel, weights sum to 1 << 14
+const int interp_bits = 7;
+const int interp_one = 1 << interp_bits;
+const int weight_bits = 2 * interp_bits;
+const int weight_round = 1 << (weight_bits - 1);
+
+const char map_magic[4] = {'V', 'P', 'U', 'M'};
+const uint32_t map_version = 1;
+
+bool useSSE2()
+{
+#if VISP_HAVE_SSE2
+  return vpCPUFeatures::checkSSE2();
+#else
+  return false;
+#endif
+}
+
+class vpUndistortMapGreyBody : public vpParallelBody
+{
+public:
+  vpUndistortMapGreyBody(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist, const int *cols,
+                         const int *rows, const short *weights)
+    : m_I(I), m_Iundist(Iundist), m_cols(cols), m_rows(rows), m_weights(weights), m_simd(useSSE2())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_Iundist.getWidth();
+    const unsigned int stride = m_I.getStride();
+
+    for (unsigned int i = begin; i < end; i++) {
+      const int *col = m_cols + i * width;
+      const int *row = m_rows + i * width;
+      const short *w = m_weights + 4 * i * width;
+      unsigned char *dst = m_Iundist[i];
+      unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (m_simd) {
+        const __m128i vround = _mm_set1_epi32(weight_round);
+        for (; j + 4 <= width; j += 4, col += 4, row += 4, w += 16) {
+          // Gather the 2x2 neighborhoods as 16-bit values in the same order than the weights
+          int p[8];
+          for (unsigned int k = 0; k < 4; k++) {
+            const unsigned char *s = m_I[row[k]] + col[k];
+            p[2 * k] = s[0] | (s[1] << 16);
+            p[2 * k + 1] = s[stride] | (s[stride + 1] << 16);
+          }
+          const __m128i s01 = _mm_madd_epi16(_mm_set_epi32(p[3], p[2], p[1], p[0]),
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i *>(w)));
+          const __m128i s23 = _mm_madd_epi16(_mm_set_epi32(p[7], p[6], p[5], p[4]),
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i *>(w + 8)));
+          // Add the top and bottom contributions of each pixel
+          const __m128 top = _mm_shuffle_ps(_mm_castsi128_ps(s01), _mm_castsi128_ps(s23), _MM_SHUFFLE(2, 0, 2, 0));
+          const __m128 bottom = _mm_shuffle_ps(_mm_castsi128_ps(s01), _mm_castsi128_ps(s23), _MM_SHUFFLE(3, 1, 3, 1));
+          __m128i res = _mm_add_epi32(_mm_castps_si128(top), _mm_castps_si128(bottom));
+          res = _mm_srli_epi32(_mm_add_epi32(res, vround), weight_bits);
+          res = _mm_packs_epi32(res, res);
+          res = _mm_packus_epi16(res, res);
+          const int values = _mm_cvtsi128_si32(res);
+          memcpy(dst + j, &values, sizeof(values));
+        }
+      }
+#endif
+
+      for (; j < width; j++, col++, row++, w += 4) {
+        const unsigned char *s = m_I[*row] + *col;
+        const int value = w[0] * s[0] + w[1] * s[1] + w[2] * s[stride] + w[3] * s[stride + 1];
+        dst[j] = static_cast<unsigned char>((value + weight_round) >> weight_bits);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<unsigned char> &m_Iundist;
+  const int *m_cols;
+  const int *m_rows;
+  const short *m_weights;
+  bool m_simd;
+};
+
+class vpUndistortMapRGBaBody : public vpParallelBody
+{
+public:
+  vpUndistortMapRGBaBody(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist, const int *cols, const int *rows,
+                         const short *weights)
+    : m_I(I), m_Iundist(Iundist), m_cols(cols), m_rows(rows), m_weights(weights), m_simd(useSSE2())
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_Iundist.getWidth();
+    const unsigned int stride = m_I.getStride();
+
+    for (unsigned int i = begin; i < end; i++) {
+      const int *col = m_cols + i * width;
+      const int *row = m_rows + i * width;
+      const short *w = m_weights + 4 * i * width;
+      unsigned char *dst = reinterpret_cast<unsigned char *>(m_Iundist[i]);
+      unsigned int j = 0;
+
+#if VISP_HAVE_SSE2
+      if (m_simd) {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i vround = _mm_set1_epi32(weight_round);
+        for (; j < width; j++, col++, row++, w += 4) {
+          const unsigned char *s = reinterpret_cast<const unsigned char *>(m_I[*row] + *col);
+          // R00 G00 B00 A00 R01 G01 B01 A01 as 16-bit values, then interleaved as R00 R01 G00 G01...
+          __m128i top = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(s)), zero);
+          __m128i bottom = _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(s + 4 * stride)), zero);
+          top = _mm_unpacklo_epi16(top, _mm_srli_si128(top, 8));
+          bottom = _mm_unpacklo_epi16(bottom, _mm_srli_si128(bottom, 8));
+
+          const __m128i wtop = _mm_set1_epi32((w[0] & 0xFFFF) | (w[1] << 16));
+          const __m128i wbottom = _mm_set1_epi32((w[2] & 0xFFFF) | (w[3] << 16));
+          __m128i res = _mm_add_epi32(_mm_madd_epi16(top, wtop), _mm_madd_epi16(bottom, wbottom));
+          res = _mm_srli_epi32(_mm_add_epi32(res, vround), weight_bits);
+          res = _mm_packs_epi32(res, res);
+          res = _mm_packus_epi16(res, res);
+          const int values = _mm_cvtsi128_si32(res);
+          memcpy(dst + 4 * j, &values, sizeof(values));
+        }
+      }
+#endif
+
+      for (; j < width; j++, col++, row++, w += 4) {
+        const unsigned char *s00 = reinterpret_cast<const unsigned char *>(m_I[*row] + *col);
+        const unsigned char *s10 = s00 + 4 * stride;
+        for (unsigned int c = 0; c < 4; c++) {
+          const int value = w[0] * s00[c] + w[1] * s00[4 + c] + w[2] * s10[c] + w[3] * s10[4 + c];
+          dst[4 * j + c] = static_cast<unsigned char>((value + weight_round) >> weight_bits);
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<vpRGBa> &m_I;
+  vpImage<vpRGBa> &m_Iundist;
+  const int *m_cols;
+  const int *m_rows;
+  const short *m_weights;
+  bool m_simd;
+};
+
+template <class Type> void writeArray(std::ofstream &file, const std::vector<Type> &values)
+{
+#ifdef VISP_LITTLE_ENDIAN
+  if (!values.empty()) {
+    file.write(reinterpret_cast<const char *>(&values[0]), static_cast<std::streamsize>(values.size() * sizeof(Type)));
+  }
+#else
+  for (size_t i = 0; i < values.size(); i++) {
+    vpIoTools::writeBinaryValueLE(file, values[i]);
+  }
+#endif
+}
+
+template <class Type> void readArray(std::ifstream &file, std::vector<Type> &values)
+{
+#ifdef VISP_LITTLE_ENDIAN
+  if (!values.empty()) {
+    file.read(reinterpret_cast<char *>(&values[0]), static_cast<std::streamsize>(values.size() * sizeof(Type)));
+  }
+#else
+  for (size_t i = 0; i < values.size(); i++) {
+    vpIoTools::readBinaryValueLE(file, values[i]);
+  }
+#endif
+}
+} // namespace
+
+/*!
+  Default constructor. The map is empty, call init() or load() before remap().
+*/
+vpUndistortMap::vpUndistortMap()
+  : m_srcWidth(0), m_srcHeight(0), m_dstWidth(0), m_dstHeight(0), m_cols(), m_rows(), m_weights()
+{
+}
+
+/*!
+  Build the undistortion map of images of size \e width x \e height.
+
+  \param cam : Camera parameters with distortion coefficients.
+  \param width : Image width.
+  \param height : Image height.
+*/
+vpUndistortMap::vpUndistortMap(const vpCameraParameters &cam, unsigned int width, unsigned int height)
+  : m_srcWidth(0), m_srcHeight(0), m_dstWidth(0), m_dstHeight(0), m_cols(), m_rows(), m_weights()
+{
+  init(cam, width, height);
+}
+
+void vpUndistortMap::checkSourceSize(unsigned int width, unsigned int height) const
+{
+  if (m_cols.empty()) {
+    throw(vpException(vpException::notInitialized, "The undistortion map is not initialized"));
+  }
+  if (width != m_srcWidth || height != m_srcHeight) {
+    throw(vpException(vpException::dimensionError,
+                      "Image size (%ux%u) does not match the undistortion map source size (%ux%u)", width, height,
+                      m_srcWidth, m_srcHeight));
+  }
+}
+
+/*!
+  Build the undistortion map of images of size \e width x \e height. The
+  undistorted images have the same size than the input images.
+
+  \param cam : Camera parameters with distortion coefficients.
+  \param width : Image width.
+  \param height : Image height.
+*/
+void vpUndistortMap::init(const vpCameraParameters &cam, unsigned int width, unsigned int height)
+{
+  init(cam, width, height, width, height);
+}
+
+/*!
+  Build a map that undistorts images of size \e srcWidth x \e srcHeight,
+  crops the region of interest \e roi of the undistorted image and resizes it
+  to \e dstWidth x \e dstHeight, in a single interpolation step.
+
+  \param cam : Camera parameters with distortion coefficients, related to the
+  source resolution.
+  \param srcWidth : Width of the distorted input images.
+  \param srcHeight : Height of the distorted input images.
+  \param dstWidth : Width of the output images.
+  \param dstHeight : Height of the output images.
+  \param roi : Region of interest in the undistorted image at the source
+  resolution. An empty rectangle stands for the whole image.
+
+  Output pixels whose location falls outside of the input image are set to 0.
+
+  \exception vpException::dimensionError : If an image is smaller than 2x2.
+*/
+void vpUndistortMap::init(const vpCameraParameters &cam, unsigned int srcWidth, unsigned int srcHeight,
+                          unsigned int dstWidth, unsigned int dstHeight, const vpRect &roi)
+{
+  if (srcWidth < 2 || srcHeight < 2 || dstWidth == 0 || dstHeight == 0) {
+    throw(vpException(vpException::dimensionError, "Cannot build an undistortion map from (%ux%u) to (%ux%u)",
+                      srcWidth, srcHeight, dstWidth, dstHeight));
+  }
+
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_dstWidth = dstWidth;
+  m_dstHeight = dstHeight;
+  m_cols.resize(static_cast<size_t>(dstWidth) * dstHeight);
+  m_rows.resize(m_cols.size());
+  m_weights.resize(4 * m_cols.size());
+
+  double roi_left = 0, roi_top = 0, roi_width = srcWidth, roi_height = srcHeight;
+  if (roi.getWidth() > 0 && roi.getHeight() > 0) {
+    roi_left = roi.getLeft();
+    roi_top = roi.getTop();
+    roi_width = roi.getWidth();
+    roi_height = roi.getHeight();
+  }
+  const double scale_u = roi_width / dstWidth;
+  const double scale_v = roi_height / dstHeight;
+
+  const double u0 = cam.get_u0();
+  const double v0 = cam.get_v0();
+  const double kud = cam.get_kud();
+  const double kud_px2 = kud / vpMath::sqr(cam.get_px());
+  const double kud_py2 = kud / vpMath::sqr(cam.get_py());
+
+  for (unsigned int i = 0; i < dstHeight; i++) {
+    // Pixel centers of the output image are aligned with the ones of the region of interest
+    const double v = roi_top + (i + 0.5) * scale_v - 0.5;
+    const double deltav = v - v0;
+    const double fr1 = 1.0 + kud_py2 * deltav * deltav;
+
+    for (unsigned int j = 0; j < dstWidth; j++) {
+      const double u = roi_left + (j + 0.5) * scale_u - 0.5;
+      const double deltau = u - u0;
+      const double fr2 = fr1 + kud_px2 * deltau * deltau;
+
+      const double u_dist = deltau * fr2 + u0;
+      const double v_dist = deltav * fr2 + v0;
+
+      const size_t idx = static_cast<size_t>(i) * dstWidth + j;
+      short *w = &m_weights[4 * idx];
+      if (u_dist < 0 || v_dist < 0 || u_dist > srcWidth - 1 || v_dist > srcHeight - 1) {
+        m_cols[idx] = 0;
+        m_rows[idx] = 0;
+        w[0] = w[1] = w[2] = w[3] = 0;
+        continue;
+      }
+
+      // The last row and column use the previous pixel with a full weight on the right / bottom pixel
+      int x = std::min(static_cast<int>(u_dist), static_cast<int>(srcWidth) - 2);
+      int y = std::min(static_cast<int>(v_dist), static_cast<int>(srcHeight) - 2);
+      int ax = vpMath::round((u_dist - x) * interp_one);
+      int ay = vpMath::round((v_dist - y) * interp_one);
+      if (ax >= interp_one && x < static_cast<int>(srcWidth) - 2) {
+        x++;
+        ax -= interp_one;
+      }
+      if (ay >= interp_one && y < static_cast<int>(srcHeight) - 2) {
+        y++;
+        ay -= interp_one;
+      }
+
+      m_cols[idx] = x;
+      m_rows[idx] = y;
+      w[0] = static_cast<short>((interp_one - ax) * (interp_one - ay));
+      w[1] = static_cast<short>(ax * (interp_one - ay));
+      w[2] = static_cast<short>((interp_one - ax) * ay);
+      w[3] = static_cast<short>(ax * ay);
+    }
+  }
+}
+
+/*!
+  Load a map previously written by save().
+
+  \param filename : Path of the map file.
+
+  \exception vpException::ioError : If the file cannot be read or is not a
+  valid map file.
+*/
+void vpUndistortMap::load(const std::string &filename)
+{
+  std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot open the undistortion map file: %s", filename.c_str()));
+  }
+
+  char magic[4];
+  file.read(magic, sizeof(magic));
+  uint32_t version = 0, srcWidth = 0, srcHeight = 0, dstWidth = 0, dstHeight = 0;
+  vpIoTools::readBinaryValueLE(file, version);
+  vpIoTools::readBinaryValueLE(file, srcWidth);
+  vpIoTools::readBinaryValueLE(file, srcHeight);
+  vpIoTools::readBinaryValueLE(file, dstWidth);
+  vpIoTools::readBinaryValueLE(file, dstHeight);
+  if (!file || memcmp(magic, map_magic, sizeof(magic)) != 0 || version != map_version) {
+    throw(vpException(vpException::ioError, "%s is not a valid undistortion map file", filename.c_str()));
+  }
+
+  std::vector<int> offsets(static_cast<size_t>(dstWidth) * dstHeight);
+  std::vector<short> weights(4 * offsets.size());
+  readArray(file, offsets);
+  readArray(file, weights);
+  if (!file) {
+    throw(vpException(vpException::ioError, "Truncated undistortion map file: %s", filename.c_str()));
+  }
+  // The file stores the offsets y * srcWidth + x of the top-left pixels
+  std::vector<int> cols(offsets.size()), rows(offsets.size());
+  for (size_t i = 0; i < offsets.size(); i++) {
+    if (offsets[i] < 0 || offsets[i] > static_cast<int>((srcHeight - 1) * srcWidth - 2)) {
+      throw(vpException(vpException::ioError, "Corrupted undistortion map file: %s", filename.c_str()));
+    }
+    cols[i] = offsets[i] % static_cast<int>(srcWidth);
+    rows[i] = offsets[i] / static_cast<int>(srcWidth);
+  }
+
+  m_srcWidth = srcWidth;
+  m_srcHeight = srcHeight;
+  m_dstWidth = dstWidth;
+  m_dstHeight = dstHeight;
+  m_cols.swap(cols);
+  m_rows.swap(rows);
+  m_weights.swap(weights);
+}
+
+/*!
+  Apply the map to a grayscale image.
+
+  \param I : Distorted input image, its size must be getSourceWidth() x getSourceHeight().
+  \param Iundist : Output image of size getWidth() x getHeight().
+
+  \exception vpException::notInitialized : If the map is empty.
+  \exception vpException::dimensionError : If the input image size does not match the map.
+*/
+void vpUndistortMap::remap(const vpImage<unsigned char> &I, vpImage<unsigned char> &Iundist) const
+{
+  checkSourceSize(I.getWidth(), I.getHeight());
+  Iundist.resize(m_dstHeight, m_dstWidth);
+  vpParallel::parallelFor(0, m_dstHeight, vpUndistortMapGreyBody(I, Iundist, &m_cols[0], &m_rows[0], &m_weights[0]));
+}
+
+/*!
+  Apply the map to a color image. The four channels are interpolated.
+
+  \param I : Distorted input image, its size must be getSourceWidth() x getSourceHeight().
+  \param Iundist : Output image of size getWidth() x getHeight().
+
+  \exception vpException::notInitialized : If the map is empty.
+  \exception vpException::dimensionError : If the input image size does not match the map.
+*/
+void vpUndistortMap::remap(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Iundist) const
+{
+  checkSourceSize(I.getWidth(), I.getHeight());
+  Iundist.resize(m_dstHeight, m_dstWidth);
+  vpParallel::parallelFor(0, m_dstHeight, vpUndistortMapRGBaBody(I, Iundist, &m_cols[0], &m_rows[0], &m_weights[0]));
+}
+
+/*!
+  Save the map in a binary file (little endian) that can be reloaded with load().
+
+  \param filename : Path of the map file.
+
+  \exception vpException::ioError : If the file cannot be written.
+*/
+void vpUndistortMap::save(const std::string &filename) const
+{
+  std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!file.is_open()) {
+    throw(vpException(vpException::ioError, "Cannot create the undistortion map file: %s", filename.c_str()));
+  }
+
+  file.write(map_magic, sizeof(map_magic));
+  vpIoTools::writeBinaryValueLE(file, map_version);
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(m_srcWidth));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(m_srcHeight));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(m_dstWidth));
+  vpIoTools::writeBinaryValueLE(file, static_cast<uint32_t>(m_dstHeight));
+  std::vector<int> offsets(m_cols.size());
+  for (size_t i = 0; i < offsets.size(); i++) {
+    offsets[i] = m_rows[i] * static_cast<int>(m_srcWidth) + m_cols[i];
+  }
+  writeArray(file, offsets);
+  writeArray(file, m_weights);
+
+  if (!file) {
+    throw(vpException(vpException::ioError, "Cannot write the undistortion map file: %s", filename.c_str()));
+  }
+}
@@ -59,6 +59,7 @@
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixWorkspace.h>
 #include <visp3/core/vpTranslationVector.h>
 
 #ifdef VISP_HAVE_LAPACK
@@ -103,6 +104,18 @@ void vpMatrix::blas_dsyev(char jobz, char uplo, unsigned int n_, double *a_data,
 #  endif
 #endif
 
+namespace
+{
+// Below this number of multiply-adds, packing the operands of the built-in
+// blocked products costs more than it saves
+const double builtin_gemm_min_ops = 4096.;
+
+bool useBuiltinGemm(unsigned int M, unsigned int N, unsigned int K)
+{
+  return static_cast<double>(M) * N * K >= builtin_gemm_min_ops;
+}
+} // namespace
+
 #if !defined(VISP_USE_MSVC) || (defined(VISP_USE_MSVC) && !defined(VISP_BUILD_SHARED_LIBS))
 const unsigned int vpMatrix::m_lapack_min_size_default = 0;
 unsigned int vpMatrix::m_lapack_min_size = vpMatrix::m_lapack_min_size_default;
@@ -675,6 +688,10 @@ void vpMatrix::AAt(vpMatrix &B) const
     vpMatrix::blas_dgemm(transa, transb, rowNum, rowNum, colNum, alpha, data, colNum, data, colNum, beta, B.data, rowNum);
 #endif
   }
+  else if (rowNum > 12 && useBuiltinGemm(rowNum, rowNum, colNum)) {
+    // The dot products of the rows below are already cache friendly for few rows
+    vpMatrix::builtin_dsyrk(rowNum, colNum, data, 1, colNum, B.data, rowNum);
+  }
   else {
     // compute A*A^T
     for (unsigned int i = 0; i < rowNum; i++) {
@@ -727,6 +744,9 @@ void vpMatrix::AtA(vpMatrix &B) const
     vpMatrix::blas_dgemm(transa, transb, colNum, colNum, rowNum, alpha, data, colNum, data, colNum, beta, B.data, colNum);
 #endif
   }
+  else if (useBuiltinGemm(colNum, colNum, rowNum)) {
+    vpMatrix::builtin_dsyrk(colNum, rowNum, data, colNum, 1, B.data, colNum);
+  }
   else {
     for (unsigned int i = 0; i < colNum; i++) {
       double *Bi = B[i];
@@ -1113,11 +1133,54 @@ void vpMatrix::multMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVe
 #endif
   }
   else {
-    w = 0.0;
-    for (unsigned int j = 0; j < A.colNum; j++) {
-      double vj = v[j]; // optimization em 5/12/2006
-      for (unsigned int i = 0; i < A.rowNum; i++) {
-        w[i] += A.rowPtrs[i][j] * vj;
+    vpMatrix::builtin_dgemv(A.rowNum, A.colNum, A.data, A.colNum, v.data, w.data);
+  }
+}
+
+/*!
+  Operation w = A^T * v (v and w are vectors), without computing the transpose
+  of A.
+
+  A new vector won't be allocated for every use of the function
+  (Speed gain if used many times with the same result vector size).
+
+  \sa multMatrixVector(), multTransposeMatrices()
+*/
+void vpMatrix::multTransposeMatrixVector(const vpMatrix &A, const vpColVector &v, vpColVector &w)
+{
+  if (A.rowNum != v.getRows()) {
+    throw(vpException(vpException::dimensionError,
+                      "Cannot multiply the transpose of a (%dx%d) matrix by a (%d) column vector", A.getRows(),
+                      A.getCols(), v.getRows()));
+  }
+
+  if (A.colNum != w.rowNum)
+    w.resize(A.colNum, false);
+
+  // If available use Lapack only for large matrices
+  bool useLapack = (A.rowNum > vpMatrix::m_lapack_min_size || A.colNum > vpMatrix::m_lapack_min_size);
+#if !(defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL))
+  useLapack = false;
+#endif
+
+  if (useLapack) {
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL)
+    double alpha = 1.0;
+    double beta = 0.0;
+    char trans = 'n';
+    int incr = 1;
+
+    vpMatrix::blas_dgemv(trans, A.colNum, A.rowNum, alpha, A.data, A.colNum, v.data, incr, beta, w.data, incr);
+#endif
+  }
+  else {
+    // Accumulate the rows of A weighted by v to read A in memory order
+    std::fill(w.data, w.data + A.colNum, 0.0);
+    for (unsigned int i = 0; i < A.rowNum; i++) {
+      const double *a_i = A.rowPtrs[i];
+      const double v_i = v[i];
+      for (unsigned int j = 0; j < A.colNum; j++) {
+        w.data[j] += a_i[j] * v_i;
       }
     }
   }
@@ -1161,6 +1224,9 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
                          C.data, B.colNum);
 #endif
   }
+  else if (useBuiltinGemm(A.rowNum, B.colNum, A.colNum)) {
+    vpMatrix::builtin_dgemm(A.rowNum, B.colNum, A.colNum, A.data, A.colNum, 1, B.data, B.colNum, 1, C.data, B.colNum);
+  }
   else {
     // 5/12/06 some "very" simple optimization to avoid indexation
     const unsigned int BcolNum = B.colNum;
@@ -1179,6 +1245,60 @@ void vpMatrix::mult2Matrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
   }
 }
 
+/*!
+  Operation C = A^T * B, without computing the transpose of A.
+
+  The result is placed in the third parameter C and not returned.
+  A new matrix won't be allocated for every use of the function
+  (speed gain if used many times with the same result matrix size).
+
+  \sa mult2Matrices(), AtA()
+*/
+void vpMatrix::multTransposeMatrices(const vpMatrix &A, const vpMatrix &B, vpMatrix &C)
+{
+  if (A.rowNum != B.rowNum) {
+    throw(vpException(vpException::dimensionError, "Cannot multiply the transpose of a (%dx%d) matrix by a (%dx%d) matrix",
+                      A.getRows(), A.getCols(), B.getRows(), B.getCols()));
+  }
+
+  if ((A.colNum != C.rowNum) || (B.colNum != C.colNum))
+    C.resize(A.colNum, B.colNum, false, false);
+
+  // If available use Lapack only for large matrices
+  bool useLapack = (A.rowNum > vpMatrix::m_lapack_min_size || A.colNum > vpMatrix::m_lapack_min_size || B.colNum > vpMatrix::m_lapack_min_size);
+#if !(defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL))
+  useLapack = false;
+#endif
+
+  if (useLapack) {
+#if defined(VISP_HAVE_LAPACK) && !defined(VISP_HAVE_LAPACK_BUILT_IN) && !defined(VISP_HAVE_GSL)
+    const double alpha = 1.0;
+    const double beta = 0.0;
+    const char transa = 'n';
+    const char transb = 't';
+    vpMatrix::blas_dgemm(transa, transb, B.colNum, A.colNum, A.rowNum, alpha, B.data, B.colNum, A.data, A.colNum, beta,
+                         C.data, B.colNum);
+#endif
+  }
+  else if (useBuiltinGemm(A.colNum, B.colNum, A.rowNum)) {
+    vpMatrix::builtin_dgemm(A.colNum, B.colNum, A.rowNum, A.data, 1, A.colNum, B.data, B.colNum, 1, C.data, B.colNum);
+  }
+  else {
+    // Accumulate the outer products of the rows of A and B
+    std::fill(C.data, C.data + C.size(), 0.0);
+    for (unsigned int k = 0; k < A.rowNum; k++) {
+      const double *a_k = A.rowPtrs[k];
+      const double *b_k = B.rowPtrs[k];
+      for (unsigned int i = 0; i < A.colNum; i++) {
+        const double a_ki = a_k[i];
+        double *ci = C.rowPtrs[i];
+        for (unsigned int j = 0; j < B.colNum; j++)
+          ci[j] += a_ki * b_k[j];
+      }
+    }
+  }
+}
+
 /*!
   \warning This function is provided for compat with previous releases. You
   should rather use the functionalities provided in vpRotationMatrix class.
@@ -3820,6 +3940,91 @@ unsigned int vpMatrix::pseudoInverse(vpMatrix &Ap, vpColVector &sv, double svThr
 #endif
 }
 
+/*!
+  Compute the Moore-Penros pseudo inverse \f$A^+\f$ of a m-by-n matrix \f$\bf
+  A\f$ using the built-in Jacobi singular value decomposition svdJacobi(),
+  the decomposition buffers being kept in \e workspace.
+
+  Once the workspace has been used with a matrix of the same size, and \e Ap
+  has the right size, this function does not allocate any memory. It is
+  intended to the iterative solvers that compute the pseudo inverse of a small
+  matrix at each iteration.
+
+  \param Ap : The Moore-Penros pseudo inverse \f$ A^+ \f$.
+
+  \param workspace : Buffers reused from one call to the next. The singular
+  values of the matrix are available with
+  vpMatrixWorkspace::getSingularValues() after the call.
+
+  \param svThreshold : Threshold used to test the singular values. If
+  a singular value is lower than this threshold we consider that the
+  matrix is not full rank.
+
+  \return The rank of the matrix.
+
+  \code
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixWorkspace.h>
+
+int main()
+{
+  vpMatrix A(2, 3), A_p;
+  vpMatrixWorkspace workspace;
+
+  A[0][0] = 2; A[0][1] = 3; A[0][2] = 5;
+  A[1][0] = -4; A[1][1] = 2; A[1][2] = 3;
+
+  unsigned int rank = A.pseudoInverse(A_p, workspace);
+  std::cout << "Rank: " << rank << std::endl;
+  A_p.print(std::cout, 10, "A^+ (pseudo-inverse): ");
+}
+  \endcode
+
+  \sa pseudoInverse(vpMatrix &, double) const, svdJacobi()
+*/
+unsigned int vpMatrix::pseudoInverse(vpMatrix &Ap, vpMatrixWorkspace &workspace, double svThreshold) const
+{
+  // The decomposition is done on the tallest of A and A^T
+  const bool transposed = rowNum < colNum;
+  vpMatrix &U = workspace.m_U;
+  vpMatrix &V = workspace.m_V;
+  vpColVector &sv = workspace.m_sv;
+  if (transposed) {
+    transpose(U);
+  } else {
+    U = *this;
+  }
+  U.svdJacobi(sv, V);
+
+  const unsigned int nsv = sv.getRows();
+  const double threshold = (nsv > 0 ? sv[0] : 0.0) * svThreshold;
+  unsigned int rank = 0;
+  while (rank < nsv && sv[rank] > threshold) {
+    rank++;
+  }
+
+  // A = U S V^T gives A^+ = V S^-1 U^T, and A^T = U S V^T gives A^+ = U S^-1 V^T
+  const vpMatrix &left = transposed ? U : V;
+  const vpMatrix &right = transposed ? V : U;
+  if (Ap.getRows() != colNum || Ap.getCols() != rowNum) {
+    Ap.resize(colNum, rowNum, false, false);
+  }
+  for (unsigned int i = 0; i < colNum; i++) {
+    const double *left_i = left[i];
+    double *Ap_i = Ap[i];
+    for (unsigned int j = 0; j < rowNum; j++) {
+      const double *right_j = right[j];
+      double s = 0;
+      for (unsigned int k = 0; k < rank; k++) {
+        s += left_i[k] * right_j[k] / sv[k];
+      }
+      Ap_i[j] = s;
+    }
+  }
+
+  return rank;
+}
+
 /*!
   Extract a column vector from a matrix.
   \warning All the indexes start from 0 in this function.
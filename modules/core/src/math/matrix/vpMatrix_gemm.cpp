@@ -0,0 +1,509 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Built-in blocked matrix products used when Blas/Lapack is not available.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpConfig.h>
+#include <visp3/core/vpMatrix.h>
+
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
+
+#if defined __AVX__
+#include <immintrin.h>
+#define VISP_HAVE_AVX 1
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#define VISP_HAVE_NEON 1
+#endif
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+namespace
+{
+/*
+  Panel-packed matrix product in the spirit of GotoBLAS/BLIS.
+
+  The operands are copied by blocks of gemm_kc depths into contiguous
+  micro-panels: gemm_mr rows of A and gemm_nr columns of B interleaved along the
+  depth, padded with zeros. The micro-kernel then streams both panels and keeps
+  the gemm_mr x gemm_nr block of C in registers. The block sizes are chosen so
+  that a packed panel of B stays in L1 and a packed block of A in L2.
+*/
+const unsigned int gemm_mr = 4;
+const unsigned int gemm_nr = 8;
+const unsigned int gemm_kc = 256;
+const unsigned int gemm_mc = 128;
+const unsigned int gemm_nc = 2048;
+// Up to this size, symmetric products are computed without packing
+const unsigned int syrk_stream_max_size = 12;
+// Packed blocks up to this number of elements are kept on the stack, so that
+// the narrow products of the iterative solvers do not allocate memory
+const unsigned int gemm_stack_size = 2048;
+
+// Copy a mc x kc block of A, element (i, k) being at a[i * rs + k * cs]
+void packA(unsigned int mc, unsigned int kc, const double *a, size_t rs, size_t cs, double *buf)
+{
+  for (unsigned int i = 0; i < mc; i += gemm_mr) {
+    const unsigned int mr = std::min(gemm_mr, mc - i);
+    const double *a_i = a + i * rs;
+    for (unsigned int k = 0; k < kc; k++) {
+      const double *src = a_i + k * cs;
+      unsigned int r = 0;
+      for (; r < mr; r++) {
+        *buf++ = src[r * rs];
+      }
+      for (; r < gemm_mr; r++) {
+        *buf++ = 0.0;
+      }
+    }
+  }
+}
+
+// Copy a kc x nc block of B, element (k, j) being at b[k * rs + j * cs]
+void packB(unsigned int kc, unsigned int nc, const double *b, size_t rs, size_t cs, double *buf)
+{
+  for (unsigned int j = 0; j < nc; j += gemm_nr) {
+    const unsigned int nr = std::min(gemm_nr, nc - j);
+    const double *b_j = b + j * cs;
+    for (unsigned int k = 0; k < kc; k++) {
+      const double *src = b_j + k * rs;
+      unsigned int c = 0;
+      if (cs == 1) {
+        for (; c < nr; c++) {
+          *buf++ = src[c];
+        }
+      } else {
+        for (; c < nr; c++) {
+          *buf++ = src[c * cs];
+        }
+      }
+      for (; c < gemm_nr; c++) {
+        *buf++ = 0.0;
+      }
+    }
+  }
+}
+
+// ab = sum over k of the outer products of the packed micro-panels (row-major gemm_mr x gemm_nr)
+void kernelGeneric(unsigned int kc, const double *a, const double *b, double *ab)
+{
+  double acc[gemm_mr * gemm_nr];
+  std::fill(acc, acc + gemm_mr * gemm_nr, 0.0);
+  for (unsigned int k = 0; k < kc; k++, a += gemm_mr, b += gemm_nr) {
+    for (unsigned int r = 0; r < gemm_mr; r++) {
+      for (unsigned int c = 0; c < gemm_nr; c++) {
+        acc[r * gemm_nr + c] += a[r] * b[c];
+      }
+    }
+  }
+  std::copy(acc, acc + gemm_mr * gemm_nr, ab);
+}
+
+#if VISP_HAVE_AVX
+#if defined __FMA__
+#define VP_GEMM_AVX_MADD(acc, x, y) acc = _mm256_fmadd_pd(x, y, acc)
+#else
+#define VP_GEMM_AVX_MADD(acc, x, y) acc = _mm256_add_pd(acc, _mm256_mul_pd(x, y))
+#endif
+void kernelAVX(unsigned int kc, const double *a, const double *b, double *ab)
+{
+  __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+  __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+  __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+  __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+  for (unsigned int k = 0; k < kc; k++, a += gemm_mr, b += gemm_nr) {
+    const __m256d b0 = _mm256_loadu_pd(b);
+    const __m256d b1 = _mm256_loadu_pd(b + 4);
+
+    __m256d ar = _mm256_broadcast_sd(a);
+    VP_GEMM_AVX_MADD(c00, ar, b0);
+    VP_GEMM_AVX_MADD(c01, ar, b1);
+    ar = _mm256_broadcast_sd(a + 1);
+    VP_GEMM_AVX_MADD(c10, ar, b0);
+    VP_GEMM_AVX_MADD(c11, ar, b1);
+    ar = _mm256_broadcast_sd(a + 2);
+    VP_GEMM_AVX_MADD(c20, ar, b0);
+    VP_GEMM_AVX_MADD(c21, ar, b1);
+    ar = _mm256_broadcast_sd(a + 3);
+    VP_GEMM_AVX_MADD(c30, ar, b0);
+    VP_GEMM_AVX_MADD(c31, ar, b1);
+  }
+
+  _mm256_storeu_pd(ab, c00);
+  _mm256_storeu_pd(ab + 4, c01);
+  _mm256_storeu_pd(ab + 8, c10);
+  _mm256_storeu_pd(ab + 12, c11);
+  _mm256_storeu_pd(ab + 16, c20);
+  _mm256_storeu_pd(ab + 20, c21);
+  _mm256_storeu_pd(ab + 24, c30);
+  _mm256_storeu_pd(ab + 28, c31);
+}
+#undef VP_GEMM_AVX_MADD
+#endif
+
+#if VISP_HAVE_SSE2
+// The 4x8 block of C is processed in two 4x4 halves to stay within the 16 xmm registers
+void kernelSSE2(unsigned int kc, const double *a, const double *b, double *ab)
+{
+  for (unsigned int half = 0; half < 2; half++) {
+    const double *pa = a;
+    const double *pb = b + 4 * half;
+    __m128d c00 = _mm_setzero_pd(), c01 = _mm_setzero_pd();
+    __m128d c10 = _mm_setzero_pd(), c11 = _mm_setzero_pd();
+    __m128d c20 = _mm_setzero_pd(), c21 = _mm_setzero_pd();
+    __m128d c30 = _mm_setzero_pd(), c31 = _mm_setzero_pd();
+
+    for (unsigned int k = 0; k < kc; k++, pa += gemm_mr, pb += gemm_nr) {
+      const __m128d b0 = _mm_loadu_pd(pb);
+      const __m128d b1 = _mm_loadu_pd(pb + 2);
+
+      __m128d ar = _mm_set1_pd(pa[0]);
+      c00 = _mm_add_pd(c00, _mm_mul_pd(ar, b0));
+      c01 = _mm_add_pd(c01, _mm_mul_pd(ar, b1));
+      ar = _mm_set1_pd(pa[1]);
+      c10 = _mm_add_pd(c10, _mm_mul_pd(ar, b0));
+      c11 = _mm_add_pd(c11, _mm_mul_pd(ar, b1));
+      ar = _mm_set1_pd(pa[2]);
+      c20 = _mm_add_pd(c20, _mm_mul_pd(ar, b0));
+      c21 = _mm_add_pd(c21, _mm_mul_pd(ar, b1));
+      ar = _mm_set1_pd(pa[3]);
+      c30 = _mm_add_pd(c30, _mm_mul_pd(ar, b0));
+      c31 = _mm_add_pd(c31, _mm_mul_pd(ar, b1));
+    }
+
+    double *pab = ab + 4 * half;
+    _mm_storeu_pd(pab, c00);
+    _mm_storeu_pd(pab + 2, c01);
+    _mm_storeu_pd(pab + 8, c10);
+    _mm_storeu_pd(pab + 10, c11);
+    _mm_storeu_pd(pab + 16, c20);
+    _mm_storeu_pd(pab + 18, c21);
+    _mm_storeu_pd(pab + 24, c30);
+    _mm_storeu_pd(pab + 26, c31);
+  }
+}
+#endif
+
+#if VISP_HAVE_NEON
+void kernelNEON(unsigned int kc, const double *a, const double *b, double *ab)
+{
+  float64x2_t c[gemm_mr][4];
+  for (unsigned int r = 0; r < gemm_mr; r++) {
+    for (unsigned int c_ = 0; c_ < 4; c_++) {
+      c[r][c_] = vdupq_n_f64(0.0);
+    }
+  }
+
+  for (unsigned int k = 0; k < kc; k++, a += gemm_mr, b += gemm_nr) {
+    const float64x2_t b0 = vld1q_f64(b);
+    const float64x2_t b1 = vld1q_f64(b + 2);
+    const float64x2_t b2 = vld1q_f64(b + 4);
+    const float64x2_t b3 = vld1q_f64(b + 6);
+    const float64x2_t a01 = vld1q_f64(a);
+    const float64x2_t a23 = vld1q_f64(a + 2);
+
+    c[0][0] = vfmaq_laneq_f64(c[0][0], b0, a01, 0);
+    c[0][1] = vfmaq_laneq_f64(c[0][1], b1, a01, 0);
+    c[0][2] = vfmaq_laneq_f64(c[0][2], b2, a01, 0);
+    c[0][3] = vfmaq_laneq_f64(c[0][3], b3, a01, 0);
+    c[1][0] = vfmaq_laneq_f64(c[1][0], b0, a01, 1);
+    c[1][1] = vfmaq_laneq_f64(c[1][1], b1, a01, 1);
+    c[1][2] = vfmaq_laneq_f64(c[1][2], b2, a01, 1);
+    c[1][3] = vfmaq_laneq_f64(c[1][3], b3, a01, 1);
+    c[2][0] = vfmaq_laneq_f64(c[2][0], b0, a23, 0);
+    c[2][1] = vfmaq_laneq_f64(c[2][1], b1, a23, 0);
+    c[2][2] = vfmaq_laneq_f64(c[2][2], b2, a23, 0);
+    c[2][3] = vfmaq_laneq_f64(c[2][3], b3, a23, 0);
+    c[3][0] = vfmaq_laneq_f64(c[3][0], b0, a23, 1);
+    c[3][1] = vfmaq_laneq_f64(c[3][1], b1, a23, 1);
+    c[3][2] = vfmaq_laneq_f64(c[3][2], b2, a23, 1);
+    c[3][3] = vfmaq_laneq_f64(c[3][3], b3, a23, 1);
+  }
+
+  for (unsigned int r = 0; r < gemm_mr; r++) {
+    for (unsigned int c_ = 0; c_ < 4; c_++) {
+      vst1q_f64(ab + r * gemm_nr + 2 * c_, c[r][c_]);
+    }
+  }
+}
+#endif
+
+typedef void (*vpGemmKernel)(unsigned int, const double *, const double *, double *);
+
+vpGemmKernel selectKernel()
+{
+#if VISP_HAVE_AVX
+  if (vpCPUFeatures::checkAVX()) {
+    return kernelAVX;
+  }
+#endif
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    return kernelSSE2;
+  }
+#endif
+#if VISP_HAVE_NEON
+  return kernelNEON;
+#else
+  return kernelGeneric;
+#endif
+}
+
+// Dot products of 4 consecutive rows of A with x
+void dot4Rows(unsigned int n, const double *a0, size_t lda, const double *x, double *y)
+{
+  const double *a1 = a0 + lda, *a2 = a1 + lda, *a3 = a2 + lda;
+  unsigned int j = 0;
+  double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2() && n >= 2) {
+    __m128d v0 = _mm_setzero_pd(), v1 = _mm_setzero_pd(), v2 = _mm_setzero_pd(), v3 = _mm_setzero_pd();
+    for (; j + 2 <= n; j += 2) {
+      const __m128d xj = _mm_loadu_pd(x + j);
+      v0 = _mm_add_pd(v0, _mm_mul_pd(_mm_loadu_pd(a0 + j), xj));
+      v1 = _mm_add_pd(v1, _mm_mul_pd(_mm_loadu_pd(a1 + j), xj));
+      v2 = _mm_add_pd(v2, _mm_mul_pd(_mm_loadu_pd(a2 + j), xj));
+      v3 = _mm_add_pd(v3, _mm_mul_pd(_mm_loadu_pd(a3 + j), xj));
+    }
+    double tmp[2];
+    _mm_storeu_pd(tmp, v0);
+    s0 = tmp[0] + tmp[1];
+    _mm_storeu_pd(tmp, v1);
+    s1 = tmp[0] + tmp[1];
+    _mm_storeu_pd(tmp, v2);
+    s2 = tmp[0] + tmp[1];
+    _mm_storeu_pd(tmp, v3);
+    s3 = tmp[0] + tmp[1];
+  }
+#elif VISP_HAVE_NEON
+  if (n >= 2) {
+    float64x2_t v0 = vdupq_n_f64(0.0), v1 = vdupq_n_f64(0.0), v2 = vdupq_n_f64(0.0), v3 = vdupq_n_f64(0.0);
+    for (; j + 2 <= n; j += 2) {
+      const float64x2_t xj = vld1q_f64(x + j);
+      v0 = vfmaq_f64(v0, vld1q_f64(a0 + j), xj);
+      v1 = vfmaq_f64(v1, vld1q_f64(a1 + j), xj);
+      v2 = vfmaq_f64(v2, vld1q_f64(a2 + j), xj);
+      v3 = vfmaq_f64(v3, vld1q_f64(a3 + j), xj);
+    }
+    s0 = vaddvq_f64(v0);
+    s1 = vaddvq_f64(v1);
+    s2 = vaddvq_f64(v2);
+    s3 = vaddvq_f64(v3);
+  }
+#endif
+  for (; j < n; j++) {
+    s0 += a0[j] * x[j];
+    s1 += a1[j] * x[j];
+    s2 += a2[j] * x[j];
+    s3 += a3[j] * x[j];
+  }
+  y[0] = s0;
+  y[1] = s1;
+  y[2] = s2;
+  y[3] = s3;
+}
+} // namespace
+
+/*
+  Compute C = A * B where A is M x K, B is K x N and C is a row-major M x N
+  matrix with a leading dimension ldc. Element (i, k) of A is at
+  a_data[i * a_rs + k * a_cs] and element (k, j) of B at b_data[k * b_rs + j *
+  b_cs], which allows to multiply transposed operands without copying them.
+
+  If upper is true, only the blocks of C that intersect the upper triangle are
+  computed (used for symmetric products).
+*/
+void vpMatrix::builtin_dgemm(unsigned int M, unsigned int N, unsigned int K, const double *a_data, unsigned int a_rs,
+                             unsigned int a_cs, const double *b_data, unsigned int b_rs, unsigned int b_cs,
+                             double *c_data, unsigned int ldc, bool upper)
+{
+  if (M == 0 || N == 0) {
+    return;
+  }
+  if (K == 0) {
+    for (unsigned int i = 0; i < M; i++) {
+      std::fill(c_data + static_cast<size_t>(i) * ldc, c_data + static_cast<size_t>(i) * ldc + N, 0.0);
+    }
+    return;
+  }
+
+  const vpGemmKernel kernel = selectKernel();
+  const unsigned int kc_max = std::min(K, gemm_kc);
+  const unsigned int mc_max = std::min(((M + gemm_mr - 1) / gemm_mr) * gemm_mr, gemm_mc);
+  const unsigned int nc_max = std::min(((N + gemm_nr - 1) / gemm_nr) * gemm_nr, gemm_nc);
+  const size_t sizeA = static_cast<size_t>(mc_max) * kc_max, sizeB = static_cast<size_t>(nc_max) * kc_max;
+  double stackA[gemm_stack_size], stackB[gemm_stack_size];
+  std::vector<double> heapA(sizeA > gemm_stack_size ? sizeA : 0), heapB(sizeB > gemm_stack_size ? sizeB : 0);
+  double *const bufA = sizeA > gemm_stack_size ? &heapA[0] : stackA;
+  double *const bufB = sizeB > gemm_stack_size ? &heapB[0] : stackB;
+  double ab[gemm_mr * gemm_nr];
+
+  for (unsigned int jc = 0; jc < N; jc += gemm_nc) {
+    const unsigned int nc = std::min(gemm_nc, N - jc);
+
+    for (unsigned int pc = 0; pc < K; pc += gemm_kc) {
+      const unsigned int kc = std::min(gemm_kc, K - pc);
+      const bool first = (pc == 0);
+      packB(kc, nc, b_data + static_cast<size_t>(pc) * b_rs + static_cast<size_t>(jc) * b_cs, b_rs, b_cs, bufB);
+
+      for (unsigned int ic = 0; ic < M; ic += gemm_mc) {
+        if (upper && ic >= jc + nc) {
+          break;
+        }
+        const unsigned int mc = std::min(gemm_mc, M - ic);
+        packA(mc, kc, a_data + static_cast<size_t>(ic) * a_rs + static_cast<size_t>(pc) * a_cs, a_rs, a_cs,
+              bufA);
+
+        for (unsigned int jr = 0; jr < nc; jr += gemm_nr) {
+          const unsigned int nr = std::min(gemm_nr, nc - jr);
+
+          for (unsigned int ir = 0; ir < mc; ir += gemm_mr) {
+            if (upper && ic + ir >= jc + jr + nr) {
+              break;
+            }
+            const unsigned int mr = std::min(gemm_mr, mc - ir);
+            kernel(kc, bufA + static_cast<size_t>(ir) * kc, bufB + static_cast<size_t>(jr) * kc, ab);
+
+            double *c_ij = c_data + static_cast<size_t>(ic + ir) * ldc + jc + jr;
+            for (unsigned int r = 0; r < mr; r++, c_ij += ldc) {
+              const double *ab_r = ab + r * gemm_nr;
+              if (first) {
+                for (unsigned int c = 0; c < nr; c++) {
+                  c_ij[c] = ab_r[c];
+                }
+              } else {
+                for (unsigned int c = 0; c < nr; c++) {
+                  c_ij[c] += ab_r[c];
+                }
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+/*
+  Compute the symmetric N x N matrix C = X^T * X where X is K x N, element
+  (k, j) of X being at x_data[k * x_rs + j * x_cs]. Only the upper triangle is
+  computed and then mirrored.
+
+  Narrow products such as the J^T J of the 6 columns Jacobians used in the
+  virtual visual servoing loops do not benefit from packing: the rows of X are
+  rather streamed once, accumulating their outer products in the small upper
+  triangle of C that stays in L1. This path expects the rows of X to be
+  contiguous (x_cs = 1).
+*/
+void vpMatrix::builtin_dsyrk(unsigned int N, unsigned int K, const double *x_data, unsigned int x_rs,
+                             unsigned int x_cs, double *c_data, unsigned int ldc)
+{
+  if (N <= syrk_stream_max_size) {
+    double acc[syrk_stream_max_size * syrk_stream_max_size];
+    std::fill(acc, acc + N * N, 0.0);
+    // Four rows are accumulated at once to amortize the loads and stores of C
+    double x_k[4][syrk_stream_max_size];
+    unsigned int k = 0;
+    for (; k + 4 <= K; k += 4) {
+      for (unsigned int r = 0; r < 4; r++) {
+        const double *src = x_data + static_cast<size_t>(k + r) * x_rs;
+        for (unsigned int j = 0; j < N; j++) {
+          x_k[r][j] = src[j * x_cs];
+        }
+      }
+      for (unsigned int i = 0; i < N; i++) {
+        const double x0 = x_k[0][i], x1 = x_k[1][i], x2 = x_k[2][i], x3 = x_k[3][i];
+        double *acc_i = acc + i * N;
+        for (unsigned int j = i; j < N; j++) {
+          acc_i[j] += x0 * x_k[0][j] + x1 * x_k[1][j] + x2 * x_k[2][j] + x3 * x_k[3][j];
+        }
+      }
+    }
+    for (; k < K; k++) {
+      const double *src = x_data + static_cast<size_t>(k) * x_rs;
+      for (unsigned int i = 0; i < N; i++) {
+        const double x_ki = src[i * x_cs];
+        double *acc_i = acc + i * N;
+        for (unsigned int j = i; j < N; j++) {
+          acc_i[j] += x_ki * src[j * x_cs];
+        }
+      }
+    }
+    for (unsigned int i = 0; i < N; i++) {
+      std::copy(acc + i * N + i, acc + (i + 1) * N, c_data + static_cast<size_t>(i) * ldc + i);
+    }
+  } else {
+    builtin_dgemm(N, N, K, x_data, x_cs, x_rs, x_data, x_rs, x_cs, c_data, ldc, true);
+  }
+
+  for (unsigned int i = 1; i < N; i++) {
+    double *c_i = c_data + static_cast<size_t>(i) * ldc;
+    for (unsigned int j = 0; j < i; j++) {
+      c_i[j] = c_data[static_cast<size_t>(j) * ldc + i];
+    }
+  }
+}
+
+/*
+  Compute y = A * x where A is a row-major M x N matrix with a leading
+  dimension lda. Rows are processed four at a time so that x is loaded once for
+  four dot products.
+*/
+void vpMatrix::builtin_dgemv(unsigned int M, unsigned int N, const double *a_data, unsigned int lda,
+                             const double *x_data, double *y_data)
+{
+  unsigned int i = 0;
+  for (; i + 4 <= M; i += 4) {
+    dot4Rows(N, a_data + static_cast<size_t>(i) * lda, lda, x_data, y_data + i);
+  }
+  for (; i < M; i++) {
+    const double *a_i = a_data + static_cast<size_t>(i) * lda;
+    double s = 0.0;
+    for (unsigned int j = 0; j < N; j++) {
+      s += a_i[j] * x_data[j];
+    }
+    y_data[i] = s;
+  }
+}
+
+#endif // #ifndef DOXYGEN_SHOULD_SKIP_THIS
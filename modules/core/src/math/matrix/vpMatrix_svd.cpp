@@ -44,7 +44,8 @@
 #include <visp3/core/vpMatrix.h>
 #include <visp3/core/vpMatrixException.h>
 
-#include <cmath> // std::fabs
+#include <algorithm> // std::swap
+#include <cmath>     // std::fabs
 #include <iostream>
 #include <limits> // numeric_limits
 
@@ -428,3 +429,127 @@ void vpMatrix::svdEigen3(vpColVector &w, vpMatrix &V)
   U_ = svd.matrixU();
 }
 #endif
+
+/*!
+
+  Singular value decomposition (SVD) using the built-in one-sided Jacobi
+  algorithm, that does not need any 3rd party.
+
+  Given matrix \f$M\f$, this function computes it singular value decomposition
+  such as
+
+  \f[ M = U \Sigma V^{\top} \f]
+
+  The columns of the matrix are orthogonalized by plane rotations that are also
+  accumulated in \f$ V \f$. The algorithm is accurate, even for small singular
+  values, and well suited to the small matrices of the pose estimation loops.
+  For large matrices, svd() that relies on optimized 3rd parties should rather
+  be used.
+
+  No memory is allocated when \e w and \e V already have the right size, which
+  allows to use this function in loops without allocation.
+
+  \warning This method is destructive wrt. to the matrix \f$ M \f$ to
+  decompose. You should make a COPY of that matrix if needed.
+
+  \param w : Vector of singular values: \f$ \Sigma = diag(w) \f$.
+
+  \param V : Matrix \f$ V \f$.
+
+  \note The singular values are ordered in decreasing
+  fashion in \e w. It means that the highest singular value is in \e w[0].
+  When the matrix has less rows than columns, the columns of \f$ U \f$ that
+  correspond to null singular values are set to zero.
+
+  \sa svd(), pseudoInverse(vpMatrix &, vpMatrixWorkspace &, double) const
+*/
+void vpMatrix::svdJacobi(vpColVector &w, vpMatrix &V)
+{
+  const unsigned int nrows = rowNum;
+  const unsigned int ncols = colNum;
+  const unsigned int max_sweeps = 60;
+  const double eps = std::numeric_limits<double>::epsilon();
+
+  if (w.getRows() != ncols) {
+    w.resize(ncols, false);
+  }
+  if (V.getRows() != ncols || V.getCols() != ncols) {
+    V.resize(ncols, ncols, false, false);
+  }
+  V.eye();
+
+  for (unsigned int sweep = 0; sweep < max_sweeps; sweep++) {
+    bool rotated = false;
+
+    for (unsigned int p = 0; p + 1 < ncols; p++) {
+      for (unsigned int q = p + 1; q < ncols; q++) {
+        double alpha = 0, beta = 0, gamma = 0;
+        for (unsigned int i = 0; i < nrows; i++) {
+          const double a_ip = rowPtrs[i][p], a_iq = rowPtrs[i][q];
+          alpha += a_ip * a_ip;
+          beta += a_iq * a_iq;
+          gamma += a_ip * a_iq;
+        }
+
+        // Skip the pairs of columns that are already orthogonal
+        if (std::fabs(gamma) <= eps * std::sqrt(alpha * beta)) {
+          continue;
+        }
+        rotated = true;
+
+        const double zeta = (beta - alpha) / (2.0 * gamma);
+        const double t = (zeta >= 0 ? 1.0 : -1.0) / (std::fabs(zeta) + std::sqrt(1.0 + zeta * zeta));
+        const double c = 1.0 / std::sqrt(1.0 + t * t);
+        const double s = c * t;
+
+        for (unsigned int i = 0; i < nrows; i++) {
+          const double a_ip = rowPtrs[i][p], a_iq = rowPtrs[i][q];
+          rowPtrs[i][p] = c * a_ip - s * a_iq;
+          rowPtrs[i][q] = s * a_ip + c * a_iq;
+        }
+        for (unsigned int i = 0; i < ncols; i++) {
+          const double v_ip = V[i][p], v_iq = V[i][q];
+          V[i][p] = c * v_ip - s * v_iq;
+          V[i][q] = s * v_ip + c * v_iq;
+        }
+      }
+    }
+
+    if (!rotated) {
+      break;
+    }
+  }
+
+  // The singular values are the norms of the orthogonalized columns
+  for (unsigned int j = 0; j < ncols; j++) {
+    double norm = 0;
+    for (unsigned int i = 0; i < nrows; i++) {
+      norm += rowPtrs[i][j] * rowPtrs[i][j];
+    }
+    norm = std::sqrt(norm);
+    w[j] = norm;
+    const double inv_norm = norm > 0 ? 1.0 / norm : 0.0;
+    for (unsigned int i = 0; i < nrows; i++) {
+      rowPtrs[i][j] *= inv_norm;
+    }
+  }
+
+  // Sort in decreasing order, swapping the columns of U and V accordingly
+  for (unsigned int j = 0; j + 1 < ncols; j++) {
+    unsigned int j_max = j;
+    for (unsigned int k = j + 1; k < ncols; k++) {
+      if (w[k] > w[j_max]) {
+        j_max = k;
+      }
+    }
+    if (j_max != j) {
+      std::swap(w[j], w[j_max]);
+      for (unsigned int i = 0; i < nrows; i++) {
+        std::swap(rowPtrs[i][j], rowPtrs[i][j_max]);
+      }
+      for (unsigned int i = 0; i < ncols; i++) {
+        std::swap(V[i][j], V[i][j_max]);
+      }
+    }
+  }
+}
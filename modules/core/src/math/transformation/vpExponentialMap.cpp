@@ -38,6 +38,7 @@
  *****************************************************************************/
 
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpMatrixFixed.h>
 
 /*!
 
@@ -77,6 +78,31 @@ vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v) { return vpEx
   \sa inverse(const vpHomogeneousMatrix &, const double &)
 */
 vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v, const double &delta_t)
+{
+  vpHomogeneousMatrix Delta;
+  vpExponentialMap::direct(v, delta_t, Delta);
+  return Delta;
+}
+
+/*!
+
+  Compute the exponential map in an existing homogeneous matrix, which avoids
+  any memory allocation. The inverse function is inverse().
+
+  \param v : Instantaneous velocity skew represented by a 6 dimension
+  vector \f$ {\bf v} = [v, \omega] \f$ where \f$ v \f$ is a translation
+  velocity vector and \f$ \omega \f$ is a rotation velocity vector.
+
+  \param delta_t : Sampling time \f$ \Delta t \f$. Time during which the
+  velocity \f$ \bf v \f$ is applied.
+
+  \param Delta : Homogeneous matrix \f${\bf M} = \exp{({\bf v})} \f$,
+  the displacement of the object when the velocity \f$ \bf v \f$ is applied
+  during \f$\Delta t\f$ seconds.
+
+  \sa direct(const vpColVector &, const double &)
+*/
+void vpExponentialMap::direct(const vpColVector &v, const double &delta_t, vpHomogeneousMatrix &Delta)
 {
   if (v.size() != 6) {
     throw(vpException(vpException::dimensionError,
@@ -84,16 +110,11 @@ vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v, const double
                       v.size()));
   }
   double theta, si, co, sinc, mcosc, msinc;
-  vpThetaUVector u;
-  vpRotationMatrix rd;
-  vpTranslationVector dt;
-
-  vpColVector v_dt = v * delta_t;
 
-  u[0] = v_dt[3];
-  u[1] = v_dt[4];
-  u[2] = v_dt[5];
-  rd.buildFrom(u);
+  // Everything is computed on the stack
+  vpMatrixFixed<6, 1> v_dt(v.data);
+  v_dt *= delta_t;
+  const double *u = v_dt.data + 3;
 
   theta = sqrt(u[0] * u[0] + u[1] * u[1] + u[2] * u[2]);
   si = sin(theta);
@@ -102,87 +123,30 @@ vpHomogeneousMatrix vpExponentialMap::direct(const vpColVector &v, const double
   mcosc = vpMath::mcosc(co, theta);
   msinc = vpMath::msinc(si, theta);
 
-  dt[0] = v_dt[0] * (sinc + u[0] * u[0] * msinc) + v_dt[1] * (u[0] * u[1] * msinc - u[2] * mcosc) +
-          v_dt[2] * (u[0] * u[2] * msinc + u[1] * mcosc);
-
-  dt[1] = v_dt[0] * (u[0] * u[1] * msinc + u[2] * mcosc) + v_dt[1] * (sinc + u[1] * u[1] * msinc) +
-          v_dt[2] * (u[1] * u[2] * msinc - u[0] * mcosc);
-
-  dt[2] = v_dt[0] * (u[0] * u[2] * msinc - u[1] * mcosc) + v_dt[1] * (u[1] * u[2] * msinc + u[0] * mcosc) +
-          v_dt[2] * (sinc + u[2] * u[2] * msinc);
-
-  vpHomogeneousMatrix Delta;
-  Delta.insert(rd);
-  Delta.insert(dt);
-
-  if (0) // test new version wrt old version
-  {
-    // old version
-    unsigned int i, j;
-
-    double s;
-    // double u[3];
-    //  vpRotationMatrix rd ;
-    //  vpTranslationVector dt ;
-
-    s = sqrt(v_dt[3] * v_dt[3] + v_dt[4] * v_dt[4] + v_dt[5] * v_dt[5]);
-    if (s > 1.e-15) {
-      for (i = 0; i < 3; i++)
-        u[i] = v_dt[3 + i] / s;
-      double sinu = sin(s);
-      double cosi = cos(s);
-      double mcosi = 1 - cosi;
-      rd[0][0] = cosi + mcosi * u[0] * u[0];
-      rd[0][1] = -sinu * u[2] + mcosi * u[0] * u[1];
-      rd[0][2] = sinu * u[1] + mcosi * u[0] * u[2];
-      rd[1][0] = sinu * u[2] + mcosi * u[1] * u[0];
-      rd[1][1] = cosi + mcosi * u[1] * u[1];
-      rd[1][2] = -sinu * u[0] + mcosi * u[1] * u[2];
-      rd[2][0] = -sinu * u[1] + mcosi * u[2] * u[0];
-      rd[2][1] = sinu * u[0] + mcosi * u[2] * u[1];
-      rd[2][2] = cosi + mcosi * u[2] * u[2];
-
-      dt[0] = v_dt[0] * (sinu / s + u[0] * u[0] * (1 - sinu / s)) +
-              v_dt[1] * (u[0] * u[1] * (1 - sinu / s) - u[2] * mcosi / s) +
-              v_dt[2] * (u[0] * u[2] * (1 - sinu / s) + u[1] * mcosi / s);
-
-      dt[1] = v_dt[0] * (u[0] * u[1] * (1 - sinu / s) + u[2] * mcosi / s) +
-              v_dt[1] * (sinu / s + u[1] * u[1] * (1 - sinu / s)) +
-              v_dt[2] * (u[1] * u[2] * (1 - sinu / s) - u[0] * mcosi / s);
-
-      dt[2] = v_dt[0] * (u[0] * u[2] * (1 - sinu / s) - u[1] * mcosi / s) +
-              v_dt[1] * (u[1] * u[2] * (1 - sinu / s) + u[0] * mcosi / s) +
-              v_dt[2] * (sinu / s + u[2] * u[2] * (1 - sinu / s));
-    } else {
-      for (i = 0; i < 3; i++) {
-        for (j = 0; j < 3; j++)
-          rd[i][j] = 0.0;
-        rd[i][i] = 1.0;
-        dt[i] = v_dt[i];
-      }
-    }
-    // end old version
-
-    // Test of the new version
-    vpHomogeneousMatrix Delta_old;
-    Delta_old.insert(rd);
-    Delta_old.insert(dt);
-
-    int pb = 0;
-    for (i = 0; i < 4; i++) {
-      for (j = 0; j < 4; j++)
-        if (fabs(Delta[i][j] - Delta_old[i][j]) > 1.e-5)
-          pb = 1;
-    }
-    if (pb == 1) {
-      printf("pb vpHomogeneousMatrix::expMap\n");
-      std::cout << " Delta : " << std::endl << Delta << std::endl;
-      std::cout << " Delta_old : " << std::endl << Delta_old << std::endl;
-    }
-    // end of the test
-  }
-
-  return Delta;
+  // Rotation from the theta u vector, as in vpRotationMatrix::buildFrom(const vpThetaUVector &)
+  Delta[0][0] = co + mcosc * u[0] * u[0];
+  Delta[0][1] = -sinc * u[2] + mcosc * u[0] * u[1];
+  Delta[0][2] = sinc * u[1] + mcosc * u[0] * u[2];
+  Delta[1][0] = sinc * u[2] + mcosc * u[1] * u[0];
+  Delta[1][1] = co + mcosc * u[1] * u[1];
+  Delta[1][2] = -sinc * u[0] + mcosc * u[1] * u[2];
+  Delta[2][0] = -sinc * u[1] + mcosc * u[2] * u[0];
+  Delta[2][1] = sinc * u[0] + mcosc * u[2] * u[1];
+  Delta[2][2] = co + mcosc * u[2] * u[2];
+
+  Delta[0][3] = v_dt[0][0] * (sinc + u[0] * u[0] * msinc) + v_dt[1][0] * (u[0] * u[1] * msinc - u[2] * mcosc) +
+                v_dt[2][0] * (u[0] * u[2] * msinc + u[1] * mcosc);
+
+  Delta[1][3] = v_dt[0][0] * (u[0] * u[1] * msinc + u[2] * mcosc) + v_dt[1][0] * (sinc + u[1] * u[1] * msinc) +
+                v_dt[2][0] * (u[1] * u[2] * msinc - u[0] * mcosc);
+
+  Delta[2][3] = v_dt[0][0] * (u[0] * u[2] * msinc - u[1] * mcosc) + v_dt[1][0] * (u[1] * u[2] * msinc + u[0] * mcosc) +
+                v_dt[2][0] * (sinc + u[2] * u[2] * msinc);
+
+  Delta[3][0] = 0.;
+  Delta[3][1] = 0.;
+  Delta[3][2] = 0.;
+  Delta[3][3] = 1.;
 }
 
 /*!
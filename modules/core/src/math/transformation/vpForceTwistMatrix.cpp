@@ -43,6 +43,7 @@
 #include <visp3/core/vpDebug.h>
 #include <visp3/core/vpException.h>
 #include <visp3/core/vpForceTwistMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
 
 /*!
   \file vpForceTwistMatrix.cpp
@@ -397,7 +398,14 @@ vpColVector vpForceTwistMatrix::operator*(const vpColVector &H) const
 */
 vpForceTwistMatrix vpForceTwistMatrix::buildFrom(const vpTranslationVector &t, const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t) * R;
+  vpMatrixFixed<3, 3> skew_t;
+  skew_t[0][1] = -t[2];
+  skew_t[0][2] = t[1];
+  skew_t[1][0] = t[2];
+  skew_t[1][2] = -t[0];
+  skew_t[2][0] = -t[1];
+  skew_t[2][1] = t[0];
+  const vpMatrixFixed<3, 3> skewaR = skew_t * vpMatrixFixed<3, 3>(R);
 
   for (unsigned int i = 0; i < 3; i++) {
     for (unsigned int j = 0; j < 3; j++) {
@@ -605,9 +605,7 @@ void vpRotationMatrix::printVector()
 */
 vpRotationMatrix vpRotationMatrix::buildFrom(const vpThetaUVector &v)
 {
-  unsigned int i, j;
   double theta, si, co, sinc, mcosc;
-  vpRotationMatrix R;
 
   theta = sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
   si = sin(theta);
@@ -615,19 +613,15 @@ vpRotationMatrix vpRotationMatrix::buildFrom(const vpThetaUVector &v)
   sinc = vpMath::sinc(si, theta);
   mcosc = vpMath::mcosc(co, theta);
 
-  R[0][0] = co + mcosc * v[0] * v[0];
-  R[0][1] = -sinc * v[2] + mcosc * v[0] * v[1];
-  R[0][2] = sinc * v[1] + mcosc * v[0] * v[2];
-  R[1][0] = sinc * v[2] + mcosc * v[1] * v[0];
-  R[1][1] = co + mcosc * v[1] * v[1];
-  R[1][2] = -sinc * v[0] + mcosc * v[1] * v[2];
-  R[2][0] = -sinc * v[1] + mcosc * v[2] * v[0];
-  R[2][1] = sinc * v[0] + mcosc * v[2] * v[1];
-  R[2][2] = co + mcosc * v[2] * v[2];
-
-  for (i = 0; i < 3; i++)
-    for (j = 0; j < 3; j++)
-      (*this)[i][j] = R[i][j];
+  (*this)[0][0] = co + mcosc * v[0] * v[0];
+  (*this)[0][1] = -sinc * v[2] + mcosc * v[0] * v[1];
+  (*this)[0][2] = sinc * v[1] + mcosc * v[0] * v[2];
+  (*this)[1][0] = sinc * v[2] + mcosc * v[1] * v[0];
+  (*this)[1][1] = co + mcosc * v[1] * v[1];
+  (*this)[1][2] = -sinc * v[0] + mcosc * v[1] * v[2];
+  (*this)[2][0] = -sinc * v[1] + mcosc * v[2] * v[0];
+  (*this)[2][1] = sinc * v[0] + mcosc * v[2] * v[1];
+  (*this)[2][2] = co + mcosc * v[2] * v[2];
 
   return *this;
 }
@@ -40,6 +40,7 @@
 #include <sstream>
 
 #include <visp3/core/vpException.h>
+#include <visp3/core/vpMatrixFixed.h>
 #include <visp3/core/vpVelocityTwistMatrix.h>
 
 /*!
@@ -363,7 +364,14 @@ vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpRotationMatrix &R
 */
 vpVelocityTwistMatrix vpVelocityTwistMatrix::buildFrom(const vpTranslationVector &t, const vpRotationMatrix &R)
 {
-  vpMatrix skewaR = t.skew(t) * R;
+  vpMatrixFixed<3, 3> skew_t;
+  skew_t[0][1] = -t[2];
+  skew_t[0][2] = t[1];
+  skew_t[1][0] = t[2];
+  skew_t[1][2] = -t[0];
+  skew_t[2][0] = -t[1];
+  skew_t[2][1] = t[0];
+  const vpMatrixFixed<3, 3> skewaR = skew_t * vpMatrixFixed<3, 3>(R);
 
   for (unsigned int i = 0; i < 3; i++) {
     for (unsigned int j = 0; j < 3; j++) {
@@ -54,5 +54,15 @@ bool checkAVX() { return cpu_features.HW_AVX; }
 
 bool checkAVX2() { return cpu_features.HW_AVX2; }
 
+bool checkNEON()
+{
+#if defined(__ARM_NEON) && defined(__aarch64__)
+  // NEON is mandatory on AArch64
+  return true;
+#else
+  return false;
+#endif
+}
+
 void printCPUInfo() { cpu_features.print(); }
 } // namespace vpCPUFeatures
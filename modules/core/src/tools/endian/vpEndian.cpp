@@ -108,12 +108,12 @@ double swapDouble(double d)
 
   \warning Pointer must be valid and 16-bit must be correctly readable.
 */
-uint16_t reinterpret_cast_uchar_to_uint16_LE(unsigned char * const ptr)
+uint16_t reinterpret_cast_uchar_to_uint16_LE(const unsigned char *const ptr)
 {
 #ifdef VISP_LITTLE_ENDIAN
-    return *reinterpret_cast<uint16_t *>(ptr);
+    return *reinterpret_cast<const uint16_t *>(ptr);
 #elif defined(VISP_BIG_ENDIAN)
-    return swap16bits(*reinterpret_cast<uint16_t *>(ptr));
+    return swap16bits(*reinterpret_cast<const uint16_t *>(ptr));
 #else
     throw std::runtime_error("Not supported endianness for correct  custom reinterpret_cast() function.");
 #endif
@@ -45,94 +45,101 @@
 
 */
 
+#include <algorithm>
+#include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include <visp3/core/vpCPUFeatures.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpParallel.h>
 
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
-#include <visp3/core/vpThread.h>
+#if defined __SSE2__ || defined _M_X64 || (defined _M_IX86_FP && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VISP_HAVE_SSE2 1
+#endif
 
 namespace
 {
-struct Histogram_Param_t {
-  unsigned int m_start_index;
-  unsigned int m_end_index;
-
-  unsigned int m_lut[256];
-  unsigned int *m_histogram;
-  const vpImage<unsigned char> *m_I;
-
-  Histogram_Param_t() : m_start_index(0), m_end_index(0), m_lut(), m_histogram(NULL), m_I(NULL) {}
-
-  Histogram_Param_t(unsigned int start_index, unsigned int end_index, const vpImage<unsigned char> *const I)
-    : m_start_index(start_index), m_end_index(end_index), m_lut(), m_histogram(NULL), m_I(I)
-  {
+// Number of rows of the stripes processed in parallel
+const unsigned int histogram_stripe_height = 64;
+
+/*
+  256 bins histogram of a region. Pixels are read 8 at a time and spread
+  over 4 sub-histograms, so that consecutive pixels with the same value do
+  not increment the same counter and do not stall on the store-to-load
+  dependency of the previous increment, as with the naive loop on smooth
+  images. The sub-histograms are summed at the end.
+*/
+void histogramKernel(const vpImage<unsigned char> &I, unsigned int top, unsigned int left, unsigned int height,
+                     unsigned int width, unsigned int *histogram)
+{
+  unsigned int sub[4][256];
+  memset(sub, 0, sizeof(sub));
+
+  for (unsigned int i = top; i < top + height; i++) {
+    const unsigned char *ptr = I[i] + left;
+    unsigned int j = 0;
+    for (; j + 8 <= width; j += 8) {
+      uint64_t pixels;
+      memcpy(&pixels, ptr + j, sizeof(pixels));
+      sub[0][pixels & 0xFF]++;
+      sub[1][(pixels >> 8) & 0xFF]++;
+      sub[2][(pixels >> 16) & 0xFF]++;
+      sub[3][(pixels >> 24) & 0xFF]++;
+      sub[0][(pixels >> 32) & 0xFF]++;
+      sub[1][(pixels >> 40) & 0xFF]++;
+      sub[2][(pixels >> 48) & 0xFF]++;
+      sub[3][pixels >> 56]++;
+    }
+    for (; j < width; j++) {
+      sub[0][ptr[j]]++;
+    }
   }
 
-  ~Histogram_Param_t()
-  {
-    if (m_histogram != NULL) {
-      delete[] m_histogram;
+#if VISP_HAVE_SSE2
+  if (vpCPUFeatures::checkSSE2()) {
+    for (unsigned int k = 0; k < 256; k += 4) {
+      const __m128i s01 = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(sub[0] + k)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(sub[1] + k)));
+      const __m128i s23 = _mm_add_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(sub[2] + k)),
+                                        _mm_loadu_si128(reinterpret_cast<const __m128i *>(sub[3] + k)));
+      _mm_storeu_si128(reinterpret_cast<__m128i *>(histogram + k), _mm_add_epi32(s01, s23));
     }
+    return;
   }
-};
-
-vpThread::Return computeHistogramThread(vpThread::Args args)
-{
-  Histogram_Param_t *histogram_param = static_cast<Histogram_Param_t *>(args);
-  unsigned int start_index = histogram_param->m_start_index;
-  unsigned int end_index = histogram_param->m_end_index;
-
-  const vpImage<unsigned char> *I = histogram_param->m_I;
-
-  unsigned char *ptrStart = (unsigned char *)(I->bitmap) + start_index;
-  unsigned char *ptrEnd = (unsigned char *)(I->bitmap) + end_index;
-  unsigned char *ptrCurrent = ptrStart;
-
-  //    while(ptrCurrent != ptrEnd) {
-  //      histogram_param->m_histogram[ histogram_param->m_lut[ *ptrCurrent ]
-  //      ] ++;
-  //      ++ptrCurrent;
-  //    }
-
-  if (end_index - start_index >= 8) {
-    // Unroll loop version
-    for (; ptrCurrent <= ptrEnd - 8;) {
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
+#endif
 
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
+  for (unsigned int k = 0; k < 256; k++) {
+    histogram[k] = sub[0][k] + sub[1][k] + sub[2][k] + sub[3][k];
+  }
+}
 
-      histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-    }
+class vpHistogramBody : public vpParallelBody
+{
+public:
+  vpHistogramBody(const vpImage<unsigned char> &I, std::vector<unsigned int> &histograms)
+    : m_I(I), m_histograms(histograms)
+  {
   }
 
-  for (; ptrCurrent != ptrEnd; ++ptrCurrent) {
-    histogram_param->m_histogram[histogram_param->m_lut[*ptrCurrent]]++;
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int s = begin; s < end; s++) {
+      const unsigned int top = s * histogram_stripe_height;
+      const unsigned int height = std::min(histogram_stripe_height, m_I.getHeight() - top);
+      histogramKernel(m_I, top, 0, height, m_I.getWidth(), &m_histograms[s * 256]);
+    }
   }
 
-  return 0;
-}
-}
-#endif
+private:
+  const vpImage<unsigned char> &m_I;
+  std::vector<unsigned int> &m_histograms;
+};
+} // namespace
 
 bool compare_vpHistogramPeak(vpHistogramPeak first, vpHistogramPeak second);
 
@@ -233,7 +240,8 @@ void vpHistogram::init(unsigned size_)
 
   \param I : Gray level image.
   \param nbins : Number of bins to compute the histogram.
-  \param nbThreads : Number of threads to use for the computation.
+  \param nbThreads : Number of threads to use for the computation. The
+  stripes of rows are processed by the thread pool of vpParallel.
 */
 void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins, unsigned int nbThreads)
 {
@@ -252,90 +260,54 @@ void vpHistogram::calculate(const vpImage<unsigned char> &I, unsigned int nbins,
 
   memset(histogram, 0, size * sizeof(unsigned int));
 
-  bool use_single_thread;
-#if !defined(VISP_HAVE_PTHREAD) && !defined(_WIN32)
-  use_single_thread = true;
-#else
-  use_single_thread = (nbThreads == 0 || nbThreads == 1);
-#endif
-
-  if (!use_single_thread && I.getSize() <= nbThreads) {
-    use_single_thread = true;
-  }
-
   unsigned int lut[256];
   for (unsigned int i = 0; i < 256; i++) {
     lut[i] = (unsigned int)(i * size / 256.0);
   }
 
-  if (use_single_thread) {
-    // Single thread
-
-    unsigned int size_ = I.getWidth() * I.getHeight();
-    unsigned char *ptrStart = (unsigned char *)I.bitmap;
-    unsigned char *ptrEnd = ptrStart + size_;
-    unsigned char *ptrCurrent = ptrStart;
-
-    while (ptrCurrent != ptrEnd) {
-      histogram[lut[*ptrCurrent]]++;
-      ++ptrCurrent;
-    }
+  unsigned int values[256];
+  const unsigned int nbStripes = (I.getHeight() + histogram_stripe_height - 1) / histogram_stripe_height;
+  if (nbThreads <= 1 || nbStripes <= 1) {
+    histogramKernel(I, 0, 0, I.getHeight(), I.getWidth(), values);
   } else {
-#if defined(VISP_HAVE_PTHREAD) || (defined(_WIN32) && !defined(WINRT_8_0))
-    // Multi-threads
-
-    std::vector<vpThread *> threadpool;
-    std::vector<Histogram_Param_t *> histogramParams;
-
-    unsigned int image_size = I.getSize();
-    unsigned int step = image_size / nbThreads;
-    unsigned int last_step = image_size - step * (nbThreads - 1);
-
-    for (unsigned int index = 0; index < nbThreads; index++) {
-      unsigned int start_index = index * step;
-      unsigned int end_index = (index + 1) * step;
-
-      if (index == nbThreads - 1) {
-        end_index = start_index + last_step;
+    // Each stripe of rows has its own histogram, summed afterwards
+    std::vector<unsigned int> histograms(nbStripes * 256);
+    vpParallel::parallelFor(0, nbStripes, vpHistogramBody(I, histograms), nbThreads, 1);
+
+    memcpy(values, &histograms[0], sizeof(values));
+    for (unsigned int s = 1; s < nbStripes; s++) {
+      for (unsigned int k = 0; k < 256; k++) {
+        values[k] += histograms[s * 256 + k];
       }
-
-      Histogram_Param_t *histogram_param = new Histogram_Param_t(start_index, end_index, &I);
-      histogram_param->m_histogram = new unsigned int[size];
-      memset(histogram_param->m_histogram, 0, size * sizeof(unsigned int));
-      memcpy(histogram_param->m_lut, lut, 256 * sizeof(unsigned int));
-
-      histogramParams.push_back(histogram_param);
-
-      // Start the threads
-      vpThread *histogram_thread = new vpThread((vpThread::Fn)computeHistogramThread, (vpThread::Args)histogram_param);
-      threadpool.push_back(histogram_thread);
     }
+  }
 
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      // Wait until thread ends up
-      threadpool[cpt]->join();
-    }
-
-    for (unsigned int cpt1 = 0; cpt1 < size; cpt1++) {
-      unsigned int sum = 0;
-
-      for (size_t cpt2 = 0; cpt2 < histogramParams.size(); cpt2++) {
-        sum += histogramParams[cpt2]->m_histogram[cpt1];
-      }
-
-      histogram[cpt1] = sum;
-    }
+  for (unsigned int k = 0; k < 256; k++) {
+    histogram[lut[k]] += values[k];
+  }
+}
 
-    // Delete
-    for (size_t cpt = 0; cpt < threadpool.size(); cpt++) {
-      delete threadpool[cpt];
-    }
+/*!
+  Calculate the 256 bins histogram of a region of a gray level image, with
+  the same kernel as calculate(). This is intended for the algorithms that
+  need many local histograms, such as adaptive histogram equalization.
 
-    for (size_t cpt = 0; cpt < histogramParams.size(); cpt++) {
-      delete histogramParams[cpt];
-    }
-#endif
+  \param I : Gray level image.
+  \param top : First row of the region.
+  \param left : First column of the region.
+  \param height : Number of rows of the region.
+  \param width : Number of columns of the region.
+  \param histogram : Array of 256 values where the histogram is written.
+*/
+void vpHistogram::calculateRegion(const vpImage<unsigned char> &I, unsigned int top, unsigned int left,
+                                  unsigned int height, unsigned int width, unsigned int *histogram)
+{
+  if (top + height > I.getHeight() || left + width > I.getWidth()) {
+    throw vpException(vpException::dimensionError, "Region (%d, %d, %dx%d) outside of the image (%dx%d)", top, left,
+                      width, height, I.getWidth(), I.getHeight());
   }
+
+  histogramKernel(I, top, left, height, width, histogram);
 }
 
 /*!
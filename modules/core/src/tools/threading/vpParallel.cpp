@@ -0,0 +1,347 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Stripe-parallel executor based on a persistent thread pool.
+ *
+ *****************************************************************************/
+
+#include <algorithm>
+
+#include <visp3/core/vpParallel.h>
+
+#if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11) && (defined(VISP_HAVE_PTHREAD) || defined(_WIN32))
+#define VISP_PARALLEL_USE_THREAD_POOL 1
+#endif
+
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace
+{
+// Maximum number of stripes when no grain size is given
+const unsigned int default_nb_stripes = 64;
+
+unsigned int hardwareConcurrency()
+{
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+  unsigned int n = std::thread::hardware_concurrency();
+  return n > 0 ? n : 1;
+#else
+  return 1;
+#endif
+}
+
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+// Read and written by any thread calling getNumThreads() or setNumThreads()
+std::atomic<unsigned int> g_nb_threads(0); // 0 means not yet initialized
+#else
+unsigned int g_nb_threads = 0; // 0 means not yet initialized
+#endif
+
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+struct vpParallelJob {
+  vpParallelJob(unsigned int begin, unsigned int end, unsigned int grain, const vpParallelBody &body)
+    : m_begin(begin), m_end(end), m_grain(grain), m_body(body), m_next(0), m_error(), m_errorMutex()
+  {
+  }
+
+  void run()
+  {
+    for (;;) {
+      const unsigned int stripe = m_next.fetch_add(1);
+      // Avoid overflow when computing the first index of the stripe
+      if (stripe >= (m_end - m_begin + m_grain - 1) / m_grain) {
+        break;
+      }
+      const unsigned int first = m_begin + stripe * m_grain;
+      const unsigned int last = std::min(first + m_grain, m_end);
+      try {
+        m_body(first, last);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(m_errorMutex);
+        if (!m_error) {
+          m_error = std::current_exception();
+        }
+      }
+    }
+  }
+
+  const unsigned int m_begin;
+  const unsigned int m_end;
+  const unsigned int m_grain;
+  const vpParallelBody &m_body;
+  std::atomic<unsigned int> m_next;
+  std::exception_ptr m_error;
+  std::mutex m_errorMutex;
+};
+
+thread_local bool t_is_pool_thread = false;
+
+class vpThreadPool
+{
+public:
+  explicit vpThreadPool(unsigned int nbWorkers)
+    : m_workers(), m_mutex(), m_cvStart(), m_cvDone(), m_busy(), m_job(NULL), m_nbActive(0), m_nbPending(0),
+      m_generation(0), m_stop(false)
+  {
+    for (unsigned int i = 0; i < nbWorkers; i++) {
+      m_workers.push_back(std::thread(&vpThreadPool::workerLoop, this, i));
+    }
+  }
+
+  ~vpThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cvStart.notify_all();
+    for (size_t i = 0; i < m_workers.size(); i++) {
+      m_workers[i].join();
+    }
+  }
+
+  unsigned int size() const { return static_cast<unsigned int>(m_workers.size()); }
+
+  // Return false if the pool is used by another thread
+  bool run(vpParallelJob &job, unsigned int nbWorkers)
+  {
+    std::unique_lock<std::mutex> busy(m_busy, std::try_to_lock);
+    if (!busy.owns_lock()) {
+      return false;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_job = &job;
+      m_nbActive = std::min(nbWorkers, size());
+      m_nbPending = m_nbActive;
+      m_generation++;
+    }
+    m_cvStart.notify_all();
+
+    // The calling thread also processes stripes
+    t_is_pool_thread = true;
+    job.run();
+    t_is_pool_thread = false;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cvDone.wait(lock, [this] { return m_nbPending == 0; });
+    m_job = NULL;
+    return true;
+  }
+
+private:
+  void workerLoop(unsigned int index)
+  {
+    t_is_pool_thread = true;
+    unsigned long seen = 0;
+    for (;;) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cvStart.wait(lock, [this, seen] { return m_stop || m_generation != seen; });
+      if (m_stop) {
+        return;
+      }
+      seen = m_generation;
+      if (index >= m_nbActive) {
+        continue;
+      }
+      vpParallelJob *job = m_job;
+      lock.unlock();
+
+      job->run();
+
+      lock.lock();
+      if (--m_nbPending == 0) {
+        m_cvDone.notify_one();
+      }
+    }
+  }
+
+  std::vector<std::thread> m_workers;
+  std::mutex m_mutex;
+  std::condition_variable m_cvStart;
+  std::condition_variable m_cvDone;
+  std::mutex m_busy;
+  vpParallelJob *m_job;
+  unsigned int m_nbActive;
+  unsigned int m_nbPending;
+  unsigned long m_generation;
+  bool m_stop;
+};
+
+struct vpPoolHolder {
+  vpPoolHolder() : m_mutex(), m_pool() {}
+
+  std::mutex m_mutex;
+  std::shared_ptr<vpThreadPool> m_pool;
+};
+
+// The holder is leaked on purpose: destroying the pool during the destruction
+// of the static objects would join the workers after objects they may use are
+// destroyed, and joining threads at that time can deadlock on Windows. The
+// idle workers are terminated with the process. shutdown() releases the pool
+// explicitly.
+vpPoolHolder &getPoolHolder()
+{
+  static vpPoolHolder *holder = new vpPoolHolder();
+  return *holder;
+}
+
+// The pool holds nb_threads - 1 workers, the calling thread being the last one.
+// A pool that is replaced while still in use is released by its last user.
+std::shared_ptr<vpThreadPool> getPool(unsigned int nb_threads)
+{
+  vpPoolHolder &holder = getPoolHolder();
+  std::lock_guard<std::mutex> lock(holder.m_mutex);
+  if (!holder.m_pool || holder.m_pool->size() + 1 != nb_threads) {
+    holder.m_pool = std::make_shared<vpThreadPool>(nb_threads - 1);
+  }
+  return holder.m_pool;
+}
+#endif
+} // namespace
+
+/*!
+  Return the number of threads used by parallelFor(), which is by default the
+  number of concurrent threads supported by the hardware.
+
+  This function and setNumThreads() can be called concurrently.
+*/
+unsigned int vpParallel::getNumThreads()
+{
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+  unsigned int nb_threads = g_nb_threads.load();
+  if (nb_threads == 0) {
+    // Do not overwrite a value set in the meantime by setNumThreads()
+    unsigned int expected = 0;
+    nb_threads = hardwareConcurrency();
+    if (!g_nb_threads.compare_exchange_strong(expected, nb_threads)) {
+      nb_threads = expected;
+    }
+  }
+  return nb_threads;
+#else
+  if (g_nb_threads == 0) {
+    g_nb_threads = hardwareConcurrency();
+  }
+  return g_nb_threads;
+#endif
+}
+
+/*!
+  Set the number of threads used by parallelFor(), including the calling
+  thread. The persistent pool is resized the next time it is used.
+
+  \param nThreads : Number of threads. 0 restores the default value, that is the
+  number of concurrent threads supported by the hardware. 1 disables parallelism.
+*/
+void vpParallel::setNumThreads(unsigned int nThreads)
+{
+  g_nb_threads = nThreads > 0 ? nThreads : hardwareConcurrency();
+}
+
+/*!
+  Stop and join the threads of the persistent pool. The pool is created again
+  the next time it is needed.
+
+  The pool is otherwise never destroyed, its idle threads being terminated
+  with the process, so that no thread is joined during the destruction of the
+  static objects. Call this function before unloading the library or before
+  the end of the program when the threads must be joined, for instance to
+  check the program with a memory leak detector. It must not be called while
+  parallelFor() is running in another thread.
+*/
+void vpParallel::shutdown()
+{
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+  std::shared_ptr<vpThreadPool> pool;
+  {
+    vpPoolHolder &holder = getPoolHolder();
+    std::lock_guard<std::mutex> lock(holder.m_mutex);
+    pool.swap(holder.m_pool);
+  }
+  // The threads are joined here, out of the lock
+#endif
+}
+
+/*!
+  Execute \e body on the range [begin, end[ split in stripes.
+
+  \param begin : First index of the range.
+  \param end : Past-the-end index of the range.
+  \param body : Work to execute on each stripe.
+  \param nThreads : Maximum number of threads to use for this call. If 0,
+  getNumThreads() threads are used.
+  \param grainSize : Size of a stripe. If 0, the range is split in at most 64
+  stripes.
+
+  If \e body throws an exception, the remaining stripes are still processed and
+  the first exception is rethrown to the caller.
+*/
+void vpParallel::parallelFor(unsigned int begin, unsigned int end, const vpParallelBody &body, unsigned int nThreads,
+                             unsigned int grainSize)
+{
+  if (end <= begin) {
+    return;
+  }
+
+  const unsigned int n = end - begin;
+  const unsigned int grain = grainSize > 0 ? grainSize : std::max(1u, (n + default_nb_stripes - 1) / default_nb_stripes);
+  const unsigned int nb_stripes = (n + grain - 1) / grain;
+  const unsigned int nb_threads = std::min(nThreads > 0 ? std::min(nThreads, getNumThreads()) : getNumThreads(),
+                                           nb_stripes);
+
+#ifdef VISP_PARALLEL_USE_THREAD_POOL
+  if (nb_threads > 1 && !t_is_pool_thread) {
+    vpParallelJob job(begin, end, grain, body);
+    if (getPool(getNumThreads())->run(job, nb_threads - 1)) {
+      if (job.m_error) {
+        std::rethrow_exception(job.m_error);
+      }
+      return;
+    }
+  }
+#else
+  (void)nb_threads;
+#endif
+
+  for (unsigned int first = begin; first < end; first += std::min(grain, end - first)) {
+    body(first, first + std::min(grain, end - first));
+  }
+}
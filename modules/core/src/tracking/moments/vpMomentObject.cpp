@@ -358,6 +358,62 @@ void vpMomentObject::fromImage(const vpImage<unsigned char> &image, unsigned cha
   }
 }
 
+/*!
+  Initializes the object from the basic moments of a dense object computed
+  in pixel coordinates, for instance accumulated while labeling the connected
+  components of a binary image. The result is the same as the one of the
+  binary version of fromImage() on an image that only contains the object.
+
+  \param pixelMoments : Moments \f$M_{ij} = \sum u^i v^j\f$ of the object,
+  with \f$(u,v)\f$ the pixel coordinates. \f$M_{ij}\f$ is stored at index
+  <tt>j * (getOrder() + 1) + i</tt>, thus the vector size must be
+  <tt>(getOrder() + 1)^2</tt>; the values for \f$i+j > order\f$ are ignored.
+  \param cam : Camera parameters used to convert the pixel coordinates into
+  normalized coordinates \f$x = (u - u_0) / p_x\f$, \f$y = (v - v_0) / p_y\f$.
+  Distortion is not considered.
+*/
+void vpMomentObject::fromPixelMoments(const std::vector<double> &pixelMoments, const vpCameraParameters &cam)
+{
+  const unsigned int n = getOrder() + 1;
+  if (pixelMoments.size() != n * n) {
+    throw vpException(vpException::dimensionError, "Bad number of pixel moments (%d), %d expected",
+                      static_cast<int>(pixelMoments.size()), static_cast<int>(n * n));
+  }
+
+  // Binomial coefficients up to the order
+  std::vector<double> binomial(n * n, 0.);
+  for (unsigned int k = 0; k < n; k++) {
+    binomial[k * n] = 1.;
+    for (unsigned int l = 1; l <= k; l++) {
+      binomial[k * n + l] = binomial[(k - 1) * n + l - 1] + (l < k ? binomial[(k - 1) * n + l] : 0.);
+    }
+  }
+
+  // Powers of -u0 and -v0 and of 1/px and 1/py
+  std::vector<double> pow_u0(n, 1.), pow_v0(n, 1.), pow_px(n, 1.), pow_py(n, 1.);
+  for (unsigned int k = 1; k < n; k++) {
+    pow_u0[k] = -cam.get_u0() * pow_u0[k - 1];
+    pow_v0[k] = -cam.get_v0() * pow_v0[k - 1];
+    pow_px[k] = cam.get_px_inverse() * pow_px[k - 1];
+    pow_py[k] = cam.get_py_inverse() * pow_py[k - 1];
+  }
+
+  // sum x^p y^q = 1 / (px^p py^q) sum_a sum_b C(p,a) C(q,b) (-u0)^(p-a) (-v0)^(q-b) M_ab
+  const double norm_factor = 1. / (cam.get_px() * cam.get_py());
+  values.assign(order * order, 0.);
+  for (unsigned int q = 0; q < n; q++) {
+    for (unsigned int p = 0; p < n - q; p++) {
+      double m = 0.;
+      for (unsigned int b = 0; b <= q; b++) {
+        for (unsigned int a = 0; a <= p; a++) {
+          m += binomial[p * n + a] * binomial[q * n + b] * pow_u0[p - a] * pow_v0[q - b] * pixelMoments[b * n + a];
+        }
+      }
+      values[q * order + p] = m * pow_px[p] * pow_py[q] * norm_factor;
+    }
+  }
+}
+
 /*!
  * Manikandan. B
  * Photometric moments v2
@@ -0,0 +1,518 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Benchmark suite of the core image and matrix kernels.
+ *
+ *****************************************************************************/
+
+/*!
+  \example perfCoreKernels.cpp
+
+  Benchmark suite of the core image and matrix kernels, that sweeps image and
+  matrix sizes and reports the throughput in MP/s (mega pixels per second) or
+  GFLOP/s.
+
+  The benchmarks are only run with the --benchmark option. The --json option
+  writes the results, with the description of the build (SIMD, OpenMP, Blas /
+  Lapack), in a machine-readable file to compare releases and backends:
+  \code
+  $ ./perfCoreKernels --benchmark --json core.json
+  $ ./perfCoreKernels --benchmark --lapack-min-size 1000000 --json core-builtin.json "[matrix]"
+  \endcode
+
+  The "visp_benchmark" target builds and runs this suite, writing the results
+  in visp-benchmark.json in the build tree.
+
+  GFLOP/s are computed from the nominal number of floating point operations of
+  each algorithm: \f$ 2n^3 \f$ for a matrix product or an inversion, \f$ 2n^2
+  \f$ for a matrix-vector product and \f$ 22n^3 \f$ for a singular value
+  decomposition.
+*/
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include <visp3/core/vpCPUFeatures.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+bool runBenchmark = false;
+std::string jsonFilename;
+
+// Amount of work processed by one invocation of a benchmark
+struct vpBenchmarkWork {
+  double amount;
+  std::string unit;
+};
+
+struct vpBenchmarkResult {
+  std::string testCase;
+  std::string name;
+  double mean;   // ns
+  double low;    // ns
+  double high;   // ns
+  double stddev; // ns
+  int samples;
+  int iterations;
+  double throughput;
+  std::string unit;
+};
+
+std::map<std::string, vpBenchmarkWork> g_works;
+std::vector<vpBenchmarkResult> g_results;
+
+const unsigned int image_sizes[][2] = {{320, 240}, {640, 480}, {1280, 720}, {1920, 1080}};
+
+// Register a benchmark processing an image of the given size, and return its name
+std::string imageBenchmark(const std::string &name, unsigned int width, unsigned int height)
+{
+  std::ostringstream oss;
+  oss << name << " " << width << "x" << height;
+  vpBenchmarkWork work = {width * height * 1e-6, "MP/s"};
+  g_works[oss.str()] = work;
+  return oss.str();
+}
+
+// Register a benchmark of a matrix operation of nominal flops floating point
+// operations, and return its name
+std::string matrixBenchmark(const std::string &name, unsigned int rows, unsigned int cols, double flops)
+{
+  std::ostringstream oss;
+  oss << name << " " << rows << "x" << cols;
+  vpBenchmarkWork work = {flops * 1e-9, "GFLOP/s"};
+  g_works[oss.str()] = work;
+  return oss.str();
+}
+
+template <class Type> void randomImage(vpImage<Type> &I, unsigned int width, unsigned int height, vpUniRand &rng)
+{
+  I.resize(height, width);
+  unsigned char *bitmap = reinterpret_cast<unsigned char *>(I.bitmap);
+  for (size_t i = 0; i < I.getSize() * sizeof(Type); i++) {
+    bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+vpMatrix randomMatrix(unsigned int rows, unsigned int cols, vpUniRand &rng)
+{
+  vpMatrix M(rows, cols);
+  for (unsigned int i = 0; i < M.size(); i++) {
+    M.data[i] = rng.uniform(-1.0, 1.0);
+  }
+  return M;
+}
+
+std::string jsonString(const std::string &str)
+{
+  std::string escaped = "\"";
+  for (size_t i = 0; i < str.size(); i++) {
+    if (str[i] == '"' || str[i] == '\\') {
+      escaped += '\\';
+    }
+    escaped += str[i];
+  }
+  return escaped + "\"";
+}
+
+void writeJson(const std::string &filename)
+{
+  std::ofstream file(filename.c_str());
+  file << std::setprecision(9);
+  file << "{\n";
+  file << "  \"visp_version\": \"" << VISP_VERSION_MAJOR << "." << VISP_VERSION_MINOR << "."
+       << VISP_VERSION_PATCH << "\",\n";
+  file << "  \"build\": {\n";
+  file << "    \"sse2\": " << (vpCPUFeatures::checkSSE2() ? "true" : "false") << ",\n";
+  file << "    \"avx\": " << (vpCPUFeatures::checkAVX() ? "true" : "false") << ",\n";
+#if defined(VISP_HAVE_OPENMP)
+  file << "    \"openmp\": true,\n";
+#else
+  file << "    \"openmp\": false,\n";
+#endif
+#if defined(VISP_HAVE_LAPACK)
+  file << "    \"lapack\": true,\n";
+#else
+  file << "    \"lapack\": false,\n";
+#endif
+  file << "    \"lapack_min_size\": " << vpMatrix::getLapackMatrixMinSize() << ",\n";
+  file << "    \"threads\": " << vpParallel::getNumThreads() << "\n";
+  file << "  },\n";
+  file << "  \"benchmarks\": [";
+  for (size_t i = 0; i < g_results.size(); i++) {
+    const vpBenchmarkResult &r = g_results[i];
+    file << (i == 0 ? "\n" : ",\n");
+    file << "    {\"test_case\": " << jsonString(r.testCase) << ", \"name\": " << jsonString(r.name)
+         << ", \"mean_ns\": " << r.mean << ", \"low_mean_ns\": " << r.low << ", \"high_mean_ns\": " << r.high
+         << ", \"std_dev_ns\": " << r.stddev << ", \"samples\": " << r.samples
+         << ", \"iterations\": " << r.iterations << ", \"throughput\": " << r.throughput
+         << ", \"unit\": " << jsonString(r.unit) << "}";
+  }
+  file << "\n  ]\n}\n";
+}
+
+// Collect the benchmark statistics to report the throughputs and write the JSON file
+class vpBenchmarkListener : public Catch::TestEventListenerBase
+{
+public:
+  using TestEventListenerBase::TestEventListenerBase;
+
+  void testCaseStarting(Catch::TestCaseInfo const &testInfo) override { m_testCase = testInfo.name; }
+
+  void benchmarkEnded(Catch::BenchmarkStats<> const &stats) override
+  {
+    vpBenchmarkResult result;
+    result.testCase = m_testCase;
+    result.name = stats.info.name;
+    result.mean = stats.mean.point.count();
+    result.low = stats.mean.lower_bound.count();
+    result.high = stats.mean.upper_bound.count();
+    result.stddev = stats.standardDeviation.point.count();
+    result.samples = stats.info.samples;
+    result.iterations = stats.info.iterations;
+    result.throughput = 0;
+    std::map<std::string, vpBenchmarkWork>::const_iterator it = g_works.find(stats.info.name);
+    if (it != g_works.end() && result.mean > 0) {
+      result.throughput = it->second.amount / (result.mean * 1e-9);
+      result.unit = it->second.unit;
+    }
+    g_results.push_back(result);
+  }
+
+  void testRunEnded(Catch::TestRunStats const &) override
+  {
+    if (g_results.empty()) {
+      return;
+    }
+
+    std::cout << "\nThroughput:\n";
+    for (size_t i = 0; i < g_results.size(); i++) {
+      std::cout << "  " << std::left << std::setw(48) << g_results[i].name << std::right << std::setw(12)
+                << std::fixed << std::setprecision(3) << g_results[i].throughput << " " << g_results[i].unit
+                << std::endl;
+    }
+    if (!jsonFilename.empty()) {
+      writeJson(jsonFilename);
+      std::cout << "Results written in " << jsonFilename << std::endl;
+    }
+  }
+
+private:
+  std::string m_testCase;
+};
+} // namespace
+
+CATCH_REGISTER_LISTENER(vpBenchmarkListener)
+
+TEST_CASE("Image filtering", "[benchmark][image]")
+{
+  if (runBenchmark) {
+    vpUniRand rng;
+    for (size_t n = 0; n < sizeof(image_sizes) / sizeof(image_sizes[0]); n++) {
+      vpImage<unsigned char> I;
+      randomImage(I, image_sizes[n][0], image_sizes[n][1], rng);
+      vpImage<unsigned char> I_blur;
+      vpImage<double> I_double;
+
+      BENCHMARK(imageBenchmark("gaussianBlur 7x7 uchar", I.getWidth(), I.getHeight()))
+      {
+        vpImageFilter::gaussianBlur(I, I_blur, 7);
+        return I_blur.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("gaussianBlur 7x7 double", I.getWidth(), I.getHeight()))
+      {
+        vpImageFilter::gaussianBlur(I, I_double, 7);
+        return I_double.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("getGradX", I.getWidth(), I.getHeight()))
+      {
+        vpImageFilter::getGradX(I, I_double);
+        return I_double.bitmap[0];
+      };
+
+      vpMatrix kernel(5, 5, 1 / 25.0);
+      BENCHMARK(imageBenchmark("filter 5x5", I.getWidth(), I.getHeight()))
+      {
+        vpImageFilter::filter(I, I_double, kernel);
+        return I_double.bitmap[0];
+      };
+    }
+  }
+}
+
+TEST_CASE("Image conversion", "[benchmark][image]")
+{
+  if (runBenchmark) {
+    vpUniRand rng;
+    for (size_t n = 0; n < sizeof(image_sizes) / sizeof(image_sizes[0]); n++) {
+      const unsigned int width = image_sizes[n][0], height = image_sizes[n][1];
+      vpImage<vpRGBa> I_color;
+      vpImage<unsigned char> I_gray;
+      randomImage(I_color, width, height, rng);
+      randomImage(I_gray, width, height, rng);
+      vpImage<vpRGBa> I_color_out(height, width);
+      vpImage<unsigned char> I_gray_out(height, width);
+      std::vector<unsigned char> yuv(width * height * 3 / 2);
+      for (size_t i = 0; i < yuv.size(); i++) {
+        yuv[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+      }
+
+      BENCHMARK(imageBenchmark("RGBa to grey", width, height))
+      {
+        vpImageConvert::convert(I_color, I_gray_out);
+        return I_gray_out.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("grey to RGBa", width, height))
+      {
+        vpImageConvert::convert(I_gray, I_color_out);
+        return I_color_out.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("YUV420 to RGBa", width, height))
+      {
+        vpImageConvert::YUV420ToRGBa(&yuv[0], reinterpret_cast<unsigned char *>(I_color_out.bitmap), width, height);
+        return I_color_out.bitmap[0];
+      };
+    }
+  }
+}
+
+TEST_CASE("Image resize and warp", "[benchmark][image]")
+{
+  if (runBenchmark) {
+    vpUniRand rng;
+    for (size_t n = 0; n < sizeof(image_sizes) / sizeof(image_sizes[0]); n++) {
+      const unsigned int width = image_sizes[n][0], height = image_sizes[n][1];
+      vpImage<unsigned char> I;
+      randomImage(I, width, height, rng);
+      vpImage<unsigned char> I_half(height / 2, width / 2), I_warp(height, width);
+
+      // The throughput is given wrt. the number of pixels of the output image
+      BENCHMARK(imageBenchmark("resize 1/2 nearest", width / 2, height / 2))
+      {
+        vpImageTools::resize(I, I_half, vpImageTools::INTERPOLATION_NEAREST);
+        return I_half.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("resize 1/2 bilinear", width / 2, height / 2))
+      {
+        vpImageTools::resize(I, I_half, vpImageTools::INTERPOLATION_LINEAR);
+        return I_half.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("resize 1/2 bicubic", width / 2, height / 2))
+      {
+        vpImageTools::resize(I, I_half, vpImageTools::INTERPOLATION_CUBIC);
+        return I_half.bitmap[0];
+      };
+
+      BENCHMARK(imageBenchmark("resize 1/2 area", width / 2, height / 2))
+      {
+        vpImageTools::resize(I, I_half, vpImageTools::INTERPOLATION_AREA);
+        return I_half.bitmap[0];
+      };
+
+      vpImage<unsigned char> I_third(height / 3, width / 3);
+      BENCHMARK(imageBenchmark("resize 1/3 area", width / 3, height / 3))
+      {
+        vpImageTools::resize(I, I_third, vpImageTools::INTERPOLATION_AREA);
+        return I_third.bitmap[0];
+      };
+
+      vpMatrix M(2, 3);
+      const double theta = vpMath::rad(30);
+      M[0][0] = cos(theta);
+      M[0][1] = -sin(theta);
+      M[0][2] = width / 4.;
+      M[1][0] = sin(theta);
+      M[1][1] = cos(theta);
+      M[1][2] = -height / 4.;
+
+      BENCHMARK(imageBenchmark("affine warp bilinear", width, height))
+      {
+        vpImageTools::warpImage(I, M, I_warp, vpImageTools::INTERPOLATION_LINEAR);
+        return I_warp.bitmap[0];
+      };
+    }
+  }
+}
+
+TEST_CASE("Image morphology", "[benchmark][image]")
+{
+  if (runBenchmark) {
+    vpUniRand rng;
+    for (size_t n = 0; n < sizeof(image_sizes) / sizeof(image_sizes[0]); n++) {
+      vpImage<unsigned char> I;
+      randomImage(I, image_sizes[n][0], image_sizes[n][1], rng);
+
+      // The operations are in place: each run works on a copy of the input
+      // image that is made outside of the measurement
+      BENCHMARK_ADVANCED(imageBenchmark("erosion connexity 8", I.getWidth(), I.getHeight()))
+      (Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<vpImage<unsigned char> > images(meter.runs(), I);
+        meter.measure([&](int i) { vpImageMorphology::erosion(images[i], vpImageMorphology::CONNEXITY_8); });
+      };
+
+      BENCHMARK_ADVANCED(imageBenchmark("dilatation connexity 4", I.getWidth(), I.getHeight()))
+      (Catch::Benchmark::Chronometer meter)
+      {
+        std::vector<vpImage<unsigned char> > images(meter.runs(), I);
+        meter.measure([&](int i) { vpImageMorphology::dilatation(images[i], vpImageMorphology::CONNEXITY_4); });
+      };
+    }
+  }
+}
+
+TEST_CASE("Matrix products", "[benchmark][matrix]")
+{
+  if (runBenchmark) {
+    vpUniRand rng;
+    const unsigned int sizes[] = {6, 32, 128, 512};
+    for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+      const unsigned int size = sizes[n];
+      const vpMatrix A = randomMatrix(size, size, rng), B = randomMatrix(size, size, rng);
+      const vpColVector v = randomMatrix(size, 1, rng).getCol(0);
+      vpMatrix C;
+      vpColVector w;
+
+      BENCHMARK(matrixBenchmark("A*B", size, size, 2. * size * size * size))
+      {
+        vpMatrix::mult2Matrices(A, B, C);
+        return C.data[0];
+      };
+
+      BENCHMARK(matrixBenchmark("A*v", size, size, 2. * size * size))
+      {
+        vpMatrix::multMatrixVector(A, v, w);
+        return w.data[0];
+      };
+    }
+
+    // Normal matrices of the tall Jacobians of the pose estimation
+    const unsigned int rows[] = {100, 1000, 10000};
+    for (size_t n = 0; n < sizeof(rows) / sizeof(rows[0]); n++) {
+      const vpMatrix L = randomMatrix(rows[n], 6, rng);
+      vpMatrix LTL;
+      BENCHMARK(matrixBenchmark("AtA", rows[n], 6, 2. * rows[n] * 6 * 6))
+      {
+        L.AtA(LTL);
+        return LTL.data[0];
+      };
+    }
+  }
+}
+
+TEST_CASE("Matrix decompositions", "[benchmark][matrix]")
+{
+  if (runBenchmark) {
+    vpUniRand rng;
+    const unsigned int sizes[] = {6, 32, 128, 256};
+    for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+      const unsigned int size = sizes[n];
+      // Diagonally dominant to be well conditioned
+      vpMatrix A = randomMatrix(size, size, rng);
+      for (unsigned int i = 0; i < size; i++) {
+        A[i][i] += size;
+      }
+      const double n3 = static_cast<double>(size) * size * size;
+
+      BENCHMARK(matrixBenchmark("inverseByLU", size, size, 2. * n3)) { return A.inverseByLU().data[0]; };
+
+      vpMatrix U, V;
+      vpColVector sv;
+      BENCHMARK(matrixBenchmark("svd", size, size, 22. * n3))
+      {
+        U = A;
+        U.svd(sv, V);
+        return sv[0];
+      };
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+  unsigned int lapackMinSize = vpMatrix::getLapackMatrixMinSize();
+  unsigned int nbThreads = vpParallel::getNumThreads();
+
+  // Build a new parser on top of Catch's
+  using namespace Catch::clara;
+  auto cli = session.cli()                                       // Get Catch's composite command line parser
+             | Opt(runBenchmark)                                 // bind variable to a new option, with a hint string
+                   ["--benchmark"]                               // the option names it will respond to
+             ("run the benchmarks")                              // description string for the help output
+             | Opt(jsonFilename, "filename")["--json"]           // JSON output
+             ("write the results in a JSON file")                //
+             | Opt(lapackMinSize, "min size")["--lapack-min-size"] // Blas/Lapack threshold
+             ("matrix/vector min size to enable blas/lapack usage") //
+             | Opt(nbThreads, "threads")["--threads"]            // vpParallel threads
+             ("number of threads used by the parallel image kernels");
+
+  // Now pass the new composite back to Catch so it uses that
+  session.cli(cli);
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  vpMatrix::setLapackMatrixMinSize(lapackMinSize);
+  vpParallel::setNumThreads(nbThreads);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return 0; }
+#endif
@@ -0,0 +1,319 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the vectorized YUV to RGB(a) and grey conversions.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testColorConversionSIMD.cpp
+
+  \brief Check the vectorized YUV conversions of vpImageConvert against
+  per-pixel reference implementations, as well as the conversions fused with a
+  downscale by 2.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+typedef std::vector<unsigned char> Buffer;
+
+Buffer randomBuffer(size_t n, vpUniRand &rng)
+{
+  Buffer buf(n);
+  for (size_t i = 0; i < n; i++) {
+    buf[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  return buf;
+}
+
+unsigned char saturate(int c) { return static_cast<unsigned char>(c < 0 ? 0 : (c > 255 ? 255 : c)); }
+
+// Reference conversion of one pixel with the coefficients used by most of the YUV formats
+void refPixel(int y, int u, int v, unsigned char *dst, bool alpha)
+{
+  const int U = (int)((u - 128) * 0.354);
+  const int V = (int)((v - 128) * 0.707);
+  dst[0] = saturate(y + 2 * V);
+  dst[1] = saturate(y - U - V);
+  dst[2] = saturate(y + 5 * U);
+  if (alpha) {
+    dst[3] = vpRGBa::alpha_default;
+  }
+}
+
+// Reference conversion of one pixel with the coefficients of the YUYV format
+void refPixelYUYV(int y, int u, int v, unsigned char *dst, bool alpha)
+{
+  dst[0] = saturate(y + (((v - 128) * 359) >> 8));
+  dst[1] = saturate(y - (((u - 128) * 88 + (v - 128) * 183) >> 8));
+  dst[2] = saturate(y + (((u - 128) * 454) >> 8));
+  if (alpha) {
+    dst[3] = vpRGBa::alpha_default;
+  }
+}
+
+enum Format { YUYV, YUV411, YUV422, YUV444, YUV420, YV12, YVU9 };
+
+// Return the luminance and chroma of pixel (i, j)
+void samples(Format format, const Buffer &yuv, unsigned int width, unsigned int height, unsigned int i,
+             unsigned int j, int &y, int &u, int &v)
+{
+  const unsigned int k = i * width + j, size = width * height;
+  switch (format) {
+  case YUYV:
+    y = yuv[2 * k];
+    u = yuv[4 * (k / 2) + 1];
+    v = yuv[4 * (k / 2) + 3];
+    break;
+  case YUV411: {
+    static const unsigned int offsets[4] = {1, 2, 4, 5};
+    y = yuv[6 * (k / 4) + offsets[k % 4]];
+    u = yuv[6 * (k / 4)];
+    v = yuv[6 * (k / 4) + 3];
+    break;
+  }
+  case YUV422:
+    y = yuv[2 * k + 1];
+    u = yuv[4 * (k / 2)];
+    v = yuv[4 * (k / 2) + 2];
+    break;
+  case YUV444:
+    y = yuv[3 * k + 1];
+    u = yuv[3 * k];
+    v = yuv[3 * k + 2];
+    break;
+  default: {
+    const unsigned int s = format == YVU9 ? 2 : 1;
+    const unsigned int c = (i >> s) * (width >> s) + (j >> s);
+    const unsigned int csize = (width >> s) * (height >> s);
+    y = yuv[k];
+    u = yuv[size + (format == YUV420 ? 0 : csize) + c];
+    v = yuv[size + (format == YUV420 ? csize : 0) + c];
+    break;
+  }
+  }
+}
+
+Buffer reference(Format format, const Buffer &yuv, unsigned int width, unsigned int height, bool alpha)
+{
+  const unsigned int nc = alpha ? 4 : 3;
+  Buffer dst(nc * width * height);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      int y, u, v;
+      samples(format, yuv, width, height, i, j, y, u, v);
+      if (format == YUYV) {
+        refPixelYUYV(y, u, v, &dst[nc * (i * width + j)], alpha);
+      } else {
+        refPixel(y, u, v, &dst[nc * (i * width + j)], alpha);
+      }
+    }
+  }
+  return dst;
+}
+
+size_t inputSize(Format format, unsigned int n)
+{
+  switch (format) {
+  case YUYV:
+  case YUV422:
+    return 2 * n;
+  case YUV444:
+    return 3 * n;
+  case YVU9:
+    return n + n / 8;
+  default:
+    return n + n / 2;
+  }
+}
+
+void convert(Format format, Buffer &yuv, Buffer &dst, unsigned int width, unsigned int height, bool alpha)
+{
+  const unsigned int n = width * height;
+  dst.assign((alpha ? 4 : 3) * n, 0);
+  unsigned char *s = &yuv[0], *d = &dst[0];
+  switch (format) {
+  case YUYV:
+    alpha ? vpImageConvert::YUYVToRGBa(s, d, width, height) : vpImageConvert::YUYVToRGB(s, d, width, height);
+    break;
+  case YUV411:
+    alpha ? vpImageConvert::YUV411ToRGBa(s, d, n) : vpImageConvert::YUV411ToRGB(s, d, n);
+    break;
+  case YUV422:
+    alpha ? vpImageConvert::YUV422ToRGBa(s, d, n) : vpImageConvert::YUV422ToRGB(s, d, n);
+    break;
+  case YUV444:
+    alpha ? vpImageConvert::YUV444ToRGBa(s, d, n) : vpImageConvert::YUV444ToRGB(s, d, n);
+    break;
+  case YUV420:
+    alpha ? vpImageConvert::YUV420ToRGBa(s, d, width, height) : vpImageConvert::YUV420ToRGB(s, d, width, height);
+    break;
+  case YV12:
+    alpha ? vpImageConvert::YV12ToRGBa(s, d, width, height) : vpImageConvert::YV12ToRGB(s, d, height, width);
+    break;
+  case YVU9:
+    alpha ? vpImageConvert::YVU9ToRGBa(s, d, width, height) : vpImageConvert::YVU9ToRGB(s, d, height, width);
+    break;
+  }
+}
+} // namespace
+
+TEST_CASE("YUV to RGB(a) conversions", "[vpImageConvert]")
+{
+  vpUniRand rng(2718);
+  const char *names[] = {"YUYV", "YUV411", "YUV422", "YUV444", "YUV420", "YV12", "YVU9"};
+  // Sizes larger than a processing chunk and with widths that are not multiple of the SIMD width
+  const unsigned int sizes[3][2] = {{4, 4}, {36, 20}, {132, 68}};
+
+  for (int f = YUYV; f <= YVU9; f++) {
+    const Format format = static_cast<Format>(f);
+    for (unsigned int s = 0; s < 3; s++) {
+      const unsigned int w = sizes[s][0], h = sizes[s][1];
+      Buffer yuv = randomBuffer(inputSize(format, w * h), rng);
+      for (int alpha = 0; alpha < 2; alpha++) {
+        INFO(names[f] << (alpha ? "ToRGBa " : "ToRGB ") << w << "x" << h);
+        Buffer dst;
+        convert(format, yuv, dst, w, h, alpha != 0);
+        CHECK(dst == reference(format, yuv, w, h, alpha != 0));
+      }
+    }
+  }
+}
+
+TEST_CASE("YUV to grey conversions", "[vpImageConvert]")
+{
+  vpUniRand rng(31415);
+  const unsigned int w = 70, h = 18, n = w * h;
+  Buffer grey(n);
+
+  Buffer yuyv = randomBuffer(2 * n, rng);
+  vpImageConvert::YUYVToGrey(&yuyv[0], &grey[0], n);
+  bool same = true;
+  for (unsigned int i = 0; i < n; i++) {
+    same = same && grey[i] == yuyv[2 * i];
+  }
+  CHECK(same);
+
+  Buffer uyvy = randomBuffer(2 * n, rng);
+  vpImageConvert::YUV422ToGrey(&uyvy[0], &grey[0], n);
+  same = true;
+  for (unsigned int i = 0; i < n; i++) {
+    same = same && grey[i] == uyvy[2 * i + 1];
+  }
+  CHECK(same);
+
+  Buffer rgba(4 * n);
+  vpImageConvert::GreyToRGBa(&grey[0], &rgba[0], n);
+  same = true;
+  for (unsigned int i = 0; i < n; i++) {
+    same = same && rgba[4 * i] == grey[i] && rgba[4 * i + 1] == grey[i] && rgba[4 * i + 2] == grey[i] &&
+           rgba[4 * i + 3] == vpRGBa::alpha_default;
+  }
+  CHECK(same);
+}
+
+TEST_CASE("YUV conversions fused with a downscale by 2", "[vpImageConvert]")
+{
+  vpUniRand rng(1618);
+  const unsigned int w = 90, h = 42, hw = w / 2, hh = h / 2;
+  const Format formats[3] = {YUYV, YUV422, YUV420};
+  const char *names[3] = {"YUYV", "YUV422", "YUV420"};
+
+  for (unsigned int f = 0; f < 3; f++) {
+    INFO(names[f]);
+    Buffer yuv = randomBuffer(inputSize(formats[f], w * h), rng);
+    Buffer rgba(4 * hw * hh), grey(hw * hh);
+    switch (formats[f]) {
+    case YUYV:
+      vpImageConvert::YUYVToRGBaHalfSize(&yuv[0], &rgba[0], w, h);
+      vpImageConvert::YUYVToGreyHalfSize(&yuv[0], &grey[0], w, h);
+      break;
+    case YUV422:
+      vpImageConvert::YUV422ToRGBaHalfSize(&yuv[0], &rgba[0], w, h);
+      vpImageConvert::YUV422ToGreyHalfSize(&yuv[0], &grey[0], w, h);
+      break;
+    default:
+      vpImageConvert::YUV420ToRGBaHalfSize(&yuv[0], &rgba[0], w, h);
+      vpImageConvert::YUV420ToGreyHalfSize(&yuv[0], &grey[0], w, h);
+      break;
+    }
+
+    bool same_grey = true, same_rgba = true;
+    for (unsigned int i = 0; i < hh; i++) {
+      for (unsigned int j = 0; j < hw; j++) {
+        int y[4], u[4], v[4];
+        for (unsigned int k = 0; k < 4; k++) {
+          samples(formats[f], yuv, w, h, 2 * i + k / 2, 2 * j + k % 2, y[k], u[k], v[k]);
+        }
+        const int ym = (y[0] + y[1] + y[2] + y[3] + 2) >> 2;
+        const int um = (u[0] + u[2] + 1) >> 1;
+        const int vm = (v[0] + v[2] + 1) >> 1;
+        unsigned char px[4];
+        if (formats[f] == YUYV) {
+          refPixelYUYV(ym, um, vm, px, true);
+        } else {
+          refPixel(ym, um, vm, px, true);
+        }
+        same_grey = same_grey && grey[i * hw + j] == ym;
+        same_rgba = same_rgba && memcmp(px, &rgba[4 * (i * hw + j)], 4) == 0;
+      }
+    }
+    CHECK(same_grey);
+    CHECK(same_rgba);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
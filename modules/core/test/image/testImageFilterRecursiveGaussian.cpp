@@ -0,0 +1,195 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the recursive Gaussian filter of vpImageFilter.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageFilterRecursiveGaussian.cpp
+
+  \brief Check that the recursive Gaussian filter of vpImageFilter stays close
+  to the exact convolution with replicated borders.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void blockImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      I[i][j] = ((i / 20 + j / 25) % 2) ? 200 : 30;
+    }
+  }
+  // Add some impulses
+  for (unsigned int i = 0; i < I.getSize(); i += 7) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+// Convolution with a Gaussian kernel of radius 6 sigma, the pixels outside of
+// the image are replicated from the border
+void gaussianBlurRef(const vpImage<unsigned char> &I, vpImage<double> &GI, double sigma)
+{
+  const int r = static_cast<int>(std::ceil(6 * sigma));
+  std::vector<double> kernel(2 * r + 1);
+  double sum = 0;
+  for (int k = -r; k <= r; k++) {
+    kernel[k + r] = std::exp(-k * k / (2 * sigma * sigma));
+    sum += kernel[k + r];
+  }
+  for (size_t k = 0; k < kernel.size(); k++) {
+    kernel[k] /= sum;
+  }
+
+  const int h = static_cast<int>(I.getHeight()), w = static_cast<int>(I.getWidth());
+  vpImage<double> GIx(h, w);
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      double val = 0;
+      for (int k = -r; k <= r; k++) {
+        val += kernel[k + r] * I[i][std::min(std::max(j + k, 0), w - 1)];
+      }
+      GIx[i][j] = val;
+    }
+  }
+  GI.resize(h, w);
+  for (int i = 0; i < h; i++) {
+    for (int j = 0; j < w; j++) {
+      double val = 0;
+      for (int k = -r; k <= r; k++) {
+        val += kernel[k + r] * GIx[std::min(std::max(i + k, 0), h - 1)][j];
+      }
+      GI[i][j] = val;
+    }
+  }
+}
+
+double maxError(const vpImage<double> &I1, const vpImage<double> &I2)
+{
+  double max_error = 0;
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    max_error = std::max(max_error, std::fabs(I1.bitmap[i] - I2.bitmap[i]));
+  }
+  return max_error;
+}
+} // namespace
+
+TEST_CASE("Recursive Gaussian blur accuracy", "[vpImageFilter]")
+{
+  vpUniRand rng(1);
+  vpImage<unsigned char> I;
+  blockImage(I, 97, 131, rng);
+
+  const double sigmas[] = {0.5, 0.8, 1.0, 1.5, 2.0, 3.0, 5.0, 10.0, 20.0, 50.0};
+  for (size_t s = 0; s < sizeof(sigmas) / sizeof(sigmas[0]); s++) {
+    vpImage<double> GI, GI_ref;
+    vpImageFilter::gaussianBlurRecursive(I, GI, sigmas[s]);
+    gaussianBlurRef(I, GI_ref, sigmas[s]);
+    REQUIRE(GI.getHeight() == I.getHeight());
+    REQUIRE(GI.getWidth() == I.getWidth());
+
+    const double max_error = maxError(GI, GI_ref);
+    std::cout << "Recursive Gaussian blur sigma=" << sigmas[s] << " max error: " << max_error << std::endl;
+    CHECK(max_error < 1.0);
+  }
+}
+
+TEST_CASE("Recursive Gaussian blur of a constant image", "[vpImageFilter]")
+{
+  vpImage<unsigned char> I(40, 3, 128);
+  vpImage<double> GI;
+  vpImageFilter::gaussianBlurRecursive(I, GI, 4.0);
+  for (unsigned int i = 0; i < GI.getSize(); i++) {
+    CHECK(GI.bitmap[i] == Approx(128.0).epsilon(1e-9));
+  }
+}
+
+TEST_CASE("Recursive Gaussian blur in place and multithreaded", "[vpImageFilter]")
+{
+  vpUniRand rng(2);
+  vpImage<unsigned char> I;
+  blockImage(I, 211, 157, rng);
+
+  const unsigned int nb_threads = vpParallel::getNumThreads();
+  vpParallel::setNumThreads(1);
+  vpImage<double> GI;
+  vpImageFilter::gaussianBlurRecursive(I, GI, 3.0);
+  vpParallel::setNumThreads(4);
+  vpImage<double> GI_mt;
+  vpImageFilter::gaussianBlurRecursive(I, GI_mt, 3.0);
+  vpParallel::setNumThreads(nb_threads);
+  CHECK(maxError(GI, GI_mt) == 0.0);
+
+  // Filter a double image in place
+  vpImage<double> GI2;
+  vpImageFilter::gaussianBlurRecursive(I, GI2, 2.0);
+  vpImage<double> GI2_ref;
+  vpImageFilter::gaussianBlurRecursive(GI2, GI2_ref, 2.0);
+  vpImageFilter::gaussianBlurRecursive(GI2, GI2, 2.0);
+  CHECK(maxError(GI2, GI2_ref) == 0.0);
+}
+
+TEST_CASE("Recursive Gaussian blur with a small sigma", "[vpImageFilter]")
+{
+  vpImage<unsigned char> I(10, 10, 0);
+  vpImage<double> GI;
+  CHECK_THROWS_AS(vpImageFilter::gaussianBlurRecursive(I, GI, 0.4), vpImageException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
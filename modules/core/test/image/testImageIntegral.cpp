@@ -0,0 +1,185 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the integer integral images and the box filters of vpImageTools.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageIntegral.cpp
+
+  \brief Compare the integer and tilted integral images, the box filter and
+  the local mean and variance of vpImageTools with a brute force computation.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+// Mean and variance of the pixels in the window clipped to the image
+void localMeanVarianceRef(const vpImage<unsigned char> &I, unsigned int i, unsigned int j, unsigned int size,
+                          double &mean, double &variance)
+{
+  const int r = static_cast<int>(size / 2);
+  double sum = 0, sqsum = 0, n = 0;
+  for (int ii = static_cast<int>(i) - r; ii <= static_cast<int>(i) + r; ii++) {
+    for (int jj = static_cast<int>(j) - r; jj <= static_cast<int>(j) + r; jj++) {
+      if (ii >= 0 && jj >= 0 && ii < static_cast<int>(I.getHeight()) && jj < static_cast<int>(I.getWidth())) {
+        sum += I[ii][jj];
+        sqsum += I[ii][jj] * I[ii][jj];
+        n++;
+      }
+    }
+  }
+  mean = sum / n;
+  variance = sqsum / n - mean * mean;
+}
+} // namespace
+
+TEST_CASE("Integer integral images", "[vpImageTools]")
+{
+  vpUniRand rng(1);
+  const unsigned int sizes[][2] = {{1, 1}, {1, 7}, {7, 1}, {3, 5}, {61, 97}, {128, 130}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<unsigned char> I;
+    randomImage(I, sizes[s][0], sizes[s][1], rng);
+
+    vpImage<double> II_ref, IIsq_ref;
+    vpImageTools::integralImage(I, II_ref, IIsq_ref);
+
+    vpImage<uint32_t> II, II2;
+    vpImage<uint64_t> IIsq;
+    vpImageTools::integralImage(I, II);
+    vpImageTools::integralImage(I, II2, IIsq);
+    REQUIRE(II.getHeight() == I.getHeight() + 1);
+    REQUIRE(II.getWidth() == I.getWidth() + 1);
+
+    bool same = true;
+    for (unsigned int k = 0; k < II.getSize(); k++) {
+      same = same && II.bitmap[k] == II_ref.bitmap[k] && II2.bitmap[k] == II_ref.bitmap[k] &&
+             IIsq.bitmap[k] == IIsq_ref.bitmap[k];
+    }
+    CHECK(same);
+  }
+}
+
+TEST_CASE("Tilted integral image", "[vpImageTools]")
+{
+  vpUniRand rng(2);
+  const unsigned int sizes[][2] = {{1, 1}, {1, 6}, {6, 1}, {5, 3}, {23, 41}, {40, 9}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<unsigned char> I;
+    randomImage(I, sizes[s][0], sizes[s][1], rng);
+
+    vpImage<uint32_t> IIt;
+    vpImageTools::integralImageTilted(I, IIt);
+    REQUIRE(IIt.getHeight() == I.getHeight() + 1);
+    REQUIRE(IIt.getWidth() == I.getWidth() + 1);
+
+    bool same = true;
+    for (int v = 0; v <= static_cast<int>(I.getHeight()); v++) {
+      for (int u = 0; u <= static_cast<int>(I.getWidth()); u++) {
+        uint32_t sum = 0;
+        for (int y = 0; y < v; y++) {
+          for (int x = 0; x < static_cast<int>(I.getWidth()); x++) {
+            if (std::abs(x - u + 1) <= v - y - 1) {
+              sum += I[y][x];
+            }
+          }
+        }
+        same = same && IIt[v][u] == sum;
+      }
+    }
+    CHECK(same);
+  }
+}
+
+TEST_CASE("Box filter and local mean and variance", "[vpImageTools]")
+{
+  vpUniRand rng(3);
+  vpImage<unsigned char> I;
+  randomImage(I, 37, 53, rng);
+
+  const unsigned int sizes[] = {1, 3, 7, 15, 81};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<double> I_box, I_mean, I_variance;
+    vpImageTools::boxFilter(I, I_box, sizes[s]);
+    vpImageTools::localMeanVariance(I, I_mean, I_variance, sizes[s]);
+
+    double max_error = 0;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double mean, variance;
+        localMeanVarianceRef(I, i, j, sizes[s], mean, variance);
+        max_error = std::max(max_error, std::fabs(I_box[i][j] - mean));
+        max_error = std::max(max_error, std::fabs(I_mean[i][j] - mean));
+        max_error = std::max(max_error, std::fabs(I_variance[i][j] - variance));
+      }
+    }
+    CHECK(max_error < 1e-6);
+  }
+
+  vpImage<double> I_box;
+  CHECK_THROWS_AS(vpImageTools::boxFilter(I, I_box, 4), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
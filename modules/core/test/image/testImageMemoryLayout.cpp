@@ -0,0 +1,304 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the aligned, strided and pooled memory of vpImage.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageMemoryLayout.cpp
+
+  \brief Check the row alignment, the views on a region of interest and the
+  pool allocator of vpImage.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <algorithm>
+#include <catch.hpp>
+#include <vector>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImageAllocator.h>
+
+namespace
+{
+void fillImage(vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = static_cast<unsigned char>(i * 7 + j * 3);
+    }
+  }
+}
+
+bool isEqual(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    for (unsigned int j = 0; j < I1.getWidth(); j++) {
+      if (I1[i][j] != I2[i][j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Row alignment", "[image_memory]")
+{
+  vpImage<unsigned char> I;
+  CHECK(I.getRowAlignment() == 0);
+  CHECK_THROWS_AS(I.setRowAlignment(24), vpException);
+
+  I.setRowAlignment(64);
+  I.resize(31, 101);
+  CHECK(I.getStride() == 128);
+  CHECK(!I.isContiguous());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    CHECK(reinterpret_cast<size_t>(I[i]) % 64 == 0);
+  }
+
+  vpImage<vpRGBa> Irgba;
+  Irgba.setRowAlignment(32);
+  Irgba.resize(5, 9, vpRGBa(1, 2, 3, 4));
+  CHECK(Irgba.getStride() == 16);
+  vpRGBa last = Irgba(4, 8);
+  bool same_value = (last == vpRGBa(1, 2, 3, 4));
+  CHECK(same_value);
+
+  // Already aligned width keeps a contiguous bitmap
+  vpImage<unsigned char> I2;
+  I2.setRowAlignment(32);
+  I2.resize(10, 64);
+  CHECK(I2.isContiguous());
+
+  SECTION("Functions on padded images")
+  {
+    fillImage(I);
+    vpImage<unsigned char> I_packed(I.getHeight(), I.getWidth());
+    fillImage(I_packed);
+
+    vpImage<unsigned char> I_copy(I);
+    CHECK(I_copy.getStride() == I.getStride());
+    CHECK(isEqual(I_copy, I_packed));
+    bool same = (I_copy == I_packed);
+    CHECK(same);
+    CHECK(I.getSum() == Approx(I_packed.getSum()));
+    CHECK(I.getMaxValue() == I_packed.getMaxValue());
+    CHECK(I.getMinValue() == I_packed.getMinValue());
+
+    unsigned char lut[256];
+    for (unsigned int k = 0; k < 256; k++) {
+      lut[k] = static_cast<unsigned char>(255 - k);
+    }
+    I.performLut(lut, 4);
+    I_packed.performLut(lut, 4);
+    CHECK(isEqual(I, I_packed));
+
+    vpImage<unsigned char> C;
+    I.sub(I, C);
+    CHECK(C.getMaxValue() == 0);
+
+    // Assignment from a packed image keeps the row alignment
+    I = I_packed;
+    CHECK(I.getStride() == 128);
+    CHECK(isEqual(I, I_packed));
+    I_packed = I;
+    CHECK(I_packed.isContiguous());
+    CHECK(isEqual(I, I_packed));
+  }
+}
+
+TEST_CASE("Views", "[image_memory]")
+{
+  vpImage<unsigned char> I(40, 60);
+  fillImage(I);
+
+  vpImage<unsigned char> roi;
+  CHECK_THROWS_AS(roi.initView(I, 30, 10, 20, 10), vpException);
+  CHECK_THROWS_AS(I.initView(I, 0, 0, 10, 10), vpException);
+
+  roi.initView(I, 10, 20, 15, 25);
+  CHECK(roi.getWidth() == 25);
+  CHECK(roi.getHeight() == 15);
+  CHECK(roi.getStride() == 60);
+  CHECK(roi[0] == I[10] + 20);
+  CHECK(roi[3][4] == I[13][24]);
+
+  unsigned char min_ref = 255, max_ref = 0;
+  for (unsigned int i = 10; i < 25; i++) {
+    for (unsigned int j = 20; j < 45; j++) {
+      min_ref = std::min(min_ref, I[i][j]);
+      max_ref = std::max(max_ref, I[i][j]);
+    }
+  }
+  unsigned char min_val = 0, max_val = 0;
+  roi.getMinMaxValue(min_val, max_val);
+  CHECK(min_val == min_ref);
+  CHECK(max_val == max_ref);
+
+  // Writing in the view modifies the parent
+  roi = 255;
+  CHECK(I[10][20] == 255);
+  CHECK(I[24][44] == 255);
+  CHECK(I[9][20] != 255);
+  CHECK(I[10][45] != 255);
+
+  // A copy of a view owns a contiguous bitmap
+  vpImage<unsigned char> roi_copy = roi;
+  CHECK(roi_copy.isContiguous());
+  roi_copy = 0;
+  CHECK(I[10][20] == 255);
+
+  // Insert in a view
+  vpImage<unsigned char> patch(2, 3, 7);
+  roi.insert(patch, vpImagePoint(1, 1));
+  CHECK(I[11][21] == 7);
+  CHECK(I[12][23] == 7);
+
+  // Strided external memory
+  std::vector<unsigned char> buffer(8 * 16, 0);
+  buffer[3 * 16 + 5] = 42;
+  vpImage<unsigned char> Iext;
+  CHECK_THROWS_AS(Iext.init(&buffer[0], 8, 17, 16, false), vpException);
+  Iext.init(&buffer[0], 8, 10, 16, false);
+  CHECK(Iext[3][5] == 42);
+  Iext.init(&buffer[0], 8, 10, 16, true);
+  CHECK(Iext.isContiguous());
+  CHECK(Iext[3][5] == 42);
+
+  // The copy of a pitched buffer with the same stride stops at the end of
+  // the last row
+  std::vector<unsigned char> pitched(7 * 16 + 10, 0);
+  pitched[7 * 16 + 9] = 43;
+  vpImage<unsigned char> Ialigned;
+  Ialigned.setRowAlignment(16);
+  Ialigned.init(&pitched[0], 8, 10, 16, true);
+  CHECK(Ialigned.getStride() == 16);
+  CHECK(Ialigned[7][9] == 43);
+}
+
+TEST_CASE("Pool allocator", "[image_memory]")
+{
+  vpImagePoolAllocator pool;
+
+  for (unsigned int frame = 0; frame < 10; frame++) {
+    vpImage<unsigned char> I;
+    I.setAllocator(&pool);
+    I.resize(48, 64, 3);
+    CHECK(I.getSum() == Approx(3 * 48 * 64));
+
+    vpImage<vpRGBa> Irgba;
+    Irgba.setAllocator(&pool);
+    Irgba.resize(12, 16);
+    bool is_zero = (Irgba[11][15] == vpRGBa());
+    CHECK(is_zero);
+  }
+  CHECK(pool.getNbReuses() == 18);
+  CHECK(pool.getCachedSize() == 48 * 64 + 12 * 16 * sizeof(vpRGBa));
+
+  {
+    vpImage<unsigned char> I;
+    I.setAllocator(&pool);
+    I.setRowAlignment(32);
+    I.resize(10, 20);
+    CHECK(I.getStride() == 32);
+    CHECK(reinterpret_cast<size_t>(I.bitmap) % 32 == 0);
+  }
+
+  pool.clear();
+  CHECK(pool.getCachedSize() == 0);
+
+  {
+    // The assignment and the copy keep the allocator of the destination
+    vpImage<unsigned char> I(30, 40, 5), I_pool;
+    I_pool.setAllocator(&pool);
+    I_pool = I;
+    CHECK(I_pool.getSum() == Approx(5 * 30 * 40));
+    vpImage<unsigned char> I_copy(I_pool);
+    I_copy = 1;
+  }
+  CHECK(pool.getCachedSize() == 30 * 40);
+  pool.clear();
+
+  vpImagePoolAllocator small_pool(100);
+  {
+    vpImage<unsigned char> I1, I2;
+    I1.setAllocator(&small_pool);
+    I2.setAllocator(&small_pool);
+    I1.resize(5, 10);
+    I2.resize(10, 10);
+  }
+  // Only the first released block fits in the pool
+  CHECK(small_pool.getCachedSize() == 100);
+
+  // A released block is only reused for the same size and a lower alignment
+  vpImagePoolAllocator raw_pool;
+  void *p64 = raw_pool.allocate(1000, 64);
+  CHECK(reinterpret_cast<size_t>(p64) % 64 == 0);
+  raw_pool.deallocate(p64, 1000);
+  void *p16 = raw_pool.allocate(1000, 16);
+  CHECK(p16 == p64);
+  raw_pool.deallocate(p16, 1000);
+  void *p128 = raw_pool.allocate(1000, 128);
+  CHECK(reinterpret_cast<size_t>(p128) % 128 == 0);
+  void *p_other = raw_pool.allocate(1061, 16);
+  CHECK(p128 != p64);
+  CHECK(p_other != p64);
+  CHECK(raw_pool.getNbReuses() == 1);
+  raw_pool.deallocate(p128, 1000);
+  raw_pool.deallocate(p_other, 1061);
+  CHECK(raw_pool.getCachedSize() == 3000 + 61);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,253 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the morphology operators with arbitrary structuring elements.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageMorphologyStructuringElement.cpp
+
+  \brief Check the erosion, dilatation, opening, closing, gradient and top-hat
+  with rectangular, line, cross, disk and user-defined structuring elements
+  against a brute-force implementation.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+
+#include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+// Pixels outside of the image are ignored, that is +inf for the erosion and -inf for the dilatation
+void bruteForce(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, const vpStructuringElement &se,
+                bool erosion)
+{
+  const vpImage<unsigned char> &mask = se.getMask();
+  const int ai = static_cast<int>(se.getAnchorI()), aj = static_cast<int>(se.getAnchorJ());
+  Ires.resize(I.getHeight(), I.getWidth());
+  for (int i = 0; i < static_cast<int>(I.getHeight()); i++) {
+    for (int j = 0; j < static_cast<int>(I.getWidth()); j++) {
+      unsigned char value = erosion ? 255 : 0;
+      for (int mi = 0; mi < static_cast<int>(mask.getHeight()); mi++) {
+        for (int mj = 0; mj < static_cast<int>(mask.getWidth()); mj++) {
+          if (mask[mi][mj] == 0) {
+            continue;
+          }
+          // Erosion: min of I(x + b), dilatation: max of I(x - b)
+          const int ii = erosion ? i + mi - ai : i - (mi - ai);
+          const int jj = erosion ? j + mj - aj : j - (mj - aj);
+          if (ii < 0 || jj < 0 || ii >= static_cast<int>(I.getHeight()) || jj >= static_cast<int>(I.getWidth())) {
+            continue;
+          }
+          value = erosion ? std::min(value, I[ii][jj]) : std::max(value, I[ii][jj]);
+        }
+      }
+      Ires[i][j] = value;
+    }
+  }
+}
+
+bool sameImages(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    if (!std::equal(I1[i], I1[i] + I1.getWidth(), I2[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      I[i][j] = static_cast<unsigned char>(rng.uniform(0, 256));
+    }
+  }
+}
+
+std::vector<vpStructuringElement> structuringElements()
+{
+  std::vector<vpStructuringElement> elements;
+  elements.push_back(vpStructuringElement());
+  elements.push_back(vpStructuringElement::rectangle(15, 15));
+  elements.push_back(vpStructuringElement::rectangle(4, 7));
+  elements.push_back(vpStructuringElement::horizontalLine(21));
+  elements.push_back(vpStructuringElement::verticalLine(6));
+  elements.push_back(vpStructuringElement::rectangle(1, 1));
+  elements.push_back(vpStructuringElement::cross(9));
+  elements.push_back(vpStructuringElement::cross(4));
+  elements.push_back(vpStructuringElement::disk(1));
+  elements.push_back(vpStructuringElement::disk(6));
+
+  // Asymmetric element with an anchor outside of the element
+  vpImage<unsigned char> mask(4, 5, 0);
+  mask[0][0] = mask[0][1] = mask[0][4] = 1;
+  mask[2][2] = mask[2][3] = 1;
+  mask[3][0] = mask[3][1] = mask[3][2] = mask[3][3] = mask[3][4] = 1;
+  elements.push_back(vpStructuringElement(mask, 1, 3));
+  return elements;
+}
+} // namespace
+
+TEST_CASE("Erosion and dilatation against brute force", "[morphology]")
+{
+  vpUniRand rng(1234);
+  const std::vector<vpStructuringElement> elements = structuringElements();
+  const unsigned int sizes[][2] = {{1, 1}, {5, 3}, {37, 61}, {64, 48}};
+
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    vpImage<unsigned char> I;
+    randomImage(I, sizes[n][0], sizes[n][1], rng);
+    for (size_t k = 0; k < elements.size(); k++) {
+      INFO("Image " << sizes[n][0] << "x" << sizes[n][1] << ", element " << k);
+      vpImage<unsigned char> I_res, I_ref;
+      vpImageMorphology::erosion(I, I_res, elements[k]);
+      bruteForce(I, I_ref, elements[k], true);
+      CHECK(sameImages(I_res, I_ref));
+
+      vpImageMorphology::dilatation(I, I_res, elements[k]);
+      bruteForce(I, I_ref, elements[k], false);
+      CHECK(sameImages(I_res, I_ref));
+    }
+  }
+}
+
+TEST_CASE("Compatibility with the connexity operators", "[morphology]")
+{
+  vpUniRand rng(42);
+  vpImage<unsigned char> I;
+  randomImage(I, 45, 70, rng);
+
+  vpImage<unsigned char> I_res, I_ref = I;
+  vpImageMorphology::erosion(I_ref, vpImageMorphology::CONNEXITY_8);
+  vpImageMorphology::erosion(I, I_res, vpStructuringElement::rectangle(3, 3));
+  CHECK(sameImages(I_res, I_ref));
+
+  I_ref = I;
+  vpImageMorphology::dilatation(I_ref, vpImageMorphology::CONNEXITY_4);
+  vpImageMorphology::dilatation(I, I_res, vpStructuringElement::cross(3));
+  CHECK(sameImages(I_res, I_ref));
+
+  // In place
+  I_res = I;
+  vpImageMorphology::erosion(I_res, I_res, vpStructuringElement::cross(3));
+  I_ref = I;
+  vpImageMorphology::erosion(I_ref, vpImageMorphology::CONNEXITY_4);
+  CHECK(sameImages(I_res, I_ref));
+}
+
+TEST_CASE("Opening, closing, gradient and top-hat", "[morphology]")
+{
+  vpUniRand rng(4321);
+  vpImage<unsigned char> I;
+  randomImage(I, 50, 40, rng);
+  const std::vector<vpStructuringElement> elements = structuringElements();
+
+  for (size_t k = 0; k < elements.size(); k++) {
+    INFO("Element " << k);
+    const vpStructuringElement &se = elements[k];
+    vpImage<unsigned char> I_erode, I_dilate, I_ref, I_res;
+    bruteForce(I, I_erode, se, true);
+    bruteForce(I, I_dilate, se, false);
+
+    vpImageMorphology::opening(I, I_res, se);
+    bruteForce(I_erode, I_ref, se, false);
+    CHECK(sameImages(I_res, I_ref));
+    // Anti-extensive
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      CHECK(I_res.bitmap[i] <= I.bitmap[i]);
+    }
+
+    vpImage<unsigned char> I_tophat;
+    vpImageMorphology::topHat(I, I_tophat, se);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      CHECK(I_tophat.bitmap[i] == I.bitmap[i] - I_res.bitmap[i]);
+    }
+
+    vpImageMorphology::closing(I, I_res, se);
+    bruteForce(I_dilate, I_ref, se, true);
+    CHECK(sameImages(I_res, I_ref));
+
+    vpImageMorphology::topHat(I, I_tophat, se, false);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      CHECK(I_tophat.bitmap[i] == I_res.bitmap[i] - I.bitmap[i]);
+    }
+
+    vpImageMorphology::gradient(I, I_res, se);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      CHECK(I_res.bitmap[i] == I_dilate.bitmap[i] - I_erode.bitmap[i]);
+    }
+  }
+}
+
+TEST_CASE("Structuring elements", "[morphology]")
+{
+  const vpStructuringElement disk = vpStructuringElement::disk(2);
+  CHECK(disk.getWidth() == 5);
+  CHECK(disk.getHeight() == 5);
+  CHECK(disk.getShape() == vpStructuringElement::SHAPE_DISK);
+  CHECK(disk.getRuns().size() == 5);
+
+  vpImage<unsigned char> empty_mask(3, 3, 0);
+  CHECK_THROWS_AS(vpStructuringElement(empty_mask), vpException);
+  CHECK_THROWS_AS(vpStructuringElement(vpImage<unsigned char>(3, 3, 1), 3, 0), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,312 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the area and bi-cubic separable image resize.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageResizeSeparable.cpp
+
+  \brief Compare the area and bi-cubic resize of vpImageTools with a
+  per-pixel computation, for grey, color and float images.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+void randomImage(vpImage<vpRGBa> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)));
+  }
+}
+
+// Overlap of the pixel k of the input row with the pixel j of the resized row
+double overlap(unsigned int k, unsigned int j, unsigned int srcSize, unsigned int dstSize)
+{
+  const double begin = j * static_cast<double>(srcSize) / dstSize;
+  const double end = (j + 1) * static_cast<double>(srcSize) / dstSize;
+  return std::max(0.0, std::min<double>(k + 1, end) - std::max<double>(k, begin));
+}
+
+// Mean of the channel c of the input pixels covered by the pixel (i, j)
+double areaRef(const vpImage<unsigned char> &I, unsigned int h, unsigned int w, unsigned int i, unsigned int j,
+               unsigned int nb_channels, unsigned int c)
+{
+  const unsigned int width = I.getWidth() / nb_channels;
+  double sum = 0, area = 0;
+  for (unsigned int k = 0; k < I.getHeight(); k++) {
+    const double oy = overlap(k, i, I.getHeight(), h);
+    for (unsigned int l = 0; oy > 0 && l < width; l++) {
+      const double ox = overlap(l, j, width, w);
+      sum += oy * ox * I[k][nb_channels * l + c];
+      area += oy * ox;
+    }
+  }
+  return sum / area;
+}
+
+// View of a color image as a grey image with 4 times more columns
+void toBytes(const vpImage<vpRGBa> &I, vpImage<unsigned char> &I_bytes)
+{
+  I_bytes.resize(I.getHeight(), 4 * I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    memcpy(I_bytes[i], I[i], 4 * I.getWidth());
+  }
+}
+
+// Per-pixel bi-cubic interpolation of vpImageTools::resize()
+float cubicHermite(float A, float B, float C, float D, float t)
+{
+  const float a = (-A + 3.0f * B - 3.0f * C + D) / 2.0f;
+  const float b = A + 2.0f * C - (5.0f * B + D) / 2.0f;
+  const float c = (-A + C) / 2.0f;
+  return a * t * t * t + b * t * t + c * t + B;
+}
+
+double cubicRef(const vpImage<unsigned char> &I, unsigned int h, unsigned int w, unsigned int i, unsigned int j,
+                unsigned int nb_channels, unsigned int c)
+{
+  const unsigned int width = I.getWidth() / nb_channels;
+  const float v = i * ((I.getHeight() - 1) / static_cast<float>(h - 1));
+  const float u = j * ((width - 1) / static_cast<float>(w - 1));
+  const int v0 = static_cast<int>(v), u0 = static_cast<int>(u);
+  float cols[4];
+  for (int k = 0; k < 4; k++) {
+    const int r = std::max(0, std::min(v0 - 1 + k, static_cast<int>(I.getHeight()) - 1));
+    float p[4];
+    for (int l = 0; l < 4; l++) {
+      const int col = std::max(0, std::min(u0 - 1 + l, static_cast<int>(width) - 1));
+      p[l] = I[r][nb_channels * col + c];
+    }
+    cols[k] = cubicHermite(p[0], p[1], p[2], p[3], u - u0);
+  }
+  return std::max(0.0f, std::min(255.0f, cubicHermite(cols[0], cols[1], cols[2], cols[3], v - v0)));
+}
+
+// Channel c of a color image, as a grey and a float image
+void channel(const vpImage<vpRGBa> &I, unsigned int c, vpImage<unsigned char> &I_grey, vpImage<float> &I_float)
+{
+  I_grey.resize(I.getHeight(), I.getWidth());
+  I_float.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I_grey[i][j] = reinterpret_cast<const unsigned char *>(&I[i][j])[c];
+      I_float[i][j] = I_grey[i][j];
+    }
+  }
+}
+
+bool sameImages(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    for (unsigned int j = 0; j < I1.getWidth(); j++) {
+      if (I1[i][j] != I2[i][j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("Area resize", "[vpImageTools]")
+{
+  vpUniRand rng(1);
+  // Input and resized sizes, including the exact decimations by 2 and 4
+  const unsigned int sizes[][4] = {{64, 96, 32, 48},  {68, 100, 17, 25}, {61, 97, 23, 31}, {40, 50, 73, 64},
+                                   {45, 33, 1, 1},    {7, 9, 7, 9},      {30, 34, 15, 17}, {33, 35, 15, 7},
+                                   {120, 8, 30, 2},   {2, 200, 1, 100}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const unsigned int h = sizes[s][2], w = sizes[s][3];
+    vpImage<unsigned char> I, I_resize;
+    randomImage(I, sizes[s][0], sizes[s][1], rng);
+    vpImageTools::resize(I, I_resize, w, h, vpImageTools::INTERPOLATION_AREA);
+    REQUIRE(I_resize.getHeight() == h);
+    REQUIRE(I_resize.getWidth() == w);
+
+    vpImage<vpRGBa> I_color, I_color_resize;
+    randomImage(I_color, sizes[s][0], sizes[s][1], rng);
+    vpImageTools::resize(I_color, I_color_resize, w, h, vpImageTools::INTERPOLATION_AREA);
+    vpImage<unsigned char> I_color_bytes, I_color_resize_bytes;
+    toBytes(I_color, I_color_bytes);
+    toBytes(I_color_resize, I_color_resize_bytes);
+
+    // Exact rounding of the block means for the decimations
+    const bool exact = (I.getHeight() % h == 0) && (I.getWidth() % w == 0) && I.getHeight() / h == I.getWidth() / w &&
+                       (I.getHeight() / h == 2 || I.getHeight() / h == 4);
+    double max_error = 0;
+    for (unsigned int i = 0; i < h; i++) {
+      for (unsigned int j = 0; j < w; j++) {
+        max_error = std::max(max_error, std::fabs(I_resize[i][j] - areaRef(I, h, w, i, j, 1, 0)));
+        for (unsigned int c = 0; c < 4; c++) {
+          max_error = std::max(max_error, std::fabs(I_color_resize_bytes[i][4 * j + c] -
+                                                    areaRef(I_color_bytes, h, w, i, j, 4, c)));
+        }
+      }
+    }
+    CHECK(max_error <= (exact ? 0.5 : 0.5 + 1e-3));
+  }
+
+  // The area interpolation is only available for the unsigned char and vpRGBa
+  // images
+  vpImage<float> I_float(20, 30, 1.0f), I_float_resize(10, 15, 0.0f);
+  vpImageTools::resize(I_float, I_float_resize, vpImageTools::INTERPOLATION_AREA);
+  CHECK(I_float_resize[5][5] == 0.0f);
+}
+
+TEST_CASE("Bi-cubic resize", "[vpImageTools]")
+{
+  vpUniRand rng(2);
+  const unsigned int sizes[][4] = {{64, 96, 32, 48}, {61, 97, 23, 31}, {40, 50, 73, 111}, {3, 2, 9, 7},
+                                   {20, 30, 2, 2}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const unsigned int h = sizes[s][2], w = sizes[s][3];
+    vpImage<unsigned char> I, I_resize;
+    randomImage(I, sizes[s][0], sizes[s][1], rng);
+    vpImageTools::resize(I, I_resize, w, h, vpImageTools::INTERPOLATION_CUBIC);
+
+    vpImage<vpRGBa> I_color, I_color_resize;
+    randomImage(I_color, sizes[s][0], sizes[s][1], rng);
+    vpImageTools::resize(I_color, I_color_resize, w, h, vpImageTools::INTERPOLATION_CUBIC);
+    vpImage<unsigned char> I_color_bytes, I_color_resize_bytes;
+    toBytes(I_color, I_color_bytes);
+    toBytes(I_color_resize, I_color_resize_bytes);
+
+    double max_error = 0;
+    for (unsigned int i = 0; i < h; i++) {
+      for (unsigned int j = 0; j < w; j++) {
+        max_error = std::max(max_error, std::fabs(I_resize[i][j] - cubicRef(I, h, w, i, j, 1, 0)));
+        for (unsigned int c = 0; c < 4; c++) {
+          max_error = std::max(max_error, std::fabs(I_color_resize_bytes[i][4 * j + c] -
+                                                    cubicRef(I_color_bytes, h, w, i, j, 4, c)));
+        }
+      }
+    }
+    CHECK(max_error <= 0.5 + 1e-3);
+  }
+}
+
+TEST_CASE("Bi-cubic resize against the per-pixel implementation", "[vpImageTools]")
+{
+  // The float images are still resized pixel per pixel, with the bi-cubic
+  // interpolation used for all the images before the separable kernels
+  vpUniRand rng(4);
+  const unsigned int sizes[][4] = {{64, 96, 32, 48}, {61, 97, 23, 31}, {40, 50, 73, 111}, {480, 640, 131, 173}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    const unsigned int h = sizes[s][2], w = sizes[s][3];
+    vpImage<vpRGBa> I_color, I_color_resize;
+    randomImage(I_color, sizes[s][0], sizes[s][1], rng);
+    vpImageTools::resize(I_color, I_color_resize, w, h, vpImageTools::INTERPOLATION_CUBIC);
+
+    // The alpha channel was not resampled by the per-pixel implementation
+    for (unsigned int c = 0; c < 3; c++) {
+      vpImage<unsigned char> I_grey, I_grey_resize;
+      vpImage<float> I_channel, I_channel_resize;
+      channel(I_color, c, I_grey, I_channel);
+      vpImageTools::resize(I_channel, I_channel_resize, w, h, vpImageTools::INTERPOLATION_CUBIC);
+      vpImageTools::resize(I_grey, I_grey_resize, w, h, vpImageTools::INTERPOLATION_CUBIC);
+
+      int max_diff_grey = 0, max_diff_color = 0;
+      for (unsigned int i = 0; i < h; i++) {
+        for (unsigned int j = 0; j < w; j++) {
+          const int ref = vpMath::saturate<unsigned char>(I_channel_resize[i][j]);
+          max_diff_grey = std::max(max_diff_grey, std::abs(I_grey_resize[i][j] - ref));
+          max_diff_color = std::max(
+              max_diff_color, std::abs(reinterpret_cast<const unsigned char *>(&I_color_resize[i][j])[c] - ref));
+        }
+      }
+      CHECK(max_diff_grey <= 1);
+      CHECK(max_diff_color <= 1);
+    }
+  }
+}
+
+TEST_CASE("Resize with threads", "[vpImageTools]")
+{
+  vpUniRand rng(3);
+  vpImage<unsigned char> I;
+  randomImage(I, 480, 640, rng);
+
+  const vpImageTools::vpImageInterpolationType methods[] = {vpImageTools::INTERPOLATION_AREA,
+                                                             vpImageTools::INTERPOLATION_CUBIC};
+  const unsigned int sizes[][2] = {{240, 320}, {120, 160}, {131, 173}};
+  for (int m = 0; m < 2; m++) {
+    for (int s = 0; s < 3; s++) {
+      vpImage<unsigned char> I_resize1, I_resize4;
+      vpImageTools::resize(I, I_resize1, sizes[s][1], sizes[s][0], methods[m], 1);
+      vpImageTools::resize(I, I_resize4, sizes[s][1], sizes[s][0], methods[m], 4);
+      CHECK(sameImages(I_resize1, I_resize4));
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the row-oriented separable filters of vpImageFilter.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageSeparableFilter.cpp
+
+  \brief Check that the row-oriented separable filters of vpImageFilter give
+  the same results than the per-pixel filtering functions.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+bool isEqual(const vpImage<double> &I1, const vpImage<double> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i] != I2.bitmap[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class Type>
+void filterXRef(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  dIx.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < (size - 1) / 2; j++) {
+      dIx[i][j] = vpImageFilter::filterXLeftBorder(I, i, j, filter, size);
+    }
+    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
+      dIx[i][j] = vpImageFilter::filterX(I, i, j, filter, size);
+    }
+    for (unsigned int j = I.getWidth() - (size - 1) / 2; j < I.getWidth(); j++) {
+      dIx[i][j] = vpImageFilter::filterXRightBorder(I, i, j, filter, size);
+    }
+  }
+}
+
+template <class Type>
+void filterYRef(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  dIy.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < (size - 1) / 2; i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      dIy[i][j] = vpImageFilter::filterYTopBorder(I, i, j, filter, size);
+    }
+  }
+  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      dIy[i][j] = vpImageFilter::filterY(I, i, j, filter, size);
+    }
+  }
+  for (unsigned int i = I.getHeight() - (size - 1) / 2; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      dIy[i][j] = vpImageFilter::filterYBottomBorder(I, i, j, filter, size);
+    }
+  }
+}
+
+template <class Type>
+void gradXRef(const vpImage<Type> &I, vpImage<double> &dIx, const double *filter, unsigned int size)
+{
+  dIx.resize(I.getHeight(), I.getWidth(), 0.0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = (size - 1) / 2; j < I.getWidth() - (size - 1) / 2; j++) {
+      dIx[i][j] = vpImageFilter::derivativeFilterX(I, i, j, filter, size);
+    }
+  }
+}
+
+template <class Type>
+void gradYRef(const vpImage<Type> &I, vpImage<double> &dIy, const double *filter, unsigned int size)
+{
+  dIy.resize(I.getHeight(), I.getWidth(), 0.0);
+  for (unsigned int i = (size - 1) / 2; i < I.getHeight() - (size - 1) / 2; i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      dIy[i][j] = vpImageFilter::derivativeFilterY(I, i, j, filter, size);
+    }
+  }
+}
+}
+
+TEST_CASE("Separable filters are bit-exact with the per-pixel functions", "[vpImageFilter]")
+{
+  vpUniRand rng(42);
+  const unsigned int sizes[] = {3, 5, 7, 11};
+  const unsigned int dims[][2] = {{23, 31}, {48, 64}, {17, 13}};
+
+  for (size_t d = 0; d < sizeof(dims) / sizeof(dims[0]); d++) {
+    vpImage<unsigned char> I;
+    randomImage(I, dims[d][0], dims[d][1], rng);
+    vpImage<double> Id;
+    vpImageConvert::convert(I, Id);
+
+    for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+      const unsigned int size = sizes[s];
+      std::vector<double> fg((size + 1) / 2), fgd((size + 1) / 2);
+      vpImageFilter::getGaussianKernel(&fg[0], size);
+      vpImageFilter::getGaussianDerivativeKernel(&fgd[0], size);
+
+      vpImage<double> res, ref;
+      vpImageFilter::filterX(I, res, &fg[0], size);
+      filterXRef(I, ref, &fg[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::filterX(Id, res, &fg[0], size);
+      filterXRef(Id, ref, &fg[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::filterY(I, res, &fg[0], size);
+      filterYRef(I, ref, &fg[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::filterY(Id, res, &fg[0], size);
+      filterYRef(Id, ref, &fg[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::getGradX(I, res, &fgd[0], size);
+      gradXRef(I, ref, &fgd[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::getGradX(Id, res, &fgd[0], size);
+      gradXRef(Id, ref, &fgd[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::getGradY(I, res, &fgd[0], size);
+      gradYRef(I, ref, &fgd[0], size);
+      CHECK(isEqual(res, ref));
+
+      vpImageFilter::getGradY(Id, res, &fgd[0], size);
+      gradYRef(Id, ref, &fgd[0], size);
+      CHECK(isEqual(res, ref));
+    }
+  }
+}
+
+TEST_CASE("Fixed-point Gaussian blur", "[vpImageFilter]")
+{
+  vpUniRand rng(7);
+  vpImage<unsigned char> I;
+  randomImage(I, 61, 83, rng);
+
+  const unsigned int sizes[] = {3, 5, 7, 9};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<double> GId;
+    vpImage<unsigned char> GI;
+    vpImageFilter::gaussianBlur(I, GId, sizes[s]);
+    vpImageFilter::gaussianBlur(I, GI, sizes[s]);
+
+    REQUIRE(GI.getHeight() == I.getHeight());
+    REQUIRE(GI.getWidth() == I.getWidth());
+    double max_error = 0;
+    for (unsigned int i = 0; i < GI.getSize(); i++) {
+      max_error = std::max(max_error, std::fabs(GI.bitmap[i] - GId.bitmap[i]));
+    }
+    std::cout << "Gaussian blur " << sizes[s] << "x" << sizes[s] << " fixed-point max error: " << max_error
+              << std::endl;
+    CHECK(max_error <= 1.5);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,217 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the coarse-to-fine template matching.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageTemplateMatchingPyramid.cpp
+
+  \brief Check the pyramid template matching of vpImageTools against the
+  exhaustive search, with several templates and sub-pixel refinement.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+// Smooth analytic intensity, so that the templates can be sampled at sub-pixel locations
+double intensity(double i, double j)
+{
+  return 128 + 50 * sin(0.11 * i + 0.05 * j) * cos(0.07 * j - 0.03 * i) + 40 * sin(0.023 * i * j / 40 + 0.3) +
+         30 * cos(0.17 * j + 0.9);
+}
+
+void analyticImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, double i0 = 0, double j0 = 0)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      I[i][j] = static_cast<unsigned char>(vpMath::round(intensity(i0 + i, j0 + j)));
+    }
+  }
+}
+
+// Random texture whose details are larger than scale pixels
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, unsigned int scale, vpUniRand &rng)
+{
+  vpImage<unsigned char> I_noise(h / scale, w / scale), I_up;
+  for (unsigned int i = 0; i < I_noise.getSize(); i++) {
+    I_noise.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+  vpImageTools::resize(I_noise, I_up, w, h, vpImageTools::INTERPOLATION_LINEAR);
+  vpImageFilter::gaussianBlur(I_up, I, 5);
+}
+
+void crop(const vpImage<unsigned char> &I, unsigned int i0, unsigned int j0, unsigned int h, unsigned int w,
+          vpImage<unsigned char> &I_crop)
+{
+  I_crop.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      I_crop[i][j] = I[i0 + i][j0 + j];
+    }
+  }
+}
+
+// Location of the maximum of the score of the exhaustive template matching
+vpImagePoint exhaustiveMaximum(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I_tpl, double &score)
+{
+  vpImage<double> I_score;
+  vpImageTools::templateMatching(I, I_tpl, I_score, 1, 1);
+  vpImagePoint ip;
+  score = -2;
+  for (unsigned int i = 0; i < I_score.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_score.getWidth(); j++) {
+      if (I_score[i][j] > score) {
+        score = I_score[i][j];
+        ip.set_ij(i, j);
+      }
+    }
+  }
+  return ip;
+}
+} // namespace
+
+TEST_CASE("Exhaustive search", "[template_matching]")
+{
+  vpUniRand rng(1234);
+  vpImage<unsigned char> I, I_tpl;
+  randomImage(I, 120, 160, 1, rng);
+  crop(I, 37, 81, 24, 32, I_tpl);
+
+  vpImagePoint ip;
+  const double score = vpImageTools::templateMatching(I, I_tpl, ip, 1);
+  CHECK(ip == vpImagePoint(37, 81));
+  CHECK(score == Approx(1.0).margin(1e-9));
+
+  double score_ref = 0;
+  CHECK(ip == exhaustiveMaximum(I, I_tpl, score_ref));
+  CHECK(score == Approx(score_ref).margin(1e-9));
+}
+
+TEST_CASE("Pyramid search of several templates", "[template_matching]")
+{
+  vpUniRand rng(4321);
+  vpImage<unsigned char> I;
+  randomImage(I, 480, 640, 8, rng);
+
+  const unsigned int locations[][2] = {{0, 0}, {100, 300}, {250, 17}, {391, 543}};
+  std::vector<vpImage<unsigned char> > I_tpls(4);
+  for (size_t k = 0; k < I_tpls.size(); k++) {
+    crop(I, locations[k][0], locations[k][1], 64 + 8 * static_cast<unsigned int>(k), 80, I_tpls[k]);
+  }
+
+  std::vector<vpImagePoint> ips;
+  std::vector<double> scores;
+  vpImageTools::templateMatching(I, I_tpls, ips, scores, 4);
+  REQUIRE(ips.size() == I_tpls.size());
+  REQUIRE(scores.size() == I_tpls.size());
+  for (size_t k = 0; k < I_tpls.size(); k++) {
+    CHECK(ips[k] == vpImagePoint(locations[k][0], locations[k][1]));
+    CHECK(scores[k] == Approx(1.0).margin(1e-9));
+  }
+}
+
+TEST_CASE("Pyramid search with all the candidates is exhaustive", "[template_matching]")
+{
+  vpUniRand rng(42);
+  vpImage<unsigned char> I, I_tpl;
+  randomImage(I, 96, 128, 2, rng);
+  crop(I, 40, 50, 32, 32, I_tpl);
+  // Noisy template, so that the best match is not a perfect one
+  for (unsigned int i = 0; i < I_tpl.getSize(); i++) {
+    I_tpl.bitmap[i] = static_cast<unsigned char>(vpMath::saturate<unsigned char>(I_tpl.bitmap[i] + rng.uniform(-60, 61)));
+  }
+
+  double score_ref = 0;
+  const vpImagePoint ip_ref = exhaustiveMaximum(I, I_tpl, score_ref);
+
+  vpImagePoint ip;
+  const double score = vpImageTools::templateMatching(I, I_tpl, ip, 3, I.getSize());
+  CHECK(ip == ip_ref);
+  CHECK(score == Approx(score_ref).margin(1e-9));
+}
+
+TEST_CASE("Sub-pixel refinement", "[template_matching]")
+{
+  vpImage<unsigned char> I, I_tpl;
+  analyticImage(I, 240, 320);
+  const double i0 = 101.3, j0 = 57.6;
+  analyticImage(I_tpl, 40, 48, i0, j0);
+
+  vpImagePoint ip;
+  vpImageTools::templateMatching(I, I_tpl, ip, 3, 16, false);
+  CHECK(ip == vpImagePoint(vpMath::round(i0), vpMath::round(j0)));
+
+  const double score = vpImageTools::templateMatching(I, I_tpl, ip, 3, 16, true);
+  CHECK(ip.get_i() == Approx(i0).margin(0.15));
+  CHECK(ip.get_j() == Approx(j0).margin(0.15));
+  CHECK(score > 0.99);
+}
+
+TEST_CASE("Invalid inputs", "[template_matching]")
+{
+  vpImage<unsigned char> I(20, 20, 0), I_tpl(20, 10, 0), I_empty;
+  vpImagePoint ip;
+  CHECK_THROWS_AS(vpImageTools::templateMatching(I, I_tpl, ip), vpException);
+  CHECK_THROWS_AS(vpImageTools::templateMatching(I, I_empty, ip), vpException);
+  I_tpl.resize(10, 10, 0);
+  CHECK_THROWS_AS(vpImageTools::templateMatching(I, I_tpl, ip, 0), vpException);
+  CHECK_THROWS_AS(vpImageTools::templateMatching(I, I_tpl, ip, 3, 0), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,274 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the zero-copy views on a region of interest.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testImageView.cpp
+
+  \brief Check that the image processing functions give the same results on a
+  vpImageView and on a cropped copy of the same region.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpHistogram.h>
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      I[i][j] = static_cast<unsigned char>(rng.uniform(0, 256));
+    }
+  }
+}
+
+template <class Type> bool isEqual(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getHeight(); i++) {
+    if (memcmp(I1[i], I2[i], I1.getWidth() * sizeof(Type)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+TEST_CASE("View construction", "[image_view]")
+{
+  vpImage<unsigned char> I(60, 80, 3);
+
+  vpImageView<unsigned char> roi(I, vpRect(70, 50, 20, 30));
+  CHECK(roi.getTop() == 50);
+  CHECK(roi.getLeft() == 70);
+  CHECK(roi.getWidth() == 10);
+  CHECK(roi.getHeight() == 10);
+  CHECK(roi[0] == I[50] + 70);
+
+  vpImageView<unsigned char> outside(I, vpRect(100, 100, 20, 20));
+  CHECK(outside.getSize() == 0);
+
+  CHECK_THROWS_AS(vpImageView<unsigned char>(I, 50, 70, 11, 10), vpException);
+
+  // The copy of a view refers to the same pixels
+  vpImageView<unsigned char> roi_copy(roi);
+  roi_copy = 9;
+  CHECK(I[59][79] == 9);
+  CHECK(I[49][79] == 3);
+
+  // Assigning an image copies the pixels in the parent
+  vpImage<unsigned char> patch(10, 10, 7);
+  roi = patch;
+  CHECK(I[50][70] == 7);
+  CHECK_THROWS_AS(roi = vpImage<unsigned char>(5, 5), vpException);
+}
+
+TEST_CASE("Functions on views", "[image_view]")
+{
+  vpUniRand rng(4);
+  vpImage<unsigned char> I;
+  randomImage(I, 120, 160, rng);
+  const vpRect rect(13, 21, 101, 67);
+
+  vpImageView<unsigned char> roi(I, rect);
+  vpImage<unsigned char> I_crop;
+  vpImageTools::crop(I, rect, I_crop);
+  REQUIRE(isEqual<unsigned char>(roi, I_crop));
+
+  SECTION("Filtering")
+  {
+    vpImage<unsigned char> blur_view, blur_crop;
+    vpImageFilter::gaussianBlur(roi, blur_view, 7);
+    vpImageFilter::gaussianBlur(I_crop, blur_crop, 7);
+    CHECK(isEqual(blur_view, blur_crop));
+
+    vpImage<double> dIx_view, dIx_crop;
+    vpImageFilter::getGradX(roi, dIx_view);
+    vpImageFilter::getGradX(I_crop, dIx_crop);
+    CHECK(isEqual(dIx_view, dIx_crop));
+  }
+
+  SECTION("Conversion")
+  {
+    vpImage<vpRGBa> rgba_view, rgba_crop;
+    vpImageConvert::convert(roi, rgba_view);
+    vpImageConvert::convert(I_crop, rgba_crop);
+    CHECK(isEqual(rgba_view, rgba_crop));
+
+    vpImage<float> f_view, f_crop;
+    vpImageConvert::convert(roi, f_view);
+    vpImageConvert::convert(I_crop, f_crop);
+    CHECK(isEqual(f_view, f_crop));
+
+    vpImage<unsigned char> R_view;
+    vpImageConvert::split(rgba_view, &R_view, NULL, NULL, NULL);
+    CHECK(isEqual(R_view, I_crop));
+
+    // Conversion of a color view to a grey view writes in the parent
+    vpImage<vpRGBa> I_color;
+    vpImageConvert::convert(I, I_color);
+    vpImageView<vpRGBa> color_roi(I_color, rect);
+    vpImage<unsigned char> I_dst(I.getHeight(), I.getWidth(), 0);
+    vpImageView<unsigned char> dst_roi(I_dst, rect);
+    vpImageConvert::convert(color_roi, dst_roi);
+    vpImage<unsigned char> I_grey;
+    vpImageConvert::convert(I_color, I_grey);
+    CHECK(I_dst[21][13] == I_grey[21][13]);
+    CHECK(I_dst[87][113] == I_grey[87][113]);
+    CHECK(I_dst[20][13] == 0);
+  }
+
+  SECTION("Resize")
+  {
+    const vpImageTools::vpImageInterpolationType methods[] = {vpImageTools::INTERPOLATION_NEAREST,
+                                                               vpImageTools::INTERPOLATION_LINEAR,
+                                                               vpImageTools::INTERPOLATION_CUBIC,
+                                                               vpImageTools::INTERPOLATION_AREA};
+    for (size_t k = 0; k < sizeof(methods) / sizeof(methods[0]); k++) {
+      vpImage<unsigned char> resize_view, resize_crop;
+      vpImageTools::resize(roi, resize_view, 43, 31, methods[k]);
+      vpImageTools::resize(I_crop, resize_crop, 43, 31, methods[k]);
+      CHECK(isEqual(resize_view, resize_crop));
+    }
+  }
+
+  SECTION("Arithmetic")
+  {
+    vpImage<unsigned char> I2;
+    randomImage(I2, I_crop.getHeight(), I_crop.getWidth(), rng);
+    vpImage<unsigned char> diff_view, diff_crop;
+    vpImageTools::imageDifference(roi, I2, diff_view);
+    vpImageTools::imageDifference(I_crop, I2, diff_crop);
+    CHECK(isEqual(diff_view, diff_crop));
+    vpImageTools::imageDifferenceAbsolute(roi, I2, diff_view);
+    vpImageTools::imageDifferenceAbsolute(I_crop, I2, diff_crop);
+    CHECK(isEqual(diff_view, diff_crop));
+    vpImageTools::imageAdd(roi, I2, diff_view, true);
+    vpImageTools::imageAdd(I_crop, I2, diff_crop, true);
+    CHECK(isEqual(diff_view, diff_crop));
+    vpImageTools::imageSubtract(roi, I2, diff_view);
+    vpImageTools::imageSubtract(I_crop, I2, diff_crop);
+    CHECK(isEqual(diff_view, diff_crop));
+
+    vpImage<vpRGBa> I_color, I2_color, I_color_crop;
+    vpImageConvert::convert(I, I_color);
+    vpImageConvert::convert(I2, I2_color);
+    vpImageView<vpRGBa> color_roi(I_color, rect);
+    vpImageTools::crop(I_color, rect, I_color_crop);
+    vpImage<vpRGBa> diff_color_view, diff_color_crop;
+    vpImageTools::imageDifference(color_roi, I2_color, diff_color_view);
+    vpImageTools::imageDifference(I_color_crop, I2_color, diff_color_crop);
+    CHECK(isEqual(diff_color_view, diff_color_crop));
+
+    vpImage<double> I_double, I2_double, I_double_crop;
+    vpImageConvert::convert(I, I_double);
+    vpImageConvert::convert(I2, I2_double);
+    vpImageView<double> double_roi(I_double, rect);
+    vpImageTools::crop(I_double, rect, I_double_crop);
+    CHECK(vpImageTools::normalizedCorrelation(double_roi, I2_double) ==
+          Approx(vpImageTools::normalizedCorrelation(I_double_crop, I2_double)));
+  }
+
+  SECTION("Morphology")
+  {
+    vpImageMorphology::erosion(roi, vpImageMorphology::CONNEXITY_8);
+    vpImageMorphology::erosion(I_crop, vpImageMorphology::CONNEXITY_8);
+    CHECK(isEqual<unsigned char>(roi, I_crop));
+    vpImageMorphology::dilatation(roi, vpImageMorphology::CONNEXITY_4);
+    vpImageMorphology::dilatation(I_crop, vpImageMorphology::CONNEXITY_4);
+    CHECK(isEqual<unsigned char>(roi, I_crop));
+  }
+
+  SECTION("Undistortion")
+  {
+    vpCameraParameters cam;
+    cam.initPersProjWithDistortion(150, 150, 50, 33, -0.4, 0.4);
+    vpImage<unsigned char> undist_view, undist_crop;
+    vpImageTools::undistort(roi, cam, undist_view);
+    vpImageTools::undistort(I_crop, cam, undist_crop);
+    CHECK(isEqual(undist_view, undist_crop));
+  }
+
+  SECTION("In-place processing")
+  {
+    vpImageTools::binarise(roi, (unsigned char)100, (unsigned char)200, (unsigned char)0, (unsigned char)128,
+                           (unsigned char)255);
+    vpImageTools::binarise(I_crop, (unsigned char)100, (unsigned char)200, (unsigned char)0, (unsigned char)128,
+                           (unsigned char)255);
+    CHECK(isEqual<unsigned char>(roi, I_crop));
+
+    vpHistogram hist;
+    hist.calculate(roi, 256, 4);
+    unsigned int nb = 0;
+    for (unsigned int k = 0; k < 256; k++) {
+      nb += hist[k];
+    }
+    CHECK(nb == roi.getSize());
+    CHECK(hist[128] > 0);
+    CHECK(hist[1] == 0);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
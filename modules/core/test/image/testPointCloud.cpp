@@ -0,0 +1,134 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the organized point cloud stored as packed floats.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testPointCloud.cpp
+
+  \brief Test the owned and wrapped buffers of vpPointCloud and the conversion
+  from and to a vector of column vectors.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpPointCloud.h>
+
+TEST_CASE("Wrapped buffer", "[point_cloud]")
+{
+  // Points aligned on 4 floats, as in pcl::PointCloud<pcl::PointXYZ>
+  std::vector<float> buffer(4 * 6);
+  for (size_t k = 0; k < buffer.size(); k++) {
+    buffer[k] = static_cast<float>(k);
+  }
+
+  vpPointCloud cloud(&buffer[0], 2, 3, 4);
+  CHECK(!cloud.isOwner());
+  CHECK(cloud.getData() == &buffer[0]);
+  CHECK(cloud.getWritableData() == NULL);
+  CHECK(cloud.getSize() == 6);
+  CHECK(cloud[4][0] == 16);
+  CHECK(cloud[4][2] == 18);
+
+  // The copy wraps the same buffer
+  vpPointCloud cloud_copy(cloud);
+  CHECK(cloud_copy.getData() == &buffer[0]);
+  CHECK(cloud_copy.getStep() == 4);
+
+  CHECK_THROWS_AS(cloud.init(&buffer[0], 2, 3, 2), vpException);
+  CHECK_THROWS_AS(cloud.init(NULL, 2, 3), vpException);
+
+  // Resizing allocates a packed buffer
+  cloud.resize(2, 3);
+  CHECK(cloud.isOwner());
+  CHECK(cloud.getStep() == 3);
+  CHECK(cloud[5][2] == 0);
+  REQUIRE(cloud.getWritableData() != NULL);
+  cloud.getWritableData()[3 * 5 + 2] = 2.5f;
+  CHECK(cloud[5][2] == 2.5f);
+}
+
+TEST_CASE("Owned buffer", "[point_cloud]")
+{
+  std::vector<vpColVector> point_cloud(12, vpColVector(4, 1));
+  for (size_t n = 0; n < point_cloud.size(); n++) {
+    point_cloud[n][0] = 0.5 * n;
+    point_cloud[n][1] = -0.25 * n;
+    point_cloud[n][2] = 1.0 + n;
+  }
+
+  vpPointCloud cloud;
+  CHECK_THROWS_AS(cloud.buildFrom(point_cloud, 5, 2), vpException);
+  cloud.buildFrom(point_cloud, 3, 4);
+  CHECK(cloud.isOwner());
+  CHECK(cloud.getHeight() == 3);
+  CHECK(cloud.getWidth() == 4);
+  CHECK(cloud[7][1] == Approx(-1.75));
+
+  // The copy owns its own buffer
+  vpPointCloud cloud_copy = cloud;
+  CHECK(cloud_copy.getData() != cloud.getData());
+  cloud_copy.getWritableData()[3 * 7 + 1] = 3;
+  CHECK(cloud[7][1] == Approx(-1.75));
+
+  std::vector<vpColVector> point_cloud_converted;
+  cloud.convert(point_cloud_converted);
+  REQUIRE(point_cloud_converted.size() == point_cloud.size());
+  for (size_t n = 0; n < point_cloud.size(); n++) {
+    for (unsigned int k = 0; k < 4; k++) {
+      CHECK(point_cloud_converted[n][k] == Approx(point_cloud[n][k]));
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
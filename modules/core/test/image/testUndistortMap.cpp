@@ -0,0 +1,319 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the fixed-point undistortion map.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testUndistortMap.cpp
+
+  \brief Check vpUndistortMap against vpImageTools::remap(), including the
+  combined undistortion, resize and crop, and the save / load to disk.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpUndistortMap.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void smoothImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      I[i][j] = static_cast<unsigned char>(127.5 + 80 * sin(0.05 * i) * cos(0.07 * j) + rng.uniform(-40, 40));
+    }
+  }
+}
+
+void colorImage(vpImage<vpRGBa> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(rng.uniform(0, 256)), static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)), static_cast<unsigned char>(rng.uniform(0, 256)));
+  }
+}
+
+bool isEqual(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (I1.bitmap[i] != I2.bitmap[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Bilinear interpolation in double at the distorted location of an undistorted point
+bool undistortedValue(const vpImage<unsigned char> &I, const vpCameraParameters &cam, double u, double v,
+                      double &value)
+{
+  const double du = u - cam.get_u0(), dv = v - cam.get_v0();
+  const double r = 1 + cam.get_kud() * (vpMath::sqr(du / cam.get_px()) + vpMath::sqr(dv / cam.get_py()));
+  const double ud = du * r + cam.get_u0(), vd = dv * r + cam.get_v0();
+  if (ud < 0 || vd < 0 || ud >= I.getWidth() - 1 || vd >= I.getHeight() - 1) {
+    return false;
+  }
+  const unsigned int x = static_cast<unsigned int>(ud), y = static_cast<unsigned int>(vd);
+  const double fx = ud - x, fy = vd - y;
+  value = (1 - fy) * ((1 - fx) * I[y][x] + fx * I[y][x + 1]) + fy * ((1 - fx) * I[y + 1][x] + fx * I[y + 1][x + 1]);
+  return true;
+}
+} // namespace
+
+TEST_CASE("Undistortion map vs remap", "[vpUndistortMap]")
+{
+  vpUniRand rng(1234);
+  const unsigned int h = 121, w = 163; // width not multiple of the SIMD width
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(150, 155, 80.5, 61.2, -0.25, 0.28);
+
+  vpImage<unsigned char> I;
+  smoothImage(I, h, w, rng);
+
+  vpArray2D<int> mapU, mapV;
+  vpArray2D<float> mapDu, mapDv;
+  vpImageTools::initUndistortMap(cam, w, h, mapU, mapV, mapDu, mapDv);
+  vpImage<unsigned char> Iref;
+  vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, Iref);
+
+  vpUndistortMap map(cam, w, h);
+  CHECK(map.getWidth() == w);
+  CHECK(map.getHeight() == h);
+  vpImage<unsigned char> Iundist;
+  vpImageTools::remap(I, map, Iundist);
+  REQUIRE(Iundist.getWidth() == w);
+  REQUIRE(Iundist.getHeight() == h);
+
+  int max_error = 0;
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      // remap() truncates the coordinates, only compare fully inside locations
+      if (mapU[i][j] >= 0 && mapV[i][j] >= 0 && mapDu[i][j] >= 0 && mapDv[i][j] >= 0 &&
+          mapU[i][j] < static_cast<int>(w) - 1 && mapV[i][j] < static_cast<int>(h) - 1) {
+        max_error = std::max(max_error, std::abs(Iundist[i][j] - Iref[i][j]));
+      }
+    }
+  }
+  std::cout << "Max difference with remap(): " << max_error << std::endl;
+  CHECK(max_error <= 2);
+
+  SECTION("Color images")
+  {
+    vpImage<vpRGBa> Icolor, Icolor_undist;
+    colorImage(Icolor, h, w, rng);
+    map.remap(Icolor, Icolor_undist);
+
+    // Each channel is interpolated as a grayscale image
+    vpImage<unsigned char> channels[4], channels_undist[4];
+    for (unsigned int c = 0; c < 4; c++) {
+      channels[c].resize(h, w);
+    }
+    vpImageConvert::split(Icolor, &channels[0], &channels[1], &channels[2], &channels[3]);
+    for (unsigned int c = 0; c < 4; c++) {
+      map.remap(channels[c], channels_undist[c]);
+    }
+    bool same = true;
+    for (unsigned int i = 0; i < Icolor_undist.getSize(); i++) {
+      const vpRGBa &p = Icolor_undist.bitmap[i];
+      same = same && p.R == channels_undist[0].bitmap[i] && p.G == channels_undist[1].bitmap[i] &&
+             p.B == channels_undist[2].bitmap[i] && p.A == channels_undist[3].bitmap[i];
+    }
+    CHECK(same);
+  }
+
+  SECTION("Views and aligned rows")
+  {
+    vpImage<unsigned char> I_parent(h + 20, w + 30, 0);
+    vpImageView<unsigned char> I_view(I_parent, 10, 17, h, w);
+    I_view = I;
+    vpImage<unsigned char> Iundist_view;
+    map.remap(I_view, Iundist_view);
+    CHECK(isEqual(Iundist_view, Iundist));
+
+    vpImage<vpRGBa> Icolor, Icolor_aligned, Icolor_undist, Icolor_aligned_undist;
+    colorImage(Icolor, h, w, rng);
+    Icolor_aligned.setRowAlignment(64);
+    Icolor_aligned.resize(h, w);
+    for (unsigned int i = 0; i < h; i++) {
+      memcpy(Icolor_aligned[i], Icolor[i], w * sizeof(vpRGBa));
+    }
+    REQUIRE(!Icolor_aligned.isContiguous());
+    map.remap(Icolor, Icolor_undist);
+    map.remap(Icolor_aligned, Icolor_aligned_undist);
+    bool same = true;
+    for (unsigned int i = 0; i < h; i++) {
+      same = same && memcmp(Icolor_undist[i], Icolor_aligned_undist[i], w * sizeof(vpRGBa)) == 0;
+    }
+    CHECK(same);
+  }
+
+  SECTION("Wrong input size")
+  {
+    vpImage<unsigned char> I2(h, w + 1);
+    CHECK_THROWS_AS(map.remap(I2, Iundist), vpException);
+    vpUndistortMap empty;
+    CHECK_THROWS_AS(empty.remap(I, Iundist), vpException);
+  }
+}
+
+TEST_CASE("Undistortion map with resize and crop", "[vpUndistortMap]")
+{
+  vpUniRand rng(4321);
+  const unsigned int h = 240, w = 320;
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(300, 300, 162.3, 118.6, 0.2, -0.19);
+
+  vpImage<unsigned char> I;
+  smoothImage(I, h, w, rng);
+
+  vpUndistortMap map(cam, w, h);
+  vpImage<unsigned char> Iundist;
+  map.remap(I, Iundist);
+
+  SECTION("Crop without resize")
+  {
+    const vpRect roi(37, 21, 200, 150);
+    vpUndistortMap map_crop;
+    map_crop.init(cam, w, h, 200, 150, roi);
+    vpImage<unsigned char> Icrop, Icrop_ref;
+    map_crop.remap(I, Icrop);
+    vpImageTools::crop(Iundist, roi, Icrop_ref);
+    CHECK(isEqual(Icrop, Icrop_ref));
+  }
+
+  SECTION("Crop and resize")
+  {
+    const vpRect roi(40.5, 30, 160, 120);
+    const unsigned int dst_w = 97, dst_h = 61;
+    vpUndistortMap map_resize;
+    map_resize.init(cam, w, h, dst_w, dst_h, roi);
+    CHECK(map_resize.getSourceWidth() == w);
+    CHECK(map_resize.getSourceHeight() == h);
+    vpImage<unsigned char> Ires;
+    map_resize.remap(I, Ires);
+    REQUIRE(Ires.getWidth() == dst_w);
+    REQUIRE(Ires.getHeight() == dst_h);
+
+    double max_error = 0;
+    for (unsigned int i = 0; i < dst_h; i++) {
+      for (unsigned int j = 0; j < dst_w; j++) {
+        const double u = roi.getLeft() + (j + 0.5) * roi.getWidth() / dst_w - 0.5;
+        const double v = roi.getTop() + (i + 0.5) * roi.getHeight() / dst_h - 0.5;
+        double value = 0;
+        if (undistortedValue(I, cam, u, v, value)) {
+          max_error = std::max(max_error, std::fabs(Ires[i][j] - value));
+        }
+      }
+    }
+    std::cout << "Crop and resize max error: " << max_error << std::endl;
+    CHECK(max_error <= 1.5);
+  }
+}
+
+TEST_CASE("Undistortion map save / load", "[vpUndistortMap]")
+{
+  vpUniRand rng(42);
+  const unsigned int h = 60, w = 90;
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(100, 100, 45, 30, -0.3, 0.33);
+
+  vpImage<unsigned char> I;
+  smoothImage(I, h, w, rng);
+
+#if defined(_WIN32)
+  std::string tmp_dir = "C:/temp/";
+#else
+  std::string tmp_dir = "/tmp/";
+#endif
+  tmp_dir += vpIoTools::getUserName() + "/test_undistort_map/";
+  vpIoTools::makeDirectory(tmp_dir);
+  const std::string filename = tmp_dir + "map.bin";
+
+  vpUndistortMap map;
+  map.init(cam, w, h, w / 2, h / 2);
+  map.save(filename);
+
+  vpUndistortMap map_loaded;
+  map_loaded.load(filename);
+  CHECK(map_loaded.getSourceWidth() == w);
+  CHECK(map_loaded.getSourceHeight() == h);
+  CHECK(map_loaded.getWidth() == w / 2);
+  CHECK(map_loaded.getHeight() == h / 2);
+
+  vpImage<unsigned char> I1, I2;
+  map.remap(I, I1);
+  map_loaded.remap(I, I2);
+  CHECK(isEqual(I1, I2));
+
+  // Invalid files
+  CHECK_THROWS_AS(map_loaded.load(tmp_dir + "missing.bin"), vpException);
+  {
+    std::ofstream file((tmp_dir + "invalid.bin").c_str(), std::ios::binary);
+    file << "not a map";
+  }
+  CHECK_THROWS_AS(map_loaded.load(tmp_dir + "invalid.bin"), vpException);
+
+  vpIoTools::remove(tmp_dir);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
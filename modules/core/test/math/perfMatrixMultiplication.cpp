@@ -40,6 +40,8 @@
 #define CATCH_CONFIG_RUNNER
 #include <catch.hpp>
 
+#include <limits>
+
 #include <visp3/core/vpMatrix.h>
 
 #if (VISP_HAVE_OPENCV_VERSION >= 0x030000)
@@ -857,6 +859,26 @@ TEST_CASE("Benchmark matrix-force twist multiplication", "[benchmark]") {
   }
 }
 
+TEST_CASE("Built-in matrix products without Lapack", "[matrix]") {
+  // Force the built-in blocked code, whatever the available third-parties
+  const unsigned int lapackMinSize = vpMatrix::getLapackMatrixMinSize();
+  vpMatrix::setLapackMatrixMinSize(std::numeric_limits<unsigned int>::max());
+
+  std::vector<std::pair<int, int>> sizes = { {1, 1}, {3, 5}, {6, 6}, {20, 20}, {6, 300}, {300, 6}, {47, 63}, {129, 257}, {300, 600} };
+  for (auto sz : sizes) {
+    vpMatrix A = generateRandomMatrix(sz.first, sz.second);
+    vpMatrix B = generateRandomMatrix(sz.second, sz.first + 3);
+    vpColVector v = generateRandomVector(sz.second);
+
+    CHECK(equalMatrix(A * B, dgemm_regular(A, B)));
+    CHECK(equalMatrix(A.AtA(), AtA_regular(A)));
+    CHECK(equalMatrix(A.AAt(), AAt_regular(A)));
+    CHECK(equalMatrix(A * v, dgemv_regular(A, v)));
+  }
+
+  vpMatrix::setLapackMatrixMinSize(lapackMinSize);
+}
+
 int main(int argc, char *argv[])
 {
   Catch::Session session; // There must be exactly one instance
@@ -0,0 +1,200 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test vpMatrixFixed and the geometry computations using it.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMatrixFixed.cpp
+
+  Test vpMatrixFixed against vpMatrix, and the homogeneous matrix, twist and
+  exponential map computations that use it.
+*/
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpHomogeneousMatrix.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/core/vpVelocityTwistMatrix.h>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+namespace
+{
+template <unsigned int R, unsigned int C> vpMatrixFixed<R, C> randomMatrix(vpUniRand &rng)
+{
+  vpMatrixFixed<R, C> A;
+  for (unsigned int i = 0; i < R * C; i++) {
+    A.data[i] = rng.uniform(-1.0, 1.0);
+  }
+  return A;
+}
+
+bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, double tol = 1e-12)
+{
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); i++) {
+    if (!vpMath::equal(A.data[i], B.data[i], tol)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <unsigned int N> void checkInverse(vpUniRand &rng)
+{
+  vpMatrixFixed<N, N> A = randomMatrix<N, N>(rng);
+  for (unsigned int i = 0; i < N; i++) {
+    A[i][i] += N; // Well conditioned
+  }
+  vpMatrixFixed<N, N> I;
+  I.eye();
+
+  vpMatrix AAi, Id;
+  (A * A.inverse()).copyTo(AAi);
+  I.copyTo(Id);
+  CHECK(equal(AAi, Id, 1e-10));
+}
+} // namespace
+
+TEST_CASE("vpMatrixFixed operations", "[vpMatrixFixed]")
+{
+  vpUniRand rng(12);
+  const vpMatrixFixed<3, 5> A = randomMatrix<3, 5>(rng);
+  const vpMatrixFixed<5, 2> B = randomMatrix<5, 2>(rng);
+
+  vpMatrix A_dyn, B_dyn, AB, At;
+  A.copyTo(A_dyn);
+  B.copyTo(B_dyn);
+  CHECK(A_dyn.getRows() == 3);
+  CHECK(A_dyn.getCols() == 5);
+
+  (A * B).copyTo(AB);
+  CHECK(equal(AB, A_dyn * B_dyn));
+
+  A.t().copyTo(At);
+  CHECK(equal(At, A_dyn.t()));
+
+  vpMatrix S;
+  (A + A * 2.0 - A).copyTo(S);
+  CHECK(equal(S, A_dyn * 2.0));
+
+  const vpMatrixFixed<3, 5> A_copy(A_dyn);
+  CHECK(A_copy[2][4] == A[2][4]);
+  typedef vpMatrixFixed<5, 3> vpMatrix5x3;
+  CHECK_THROWS_AS(vpMatrix5x3(A_dyn), vpException);
+}
+
+TEST_CASE("vpMatrixFixed inverse", "[vpMatrixFixed]")
+{
+  vpUniRand rng(5);
+  checkInverse<2>(rng);
+  checkInverse<3>(rng);
+  checkInverse<4>(rng);
+  checkInverse<6>(rng);
+
+  vpMatrixFixed<3, 3> singular;
+  CHECK_THROWS_AS(singular.inverse(), vpException);
+  typedef vpMatrixFixed<2, 3> vpMatrix2x3;
+  CHECK_THROWS_AS(vpMatrix2x3().inverse(), vpException);
+}
+
+TEST_CASE("Geometry computed on the stack", "[vpMatrixFixed]")
+{
+  const vpHomogeneousMatrix M1(0.1, -0.2, 0.8, vpMath::rad(10), vpMath::rad(-20), vpMath::rad(35));
+  const vpHomogeneousMatrix M2(-0.3, 0.05, 1.2, vpMath::rad(-40), vpMath::rad(5), vpMath::rad(60));
+
+  // Reference computed with dynamic matrices
+  const vpMatrix M1_dyn(M1), M2_dyn(M2);
+  CHECK(equal(M1 * M2, M1_dyn * M2_dyn));
+
+  vpHomogeneousMatrix M3 = M1;
+  M3 *= M2;
+  CHECK(equal(M3, M1_dyn * M2_dyn));
+
+  CHECK(equal(M1.inverse(), M1_dyn.inverseByLU()));
+  vpHomogeneousMatrix M4 = M1;
+  M4.inverse(M4);
+  CHECK(equal(M4, M1_dyn.inverseByLU()));
+
+  vpRotationMatrix R;
+  vpTranslationVector t;
+  M1.extract(R);
+  M1.extract(t);
+  vpVelocityTwistMatrix V(t, R);
+  const vpMatrix skewtR = vpColVector::skew(vpColVector(t)) * vpMatrix(R);
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      CHECK(vpMath::equal(V[i][j + 3], skewtR[i][j], 1e-12));
+      CHECK(vpMath::equal(V[i + 3][j + 3], R[i][j], 1e-12));
+    }
+  }
+
+  vpColVector v(6);
+  v[0] = 0.1;
+  v[1] = -0.2;
+  v[2] = 0.3;
+  v[3] = 0.4;
+  v[4] = -0.5;
+  v[5] = 0.2;
+  const vpHomogeneousMatrix Delta = vpExponentialMap::direct(v, 0.5);
+  CHECK(vpExponentialMap::inverse(Delta, 0.5).frobeniusNorm() == Approx(v.frobeniusNorm()).epsilon(1e-9));
+  vpRotationMatrix R_delta;
+  Delta.extract(R_delta);
+  CHECK(equal(R_delta, vpRotationMatrix(vpThetaUVector(0.2, -0.25, 0.1))));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return 0; }
+#endif
@@ -0,0 +1,234 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the allocation-free matrix operations.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMatrixWorkspace.cpp
+
+  Test the pseudo inverse computed in a vpMatrixWorkspace, the built-in Jacobi
+  singular value decomposition and the products by a transposed matrix.
+*/
+#include <visp3/core/vpConfig.h>
+
+#ifdef VISP_HAVE_CATCH2
+#include <limits>
+
+#include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixWorkspace.h>
+#include <visp3/core/vpUniRand.h>
+
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+namespace
+{
+vpMatrix randomMatrix(unsigned int rows, unsigned int cols, vpUniRand &rng)
+{
+  vpMatrix A(rows, cols);
+  for (unsigned int i = 0; i < A.size(); i++) {
+    A.data[i] = rng.uniform(-1.0, 1.0);
+  }
+  return A;
+}
+
+vpColVector randomVector(unsigned int rows, vpUniRand &rng)
+{
+  vpColVector v(rows);
+  for (unsigned int i = 0; i < rows; i++) {
+    v[i] = rng.uniform(-1.0, 1.0);
+  }
+  return v;
+}
+
+bool equal(const vpArray2D<double> &A, const vpArray2D<double> &B, double tol = 1e-10)
+{
+  if (A.getRows() != B.getRows() || A.getCols() != B.getCols()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < A.size(); i++) {
+    if (!vpMath::equal(A.data[i], B.data[i], tol)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+vpMatrix identity(unsigned int n)
+{
+  vpMatrix I;
+  I.eye(n);
+  return I;
+}
+
+// Check the four Moore-Penrose conditions
+bool isPseudoInverse(const vpMatrix &A, const vpMatrix &Ap)
+{
+  const vpMatrix AAp = A * Ap, ApA = Ap * A;
+  return equal(AAp * A, A) && equal(ApA * Ap, Ap) && equal(AAp.t(), AAp) && equal(ApA.t(), ApA);
+}
+} // namespace
+
+TEST_CASE("Jacobi SVD", "[svd]")
+{
+  vpUniRand rng(1234);
+  const unsigned int sizes[][2] = {{6, 6}, {20, 6}, {3, 5}, {1, 1}};
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    const vpMatrix M = randomMatrix(sizes[n][0], sizes[n][1], rng);
+    vpMatrix U = M, V;
+    vpColVector w;
+    U.svdJacobi(w, V);
+
+    vpMatrix S;
+    S.diag(w);
+    CHECK(equal(U * S * V.t(), M));
+    CHECK(equal(V.AtA(), identity(M.getCols()), 1e-12));
+    for (unsigned int i = 1; i < w.size(); i++) {
+      CHECK(w[i - 1] >= w[i]);
+    }
+  }
+}
+
+TEST_CASE("Pseudo inverse in a workspace", "[pseudo_inverse]")
+{
+  vpUniRand rng(4321);
+  vpMatrixWorkspace workspace;
+
+  SECTION("Full rank matrices")
+  {
+    const unsigned int sizes[][2] = {{6, 6}, {40, 6}, {2, 3}, {4, 9}};
+    for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+      const vpMatrix A = randomMatrix(sizes[n][0], sizes[n][1], rng);
+      vpMatrix Ap;
+      const unsigned int rank = A.pseudoInverse(Ap, workspace, 1e-10);
+      CHECK(rank == std::min(A.getRows(), A.getCols()));
+      CHECK(isPseudoInverse(A, Ap));
+      CHECK(workspace.getSingularValues().size() == std::min(A.getRows(), A.getCols()));
+
+#if defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_EIGEN3) || (VISP_HAVE_OPENCV_VERSION >= 0x020101)
+      CHECK(equal(Ap, A.pseudoInverse(1e-10)));
+#endif
+    }
+  }
+
+  SECTION("Rank deficient matrix")
+  {
+    // The last column is a combination of the first two
+    vpMatrix A = randomMatrix(10, 6, rng);
+    for (unsigned int i = 0; i < A.getRows(); i++) {
+      A[i][5] = A[i][0] - 2 * A[i][1];
+    }
+    vpMatrix Ap;
+    CHECK(A.pseudoInverse(Ap, workspace, 1e-10) == 5);
+    CHECK(isPseudoInverse(A, Ap));
+  }
+
+  SECTION("Damped normal matrix of a VVS iteration")
+  {
+    const vpMatrix L = randomMatrix(100, 6, rng);
+    vpMatrix LTL = L.AtA(), Ap;
+    for (unsigned int i = 0; i < 6; i++) {
+      LTL[i][i] += 0.01;
+    }
+    const double threshold = 6 * std::numeric_limits<double>::epsilon();
+    CHECK(LTL.pseudoInverse(Ap, workspace, threshold) == 6);
+    CHECK(equal(Ap * LTL, identity(6)));
+  }
+}
+
+TEST_CASE("Products by a transposed matrix", "[mult]")
+{
+  vpUniRand rng(42);
+  const unsigned int lapack_min_size = vpMatrix::getLapackMatrixMinSize();
+
+  // Small sizes use the naive loops, larger ones the blocked products
+  const unsigned int sizes[][3] = {{5, 3, 4}, {200, 6, 6}, {300, 40, 30}};
+  for (int use_lapack = 0; use_lapack < 2; use_lapack++) {
+    vpMatrix::setLapackMatrixMinSize(use_lapack ? 0 : std::numeric_limits<unsigned int>::max());
+    for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+      const vpMatrix A = randomMatrix(sizes[n][0], sizes[n][1], rng);
+      const vpMatrix B = randomMatrix(sizes[n][0], sizes[n][2], rng);
+      const vpColVector v = randomVector(sizes[n][0], rng);
+
+      vpMatrix C;
+      vpMatrix::multTransposeMatrices(A, B, C);
+      CHECK(equal(C, A.t() * B));
+
+      vpColVector w;
+      vpMatrix::multTransposeMatrixVector(A, v, w);
+      CHECK(equal(w, A.t() * v));
+    }
+  }
+  vpMatrix::setLapackMatrixMinSize(lapack_min_size);
+
+  vpMatrix C;
+  const vpMatrix A(3, 2), B(4, 2);
+  CHECK_THROWS_AS(vpMatrix::multTransposeMatrices(A, B, C), vpException);
+}
+
+TEST_CASE("Exponential map in an existing matrix", "[exponential_map]")
+{
+  vpColVector v(6);
+  v[0] = 0.1;
+  v[1] = -0.2;
+  v[2] = 0.3;
+  v[3] = 0.4;
+  v[4] = -0.5;
+  v[5] = 0.2;
+
+  vpHomogeneousMatrix M;
+  M[3][3] = 2; // overwritten
+  vpExponentialMap::direct(v, 0.5, M);
+  CHECK(equal(M, vpExponentialMap::direct(v, 0.5), std::numeric_limits<double>::epsilon()));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+#include <iostream>
+
+int main() { return 0; }
+#endif
@@ -71,6 +71,7 @@ int main()
             << std::endl;
   std::cout << "checkSSSE3: " << vpCPUFeatures::checkSSSE3() << " ; VISP_HAVE_SSSE3: " << VALUE(VISP_HAVE_SSSE3)
             << std::endl;
+  std::cout << "checkNEON: " << vpCPUFeatures::checkNEON() << std::endl;
 
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,139 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the histogram kernel against a naive implementation.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testHistogramKernel.cpp
+
+  \brief Compare vpHistogram::calculate() and vpHistogram::calculateRegion()
+  with a naive histogram, with several numbers of bins and threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpHistogram.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+void naiveHistogram(const vpImage<unsigned char> &I, unsigned int top, unsigned int left, unsigned int height,
+                    unsigned int width, unsigned int nbins, std::vector<unsigned int> &hist)
+{
+  hist.assign(nbins, 0);
+  for (unsigned int i = top; i < top + height; i++) {
+    for (unsigned int j = left; j < left + width; j++) {
+      hist[(unsigned int)(I[i][j] * nbins / 256.0)]++;
+    }
+  }
+}
+
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      // Smooth areas with runs of equal values and random areas
+      I[i][j] = (j / 16) % 2 ? static_cast<unsigned char>(i / 4) : static_cast<unsigned char>(rng.uniform(0, 256));
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Histogram of the whole image", "[histogram]")
+{
+  vpUniRand rng(11);
+  const unsigned int sizes[][2] = {{1, 1}, {3, 7}, {64, 64}, {200, 333}};
+  const unsigned int bins[] = {256, 64, 7};
+  const unsigned int threads[] = {1, 4};
+
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    vpImage<unsigned char> I;
+    randomImage(I, sizes[n][0], sizes[n][1], rng);
+    for (size_t b = 0; b < sizeof(bins) / sizeof(bins[0]); b++) {
+      std::vector<unsigned int> hist_ref;
+      naiveHistogram(I, 0, 0, I.getHeight(), I.getWidth(), bins[b], hist_ref);
+
+      for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        INFO("Image " << sizes[n][0] << "x" << sizes[n][1] << ", bins " << bins[b] << ", threads " << threads[t]);
+        vpHistogram hist;
+        hist.calculate(I, bins[b], threads[t]);
+        REQUIRE(hist.getSize() == bins[b]);
+        CHECK(std::equal(hist_ref.begin(), hist_ref.end(), hist.getValues()));
+      }
+    }
+  }
+}
+
+TEST_CASE("Histogram of a region", "[histogram]")
+{
+  vpUniRand rng(12);
+  vpImage<unsigned char> I;
+  randomImage(I, 120, 150, rng);
+
+  const unsigned int regions[][4] = {{0, 0, 120, 150}, {10, 3, 1, 1}, {5, 17, 33, 9}, {100, 141, 20, 9}};
+  for (size_t r = 0; r < sizeof(regions) / sizeof(regions[0]); r++) {
+    INFO("Region " << r);
+    std::vector<unsigned int> hist_ref;
+    naiveHistogram(I, regions[r][0], regions[r][1], regions[r][2], regions[r][3], 256, hist_ref);
+
+    unsigned int hist[256];
+    vpHistogram::calculateRegion(I, regions[r][0], regions[r][1], regions[r][2], regions[r][3], hist);
+    CHECK(std::equal(hist_ref.begin(), hist_ref.end(), hist));
+  }
+
+  unsigned int hist[256];
+  CHECK_THROWS_AS(vpHistogram::calculateRegion(I, 100, 0, 21, 10, hist), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
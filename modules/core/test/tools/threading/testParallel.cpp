@@ -0,0 +1,303 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the stripe-parallel executor.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testParallel.cpp
+
+  \brief Test vpParallel::parallelFor() and check that the image processing
+  functions based on it give the same results whatever the number of threads.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+
+#include <visp3/core/vpImageFilter.h>
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpUniRand.h>
+
+namespace
+{
+class CountBody : public vpParallelBody
+{
+public:
+  explicit CountBody(std::vector<int> &count) : m_count(count) {}
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      m_count[i]++;
+    }
+  }
+
+private:
+  std::vector<int> &m_count;
+};
+
+class ThrowBody : public vpParallelBody
+{
+public:
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    if (begin <= 50 && 50 < end) {
+      throw vpException(vpException::fatalError, "stripe error");
+    }
+  }
+};
+
+class NestedBody : public vpParallelBody
+{
+public:
+  explicit NestedBody(std::vector<int> &count) : m_count(count) {}
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      std::vector<int> inner(10, 0);
+      vpParallel::parallelFor(0, 10, CountBody(inner));
+      m_count[i] = static_cast<int>(std::count(inner.begin(), inner.end(), 1));
+    }
+  }
+
+private:
+  std::vector<int> &m_count;
+};
+
+template <class Type> bool isSame(const Type &a, const Type &b) { return a == b; }
+
+template <> bool isSame(const vpRGBa &a, const vpRGBa &b)
+{
+  return a.R == b.R && a.G == b.G && a.B == b.B && a.A == b.A;
+}
+
+template <class Type> bool isEqual(const vpImage<Type> &I1, const vpImage<Type> &I2)
+{
+  if (I1.getHeight() != I2.getHeight() || I1.getWidth() != I2.getWidth()) {
+    return false;
+  }
+  for (unsigned int i = 0; i < I1.getSize(); i++) {
+    if (!isSame(I1.bitmap[i], I2.bitmap[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+void randomImage(vpImage<vpRGBa> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = vpRGBa(static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)),
+                         static_cast<unsigned char>(rng.uniform(0, 256)));
+  }
+}
+
+struct Results {
+  vpImage<unsigned char> resize_nn, resize_linear, resize_cubic, warp_nn, warp_linear, remap, blur_uc, diff, undist;
+  vpImage<vpRGBa> resize_rgba, warp_rgba, remap_rgba, diff_rgba;
+  vpImage<double> blur, sep, II, IIsq, score;
+};
+
+void compute(const vpImage<unsigned char> &I, const vpImage<unsigned char> &I2, const vpImage<vpRGBa> &Ic,
+             const vpImage<vpRGBa> &Ic2, Results &r)
+{
+  vpImageTools::resize(I, r.resize_nn, 71, 53, vpImageTools::INTERPOLATION_NEAREST);
+  vpImageTools::resize(I, r.resize_linear, 71, 53, vpImageTools::INTERPOLATION_LINEAR);
+  vpImageTools::resize(I, r.resize_cubic, 71, 53, vpImageTools::INTERPOLATION_CUBIC);
+  vpImageTools::resize(Ic, r.resize_rgba, 71, 53, vpImageTools::INTERPOLATION_LINEAR);
+
+  vpMatrix H(3, 3);
+  H.eye();
+  H[0][0] = 0.9; H[0][1] = 0.1; H[0][2] = 3.2;
+  H[1][0] = -0.05; H[1][1] = 1.1; H[1][2] = -2.7;
+  H[2][0] = 1e-4; H[2][1] = -2e-4;
+  r.warp_nn.resize(I.getHeight(), I.getWidth(), 0);
+  r.warp_linear.resize(I.getHeight(), I.getWidth(), 0);
+  r.warp_rgba.resize(Ic.getHeight(), Ic.getWidth(), vpRGBa(0));
+  vpImageTools::warpImage(I, H, r.warp_nn, vpImageTools::INTERPOLATION_NEAREST);
+  vpImageTools::warpImage(I, H, r.warp_linear, vpImageTools::INTERPOLATION_LINEAR);
+  vpImageTools::warpImage(Ic, H, r.warp_rgba, vpImageTools::INTERPOLATION_LINEAR);
+
+  vpCameraParameters cam;
+  cam.initPersProjWithDistortion(200, 210, I.getWidth() / 2.0, I.getHeight() / 2.0, -0.2, 0.21);
+  vpArray2D<int> mapU, mapV;
+  vpArray2D<float> mapDu, mapDv;
+  vpImageTools::initUndistortMap(cam, I.getWidth(), I.getHeight(), mapU, mapV, mapDu, mapDv);
+  vpImageTools::remap(I, mapU, mapV, mapDu, mapDv, r.remap);
+  vpImageTools::remap(Ic, mapU, mapV, mapDu, mapDv, r.remap_rgba);
+  vpImageTools::undistort(I, cam, r.undist, 0);
+
+  vpImageFilter::gaussianBlur(I, r.blur, 7);
+  vpImageFilter::gaussianBlur(I, r.blur_uc, 7);
+  vpColVector kernel(5, 0.2);
+  vpImageFilter::sepFilter(I, r.sep, kernel, kernel);
+
+  vpImageTools::imageDifference(I, I2, r.diff);
+  vpImageTools::imageDifference(Ic, Ic2, r.diff_rgba);
+  vpImageTools::integralImage(I, r.II, r.IIsq);
+
+  vpImage<unsigned char> I_tpl;
+  vpImageTools::crop(I, 10, 12, 9, 11, I_tpl);
+  vpImageTools::templateMatching(I, I_tpl, r.score, 2, 3);
+}
+} // namespace
+
+TEST_CASE("Each index is processed exactly once", "[vpParallel]")
+{
+  const unsigned int ranges[][2] = {{0, 0}, {0, 1}, {3, 17}, {0, 1000}, {5, 4099}};
+  const unsigned int grains[] = {0, 1, 7, 64, 5000};
+  const unsigned int threads[] = {1, 2, 3, 8};
+  for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++) {
+    for (size_t g = 0; g < sizeof(grains) / sizeof(grains[0]); g++) {
+      for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        vpParallel::setNumThreads(threads[t]);
+        std::vector<int> count(ranges[r][1], 0);
+        vpParallel::parallelFor(ranges[r][0], ranges[r][1], CountBody(count), 0, grains[g]);
+        for (unsigned int i = 0; i < ranges[r][1]; i++) {
+          REQUIRE(count[i] == (i < ranges[r][0] ? 0 : 1));
+        }
+      }
+    }
+  }
+  vpParallel::setNumThreads(0);
+}
+
+TEST_CASE("Exceptions and nested calls", "[vpParallel]")
+{
+  vpParallel::setNumThreads(4);
+  CHECK_THROWS_AS(vpParallel::parallelFor(0, 100, ThrowBody(), 0, 1), vpException);
+
+  std::vector<int> count(37, 0);
+  vpParallel::parallelFor(0, 37, NestedBody(count));
+  CHECK(std::count(count.begin(), count.end(), 10) == 37);
+  vpParallel::setNumThreads(0);
+}
+
+TEST_CASE("Pool shutdown", "[vpParallel]")
+{
+  vpParallel::setNumThreads(3);
+  for (int n = 0; n < 2; n++) {
+    std::vector<int> count(100, 0);
+    vpParallel::parallelFor(0, 100, CountBody(count), 0, 1);
+    CHECK(std::count(count.begin(), count.end(), 1) == 100);
+
+    // The pool is created again by the next call
+    vpParallel::shutdown();
+  }
+  vpParallel::shutdown();
+  vpParallel::setNumThreads(0);
+}
+
+TEST_CASE("Results do not depend on the number of threads", "[vpParallel]")
+{
+  vpUniRand rng(11);
+  vpImage<unsigned char> I, I2;
+  vpImage<vpRGBa> Ic, Ic2;
+  randomImage(I, 97, 131, rng);
+  randomImage(I2, 97, 131, rng);
+  randomImage(Ic, 97, 131, rng);
+  randomImage(Ic2, 97, 131, rng);
+
+  vpParallel::setNumThreads(1);
+  Results ref;
+  compute(I, I2, Ic, Ic2, ref);
+
+  // Integral images against the straightforward recurrence
+  for (unsigned int i = 1; i < ref.II.getHeight(); i++) {
+    for (unsigned int j = 1; j < ref.II.getWidth(); j++) {
+      REQUIRE(ref.II[i][j] == I[i - 1][j - 1] + ref.II[i - 1][j] + ref.II[i][j - 1] - ref.II[i - 1][j - 1]);
+      REQUIRE(ref.IIsq[i][j] ==
+              vpMath::sqr(I[i - 1][j - 1]) + ref.IIsq[i - 1][j] + ref.IIsq[i][j - 1] - ref.IIsq[i - 1][j - 1]);
+    }
+  }
+
+  const unsigned int threads[] = {2, 3, 8};
+  for (size_t t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+    vpParallel::setNumThreads(threads[t]);
+    Results res;
+    compute(I, I2, Ic, Ic2, res);
+
+    CHECK(isEqual(res.resize_nn, ref.resize_nn));
+    CHECK(isEqual(res.resize_linear, ref.resize_linear));
+    CHECK(isEqual(res.resize_cubic, ref.resize_cubic));
+    CHECK(isEqual(res.resize_rgba, ref.resize_rgba));
+    CHECK(isEqual(res.warp_nn, ref.warp_nn));
+    CHECK(isEqual(res.warp_linear, ref.warp_linear));
+    CHECK(isEqual(res.warp_rgba, ref.warp_rgba));
+    CHECK(isEqual(res.remap, ref.remap));
+    CHECK(isEqual(res.remap_rgba, ref.remap_rgba));
+    CHECK(isEqual(res.undist, ref.undist));
+    CHECK(isEqual(res.blur, ref.blur));
+    CHECK(isEqual(res.blur_uc, ref.blur_uc));
+    CHECK(isEqual(res.sep, ref.sep));
+    CHECK(isEqual(res.diff, ref.diff));
+    CHECK(isEqual(res.diff_rgba, ref.diff_rgba));
+    CHECK(isEqual(res.II, ref.II));
+    CHECK(isEqual(res.IIsq, ref.IIsq));
+    CHECK(isEqual(res.score, ref.score));
+  }
+  vpParallel::setNumThreads(0);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -168,6 +168,13 @@ typedef enum {
   CONTOUR_RETR_EXTERNAL /*!< Retrieve only external contours. */
 } vpContourRetrievalType;
 
+typedef enum {
+  CONTOUR_APPROX_NONE,       /*!< Keep all the contour points. */
+  CONTOUR_APPROX_POLYGON,    /*!< Approximate the contours by polygons with the
+                                Douglas-Peucker algorithm. */
+  CONTOUR_APPROX_CONVEX_HULL /*!< Replace the contours by their convex hull. */
+} vpContourApproximationType;
+
 struct vpContour {
   std::vector<vpContour *> m_children;
   vpContourType m_contourType;
@@ -241,6 +248,57 @@ struct vpContour {
   }
 };
 
+/*!
+  \ingroup group_imgproc_contours
+
+  Contours stored in flat arrays: the points of all the contours are stored
+  in a single buffer, the points of the contour \e k being
+  <tt>m_points[m_offsets[k]]</tt> to <tt>m_points[m_offsets[k+1]-1]</tt>.
+  This avoids one memory allocation per contour when the image contains a lot
+  of small contours.
+*/
+struct VISP_EXPORT vpFlatContours {
+  std::vector<vpImagePoint> m_points; //!< Points of all the contours.
+  std::vector<unsigned int> m_offsets; //!< Index of the first point of each contour, plus the total number of points.
+  std::vector<int> m_parents;          //!< Index of the parent contour, -1 for the contours without parent.
+  std::vector<vpContourType> m_types;  //!< Type of each contour.
+  std::vector<double> m_areas;         //!< Area enclosed by each traced contour, in pixel^2.
+  std::vector<double> m_perimeters;    //!< Length of each traced contour, in pixel.
+
+  vpFlatContours() : m_points(), m_offsets(1, 0), m_parents(), m_types(), m_areas(), m_perimeters() {}
+
+  /*!
+    Remove all the contours.
+  */
+  void clear()
+  {
+    m_points.clear();
+    m_offsets.assign(1, 0);
+    m_parents.clear();
+    m_types.clear();
+    m_areas.clear();
+    m_perimeters.clear();
+  }
+
+  /*!
+    Copy the points of a contour.
+  */
+  void getContour(unsigned int k, std::vector<vpImagePoint> &points) const
+  {
+    points.assign(m_points.begin() + m_offsets[k], m_points.begin() + m_offsets[k + 1]);
+  }
+
+  /*!
+    Return the number of points of a contour.
+  */
+  unsigned int getNbPoints(unsigned int k) const { return m_offsets[k + 1] - m_offsets[k]; }
+
+  /*!
+    Return the number of contours.
+  */
+  unsigned int size() const { return static_cast<unsigned int>(m_types.size()); }
+};
+
 VISP_EXPORT void drawContours(vpImage<unsigned char> &I, const std::vector<std::vector<vpImagePoint> > &contours,
                               unsigned char grayValue = 255);
 VISP_EXPORT void drawContours(vpImage<vpRGBa> &I, const std::vector<std::vector<vpImagePoint> > &contours,
@@ -249,6 +307,10 @@ VISP_EXPORT void drawContours(vpImage<vpRGBa> &I, const std::vector<std::vector<
 VISP_EXPORT void findContours(const vpImage<unsigned char> &I_original, vpContour &contours,
                               std::vector<std::vector<vpImagePoint> > &contourPts,
                               const vpContourRetrievalType &retrievalMode = vp::CONTOUR_RETR_TREE);
+VISP_EXPORT void findContours(const vpImage<unsigned char> &I_original, vpFlatContours &contours,
+                              const vpContourRetrievalType &retrievalMode = vp::CONTOUR_RETR_TREE,
+                              const vpContourApproximationType &approximation = vp::CONTOUR_APPROX_NONE,
+                              double epsilon = 1.0);
 }
 
 #endif
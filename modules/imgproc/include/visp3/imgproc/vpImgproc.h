@@ -45,8 +45,13 @@
 #ifndef _vpImgproc_h_
 #define _vpImgproc_h_
 
+#include <vector>
+
+#include <visp3/core/vpCameraParameters.h>
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImageMorphology.h>
+#include <visp3/core/vpMomentObject.h>
+#include <visp3/core/vpRect.h>
 #include <visp3/imgproc/vpContours.h>
 
 #define USE_OLD_FILL_HOLE 0
@@ -83,6 +88,82 @@ typedef enum {
                               */
 } vpAutoThresholdMethod;
 
+typedef enum {
+  ADAPTIVE_THRESHOLD_BRADLEY, /*!< Bradley, D & Roth, G (2007), "Adaptive
+                                 thresholding using the integral image",
+                                 Journal of Graphics Tools 12(2): 13-21
+                                 \cite Bradley2007: a pixel is foreground if it
+                                 is greater than \f$ m (1 - k) \f$, with
+                                 \f$ m \f$ the local mean. */
+  ADAPTIVE_THRESHOLD_SAUVOLA  /*!< Sauvola, J & Pietikainen, M (2000),
+                                 "Adaptive document image binarization",
+                                 Pattern Recognition 33(2): 225-236
+                                 \cite Sauvola2000: a pixel is foreground if it
+                                 is greater than \f$ m (1 + k (s / 128 - 1)) \f$,
+                                 with \f$ m \f$ and \f$ s \f$ the local mean and
+                                 standard deviation. */
+} vpAdaptiveThresholdMethod;
+
+typedef enum {
+  DISTANCE_EUCLIDEAN,      /*!< Exact Euclidean distance, computed with the
+                              separable algorithm of Felzenszwalb, P & Huttenlocher, D
+                              (2012), "Distance transforms of sampled functions",
+                              Theory of Computing 8(19): 415-428
+                              \cite Felzenszwalb2012 */
+  DISTANCE_CHAMFER_3_4,    /*!< Chamfer distance with a 3x3 mask, weights 3 for
+                              the 4-neighbors and 4 for the diagonal neighbors,
+                              Borgefors, G (1986), "Distance transformations in
+                              digital images", CVGIP 34(3): 344-371
+                              \cite Borgefors1986 */
+  DISTANCE_CHAMFER_5_7_11  /*!< Chamfer distance with a 5x5 mask, weights 5, 7
+                              and 11 \cite Borgefors1986 */
+} vpDistanceTransformType;
+
+/*!
+  \ingroup group_imgproc_connected_components
+
+  Statistics of a connected component, accumulated by connectedComponents()
+  while the image is labeled. The moments are the raw moments
+  \f$m_{pq} = \sum u^p v^q\f$ in pixel coordinates, with \f$u\f$ the column
+  and \f$v\f$ the row of a pixel of the component.
+*/
+struct VISP_EXPORT vpConnectedComponentStats {
+  unsigned int m_area;   //!< Number of pixels of the component.
+  unsigned int m_left;   //!< First column of the component.
+  unsigned int m_top;    //!< First row of the component.
+  unsigned int m_right;  //!< Last column of the component.
+  unsigned int m_bottom; //!< Last row of the component.
+  double m_m10;          //!< Sum of the columns.
+  double m_m01;          //!< Sum of the rows.
+  double m_m20;          //!< Sum of the squared columns.
+  double m_m11;          //!< Sum of the products of the columns and the rows.
+  double m_m02;          //!< Sum of the squared rows.
+
+  vpConnectedComponentStats();
+
+  /*!
+    Add the pixel at row \e i and column \e j to the component.
+  */
+  inline void add(unsigned int i, unsigned int j)
+  {
+    const double u = static_cast<double>(j), v = static_cast<double>(i);
+    m_area++;
+    m_left = j < m_left ? j : m_left;
+    m_right = j > m_right ? j : m_right;
+    m_top = i < m_top ? i : m_top;
+    m_bottom = i > m_bottom ? i : m_bottom;
+    m_m10 += u;
+    m_m01 += v;
+    m_m20 += u * u;
+    m_m11 += u * v;
+    m_m02 += v * v;
+  }
+  void add(const vpConnectedComponentStats &stats);
+  vpRect getBoundingBox() const;
+  vpImagePoint getCentroid() const;
+  void toMomentObject(const vpCameraParameters &cam, vpMomentObject &obj) const;
+};
+
 VISP_EXPORT void adjust(vpImage<unsigned char> &I, double alpha, double beta);
 VISP_EXPORT void adjust(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, double alpha,
                         double beta);
@@ -124,10 +205,20 @@ VISP_EXPORT void unsharpMask(vpImage<vpRGBa> &I, unsigned int size = 7, double w
 VISP_EXPORT void unsharpMask(const vpImage<vpRGBa> &I, vpImage<vpRGBa> &Ires, unsigned int size = 7,
                              double weight = 0.6);
 
+VISP_EXPORT void clearBorder(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                             const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+
+VISP_EXPORT void
+connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                    const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 VISP_EXPORT void
 connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                    std::vector<vpConnectedComponentStats> &stats,
                     const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
+VISP_EXPORT void distanceTransform(const vpImage<unsigned char> &I, vpImage<float> &dist,
+                                   const vp::vpDistanceTransformType &type = vp::DISTANCE_EUCLIDEAN);
+
 VISP_EXPORT void fillHoles(vpImage<unsigned char> &I
 #if USE_OLD_FILL_HOLE
                            ,
@@ -139,10 +230,28 @@ VISP_EXPORT void floodFill(vpImage<unsigned char> &I, const vpImagePoint &seedPo
                            const unsigned char newValue,
                            const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
+VISP_EXPORT void hMaxima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, unsigned char h,
+                         const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+VISP_EXPORT void hMinima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, unsigned char h,
+                         const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+
 VISP_EXPORT void reconstruct(const vpImage<unsigned char> &marker, const vpImage<unsigned char> &mask,
                              vpImage<unsigned char> &I,
                              const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
 
+VISP_EXPORT void regionalMaxima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+VISP_EXPORT void regionalMinima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                const vpImageMorphology::vpConnexityType &connexity = vpImageMorphology::CONNEXITY_4);
+
+VISP_EXPORT void skeleton(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires);
+
+VISP_EXPORT void adaptiveThreshold(vpImage<unsigned char> &I, const vp::vpAdaptiveThresholdMethod &method,
+                                   unsigned int size = 15, double k = 0.2, const unsigned char backgroundValue = 0,
+                                   const unsigned char foregroundValue = 255);
+VISP_EXPORT void adaptiveThreshold(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                                   const vp::vpAdaptiveThresholdMethod &method, unsigned int size = 15, double k = 0.2,
+                                   const unsigned char backgroundValue = 0, const unsigned char foregroundValue = 255);
 VISP_EXPORT unsigned char autoThreshold(vpImage<unsigned char> &I, const vp::vpAutoThresholdMethod &method,
                                         const unsigned char backgroundValue = 0,
                                         const unsigned char foregroundValue = 255);
@@ -81,7 +81,9 @@
   \brief Contrast Limited Adaptive Histogram Equalization (CLAHE).
 */
 
+#include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImageConvert.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
@@ -120,21 +122,36 @@ void clipHistogram(const std::vector<int> &hist, std::vector<int> &clippedHist,
   } while (clippedEntries != clippedEntriesBefore);
 }
 
-void createHistogram(int blockRadius, int bins, int blockXCenter, int blockYCenter,
-                     const vpImage<unsigned char> &I, std::vector<int> &hist)
+// Bin of each gray level, that is fastRound(v / 255.0f * bins)
+void createBinLut(int bins, int *lut)
+{
+  for (int v = 0; v < 256; v++) {
+    lut[v] = fastRound(v / 255.0f * bins);
+  }
+}
+
+void createHistogram(int yMin, int yMax, int xMin, int xMax, const int *lut, const vpImage<unsigned char> &I,
+                     std::vector<int> &hist)
 {
+  unsigned int values[256];
+  vpHistogram::calculateRegion(I, (unsigned int)yMin, (unsigned int)xMin, (unsigned int)(yMax - yMin),
+                               (unsigned int)(xMax - xMin), values);
+
   std::fill(hist.begin(), hist.end(), 0);
+  for (int v = 0; v < 256; v++) {
+    hist[lut[v]] += (int)values[v];
+  }
+}
 
+void createHistogram(int blockRadius, int blockXCenter, int blockYCenter, const int *lut,
+                     const vpImage<unsigned char> &I, std::vector<int> &hist)
+{
   int xMin = std::max(0, blockXCenter - blockRadius);
   int yMin = std::max(0, blockYCenter - blockRadius);
   int xMax = std::min((int)I.getWidth(), blockXCenter + blockRadius + 1);
   int yMax = std::min((int)I.getHeight(), blockYCenter + blockRadius + 1);
 
-  for (int y = yMin; y < yMax; ++y) {
-    for (int x = xMin; x < xMax; ++x) {
-      ++hist[fastRound(I[y][x] / 255.0f * bins)];
-    }
-  }
+  createHistogram(yMin, yMax, xMin, xMax, lut, I, hist);
 }
 
 std::vector<float> createTransfer(const std::vector<int> &hist, int limit, std::vector<int> &cdfs)
@@ -194,6 +211,229 @@ float transferValue(int v, const std::vector<int> &hist, std::vector<int> &clipp
 
   return transferValue(v, clippedHist);
 }
+
+// Centers of the blocks along a dimension of the image
+std::vector<int> blockCenters(int length, int blockRadius)
+{
+  int blockSize = 2 * blockRadius + 1;
+  /* div */
+  int n = length / blockSize;
+  /* % */
+  int m = length - n * blockSize;
+  std::vector<int> centers;
+
+  switch (m) {
+  case 0:
+    centers.resize((size_t)n);
+    for (int i = 0; i < n; ++i) {
+      centers[i] = i * blockSize + blockRadius + 1;
+    }
+    break;
+
+  case 1:
+    centers.resize((size_t)(n + 1));
+    for (int i = 0; i < n; ++i) {
+      centers[i] = i * blockSize + blockRadius + 1;
+    }
+    centers[n] = length - blockRadius - 1;
+    break;
+
+  default:
+    centers.resize((size_t)(n + 2));
+    centers[0] = blockRadius + 1;
+    for (int i = 0; i < n; ++i) {
+      centers[i + 1] = i * blockSize + blockRadius + 1 + m / 2;
+    }
+    centers[n + 1] = length - blockRadius - 1;
+  }
+
+  return centers;
+}
+
+// Transfer function of each block, the blocks being processed in parallel
+class vpBlockTransferBody : public vpParallelBody
+{
+public:
+  vpBlockTransferBody(const vpImage<unsigned char> &I, const std::vector<int> &rs, const std::vector<int> &cs,
+                      int blockRadius, int bins, int limit, const int *lut, std::vector<std::vector<float> > &transfers)
+    : m_I(I), m_rs(rs), m_cs(cs), m_blockRadius(blockRadius), m_bins(bins), m_limit(limit), m_lut(lut),
+      m_transfers(transfers)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    std::vector<int> hist((size_t)(m_bins + 1));
+    std::vector<int> cdfs((size_t)(m_bins + 1));
+    for (unsigned int b = begin; b < end; b++) {
+      unsigned int r = b / (unsigned int)m_cs.size(), c = b % (unsigned int)m_cs.size();
+      createHistogram(m_blockRadius, m_cs[c], m_rs[r], m_lut, m_I, hist);
+      m_transfers[b] = createTransfer(hist, m_limit, cdfs);
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  const std::vector<int> &m_rs;
+  const std::vector<int> &m_cs;
+  int m_blockRadius;
+  int m_bins;
+  int m_limit;
+  const int *m_lut;
+  std::vector<std::vector<float> > &m_transfers;
+};
+
+// Bilinear interpolation of the transfer functions of the 4 nearest blocks
+class vpInterpolationBody : public vpParallelBody
+{
+public:
+  vpInterpolationBody(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, const std::vector<int> &rs,
+                      const std::vector<int> &cs, const int *lut, const std::vector<std::vector<float> > &transfers)
+    : m_I1(I1), m_I2(I2), m_rs(rs), m_cs(cs), m_lut(lut), m_transfers(transfers)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const int nc = (int)m_cs.size();
+    int r = 0;
+    for (int y = (int)begin; y < (int)end; ++y) {
+      // Row of the cell between the block centers rs[r0] and rs[r1]
+      while (r < (int)m_rs.size() && y >= m_rs[r]) {
+        ++r;
+      }
+      int r0 = std::max(0, r - 1);
+      int r1 = std::min((int)m_rs.size() - 1, r);
+      float wy = (r0 == r1) ? 1.0f : (float)(m_rs[r1] - y) / (m_rs[r1] - m_rs[r0]);
+
+      const unsigned char *src = m_I1[y];
+      unsigned char *dst = m_I2[y];
+      for (int c = 0; c <= nc; ++c) {
+        int c0 = std::max(0, c - 1);
+        int c1 = std::min(nc - 1, c);
+        int dc = m_cs[c1] - m_cs[c0];
+        const std::vector<float> &tl = m_transfers[r0 * nc + c0];
+        const std::vector<float> &tr = m_transfers[r0 * nc + c1];
+        const std::vector<float> &bl = m_transfers[r1 * nc + c0];
+        const std::vector<float> &br = m_transfers[r1 * nc + c1];
+
+        int xMin = (c == 0 ? 0 : m_cs[c0]);
+        int xMax = (c < nc ? m_cs[c1] : (int)m_I1.getWidth());
+        for (int x = xMin; x < xMax; ++x) {
+          int v = m_lut[src[x]];
+          float t0 = 0.0f, t1 = 0.0f;
+
+          if (c0 == c1) {
+            t0 = tl[v];
+            t1 = bl[v];
+          } else {
+            float wx = (float)(m_cs[c1] - x) / dc;
+            t0 = wx * tl[v] + (1.0f - wx) * tr[v];
+            t1 = wx * bl[v] + (1.0f - wx) * br[v];
+          }
+
+          float t = (r0 == r1) ? t0 : wy * t0 + (1.0f - wy) * t1;
+          dst[x] = (unsigned char)std::max(0, std::min(255, fastRound(t * 255.0f)));
+        }
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I1;
+  vpImage<unsigned char> &m_I2;
+  const std::vector<int> &m_rs;
+  const std::vector<int> &m_cs;
+  const int *m_lut;
+  const std::vector<std::vector<float> > &m_transfers;
+};
+
+// Accurate version, the histogram of the block centered on each pixel is
+// updated by sliding the block along the rows. Each range of rows starts
+// with the histogram of its first block.
+class vpSlidingBody : public vpParallelBody
+{
+public:
+  vpSlidingBody(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int blockRadius, int bins,
+                float slope, const int *lut)
+    : m_I1(I1), m_I2(I2), m_blockRadius(blockRadius), m_bins(bins), m_slope(slope), m_lut(lut)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const int width = (int)m_I1.getWidth(), height = (int)m_I1.getHeight();
+    std::vector<int> hist((size_t)(m_bins + 1)), prev_hist((size_t)(m_bins + 1));
+    std::vector<int> clippedHist((size_t)(m_bins + 1));
+
+    int xMax0 = std::min(width, m_blockRadius);
+
+    for (int y = (int)begin; y < (int)end; y++) {
+      int yMin = std::max(0, y - m_blockRadius);
+      int yMax = std::min(height, y + m_blockRadius + 1);
+      int h = yMax - yMin;
+
+      if (y == (int)begin) {
+        // Histogram of the block at (y, 0)
+        createHistogram(yMin, yMax, 0, xMax0, m_lut, m_I1, hist);
+      } else {
+        hist = prev_hist;
+
+        if (yMin > 0) {
+          // Sliding histogram, remove top
+          const unsigned char *row = m_I1[yMin - 1];
+          for (int xi = 0; xi < xMax0; xi++) {
+            --hist[m_lut[row[xi]]];
+          }
+        }
+
+        if (y + m_blockRadius < height) {
+          // Sliding histogram, add bottom
+          const unsigned char *row = m_I1[yMax - 1];
+          for (int xi = 0; xi < xMax0; xi++) {
+            ++hist[m_lut[row[xi]]];
+          }
+        }
+      }
+      prev_hist = hist;
+
+      for (int x = 0; x < width; x++) {
+        int xMin = std::max(0, x - m_blockRadius);
+        int xMax = x + m_blockRadius + 1;
+
+        if (xMin > 0) {
+          int xMin1 = xMin - 1;
+          // Sliding histogram, remove left
+          for (int yi = yMin; yi < yMax; yi++) {
+            --hist[m_lut[m_I1[yi][xMin1]]];
+          }
+        }
+
+        if (xMax <= width) {
+          int xMax1 = xMax - 1;
+          // Sliding histogram, add right
+          for (int yi = yMin; yi < yMax; yi++) {
+            ++hist[m_lut[m_I1[yi][xMax1]]];
+          }
+        }
+
+        int v = m_lut[m_I1[y][x]];
+        int w = std::min(width, xMax) - xMin;
+        int n = h * w;
+        int limit = (int)(m_slope * n / m_bins + 0.5f);
+        m_I2[y][x] = (unsigned char)fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I1;
+  vpImage<unsigned char> &m_I2;
+  int m_blockRadius;
+  int m_bins;
+  float m_slope;
+  const int *m_lut;
+};
 }
 
 /*!
@@ -247,221 +487,24 @@ void vp::clahe(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I2, int
 
   I2.resize(I1.getHeight(), I1.getWidth());
 
+  int lut[256];
+  createBinLut(bins, lut);
+
   if (fast) {
     int blockSize = 2 * blockRadius + 1;
     int limit = (int)(slope * blockSize * blockSize / bins + 0.5);
 
-    /* div */
-    int nc = I1.getWidth() / blockSize;
-    int nr = I1.getHeight() / blockSize;
-
-    /* % */
-    int cm = I1.getWidth() - nc * blockSize;
-    std::vector<int> cs;
-
-    switch (cm) {
-    case 0:
-      cs.resize(nc);
-      for (int i = 0; i < nc; ++i) {
-        cs[i] = i * blockSize + blockRadius + 1;
-      }
-      break;
-
-    case 1:
-      cs.resize(nc + 1);
-      for (int i = 0; i < nc; ++i) {
-        cs[i] = i * blockSize + blockRadius + 1;
-      }
-      cs[nc] = I1.getWidth() - blockRadius - 1;
-      break;
-
-    default:
-      cs.resize(nc + 2);
-      cs[0] = blockRadius + 1;
-      for (int i = 0; i < nc; ++i) {
-        cs[i + 1] = i * blockSize + blockRadius + 1 + cm / 2;
-      }
-      cs[nc + 1] = I1.getWidth() - blockRadius - 1;
-    }
-
-    int rm = I1.getHeight() - nr * blockSize;
-    std::vector<int> rs;
+    std::vector<int> cs = blockCenters((int)I1.getWidth(), blockRadius);
+    std::vector<int> rs = blockCenters((int)I1.getHeight(), blockRadius);
 
-    switch (rm) {
-    case 0:
-      rs.resize((size_t)nr);
-      for (int i = 0; i < nr; ++i) {
-        rs[i] = i * blockSize + blockRadius + 1;
-      }
-      break;
-
-    case 1:
-      rs.resize((size_t)(nr + 1));
-      for (int i = 0; i < nr; ++i) {
-        rs[i] = i * blockSize + blockRadius + 1;
-      }
-      rs[nr] = I1.getHeight() - blockRadius - 1;
-      break;
-
-    default:
-      rs.resize((size_t)(nr + 2));
-      rs[0] = blockRadius + 1;
-      for (int i = 0; i < nr; ++i) {
-        rs[i + 1] = i * blockSize + blockRadius + 1 + rm / 2;
-      }
-      rs[nr + 1] = I1.getHeight() - blockRadius - 1;
-    }
-
-    std::vector<int> hist((size_t)(bins + 1));
-    std::vector<int> cdfs((size_t)(bins + 1));
-    std::vector<float> tl;
-    std::vector<float> tr;
-    std::vector<float> br;
-    std::vector<float> bl;
-
-    for (int r = 0; r <= (int)rs.size(); ++r) {
-      int r0 = std::max(0, r - 1);
-      int r1 = std::min((int)rs.size() - 1, r);
-      int dr = rs[r1] - rs[r0];
-
-      createHistogram(blockRadius, bins, cs[0], rs[r0], I1, hist);
-      tr = createTransfer(hist, limit, cdfs);
-      if (r0 == r1) {
-        br = tr;
-      } else {
-        createHistogram(blockRadius, bins, cs[0], rs[r1], I1, hist);
-        br = createTransfer(hist, limit, cdfs);
-      }
-
-      int yMin = (r == 0 ? 0 : rs[r0]);
-      int yMax = (r < (int)rs.size() ? rs[r1] : I1.getHeight());
-
-      for (int c = 0; c <= (int)cs.size(); ++c) {
-        int c0 = std::max(0, c - 1);
-        int c1 = std::min((int)cs.size() - 1, c);
-        int dc = cs[c1] - cs[c0];
-
-        tl = tr;
-        bl = br;
-
-        if (c0 != c1) {
-          createHistogram(blockRadius, bins, cs[c1], rs[r0], I1, hist);
-          tr = createTransfer(hist, limit, cdfs);
-          if (r0 == r1) {
-            br = tr;
-          } else {
-            createHistogram(blockRadius, bins, cs[c1], rs[r1], I1, hist);
-            br = createTransfer(hist, limit, cdfs);
-          }
-        }
-
-        int xMin = (c == 0 ? 0 : cs[c0]);
-        int xMax = (c < (int)cs.size() ? cs[c1] : I1.getWidth());
-        for (int y = yMin; y < yMax; ++y) {
-          float wy = (float)(rs[r1] - y) / dr;
-
-          for (int x = xMin; x < xMax; ++x) {
-            float wx = (float)(cs[c1] - x) / dc;
-            int v = fastRound(I1[y][x] / 255.0f * bins);
-            float t00 = tl[v];
-            float t01 = tr[v];
-            float t10 = bl[v];
-            float t11 = br[v];
-            float t0 = 0.0f, t1 = 0.0f;
-
-            if (c0 == c1) {
-              t0 = t00;
-              t1 = t10;
-            } else {
-              t0 = wx * t00 + (1.0f - wx) * t01;
-              t1 = wx * t10 + (1.0f - wx) * t11;
-            }
-
-            float t = (r0 == r1) ? t0 : wy * t0 + (1.0f - wy) * t1;
-            I2[y][x] = std::max(0, std::min(255, fastRound(t * 255.0f)));
-          }
-        }
-      }
-    }
+    // Transfer functions of the blocks, then interpolation between the
+    // transfer functions of the 4 nearest blocks for each pixel
+    std::vector<std::vector<float> > transfers(rs.size() * cs.size());
+    vpParallel::parallelFor(0, (unsigned int)transfers.size(),
+                            vpBlockTransferBody(I1, rs, cs, blockRadius, bins, limit, lut, transfers), 0, 1);
+    vpParallel::parallelFor(0, I1.getHeight(), vpInterpolationBody(I1, I2, rs, cs, lut, transfers));
   } else {
-    std::vector<int> hist(bins + 1), prev_hist(bins + 1);
-    std::vector<int> clippedHist(bins + 1);
-
-    bool first = true;
-    int xMin0 = 0;
-    int xMax0 = std::min((int)I1.getWidth(), blockRadius);
-
-    for (int y = 0; y < (int)I1.getHeight(); y++) {
-      int yMin = std::max(0, y - (int)blockRadius);
-      int yMax = std::min((int)I1.getHeight(), y + blockRadius + 1);
-      int h = yMax - yMin;
-
-#if 0
-      std::fill(hist.begin(), hist.end(), 0);
-      // Compute histogram for the current block
-      for (int yi = yMin; yi < yMax; yi++) {
-        for (int xi = xMin0; xi < xMax0; xi++) {
-          ++hist[fastRound(I1[yi][xi] / 255.0f * bins)];
-        }
-      }
-#else
-      if (first) {
-        first = false;
-        // Compute histogram for the block at (0,0)
-        for (int yi = yMin; yi < yMax; yi++) {
-          for (int xi = xMin0; xi < xMax0; xi++) {
-            ++hist[fastRound(I1[yi][xi] / 255.0f * bins)];
-          }
-        }
-      } else {
-        hist = prev_hist;
-
-        if (yMin > 0) {
-          int yMin1 = yMin - 1;
-          // Sliding histogram, remove top
-          for (int xi = xMin0; xi < xMax0; xi++) {
-            --hist[fastRound(I1[yMin1][xi] / 255.0f * bins)];
-          }
-        }
-
-        if (y + blockRadius < (int)I1.getHeight()) {
-          int yMax1 = yMax - 1;
-          // Sliding histogram, add bottom
-          for (int xi = xMin0; xi < xMax0; xi++) {
-            ++hist[fastRound(I1[yMax1][xi] / 255.0f * bins)];
-          }
-        }
-      }
-      prev_hist = hist;
-#endif
-
-      for (int x = 0; x < (int)I1.getWidth(); x++) {
-        int xMin = std::max(0, x - (int)blockRadius);
-        int xMax = x + blockRadius + 1;
-
-        if (xMin > 0) {
-          int xMin1 = xMin - 1;
-          // Sliding histogram, remove left
-          for (int yi = yMin; yi < yMax; yi++) {
-            --hist[fastRound(I1[yi][xMin1] / 255.0f * bins)];
-          }
-        }
-
-        if (xMax <= (int)I1.getWidth()) {
-          int xMax1 = xMax - 1;
-          // Sliding histogram, add right
-          for (int yi = yMin; yi < yMax; yi++) {
-            ++hist[fastRound(I1[yi][xMax1] / 255.0f * bins)];
-          }
-        }
-
-        int v = fastRound(I1[y][x] / 255.0f * bins);
-        int w = std::min((int)I1.getWidth(), xMax) - xMin;
-        int n = h * w;
-        int limit = (int)(slope * n / bins + 0.5f);
-        I2[y][x] = fastRound(transferValue(v, hist, clippedHist, limit) * 255.0f);
-      }
-    }
+    vpParallel::parallelFor(0, I1.getHeight(), vpSlidingBody(I1, I2, blockRadius, bins, slope, lut));
   }
 }
 
@@ -507,26 +550,5 @@ void vp::clahe(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int blockRadius,
   clahe(pG, resG, blockRadius, bins, slope, fast);
   clahe(pB, resB, blockRadius, bins, slope, fast);
 
-  I2.resize(I1.getHeight(), I1.getWidth());
-  unsigned int size = I2.getWidth() * I2.getHeight();
-  unsigned char *ptrStart = (unsigned char *)I2.bitmap;
-  unsigned char *ptrEnd = ptrStart + size * 4;
-  unsigned char *ptrCurrent = ptrStart;
-
-  unsigned int cpt = 0;
-  while (ptrCurrent != ptrEnd) {
-    *ptrCurrent = resR.bitmap[cpt];
-    ++ptrCurrent;
-
-    *ptrCurrent = resG.bitmap[cpt];
-    ++ptrCurrent;
-
-    *ptrCurrent = resB.bitmap[cpt];
-    ++ptrCurrent;
-
-    *ptrCurrent = pa.bitmap[cpt];
-    ++ptrCurrent;
-
-    cpt++;
-  }
+  vpImageConvert::merge(&resR, &resG, &resB, &pa, I2);
 }
@@ -36,137 +36,378 @@
  *
  *****************************************************************************/
 
+
 /*!
   \file vpConnectedComponents.cpp
   \brief Basic connected components.
 */
 
-#include <queue>
+#include <algorithm>
+#include <limits>
+#include <visp3/core/vpParallel.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
 {
-void getNeighbors(const vpImage<unsigned char> &I, std::queue<vpImagePoint> &listOfNeighbors, unsigned int i,
-                  unsigned int j, const vpImageMorphology::vpConnexityType &connexity)
+// Number of rows labeled by a stripe of the first pass
+const unsigned int stripe_height = 64;
+
+/*
+  Union-find on the provisional labels. A root is its own parent and the
+  root of a tree is always its smallest label, so that parent[l] <= l.
+*/
+inline int findRoot(std::vector<int> &parent, int label)
 {
-  unsigned char currValue = I[i][j];
+  int root = label;
+  while (parent[root] < root) {
+    root = parent[root];
+  }
 
-  if (connexity == vpImageMorphology::CONNEXITY_4) {
-    // Top
-    if (I[i - 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i - 1, j));
-    }
+  // Path compression
+  while (label != root) {
+    int next = parent[label];
+    parent[label] = root;
+    label = next;
+  }
 
-    // Left
-    if (I[i][j - 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j - 1));
-    }
+  return root;
+}
 
-    // Right
-    if (I[i][j + 1] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i, j + 1));
-    }
+inline int merge(std::vector<int> &parent, int label1, int label2)
+{
+  int root1 = findRoot(parent, label1);
+  int root2 = findRoot(parent, label2);
+
+  if (root1 < root2) {
+    parent[root2] = root1;
+    return root1;
+  }
+
+  parent[root1] = root2;
+  return root2;
+}
+
+/*
+  Label of the pixel at (i, j) given the labels of its already visited
+  neighbors, following the decision tree of Wu et al. (SAUF): with an 8-connexity
+  the upper neighbor b is connected to the upper-left a and to the left d
+  neighbors, so a single merge is needed when the upper-right c neighbor is
+  used. A neighbor is connected if it has the same value as the current pixel.
+  Returns 0 when no neighbor is connected.
+*/
+inline int neighborLabel(const unsigned char *row, const unsigned char *prev, const int *lrow, const int *lprev,
+                         unsigned int j, unsigned int width, std::vector<int> &parent, bool connexity8)
+{
+  const unsigned char value = row[j];
+  const bool left = j > 0 && row[j - 1] == value;
 
-    // Bottom
-    if (I[i + 1][j] == currValue) {
-      listOfNeighbors.push(vpImagePoint(i + 1, j));
+  if (prev != NULL) {
+    if (prev[j] == value) {
+      return (!connexity8 && left) ? merge(parent, lprev[j], lrow[j - 1]) : lprev[j];
     }
-  } else {
-    for (int cpt1 = -1; cpt1 <= 1; cpt1++) {
-      for (int cpt2 = -1; cpt2 <= 1; cpt2++) {
-        // Everything except the current position
-        if (cpt1 != 0 || cpt2 != 0) {
-          if (I[(int)i + cpt1][(int)j + cpt2] == currValue) {
-            listOfNeighbors.push(vpImagePoint((int)i + cpt1, (int)j + cpt2));
-          }
+
+    if (connexity8) {
+      const bool upLeft = j > 0 && prev[j - 1] == value;
+      if (j + 1 < width && prev[j + 1] == value) {
+        if (upLeft) {
+          return merge(parent, lprev[j + 1], lprev[j - 1]);
         }
+        return left ? merge(parent, lprev[j + 1], lrow[j - 1]) : lprev[j + 1];
+      }
+      if (upLeft) {
+        return lprev[j - 1];
       }
     }
   }
+
+  return left ? lrow[j - 1] : 0;
 }
 
-void visitNeighbors(vpImage<unsigned char> &I_copy, std::queue<vpImagePoint> &listOfNeighbors, vpImage<int> &labels,
-                    int current_label, const vpImageMorphology::vpConnexityType &connexity)
+/*
+  First pass of the labeling: each stripe of rows is labeled independently
+  with provisional labels starting at (first row of the stripe) * width + 1,
+  and the statistics are accumulated per provisional label.
+*/
+class vpFirstPassBody : public vpParallelBody
 {
-  // Visit the neighbors
-  while (!listOfNeighbors.empty()) {
-    vpImagePoint imPt = listOfNeighbors.front();
-    unsigned int i = (unsigned int)imPt.get_i();
-    unsigned int j = (unsigned int)imPt.get_j();
-    listOfNeighbors.pop();
-
-    if (I_copy[i][j]) {
-      getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
-
-      // Reset current position and set label
-      I_copy[i][j] = 0;
-      labels[i][j] = current_label;
+public:
+  vpFirstPassBody(const vpImage<unsigned char> &I, vpImage<int> &labels, std::vector<int> &parent,
+                  std::vector<int> &nbLabels, std::vector<std::vector<vp::vpConnectedComponentStats> > *stats,
+                  bool connexity8)
+    : m_I(I), m_labels(labels), m_parent(parent), m_nbLabels(nbLabels), m_stats(stats), m_connexity8(connexity8)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int width = m_I.getWidth();
+    for (unsigned int s = begin; s < end; s++) {
+      const unsigned int row_begin = s * stripe_height;
+      const unsigned int row_end = std::min(row_begin + stripe_height, m_I.getHeight());
+      const int base = static_cast<int>(row_begin * width) + 1;
+      int nb = 0;
+
+      for (unsigned int i = row_begin; i < row_end; i++) {
+        const unsigned char *row = m_I[i];
+        const unsigned char *prev = i > row_begin ? m_I[i - 1] : NULL;
+        int *lrow = m_labels[i];
+        const int *lprev = i > row_begin ? m_labels[i - 1] : NULL;
+
+        for (unsigned int j = 0; j < width; j++) {
+          if (row[j] == 0) {
+            lrow[j] = 0;
+            continue;
+          }
+
+          int label = neighborLabel(row, prev, lrow, lprev, j, width, m_parent, m_connexity8);
+          if (label == 0) {
+            label = base + nb;
+            m_parent[label] = label;
+            nb++;
+            if (m_stats != NULL) {
+              (*m_stats)[s].push_back(vp::vpConnectedComponentStats());
+            }
+          }
+
+          lrow[j] = label;
+          if (m_stats != NULL) {
+            (*m_stats)[s][label - base].add(i, j);
+          }
+        }
+      }
+
+      m_nbLabels[s] = nb;
     }
   }
-}
-} // namespace
 
-/*!
-  \ingroup group_imgproc_connected_components
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<int> &m_labels;
+  std::vector<int> &m_parent;
+  std::vector<int> &m_nbLabels;
+  std::vector<std::vector<vp::vpConnectedComponentStats> > *m_stats;
+  bool m_connexity8;
+};
 
-  Perform connected components detection.
+class vpSecondPassBody : public vpParallelBody
+{
+public:
+  vpSecondPassBody(vpImage<int> &labels, const std::vector<int> &finalLabels)
+    : m_labels(labels), m_finalLabels(finalLabels)
+  {
+  }
 
-  \param I : Input image (0 means background).
-  \param labels : Label image that contain for each position the component
-  label. \param nbComponents : Number of connected components. \param
-  connexity : Type of connexity.
-*/
-void vp::connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
-                             const vpImageMorphology::vpConnexityType &connexity)
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      int *lrow = m_labels[i];
+      for (unsigned int j = 0; j < m_labels.getWidth(); j++) {
+        lrow[j] = m_finalLabels[lrow[j]];
+      }
+    }
+  }
+
+private:
+  vpImage<int> &m_labels;
+  const std::vector<int> &m_finalLabels;
+};
+
+void labelComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                     std::vector<vp::vpConnectedComponentStats> *stats,
+                     const vpImageMorphology::vpConnexityType &connexity)
 {
+  nbComponents = 0;
+  if (stats != NULL) {
+    stats->clear();
+  }
   if (I.getSize() == 0) {
     return;
   }
 
-  labels.resize(I.getHeight(), I.getWidth());
+  const unsigned int width = I.getWidth(), height = I.getHeight();
+  const bool connexity8 = connexity == vpImageMorphology::CONNEXITY_8;
+  labels.resize(height, width);
+
+  // Label 0 is the background, it stays 0 in the second pass
+  std::vector<int> parent(I.getSize() + 1, 0);
+  const unsigned int nbStripes = (height + stripe_height - 1) / stripe_height;
+  std::vector<int> nbLabels(nbStripes, 0);
+  std::vector<std::vector<vp::vpConnectedComponentStats> > stripeStats(stats != NULL ? nbStripes : 0);
 
-  vpImage<unsigned char> I_copy(I.getHeight() + 2, I.getWidth() + 2);
-  // Copy and add border
-  for (unsigned int i = 0; i < I_copy.getHeight(); i++) {
-    if (i == 0 || i == I_copy.getHeight() - 1) {
-      memset(I_copy[i], 0, sizeof(unsigned char) * I_copy.getWidth());
-    } else {
-      I_copy[i][0] = 0;
-      memcpy(I_copy[i] + 1, I[i - 1], sizeof(unsigned char) * I.getWidth());
-      I_copy[i][I_copy.getWidth() - 1] = 0;
+  vpParallel::parallelFor(0, nbStripes,
+                          vpFirstPassBody(I, labels, parent, nbLabels, stats != NULL ? &stripeStats : NULL, connexity8),
+                          0, 1);
+
+  // Merge the provisional labels across the stripe borders
+  for (unsigned int s = 1; s < nbStripes; s++) {
+    const unsigned int i = s * stripe_height;
+    const unsigned char *row = I[i], *prev = I[i - 1];
+    const int *lrow = labels[i], *lprev = labels[i - 1];
+    for (unsigned int j = 0; j < width; j++) {
+      const unsigned char value = row[j];
+      if (value == 0) {
+        continue;
+      }
+      if (prev[j] == value) {
+        merge(parent, lrow[j], lprev[j]);
+      }
+      if (connexity8) {
+        if (j > 0 && prev[j - 1] == value) {
+          merge(parent, lrow[j], lprev[j - 1]);
+        }
+        if (j + 1 < width && prev[j + 1] == value) {
+          merge(parent, lrow[j], lprev[j + 1]);
+        }
+      }
     }
   }
 
-  vpImage<int> labels_copy(I.getHeight() + 2, I.getWidth() + 2, 0);
-
+  // Flatten the trees into consecutive labels. Since a root is the smallest
+  // label of its tree, the components are numbered in the raster order of
+  // their first pixel.
   int current_label = 1;
-  std::queue<vpImagePoint> listOfNeighbors;
+  for (unsigned int s = 0; s < nbStripes; s++) {
+    const int base = static_cast<int>(s * stripe_height * width) + 1;
+    for (int label = base; label < base + nbLabels[s]; label++) {
+      parent[label] = parent[label] < label ? parent[parent[label]] : current_label++;
+    }
+  }
+  nbComponents = current_label - 1;
 
-  for (unsigned int cpt1 = 0; cpt1 < I.getHeight(); cpt1++) {
-    unsigned int i = cpt1 + 1;
+  vpParallel::parallelFor(0, height, vpSecondPassBody(labels, parent));
 
-    for (unsigned int cpt2 = 0; cpt2 < I.getWidth(); cpt2++) {
-      unsigned int j = cpt2 + 1;
+  if (stats != NULL) {
+    stats->resize(static_cast<size_t>(nbComponents));
+    for (unsigned int s = 0; s < nbStripes; s++) {
+      const int base = static_cast<int>(s * stripe_height * width) + 1;
+      for (int k = 0; k < nbLabels[s]; k++) {
+        (*stats)[static_cast<size_t>(parent[base + k] - 1)].add(stripeStats[s][static_cast<size_t>(k)]);
+      }
+    }
+  }
+}
+} // namespace
 
-      if (I_copy[i][j] && labels_copy[i][j] == 0) {
-        // Get all the neighbors relative to the current position
-        getNeighbors(I_copy, listOfNeighbors, i, j, connexity);
+/*!
+  Constructor of an empty component.
+*/
+vp::vpConnectedComponentStats::vpConnectedComponentStats()
+  : m_area(0), m_left(std::numeric_limits<unsigned int>::max()), m_top(std::numeric_limits<unsigned int>::max()),
+    m_right(0), m_bottom(0), m_m10(0.), m_m01(0.), m_m20(0.), m_m11(0.), m_m02(0.)
+{
+}
 
-        // Reset current position and set label
-        I_copy[i][j] = 0;
-        labels_copy[i][j] = current_label;
+/*!
+  Merge the statistics of another part of the component.
+*/
+void vp::vpConnectedComponentStats::add(const vpConnectedComponentStats &stats)
+{
+  m_area += stats.m_area;
+  m_left = std::min(m_left, stats.m_left);
+  m_top = std::min(m_top, stats.m_top);
+  m_right = std::max(m_right, stats.m_right);
+  m_bottom = std::max(m_bottom, stats.m_bottom);
+  m_m10 += stats.m_m10;
+  m_m01 += stats.m_m01;
+  m_m20 += stats.m_m20;
+  m_m11 += stats.m_m11;
+  m_m02 += stats.m_m02;
+}
 
-        visitNeighbors(I_copy, listOfNeighbors, labels_copy, current_label, connexity);
+/*!
+  Return the bounding box of the component.
+*/
+vpRect vp::vpConnectedComponentStats::getBoundingBox() const
+{
+  if (m_area == 0) {
+    return vpRect();
+  }
+  return vpRect(m_left, m_top, m_right - m_left + 1, m_bottom - m_top + 1);
+}
 
-        // Increment label
-        current_label++;
-      }
-    }
+/*!
+  Return the centroid of the component.
+*/
+vpImagePoint vp::vpConnectedComponentStats::getCentroid() const
+{
+  if (m_area == 0) {
+    return vpImagePoint();
+  }
+  return vpImagePoint(m_m01 / m_area, m_m10 / m_area);
+}
+
+/*!
+  Initialize a moment object from the statistics of the component, without
+  a new scan of the image. The result is the same as the one of
+  vpMomentObject::fromImage() (binary version) on an image that only contains
+  the component.
+
+  \param cam : Camera parameters used to convert the pixel coordinates into
+  normalized coordinates.
+  \param obj : Moment object, whose order must be lower or equal to 2.
+*/
+void vp::vpConnectedComponentStats::toMomentObject(const vpCameraParameters &cam, vpMomentObject &obj) const
+{
+  const unsigned int order = obj.getOrder();
+  if (order > 2) {
+    throw vpException(vpException::badValue,
+                      "Connected component moments are available up to order 2, the moment object order is %d",
+                      static_cast<int>(order));
   }
 
-  for (unsigned int i = 0; i < labels.getHeight(); i++) {
-    memcpy(labels[i], labels_copy[i + 1] + 1, sizeof(int) * labels.getWidth());
+  const unsigned int n = order + 1;
+  const double moments[3][3] = {{static_cast<double>(m_area), m_m10, m_m20}, {m_m01, m_m11, 0.}, {m_m02, 0., 0.}};
+  std::vector<double> pixelMoments(n * n, 0.);
+  for (unsigned int q = 0; q < n; q++) {
+    for (unsigned int p = 0; p < n - q; p++) {
+      pixelMoments[q * n + p] = moments[q][p];
+    }
   }
 
-  nbComponents = current_label - 1;
+  obj.setType(vpMomentObject::DENSE_FULL_OBJECT);
+  obj.fromPixelMoments(pixelMoments, cam);
+}
+
+/*!
+  \ingroup group_imgproc_connected_components
+
+  Perform connected components detection. The labeling is done with a
+  two-pass union-find algorithm and is parallelized by stripes of rows.
+
+  \param I : Input image (0 means background). Neighbor pixels belong to the
+  same component when they have the same value.
+  \param labels : Label image that contain for each position the component
+  label. The components are numbered from 1, in the raster order of their
+  first pixel. \param nbComponents : Number of connected components. \param
+  connexity : Type of connexity.
+*/
+void vp::connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                             const vpImageMorphology::vpConnexityType &connexity)
+{
+  labelComponents(I, labels, nbComponents, NULL, connexity);
+}
+
+/*!
+  \ingroup group_imgproc_connected_components
+
+  Perform connected components detection and compute the area, the bounding
+  box and the moments up to order 2 of each component during the labeling,
+  so that a blob analysis only needs a single scan of the image.
+
+  \param I : Input image (0 means background). Neighbor pixels belong to the
+  same component when they have the same value.
+  \param labels : Label image that contain for each position the component
+  label. The components are numbered from 1, in the raster order of their
+  first pixel.
+  \param nbComponents : Number of connected components.
+  \param stats : Statistics of the components, stats[k] corresponds to the
+  label k+1. Use vpConnectedComponentStats::toMomentObject() to compute
+  moment based features.
+  \param connexity : Type of connexity.
+*/
+void vp::connectedComponents(const vpImage<unsigned char> &I, vpImage<int> &labels, int &nbComponents,
+                             std::vector<vpConnectedComponentStats> &stats,
+                             const vpImageMorphology::vpConnexityType &connexity)
+{
+  labelComponents(I, labels, nbComponents, &stats, connexity);
 }
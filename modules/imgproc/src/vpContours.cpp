@@ -72,71 +72,70 @@
   \brief Basic contours extraction.
 */
 
-#include <map>
+#include <algorithm>
+#include <visp3/core/vpParallel.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
 {
-bool fromTo(const vpImagePoint &from, const vpImagePoint &to, vpDirection &direction)
+// Offsets of the 8 neighbors, clockwise from the north (see vpDirectionType)
+const int g_dir_i[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+const int g_dir_j[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+// Direction from a pixel to one of its 8 neighbors
+int neighborDirection(int di, int dj)
 {
-  if (from == to) {
-    return false;
+  static const int directions[9] = {NORTH_WEST, NORTH, NORTH_EAST, WEST, LAST_DIRECTION,
+                                    EAST,       SOUTH_WEST, SOUTH, SOUTH_EAST};
+  return directions[(di + 1) * 3 + dj + 1];
+}
+
+// Shape measures accumulated while tracing a contour
+struct vpContourMeasures {
+  double m_area; // twice the signed area
+  double m_perimeter;
+  int m_first_i, m_first_j, m_last_i, m_last_j;
+  bool m_empty;
+
+  vpContourMeasures() : m_area(0), m_perimeter(0), m_first_i(0), m_first_j(0), m_last_i(0), m_last_j(0), m_empty(true)
+  {
   }
 
-  if (std::fabs(from.get_i() - to.get_i()) < std::numeric_limits<double>::epsilon()) {
-    if (from.get_j() < to.get_j()) {
-      direction.m_direction = EAST;
+  void add(int i, int j)
+  {
+    if (m_empty) {
+      m_first_i = i;
+      m_first_j = j;
+      m_empty = false;
     } else {
-      direction.m_direction = WEST;
-    }
-  } else if (from.get_i() < to.get_i()) {
-    if (std::fabs(from.get_j() - to.get_j()) < std::numeric_limits<double>::epsilon()) {
-      direction.m_direction = SOUTH;
-    } else if (from.get_j() < to.get_j()) {
-      direction.m_direction = SOUTH_EAST;
-    } else {
-      direction.m_direction = SOUTH_WEST;
-    }
-  } else {
-    if (std::fabs(from.get_j() - to.get_j()) < std::numeric_limits<double>::epsilon()) {
-      direction.m_direction = NORTH;
-    } else if (from.get_j() < to.get_j()) {
-      direction.m_direction = NORTH_EAST;
-    } else {
-      direction.m_direction = NORTH_WEST;
+      addEdge(m_last_i, m_last_j, i, j);
     }
+    m_last_i = i;
+    m_last_j = j;
   }
 
-  return true;
-}
-
-bool crossesEastBorder(const vpImage<int> &I, bool checked[8], const vpImagePoint &point)
-{
-  vpDirection direction;
-  if (!fromTo(point, vpImagePoint(point.get_i(), point.get_j() + 1), direction)) {
-    return false;
+  void addEdge(int i1, int j1, int i2, int j2)
+  {
+    m_area += static_cast<double>(j1) * i2 - static_cast<double>(j2) * i1;
+    m_perimeter += (i1 != i2 && j1 != j2) ? M_SQRT2 : 1.0;
   }
 
-  bool b = checked[(int)direction.m_direction];
-
-  if (point.get_i() < 0 || point.get_j() < 0) {
-    return false;
+  // Close the polygon
+  void close()
+  {
+    if (!m_empty && (m_last_i != m_first_i || m_last_j != m_first_j)) {
+      addEdge(m_last_i, m_last_j, m_first_i, m_first_j);
+    }
   }
+};
 
-  unsigned int i = (unsigned int)point.get_i();
-  unsigned int j = (unsigned int)point.get_j();
-
-  return I[i][j] != 0 && ((unsigned int)point.get_j() == I.getWidth() - 1 || b);
-}
-
-void addContourPoint(vpImage<int> &I, vp::vpContour *border, const vpImagePoint &point, bool checked[8], int nbd)
+void addContourPoint(vpImage<int> &I, vp::vpFlatContours &contours, vpContourMeasures &measures, int i, int j,
+                     bool east_checked, int nbd)
 {
-  border->m_points.push_back(vpImagePoint(point.get_i() - 1, point.get_j() - 1)); // remove 1-pixel padding
+  contours.m_points.push_back(vpImagePoint(i - 1, j - 1)); // remove 1-pixel padding
+  measures.add(i, j);
 
-  unsigned int i = (unsigned int)point.get_i();
-  unsigned int j = (unsigned int)point.get_j();
-
-  if (crossesEastBorder(I, checked, point)) {
+  if (east_checked) {
     I[i][j] = -nbd;
   } else if (I[i][j] == 1) {
     // Only set if the pixel has not been visited before (3.4) (b)
@@ -144,84 +143,345 @@ void addContourPoint(vpImage<int> &I, vp::vpContour *border, const vpImagePoint
   } // Otherwise leave it alone
 }
 
-void followBorder(vpImage<int> &I, const vpImagePoint &ij, vpImagePoint &i2j2, vp::vpContour *border, int nbd)
+// Border following from the pixel (i, j), (i2, j2) being the neighbor
+// background pixel (steps (3.1) to (3.5) of Suzuki and Abe). The padded image
+// ensures that the neighbors of a foreground pixel are always inside the image.
+void followBorder(vpImage<int> &I, int i, int j, int i2, int j2, int nbd, vp::vpFlatContours &contours,
+                  vpContourMeasures &measures)
 {
-  vpDirection dir;
-  if (!fromTo(ij, i2j2, dir)) {
-    throw vpException(vpException::fatalError, "ij == i2j2");
-  }
-
-  vpDirection trace = dir.clockwise();
-  vpImagePoint i1j1(-1, -1);
+  const int dir = neighborDirection(i2 - i, j2 - j);
 
   // Find i1j1 (3.1)
-  while (trace.m_direction != dir.m_direction) {
-    vpImagePoint activePixel = trace.active(I, ij);
-
-    if (activePixel.get_i() >= 0 && activePixel.get_j() >= 0) {
-      i1j1 = activePixel;
+  int i1 = -1, j1 = -1;
+  for (int trace = (dir + 1) % 8; trace != dir; trace = (trace + 1) % 8) {
+    if (I[i + g_dir_i[trace]][j + g_dir_j[trace]] != 0) {
+      i1 = i + g_dir_i[trace];
+      j1 = j + g_dir_j[trace];
       break;
     }
-
-    trace = trace.clockwise();
   }
 
-  if (i1j1.get_i() < 0 || i1j1.get_j() < 0) {
+  if (i1 < 0) {
     //(3.1) ; single pixel contour
     return;
   }
 
-  i2j2 = i1j1;
-  vpImagePoint i3j3 = ij; //(3.2)
-
-  bool checked[8] = {false, false, false, false, false, false, false, false};
+  i2 = i1;
+  j2 = j1;
+  int i3 = i, j3 = j; //(3.2)
 
   while (true) {
-    if (!fromTo(i3j3, i2j2, dir)) {
-      throw vpException(vpException::fatalError, "i3j3 == i2j2");
+    // (3.3) search counterclockwise the next border pixel, starting after
+    // the previous one
+    int trace = neighborDirection(i2 - i3, j2 - j3);
+    bool east_checked = false;
+    int i4, j4;
+    while (true) {
+      trace = (trace + 7) % 8;
+      i4 = i3 + g_dir_i[trace];
+      j4 = j3 + g_dir_j[trace];
+      if (I[i4][j4] != 0) {
+        break;
+      }
+      if (trace == EAST) {
+        east_checked = true;
+      }
     }
 
-    trace = dir.counterClockwise();
-    vpImagePoint i4j4(-1, -1);
+    addContourPoint(I, contours, measures, i3, j3, east_checked, nbd);
 
-    // Reset checked
-    for (int cpt = 0; cpt < 8; cpt++) {
-      checked[cpt] = false;
+    if (i4 == i && j4 == j && i3 == i1 && j3 == j1) {
+      //(3.5)
+      break;
     }
 
-    while (true) {
-      i4j4 = trace.active(I, i3j3); //(3.3)
-      if (i4j4.get_i() >= 0 && i4j4.get_j() >= 0) {
-        break;
+    //(3.5)
+    i2 = i3;
+    j2 = j3;
+    i3 = i4;
+    j3 = j4;
+  }
+}
+
+// Suzuki and Abe border following, the contours are stored in the order they
+// are found with their full hierarchy
+void traceContours(const vpImage<unsigned char> &I_original, vp::vpFlatContours &contours)
+{
+  contours.clear();
+
+  // Copy uchar I_original into int I + padding
+  vpImage<int> I(I_original.getHeight() + 2, I_original.getWidth() + 2);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    if (i == 0 || i == I.getHeight() - 1) {
+      memset(I[i], 0, sizeof(int) * I.getWidth());
+    } else {
+      I[i][0] = 0;
+      for (unsigned int j = 0; j < I_original.getWidth(); j++) {
+        I[i][j + 1] = I_original[i - 1][j];
+      }
+      I[i][I.getWidth() - 1] = 0;
+    }
+  }
+
+  // Ref: http://openimaj.org/
+  // Ref: Satoshi Suzuki and others. Topological structural analysis of
+  // digitized binary images by border following.
+  // The border numbered nbd is the contour nbd - 2, the background being the
+  // border 1.
+  int nbd = 1;  // Newest border
+  int lnbd = 1; // Last newest border
+
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  for (int i = 0; i < height; i++) {
+    lnbd = 1; // Reset LNBD at the beginning of each scan row
+
+    for (int j = 0; j < width; j++) {
+      int fji = I[i][j];
+
+      bool isOuter = (fji == 1 && (j == 0 || I[i][j - 1] == 0));
+      bool isHole = (fji >= 1 && (j == width - 1 || I[i][j + 1] == 0));
+
+      if (isOuter || isHole) { // else (1) (c)
+        vp::vpContourType type;
+        int from_j;
+        nbd++;
+
+        if (isOuter) {
+          //(1) (a)
+          type = vp::CONTOUR_OUTER;
+          from_j = j - 1;
+        } else {
+          //(1) (b)
+          if (fji > 1) {
+            lnbd = fji;
+          }
+          type = vp::CONTOUR_HOLE;
+          from_j = j + 1;
+        }
+
+        // Table 1, the background is a hole without parent
+        const int prime = lnbd - 2;
+        const vp::vpContourType prime_type = prime < 0 ? vp::CONTOUR_HOLE : contours.m_types[(size_t)prime];
+        const int prime_parent = prime < 0 ? -1 : contours.m_parents[(size_t)prime];
+        contours.m_parents.push_back(type == prime_type ? prime_parent : prime);
+        contours.m_types.push_back(type);
+
+        vpContourMeasures measures;
+        followBorder(I, i, j, i, from_j, nbd, contours, measures);
+
+        //(3) (1) ; single pixel contour
+        if (measures.m_empty) {
+          contours.m_points.push_back(vpImagePoint(i - 1, j - 1)); // remove 1-pixel padding
+          I[i][j] = -nbd;
+        }
+
+        measures.close();
+        contours.m_offsets.push_back(static_cast<unsigned int>(contours.m_points.size()));
+        contours.m_areas.push_back(std::fabs(measures.m_area) / 2.0);
+        contours.m_perimeters.push_back(measures.m_perimeter);
       }
 
-      checked[(int)trace.m_direction] = true;
-      trace = trace.counterClockwise();
+      //(4)
+      if (fji != 0 && fji != 1) {
+        lnbd = std::abs(fji);
+      }
     }
+  }
+}
 
-    addContourPoint(I, border, i3j3, checked, nbd);
+// Keep only the outer contours without parent
+void keepExternalContours(vp::vpFlatContours &contours)
+{
+  unsigned int nb_contours = 0, nb_points = 0;
+  for (unsigned int k = 0; k < contours.size(); k++) {
+    if (contours.m_parents[k] < 0 && contours.m_types[k] == vp::CONTOUR_OUTER) {
+      const unsigned int begin = contours.m_offsets[k], end = contours.m_offsets[k + 1];
+      std::copy(contours.m_points.begin() + begin, contours.m_points.begin() + end,
+                contours.m_points.begin() + nb_points);
+      contours.m_offsets[nb_contours] = nb_points;
+      contours.m_types[nb_contours] = contours.m_types[k];
+      contours.m_areas[nb_contours] = contours.m_areas[k];
+      contours.m_perimeters[nb_contours] = contours.m_perimeters[k];
+      nb_points += end - begin;
+      nb_contours++;
+    }
+  }
 
-    if (i4j4 == ij && i3j3 == i1j1) {
-      //(3.5)
-      break;
+  contours.m_points.resize(nb_points);
+  contours.m_offsets.resize(nb_contours + 1);
+  contours.m_offsets[nb_contours] = nb_points;
+  contours.m_parents.assign(nb_contours, -1);
+  contours.m_types.resize(nb_contours);
+  contours.m_areas.resize(nb_contours);
+  contours.m_perimeters.resize(nb_contours);
+}
+
+double distanceToSegment(const vpImagePoint &p, const vpImagePoint &a, const vpImagePoint &b)
+{
+  const double ab_i = b.get_i() - a.get_i(), ab_j = b.get_j() - a.get_j();
+  const double ap_i = p.get_i() - a.get_i(), ap_j = p.get_j() - a.get_j();
+  const double ab2 = ab_i * ab_i + ab_j * ab_j;
+  double t = ab2 > 0 ? (ap_i * ab_i + ap_j * ab_j) / ab2 : 0;
+  t = std::max(0.0, std::min(1.0, t));
+  const double d_i = ap_i - t * ab_i, d_j = ap_j - t * ab_j;
+  return std::sqrt(d_i * d_i + d_j * d_j);
+}
+
+// Douglas-Peucker approximation of a closed contour, the kept points are moved
+// to the beginning of the array and their number is returned
+unsigned int approximatePolygon(vpImagePoint *points, unsigned int n, double epsilon, std::vector<unsigned char> &keep,
+                                std::vector<std::pair<unsigned int, unsigned int> > &stack)
+{
+  if (n <= 2) {
+    return n;
+  }
+
+  // Split the closed contour at the point the farthest from the first one
+  unsigned int farthest = 0;
+  double max_dist = -1;
+  for (unsigned int k = 1; k < n; k++) {
+    const double dist = vpImagePoint::sqrDistance(points[0], points[k]);
+    if (dist > max_dist) {
+      max_dist = dist;
+      farthest = k;
     }
+  }
 
-    //(3.5)
-    i2j2 = i3j3;
-    i3j3 = i4j4;
+  keep.assign(n, 0);
+  keep[0] = 1;
+  keep[farthest] = 1;
+  stack.clear();
+  stack.push_back(std::make_pair(0u, farthest));
+  stack.push_back(std::make_pair(farthest, n)); // the index n is the first point
+
+  while (!stack.empty()) {
+    const unsigned int first = stack.back().first, last = stack.back().second;
+    stack.pop_back();
+
+    unsigned int split = first;
+    double max_distance = epsilon;
+    for (unsigned int k = first + 1; k < last; k++) {
+      const double distance = distanceToSegment(points[k], points[first], points[last % n]);
+      if (distance > max_distance) {
+        max_distance = distance;
+        split = k;
+      }
+    }
+
+    if (split != first) {
+      keep[split] = 1;
+      stack.push_back(std::make_pair(first, split));
+      stack.push_back(std::make_pair(split, last));
+    }
   }
+
+  unsigned int nb_kept = 0;
+  for (unsigned int k = 0; k < n; k++) {
+    if (keep[k]) {
+      points[nb_kept++] = points[k];
+    }
+  }
+  return nb_kept;
 }
 
-bool isOuterBorderStart(const vpImage<int> &I, unsigned int i, unsigned int j)
+bool lessPoint(const vpImagePoint &a, const vpImagePoint &b)
 {
-  return (I[i][j] == 1 && (j == 0 || I[i][j - 1] == 0));
+  return a.get_j() < b.get_j() || (a.get_j() == b.get_j() && a.get_i() < b.get_i());
 }
 
-bool isHoleBorderStart(const vpImage<int> &I, unsigned int i, unsigned int j)
+double cross(const vpImagePoint &o, const vpImagePoint &a, const vpImagePoint &b)
 {
-  return (I[i][j] >= 1 && (j == I.getWidth() - 1 || I[i][j + 1] == 0));
+  return (a.get_j() - o.get_j()) * (b.get_i() - o.get_i()) - (a.get_i() - o.get_i()) * (b.get_j() - o.get_j());
+}
+
+// Convex hull of a contour with the monotone chain algorithm, the hull is
+// written at the beginning of the array and its size is returned
+unsigned int approximateConvexHull(vpImagePoint *points, unsigned int n, std::vector<vpImagePoint> &sorted,
+                                   std::vector<vpImagePoint> &hull)
+{
+  if (n <= 2) {
+    return n;
+  }
+
+  sorted.assign(points, points + n);
+  std::sort(sorted.begin(), sorted.end(), lessPoint);
+  hull.resize(2 * n);
+
+  unsigned int size = 0;
+  // Lower hull
+  for (unsigned int k = 0; k < n; k++) {
+    while (size >= 2 && cross(hull[size - 2], hull[size - 1], sorted[k]) <= 0) {
+      size--;
+    }
+    hull[size++] = sorted[k];
+  }
+  // Upper hull
+  for (unsigned int k = n - 1, lower_size = size + 1; k-- > 0;) {
+    while (size >= lower_size && cross(hull[size - 2], hull[size - 1], sorted[k]) <= 0) {
+      size--;
+    }
+    hull[size++] = sorted[k];
+  }
+  // The last point is the first one
+  size--;
+
+  std::copy(hull.begin(), hull.begin() + size, points);
+  return size;
 }
 
+// Approximate each contour in place, the new number of points of each
+// contour is stored in sizes
+class vpContourApproximationBody : public vpParallelBody
+{
+public:
+  vpContourApproximationBody(vp::vpFlatContours &contours, vp::vpContourApproximationType approximation,
+                             double epsilon, std::vector<unsigned int> &sizes)
+    : m_contours(contours), m_approximation(approximation), m_epsilon(epsilon), m_sizes(sizes)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    std::vector<unsigned char> keep;
+    std::vector<std::pair<unsigned int, unsigned int> > stack;
+    std::vector<vpImagePoint> sorted, hull;
+
+    for (unsigned int k = begin; k < end; k++) {
+      vpImagePoint *points = &m_contours.m_points[m_contours.m_offsets[k]];
+      const unsigned int n = m_contours.getNbPoints(k);
+      if (m_approximation == vp::CONTOUR_APPROX_POLYGON) {
+        m_sizes[k] = approximatePolygon(points, n, m_epsilon, keep, stack);
+      } else {
+        m_sizes[k] = approximateConvexHull(points, n, sorted, hull);
+      }
+    }
+  }
+
+private:
+  vp::vpFlatContours &m_contours;
+  vp::vpContourApproximationType m_approximation;
+  double m_epsilon;
+  std::vector<unsigned int> &m_sizes;
+};
+
+void approximateContours(vp::vpFlatContours &contours, vp::vpContourApproximationType approximation, double epsilon)
+{
+  std::vector<unsigned int> sizes(contours.size());
+  vpParallel::parallelFor(0, contours.size(),
+                          vpContourApproximationBody(contours, approximation, epsilon, sizes));
+
+  // Remove the gaps between the approximated contours
+  unsigned int nb_points = 0;
+  for (unsigned int k = 0; k < contours.size(); k++) {
+    const unsigned int begin = contours.m_offsets[k];
+    std::copy(contours.m_points.begin() + begin, contours.m_points.begin() + begin + sizes[k],
+              contours.m_points.begin() + nb_points);
+    contours.m_offsets[k] = nb_points;
+    nb_points += sizes[k];
+  }
+  contours.m_offsets[contours.size()] = nb_points;
+  contours.m_points.resize(nb_points);
+}
 void getContoursList(const vp::vpContour &root, int level, vp::vpContour &contour_list)
 {
   if (level > 0) {
@@ -307,116 +567,34 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
   // Clear output results
   contourPts.clear();
 
-  // Copy uchar I_original into int I + padding
-  vpImage<int> I(I_original.getHeight() + 2, I_original.getWidth() + 2);
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    if (i == 0 || i == I.getHeight() - 1) {
-      memset(I.bitmap, 0, sizeof(int) * I.getWidth());
-    } else {
-      I[i][0] = 0;
-      for (unsigned int j = 0; j < I_original.getWidth(); j++) {
-        I[i][j + 1] = I_original[i - 1][j];
-      }
-      I[i][I.getWidth() - 1] = 0;
-    }
-  }
-
-  // Ref: http://openimaj.org/
-  // Ref: Satoshi Suzuki and others. Topological structural analysis of
-  // digitized binary images by border following.
-  int nbd = 1;  // Newest border
-  int lnbd = 1; // Last newest border
+  vpFlatContours flat_contours;
+  traceContours(I_original, flat_contours);
 
   // Background contour
   // By default the root contour is a hole contour
   vpContour *root = new vpContour(vp::CONTOUR_HOLE);
 
-  std::map<int, vpContour *> borderMap;
-  borderMap[lnbd] = root;
-
-  for (unsigned int i = 0; i < I.getHeight(); i++) {
-    lnbd = 1; // Reset LNBD at the beginning of each scan row
-
-    for (unsigned int j = 0; j < I.getWidth(); j++) {
-      int fji = I[i][j];
-
-      bool isOuter = isOuterBorderStart(I, i, j);
-      bool isHole = isHoleBorderStart(I, i, j);
-
-      if (isOuter || isHole) { // else (1) (c)
-        vpContour *border = new vpContour;
-        vpContour *borderPrime = NULL;
-        vpImagePoint from(i, j);
-
-        if (isOuter) {
-          //(1) (a)
-          nbd++;
-          from.set_j(from.get_j() - 1);
-          border->m_contourType = vp::CONTOUR_OUTER;
-          borderPrime = borderMap[lnbd];
-
-          // Table 1
-          switch (borderPrime->m_contourType) {
-          case vp::CONTOUR_OUTER:
-            border->setParent(borderPrime->m_parent);
-            break;
-
-          case vp::CONTOUR_HOLE:
-            border->setParent(borderPrime);
-            break;
-
-          default:
-            break;
-          }
-        } else {
-          //(1) (b)
-          nbd++;
-
-          if (fji > 1) {
-            lnbd = fji;
-          }
-
-          borderPrime = borderMap[lnbd];
-          from.set_j(from.get_j() + 1);
-          border->m_contourType = vp::CONTOUR_HOLE;
-
-          // Table 1
-          switch (borderPrime->m_contourType) {
-          case vp::CONTOUR_OUTER:
-            border->setParent(borderPrime);
-            break;
-
-          case vp::CONTOUR_HOLE:
-            border->setParent(borderPrime->m_parent);
-            break;
-
-          default:
-            break;
-          }
-        }
-
-        vpImagePoint ij(i, j);
-        followBorder(I, ij, from, border, nbd);
-
-        //(3) (1) ; single pixel contour
-        if (border->m_points.empty()) {
-          border->m_points.push_back(vpImagePoint(ij.get_i() - 1, ij.get_j() - 1)); // remove 1-pixel padding
-          I[i][j] = -nbd;
-        }
-
-        if (retrievalMode == CONTOUR_RETR_LIST || retrievalMode == CONTOUR_RETR_TREE) {
-          // Add contour points
-          contourPts.push_back(border->m_points);
-        }
-
-        borderMap[nbd] = border;
-      }
+  // The holes without parent are not part of the hierarchy
+  std::vector<vpContour *> borders(flat_contours.size()), orphans;
+  for (unsigned int k = 0; k < flat_contours.size(); k++) {
+    vpContour *border = new vpContour(flat_contours.m_types[k]);
+    flat_contours.getContour(k, border->m_points);
+
+    const int parent = flat_contours.m_parents[k];
+    if (parent >= 0) {
+      border->setParent(borders[(size_t)parent]);
+    } else if (border->m_contourType == vp::CONTOUR_OUTER) {
+      border->setParent(root);
+    } else {
+      orphans.push_back(border);
+    }
 
-      //(4)
-      if (fji != 0 && fji != 1) {
-        lnbd = std::abs(fji);
-      }
+    if (retrievalMode == CONTOUR_RETR_LIST || retrievalMode == CONTOUR_RETR_TREE) {
+      // Add contour points
+      contourPts.push_back(border->m_points);
     }
+
+    borders[k] = border;
   }
 
   if (retrievalMode == CONTOUR_RETR_EXTERNAL || retrievalMode == CONTOUR_RETR_LIST) {
@@ -465,4 +643,57 @@ void vp::findContours(const vpImage<unsigned char> &I_original, vpContour &conto
 
   delete root;
   root = NULL;
+  for (std::vector<vpContour *>::iterator it = orphans.begin(); it != orphans.end(); ++it) {
+    delete *it;
+  }
+}
+
+/*!
+  \ingroup group_imgproc_contours
+
+  Extract contours from a binary image into a flat storage, with one memory
+  allocation for all the points instead of one per contour.
+
+  The contours are traced with the border following algorithm of Suzuki and
+  Abe \cite articleSuzuki, in the same order as findContours(const
+  vpImage<unsigned char> &, vpContour &, std::vector<std::vector<vpImagePoint> > &,
+  const vpContourRetrievalType &). The area enclosed by each contour and its
+  length are computed during the tracing, on the polygon joining the centers
+  of the border pixels, before any approximation.
+
+  \param I_original : Input binary image (0 means background, 1 means
+  foreground, other values are not allowed).
+  \param contours : Detected contours. With vp::CONTOUR_RETR_TREE, the parent
+  of each contour is stored in vpFlatContours::m_parents. With the other
+  retrieval modes, all the parents are -1.
+  \param retrievalMode : Contour retrieval mode.
+  \param approximation : With vp::CONTOUR_APPROX_POLYGON, each contour is
+  replaced by a polygon with the Douglas-Peucker algorithm, such that the
+  removed points are at a distance lower than \e epsilon of the polygon. With
+  vp::CONTOUR_APPROX_CONVEX_HULL, each contour is replaced by its convex hull,
+  starting from its leftmost point and clockwise in the image. The contours
+  are approximated in parallel with vpParallel.
+  \param epsilon : Maximal distance in pixel between the contours and their
+  polygonal approximation.
+*/
+void vp::findContours(const vpImage<unsigned char> &I_original, vpFlatContours &contours,
+                      const vpContourRetrievalType &retrievalMode, const vpContourApproximationType &approximation,
+                      double epsilon)
+{
+  if (I_original.getSize() == 0) {
+    contours.clear();
+    return;
+  }
+
+  traceContours(I_original, contours);
+
+  if (retrievalMode == CONTOUR_RETR_EXTERNAL) {
+    keepExternalContours(contours);
+  } else if (retrievalMode == CONTOUR_RETR_LIST) {
+    contours.m_parents.assign(contours.size(), -1);
+  }
+
+  if (approximation != CONTOUR_APPROX_NONE) {
+    approximateContours(contours, approximation, epsilon);
+  }
 }
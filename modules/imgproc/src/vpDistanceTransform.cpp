@@ -0,0 +1,420 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Distance transform and skeletonization.
+ *
+ *****************************************************************************/
+
+/*!
+  \file vpDistanceTransform.cpp
+  \brief Distance transform and skeletonization.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <visp3/core/vpParallel.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+// Vertical distance of each pixel to the nearest background pixel of its
+// column, over a stripe of columns. The two scans go through the rows so that
+// the memory is accessed sequentially.
+class vpColumnDistanceBody : public vpParallelBody
+{
+public:
+  vpColumnDistanceBody(const vpImage<unsigned char> &I, vpImage<unsigned int> &G) : m_I(I), m_G(G) {}
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    // Larger than any distance in the image, see squaredEuclideanDistance()
+    const unsigned int infinity = m_I.getHeight() + m_I.getWidth();
+
+    for (unsigned int j = begin; j < end; j++) {
+      m_G[0][j] = m_I[0][j] == 0 ? 0 : infinity;
+    }
+    for (unsigned int i = 1; i < m_I.getHeight(); i++) {
+      const unsigned char *src = m_I[i];
+      const unsigned int *g_prev = m_G[i - 1];
+      unsigned int *g = m_G[i];
+      for (unsigned int j = begin; j < end; j++) {
+        g[j] = src[j] == 0 ? 0 : std::min(g_prev[j] + 1, infinity);
+      }
+    }
+    for (int i = static_cast<int>(m_I.getHeight()) - 2; i >= 0; i--) {
+      const unsigned int *g_next = m_G[i + 1];
+      unsigned int *g = m_G[i];
+      for (unsigned int j = begin; j < end; j++) {
+        g[j] = std::min(g[j], g_next[j] + 1);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  vpImage<unsigned int> &m_G;
+};
+
+// Squared distance transform of the rows: lower envelope of the parabolas
+// rooted at each column, with the algorithm of Felzenszwalb and Huttenlocher
+class vpRowDistanceBody : public vpParallelBody
+{
+public:
+  vpRowDistanceBody(const vpImage<unsigned int> &G, vpImage<double> &D) : m_G(G), m_D(D) {}
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const int width = static_cast<int>(m_G.getWidth());
+    std::vector<double> f(width), z(width + 1);
+    std::vector<int> v(width);
+
+    for (unsigned int i = begin; i < end; i++) {
+      const unsigned int *g = m_G[i];
+      for (int q = 0; q < width; q++) {
+        f[q] = static_cast<double>(g[q]) * g[q];
+      }
+
+      int k = 0;
+      v[0] = 0;
+      z[0] = -std::numeric_limits<double>::max();
+      z[1] = std::numeric_limits<double>::max();
+      for (int q = 1; q < width; q++) {
+        // Abscissa of the intersection of the parabolas rooted at q and v[k].
+        // The parabolas of the envelope hidden by the one rooted at q are
+        // removed.
+        double s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+        while (s <= z[k]) {
+          k--;
+          s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0 * (q - v[k]));
+        }
+        k++;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = std::numeric_limits<double>::max();
+      }
+
+      double *d = m_D[i];
+      k = 0;
+      for (int q = 0; q < width; q++) {
+        while (z[k + 1] < q) {
+          k++;
+        }
+        const double dq = q - v[k];
+        d[q] = dq * dq + f[v[k]];
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned int> &m_G;
+  vpImage<double> &m_D;
+};
+
+bool hasBackground(const vpImage<unsigned char> &I)
+{
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    if (std::find(I[i], I[i] + I.getWidth(), 0) != I[i] + I.getWidth()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Exact squared Euclidean distance of each pixel to the nearest background
+// pixel. The image must contain at least one background pixel.
+void squaredEuclideanDistance(const vpImage<unsigned char> &I, vpImage<double> &D)
+{
+  // The vertical distances of the columns without background pixel are set
+  // to height + width. Its square is larger than the squared diagonal, thus
+  // it never gives the minimum of a row as soon as one column has a
+  // background pixel.
+  vpImage<unsigned int> G(I.getHeight(), I.getWidth());
+  vpParallel::parallelFor(0, I.getWidth(), vpColumnDistanceBody(I, G));
+
+  D.resize(I.getHeight(), I.getWidth());
+  vpParallel::parallelFor(0, I.getHeight(), vpRowDistanceBody(G, D));
+}
+
+// Chamfer distance with a forward and a backward raster scan. The mask is
+// given by its half that precedes the pixel in raster order.
+void chamferDistance(const vpImage<unsigned char> &I, vpImage<float> &dist, const int (*mask)[3], unsigned int mask_size,
+                     int scale)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  const int infinity = std::numeric_limits<int>::max() / 2;
+  vpImage<int> D(I.getHeight(), I.getWidth());
+
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      int d = I[i][j] == 0 ? 0 : infinity;
+      for (unsigned int k = 0; k < mask_size && d != 0; k++) {
+        const int ni = i + mask[k][0], nj = j + mask[k][1];
+        if (ni >= 0 && nj >= 0 && nj < width) {
+          d = std::min(d, D[ni][nj] + mask[k][2]);
+        }
+      }
+      D[i][j] = d;
+    }
+  }
+
+  for (int i = height - 1; i >= 0; i--) {
+    for (int j = width - 1; j >= 0; j--) {
+      int d = D[i][j];
+      for (unsigned int k = 0; k < mask_size && d != 0; k++) {
+        const int ni = i - mask[k][0], nj = j - mask[k][1];
+        if (ni < height && nj >= 0 && nj < width) {
+          d = std::min(d, D[ni][nj] + mask[k][2]);
+        }
+      }
+      D[i][j] = d;
+    }
+  }
+
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      dist[i][j] = static_cast<float>(D[i][j]) / scale;
+    }
+  }
+}
+
+// Whether a foreground pixel can be removed without changing the topology,
+// for each configuration of its 8 neighbors (bit k set for the foreground
+// neighbor k, in circular order starting from the top one). The pixel is
+// simple if its foreground neighbors form a single 8-connected component and
+// its background 4-neighbors a single 4-connected component in the 3x3
+// neighborhood.
+void computeSimplePoints(bool simple[256])
+{
+  const int di[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+  const int dj[8] = {0, 1, 1, 1, 0, -1, -1, -1};
+
+  for (int code = 0; code < 256; code++) {
+    int nb_components[2] = {0, 0};
+    // 0: foreground with 8-connexity, 1: background with 4-connexity
+    for (int bg = 0; bg < 2; bg++) {
+      int visited = 0;
+      for (int seed = 0; seed < 8; seed++) {
+        const bool seed_fg = (code >> seed) & 1;
+        if ((visited >> seed) & 1 || seed_fg == (bg == 1)) {
+          continue;
+        }
+        // Only the background components that touch a 4-neighbor count
+        if (bg == 1 && seed % 2 == 1) {
+          continue;
+        }
+
+        int stack[8], stack_size = 0;
+        stack[stack_size++] = seed;
+        visited |= 1 << seed;
+        while (stack_size > 0) {
+          const int n = stack[--stack_size];
+          for (int m = 0; m < 8; m++) {
+            const bool m_fg = (code >> m) & 1;
+            if ((visited >> m) & 1 || m_fg == (bg == 1)) {
+              continue;
+            }
+            const int dist_i = std::abs(di[n] - di[m]), dist_j = std::abs(dj[n] - dj[m]);
+            const bool adjacent = bg == 0 ? (dist_i <= 1 && dist_j <= 1) : (dist_i + dist_j == 1);
+            if (adjacent) {
+              visited |= 1 << m;
+              stack[stack_size++] = m;
+            }
+          }
+        }
+        nb_components[bg]++;
+      }
+    }
+    simple[code] = nb_components[0] == 1 && nb_components[1] == 1;
+  }
+}
+
+struct vpDistanceLess {
+  explicit vpDistanceLess(const vpImage<double> &D) : m_D(D) {}
+  bool operator()(unsigned int a, unsigned int b) const { return m_D.bitmap[a] < m_D.bitmap[b]; }
+
+  const vpImage<double> &m_D;
+};
+} // namespace
+
+/*!
+  \ingroup group_imgproc_distance
+
+  Compute the distance of each pixel to the nearest background pixel. The
+  background pixels have a null distance.
+
+  The Euclidean distance is exact. It is computed in linear time with two
+  separable passes, the first one over stripes of columns and the second one
+  over the rows, both in parallel with vpParallel. Its cost does not depend on
+  the distances, contrary to iterated erosions. The chamfer distances are
+  approximations computed with two sequential raster scans.
+
+  To get a distance map to edges, the edge pixels must be the background:
+  \code
+vpImage<unsigned char> I_edges; // 255 on the edges, 0 elsewhere
+vpImage<unsigned char> I_inv(I_edges.getHeight(), I_edges.getWidth());
+for (unsigned int i = 0; i < I_edges.getHeight(); i++) {
+  for (unsigned int j = 0; j < I_edges.getWidth(); j++) {
+    I_inv[i][j] = I_edges[i][j] ? 0 : 255;
+  }
+}
+vpImage<float> dist;
+vp::distanceTransform(I_inv, dist);
+  \endcode
+
+  \param I : Input binary image (0 means background).
+  \param dist : Distance in pixels to the nearest background pixel. If the
+  image does not contain any background pixel, all the distances are set to
+  std::numeric_limits<float>::max().
+  \param type : Type of distance.
+*/
+void vp::distanceTransform(const vpImage<unsigned char> &I, vpImage<float> &dist,
+                           const vpDistanceTransformType &type)
+{
+  dist.resize(I.getHeight(), I.getWidth());
+  if (I.getSize() == 0) {
+    return;
+  }
+  if (!hasBackground(I)) {
+    dist = std::numeric_limits<float>::max();
+    return;
+  }
+
+  switch (type) {
+  case DISTANCE_CHAMFER_3_4: {
+    const int mask[4][3] = {{-1, -1, 4}, {-1, 0, 3}, {-1, 1, 4}, {0, -1, 3}};
+    chamferDistance(I, dist, mask, 4, 3);
+    break;
+  }
+
+  case DISTANCE_CHAMFER_5_7_11: {
+    const int mask[8][3] = {{-2, -1, 11}, {-2, 1, 11}, {-1, -2, 11}, {-1, -1, 7},
+                            {-1, 0, 5},   {-1, 1, 7},   {-1, 2, 11},  {0, -1, 5}};
+    chamferDistance(I, dist, mask, 8, 5);
+    break;
+  }
+
+  case DISTANCE_EUCLIDEAN:
+  default: {
+    vpImage<double> D;
+    squaredEuclideanDistance(I, D);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        dist[i][j] = static_cast<float>(std::sqrt(D[i][j]));
+      }
+    }
+    break;
+  }
+  }
+}
+
+/*!
+  \ingroup group_imgproc_distance
+
+  Compute the skeleton of the objects of a binary image by distance-ordered
+  homotopic thinning: the foreground pixels are visited by increasing
+  Euclidean distance to the background, and removed if this does not change
+  the topology of the image. The pixels with a single foreground neighbor
+  are kept, so that the branches are not shortened. The visits are repeated
+  until no more pixel can be removed.
+
+  The result is an 8-connected skeleton of one pixel width, centered in the
+  objects, with the same number of 8-connected objects and of 4-connected
+  holes as the input image.
+
+  \param I : Input binary image (0 means background).
+  \param Ires : Binary image, 255 for the pixels of the skeleton, 0 otherwise.
+*/
+void vp::skeleton(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires)
+{
+  const unsigned int height = I.getHeight(), width = I.getWidth();
+  Ires.resize(height, width, 0);
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  // Binary image with a background border, so that the neighbors of all the
+  // pixels are inside it
+  const unsigned int stride = width + 2;
+  std::vector<unsigned char> J(stride * (height + 2), 0);
+  std::vector<unsigned int> order;
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      if (I[i][j] != 0) {
+        J[(i + 1) * stride + j + 1] = 1;
+        order.push_back(i * width + j);
+      }
+    }
+  }
+
+  // Without background pixel, the pixels are visited in raster order
+  if (order.size() != I.getSize()) {
+    vpImage<double> D;
+    squaredEuclideanDistance(I, D);
+    std::stable_sort(order.begin(), order.end(), vpDistanceLess(D));
+  }
+
+  bool simple[256];
+  computeSimplePoints(simple);
+  const int offsets[8] = {-static_cast<int>(stride), -static_cast<int>(stride) + 1, 1, static_cast<int>(stride) + 1,
+                          static_cast<int>(stride),  static_cast<int>(stride) - 1,  -1, -static_cast<int>(stride) - 1};
+
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    size_t nb_kept = 0;
+    for (size_t k = 0; k < order.size(); k++) {
+      const unsigned int idx = order[k];
+      unsigned char *p = &J[(idx / width + 1) * stride + idx % width + 1];
+      int code = 0, nb_neighbors = 0;
+      for (int n = 0; n < 8; n++) {
+        if (p[offsets[n]]) {
+          code |= 1 << n;
+          nb_neighbors++;
+        }
+      }
+
+      if (nb_neighbors > 1 && simple[code]) {
+        *p = 0;
+        changed = true;
+      } else {
+        order[nb_kept++] = idx;
+      }
+    }
+    order.resize(nb_kept);
+  }
+
+  for (size_t k = 0; k < order.size(); k++) {
+    Ires[order[k] / width][order[k] % width] = 255;
+  }
+}
@@ -65,8 +65,25 @@
 #include <visp3/core/vpImageConvert.h>
 #include <visp3/core/vpImageFilter.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+namespace
+{
+// Above this kernel size, the recursive Gaussian filter is faster than the
+// convolution
+const unsigned int unsharpMaskRecursiveSize = 15;
+
+void unsharpMaskBlur(const vpImage<unsigned char> &I, vpImage<double> &I_blurred, unsigned int size)
+{
+  if (size > unsharpMaskRecursiveSize) {
+    vpImageFilter::gaussianBlurRecursive(I, I_blurred, (size - 1) / 6.0);
+  } else {
+    vpImageFilter::gaussianBlur(I, I_blurred, size);
+  }
+}
+} // namespace
+
 /*!
   \ingroup group_imgproc_brightness
 
@@ -169,7 +186,7 @@ void vp::equalizeHistogram(vpImage<unsigned char> &I)
 
   // Calculate the histogram
   vpHistogram hist;
-  hist.calculate(I);
+  hist.calculate(I, 256, vpParallel::getNumThreads());
 
   // Calculate the cumulative distribution function
   unsigned int cdf[256];
@@ -263,43 +280,24 @@ void vp::equalizeHistogram(vpImage<vpRGBa> &I, bool useHSV)
     vp::equalizeHistogram(pB);
 
     // Merge the result in I
-    unsigned int size = I.getWidth() * I.getHeight();
-    unsigned char *ptrStart = (unsigned char *)I.bitmap;
-    unsigned char *ptrEnd = ptrStart + size * 4;
-    unsigned char *ptrCurrent = ptrStart;
-
-    unsigned int cpt = 0;
-    while (ptrCurrent != ptrEnd) {
-      *ptrCurrent = pR.bitmap[cpt];
-      ++ptrCurrent;
-
-      *ptrCurrent = pG.bitmap[cpt];
-      ++ptrCurrent;
-
-      *ptrCurrent = pB.bitmap[cpt];
-      ++ptrCurrent;
-
-      *ptrCurrent = pa.bitmap[cpt];
-      ++ptrCurrent;
-
-      cpt++;
-    }
+    vpImageConvert::merge(&pR, &pG, &pB, &pa, I);
   } else {
     vpImage<unsigned char> hue(I.getHeight(), I.getWidth());
     vpImage<unsigned char> saturation(I.getHeight(), I.getWidth());
     vpImage<unsigned char> value(I.getHeight(), I.getWidth());
 
-    unsigned int size = I.getWidth() * I.getHeight();
     // Convert from RGBa to HSV
-    vpImageConvert::RGBaToHSV((unsigned char *)I.bitmap, (unsigned char *)hue.bitmap,
-                              (unsigned char *)saturation.bitmap, (unsigned char *)value.bitmap, size);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      vpImageConvert::RGBaToHSV((unsigned char *)I[i], hue[i], saturation[i], value[i], I.getWidth());
+    }
 
     // Histogram equalization on the value plane
     vp::equalizeHistogram(value);
 
     // Convert from HSV to RGBa
-    vpImageConvert::HSVToRGBa((unsigned char *)hue.bitmap, (unsigned char *)saturation.bitmap,
-                              (unsigned char *)value.bitmap, (unsigned char *)I.bitmap, size);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      vpImageConvert::HSVToRGBa(hue[i], saturation[i], value[i], (unsigned char *)I[i], I.getWidth());
+    }
   }
 }
 
@@ -559,8 +557,9 @@ void vp::stretchContrastHSV(vpImage<vpRGBa> &I)
   // Convert RGB to HSV
   vpImage<double> hueImage(I.getHeight(), I.getWidth()), saturationImage(I.getHeight(), I.getWidth()),
       valueImage(I.getHeight(), I.getWidth());
-  vpImageConvert::RGBaToHSV((unsigned char *)I.bitmap, hueImage.bitmap, saturationImage.bitmap, valueImage.bitmap,
-                            size);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    vpImageConvert::RGBaToHSV((unsigned char *)I[i], hueImage[i], saturationImage[i], valueImage[i], I.getWidth());
+  }
 
   // Find min and max Saturation and Value
   double minSaturation, maxSaturation, minValue, maxValue;
@@ -592,8 +591,9 @@ void vp::stretchContrastHSV(vpImage<vpRGBa> &I)
   }
 
   // Convert HSV to RGBa
-  vpImageConvert::HSVToRGBa(hueImage.bitmap, saturationImage.bitmap, valueImage.bitmap, (unsigned char *)I.bitmap,
-                            size);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    vpImageConvert::HSVToRGBa(hueImage[i], saturationImage[i], valueImage[i], (unsigned char *)I[i], I.getWidth());
+  }
 }
 
 /*!
@@ -618,7 +618,10 @@ void vp::stretchContrastHSV(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2)
   Sharpen a grayscale image using the unsharp mask technique.
 
   \param I : The grayscale image to sharpen.
-  \param size : Size (must be odd) of the Gaussian blur kernel.
+  \param size : Size (must be odd) of the Gaussian blur kernel. The standard
+  deviation of the Gaussian is (size-1)/6. Above a size of 15, the blur is
+  computed with vpImageFilter::gaussianBlurRecursive() whose cost does not
+  depend on the size.
   \param weight : Weight (between [0 - 1[) for the sharpening process.
  */
 void vp::unsharpMask(vpImage<unsigned char> &I, unsigned int size, double weight)
@@ -626,12 +629,14 @@ void vp::unsharpMask(vpImage<unsigned char> &I, unsigned int size, double weight
   if (weight < 1.0 && weight >= 0.0) {
     // Gaussian blurred image
     vpImage<double> I_blurred;
-    vpImageFilter::gaussianBlur(I, I_blurred, size);
+    unsharpMaskBlur(I, I_blurred, size);
 
     // Unsharp mask
-    for (unsigned int cpt = 0; cpt < I.getSize(); cpt++) {
-      double val = (I.bitmap[cpt] - weight * I_blurred.bitmap[cpt]) / (1 - weight);
-      I.bitmap[cpt] = vpMath::saturate<unsigned char>(val); // val > 255 ? 255 : (val < 0 ? 0 : val);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double val = (I[i][j] - weight * I_blurred[i][j]) / (1 - weight);
+        I[i][j] = vpMath::saturate<unsigned char>(val); // val > 255 ? 255 : (val < 0 ? 0 : val);
+      }
     }
   }
 }
@@ -660,7 +665,10 @@ void vp::unsharpMask(const vpImage<unsigned char> &I1, vpImage<unsigned char> &I
   Sharpen a color image using the unsharp mask technique.
 
   \param I : The color image to sharpen.
-  \param size : Size (must be odd) of the Gaussian blur kernel.
+  \param size : Size (must be odd) of the Gaussian blur kernel. The standard
+  deviation of the Gaussian is (size-1)/6. Above a size of 15, the blur is
+  computed with vpImageFilter::gaussianBlurRecursive() whose cost does not
+  depend on the size.
   \param weight : Weight (between [0 - 1[) for the sharpening process.
  */
 void vp::unsharpMask(vpImage<vpRGBa> &I, unsigned int size, double weight)
@@ -671,19 +679,21 @@ void vp::unsharpMask(vpImage<vpRGBa> &I, unsigned int size, double weight)
     vpImage<unsigned char> I_R, I_G, I_B;
 
     vpImageConvert::split(I, &I_R, &I_G, &I_B);
-    vpImageFilter::gaussianBlur(I_R, I_blurred_R, size);
-    vpImageFilter::gaussianBlur(I_G, I_blurred_G, size);
-    vpImageFilter::gaussianBlur(I_B, I_blurred_B, size);
+    unsharpMaskBlur(I_R, I_blurred_R, size);
+    unsharpMaskBlur(I_G, I_blurred_G, size);
+    unsharpMaskBlur(I_B, I_blurred_B, size);
 
     // Unsharp mask
-    for (unsigned int cpt = 0; cpt < I.getSize(); cpt++) {
-      double val_R = (I.bitmap[cpt].R - weight * I_blurred_R.bitmap[cpt]) / (1 - weight);
-      double val_G = (I.bitmap[cpt].G - weight * I_blurred_G.bitmap[cpt]) / (1 - weight);
-      double val_B = (I.bitmap[cpt].B - weight * I_blurred_B.bitmap[cpt]) / (1 - weight);
-
-      I.bitmap[cpt].R = vpMath::saturate<unsigned char>(val_R);
-      I.bitmap[cpt].G = vpMath::saturate<unsigned char>(val_G);
-      I.bitmap[cpt].B = vpMath::saturate<unsigned char>(val_B);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        double val_R = (I[i][j].R - weight * I_blurred_R[i][j]) / (1 - weight);
+        double val_G = (I[i][j].G - weight * I_blurred_G[i][j]) / (1 - weight);
+        double val_B = (I[i][j].B - weight * I_blurred_B[i][j]) / (1 - weight);
+
+        I[i][j].R = vpMath::saturate<unsigned char>(val_R);
+        I[i][j].G = vpMath::saturate<unsigned char>(val_G);
+        I[i][j].B = vpMath::saturate<unsigned char>(val_B);
+      }
     }
   }
 }
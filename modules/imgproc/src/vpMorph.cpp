@@ -41,13 +41,138 @@
   \brief Additional image morphology functions.
 */
 
+#include <vector>
+
 #include <visp3/core/vpImageTools.h>
 #include <visp3/imgproc/vpImgproc.h>
 
+namespace
+{
+// FIFO of pixel indexes that reuses its storage
+class vpPixelQueue
+{
+public:
+  vpPixelQueue() : m_data(), m_head(0) {}
+
+  bool empty() const { return m_head == m_data.size(); }
+  unsigned int pop() { return m_data[m_head++]; }
+  void push(unsigned int idx) { m_data.push_back(idx); }
+
+private:
+  std::vector<unsigned int> m_data;
+  size_t m_head;
+};
+
+// Neighbors of a pixel: offsets in the image and in (row, col) coordinates.
+// The first half of the neighbors precede the pixel in raster order.
+struct vpNeighborhood {
+  explicit vpNeighborhood(const vpImageMorphology::vpConnexityType &connexity) : size(0)
+  {
+    const int connexity_4[4][2] = {{-1, 0}, {0, -1}, {0, 1}, {1, 0}};
+    const int connexity_8[8][2] = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+    if (connexity == vpImageMorphology::CONNEXITY_4) {
+      size = 4;
+      for (unsigned int k = 0; k < size; k++) {
+        di[k] = connexity_4[k][0];
+        dj[k] = connexity_4[k][1];
+      }
+    } else {
+      size = 8;
+      for (unsigned int k = 0; k < size; k++) {
+        di[k] = connexity_8[k][0];
+        dj[k] = connexity_8[k][1];
+      }
+    }
+  }
+
+  unsigned int size;
+  int di[8];
+  int dj[8];
+};
+
+// Reconstruction by dilation of J under I, in place, with the hybrid algorithm
+// of L. Vincent, "Morphological grayscale reconstruction in image analysis:
+// applications and efficient algorithms", IEEE Trans. on Image Processing, 1993.
+// A raster and an anti-raster scan propagate most of the values, then a FIFO
+// propagates the remaining ones: each pixel is processed a small number of
+// times, whatever the shape of the regions.
+void reconstructByDilation(const vpImage<unsigned char> &I, vpImage<unsigned char> &J,
+                           const vpImageMorphology::vpConnexityType &connexity)
+{
+  const int height = static_cast<int>(I.getHeight()), width = static_cast<int>(I.getWidth());
+  const vpNeighborhood nbh(connexity);
+  const unsigned int half = nbh.size / 2;
+
+  // Raster scan with the neighbors preceding the pixel
+  for (int i = 0; i < height; i++) {
+    for (int j = 0; j < width; j++) {
+      unsigned char value = J[i][j];
+      for (unsigned int k = 0; k < half; k++) {
+        const int ni = i + nbh.di[k], nj = j + nbh.dj[k];
+        if (ni >= 0 && nj >= 0 && nj < width && J[ni][nj] > value) {
+          value = J[ni][nj];
+        }
+      }
+      J[i][j] = std::min(value, I[i][j]);
+    }
+  }
+
+  // Anti-raster scan with the neighbors following the pixel. The pixels that
+  // could still propagate their value are queued.
+  vpPixelQueue fifo;
+  for (int i = height - 1; i >= 0; i--) {
+    for (int j = width - 1; j >= 0; j--) {
+      unsigned char value = J[i][j];
+      for (unsigned int k = half; k < nbh.size; k++) {
+        const int ni = i + nbh.di[k], nj = j + nbh.dj[k];
+        if (ni < height && nj >= 0 && nj < width && J[ni][nj] > value) {
+          value = J[ni][nj];
+        }
+      }
+      value = std::min(value, I[i][j]);
+      J[i][j] = value;
+
+      for (unsigned int k = half; k < nbh.size; k++) {
+        const int ni = i + nbh.di[k], nj = j + nbh.dj[k];
+        if (ni < height && nj >= 0 && nj < width && J[ni][nj] < value && J[ni][nj] < I[ni][nj]) {
+          fifo.push(static_cast<unsigned int>(i * width + j));
+          break;
+        }
+      }
+    }
+  }
+
+  // Propagation
+  while (!fifo.empty()) {
+    const unsigned int idx = fifo.pop();
+    const int i = static_cast<int>(idx) / width, j = static_cast<int>(idx) % width;
+    const unsigned char value = J[i][j];
+    for (unsigned int k = 0; k < nbh.size; k++) {
+      const int ni = i + nbh.di[k], nj = j + nbh.dj[k];
+      if (ni >= 0 && ni < height && nj >= 0 && nj < width && J[ni][nj] < value && J[ni][nj] != I[ni][nj]) {
+        J[ni][nj] = std::min(value, I[ni][nj]);
+        fifo.push(static_cast<unsigned int>(ni * width + nj));
+      }
+    }
+  }
+}
+
+void complement(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic)
+{
+  Ic.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      Ic[i][j] = 255 - I[i][j];
+    }
+  }
+}
+} // namespace
+
 /*!
   \ingroup group_imgproc_morph
 
-  Fill the holes in a binary image.
+  Fill the holes in a binary image, that is the background regions that are
+  not connected to the image border.
 
   \param I : Input binary image (0 means background, 255 means foreground).
 */
@@ -62,66 +187,121 @@ void vp::fillHoles(vpImage<unsigned char> &I
     return;
   }
 
-#if USE_OLD_FILL_HOLE
-  // Code similar to Matlab imfill(BW,'holes')
-  // Replaced by flood fill as imfill use imreconstruct
-  // and our reconstruct implementation is naive and inefficient
-  // Difference between new and old implementation:
-  //  - new implementation allows to set the fill value
-  //  - only background==0 is required, before it was 0 (background) / 1
-  //  (foreground)
-  //  - no more connexity option
-  vpImage<unsigned char> mask(I.getHeight() + 2, I.getWidth() + 2, 255);
-  // Copy I to mask + add border padding + complement
+#if !USE_OLD_FILL_HOLE
+  const vpImageMorphology::vpConnexityType connexity = vpImageMorphology::CONNEXITY_4;
+#endif
+
+  // Code similar to Matlab imfill(BW,'holes'): the background is reconstructed
+  // from the image border, the pixels that are not reached are holes.
+  // Only background==0 is required, the other values are kept.
+  vpImage<unsigned char> mask(I.getHeight(), I.getWidth());
   for (unsigned int i = 0; i < I.getHeight(); i++) {
     for (unsigned int j = 0; j < I.getWidth(); j++) {
-      mask[i + 1][j + 1] = 255 - I[i][j];
+      mask[i][j] = I[i][j] == 0 ? 255 : 0;
     }
   }
 
-  vpImage<unsigned char> marker(I.getHeight() + 2, I.getWidth() + 2, 0);
-  // Create marker with 255 1-pixel border
-  for (unsigned int i = 0; i < marker.getHeight(); i++) {
-    if (i == 0 || i == marker.getHeight() - 1) {
-      for (unsigned int j = 0; j < marker.getWidth(); j++) {
-        marker[i][j] = 255;
-      }
+  vpImage<unsigned char> marker(I.getHeight(), I.getWidth(), 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    if (i == 0 || i == I.getHeight() - 1) {
+      memcpy(marker[i], mask[i], sizeof(unsigned char) * I.getWidth());
     } else {
-      marker[i][0] = 255;
-      marker[i][marker.getWidth() - 1] = 255;
+      marker[i][0] = mask[i][0];
+      marker[i][I.getWidth() - 1] = mask[i][I.getWidth() - 1];
     }
   }
 
-  vpImage<unsigned char> I_reconstruct;
-  reconstruct(marker, mask, I_reconstruct, connexity);
+  reconstructByDilation(mask, marker, connexity);
 
   for (unsigned int i = 0; i < I.getHeight(); i++) {
     for (unsigned int j = 0; j < I.getWidth(); j++) {
-      I[i][j] = 255 - I_reconstruct[i + 1][j + 1];
+      if (mask[i][j] != marker[i][j]) {
+        I[i][j] = 255;
+      }
     }
   }
-#else
-  // Create flood fill mask
-  vpImage<unsigned char> flood_fill_mask(I.getHeight() + 2, I.getWidth() + 2, 0);
-  // Copy I to mask + add border padding
+}
+
+/*!
+  \ingroup group_imgproc_morph
+
+  Remove the objects connected to the image border, like Matlab
+  imclearborder(). The image is reconstructed from its border pixels, and the
+  reconstruction is subtracted from the image.
+
+  \param I : Input grayscale or binary image.
+  \param Ires : Image without the objects connected to the border.
+  \param connexity : Type of connexity.
+*/
+void vp::clearBorder(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                     const vpImageMorphology::vpConnexityType &connexity)
+{
+  vpImage<unsigned char> marker(I.getHeight(), I.getWidth(), 0);
   for (unsigned int i = 0; i < I.getHeight(); i++) {
-    memcpy(flood_fill_mask[i + 1] + 1, I[i], sizeof(unsigned char) * I.getWidth());
+    if (i == 0 || i == I.getHeight() - 1) {
+      memcpy(marker[i], I[i], sizeof(unsigned char) * I.getWidth());
+    } else {
+      marker[i][0] = I[i][0];
+      marker[i][I.getWidth() - 1] = I[i][I.getWidth() - 1];
+    }
   }
 
-  // Perform flood fill
-  vp::floodFill(flood_fill_mask, vpImagePoint(0, 0), 0, 255);
+  reconstructByDilation(I, marker, connexity);
 
-  // Get current mask
-  vpImage<unsigned char> mask(I.getHeight(), I.getWidth());
-  for (unsigned int i = 0; i < mask.getHeight(); i++) {
-    memcpy(mask[i], flood_fill_mask[i + 1] + 1, sizeof(unsigned char) * mask.getWidth());
+  Ires.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      Ires[i][j] = I[i][j] - marker[i][j];
+    }
   }
+}
 
-  // Get image with holes filled
-  vpImage<unsigned char> I_white(I.getHeight(), I.getWidth(), 255), I_holes;
-  vpImageTools::imageSubtract(I_white, mask, I_holes);
-  vpImageTools::imageAdd(I, I_holes, I, true);
-#endif
+/*!
+  \ingroup group_imgproc_morph
+
+  H-maxima transform: suppress the regional maxima whose height is lower than
+  \e h, by reconstruction by dilation of \f$ I - h \f$ under \f$ I \f$.
+
+  \param I : Input image.
+  \param Ires : Transformed image.
+  \param h : Height threshold.
+  \param connexity : Type of connexity.
+
+  \sa hMinima(), regionalMaxima()
+*/
+void vp::hMaxima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, unsigned char h,
+                 const vpImageMorphology::vpConnexityType &connexity)
+{
+  Ires.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      Ires[i][j] = I[i][j] > h ? I[i][j] - h : 0;
+    }
+  }
+
+  reconstructByDilation(I, Ires, connexity);
+}
+
+/*!
+  \ingroup group_imgproc_morph
+
+  H-minima transform: suppress the regional minima whose depth is lower than
+  \e h, by reconstruction by erosion of \f$ I + h \f$ over \f$ I \f$.
+
+  \param I : Input image.
+  \param Ires : Transformed image.
+  \param h : Depth threshold.
+  \param connexity : Type of connexity.
+
+  \sa hMaxima(), regionalMinima()
+*/
+void vp::hMinima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires, unsigned char h,
+                 const vpImageMorphology::vpConnexityType &connexity)
+{
+  vpImage<unsigned char> Ic;
+  complement(I, Ic);
+  hMaxima(Ic, Ires, h, connexity);
+  complement(Ires, Ires);
 }
 
 /*!
@@ -137,7 +317,12 @@ void vp::fillHoles(vpImage<unsigned char> &I
   ) \f] with \f$ k \f$ such that: \f$ D_{g}^{\left ( k \right )} \left ( f
   \right ) = D_{g}^{\left ( k+1 \right )} \left ( f \right ) \f$
 
-  \param marker : Grayscale image marker.
+  The reconstruction is computed with the hybrid algorithm of L. Vincent
+  (raster scans followed by a queue-based propagation), that runs in a time
+  nearly linear in the number of pixels.
+
+  \param marker : Grayscale image marker. Marker values greater than the mask
+  are clipped to the mask.
   \param mask : Grayscale image mask.
   \param h_kp1 : Image morphologically reconstructed.
   \param connexity : Type of connexity.
@@ -157,24 +342,58 @@ void vp::reconstruct(const vpImage<unsigned char> &marker, const vpImage<unsigne
     return;
   }
 
-  vpImage<unsigned char> h_k = marker;
-  h_kp1 = h_k;
+  if (&h_kp1 == &mask) {
+    const vpImage<unsigned char> mask_copy = mask;
+    reconstruct(marker, mask_copy, h_kp1, connexity);
+    return;
+  }
 
-  do {
-    // Dilatation
-    vpImageMorphology::dilatation(h_kp1, connexity);
+  h_kp1 = marker;
+  reconstructByDilation(mask, h_kp1, connexity);
+}
 
-    // Keep min
-    for (unsigned int i = 0; i < h_kp1.getHeight(); i++) {
-      for (unsigned int j = 0; j < h_kp1.getWidth(); j++) {
-        h_kp1[i][j] = std::min(h_kp1[i][j], mask[i][j]);
-      }
-    }
+/*!
+  \ingroup group_imgproc_morph
+
+  Regional maxima: connected plateaus of constant value whose external
+  boundary pixels all have a strictly lower value.
 
-    if (h_kp1 == h_k) {
-      break;
+  \param I : Input image.
+  \param Ires : Binary image, 255 for the pixels of the regional maxima, 0 otherwise.
+  \param connexity : Type of connexity.
+
+  \sa regionalMinima(), hMaxima()
+*/
+void vp::regionalMaxima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                        const vpImageMorphology::vpConnexityType &connexity)
+{
+  // Pixels where I - R_I(I - 1) > 0
+  vpImage<unsigned char> J;
+  hMaxima(I, J, 1, connexity);
+  Ires.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      Ires[i][j] = I[i][j] > J[i][j] ? 255 : 0;
     }
+  }
+}
 
-    h_k = h_kp1;
-  } while (true);
+/*!
+  \ingroup group_imgproc_morph
+
+  Regional minima: connected plateaus of constant value whose external
+  boundary pixels all have a strictly higher value.
+
+  \param I : Input image.
+  \param Ires : Binary image, 255 for the pixels of the regional minima, 0 otherwise.
+  \param connexity : Type of connexity.
+
+  \sa regionalMaxima(), hMinima()
+*/
+void vp::regionalMinima(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                        const vpImageMorphology::vpConnexityType &connexity)
+{
+  vpImage<unsigned char> Ic;
+  complement(I, Ic);
+  regionalMaxima(Ic, Ires, connexity);
 }
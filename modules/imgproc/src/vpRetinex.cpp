@@ -155,41 +155,41 @@ void MSRCR(vpImage<vpRGBa> &I, int _scale, int scaleDiv, int level, double dynam
   std::vector<vpImage<double> > doubleResRGB(3);
   unsigned int size = I.getSize();
 
-  int kernelSize = _kernelSize;
-  if (kernelSize == -1) {
-    // Compute the kernel size from the input image size
-    kernelSize = (int)(std::min(I.getWidth(), I.getHeight()) / 2.0);
-    kernelSize = (kernelSize - kernelSize % 2) + 1;
-  }
-
   for (int channel = 0; channel < 3; channel++) {
     doubleRGB[(size_t)channel] = vpImage<double>(I.getHeight(), I.getWidth());
     doubleResRGB[(size_t)channel] = vpImage<double>(I.getHeight(), I.getWidth());
 
-    for (unsigned int cpt = 0; cpt < size; cpt++) {
-      // Shift the pixel values by 1 to avoid problem with log(0)
-      switch (channel) {
-      case 0:
-        doubleRGB[(size_t)channel].bitmap[cpt] = I.bitmap[cpt].R + 1.0;
-        break;
-
-      case 1:
-        doubleRGB[(size_t)channel].bitmap[cpt] = I.bitmap[cpt].G + 1.0;
-        break;
-
-      case 2:
-        doubleRGB[(size_t)channel].bitmap[cpt] = I.bitmap[cpt].B + 1.0;
-        break;
-
-      default:
-        break;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        // Shift the pixel values by 1 to avoid problem with log(0)
+        switch (channel) {
+        case 0:
+          doubleRGB[(size_t)channel][i][j] = I[i][j].R + 1.0;
+          break;
+
+        case 1:
+          doubleRGB[(size_t)channel][i][j] = I[i][j].G + 1.0;
+          break;
+
+        case 2:
+          doubleRGB[(size_t)channel][i][j] = I[i][j].B + 1.0;
+          break;
+
+        default:
+          break;
+        }
       }
     }
 
     for (int sc = 0; sc < scaleDiv; sc++) {
       vpImage<double> blurImage;
       double sigma = retinexScales[(size_t)sc];
-      vpImageFilter::gaussianBlur(doubleRGB[(size_t)channel], blurImage, (unsigned int)kernelSize, sigma);
+      if (_kernelSize == -1) {
+        // The cost of the recursive filter does not depend on sigma
+        vpImageFilter::gaussianBlurRecursive(doubleRGB[(size_t)channel], blurImage, sigma);
+      } else {
+        vpImageFilter::gaussianBlur(doubleRGB[(size_t)channel], blurImage, (unsigned int)_kernelSize, sigma);
+      }
 
       for (unsigned int cpt = 0; cpt < size; cpt++) {
         // Summarize the filtered values.
@@ -204,14 +204,17 @@ void MSRCR(vpImage<vpRGBa> &I, int _scale, int scaleDiv, int level, double dynam
   std::vector<double> dest(size * 3);
   const double gain = 1.0, alpha = 128.0, offset = 0.0;
 
-  for (unsigned int cpt = 0; cpt < size; cpt++) {
-    double logl = std::log((double)(I.bitmap[cpt].R + I.bitmap[cpt].G + I.bitmap[cpt].B + 3.0));
+  for (unsigned int i = 0, cpt = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++, cpt++) {
+      double logl = std::log((double)(I[i][j].R + I[i][j].G + I[i][j].B + 3.0));
 
-    dest[cpt * 3] = gain * (std::log(alpha * doubleRGB[0].bitmap[cpt]) - logl) * doubleResRGB[0].bitmap[cpt] + offset;
-    dest[cpt * 3 + 1] =
-        gain * (std::log(alpha * doubleRGB[1].bitmap[cpt]) - logl) * doubleResRGB[1].bitmap[cpt] + offset;
-    dest[cpt * 3 + 2] =
-        gain * (std::log(alpha * doubleRGB[2].bitmap[cpt]) - logl) * doubleResRGB[2].bitmap[cpt] + offset;
+      dest[cpt * 3] =
+          gain * (std::log(alpha * doubleRGB[0].bitmap[cpt]) - logl) * doubleResRGB[0].bitmap[cpt] + offset;
+      dest[cpt * 3 + 1] =
+          gain * (std::log(alpha * doubleRGB[1].bitmap[cpt]) - logl) * doubleResRGB[1].bitmap[cpt] + offset;
+      dest[cpt * 3 + 2] =
+          gain * (std::log(alpha * doubleRGB[2].bitmap[cpt]) - logl) * doubleResRGB[2].bitmap[cpt] + offset;
+    }
   }
 
   double sum = std::accumulate(dest.begin(), dest.end(), 0.0);
@@ -236,10 +239,12 @@ void MSRCR(vpImage<vpRGBa> &I, int _scale, int scaleDiv, int level, double dynam
     range = 1.0;
   }
 
-  for (unsigned int cpt = 0; cpt < size; cpt++) {
-    I.bitmap[cpt].R = vpMath::saturate<unsigned char>((255.0 * (dest[cpt * 3 + 0] - mini) / range));
-    I.bitmap[cpt].G = vpMath::saturate<unsigned char>((255.0 * (dest[cpt * 3 + 1] - mini) / range));
-    I.bitmap[cpt].B = vpMath::saturate<unsigned char>((255.0 * (dest[cpt * 3 + 2] - mini) / range));
+  for (unsigned int i = 0, cpt = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++, cpt++) {
+      I[i][j].R = vpMath::saturate<unsigned char>((255.0 * (dest[cpt * 3 + 0] - mini) / range));
+      I[i][j].G = vpMath::saturate<unsigned char>((255.0 * (dest[cpt * 3 + 1] - mini) / range));
+      I[i][j].B = vpMath::saturate<unsigned char>((255.0 * (dest[cpt * 3 + 2] - mini) / range));
+    }
   }
 }
 
@@ -259,7 +264,9 @@ void MSRCR(vpImage<vpRGBa> &I, int _scale, int scaleDiv, int level, double dynam
     - 2, enhances the bright regions of the image.
   \param dynamic : Adjusts the color of the result. Large values produce less
   saturated images. \param kernelSize : Kernel size for the gaussian blur
-  operation. If -1, the kernel size is calculated from the image size.
+  operation. If -1, the blur is not truncated and is computed with
+  vpImageFilter::gaussianBlurRecursive(), whose cost does not depend on the
+  scale.
 */
 void vp::retinex(vpImage<vpRGBa> &I, int scale, int scaleDiv, int level, const double dynamic,
                  int kernelSize)
@@ -301,7 +308,9 @@ void vp::retinex(vpImage<vpRGBa> &I, int scale, int scaleDiv, int level, const d
     - 2, enhances the bright regions of the image.
   \param dynamic : Adjusts the color of the result. Large values produce less
   saturated images. \param kernelSize : Kernel size for the gaussian blur
-  operation. If -1, the kernel size is calculated from the image size.
+  operation. If -1, the blur is not truncated and is computed with
+  vpImageFilter::gaussianBlurRecursive(), whose cost does not depend on the
+  scale.
 */
 void vp::retinex(const vpImage<vpRGBa> &I1, vpImage<vpRGBa> &I2, int scale, int scaleDiv, int level,
                  double dynamic, int kernelSize)
@@ -43,6 +43,7 @@
 
 #include <visp3/core/vpHistogram.h>
 #include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/imgproc/vpImgproc.h>
 
 namespace
@@ -359,6 +360,63 @@ int computeThresholdTriangle(vpHistogram &hist)
 
   return threshold;
 }
+
+// Compare each pixel with a threshold computed from the mean and the standard
+// deviation of its neighborhood, given by the integral images
+class vpAdaptiveThresholdBody : public vpParallelBody
+{
+public:
+  vpAdaptiveThresholdBody(const vpImage<unsigned char> &I, const vpImage<uint32_t> &II,
+                          const vpImage<uint64_t> &IIsq, vp::vpAdaptiveThresholdMethod method, unsigned int size,
+                          double k, unsigned char backgroundValue, unsigned char foregroundValue,
+                          vpImage<unsigned char> &Ires)
+    : m_I(I), m_II(II), m_IIsq(IIsq), m_method(method), m_half_size(size / 2), m_k(k),
+      m_backgroundValue(backgroundValue), m_foregroundValue(foregroundValue), m_Ires(Ires)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const unsigned int height = m_I.getHeight(), width = m_I.getWidth();
+    for (unsigned int i = begin; i < end; i++) {
+      const unsigned int top = i > m_half_size ? i - m_half_size : 0;
+      const unsigned int bottom = std::min(i + m_half_size + 1, height);
+      const uint32_t *ii_top = m_II[top], *ii_bottom = m_II[bottom];
+      const unsigned char *src = m_I[i];
+      unsigned char *dst = m_Ires[i];
+
+      for (unsigned int j = 0; j < width; j++) {
+        const unsigned int left = j > m_half_size ? j - m_half_size : 0;
+        const unsigned int right = std::min(j + m_half_size + 1, width);
+        const double area = static_cast<double>((bottom - top) * (right - left));
+        const double mean = (ii_bottom[right] - ii_bottom[left] - ii_top[right] + ii_top[left]) / area;
+
+        double threshold;
+        if (m_method == vp::ADAPTIVE_THRESHOLD_SAUVOLA) {
+          const uint64_t sqsum =
+              m_IIsq[bottom][right] - m_IIsq[bottom][left] - m_IIsq[top][right] + m_IIsq[top][left];
+          const double stdev = std::sqrt(std::max(sqsum / area - mean * mean, 0.0));
+          threshold = mean * (1.0 + m_k * (stdev / 128.0 - 1.0));
+        } else {
+          threshold = mean * (1.0 - m_k);
+        }
+
+        dst[j] = src[j] > threshold ? m_foregroundValue : m_backgroundValue;
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  const vpImage<uint32_t> &m_II;
+  const vpImage<uint64_t> &m_IIsq;
+  vp::vpAdaptiveThresholdMethod m_method;
+  unsigned int m_half_size;
+  double m_k;
+  unsigned char m_backgroundValue;
+  unsigned char m_foregroundValue;
+  vpImage<unsigned char> &m_Ires;
+};
 } // namespace
 
 /*!
@@ -379,7 +437,8 @@ unsigned char vp::autoThreshold(vpImage<unsigned char> &I, const vpAutoThreshold
   }
 
   // Compute image histogram
-  vpHistogram histogram(I);
+  vpHistogram histogram;
+  histogram.calculate(I, 256, vpParallel::getNumThreads());
   int threshold = -1;
 
   switch (method) {
@@ -419,3 +478,68 @@ unsigned char vp::autoThreshold(vpImage<unsigned char> &I, const vpAutoThreshold
 
   return threshold;
 }
+
+/*!
+  \ingroup group_imgproc_threshold
+
+  Adaptive thresholding: each pixel is compared with a threshold computed
+  from the statistics of its size x size neighborhood. The local statistics
+  are given by integer integral images (see vpImageTools::integralImage()),
+  thus the cost does not depend on the size of the neighborhood. Near the
+  borders, the statistics are computed on the part of the neighborhood that
+  is inside the image.
+
+  \param I : Input grayscale image, thresholded in place.
+  \param method : Adaptive thresholding method.
+  \param size : Size of the neighborhood, must be odd.
+  \param k : Sensitivity of the threshold, typically between 0.1 and 0.5.
+  Larger values give less foreground pixels.
+  \param backgroundValue : Value to set to the background, that is the pixels
+  lower or equal to the threshold.
+  \param foregroundValue : Value to set to the foreground.
+*/
+void vp::adaptiveThreshold(vpImage<unsigned char> &I, const vpAdaptiveThresholdMethod &method, unsigned int size,
+                           double k, const unsigned char backgroundValue, const unsigned char foregroundValue)
+{
+  if (size % 2 != 1) {
+    throw vpException(vpException::badValue, "Adaptive threshold window size %u must be odd", size);
+  }
+  if (I.getSize() == 0) {
+    return;
+  }
+
+  vpImage<uint32_t> II;
+  vpImage<uint64_t> IIsq;
+  if (method == ADAPTIVE_THRESHOLD_SAUVOLA) {
+    vpImageTools::integralImage(I, II, IIsq);
+  } else {
+    vpImageTools::integralImage(I, II);
+  }
+
+  vpParallel::parallelFor(0, I.getHeight(), vpAdaptiveThresholdBody(I, II, IIsq, method, size, k, backgroundValue,
+                                                                      foregroundValue, I));
+}
+
+/*!
+  \ingroup group_imgproc_threshold
+
+  Adaptive thresholding.
+
+  \param I : Input grayscale image.
+  \param Ires : Thresholded image.
+  \param method : Adaptive thresholding method.
+  \param size : Size of the neighborhood, must be odd.
+  \param k : Sensitivity of the threshold, typically between 0.1 and 0.5.
+  \param backgroundValue : Value to set to the background.
+  \param foregroundValue : Value to set to the foreground.
+
+  \sa adaptiveThreshold(vpImage<unsigned char> &, const vpAdaptiveThresholdMethod &, unsigned int, double,
+  unsigned char, unsigned char)
+*/
+void vp::adaptiveThreshold(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ires,
+                           const vpAdaptiveThresholdMethod &method, unsigned int size, double k,
+                           const unsigned char backgroundValue, const unsigned char foregroundValue)
+{
+  Ires = I;
+  vp::adaptiveThreshold(Ires, method, size, k, backgroundValue, foregroundValue);
+}
@@ -0,0 +1,141 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the adaptive thresholding.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testAdaptiveThreshold.cpp
+
+  \brief Compare the Bradley and Sauvola adaptive thresholding with a brute
+  force computation of the local statistics.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+// Uneven illumination with dark text-like strokes
+void documentImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      const double background = 60.0 + 150.0 * j / w;
+      const bool stroke = (i % 12 < 3 && j % 17 < 11) || (j % 23 < 2);
+      I[i][j] = static_cast<unsigned char>(stroke ? background * 0.4 : background + rng.uniform(-8.0, 8.0));
+    }
+  }
+}
+
+unsigned char thresholdRef(const vpImage<unsigned char> &I, unsigned int i, unsigned int j, unsigned int size,
+                           vp::vpAdaptiveThresholdMethod method, double k)
+{
+  const int r = static_cast<int>(size / 2);
+  double sum = 0, sqsum = 0, n = 0;
+  for (int ii = static_cast<int>(i) - r; ii <= static_cast<int>(i) + r; ii++) {
+    for (int jj = static_cast<int>(j) - r; jj <= static_cast<int>(j) + r; jj++) {
+      if (ii >= 0 && jj >= 0 && ii < static_cast<int>(I.getHeight()) && jj < static_cast<int>(I.getWidth())) {
+        sum += I[ii][jj];
+        sqsum += I[ii][jj] * I[ii][jj];
+        n++;
+      }
+    }
+  }
+  const double mean = sum / n, stdev = std::sqrt(std::max(sqsum / n - mean * mean, 0.0));
+  const double threshold =
+      method == vp::ADAPTIVE_THRESHOLD_SAUVOLA ? mean * (1 + k * (stdev / 128 - 1)) : mean * (1 - k);
+  return I[i][j] > threshold ? 255 : 0;
+}
+} // namespace
+
+TEST_CASE("Adaptive thresholding", "[adaptiveThreshold]")
+{
+  vpUniRand rng(1);
+  vpImage<unsigned char> I;
+  documentImage(I, 120, 170, rng);
+
+  const vp::vpAdaptiveThresholdMethod methods[] = {vp::ADAPTIVE_THRESHOLD_BRADLEY, vp::ADAPTIVE_THRESHOLD_SAUVOLA};
+  for (size_t m = 0; m < 2; m++) {
+    vpImage<unsigned char> I_bin;
+    vp::adaptiveThreshold(I, I_bin, methods[m], 25, 0.2);
+
+    unsigned int nb_diff = 0, nb_stroke_errors = 0;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if (I_bin[i][j] != thresholdRef(I, i, j, 25, methods[m], 0.2)) {
+          nb_diff++;
+        }
+        const bool stroke = (i % 12 < 3 && j % 17 < 11) || (j % 23 < 2);
+        if (stroke != (I_bin[i][j] == 0)) {
+          nb_stroke_errors++;
+        }
+      }
+    }
+    CHECK(nb_diff == 0);
+    // The strokes are recovered despite the illumination gradient
+    CHECK(nb_stroke_errors < I.getSize() / 100);
+  }
+
+  // In place
+  vpImage<unsigned char> I_bin, I_inplace = I;
+  vp::adaptiveThreshold(I, I_bin, vp::ADAPTIVE_THRESHOLD_SAUVOLA, 15, 0.3, 10, 20);
+  vp::adaptiveThreshold(I_inplace, vp::ADAPTIVE_THRESHOLD_SAUVOLA, 15, 0.3, 10, 20);
+  CHECK(std::equal(I_bin.bitmap, I_bin.bitmap + I_bin.getSize(), I_inplace.bitmap));
+
+  CHECK_THROWS_AS(vp::adaptiveThreshold(I_inplace, vp::ADAPTIVE_THRESHOLD_BRADLEY, 10), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
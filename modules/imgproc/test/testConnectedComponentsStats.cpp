@@ -0,0 +1,299 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the union-find connected components labeling and the blob statistics.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testConnectedComponentsStats.cpp
+
+  \brief Compare the connected components labeling and the statistics of the
+  components with a flood fill, and the moments with vpMomentObject.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <queue>
+
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+// Flood fill labeling of the pixels with the same non-zero value, in raster order
+int floodFillLabels(const vpImage<unsigned char> &I, vpImage<int> &labels, bool connexity8)
+{
+  labels.resize(I.getHeight(), I.getWidth(), 0);
+  int nb = 0;
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      if (I[i][j] == 0 || labels[i][j] != 0) {
+        continue;
+      }
+      nb++;
+      std::queue<std::pair<int, int> > queue;
+      queue.push(std::make_pair(static_cast<int>(i), static_cast<int>(j)));
+      labels[i][j] = nb;
+      while (!queue.empty()) {
+        const int ci = queue.front().first, cj = queue.front().second;
+        queue.pop();
+        for (int di = -1; di <= 1; di++) {
+          for (int dj = -1; dj <= 1; dj++) {
+            if ((di == 0 && dj == 0) || (!connexity8 && di != 0 && dj != 0)) {
+              continue;
+            }
+            const int ni = ci + di, nj = cj + dj;
+            if (ni < 0 || nj < 0 || ni >= static_cast<int>(I.getHeight()) || nj >= static_cast<int>(I.getWidth())) {
+              continue;
+            }
+            if (labels[ni][nj] == 0 && I[ni][nj] == I[i][j]) {
+              labels[ni][nj] = nb;
+              queue.push(std::make_pair(ni, nj));
+            }
+          }
+        }
+      }
+    }
+  }
+  return nb;
+}
+
+bool sameLabels(const vpImage<int> &labels1, const vpImage<int> &labels2)
+{
+  if (labels1.getHeight() != labels2.getHeight() || labels1.getWidth() != labels2.getWidth()) {
+    return false;
+  }
+  return std::equal(labels1.bitmap, labels1.bitmap + labels1.getSize(), labels2.bitmap);
+}
+
+// Random blobs: sparse seeds grown with a few random dilatations
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, double density, unsigned int nbValues,
+                 vpUniRand &rng)
+{
+  I.resize(h, w, 0);
+  for (unsigned int i = 0; i < h; i++) {
+    for (unsigned int j = 0; j < w; j++) {
+      if (rng.uniform(0.0, 1.0) < density) {
+        I[i][j] = static_cast<unsigned char>(255 - rng.uniform(0, static_cast<int>(nbValues)));
+      }
+    }
+  }
+}
+
+void checkStats(const vpImage<int> &labels, int nbComponents, const std::vector<vp::vpConnectedComponentStats> &stats)
+{
+  std::vector<vp::vpConnectedComponentStats> ref(static_cast<size_t>(nbComponents));
+  for (unsigned int i = 0; i < labels.getHeight(); i++) {
+    for (unsigned int j = 0; j < labels.getWidth(); j++) {
+      if (labels[i][j] > 0) {
+        ref[static_cast<size_t>(labels[i][j] - 1)].add(i, j);
+      }
+    }
+  }
+
+  REQUIRE(stats.size() == ref.size());
+  for (size_t k = 0; k < stats.size(); k++) {
+    CHECK(stats[k].m_area == ref[k].m_area);
+    CHECK(stats[k].m_left == ref[k].m_left);
+    CHECK(stats[k].m_top == ref[k].m_top);
+    CHECK(stats[k].m_right == ref[k].m_right);
+    CHECK(stats[k].m_bottom == ref[k].m_bottom);
+    CHECK(stats[k].m_m10 == Approx(ref[k].m_m10));
+    CHECK(stats[k].m_m01 == Approx(ref[k].m_m01));
+    CHECK(stats[k].m_m20 == Approx(ref[k].m_m20));
+    CHECK(stats[k].m_m11 == Approx(ref[k].m_m11));
+    CHECK(stats[k].m_m02 == Approx(ref[k].m_m02));
+  }
+}
+} // namespace
+
+TEST_CASE("Labeling against flood fill", "[connected_components]")
+{
+  vpUniRand rng(2019);
+  const unsigned int sizes[][2] = {{1, 1}, {1, 37}, {41, 1}, {70, 90}, {300, 160}};
+  const double densities[] = {0.2, 0.5, 0.7};
+  const unsigned int nbValues[] = {1, 3};
+
+  for (size_t n = 0; n < sizeof(sizes) / sizeof(sizes[0]); n++) {
+    for (size_t d = 0; d < sizeof(densities) / sizeof(densities[0]); d++) {
+      for (size_t v = 0; v < sizeof(nbValues) / sizeof(nbValues[0]); v++) {
+        vpImage<unsigned char> I;
+        randomImage(I, sizes[n][0], sizes[n][1], densities[d], nbValues[v], rng);
+
+        for (int c = 0; c < 2; c++) {
+          INFO("Image " << sizes[n][0] << "x" << sizes[n][1] << ", density " << densities[d] << ", values "
+                        << nbValues[v] << ", connexity " << (c ? 8 : 4));
+          const vpImageMorphology::vpConnexityType connexity =
+              c ? vpImageMorphology::CONNEXITY_8 : vpImageMorphology::CONNEXITY_4;
+
+          vpImage<int> labels, labels_ref;
+          int nbComponents = 0;
+          std::vector<vp::vpConnectedComponentStats> stats;
+          vp::connectedComponents(I, labels, nbComponents, stats, connexity);
+          const int nbComponents_ref = floodFillLabels(I, labels_ref, c == 1);
+
+          CHECK(nbComponents == nbComponents_ref);
+          CHECK(sameLabels(labels, labels_ref));
+          checkStats(labels_ref, nbComponents_ref, stats);
+
+          int nbComponents_nostats = 0;
+          vp::connectedComponents(I, labels, nbComponents_nostats, connexity);
+          CHECK(nbComponents_nostats == nbComponents_ref);
+          CHECK(sameLabels(labels, labels_ref));
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Components spanning several stripes", "[connected_components]")
+{
+  // A serpentine crossing all the stripes
+  vpImage<unsigned char> I(400, 61, 0);
+  for (unsigned int i = 2; i < I.getHeight(); i += 4) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      I[i][j] = 255;
+    }
+    const unsigned int j = (i / 4) % 2 ? 0 : I.getWidth() - 1;
+    for (unsigned int k = 1; k < 4 && i + k < I.getHeight(); k++) {
+      I[i + k][j] = 255;
+    }
+  }
+  // Diagonal link across a stripe border, only connected with an 8-connexity
+  I[127][30] = 100;
+  I[128][31] = 100;
+
+  vpImage<int> labels;
+  int nbComponents = 0;
+  std::vector<vp::vpConnectedComponentStats> stats;
+  vp::connectedComponents(I, labels, nbComponents, stats, vpImageMorphology::CONNEXITY_4);
+  CHECK(nbComponents == 3);
+  REQUIRE(stats.size() == 3);
+  CHECK(stats[0].getBoundingBox() == vpRect(0, 2, I.getWidth(), I.getHeight() - 2));
+
+  vp::connectedComponents(I, labels, nbComponents, stats, vpImageMorphology::CONNEXITY_8);
+  CHECK(nbComponents == 2);
+  REQUIRE(stats.size() == 2);
+  CHECK(stats[1].m_area == 2);
+  CHECK(stats[1].getCentroid() == vpImagePoint(127.5, 30.5));
+}
+
+TEST_CASE("Same labels whatever the number of threads", "[connected_components]")
+{
+  vpUniRand rng(7);
+  vpImage<unsigned char> I;
+  randomImage(I, 513, 257, 0.6, 1, rng);
+
+  const unsigned int nbThreads = vpParallel::getNumThreads();
+  vpImage<int> labels1, labels4;
+  int nbComponents1 = 0, nbComponents4 = 0;
+  std::vector<vp::vpConnectedComponentStats> stats1, stats4;
+
+  vpParallel::setNumThreads(1);
+  vp::connectedComponents(I, labels1, nbComponents1, stats1, vpImageMorphology::CONNEXITY_8);
+  vpParallel::setNumThreads(4);
+  vp::connectedComponents(I, labels4, nbComponents4, stats4, vpImageMorphology::CONNEXITY_8);
+  vpParallel::setNumThreads(nbThreads);
+
+  CHECK(nbComponents1 == nbComponents4);
+  CHECK(sameLabels(labels1, labels4));
+  REQUIRE(stats1.size() == stats4.size());
+  for (size_t k = 0; k < stats1.size(); k++) {
+    CHECK(stats1[k].m_area == stats4[k].m_area);
+    CHECK(stats1[k].m_m11 == stats4[k].m_m11);
+  }
+}
+
+TEST_CASE("Conversion to vpMomentObject", "[connected_components]")
+{
+  // Two ellipse-like blobs
+  vpImage<unsigned char> I(120, 160, 0);
+  for (unsigned int i = 0; i < I.getHeight(); i++) {
+    for (unsigned int j = 0; j < I.getWidth(); j++) {
+      const double u1 = (j - 50.0) / 30.0, v1 = (i - 40.0) / 15.0;
+      const double u2 = (j - 110.0) / 12.0, v2 = (i - 85.0) / 25.0;
+      if (u1 * u1 + v1 * v1 + 0.8 * u1 * v1 < 1.0 || u2 * u2 + v2 * v2 < 1.0) {
+        I[i][j] = 255;
+      }
+    }
+  }
+
+  vpImage<int> labels;
+  int nbComponents = 0;
+  std::vector<vp::vpConnectedComponentStats> stats;
+  vp::connectedComponents(I, labels, nbComponents, stats);
+  REQUIRE(nbComponents == 2);
+
+  vpCameraParameters cam(600.0, 620.0, 80.0, 60.0);
+  for (int k = 0; k < nbComponents; k++) {
+    vpImage<unsigned char> I_blob(I.getHeight(), I.getWidth(), 0);
+    for (unsigned int n = 0; n < I.getSize(); n++) {
+      I_blob.bitmap[n] = labels.bitmap[n] == k + 1 ? 255 : 0;
+    }
+
+    vpMomentObject obj_ref(2), obj(2);
+    obj_ref.fromImage(I_blob, 0, cam);
+    stats[static_cast<size_t>(k)].toMomentObject(cam, obj);
+    for (unsigned int j = 0; j <= 2; j++) {
+      for (unsigned int i = 0; i <= 2 - j; i++) {
+        INFO("Component " << k << ", m" << i << j);
+        CHECK(obj.get(i, j) == Approx(obj_ref.get(i, j)).epsilon(1e-9).margin(1e-12));
+      }
+    }
+  }
+
+  vpMomentObject obj3(3);
+  CHECK_THROWS_AS(stats[0].toMomentObject(cam, obj3), vpException);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
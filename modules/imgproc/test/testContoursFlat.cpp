@@ -0,0 +1,239 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the flat contour storage and the contour approximations.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testContoursFlat.cpp
+
+  \brief Compare the flat contour storage of vp::findContours with the
+  contour tree, and check the measures and the approximations of the contours.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+void randomBlobs(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w, 0);
+  for (int b = 0; b < 40; b++) {
+    const int ci = rng.uniform(0, static_cast<int>(h)), cj = rng.uniform(0, static_cast<int>(w));
+    const int r = rng.uniform(1, 8), r_hole = rng.uniform(-3, 3);
+    for (int i = std::max(ci - r, 0); i <= std::min(ci + r, static_cast<int>(h) - 1); i++) {
+      for (int j = std::max(cj - r, 0); j <= std::min(cj + r, static_cast<int>(w) - 1); j++) {
+        const int d2 = (i - ci) * (i - ci) + (j - cj) * (j - cj);
+        I[i][j] = (d2 <= r * r && d2 > r_hole * r_hole) ? 1 : I[i][j];
+      }
+    }
+  }
+}
+
+// Flatten the tree in depth-first order, with the index of the parents
+void flattenTree(const vp::vpContour &contour, int parent, std::vector<const vp::vpContour *> &nodes,
+                 std::vector<int> &parents)
+{
+  for (size_t k = 0; k < contour.m_children.size(); k++) {
+    nodes.push_back(contour.m_children[k]);
+    parents.push_back(parent);
+    flattenTree(*contour.m_children[k], static_cast<int>(nodes.size()) - 1, nodes, parents);
+  }
+}
+
+double distanceToPolygon(const vpImagePoint &p, const std::vector<vpImagePoint> &polygon)
+{
+  double min_distance = std::numeric_limits<double>::max();
+  for (size_t k = 0; k < polygon.size(); k++) {
+    const vpImagePoint &a = polygon[k], &b = polygon[(k + 1) % polygon.size()];
+    const double ab_i = b.get_i() - a.get_i(), ab_j = b.get_j() - a.get_j();
+    const double ab2 = ab_i * ab_i + ab_j * ab_j;
+    double t = ab2 > 0 ? ((p.get_i() - a.get_i()) * ab_i + (p.get_j() - a.get_j()) * ab_j) / ab2 : 0;
+    t = std::max(0.0, std::min(1.0, t));
+    min_distance = std::min(min_distance, vpImagePoint::distance(p, vpImagePoint(a.get_i() + t * ab_i,
+                                                                                   a.get_j() + t * ab_j)));
+  }
+  return min_distance;
+}
+} // namespace
+
+TEST_CASE("Flat contours and contour tree", "[findContours]")
+{
+  vpUniRand rng(1);
+  for (int trial = 0; trial < 20; trial++) {
+    vpImage<unsigned char> I;
+    randomBlobs(I, 80, 100, rng);
+
+    vp::vpContour tree;
+    std::vector<std::vector<vpImagePoint> > contour_pts;
+    vp::findContours(I, tree, contour_pts, vp::CONTOUR_RETR_TREE);
+
+    vp::vpFlatContours flat;
+    vp::findContours(I, flat, vp::CONTOUR_RETR_TREE);
+    REQUIRE(flat.size() == contour_pts.size());
+    REQUIRE(flat.m_offsets.size() == flat.size() + 1);
+    REQUIRE(flat.m_offsets.back() == flat.m_points.size());
+
+    std::vector<vpImagePoint> points;
+    for (unsigned int k = 0; k < flat.size(); k++) {
+      flat.getContour(k, points);
+      CHECK(points == contour_pts[k]);
+    }
+
+    // The tree is in depth-first order, the flat contours in tracing order
+    std::vector<const vp::vpContour *> nodes;
+    std::vector<int> parents;
+    flattenTree(tree, -1, nodes, parents);
+    REQUIRE(nodes.size() == flat.size());
+    std::vector<int> node_to_flat(nodes.size());
+    for (size_t n = 0; n < nodes.size(); n++) {
+      for (unsigned int k = 0; k < flat.size(); k++) {
+        if (contour_pts[k] == nodes[n]->m_points) {
+          node_to_flat[n] = static_cast<int>(k);
+        }
+      }
+    }
+    for (size_t n = 0; n < nodes.size(); n++) {
+      const int k = node_to_flat[n];
+      CHECK(flat.m_types[(size_t)k] == nodes[n]->m_contourType);
+      CHECK(flat.m_parents[(size_t)k] == (parents[n] < 0 ? -1 : node_to_flat[(size_t)parents[n]]));
+    }
+
+    // External contours
+    vp::findContours(I, tree, contour_pts, vp::CONTOUR_RETR_EXTERNAL);
+    vp::findContours(I, flat, vp::CONTOUR_RETR_EXTERNAL);
+    REQUIRE(flat.size() == contour_pts.size());
+    for (unsigned int k = 0; k < flat.size(); k++) {
+      flat.getContour(k, points);
+      CHECK(points == contour_pts[k]);
+      CHECK(flat.m_parents[k] == -1);
+      CHECK(flat.m_types[k] == vp::CONTOUR_OUTER);
+    }
+  }
+}
+
+TEST_CASE("Contour area and perimeter", "[findContours]")
+{
+  vpImage<unsigned char> I(30, 40, 0);
+  for (unsigned int i = 5; i < 15; i++) {
+    for (unsigned int j = 10; j < 30; j++) {
+      I[i][j] = 1;
+    }
+  }
+  // Single pixel
+  I[20][5] = 1;
+
+  vp::vpFlatContours contours;
+  vp::findContours(I, contours);
+  REQUIRE(contours.size() == 2);
+  // Polygon joining the centers of the border pixels
+  CHECK(contours.m_areas[0] == Approx(9.0 * 19.0));
+  CHECK(contours.m_perimeters[0] == Approx(2 * (9.0 + 19.0)));
+  CHECK(contours.m_areas[1] == 0.0);
+  CHECK(contours.m_perimeters[1] == 0.0);
+
+  // The approximations keep the corners of the rectangle
+  vp::findContours(I, contours, vp::CONTOUR_RETR_TREE, vp::CONTOUR_APPROX_POLYGON, 0.5);
+  CHECK(contours.getNbPoints(0) == 4);
+  CHECK(contours.getNbPoints(1) == 1);
+  vp::findContours(I, contours, vp::CONTOUR_RETR_TREE, vp::CONTOUR_APPROX_CONVEX_HULL);
+  REQUIRE(contours.getNbPoints(0) == 4);
+  CHECK(contours.m_points[0] == vpImagePoint(5, 10));
+  CHECK(contours.m_points[1] == vpImagePoint(5, 29));
+  CHECK(contours.m_points[2] == vpImagePoint(14, 29));
+  CHECK(contours.m_points[3] == vpImagePoint(14, 10));
+}
+
+TEST_CASE("Contour approximations", "[findContours]")
+{
+  vpUniRand rng(2);
+  vpImage<unsigned char> I;
+  randomBlobs(I, 120, 160, rng);
+
+  vp::vpFlatContours contours, polygons, hulls;
+  vp::findContours(I, contours, vp::CONTOUR_RETR_LIST);
+  const double epsilon = 1.5;
+  vp::findContours(I, polygons, vp::CONTOUR_RETR_LIST, vp::CONTOUR_APPROX_POLYGON, epsilon);
+  vp::findContours(I, hulls, vp::CONTOUR_RETR_LIST, vp::CONTOUR_APPROX_CONVEX_HULL);
+  REQUIRE(polygons.size() == contours.size());
+  REQUIRE(hulls.size() == contours.size());
+  CHECK(polygons.m_points.size() < contours.m_points.size());
+  CHECK(hulls.m_points.size() < contours.m_points.size());
+
+  std::vector<vpImagePoint> points, polygon, hull;
+  for (unsigned int k = 0; k < contours.size(); k++) {
+    contours.getContour(k, points);
+    polygons.getContour(k, polygon);
+    hulls.getContour(k, hull);
+    CHECK(polygons.m_areas[k] == contours.m_areas[k]);
+    REQUIRE(polygon.size() <= points.size());
+    REQUIRE(hull.size() <= points.size());
+
+    for (size_t n = 0; n < points.size(); n++) {
+      // All the points are close to the polygon
+      CHECK(distanceToPolygon(points[n], polygon) <= epsilon);
+
+      // All the points are inside the hull, which is clockwise in the image
+      for (size_t h = 0; hull.size() > 2 && h < hull.size(); h++) {
+        const vpImagePoint &a = hull[h], &b = hull[(h + 1) % hull.size()];
+        const double cross = (b.get_j() - a.get_j()) * (points[n].get_i() - a.get_i()) -
+                             (b.get_i() - a.get_i()) * (points[n].get_j() - a.get_j());
+        CHECK(cross >= 0);
+      }
+    }
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,319 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the distance transform and the skeletonization.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testDistanceTransform.cpp
+
+  \brief Compare the distance transforms with a brute force computation, and
+  check the topology and the position of the skeletons.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <limits>
+
+#include <visp3/core/vpImageTools.h>
+#include <visp3/core/vpImageView.h>
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+// Sparse background pixels
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = rng.uniform(0, 40) == 0 ? 0 : 255;
+  }
+}
+
+double distanceRef(const vpImage<unsigned char> &I, int i, int j)
+{
+  double min_dist = std::numeric_limits<double>::max();
+  for (int ii = 0; ii < static_cast<int>(I.getHeight()); ii++) {
+    for (int jj = 0; jj < static_cast<int>(I.getWidth()); jj++) {
+      if (I[ii][jj] == 0) {
+        min_dist = std::min(min_dist, std::sqrt(static_cast<double>((ii - i) * (ii - i) + (jj - j) * (jj - j))));
+      }
+    }
+  }
+  return min_dist;
+}
+
+void drawRectangle(vpImage<unsigned char> &I, unsigned int top, unsigned int left, unsigned int h, unsigned int w,
+                   unsigned char value)
+{
+  for (unsigned int i = top; i < top + h; i++) {
+    for (unsigned int j = left; j < left + w; j++) {
+      I[i][j] = value;
+    }
+  }
+}
+
+int countComponents(const vpImage<unsigned char> &I, const vpImageMorphology::vpConnexityType &connexity)
+{
+  vpImage<int> labels;
+  int nbComponents = 0;
+  vp::connectedComponents(I, labels, nbComponents, connexity);
+  return nbComponents;
+}
+
+void complement(const vpImage<unsigned char> &I, vpImage<unsigned char> &Ic)
+{
+  Ic.resize(I.getHeight(), I.getWidth());
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    Ic.bitmap[i] = I.bitmap[i] ? 0 : 255;
+  }
+}
+} // namespace
+
+TEST_CASE("Euclidean distance transform", "[distanceTransform]")
+{
+  vpUniRand rng(1);
+  const unsigned int sizes[][2] = {{1, 1}, {1, 9}, {9, 1}, {31, 47}, {64, 20}};
+  for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+    vpImage<unsigned char> I;
+    randomImage(I, sizes[s][0], sizes[s][1], rng);
+    I[sizes[s][0] / 2][0] = 0;
+
+    vpImage<float> dist;
+    vp::distanceTransform(I, dist);
+    REQUIRE(dist.getHeight() == I.getHeight());
+    REQUIRE(dist.getWidth() == I.getWidth());
+
+    double max_error = 0;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        max_error = std::max(max_error, std::fabs(dist[i][j] - distanceRef(I, i, j)));
+      }
+    }
+    CHECK(max_error < 1e-4);
+  }
+
+  // A single background pixel in a corner
+  vpImage<unsigned char> I(50, 70, 255);
+  I[49][0] = 0;
+  vpImage<float> dist;
+  vp::distanceTransform(I, dist);
+  CHECK(dist[0][69] == Approx(std::sqrt(49.0 * 49.0 + 69.0 * 69.0)));
+
+  // No background
+  I = 255;
+  vp::distanceTransform(I, dist);
+  CHECK(dist[10][10] == std::numeric_limits<float>::max());
+}
+
+TEST_CASE("Chamfer distance transforms", "[distanceTransform]")
+{
+  vpUniRand rng(2);
+  vpImage<unsigned char> I;
+  randomImage(I, 45, 61, rng);
+
+  const vp::vpDistanceTransformType types[] = {vp::DISTANCE_CHAMFER_3_4, vp::DISTANCE_CHAMFER_5_7_11};
+  // Maximal relative errors of the chamfer distances (Borgefors, 1986)
+  const double max_relative_errors[] = {0.09, 0.03};
+  for (int t = 0; t < 2; t++) {
+    vpImage<float> dist;
+    vp::distanceTransform(I, dist, types[t]);
+
+    double max_relative_error = 0;
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        const double d = distanceRef(I, i, j);
+        if (d > 0) {
+          max_relative_error = std::max(max_relative_error, std::fabs(dist[i][j] - d) / d);
+        } else {
+          CHECK(dist[i][j] == 0);
+        }
+      }
+    }
+    CHECK(max_relative_error < max_relative_errors[t]);
+  }
+
+  // Exact along the rows and the columns
+  vpImage<unsigned char> I_line(20, 30, 255);
+  I_line[0][0] = 0;
+  for (int t = 0; t < 2; t++) {
+    vpImage<float> dist;
+    vp::distanceTransform(I_line, dist, types[t]);
+    CHECK(dist[0][29] == Approx(29));
+    CHECK(dist[19][0] == Approx(19));
+  }
+}
+
+TEST_CASE("Distance transform and skeleton of views", "[distanceTransform]")
+{
+  vpUniRand rng(3);
+  vpImage<unsigned char> I;
+  randomImage(I, 60, 80, rng);
+  const vpRect rect(11, 7, 50, 40);
+  vpImageView<unsigned char> roi(I, rect);
+  vpImage<unsigned char> I_crop;
+  vpImageTools::crop(I, rect, I_crop);
+
+  const vp::vpDistanceTransformType types[] = {vp::DISTANCE_EUCLIDEAN, vp::DISTANCE_CHAMFER_3_4};
+  for (int t = 0; t < 2; t++) {
+    vpImage<float> dist_parent(I.getHeight(), I.getWidth(), -1.0f), dist_crop;
+    vpImageView<float> dist_view(dist_parent, rect);
+    vp::distanceTransform(roi, dist_view, types[t]);
+    vp::distanceTransform(I_crop, dist_crop, types[t]);
+    bool same = true;
+    for (unsigned int i = 0; i < I_crop.getHeight(); i++) {
+      for (unsigned int j = 0; j < I_crop.getWidth(); j++) {
+        same = same && dist_view[i][j] == dist_crop[i][j];
+      }
+    }
+    CHECK(same);
+    CHECK(dist_parent[6][10] == -1.0f);
+  }
+
+  // The background pixels around the view are not seen
+  vpImage<unsigned char> I_fg(30, 30, 0);
+  vpImageView<unsigned char> fg(I_fg, 5, 5, 20, 20);
+  fg = 255;
+  vpImage<float> dist;
+  vp::distanceTransform(fg, dist);
+  CHECK(dist[10][10] == std::numeric_limits<float>::max());
+
+  // Skeleton written in a view
+  vpImage<unsigned char> I_bar(31, 80, 0), I_skel;
+  drawRectangle(I_bar, 8, 10, 15, 60, 255);
+  vp::skeleton(I_bar, I_skel);
+  vpImage<unsigned char> I_parent(40, 100, 7);
+  vpImageView<unsigned char> skel_view(I_parent, 3, 9, 31, 80);
+  vp::skeleton(I_bar, skel_view);
+  bool same = true;
+  for (unsigned int i = 0; i < I_skel.getHeight(); i++) {
+    for (unsigned int j = 0; j < I_skel.getWidth(); j++) {
+      same = same && skel_view[i][j] == I_skel[i][j];
+    }
+  }
+  CHECK(same);
+  CHECK(I_parent[2][9] == 7);
+}
+
+TEST_CASE("Skeleton", "[skeleton]")
+{
+  SECTION("Bar")
+  {
+    // The skeleton of a bar of odd height is its middle row, away from the
+    // ends
+    vpImage<unsigned char> I(31, 80, 0), I_skel;
+    drawRectangle(I, 8, 10, 15, 60, 255);
+    vp::skeleton(I, I_skel);
+
+    for (unsigned int j = 20; j < 60; j++) {
+      unsigned int nb_pixels = 0;
+      for (unsigned int i = 0; i < I.getHeight(); i++) {
+        if (I_skel[i][j]) {
+          nb_pixels++;
+          CHECK(i == 15);
+        }
+      }
+      CHECK(nb_pixels == 1);
+    }
+    CHECK(countComponents(I_skel, vpImageMorphology::CONNEXITY_8) == 1);
+  }
+
+  SECTION("Topology")
+  {
+    // A frame with a hole, a thick line and a disk
+    vpImage<unsigned char> I(120, 160, 0), I_skel;
+    drawRectangle(I, 10, 10, 50, 60, 255);
+    drawRectangle(I, 22, 25, 20, 25, 0);
+    drawRectangle(I, 80, 15, 9, 130, 255);
+    for (unsigned int i = 0; i < I.getHeight(); i++) {
+      for (unsigned int j = 0; j < I.getWidth(); j++) {
+        if ((i - 35.0) * (i - 35.0) + (j - 120.0) * (j - 120.0) < 20.0 * 20.0) {
+          I[i][j] = 255;
+        }
+      }
+    }
+    vp::skeleton(I, I_skel);
+
+    // The skeleton is inside the objects, with the same objects and holes
+    bool inside = true;
+    unsigned int nb_pixels = 0;
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      inside = inside && (I_skel.bitmap[i] == 0 || I.bitmap[i] != 0);
+      nb_pixels += I_skel.bitmap[i] ? 1 : 0;
+    }
+    CHECK(inside);
+    CHECK(nb_pixels < I.getSize() / 20);
+    CHECK(countComponents(I_skel, vpImageMorphology::CONNEXITY_8) == 3);
+
+    vpImage<unsigned char> I_c, I_skel_c;
+    complement(I, I_c);
+    complement(I_skel, I_skel_c);
+    CHECK(countComponents(I_skel_c, vpImageMorphology::CONNEXITY_4) ==
+          countComponents(I_c, vpImageMorphology::CONNEXITY_4));
+
+    // The skeleton of the disk is close to its center
+    unsigned int nb_disk_pixels = 0;
+    for (unsigned int i = 10; i < 60; i++) {
+      for (unsigned int j = 95; j < 145; j++) {
+        if (I_skel[i][j]) {
+          nb_disk_pixels++;
+          CHECK(std::fabs(i - 35.0) <= 3);
+          CHECK(std::fabs(j - 120.0) <= 3);
+        }
+      }
+    }
+    CHECK(nb_disk_pixels >= 1);
+  }
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -0,0 +1,217 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the morphological reconstruction and the operators built on it.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMorphologicalReconstruction.cpp
+
+  \brief Check the queue-based morphological reconstruction against iterated
+  geodesic dilations, and the hole filling, border clearing, h-extrema and
+  regional extrema operators.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2)
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+
+#include <visp3/core/vpUniRand.h>
+#include <visp3/imgproc/vpImgproc.h>
+
+namespace
+{
+// Iterated geodesic dilations until stability
+void naiveReconstruct(const vpImage<unsigned char> &marker, const vpImage<unsigned char> &mask,
+                      vpImage<unsigned char> &I, const vpImageMorphology::vpConnexityType &connexity)
+{
+  I = marker;
+  vpImage<unsigned char> I_prev;
+  do {
+    I_prev = I;
+    vpImageMorphology::dilatation(I, connexity);
+    for (unsigned int i = 0; i < I.getSize(); i++) {
+      I.bitmap[i] = std::min(I.bitmap[i], mask.bitmap[i]);
+    }
+  } while (I != I_prev);
+}
+
+bool sameImages(const vpImage<unsigned char> &I1, const vpImage<unsigned char> &I2)
+{
+  return I1.getHeight() == I2.getHeight() && I1.getWidth() == I2.getWidth() &&
+         std::equal(I1.bitmap, I1.bitmap + I1.getSize(), I2.bitmap);
+}
+
+void randomImage(vpImage<unsigned char> &I, unsigned int h, unsigned int w, vpUniRand &rng)
+{
+  I.resize(h, w);
+  for (unsigned int i = 0; i < I.getSize(); i++) {
+    I.bitmap[i] = static_cast<unsigned char>(rng.uniform(0, 256));
+  }
+}
+
+void drawRectangle(vpImage<unsigned char> &I, unsigned int top, unsigned int left, unsigned int h, unsigned int w,
+                   unsigned char value)
+{
+  for (unsigned int i = top; i < top + h; i++) {
+    for (unsigned int j = left; j < left + w; j++) {
+      I[i][j] = value;
+    }
+  }
+}
+} // namespace
+
+TEST_CASE("Reconstruction by dilation", "[morphology]")
+{
+  vpUniRand rng(1234);
+  const vpImageMorphology::vpConnexityType connexities[2] = {vpImageMorphology::CONNEXITY_4,
+                                                              vpImageMorphology::CONNEXITY_8};
+  for (int c = 0; c < 2; c++) {
+    for (int n = 0; n < 5; n++) {
+      vpImage<unsigned char> mask, marker;
+      randomImage(mask, 37 + n, 53 - n, rng);
+      marker = mask;
+      // Sparse marker below the mask
+      for (unsigned int i = 0; i < marker.getSize(); i++) {
+        marker.bitmap[i] = rng.uniform(0, 10) == 0 ? static_cast<unsigned char>(marker.bitmap[i] / 2) : 0;
+      }
+
+      vpImage<unsigned char> I, I_ref;
+      vp::reconstruct(marker, mask, I, connexities[c]);
+      naiveReconstruct(marker, mask, I_ref, connexities[c]);
+      CHECK(sameImages(I, I_ref));
+    }
+  }
+}
+
+TEST_CASE("Fill holes", "[morphology]")
+{
+  vpImage<unsigned char> I(40, 50, 0);
+  // Ring with a hole
+  drawRectangle(I, 5, 5, 12, 12, 255);
+  drawRectangle(I, 8, 8, 6, 6, 0);
+  // Open ring: the background inside is connected to the border
+  drawRectangle(I, 20, 20, 12, 12, 255);
+  drawRectangle(I, 23, 23, 6, 12, 0);
+  // Hole only connected diagonally to the background, that is a hole in 4-connexity
+  drawRectangle(I, 5, 30, 5, 5, 255);
+  I[7][32] = 0;
+  I[6][33] = 0;
+  I[5][34] = 0;
+
+  vpImage<unsigned char> I_ref = I;
+  drawRectangle(I_ref, 8, 8, 6, 6, 255);
+  I_ref[7][32] = 255;
+  I_ref[6][33] = 255;
+
+  vp::fillHoles(I);
+  CHECK(sameImages(I, I_ref));
+}
+
+TEST_CASE("Clear border", "[morphology]")
+{
+  vpImage<unsigned char> I(30, 30, 0);
+  drawRectangle(I, 0, 3, 5, 5, 255);
+  drawRectangle(I, 10, 10, 5, 5, 200);
+  drawRectangle(I, 20, 20, 5, 5, 100);
+  // Connected to the border only in 8-connexity
+  drawRectangle(I, 25, 25, 4, 4, 100);
+  I[29][29] = 50;
+
+  vpImage<unsigned char> I_clear;
+  vp::clearBorder(I, I_clear);
+  vpImage<unsigned char> I_ref(30, 30, 0);
+  drawRectangle(I_ref, 10, 10, 5, 5, 200);
+  drawRectangle(I_ref, 20, 20, 5, 5, 100);
+  drawRectangle(I_ref, 25, 25, 4, 4, 100);
+  CHECK(sameImages(I_clear, I_ref));
+
+  vp::clearBorder(I, I_clear, vpImageMorphology::CONNEXITY_8);
+  drawRectangle(I_ref, 20, 20, 5, 5, 50);
+  drawRectangle(I_ref, 25, 25, 4, 4, 50);
+  CHECK(sameImages(I_clear, I_ref));
+}
+
+TEST_CASE("H-extrema and regional extrema", "[morphology]")
+{
+  vpImage<unsigned char> I(30, 40, 100);
+  drawRectangle(I, 5, 5, 4, 4, 110);   // low peak
+  drawRectangle(I, 15, 20, 5, 5, 150); // high peak
+  drawRectangle(I, 20, 5, 3, 3, 60);   // deep basin
+  drawRectangle(I, 5, 30, 2, 2, 95);   // shallow basin
+
+  vpImage<unsigned char> I_h;
+  vp::hMaxima(I, I_h, 20);
+  vpImage<unsigned char> I_ref = I;
+  drawRectangle(I_ref, 5, 5, 4, 4, 100);
+  drawRectangle(I_ref, 15, 20, 5, 5, 130);
+  CHECK(sameImages(I_h, I_ref));
+
+  vp::hMinima(I, I_h, 20);
+  I_ref = I;
+  drawRectangle(I_ref, 20, 5, 3, 3, 80);
+  drawRectangle(I_ref, 5, 30, 2, 2, 100);
+  CHECK(sameImages(I_h, I_ref));
+
+  vpImage<unsigned char> I_max, I_min;
+  vp::regionalMaxima(I, I_max);
+  vp::regionalMinima(I, I_min);
+  vpImage<unsigned char> I_max_ref(30, 40, 0), I_min_ref(30, 40, 0);
+  drawRectangle(I_max_ref, 5, 5, 4, 4, 255);
+  drawRectangle(I_max_ref, 15, 20, 5, 5, 255);
+  drawRectangle(I_min_ref, 20, 5, 3, 3, 255);
+  drawRectangle(I_min_ref, 5, 30, 2, 2, 255);
+  CHECK(sameImages(I_max, I_max_ref));
+  CHECK(sameImages(I_min, I_min_ref));
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
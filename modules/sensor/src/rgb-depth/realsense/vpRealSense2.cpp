@@ -217,6 +217,73 @@ void vpRealSense2::acquire(unsigned char *const data_image, unsigned char *const
   }
 }
 
+/*!
+  Acquire the color image and the point cloud computed by librealsense from
+  the depth frame.
+
+  The point cloud wraps the vertices computed by librealsense without any
+  copy, which avoids the conversion into a vector of column vectors. It is
+  valid until the next acquisition. Pixels without depth have a null \e Z
+  coordinate; unlike acquire() with a std::vector<vpColVector>, the points
+  farther than getMaxZ() are not discarded.
+
+  \param data_image : Color image buffer or NULL if not wanted.
+  \param pointcloud : Point cloud that wraps the vertices computed by librealsense.
+  \param align_to : Align to a reference stream or NULL if not wanted.
+  Only depth and color streams can be aligned.
+
+  \code
+#include <visp3/mbt/vpMbGenericTracker.h>
+#include <visp3/sensor/vpRealSense2.h>
+
+int main()
+{
+  vpRealSense2 rs;
+  rs2::config config;
+  config.enable_stream(RS2_STREAM_COLOR, 640, 480, RS2_FORMAT_RGBA8, 30);
+  config.enable_stream(RS2_STREAM_DEPTH, 640, 480, RS2_FORMAT_Z16, 30);
+  rs.open(config);
+  rs2::align align_to(RS2_STREAM_COLOR);
+
+  vpImage<vpRGBa> I_color(480, 640);
+  vpPointCloud pointcloud;
+  vpMbGenericTracker tracker(2, vpMbGenericTracker::EDGE_TRACKER | vpMbGenericTracker::DEPTH_DENSE_TRACKER);
+  // ... initialize the tracker
+
+  while (true) {
+    rs.acquire(reinterpret_cast<unsigned char *>(I_color.bitmap), pointcloud, &align_to);
+    std::map<std::string, const vpImage<vpRGBa> *> mapOfImages;
+    std::map<std::string, const vpPointCloud *> mapOfPointClouds;
+    mapOfImages["Camera1"] = &I_color;
+    mapOfPointClouds["Camera2"] = &pointcloud;
+    tracker.track(mapOfImages, mapOfPointClouds);
+  }
+}
+  \endcode
+ */
+void vpRealSense2::acquire(unsigned char *const data_image, vpPointCloud &pointcloud, rs2::align *const align_to)
+{
+  auto data = m_pipe.wait_for_frames();
+  if (align_to != NULL) {
+#if (RS2_API_VERSION > ((2 * 10000) + (9 * 100) + 0))
+    data = align_to->process(data);
+#else
+    data = align_to->proccess(data);
+#endif
+  }
+
+  if (data_image != NULL) {
+    auto color_frame = data.get_color_frame();
+    getNativeFrameData(color_frame, data_image);
+  }
+
+  auto depth_frame = data.get_depth_frame();
+  auto vf = depth_frame.as<rs2::video_frame>();
+  m_points = m_pointcloud.calculate(depth_frame);
+  pointcloud.init(reinterpret_cast<const float *>(m_points.get_vertices()), static_cast<unsigned int>(vf.get_height()),
+                  static_cast<unsigned int>(vf.get_width()));
+}
+
 #ifdef VISP_HAVE_PCL
 /*!
   Acquire data from RealSense device.
@@ -66,6 +66,14 @@ public:
 
   virtual inline vpColVector getRobustWeights() const { return m_w_depthDense; }
 
+  /*!
+    Return true if the pose is estimated from the normal equations accumulated
+    face by face.
+
+    \sa setUseDepthDenseNormalEquations()
+  */
+  inline bool getUseDepthDenseNormalEquations() const { return m_depthDenseUseNormalEquations; }
+
   virtual void init(const vpImage<unsigned char> &I);
 
   virtual void loadConfigFile(const std::string &configFile);
@@ -107,6 +115,22 @@ public:
 
   virtual void setScanLineVisibilityTest(const bool &v);
 
+  /*!
+    Estimate the pose from the normal equations \f$ {\bf L}^T {\bf W}^2 {\bf
+    L} \f$ and \f$ {\bf L}^T {\bf W}^2 {\bf e} \f$ accumulated face by face
+    from the moments of the points of each face, in parallel over the faces,
+    instead of stacking the interaction matrix of all the points. The memory
+    used by the virtual visual servoing no longer grows with six doubles per
+    point. Disabled by default. The covariance matrix, see
+    setCovarianceComputation(), still requires the stacked interaction matrix.
+
+    \param useNormalEquations : If true, use the normal equations.
+  */
+  inline void setUseDepthDenseNormalEquations(bool useNormalEquations)
+  {
+    m_depthDenseUseNormalEquations = useNormalEquations;
+  }
+
   void setUseDepthDenseTracking(const std::string &name, const bool &useDepthDenseTracking);
 
   virtual void testTracking();
@@ -117,6 +141,7 @@ public:
   virtual void track(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud);
 #endif
   virtual void track(const std::vector<vpColVector> &point_cloud, unsigned int width, unsigned int height);
+  virtual void track(const vpPointCloud &point_cloud);
 
 protected:
   //! Set of faces describing the object used only for display with scan line.
@@ -141,6 +166,14 @@ protected:
   vpColVector m_w_depthDense;
   //! Weighted error
   vpColVector m_weightedError_depthDense;
+  //! If true, the pose is estimated from the normal equations of the faces
+  bool m_depthDenseUseNormalEquations;
+  //! Index of the first point of each active face in the error vector
+  std::vector<unsigned int> m_depthDenseFacesStartIndex;
+  //! \f$ {\bf L}^T {\bf W}^2 {\bf L} \f$ of each active face
+  std::vector<vpMatrix> m_depthDenseFacesLTL;
+  //! \f$ {\bf L}^T {\bf W}^2 {\bf e} \f$ of each active face
+  std::vector<vpColVector> m_depthDenseFacesLTR;
 #if DEBUG_DISPLAY_DEPTH_DENSE
   vpDisplay *m_debugDisp_depthDense;
   vpImage<unsigned char> m_debugImage_depthDense;
@@ -151,6 +184,7 @@ protected:
   void computeVisibility(unsigned int width, unsigned int height);
 
   void computeVVS();
+  void computeVVSNormalEquations();
   virtual void computeVVSInit();
   virtual void computeVVSInteractionMatrixAndResidu();
   virtual void computeVVSWeights();
@@ -171,5 +205,6 @@ protected:
 #endif
   void segmentPointCloud(const std::vector<vpColVector> &point_cloud, unsigned int width,
                          unsigned int height);
+  void segmentPointCloud(const vpPointCloud &point_cloud);
 };
 #endif
@@ -328,6 +328,14 @@ protected:
   vpRobust m_robust_edge;
   //! Display features
   std::vector<std::vector<double> > m_featuresToBeDisplayedEdge;
+  //! Normal matrix of the first phase of the minimization
+  vpMatrix m_LTL_edge;
+  //! Gradient of the first phase of the minimization
+  vpColVector m_LTR_edge;
+  //! Velocity of the first phase of the minimization
+  vpColVector m_v_edge;
+  //! Maximum number of threads used to track the moving edges
+  unsigned int m_nbMovingEdgeThreads;
 
 public:
   vpMbEdgeTracker();
@@ -364,6 +372,13 @@ public:
   */
   virtual inline vpMe getMovingEdge() const { return this->me; }
 
+  /*!
+    Return the maximum number of threads used to track the moving edges.
+
+    \sa setNbMovingEdgeThreads()
+  */
+  inline unsigned int getNbMovingEdgeThreads() const { return m_nbMovingEdgeThreads; }
+
   virtual unsigned int getNbPoints(unsigned int level = 0) const;
 
   /*!
@@ -478,6 +493,8 @@ public:
 
   void setMovingEdge(const vpMe &me);
 
+  void setNbMovingEdgeThreads(unsigned int nbThreads);
+
   virtual void setPose(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cdMo);
   virtual void setPose(const vpImage<vpRGBa> &I_color, const vpHomogeneousMatrix &cdMo);
 
@@ -198,6 +198,14 @@ public:
   virtual unsigned int getNbPoints(unsigned int level = 0) const;
   virtual void getNbPoints(std::map<std::string, unsigned int> &mapOfNbPoints, unsigned int level = 0) const;
 
+  /*!
+    Return the maximum number of threads used to process the cameras
+    concurrently.
+
+    \sa setNbCameraThreads()
+  */
+  virtual inline unsigned int getNbCameraThreads() const { return m_nbCameraThreads; }
+
   virtual unsigned int getNbPolygon() const;
   virtual void getNbPolygon(std::map<std::string, unsigned int> &mapOfNbPolygons) const;
 
@@ -222,6 +230,10 @@ public:
 
   virtual int getTrackerType() const;
 
+  virtual void getTrackingTimes(std::map<std::string, double> &mapOfPreTrackingTimes,
+                                std::map<std::string, double> &mapOfVVSTimes,
+                                std::map<std::string, double> &mapOfPostTrackingTimes) const;
+
   virtual void init(const vpImage<unsigned char> &I);
 
 #ifdef VISP_HAVE_MODULE_GUI
@@ -386,6 +398,9 @@ public:
   virtual void setMovingEdge(const vpMe &me1, const vpMe &me2);
   virtual void setMovingEdge(const std::map<std::string, vpMe> &mapOfMe);
 
+  virtual void setNbCameraThreads(unsigned int nbThreads);
+  virtual void setNbMovingEdgeThreads(unsigned int nbThreads);
+
   virtual void setNearClippingDistance(const double &dist);
   virtual void setNearClippingDistance(const double &dist1, const double &dist2);
   virtual void setNearClippingDistance(const std::map<std::string, double> &mapOfDists);
@@ -455,6 +470,11 @@ public:
                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                      std::map<std::string, unsigned int> &mapOfPointCloudHeights);
 
+  virtual void track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+  virtual void track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
+
 protected:
   virtual void computeProjectionError();
 
@@ -478,6 +498,14 @@ protected:
 
   virtual void initFaceFromLines(vpMbtPolygon &polygon);
 
+#ifdef VISP_HAVE_PCL
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                            std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
+#endif
+  virtual void postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+
 #ifdef VISP_HAVE_PCL
   virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                            std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds);
@@ -486,8 +514,12 @@ protected:
                            std::map<std::string, const std::vector<vpColVector> *> &mapOfPointClouds,
                            std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                            std::map<std::string, unsigned int> &mapOfPointCloudHeights);
+  virtual void preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                           std::map<std::string, const vpPointCloud *> &mapOfPointClouds);
 
 private:
+  class TrackingBody;
+
   class TrackerWrapper : public vpMbEdgeTracker,
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
                          public vpMbKltTracker,
@@ -496,6 +528,7 @@ private:
                          public vpMbDepthDenseTracker
   {
     friend class vpMbGenericTracker;
+    friend class vpMbGenericTracker::TrackingBody;
 
   public:
     //! (s - s*)
@@ -508,6 +541,13 @@ private:
     vpColVector m_w;
     //! Weighted error
     vpColVector m_weightedError;
+    //! Time in ms spent in the pre-tracking during the last tracking
+    double m_preTrackingTime;
+    //! Time in ms spent in the features and weights of the VVS during the
+    //! last tracking
+    double m_vvsTime;
+    //! Time in ms spent in the post-tracking during the last tracking
+    double m_postTrackingTime;
 
     TrackerWrapper();
     explicit TrackerWrapper(int trackerType);
@@ -612,6 +652,7 @@ private:
     virtual void preTracking(const vpImage<unsigned char> *const ptr_I = NULL,
                              const std::vector<vpColVector> *const point_cloud = NULL,
                              const unsigned int pointcloud_width = 0, const unsigned int pointcloud_height = 0);
+    virtual void preTracking(const vpImage<unsigned char> *const ptr_I, const vpPointCloud *const point_cloud);
 
     virtual void reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                              const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose = false,
@@ -654,5 +695,7 @@ protected:
   vpColVector m_w;
   //! Weighted error
   vpColVector m_weightedError;
+  //! Maximum number of threads used to process the cameras concurrently
+  unsigned int m_nbCameraThreads;
 };
 #endif
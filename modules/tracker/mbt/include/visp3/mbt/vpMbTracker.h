@@ -55,6 +55,7 @@
 #include <visp3/core/vpImage.h>
 #include <visp3/core/vpImagePoint.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixWorkspace.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpPolygon.h>
 #include <visp3/core/vpRGBa.h>
@@ -221,6 +222,23 @@ protected:
   const vpImage<bool> *m_mask;
   //! Grayscale image buffer, used when passing color images
   vpImage<unsigned char> m_I;
+  //! Buffers of the pseudo inverse computed at each iteration of the virtual
+  //! visual servoing
+  vpMatrixWorkspace m_vvsWorkspace;
+  //! Damped normal matrix of the Levenberg-Marquardt iterations
+  vpMatrix m_vvsLTLmuI;
+  //! Pseudo inverse of the normal matrix
+  vpMatrix m_vvsLTLPinv;
+  //! Product of the velocity twist matrix cVo and oJo
+  vpMatrix m_vvsVJ;
+  //! Interaction matrix multiplied by cVo and oJo
+  vpMatrix m_vvsLVJ;
+  //! Normal matrix of m_vvsLVJ
+  vpMatrix m_vvsLVJTLVJ;
+  //! Transpose of m_vvsLVJ multiplied by the residual
+  vpColVector m_vvsLVJTR;
+  //! Pose displacement of the current iteration
+  vpHomogeneousMatrix m_vvsDeltaM;
 
 public:
   vpMbTracker();
@@ -805,7 +823,16 @@ protected:
                                         vpColVector &R, const vpColVector &error, vpColVector &error_prev,
                                         vpColVector &LTR, double &mu, vpColVector &v, const vpColVector *const w = NULL,
                                         vpColVector *const m_w_prev = NULL);
+  void computeVVSPoseEstimationFromNormalEquations(const bool isoJoIdentity_, unsigned int iter, const vpMatrix &LTL,
+                                                   const vpColVector &LTR, const vpColVector &error,
+                                                   vpColVector &error_prev, double &mu, vpColVector &v);
+  void computeVVSPoseUpdate(const vpColVector &v, vpHomogeneousMatrix &M);
+  void computeVVSVelocity(bool isoJoIdentity_, const vpMatrix &L, const vpColVector &R, double gain, double mu,
+                          vpMatrix &LTL, vpColVector &LTR, vpColVector &v);
+  void computeVVSVelocityFromNormalEquations(bool isoJoIdentity_, const vpMatrix &LTL, const vpColVector &LTR,
+                                             double gain, double mu, vpColVector &v);
   virtual void computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w);
+  void solveVVSVelocity(const vpMatrix &normal, const vpColVector &gradient, double gain, double mu, vpColVector &v);
 
 #ifdef VISP_HAVE_COIN3D
   virtual void extractGroup(SoVRMLGroup *sceneGraphVRML2, vpHomogeneousMatrix &transform, int &idFace);
@@ -45,6 +45,7 @@
 #endif
 
 #include <visp3/core/vpPlane.h>
+#include <visp3/core/vpPointCloud.h>
 #include <visp3/mbt/vpMbTracker.h>
 #include <visp3/mbt/vpMbtDistanceLine.h>
 
@@ -107,8 +108,19 @@ public:
 #endif
                               , const vpImage<bool> *mask = NULL
   );
+  bool computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpPointCloud &point_cloud, unsigned int stepX,
+                              unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                              ,
+                              vpImage<unsigned char> &debugImage, std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                              , const vpImage<bool> *mask = NULL
+  );
 
   void computeInteractionMatrixAndResidu(const vpHomogeneousMatrix &cMo, vpMatrix &L, vpColVector &error);
+  void computeNormalEquations(const vpColVector &error, const vpColVector &w, unsigned int start_index, vpMatrix &LTL,
+                              vpColVector &LTR) const;
+  void computeResidu(const vpHomogeneousMatrix &cMo, vpColVector &error, unsigned int start_index);
 
   void computeVisibility();
   void computeVisibilityDisplay();
@@ -226,6 +238,15 @@ protected:
   std::vector<PolygonLine> m_polygonLines;
 
 protected:
+  template <class PointCloud>
+  bool computeDesiredFeaturesOrganized(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
+                                       const PointCloud &point_cloud, unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                       ,
+                                       vpImage<unsigned char> &debugImage,
+                                       std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                       , const vpImage<bool> *mask);
   void computeROI(const vpHomogeneousMatrix &cMo, unsigned int width, unsigned int height,
                   std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
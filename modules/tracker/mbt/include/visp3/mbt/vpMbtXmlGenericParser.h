@@ -83,6 +83,7 @@ public:
   void getCameraParameters(vpCameraParameters &cam) const;
 
   void getEdgeMe(vpMe &ecm) const;
+  unsigned int getEdgeNbThreads() const;
 
   unsigned int getDepthDenseSamplingStepX() const;
   unsigned int getDepthDenseSamplingStepY() const;
@@ -137,6 +138,7 @@ public:
   void setDepthNormalSamplingStepY(unsigned int stepY);
 
   void setEdgeMe(const vpMe &ecm);
+  void setEdgeNbThreads(unsigned int nbThreads);
 
   void setFarClippingDistance(const double &fclip);
 
@@ -43,6 +43,7 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbDepthDenseTracker.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
@@ -52,10 +53,69 @@
 #include <visp3/gui/vpDisplayX.h>
 #endif
 
+namespace
+{
+// Residuals of the points of a range of faces, each face writing its own
+// segment of the error vector
+class vpFaceResiduBody : public vpParallelBody
+{
+public:
+  vpFaceResiduBody(const std::vector<vpMbtFaceDepthDense *> &faces, const std::vector<unsigned int> &startIndex,
+                   const vpHomogeneousMatrix &cMo, vpColVector &error)
+    : m_faces(faces), m_startIndex(startIndex), m_cMo(cMo), m_error(error)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      m_faces[i]->computeResidu(m_cMo, m_error, m_startIndex[i]);
+    }
+  }
+
+private:
+  const std::vector<vpMbtFaceDepthDense *> &m_faces;
+  const std::vector<unsigned int> &m_startIndex;
+  const vpHomogeneousMatrix &m_cMo;
+  vpColVector &m_error;
+};
+
+// Normal equations of a range of faces. They are summed afterwards in the
+// order of the faces, so that the result does not depend on the number of
+// threads.
+class vpFaceNormalEquationsBody : public vpParallelBody
+{
+public:
+  vpFaceNormalEquationsBody(const std::vector<vpMbtFaceDepthDense *> &faces,
+                            const std::vector<unsigned int> &startIndex, const vpColVector &error,
+                            const vpColVector &w, std::vector<vpMatrix> &LTL, std::vector<vpColVector> &LTR)
+    : m_faces(faces), m_startIndex(startIndex), m_error(error), m_w(w), m_LTL(LTL), m_LTR(LTR)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      m_faces[i]->computeNormalEquations(m_error, m_w, m_startIndex[i], m_LTL[i], m_LTR[i]);
+    }
+  }
+
+private:
+  const std::vector<vpMbtFaceDepthDense *> &m_faces;
+  const std::vector<unsigned int> &m_startIndex;
+  const vpColVector &m_error;
+  const vpColVector &m_w;
+  std::vector<vpMatrix> &m_LTL;
+  std::vector<vpColVector> &m_LTR;
+};
+} // namespace
+
 vpMbDepthDenseTracker::vpMbDepthDenseTracker()
   : m_depthDenseHiddenFacesDisplay(), m_depthDenseListOfActiveFaces(),
     m_denseDepthNbFeatures(0), m_depthDenseFaces(), m_depthDenseSamplingStepX(2), m_depthDenseSamplingStepY(2),
-    m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense()
+    m_error_depthDense(), m_L_depthDense(), m_robust_depthDense(), m_w_depthDense(), m_weightedError_depthDense(),
+    m_depthDenseUseNormalEquations(false), m_depthDenseFacesStartIndex(), m_depthDenseFacesLTL(),
+    m_depthDenseFacesLTR()
 #if DEBUG_DISPLAY_DEPTH_DENSE
     ,
     m_debugDisp_depthDense(NULL), m_debugImage_depthDense()
@@ -149,6 +209,11 @@ void vpMbDepthDenseTracker::computeVisibility(unsigned int width, unsigned int h
 
 void vpMbDepthDenseTracker::computeVVS()
 {
+  if (m_depthDenseUseNormalEquations && !computeCovariance) {
+    computeVVSNormalEquations();
+    return;
+  }
+
   double normRes = 0;
   double normRes_1 = -1;
   unsigned int iter = 0;
@@ -228,7 +293,7 @@ void vpMbDepthDenseTracker::computeVVS()
                                m_error_depthDense, error_prev, LTR, mu, v);
 
       cMo_prev = m_cMo;
-      m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
+      computeVVSPoseUpdate(v, m_cMo);
 
       normRes_1 = normRes;
       normRes = sqrt(num / den);
@@ -240,6 +305,121 @@ void vpMbDepthDenseTracker::computeVVS()
   computeCovarianceMatrixVVS(isoJoIdentity_, m_w_depthDense, cMo_prev, L_true, LVJ_true, m_error_depthDense);
 }
 
+/*!
+  Virtual visual servoing from the normal equations of the faces, see
+  setUseDepthDenseNormalEquations(). The iterations are the ones of the
+  stacked computation, but the \f$ N \times 6 \f$ interaction matrix is
+  replaced by the \f$ 6 \times 6 \f$ normal equations of each face, computed
+  in parallel.
+*/
+void vpMbDepthDenseTracker::computeVVSNormalEquations()
+{
+  const unsigned int nbFaces = static_cast<unsigned int>(m_depthDenseListOfActiveFaces.size());
+
+  m_denseDepthNbFeatures = 0;
+  m_depthDenseFacesStartIndex.resize(nbFaces);
+  for (unsigned int i = 0; i < nbFaces; i++) {
+    m_depthDenseFacesStartIndex[i] = m_denseDepthNbFeatures;
+    m_denseDepthNbFeatures += m_depthDenseListOfActiveFaces[i]->getNbFeatures();
+  }
+  m_depthDenseFacesLTL.resize(nbFaces);
+  m_depthDenseFacesLTR.resize(nbFaces);
+
+  m_error_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_w_depthDense.resize(m_denseDepthNbFeatures, false);
+  m_w_depthDense = 1;
+
+  double normRes = 0;
+  double normRes_1 = -1;
+  unsigned int iter = 0;
+
+  vpColVector error_prev(m_denseDepthNbFeatures);
+  vpMatrix LTL(6, 6);
+  vpColVector LTR(6), v;
+
+  double mu = m_initialMu;
+  vpHomogeneousMatrix cMo_prev;
+
+  bool isoJoIdentity_ = true;
+  vpVelocityTwistMatrix cVo;
+
+  while (std::fabs(normRes_1 - normRes) > m_stopCriteriaEpsilon && (iter < m_maxIter)) {
+    vpParallel::parallelFor(0, nbFaces, vpFaceResiduBody(m_depthDenseListOfActiveFaces, m_depthDenseFacesStartIndex,
+                                                         m_cMo, m_error_depthDense),
+                            0, 1);
+
+    bool reStartFromLastIncrement = false;
+    computeVVSCheckLevenbergMarquardt(iter, m_error_depthDense, error_prev, cMo_prev, mu, reStartFromLastIncrement);
+
+    if (!reStartFromLastIncrement) {
+      // Compute DoF only once, from the unweighted normal equations:
+      // (L V)^T (L V) has the same kernel as L V
+      if (iter == 0) {
+        isoJoIdentity_ = true;
+        oJo.eye();
+
+        vpParallel::parallelFor(0, nbFaces,
+                                vpFaceNormalEquationsBody(m_depthDenseListOfActiveFaces, m_depthDenseFacesStartIndex,
+                                                          m_error_depthDense, m_w_depthDense, m_depthDenseFacesLTL,
+                                                          m_depthDenseFacesLTR),
+                                0, 1);
+        LTL = 0;
+        for (unsigned int i = 0; i < nbFaces; i++) {
+          LTL += m_depthDenseFacesLTL[i];
+        }
+
+        cVo.buildFrom(m_cMo);
+
+        vpMatrix K; // kernel
+        // The singular values of L^T L are the squares of the ones of L
+        unsigned int rank = (vpMatrix(cVo).t() * LTL * cVo).kernel(K, 1e-12);
+        if (rank == 0) {
+          throw vpException(vpException::fatalError, "Rank=0, cannot estimate the pose !");
+        }
+
+        if (rank != 6) {
+          vpMatrix I; // Identity
+          I.eye(6);
+          oJo = I - K.AtA();
+
+          isoJoIdentity_ = false;
+        }
+      }
+
+      computeVVSWeights();
+
+      double num = 0.0, den = 0.0;
+      for (unsigned int i = 0; i < m_denseDepthNbFeatures; i++) {
+        num += m_w_depthDense[i] * vpMath::sqr(m_error_depthDense[i]);
+        den += m_w_depthDense[i];
+      }
+
+      vpParallel::parallelFor(0, nbFaces,
+                              vpFaceNormalEquationsBody(m_depthDenseListOfActiveFaces, m_depthDenseFacesStartIndex,
+                                                        m_error_depthDense, m_w_depthDense, m_depthDenseFacesLTL,
+                                                        m_depthDenseFacesLTR),
+                              0, 1);
+      LTL = 0;
+      LTR = 0;
+      for (unsigned int i = 0; i < nbFaces; i++) {
+        LTL += m_depthDenseFacesLTL[i];
+        LTR += m_depthDenseFacesLTR[i];
+      }
+
+      computeVVSPoseEstimationFromNormalEquations(isoJoIdentity_, iter, LTL, LTR, m_error_depthDense, error_prev,
+                                                  mu, v);
+
+      cMo_prev = m_cMo;
+      computeVVSPoseUpdate(v, m_cMo);
+
+      normRes_1 = normRes;
+      normRes = sqrt(num / den);
+    }
+
+    iter++;
+  }
+}
+
 void vpMbDepthDenseTracker::computeVVSInit()
 {
   m_denseDepthNbFeatures = 0;
@@ -656,6 +836,63 @@ void vpMbDepthDenseTracker::segmentPointCloud(const std::vector<vpColVector> &po
 #endif
 }
 
+void vpMbDepthDenseTracker::segmentPointCloud(const vpPointCloud &point_cloud)
+{
+  m_depthDenseListOfActiveFaces.clear();
+
+#if DEBUG_DISPLAY_DEPTH_DENSE
+  if (!m_debugDisp_depthDense->isInitialised()) {
+    m_debugImage_depthDense.resize(point_cloud.getHeight(), point_cloud.getWidth());
+    m_debugDisp_depthDense->init(m_debugImage_depthDense, 50, 0, "Debug display dense depth tracker");
+  }
+
+  m_debugImage_depthDense = 0;
+  std::vector<std::vector<vpImagePoint> > roiPts_vec;
+#endif
+
+  for (std::vector<vpMbtFaceDepthDense *>::iterator it = m_depthDenseFaces.begin();
+       it != m_depthDenseFaces.end(); ++it) {
+    vpMbtFaceDepthDense *face = *it;
+
+    if (face->isVisible() && face->isTracked()) {
+#if DEBUG_DISPLAY_DEPTH_DENSE
+      std::vector<std::vector<vpImagePoint> > roiPts_vec_;
+#endif
+      if (face->computeDesiredFeatures(m_cMo, point_cloud, m_depthDenseSamplingStepX,
+                                       m_depthDenseSamplingStepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                       ,
+                                       m_debugImage_depthDense, roiPts_vec_
+#endif
+                                       , m_mask
+                                       )) {
+        m_depthDenseListOfActiveFaces.push_back(*it);
+
+#if DEBUG_DISPLAY_DEPTH_DENSE
+        roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
+#endif
+      }
+    }
+  }
+
+#if DEBUG_DISPLAY_DEPTH_DENSE
+  vpDisplay::display(m_debugImage_depthDense);
+
+  for (size_t i = 0; i < roiPts_vec.size(); i++) {
+    if (roiPts_vec[i].empty())
+      continue;
+
+    for (size_t j = 0; j < roiPts_vec[i].size() - 1; j++) {
+      vpDisplay::displayLine(m_debugImage_depthDense, roiPts_vec[i][j], roiPts_vec[i][j + 1], vpColor::red, 2);
+    }
+    vpDisplay::displayLine(m_debugImage_depthDense, roiPts_vec[i][0], roiPts_vec[i][roiPts_vec[i].size() - 1],
+                           vpColor::red, 2);
+  }
+
+  vpDisplay::flush(m_debugImage_depthDense);
+#endif
+}
+
 void vpMbDepthDenseTracker::setOgreVisibilityTest(const bool &v)
 {
   vpMbTracker::setOgreVisibilityTest(v);
@@ -741,6 +978,15 @@ void vpMbDepthDenseTracker::track(const std::vector<vpColVector> &point_cloud, u
   computeVisibility(width, height);
 }
 
+void vpMbDepthDenseTracker::track(const vpPointCloud &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthDenseTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                        double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
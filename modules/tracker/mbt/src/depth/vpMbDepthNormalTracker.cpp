@@ -233,7 +233,7 @@ void vpMbDepthNormalTracker::computeVVS()
                                m_error_depthNormal, error_prev, LTR, mu, v);
 
       cMo_prev = m_cMo;
-      m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
+      computeVVSPoseUpdate(v, m_cMo);
 
       normRes_1 = normRes;
       normRes = sqrt(num / den);
@@ -710,6 +710,68 @@ void vpMbDepthNormalTracker::segmentPointCloud(const std::vector<vpColVector> &p
 #endif
 }
 
+void vpMbDepthNormalTracker::segmentPointCloud(const vpPointCloud &point_cloud)
+{
+  m_depthNormalListOfActiveFaces.clear();
+  m_depthNormalListOfDesiredFeatures.clear();
+
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+  if (!m_debugDisp_depthNormal->isInitialised()) {
+    m_debugImage_depthNormal.resize(point_cloud.getHeight(), point_cloud.getWidth());
+    m_debugDisp_depthNormal->init(m_debugImage_depthNormal, 50, 0, "Debug display normal depth tracker");
+  }
+
+  m_debugImage_depthNormal = 0;
+  std::vector<std::vector<vpImagePoint> > roiPts_vec;
+#endif
+
+  for (std::vector<vpMbtFaceDepthNormal *>::iterator it = m_depthNormalFaces.begin(); it != m_depthNormalFaces.end();
+       ++it) {
+    vpMbtFaceDepthNormal *face = *it;
+
+    if (face->isVisible() && face->isTracked()) {
+      vpColVector desired_features;
+
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+      std::vector<std::vector<vpImagePoint> > roiPts_vec_;
+#endif
+
+      if (face->computeDesiredFeatures(m_cMo, point_cloud, desired_features, m_depthNormalSamplingStepX,
+                                       m_depthNormalSamplingStepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                       ,
+                                       m_debugImage_depthNormal, roiPts_vec_
+#endif
+                                       , m_mask
+                                       )) {
+        m_depthNormalListOfDesiredFeatures.push_back(desired_features);
+        m_depthNormalListOfActiveFaces.push_back(face);
+
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+        roiPts_vec.insert(roiPts_vec.end(), roiPts_vec_.begin(), roiPts_vec_.end());
+#endif
+      }
+    }
+  }
+
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+  vpDisplay::display(m_debugImage_depthNormal);
+
+  for (size_t i = 0; i < roiPts_vec.size(); i++) {
+    if (roiPts_vec[i].empty())
+      continue;
+
+    for (size_t j = 0; j < roiPts_vec[i].size() - 1; j++) {
+      vpDisplay::displayLine(m_debugImage_depthNormal, roiPts_vec[i][j], roiPts_vec[i][j + 1], vpColor::red, 2);
+    }
+    vpDisplay::displayLine(m_debugImage_depthNormal, roiPts_vec[i][0], roiPts_vec[i][roiPts_vec[i].size() - 1],
+                           vpColor::red, 2);
+  }
+
+  vpDisplay::flush(m_debugImage_depthNormal);
+#endif
+}
+
 void vpMbDepthNormalTracker::setCameraParameters(const vpCameraParameters &cam)
 {
   m_cam = cam;
@@ -815,6 +877,15 @@ void vpMbDepthNormalTracker::track(const std::vector<vpColVector> &point_cloud,
   computeVisibility(width, height);
 }
 
+void vpMbDepthNormalTracker::track(const vpPointCloud &point_cloud)
+{
+  segmentPointCloud(point_cloud);
+
+  computeVVS();
+
+  computeVisibility(point_cloud.getWidth(), point_cloud.getHeight());
+}
+
 void vpMbDepthNormalTracker::initCircle(const vpPoint & /*p1*/, const vpPoint & /*p2*/, const vpPoint & /*p3*/,
                                         double /*radius*/, int /*idFace*/, const std::string & /*name*/)
 {
@@ -266,15 +266,21 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
 }
 #endif
 
-bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                 unsigned int height, const std::vector<vpColVector> &point_cloud,
-                                                 unsigned int stepX, unsigned int stepY
+/*!
+  Keep the points of an organized point cloud that lie inside the projected
+  face. \e PointCloud is either a std::vector<vpColVector> or a vpPointCloud,
+  the coordinates of the point \e n being read with <tt>point_cloud[n][k]</tt>.
+*/
+template <class PointCloud>
+bool vpMbtFaceDepthDense::computeDesiredFeaturesOrganized(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                          unsigned int height, const PointCloud &point_cloud,
+                                                          unsigned int stepX, unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_DENSE
-                                                 ,
-                                                 vpImage<unsigned char> &debugImage,
-                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                          ,
+                                                          vpImage<unsigned char> &debugImage,
+                                                          std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                 , const vpImage<bool> *mask
+                                                          , const vpImage<bool> *mask
 )
 {
   m_pointCloudFace.clear();
@@ -388,6 +394,44 @@ bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo,
   return true;
 }
 
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                 unsigned int height, const std::vector<vpColVector> &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, width, height, point_cloud, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
+bool vpMbtFaceDepthDense::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpPointCloud &point_cloud,
+                                                 unsigned int stepX, unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                                 ,
+                                                 vpImage<unsigned char> &debugImage,
+                                                 std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                 , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, point_cloud.getWidth(), point_cloud.getHeight(), point_cloud, stepX,
+                                         stepY
+#if DEBUG_DISPLAY_DEPTH_DENSE
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
 void vpMbtFaceDepthDense::computeVisibility() { m_isVisible = m_polygon->isVisible(); }
 
 void vpMbtFaceDepthDense::computeVisibilityDisplay()
@@ -575,6 +619,226 @@ void vpMbtFaceDepthDense::computeInteractionMatrixAndResidu(const vpHomogeneousM
   }
 }
 
+/*!
+  Compute the normal equations \f$ {\bf L}^T {\bf W}^2 {\bf L} \f$ and
+  \f$ {\bf L}^T {\bf W}^2 {\bf e} \f$ of the face, \f$ \bf W \f$ being
+  the diagonal matrix of the robust weights, without building the interaction
+  matrix. The row of the interaction matrix of a point \f$ {\bf p} \f$ is
+  \f$ ({\bf n}^T, ({\bf p} \times {\bf n})^T) \f$, thus the normal
+  equations only depend on the weighted moments of the points of the face:
+  \f$ \sum w^2 \f$, \f$ \sum w^2 {\bf p} \f$, \f$ \sum w^2 {\bf p}
+  {\bf p}^T \f$, \f$ \sum w^2 e \f$ and \f$ \sum w^2 e {\bf p} \f$,
+  accumulated in a single pass over the points.
+
+  computeResidu() must have been called with the current pose.
+
+  \param error : Residuals computed by computeResidu().
+  \param w : Robust weights.
+  \param start_index : Index of the first point of the face in \e error and
+  \e w.
+  \param LTL : 6x6 matrix \f$ {\bf L}^T {\bf W}^2 {\bf L} \f$.
+  \param LTR : 6-dim vector \f$ {\bf L}^T {\bf W}^2 {\bf e} \f$.
+*/
+void vpMbtFaceDepthDense::computeNormalEquations(const vpColVector &error, const vpColVector &w,
+                                                 unsigned int start_index, vpMatrix &LTL, vpColVector &LTR) const
+{
+  LTL.resize(6, 6, false, false);
+  LTR.resize(6, false);
+
+  // Weighted moments: sum w^2, sum w^2 p, sum w^2 p p^T, sum w^2 e, sum w^2 e p
+  double s0 = 0, sx = 0, sy = 0, sz = 0, sxx = 0, sxy = 0, sxz = 0, syy = 0, syz = 0, szz = 0;
+  double se = 0, sex = 0, sey = 0, sez = 0;
+
+  const double *ptr_point_cloud = m_pointCloudFace.empty() ? NULL : &m_pointCloudFace[0];
+  const double *ptr_error = error.data + start_index;
+  const double *ptr_w = w.data + start_index;
+  size_t cpt = 0;
+
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !USE_SSE
+  checkSSE2 = false;
+#endif
+
+  if (checkSSE2) {
+#if USE_SSE
+    // The points are stored by pairs: x0 x1 y0 y1 z0 z1
+    if (getNbFeatures() >= 2) {
+      __m128d vs0 = _mm_setzero_pd(), vsx = _mm_setzero_pd(), vsy = _mm_setzero_pd(), vsz = _mm_setzero_pd();
+      __m128d vsxx = _mm_setzero_pd(), vsxy = _mm_setzero_pd(), vsxz = _mm_setzero_pd();
+      __m128d vsyy = _mm_setzero_pd(), vsyz = _mm_setzero_pd(), vszz = _mm_setzero_pd();
+      __m128d vse = _mm_setzero_pd(), vsex = _mm_setzero_pd(), vsey = _mm_setzero_pd(), vsez = _mm_setzero_pd();
+
+      for (; cpt <= m_pointCloudFace.size() - 6; cpt += 6, ptr_point_cloud += 6, ptr_error += 2, ptr_w += 2) {
+        const __m128d vx = _mm_loadu_pd(ptr_point_cloud);
+        const __m128d vy = _mm_loadu_pd(ptr_point_cloud + 2);
+        const __m128d vz = _mm_loadu_pd(ptr_point_cloud + 4);
+        const __m128d vw = _mm_loadu_pd(ptr_w);
+        const __m128d vww = _mm_mul_pd(vw, vw);
+        const __m128d vwwe = _mm_mul_pd(vww, _mm_loadu_pd(ptr_error));
+
+        const __m128d vwwx = _mm_mul_pd(vww, vx);
+        const __m128d vwwy = _mm_mul_pd(vww, vy);
+        const __m128d vwwz = _mm_mul_pd(vww, vz);
+
+        vs0 = _mm_add_pd(vs0, vww);
+        vsx = _mm_add_pd(vsx, vwwx);
+        vsy = _mm_add_pd(vsy, vwwy);
+        vsz = _mm_add_pd(vsz, vwwz);
+        vsxx = _mm_add_pd(vsxx, _mm_mul_pd(vwwx, vx));
+        vsxy = _mm_add_pd(vsxy, _mm_mul_pd(vwwx, vy));
+        vsxz = _mm_add_pd(vsxz, _mm_mul_pd(vwwx, vz));
+        vsyy = _mm_add_pd(vsyy, _mm_mul_pd(vwwy, vy));
+        vsyz = _mm_add_pd(vsyz, _mm_mul_pd(vwwy, vz));
+        vszz = _mm_add_pd(vszz, _mm_mul_pd(vwwz, vz));
+        vse = _mm_add_pd(vse, vwwe);
+        vsex = _mm_add_pd(vsex, _mm_mul_pd(vwwe, vx));
+        vsey = _mm_add_pd(vsey, _mm_mul_pd(vwwe, vy));
+        vsez = _mm_add_pd(vsez, _mm_mul_pd(vwwe, vz));
+      }
+
+      double tmp[2];
+#define VISP_DEPTH_DENSE_HSUM(v, s)                                                                                   \
+  _mm_storeu_pd(tmp, v);                                                                                               \
+  s = tmp[0] + tmp[1];
+      VISP_DEPTH_DENSE_HSUM(vs0, s0)
+      VISP_DEPTH_DENSE_HSUM(vsx, sx)
+      VISP_DEPTH_DENSE_HSUM(vsy, sy)
+      VISP_DEPTH_DENSE_HSUM(vsz, sz)
+      VISP_DEPTH_DENSE_HSUM(vsxx, sxx)
+      VISP_DEPTH_DENSE_HSUM(vsxy, sxy)
+      VISP_DEPTH_DENSE_HSUM(vsxz, sxz)
+      VISP_DEPTH_DENSE_HSUM(vsyy, syy)
+      VISP_DEPTH_DENSE_HSUM(vsyz, syz)
+      VISP_DEPTH_DENSE_HSUM(vszz, szz)
+      VISP_DEPTH_DENSE_HSUM(vse, se)
+      VISP_DEPTH_DENSE_HSUM(vsex, sex)
+      VISP_DEPTH_DENSE_HSUM(vsey, sey)
+      VISP_DEPTH_DENSE_HSUM(vsez, sez)
+#undef VISP_DEPTH_DENSE_HSUM
+    }
+#endif
+  }
+
+  for (; cpt < m_pointCloudFace.size(); cpt += 3, ptr_point_cloud += 3, ptr_error++, ptr_w++) {
+    const double x = ptr_point_cloud[0], y = ptr_point_cloud[1], z = ptr_point_cloud[2];
+    const double ww = (*ptr_w) * (*ptr_w);
+    const double wwe = ww * (*ptr_error);
+
+    s0 += ww;
+    sx += ww * x;
+    sy += ww * y;
+    sz += ww * z;
+    sxx += ww * x * x;
+    sxy += ww * x * y;
+    sxz += ww * x * z;
+    syy += ww * y * y;
+    syz += ww * y * z;
+    szz += ww * z * z;
+    se += wwe;
+    sex += wwe * x;
+    sey += wwe * y;
+    sez += wwe * z;
+  }
+
+  const double n[3] = {m_planeCamera.getA(), m_planeCamera.getB(), m_planeCamera.getC()};
+
+  // sum w^2 n n^T
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      LTL[i][j] = s0 * n[i] * n[j];
+    }
+  }
+
+  // sum w^2 n (p x n)^T = n ((sum w^2 p) x n)^T
+  const double c[3] = {sy * n[2] - sz * n[1], sz * n[0] - sx * n[2], sx * n[1] - sy * n[0]};
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      LTL[i][j + 3] = LTL[j + 3][i] = n[i] * c[j];
+    }
+  }
+
+  // sum w^2 (p x n) (p x n)^T = [n]x (sum w^2 p p^T) [n]x^T
+  const double S[3][3] = {{sxx, sxy, sxz}, {sxy, syy, syz}, {sxz, syz, szz}};
+  const double N[3][3] = {{0, -n[2], n[1]}, {n[2], 0, -n[0]}, {-n[1], n[0], 0}};
+  double NS[3][3];
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      NS[i][j] = N[i][0] * S[0][j] + N[i][1] * S[1][j] + N[i][2] * S[2][j];
+    }
+  }
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      LTL[i + 3][j + 3] = NS[i][0] * N[j][0] + NS[i][1] * N[j][1] + NS[i][2] * N[j][2];
+    }
+  }
+
+  // sum w^2 e (n^T, (p x n)^T)^T
+  LTR[0] = se * n[0];
+  LTR[1] = se * n[1];
+  LTR[2] = se * n[2];
+  LTR[3] = sey * n[2] - sez * n[1];
+  LTR[4] = sez * n[0] - sex * n[2];
+  LTR[5] = sex * n[1] - sey * n[0];
+}
+
+/*!
+  Compute the residual of each point of the face, that is its signed distance
+  to the plane of the face at the pose \e cMo, without building the
+  interaction matrix.
+
+  \param cMo : Current pose.
+  \param error : Vector of residuals in which getNbFeatures() values are
+  written from \e start_index.
+  \param start_index : Index of the first point of the face in \e error.
+
+  \sa computeNormalEquations()
+*/
+void vpMbtFaceDepthDense::computeResidu(const vpHomogeneousMatrix &cMo, vpColVector &error, unsigned int start_index)
+{
+  // Transform the plane equation for the current pose
+  m_planeCamera = m_planeObject;
+  m_planeCamera.changeFrame(cMo);
+
+  const double nx = m_planeCamera.getA();
+  const double ny = m_planeCamera.getB();
+  const double nz = m_planeCamera.getC();
+  const double D = m_planeCamera.getD();
+
+  const double *ptr_point_cloud = m_pointCloudFace.empty() ? NULL : &m_pointCloudFace[0];
+  double *ptr_error = error.data + start_index;
+  size_t cpt = 0;
+
+  bool checkSSE2 = vpCPUFeatures::checkSSE2();
+#if !USE_SSE
+  checkSSE2 = false;
+#endif
+
+  if (checkSSE2) {
+#if USE_SSE
+    if (getNbFeatures() >= 2) {
+      const __m128d vnx = _mm_set1_pd(nx);
+      const __m128d vny = _mm_set1_pd(ny);
+      const __m128d vnz = _mm_set1_pd(nz);
+      const __m128d vd = _mm_set1_pd(D);
+
+      for (; cpt <= m_pointCloudFace.size() - 6; cpt += 6, ptr_point_cloud += 6, ptr_error += 2) {
+        const __m128d vx = _mm_loadu_pd(ptr_point_cloud);
+        const __m128d vy = _mm_loadu_pd(ptr_point_cloud + 2);
+        const __m128d vz = _mm_loadu_pd(ptr_point_cloud + 4);
+
+        const __m128d verror =
+            _mm_add_pd(_mm_add_pd(vd, _mm_mul_pd(vnx, vx)), _mm_add_pd(_mm_mul_pd(vny, vy), _mm_mul_pd(vnz, vz)));
+        _mm_storeu_pd(ptr_error, verror);
+      }
+    }
+#endif
+  }
+
+  for (; cpt < m_pointCloudFace.size(); cpt += 3, ptr_point_cloud += 3, ptr_error++) {
+    *ptr_error = D + (nx * ptr_point_cloud[0] + ny * ptr_point_cloud[1] + nz * ptr_point_cloud[2]);
+  }
+}
+
 void vpMbtFaceDepthDense::computeROI(const vpHomogeneousMatrix &cMo, unsigned int width,
                                      unsigned int height, std::vector<vpImagePoint> &roiPts
 #if DEBUG_DISPLAY_DEPTH_DENSE
@@ -307,17 +307,23 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
 }
 #endif
 
-bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
-                                                  unsigned int height,
-                                                  const std::vector<vpColVector> &point_cloud,
-                                                  vpColVector &desired_features, unsigned int stepX,
-                                                  unsigned int stepY
+/*!
+  Estimate the plane of the face from the points of an organized point cloud
+  that lie inside the projected face. \e PointCloud is either a
+  std::vector<vpColVector> or a vpPointCloud, the coordinates of the point \e n
+  being read with <tt>point_cloud[n][k]</tt>.
+*/
+template <class PointCloud>
+bool vpMbtFaceDepthNormal::computeDesiredFeaturesOrganized(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                           unsigned int height, const PointCloud &point_cloud,
+                                                           vpColVector &desired_features, unsigned int stepX,
+                                                           unsigned int stepY
 #if DEBUG_DISPLAY_DEPTH_NORMAL
-                                                  ,
-                                                  vpImage<unsigned char> &debugImage,
-                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+                                                           ,
+                                                           vpImage<unsigned char> &debugImage,
+                                                           std::vector<std::vector<vpImagePoint> > &roiPts_vec
 #endif
-                                                  , const vpImage<bool> *mask
+                                                           , const vpImage<bool> *mask
 )
 {
   m_faceActivated = false;
@@ -465,6 +471,47 @@ bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo
   return true;
 }
 
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, unsigned int width,
+                                                  unsigned int height,
+                                                  const std::vector<vpColVector> &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX,
+                                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, width, height, point_cloud, desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
+bool vpMbtFaceDepthNormal::computeDesiredFeatures(const vpHomogeneousMatrix &cMo, const vpPointCloud &point_cloud,
+                                                  vpColVector &desired_features, unsigned int stepX,
+                                                  unsigned int stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                                  ,
+                                                  vpImage<unsigned char> &debugImage,
+                                                  std::vector<std::vector<vpImagePoint> > &roiPts_vec
+#endif
+                                                  , const vpImage<bool> *mask
+)
+{
+  return computeDesiredFeaturesOrganized(cMo, point_cloud.getWidth(), point_cloud.getHeight(), point_cloud,
+                                         desired_features, stepX, stepY
+#if DEBUG_DISPLAY_DEPTH_NORMAL
+                                         ,
+                                         debugImage, roiPts_vec
+#endif
+                                         , mask);
+}
+
 #ifdef VISP_HAVE_PCL
 bool vpMbtFaceDepthNormal::computeDesiredFeaturesPCL(const pcl::PointCloud<pcl::PointXYZ>::ConstPtr &point_cloud_face,
                                                      vpColVector &desired_features, vpColVector &desired_normal,
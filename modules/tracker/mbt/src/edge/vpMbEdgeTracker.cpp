@@ -48,6 +48,7 @@
 #include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpMath.h>
 #include <visp3/core/vpMatrixException.h>
+#include <visp3/core/vpParallel.h>
 #include <visp3/core/vpPixelMeterConversion.h>
 #include <visp3/core/vpPolygon3D.h>
 #include <visp3/core/vpTrackingException.h>
@@ -63,6 +64,45 @@
 #include <sstream>
 #include <string>
 
+namespace
+{
+// Search of the moving edges of a range of features, the lines being followed
+// by the cylinders and the circles. Each feature only updates its own sites
+// and the moving edges parameters are only read.
+class vpMovingEdgeTrackingBody : public vpParallelBody
+{
+public:
+  vpMovingEdgeTrackingBody(const vpImage<unsigned char> &I, const vpHomogeneousMatrix &cMo,
+                           const std::vector<vpMbtDistanceLine *> &lines,
+                           const std::vector<vpMbtDistanceCylinder *> &cylinders,
+                           const std::vector<vpMbtDistanceCircle *> &circles)
+    : m_I(I), m_cMo(cMo), m_lines(lines), m_cylinders(cylinders), m_circles(circles)
+  {
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    const size_t nbLines = m_lines.size(), nbCylinders = m_cylinders.size();
+    for (size_t i = begin; i < end; i++) {
+      if (i < nbLines) {
+        m_lines[i]->trackMovingEdge(m_I);
+      } else if (i < nbLines + nbCylinders) {
+        m_cylinders[i - nbLines]->trackMovingEdge(m_I, m_cMo);
+      } else {
+        m_circles[i - nbLines - nbCylinders]->trackMovingEdge(m_I, m_cMo);
+      }
+    }
+  }
+
+private:
+  const vpImage<unsigned char> &m_I;
+  const vpHomogeneousMatrix &m_cMo;
+  const std::vector<vpMbtDistanceLine *> &m_lines;
+  const std::vector<vpMbtDistanceCylinder *> &m_cylinders;
+  const std::vector<vpMbtDistanceCircle *> &m_circles;
+};
+} // namespace
+
 /*!
   Basic constructor
 */
@@ -71,7 +111,8 @@ vpMbEdgeTracker::vpMbEdgeTracker()
     percentageGdPt(0.4), scales(1), Ipyramid(0), scaleLevel(0), nbFeaturesForProjErrorComputation(0), m_factor(),
     m_robustLines(), m_robustCylinders(), m_robustCircles(), m_wLines(), m_wCylinders(), m_wCircles(), m_errorLines(),
     m_errorCylinders(), m_errorCircles(), m_L_edge(), m_error_edge(), m_w_edge(), m_weightedError_edge(),
-    m_robust_edge(), m_featuresToBeDisplayedEdge()
+    m_robust_edge(), m_featuresToBeDisplayedEdge(), m_LTL_edge(), m_LTR_edge(), m_v_edge(),
+    m_nbMovingEdgeThreads(1)
 {
   scales[0] = true;
 
@@ -155,6 +196,23 @@ void vpMbEdgeTracker::setMovingEdge(const vpMe &p_me)
   }
 }
 
+/*!
+  Set the maximum number of threads used to search the moving edges of the
+  visible lines, cylinders and circles, on the thread pool of vpParallel.
+  The features are distributed over the threads, each feature being tracked
+  by a single thread, thus the tracked moving edges and the estimated pose do
+  not depend on the number of threads.
+
+  \param nbThreads : Number of threads. 1 (the default) tracks the features
+  sequentially, 0 uses vpParallel::getNumThreads() threads.
+
+  \note The display of the moving edges sites during their search, see
+  vpMeSite::setDisplay(), is not thread-safe and requires a single thread.
+
+  \sa getNbMovingEdgeThreads()
+*/
+void vpMbEdgeTracker::setNbMovingEdgeThreads(unsigned int nbThreads) { m_nbMovingEdgeThreads = nbThreads; }
+
 /*!
   Compute the visual servoing loop to get the pose of the feature set.
 
@@ -214,6 +272,7 @@ void vpMbEdgeTracker::computeVVS(const vpImage<unsigned char> &_I, unsigned int
   vpMatrix LTL;
   vpColVector LTR;
   vpColVector v;
+  vpVelocityTwistMatrix cVo;
 
   iter = 0;
   m_w_edge = 1;
@@ -229,9 +288,6 @@ void vpMbEdgeTracker::computeVVS(const vpImage<unsigned char> &_I, unsigned int
     if (!reStartFromLastIncrement) {
       computeVVSWeights();
 
-      L_true = m_L_edge;
-      vpVelocityTwistMatrix cVo;
-
       if (computeCovariance) {
         L_true = m_L_edge;
         if (!isoJoIdentity_) {
@@ -275,7 +331,7 @@ void vpMbEdgeTracker::computeVVS(const vpImage<unsigned char> &_I, unsigned int
                                LTR, mu, v, &m_w_edge, &m_w_prev);
 
       cMoPrev = m_cMo;
-      m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
+      computeVVSPoseUpdate(v, m_cMo);
 
     } // endif(!restartFromLast)
 
@@ -323,13 +379,13 @@ void vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char> &_I, uns
         }
       }
 
-      std::list<vpMeSite>::const_iterator itListLine;
+      std::vector<vpMeSite>::const_iterator itListLine;
 
       unsigned int indexFeature = 0;
 
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (iter == 0 && l->meline[a] != NULL)
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
         for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
           for (unsigned int j = 0; j < 6; j++) {
@@ -396,11 +452,11 @@ void vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char> &_I, uns
       cy->computeInteractionMatrixError(m_cMo, _I);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if (iter == 0 && (cy->meline1 != NULL || cy->meline2 != NULL)) {
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
       }
 
       for (unsigned int i = 0; i < cy->nbFeature; i++) {
@@ -490,9 +546,9 @@ void vpMbEdgeTracker::computeVVSFirstPhase(const vpImage<unsigned char> &_I, uns
       ci->computeInteractionMatrixError(m_cMo);
       double fac = 1.0;
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (iter == 0 && (ci->meEllipse != NULL)) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
       }
 
       for (unsigned int i = 0; i < ci->nbFeature; i++) {
@@ -581,9 +637,9 @@ void vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char> &I
 
       unsigned int indexFeature = 0;
       for (size_t a = 0; a < l->meline.size(); a++) {
-        std::list<vpMeSite>::const_iterator itListLine;
+        std::vector<vpMeSite>::const_iterator itListLine;
         if (l->meline[a] != NULL) {
-          itListLine = l->meline[a]->getMeList().begin();
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
             m_factor[n + i] = fac;
@@ -605,11 +661,11 @@ void vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char> &I
       cy = *it;
       cy->computeInteractionMatrixError(m_cMo, I);
 
-      std::list<vpMeSite>::const_iterator itCyl1;
-      std::list<vpMeSite>::const_iterator itCyl2;
+      std::vector<vpMeSite>::const_iterator itCyl1;
+      std::vector<vpMeSite>::const_iterator itCyl2;
       if ((cy->meline1 != NULL || cy->meline2 != NULL)) {
-        itCyl1 = cy->meline1->getMeList().begin();
-        itCyl2 = cy->meline2->getMeList().begin();
+        itCyl1 = cy->meline1->getMeSites().begin();
+        itCyl2 = cy->meline2->getMeSites().begin();
 
         double fac = 1.0;
         for (unsigned int i = 0; i < cy->nbFeature; i++) {
@@ -635,9 +691,9 @@ void vpMbEdgeTracker::computeVVSFirstPhaseFactor(const vpImage<unsigned char> &I
       ci = *it;
       ci->computeInteractionMatrixError(m_cMo);
 
-      std::list<vpMeSite>::const_iterator itCir;
+      std::vector<vpMeSite>::const_iterator itCir;
       if (ci->meEllipse != NULL) {
-        itCir = ci->meEllipse->getMeList().begin();
+        itCir = ci->meEllipse->getMeSites().begin();
         double fac = 1.0;
 
         for (unsigned int i = 0; i < ci->nbFeature; i++) {
@@ -701,25 +757,8 @@ void vpMbEdgeTracker::computeVVSFirstPhasePoseEstimation(unsigned int iter, bool
     }
   }
 
-  vpColVector v;
-  vpMatrix LTL;
-  vpColVector LTR;
-
-  if (isoJoIdentity_) {
-    LTL = m_L_edge.AtA();
-    computeJTR(m_L_edge, m_weightedError_edge, LTR);
-    v = -0.7 * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
-  } else {
-    cVo.buildFrom(m_cMo);
-    vpMatrix LVJ = (m_L_edge * cVo * oJo);
-    vpMatrix LVJTLVJ = (LVJ).AtA();
-    vpColVector LVJTR;
-    computeJTR(LVJ, m_weightedError_edge, LVJTR);
-    v = -0.7 * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-    v = cVo * v;
-  }
-
-  m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
+  computeVVSVelocity(isoJoIdentity_, m_L_edge, m_weightedError_edge, 0.7, 0., m_LTL_edge, m_LTR_edge, m_v_edge);
+  computeVVSPoseUpdate(m_v_edge, m_cMo);
 }
 
 void vpMbEdgeTracker::computeVVSInit()
@@ -952,8 +991,8 @@ void vpMbEdgeTracker::testTracking()
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (l->meline[a] != NULL) {
           nbExpectedPoint += (int)l->meline[a]->expecteddensity;
-          for (std::list<vpMeSite>::const_iterator itme = l->meline[a]->getMeList().begin();
-               itme != l->meline[a]->getMeList().end(); ++itme) {
+          for (std::vector<vpMeSite>::const_iterator itme = l->meline[a]->getMeSites().begin();
+               itme != l->meline[a]->getMeSites().end(); ++itme) {
             vpMeSite pix = *itme;
             if (pix.getState() == vpMeSite::NO_SUPPRESSION)
               nbGoodPoint++;
@@ -970,8 +1009,8 @@ void vpMbEdgeTracker::testTracking()
     vpMbtDistanceCylinder *cy = *it;
     if ((cy->meline1 != NULL && cy->meline2 != NULL) && cy->isVisible() && cy->isTracked()) {
       nbExpectedPoint += (int)cy->meline1->expecteddensity;
-      for (std::list<vpMeSite>::const_iterator itme1 = cy->meline1->getMeList().begin();
-           itme1 != cy->meline1->getMeList().end(); ++itme1) {
+      for (std::vector<vpMeSite>::const_iterator itme1 = cy->meline1->getMeSites().begin();
+           itme1 != cy->meline1->getMeSites().end(); ++itme1) {
         vpMeSite pix = *itme1;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoint++;
@@ -979,8 +1018,8 @@ void vpMbEdgeTracker::testTracking()
           nbBadPoint++;
       }
       nbExpectedPoint += (int)cy->meline2->expecteddensity;
-      for (std::list<vpMeSite>::const_iterator itme2 = cy->meline2->getMeList().begin();
-           itme2 != cy->meline2->getMeList().end(); ++itme2) {
+      for (std::vector<vpMeSite>::const_iterator itme2 = cy->meline2->getMeSites().begin();
+           itme2 != cy->meline2->getMeSites().end(); ++itme2) {
         vpMeSite pix = *itme2;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoint++;
@@ -995,8 +1034,8 @@ void vpMbEdgeTracker::testTracking()
     vpMbtDistanceCircle *ci = *it;
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL) {
       nbExpectedPoint += ci->meEllipse->getExpectedDensity();
-      for (std::list<vpMeSite>::const_iterator itme = ci->meEllipse->getMeList().begin();
-           itme != ci->meEllipse->getMeList().end(); ++itme) {
+      for (std::vector<vpMeSite>::const_iterator itme = ci->meEllipse->getMeSites().begin();
+           itme != ci->meEllipse->getMeSites().end(); ++itme) {
         vpMeSite pix = *itme;
         if (pix.getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoint++;
@@ -1248,6 +1287,7 @@ void vpMbEdgeTracker::loadConfigFile(const std::string &configFile)
 
   setCameraParameters(camera);
   setMovingEdge(meParser);
+  setNbMovingEdgeThreads(xmlp.getEdgeNbThreads());
   angleAppears = vpMath::rad(xmlp.getAngleAppear());
   angleDisappears = vpMath::rad(xmlp.getAngleDisappear());
 
@@ -1631,12 +1671,23 @@ void vpMbEdgeTracker::initMovingEdge(const vpImage<unsigned char> &I, const vpHo
 /*!
   Track the moving edges in the image.
 
+  The features whose moving edges have to be initialized are first
+  initialized sequentially, since the initialization temporarily modifies the
+  shared moving edges parameters and queries the scan line renderer. The
+  search of the moving edges along their normal is then distributed over the
+  features, see setNbMovingEdgeThreads(). Each feature only updates its own
+  sites, thus the result does not depend on the number of threads.
+
   \param I : the image.
 */
 void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
 {
   const bool doNotTrack = false;
 
+  std::vector<vpMbtDistanceLine *> trackedLines;
+  std::vector<vpMbtDistanceCylinder *> trackedCylinders;
+  std::vector<vpMbtDistanceCircle *> trackedCircles;
+
   for (std::list<vpMbtDistanceLine *>::const_iterator it = lines[scaleLevel].begin(); it != lines[scaleLevel].end();
        ++it) {
     vpMbtDistanceLine *l = *it;
@@ -1644,7 +1695,7 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (l->meline.empty()) {
         l->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      l->trackMovingEdge(I);
+      trackedLines.push_back(l);
     }
   }
 
@@ -1655,7 +1706,7 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (cy->meline1 == NULL || cy->meline2 == NULL) {
         cy->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      cy->trackMovingEdge(I, m_cMo);
+      trackedCylinders.push_back(cy);
     }
   }
 
@@ -1666,9 +1717,15 @@ void vpMbEdgeTracker::trackMovingEdge(const vpImage<unsigned char> &I)
       if (ci->meEllipse == NULL) {
         ci->initMovingEdge(I, m_cMo, doNotTrack, m_mask);
       }
-      ci->trackMovingEdge(I, m_cMo);
+      trackedCircles.push_back(ci);
     }
   }
+
+  const unsigned int nbFeatures =
+      static_cast<unsigned int>(trackedLines.size() + trackedCylinders.size() + trackedCircles.size());
+  vpParallel::parallelFor(0, nbFeatures,
+                          vpMovingEdgeTrackingBody(I, m_cMo, trackedLines, trackedCylinders, trackedCircles),
+                          m_nbMovingEdgeThreads, 1);
 }
 
 /*!
@@ -1728,8 +1785,8 @@ void vpMbEdgeTracker::updateMovingEdgeWeights()
       double wmean = 0;
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (l->nbFeature[a] > 0) {
-          std::list<vpMeSite>::iterator itListLine;
-          itListLine = l->meline[a]->getMeList().begin();
+          std::vector<vpMeSite>::iterator itListLine;
+          itListLine = l->meline[a]->getMeSites().begin();
 
           for (unsigned int i = 0; i < l->nbFeature[a]; i++) {
             wmean += m_w_edge[n + indexLine];
@@ -1766,12 +1823,12 @@ void vpMbEdgeTracker::updateMovingEdgeWeights()
     if ((*it)->isTracked()) {
       cy = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCyl1;
-      std::list<vpMeSite>::iterator itListCyl2;
+      std::vector<vpMeSite>::iterator itListCyl1;
+      std::vector<vpMeSite>::iterator itListCyl2;
 
       if (cy->nbFeature > 0) {
-        itListCyl1 = cy->meline1->getMeList().begin();
-        itListCyl2 = cy->meline2->getMeList().begin();
+        itListCyl1 = cy->meline1->getMeSites().begin();
+        itListCyl2 = cy->meline2->getMeSites().begin();
 
         for (unsigned int i = 0; i < cy->nbFeaturel1; i++) {
           wmean += m_w_edge[n + i];
@@ -1832,10 +1889,10 @@ void vpMbEdgeTracker::updateMovingEdgeWeights()
     if ((*it)->isTracked()) {
       ci = *it;
       double wmean = 0;
-      std::list<vpMeSite>::iterator itListCir;
+      std::vector<vpMeSite>::iterator itListCir;
 
       if (ci->nbFeature > 0) {
-        itListCir = ci->meEllipse->getMeList().begin();
+        itListCir = ci->meEllipse->getMeSites().begin();
       }
 
       wmean = 0;
@@ -2523,8 +2580,8 @@ unsigned int vpMbEdgeTracker::getNbPoints(unsigned int level) const
     if (l->isVisible() && l->isTracked()) {
       for (size_t a = 0; a < l->meline.size(); a++) {
         if (l->nbFeature[a] != 0)
-          for (std::list<vpMeSite>::const_iterator itme = l->meline[a]->getMeList().begin();
-               itme != l->meline[a]->getMeList().end(); ++itme) {
+          for (std::vector<vpMeSite>::const_iterator itme = l->meline[a]->getMeSites().begin();
+               itme != l->meline[a]->getMeSites().end(); ++itme) {
             if (itme->getState() == vpMeSite::NO_SUPPRESSION)
               nbGoodPoints++;
           }
@@ -2537,13 +2594,13 @@ unsigned int vpMbEdgeTracker::getNbPoints(unsigned int level) const
        ++it) {
     cy = *it;
     if (cy->isVisible() && cy->isTracked() && (cy->meline1 != NULL || cy->meline2 != NULL)) {
-      for (std::list<vpMeSite>::const_iterator itme1 = cy->meline1->getMeList().begin();
-           itme1 != cy->meline1->getMeList().end(); ++itme1) {
+      for (std::vector<vpMeSite>::const_iterator itme1 = cy->meline1->getMeSites().begin();
+           itme1 != cy->meline1->getMeSites().end(); ++itme1) {
         if (itme1->getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoints++;
       }
-      for (std::list<vpMeSite>::const_iterator itme2 = cy->meline2->getMeList().begin();
-           itme2 != cy->meline2->getMeList().end(); ++itme2) {
+      for (std::vector<vpMeSite>::const_iterator itme2 = cy->meline2->getMeSites().begin();
+           itme2 != cy->meline2->getMeSites().end(); ++itme2) {
         if (itme2->getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoints++;
       }
@@ -2554,8 +2611,8 @@ unsigned int vpMbEdgeTracker::getNbPoints(unsigned int level) const
   for (std::list<vpMbtDistanceCircle *>::const_iterator it = circles[level].begin(); it != circles[level].end(); ++it) {
     ci = *it;
     if (ci->isVisible() && ci->isTracked() && ci->meEllipse != NULL) {
-      for (std::list<vpMeSite>::const_iterator itme = ci->meEllipse->getMeList().begin();
-           itme != ci->meEllipse->getMeList().end(); ++itme) {
+      for (std::vector<vpMeSite>::const_iterator itme = ci->meEllipse->getMeSites().begin();
+           itme != ci->meEllipse->getMeSites().end(); ++itme) {
         if (itme->getState() == vpMeSite::NO_SUPPRESSION)
           nbGoodPoints++;
       }
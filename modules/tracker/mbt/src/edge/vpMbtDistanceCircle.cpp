@@ -198,7 +198,7 @@ void vpMbtDistanceCircle::trackMovingEdge(const vpImage<unsigned char> &I, const
     }
 
     // Update the number of features
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
   }
 }
 
@@ -231,7 +231,7 @@ void vpMbtDistanceCircle::updateMovingEdge(const vpImage<unsigned char> &I, cons
     } catch (...) {
       Reinit = true;
     }
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
   }
 }
 
@@ -315,7 +315,7 @@ std::vector<std::vector<double> > vpMbtDistanceCircle::getFeaturesForDisplay()
   std::vector<std::vector<double> > features;
 
   if (meEllipse != NULL) {
-    for (std::list<vpMeSite>::const_iterator it = meEllipse->getMeList().begin(); it != meEllipse->getMeList().end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = meEllipse->getMeSites().begin(); it != meEllipse->getMeSites().end(); ++it) {
       vpMeSite p_me = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       std::vector<double> params = {0, //ME
@@ -410,7 +410,7 @@ void vpMbtDistanceCircle::displayMovingEdges(const vpImage<vpRGBa> &I)
 void vpMbtDistanceCircle::initInteractionMatrixError()
 {
   if (isvisible) {
-    nbFeature = (unsigned int)meEllipse->getMeList().size();
+    nbFeature = (unsigned int)meEllipse->getMeSites().size();
     L.resize(nbFeature, 6);
     error.resize(nbFeature);
   } else
@@ -448,7 +448,7 @@ void vpMbtDistanceCircle::computeInteractionMatrixError(const vpHomogeneousMatri
 
     unsigned int j = 0;
 
-    for (std::list<vpMeSite>::const_iterator it = meEllipse->getMeList().begin(); it != meEllipse->getMeList().end();
+    for (std::vector<vpMeSite>::const_iterator it = meEllipse->getMeSites().begin(); it != meEllipse->getMeSites().end();
          ++it) {
       vpPixelMeterConversion::convertPoint(cam, it->j, it->i, x, y);
       H[0] = 2 * (mu11 * (y - yg) + mu02 * (xg - x));
@@ -339,8 +339,8 @@ void vpMbtDistanceCylinder::trackMovingEdge(const vpImage<unsigned char> &I, con
     }
 
     // Update the number of features
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
   }
 }
@@ -470,8 +470,8 @@ void vpMbtDistanceCylinder::updateMovingEdge(const vpImage<unsigned char> &I, co
     }
 
     // Update the numbers of features
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
   }
 }
@@ -562,7 +562,7 @@ std::vector<std::vector<double> > vpMbtDistanceCylinder::getFeaturesForDisplay()
   std::vector<std::vector<double> > features;
 
   if (meline1 != NULL) {
-    for (std::list<vpMeSite>::const_iterator it = meline1->getMeList().begin(); it != meline1->getMeList().end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = meline1->getMeSites().begin(); it != meline1->getMeSites().end(); ++it) {
       vpMeSite p_me = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       std::vector<double> params = {0, //ME
@@ -581,7 +581,7 @@ std::vector<std::vector<double> > vpMbtDistanceCylinder::getFeaturesForDisplay()
   }
 
   if (meline2 != NULL) {
-    for (std::list<vpMeSite>::const_iterator it = meline2->getMeList().begin(); it != meline2->getMeList().end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = meline2->getMeSites().begin(); it != meline2->getMeSites().end(); ++it) {
       vpMeSite p_me = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
       std::vector<double> params = {0, //ME
@@ -738,8 +738,8 @@ void vpMbtDistanceCylinder::displayMovingEdges(const vpImage<vpRGBa> &I)
 void vpMbtDistanceCylinder::initInteractionMatrixError()
 {
   if (isvisible) {
-    nbFeaturel1 = (unsigned int)meline1->getMeList().size();
-    nbFeaturel2 = (unsigned int)meline2->getMeList().size();
+    nbFeaturel1 = (unsigned int)meline1->getMeSites().size();
+    nbFeaturel2 = (unsigned int)meline2->getMeSites().size();
     nbFeature = nbFeaturel1 + nbFeaturel2;
     L.resize(nbFeature, 6);
     error.resize(nbFeature);
@@ -805,7 +805,7 @@ void vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMat
 
     vpMeSite p;
     unsigned int j = 0;
-    for (std::list<vpMeSite>::const_iterator it = meline1->getMeList().begin(); it != meline1->getMeList().end();
+    for (std::vector<vpMeSite>::const_iterator it = meline1->getMeSites().begin(); it != meline1->getMeSites().end();
          ++it) {
       double x = (double)it->j;
       double y = (double)it->i;
@@ -829,7 +829,7 @@ void vpMbtDistanceCylinder::computeInteractionMatrixError(const vpHomogeneousMat
       j++;
     }
 
-    for (std::list<vpMeSite>::const_iterator it = meline2->getMeList().begin(); it != meline2->getMeList().end();
+    for (std::vector<vpMeSite>::const_iterator it = meline2->getMeSites().begin(); it != meline2->getMeSites().end();
          ++it) {
       double x = (double)it->j;
       double y = (double)it->i;
@@ -397,7 +397,7 @@ bool vpMbtDistanceLine::initMovingEdge(const vpImage<unsigned char> &I, const vp
         try {
           melinePt->initTracking(I, ip1, ip2, rho, theta, doNotTrack);
           meline.push_back(melinePt);
-          nbFeature.push_back((unsigned int) melinePt->getMeList().size());
+          nbFeature.push_back((unsigned int) melinePt->getMeSites().size());
           nbFeatureTotal += nbFeature.back();
         } catch (...) {
           delete melinePt;
@@ -426,8 +426,8 @@ void vpMbtDistanceLine::trackMovingEdge(const vpImage<unsigned char> &I)
       nbFeatureTotal = 0;
       for (size_t i = 0; i < meline.size(); i++) {
         meline[i]->track(I);
-        nbFeature.push_back((unsigned int)meline[i]->getMeList().size());
-        nbFeatureTotal += (unsigned int)meline[i]->getMeList().size();
+        nbFeature.push_back((unsigned int)meline[i]->getMeSites().size());
+        nbFeatureTotal += (unsigned int)meline[i]->getMeSites().size();
       }
     } catch (...) {
       for (size_t i = 0; i < meline.size(); i++) {
@@ -543,7 +543,7 @@ void vpMbtDistanceLine::updateMovingEdge(const vpImage<unsigned char> &I, const
             }
 
             meline[i]->updateParameters(I, ip1, ip2, rho, theta);
-            nbFeature[i] = (unsigned int)meline[i]->getMeList().size();
+            nbFeature[i] = (unsigned int)meline[i]->getMeSites().size();
             nbFeatureTotal += nbFeature[i];
           }
         } catch (...) {
@@ -692,7 +692,7 @@ std::vector<std::vector<double> > vpMbtDistanceLine::getFeaturesForDisplay()
   for (size_t i = 0; i < meline.size(); i++) {
     vpMbtMeLine *me_l = meline[i];
     if (me_l != NULL) {
-      for (std::list<vpMeSite>::const_iterator it = me_l->getMeList().begin(); it != me_l->getMeList().end(); ++it) {
+      for (std::vector<vpMeSite>::const_iterator it = me_l->getMeSites().begin(); it != me_l->getMeSites().end(); ++it) {
         vpMeSite p_me_l = *it;
 #if (VISP_CXX_STANDARD >= VISP_CXX_STANDARD_11)
         std::vector<double> params = {0, //ME
@@ -799,7 +799,7 @@ void vpMbtDistanceLine::initInteractionMatrixError()
     for (size_t i = 0; i < meline.size(); i++) {
       nbFeature[i] = 0;
       // To be consistent with nbFeature[i] = 0
-      std::list<vpMeSite> &me_site_list = meline[i]->getMeList();
+      std::vector<vpMeSite> &me_site_list = meline[i]->getMeSites();
       me_site_list.clear();
     }
     nbFeatureTotal = 0;
@@ -838,8 +838,8 @@ void vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix
       unsigned int j = 0;
 
       for (size_t i = 0; i < meline.size(); i++) {
-        for (std::list<vpMeSite>::const_iterator it = meline[i]->getMeList().begin();
-             it != meline[i]->getMeList().end(); ++it) {
+        for (std::vector<vpMeSite>::const_iterator it = meline[i]->getMeSites().begin();
+             it != meline[i]->getMeSites().end(); ++it) {
           x = (double)it->j;
           y = (double)it->i;
 
@@ -863,8 +863,8 @@ void vpMbtDistanceLine::computeInteractionMatrixError(const vpHomogeneousMatrix
       // Set the corresponding interaction matrix part to zero
       unsigned int j = 0;
       for (size_t i = 0; i < meline.size(); i++) {
-        for (std::list<vpMeSite>::const_iterator it = meline[i]->getMeList().begin();
-             it != meline[i]->getMeList().end(); ++it) {
+        for (std::vector<vpMeSite>::const_iterator it = meline[i]->getMeSites().begin();
+             it != meline[i]->getMeSites().end(); ++it) {
           for (unsigned int k = 0; k < 6; k++) {
             L[j][k] = 0.0;
           }
@@ -893,7 +893,7 @@ bool vpMbtDistanceLine::closeToImageBorder(const vpImage<unsigned char> &I, cons
   if (isvisible) {
 
     for (size_t i = 0; i < meline.size(); i++) {
-      for (std::list<vpMeSite>::const_iterator it = meline[i]->getMeList().begin(); it != meline[i]->getMeList().end();
+      for (std::vector<vpMeSite>::const_iterator it = meline[i]->getMeSites().begin(); it != meline[i]->getMeSites().end();
            ++it) {
         int i_ = it->i;
         int j_ = it->j;
@@ -113,7 +113,7 @@ void vpMbtMeEllipse::computeProjectionError(const vpImage<unsigned char> &_I, do
   int height = (int)_I.getHeight();
   int width = (int)_I.getWidth();
 
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     double iSite = it->ifloat;
     double jSite = it->jfloat;
 
@@ -335,7 +335,7 @@ void vpMbtMeEllipse::reSample(const vpImage<unsigned char> &I)
 void vpMbtMeEllipse::updateTheta()
 {
   vpMeSite p_me;
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     vpImagePoint iP;
     iP.set_i(p_me.ifloat);
@@ -357,14 +357,13 @@ void vpMbtMeEllipse::updateTheta()
 */
 void vpMbtMeEllipse::suppressPoints()
 {
-  // Loop through list of sites to track
-  for (std::list<vpMeSite>::iterator itList = list.begin(); itList != list.end();) {
-    vpMeSite s = *itList; // current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      itList = list.erase(itList);
-    else
-      ++itList;
+  // Compact the remaining sites in place, in the same order
+  size_t nbSites = 0;
+  for (size_t k = 0; k < list.size(); k++) {
+    if (list[k].getState() == vpMeSite::NO_SUPPRESSION)
+      list[nbSites++] = list[k];
   }
+  list.erase(list.begin() + static_cast<std::ptrdiff_t>(nbSites), list.end());
 }
 
 /*!
@@ -44,7 +44,7 @@
  \file vpMbtMeLine.cpp
  \brief Make the complete tracking of an object by using its CAD model.
 */
-#include <algorithm> // (std::min)
+#include <algorithm> // (std::min), std::stable_sort
 #include <cmath>     // std::fabs
 #include <limits>    // numeric_limits
 
@@ -206,8 +206,10 @@ void vpMbtMeLine::sample(const vpImage<unsigned char> &I, bool doNoTrack)
 */
 void vpMbtMeLine::suppressPoints(const vpImage<unsigned char> &I)
 {
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();) {
-    vpMeSite s = *it; // current reference pixel
+  // Compact the remaining sites in place, in the same order
+  size_t nbSites = 0;
+  for (size_t k = 0; k < list.size(); k++) {
+    vpMeSite s = list[k]; // current reference pixel
 
     if (fabs(sin(theta)) > 0.9) // Vertical line management
     {
@@ -233,11 +235,10 @@ void vpMbtMeLine::suppressPoints(const vpImage<unsigned char> &I)
       s.setState(vpMeSite::TOO_NEAR);
     }
 
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
+    if (s.getState() == vpMeSite::NO_SUPPRESSION)
+      list[nbSites++] = s;
   }
+  list.erase(list.begin() + static_cast<std::ptrdiff_t>(nbSites), list.end());
 }
 
 /*!
@@ -370,7 +371,7 @@ void vpMbtMeLine::computeProjectionError(const vpImage<unsigned char> &_I, doubl
 
   double offset = std::floor(SobelX.getRows() / 2.0f);
 
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     if (iter != 0 && iter + 1 != list.size()) {
       double gradientX = 0;
       double gradientY = 0;
@@ -547,7 +548,7 @@ void vpMbtMeLine::updateDelta()
   delta = -theta + M_PI / 2.0;
   normalizeAngle(delta);
 
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     p_me.alpha = delta;
     p_me.mask_sign = sign;
@@ -644,7 +645,7 @@ void vpMbtMeLine::setExtremities()
   double j_max = -1;
 
   // Loop through list of sites to track
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite s = *it; // current reference pixel
     if (s.ifloat < i_min) {
       i_min = s.ifloat;
@@ -665,7 +666,7 @@ void vpMbtMeLine::setExtremities()
   }
 
   if (fabs(i_min - i_max) < 25) {
-    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
       vpMeSite s = *it; // current reference pixel
       if (s.jfloat < j_min) {
         i_min = s.ifloat;
@@ -711,7 +712,7 @@ void vpMbtMeLine::bubbleSortI()
     }
   }
 #endif
-  list.sort(sortByI);
+  std::stable_sort(list.begin(), list.end(), sortByI);
 }
 
 static bool sortByJ(const vpMeSite &s1, const vpMeSite &s2) { return (s1.jfloat > s2.jfloat); }
@@ -734,7 +735,7 @@ void vpMbtMeLine::bubbleSortJ()
     }
   }
 #endif
-  list.sort(sortByJ);
+  std::stable_sort(list.begin(), list.end(), sortByJ);
 }
 
 #endif
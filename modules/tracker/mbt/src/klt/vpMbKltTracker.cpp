@@ -847,8 +847,9 @@ void vpMbKltTracker::computeVVS()
 
       cMoPrev = m_cMo;
       ctTc0_Prev = ctTc0;
-      ctTc0 = vpExponentialMap::direct(v).inverse() * ctTc0;
-      m_cMo = ctTc0 * c0Mo;
+      computeVVSPoseUpdate(v, ctTc0);
+      m_cMo = ctTc0;
+      m_cMo *= c0Mo;
     } // endif(!reStartFromLastIncrement)
 
     iter++;
@@ -37,12 +37,141 @@
 
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpTime.h>
 #include <visp3/core/vpTrackingException.h>
 #include <visp3/mbt/vpMbtXmlGenericParser.h>
 
+/*!
+  Per-camera steps of the tracking, executed concurrently by vpParallel. The
+  inputs of each camera are resolved from the maps beforehand and a stripe only
+  modifies its own TrackerWrapper and its own rows of the stacked VVS system,
+  thus the result does not depend on the number of threads.
+*/
+class vpMbGenericTracker::TrackingBody : public vpParallelBody
+{
+public:
+  enum vpTrackingStep { PRE_TRACKING, VVS_FEATURES, VVS_WEIGHTS, POST_TRACKING };
+
+  struct vpCameraData {
+    vpCameraData()
+      : tracker(NULL), I(NULL), point_cloud(NULL), cloud(NULL),
+#ifdef VISP_HAVE_PCL
+        pcl_cloud(),
+#endif
+        width(0), height(0), cVo(), start_index(0)
+    {
+    }
+
+    TrackerWrapper *tracker;
+    const vpImage<unsigned char> *I;
+    const std::vector<vpColVector> *point_cloud;
+    const vpPointCloud *cloud;
+#ifdef VISP_HAVE_PCL
+    pcl::PointCloud<pcl::PointXYZ>::ConstPtr pcl_cloud;
+#endif
+    unsigned int width;
+    unsigned int height;
+    //! Velocity twist matrix from the reference camera (VVS_FEATURES)
+    vpVelocityTwistMatrix cVo;
+    //! First row of the camera in the stacked VVS system
+    unsigned int start_index;
+  };
+
+  TrackingBody(vpMbGenericTracker &tracker, vpTrackingStep step) : m_tracker(tracker), m_step(step), m_cameras() {}
+
+  vpCameraData &addCamera(TrackerWrapper *tracker, const vpImage<unsigned char> *I)
+  {
+    m_cameras.push_back(vpCameraData());
+    m_cameras.back().tracker = tracker;
+    m_cameras.back().I = I;
+    return m_cameras.back();
+  }
+
+  void operator()(unsigned int begin, unsigned int end) const
+  {
+    for (unsigned int i = begin; i < end; i++) {
+      const vpCameraData &camera = m_cameras[i];
+      TrackerWrapper *tracker = camera.tracker;
+      const double t = vpTime::measureTimeMs();
+
+      switch (m_step) {
+      case PRE_TRACKING:
+#ifdef VISP_HAVE_PCL
+        if (camera.pcl_cloud) {
+          tracker->preTracking(camera.I, camera.pcl_cloud);
+        } else
+#endif
+        if (camera.cloud != NULL) {
+          tracker->preTracking(camera.I, camera.cloud);
+        } else {
+          tracker->preTracking(camera.I, camera.point_cloud, camera.width, camera.height);
+        }
+        tracker->m_preTrackingTime = vpTime::measureTimeMs() - t;
+        break;
+
+      case VVS_FEATURES:
+        tracker->computeVVSInteractionMatrixAndResidu(camera.I);
+        m_tracker.m_L.insert(tracker->m_L * camera.cVo, camera.start_index, 0);
+        m_tracker.m_error.insert(camera.start_index, tracker->m_error);
+        tracker->m_vvsTime += vpTime::measureTimeMs() - t;
+        break;
+
+      case VVS_WEIGHTS:
+        tracker->computeVVSWeights();
+        m_tracker.m_w.insert(camera.start_index, tracker->m_w);
+        tracker->m_vvsTime += vpTime::measureTimeMs() - t;
+        break;
+
+      case POST_TRACKING:
+        if (tracker->m_trackerType & EDGE_TRACKER && m_tracker.displayFeatures) {
+          tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+        }
+
+        tracker->postTracking(camera.I, camera.width, camera.height);
+
+        if (m_tracker.displayFeatures) {
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+          if (tracker->m_trackerType & KLT_TRACKER) {
+            tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
+          }
+#endif
+
+          if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
+            tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
+          }
+        }
+        tracker->m_postTrackingTime = vpTime::measureTimeMs() - t;
+        break;
+      }
+    }
+  }
+
+  void run() const
+  {
+    unsigned int nbThreads = m_tracker.m_nbCameraThreads;
+#ifdef VISP_HAVE_OGRE
+    // The Ogre rendering used by the visibility test is not thread-safe
+    for (size_t i = 0; i < m_cameras.size(); i++) {
+      if (m_cameras[i].tracker->useOgre) {
+        nbThreads = 1;
+      }
+    }
+#endif
+
+    vpParallel::parallelFor(0, static_cast<unsigned int>(m_cameras.size()), *this, nbThreads, 1);
+  }
+
+private:
+  vpMbGenericTracker &m_tracker;
+  vpTrackingStep m_step;
+  std::vector<vpCameraData> m_cameras;
+};
+
 vpMbGenericTracker::vpMbGenericTracker()
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbCameraThreads(1)
 {
   m_mapOfTrackers["Camera"] = new TrackerWrapper(EDGE_TRACKER);
 
@@ -62,7 +191,8 @@ vpMbGenericTracker::vpMbGenericTracker()
 
 vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbCameraThreads(1)
 {
   if (nbCameras == 0) {
     throw vpException(vpTrackingException::fatalError, "Cannot use no camera!");
@@ -98,7 +228,8 @@ vpMbGenericTracker::vpMbGenericTracker(unsigned int nbCameras, int trackerType)
 
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbCameraThreads(1)
 {
   if (trackerTypes.empty()) {
     throw vpException(vpException::badValue, "There is no camera!");
@@ -137,7 +268,8 @@ vpMbGenericTracker::vpMbGenericTracker(const std::vector<int> &trackerTypes)
 vpMbGenericTracker::vpMbGenericTracker(const std::vector<std::string> &cameraNames,
                                        const std::vector<int> &trackerTypes)
   : m_error(), m_L(), m_mapOfCameraTransformationMatrix(), m_mapOfFeatureFactors(), m_mapOfTrackers(),
-    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError()
+    m_percentageGdPt(0.4), m_referenceCameraName("Camera"), m_thresholdOutlier(0.5), m_w(), m_weightedError(),
+    m_nbCameraThreads(1)
 {
   if (cameraNames.size() != trackerTypes.size() || cameraNames.empty()) {
     throw vpException(vpTrackingException::badValue,
@@ -460,7 +592,7 @@ void vpMbGenericTracker::computeVVS(std::map<std::string, const vpImage<unsigned
 
       cMo_prev = m_cMo;
 
-      m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
+      computeVVSPoseUpdate(v, m_cMo);
 
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
       for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
@@ -509,6 +641,7 @@ void vpMbGenericTracker::computeVVSInit(std::map<std::string, const vpImage<unsi
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
     tracker->computeVVSInit(mapOfImages[it->first]);
+    tracker->m_vvsTime = 0;
 
     nbFeatures += tracker->m_error.getRows();
   }
@@ -532,6 +665,7 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
     std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
     std::map<std::string, vpVelocityTwistMatrix> &mapOfVelocityTwist)
 {
+  TrackingBody body(*this, TrackingBody::VVS_FEATURES);
   unsigned int start_index = 0;
 
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
@@ -544,27 +678,31 @@ void vpMbGenericTracker::computeVVSInteractionMatrixAndResidu(
     tracker->ctTc0 = c_curr_tTc_curr0;
 #endif
 
-    tracker->computeVVSInteractionMatrixAndResidu(mapOfImages[it->first]);
-
-    m_L.insert(tracker->m_L * mapOfVelocityTwist[it->first], start_index, 0);
-    m_error.insert(start_index, tracker->m_error);
+    TrackingBody::vpCameraData &camera = body.addCamera(tracker, mapOfImages[it->first]);
+    camera.cVo = mapOfVelocityTwist[it->first];
+    camera.start_index = start_index;
 
+    // The number of features is fixed by computeVVSInit()
     start_index += tracker->m_error.getRows();
   }
+
+  body.run();
 }
 
 void vpMbGenericTracker::computeVVSWeights()
 {
+  TrackingBody body(*this, TrackingBody::VVS_WEIGHTS);
   unsigned int start_index = 0;
 
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
-    tracker->computeVVSWeights();
 
-    m_w.insert(start_index, tracker->m_w);
+    body.addCamera(tracker, NULL).start_index = start_index;
     start_index += tracker->m_w.getRows();
   }
+
+  body.run();
 }
 
 /*!
@@ -1754,6 +1892,35 @@ int vpMbGenericTracker::getTrackerType() const
   }
 }
 
+/*!
+  Get the time spent by each camera during the last tracking, in ms.
+
+  \param mapOfPreTrackingTimes : Map of the times spent in the pre-tracking
+  (moving-edges and KLT tracking, point cloud segmentation).
+  \param mapOfVVSTimes : Map of the times spent computing the features, the
+  interaction matrices and the robust weights over all the VVS iterations.
+  \param mapOfPostTrackingTimes : Map of the times spent in the post-tracking
+  (visibility and moving-edges reinitialization).
+
+  \sa setNbCameraThreads()
+*/
+void vpMbGenericTracker::getTrackingTimes(std::map<std::string, double> &mapOfPreTrackingTimes,
+                                          std::map<std::string, double> &mapOfVVSTimes,
+                                          std::map<std::string, double> &mapOfPostTrackingTimes) const
+{
+  mapOfPreTrackingTimes.clear();
+  mapOfVVSTimes.clear();
+  mapOfPostTrackingTimes.clear();
+
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    mapOfPreTrackingTimes[it->first] = tracker->m_preTrackingTime;
+    mapOfVVSTimes[it->first] = tracker->m_vvsTime;
+    mapOfPostTrackingTimes[it->first] = tracker->m_postTrackingTime;
+  }
+}
+
 void vpMbGenericTracker::init(const vpImage<unsigned char> &I)
 {
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
@@ -3007,15 +3174,51 @@ void vpMbGenericTracker::loadModel(const std::map<std::string, std::string> &map
   }
 }
 
+#ifdef VISP_HAVE_PCL
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
+{
+  TrackingBody body(*this, TrackingBody::POST_TRACKING);
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackingBody::vpCameraData &camera = body.addCamera(it->second, mapOfImages[it->first]);
+    pcl::PointCloud<pcl::PointXYZ>::ConstPtr point_cloud = mapOfPointClouds[it->first];
+    if (point_cloud) {
+      camera.width = point_cloud->width;
+      camera.height = point_cloud->height;
+    }
+  }
+
+  body.run();
+}
+#endif
+
+void vpMbGenericTracker::postTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
+                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights)
+{
+  TrackingBody body(*this, TrackingBody::POST_TRACKING);
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackingBody::vpCameraData &camera = body.addCamera(it->second, mapOfImages[it->first]);
+    camera.width = mapOfPointCloudWidths[it->first];
+    camera.height = mapOfPointCloudHeights[it->first];
+  }
+
+  body.run();
+}
+
 #ifdef VISP_HAVE_PCL
 void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
                                      std::map<std::string, pcl::PointCloud<pcl::PointXYZ>::ConstPtr> &mapOfPointClouds)
 {
+  TrackingBody body(*this, TrackingBody::PRE_TRACKING);
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
+    body.addCamera(it->second, mapOfImages[it->first]).pcl_cloud = mapOfPointClouds[it->first];
   }
+
+  body.run();
 }
 #endif
 
@@ -3024,12 +3227,28 @@ void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigne
                                      std::map<std::string, unsigned int> &mapOfPointCloudWidths,
                                      std::map<std::string, unsigned int> &mapOfPointCloudHeights)
 {
+  TrackingBody body(*this, TrackingBody::PRE_TRACKING);
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-    tracker->preTracking(mapOfImages[it->first], mapOfPointClouds[it->first], mapOfPointCloudWidths[it->first],
-                         mapOfPointCloudHeights[it->first]);
+    TrackingBody::vpCameraData &camera = body.addCamera(it->second, mapOfImages[it->first]);
+    camera.point_cloud = mapOfPointClouds[it->first];
+    camera.width = mapOfPointCloudWidths[it->first];
+    camera.height = mapOfPointCloudHeights[it->first];
+  }
+
+  body.run();
+}
+
+void vpMbGenericTracker::preTracking(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                                     std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  TrackingBody body(*this, TrackingBody::PRE_TRACKING);
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    body.addCamera(it->second, mapOfImages[it->first]).cloud = mapOfPointClouds[it->first];
   }
+
+  body.run();
 }
 
 /*!
@@ -4373,6 +4592,46 @@ void vpMbGenericTracker::setMovingEdge(const std::map<std::string, vpMe> &mapOfM
   }
 }
 
+/*!
+  Set the maximum number of threads used to process the cameras concurrently:
+  the pre-tracking, the computation of the features and of the robust weights
+  in the VVS loop, and the post-tracking of each camera are executed on the
+  thread pool of vpParallel. The stacking of the VVS system and the pose
+  update remain sequential, thus the estimated pose does not depend on the
+  number of threads.
+
+  \param nbThreads : Number of threads. 1 (the default) processes the cameras
+  sequentially, 0 uses vpParallel::getNumThreads() threads.
+
+  \note The cameras are processed sequentially when the Ogre visibility test
+  is used.
+
+  \sa getTrackingTimes()
+*/
+void vpMbGenericTracker::setNbCameraThreads(unsigned int nbThreads) { m_nbCameraThreads = nbThreads; }
+
+/*!
+  Set the maximum number of threads used to search the moving edges of each
+  camera.
+
+  \param nbThreads : Number of threads. 1 (the default) tracks the moving
+  edges sequentially, 0 uses vpParallel::getNumThreads() threads.
+
+  \note This function will set the new parameter for all the cameras. When
+  the cameras are processed concurrently, see setNbCameraThreads(), the
+  moving edges of each camera are tracked sequentially.
+
+  \sa vpMbEdgeTracker::setNbMovingEdgeThreads()
+*/
+void vpMbGenericTracker::setNbMovingEdgeThreads(unsigned int nbThreads)
+{
+  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
+       it != m_mapOfTrackers.end(); ++it) {
+    TrackerWrapper *tracker = it->second;
+    tracker->setNbMovingEdgeThreads(nbThreads);
+  }
+}
+
 /*!
   Set the near distance for clipping.
 
@@ -5194,28 +5453,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5276,28 +5514,7 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
-  for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
-       it != m_mapOfTrackers.end(); ++it) {
-    TrackerWrapper *tracker = it->second;
-
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
-    }
-
-    tracker->postTracking(mapOfImages[it->first], mapOfPointClouds[it->first]);
-
-    if (displayFeatures) {
-#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
-#endif
-
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
-    }
-  }
+  postTracking(mapOfImages, mapOfPointClouds);
 
   computeProjectionError();
 }
@@ -5356,29 +5573,71 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char
 
   testTracking();
 
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
+  computeProjectionError();
+}
+
+/*!
+  Realize the tracking of the object in the image.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfImages : Map of images.
+  \param mapOfPointClouds : Map of organized pointclouds, which can wrap the
+  buffers of the sensors without any copy.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<unsigned char> *> &mapOfImages,
+                               std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    if ((tracker->m_trackerType & (EDGE_TRACKER |
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                   KLT_TRACKER |
+#endif
+                                   DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
+      throw vpException(vpException::fatalError, "Bad tracker type: %d", tracker->m_trackerType);
     }
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
+    if (tracker->m_trackerType & (EDGE_TRACKER
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
+                                  | KLT_TRACKER
 #endif
+                                  ) &&
+        mapOfImages[it->first] == NULL) {
+      throw vpException(vpException::fatalError, "Image pointer is NULL!");
+    }
 
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
+    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) &&
+        (mapOfPointClouds[it->first] == NULL)) {
+      throw vpException(vpException::fatalError, "Pointcloud is NULL!");
     }
   }
 
+  preTracking(mapOfImages, mapOfPointClouds);
+
+  try {
+    computeVVS(mapOfImages);
+  } catch (...) {
+    covarianceMatrix = -1;
+    throw; // throw the original exception
+  }
+
+  testTracking();
+
+  std::map<std::string, unsigned int> mapOfPointCloudWidths, mapOfPointCloudHeights;
+  for (std::map<std::string, const vpPointCloud *>::const_iterator it = mapOfPointClouds.begin();
+       it != mapOfPointClouds.end(); ++it) {
+    if (it->second != NULL) {
+      mapOfPointCloudWidths[it->first] = it->second->getWidth();
+      mapOfPointCloudHeights[it->first] = it->second->getHeight();
+    }
+  }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
   computeProjectionError();
 }
 
@@ -5442,35 +5701,85 @@ void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &m
 
   testTracking();
 
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
+
+  computeProjectionError();
+}
+
+/*!
+  Realize the tracking of the object in the image.
+
+  \throw vpException : if the tracking is supposed to have failed
+
+  \param mapOfColorImages : Map of images.
+  \param mapOfPointClouds : Map of organized pointclouds, which can wrap the
+  buffers of the sensors without any copy.
+*/
+void vpMbGenericTracker::track(std::map<std::string, const vpImage<vpRGBa> *> &mapOfColorImages,
+                               std::map<std::string, const vpPointCloud *> &mapOfPointClouds)
+{
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
   for (std::map<std::string, TrackerWrapper *>::const_iterator it = m_mapOfTrackers.begin();
        it != m_mapOfTrackers.end(); ++it) {
     TrackerWrapper *tracker = it->second;
 
-    if (tracker->m_trackerType & EDGE_TRACKER && displayFeatures) {
-      tracker->m_featuresToBeDisplayedEdge = tracker->getFeaturesForDisplayEdge();
+    if ((tracker->m_trackerType & (EDGE_TRACKER |
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                   KLT_TRACKER |
+#endif
+                                   DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER)) == 0) {
+      throw vpException(vpException::fatalError, "Bad tracker type: %d", tracker->m_trackerType);
     }
 
-    tracker->postTracking(mapOfImages[it->first], mapOfPointCloudWidths[it->first], mapOfPointCloudHeights[it->first]);
-
-    if (displayFeatures) {
+    if (tracker->m_trackerType & (EDGE_TRACKER
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
-      if (tracker->m_trackerType & KLT_TRACKER) {
-        tracker->m_featuresToBeDisplayedKlt = tracker->getFeaturesForDisplayKlt();
-      }
+                                  | KLT_TRACKER
 #endif
+                                  ) && mapOfColorImages[it->first] == NULL) {
+      throw vpException(vpException::fatalError, "Image pointer is NULL!");
+    } else if (tracker->m_trackerType & (EDGE_TRACKER
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+                                  | KLT_TRACKER
+#endif
+                                  ) && mapOfColorImages[it->first] != NULL) {
+      vpImageConvert::convert(*mapOfColorImages[it->first], tracker->m_I);
+      mapOfImages[it->first] = &tracker->m_I; //update grayscale image buffer
+    }
 
-      if (tracker->m_trackerType & DEPTH_NORMAL_TRACKER) {
-        tracker->m_featuresToBeDisplayedDepthNormal = tracker->getFeaturesForDisplayDepthNormal();
-      }
+    if (tracker->m_trackerType & (DEPTH_NORMAL_TRACKER | DEPTH_DENSE_TRACKER) &&
+        (mapOfPointClouds[it->first] == NULL)) {
+      throw vpException(vpException::fatalError, "Pointcloud is NULL!");
+    }
+  }
+
+  preTracking(mapOfImages, mapOfPointClouds);
+
+  try {
+    computeVVS(mapOfImages);
+  } catch (...) {
+    covarianceMatrix = -1;
+    throw; // throw the original exception
+  }
+
+  testTracking();
+
+  std::map<std::string, unsigned int> mapOfPointCloudWidths, mapOfPointCloudHeights;
+  for (std::map<std::string, const vpPointCloud *>::const_iterator it = mapOfPointClouds.begin();
+       it != mapOfPointClouds.end(); ++it) {
+    if (it->second != NULL) {
+      mapOfPointCloudWidths[it->first] = it->second->getWidth();
+      mapOfPointCloudHeights[it->first] = it->second->getHeight();
     }
   }
+  postTracking(mapOfImages, mapOfPointCloudWidths, mapOfPointCloudHeights);
 
   computeProjectionError();
 }
 
 /** TrackerWrapper **/
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
-  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(EDGE_TRACKER), m_w(), m_weightedError(), m_preTrackingTime(0), m_vvsTime(0),
+    m_postTrackingTime(0)
 {
   m_lambda = 1.0;
   m_maxIter = 30;
@@ -5483,7 +5792,8 @@ vpMbGenericTracker::TrackerWrapper::TrackerWrapper()
 }
 
 vpMbGenericTracker::TrackerWrapper::TrackerWrapper(int trackerType)
-  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError()
+  : m_error(), m_L(), m_trackerType(trackerType), m_w(), m_weightedError(), m_preTrackingTime(0), m_vvsTime(0),
+    m_postTrackingTime(0)
 {
   if ((m_trackerType & (EDGE_TRACKER |
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
@@ -5685,11 +5995,11 @@ void vpMbGenericTracker::TrackerWrapper::computeVVS(const vpImage<unsigned char>
       }
 #endif
 
-      m_cMo = vpExponentialMap::direct(v).inverse() * m_cMo;
+      computeVVSPoseUpdate(v, m_cMo);
 
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
       if (m_trackerType & KLT_TRACKER) {
-        ctTc0 = vpExponentialMap::direct(v).inverse() * ctTc0;
+        computeVVSPoseUpdate(v, ctTc0);
       }
 #endif
       normRes_1 = normRes;
@@ -6310,6 +6620,7 @@ void vpMbGenericTracker::TrackerWrapper::loadConfigFile(const std::string &confi
   vpMe meParser;
   xmlp.getEdgeMe(meParser);
   vpMbEdgeTracker::setMovingEdge(meParser);
+  vpMbEdgeTracker::setNbMovingEdgeThreads(xmlp.getEdgeNbThreads());
 
 // KLT
 #if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
@@ -6519,6 +6830,48 @@ void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char
   }
 }
 
+void vpMbGenericTracker::TrackerWrapper::preTracking(const vpImage<unsigned char> *const ptr_I,
+                                                     const vpPointCloud *const point_cloud)
+{
+  if (m_trackerType & EDGE_TRACKER) {
+    try {
+      vpMbEdgeTracker::trackMovingEdge(*ptr_I);
+    } catch (...) {
+      std::cerr << "Error in moving edge tracking" << std::endl;
+      throw;
+    }
+  }
+
+#if defined(VISP_HAVE_MODULE_KLT) && (defined(VISP_HAVE_OPENCV) && (VISP_HAVE_OPENCV_VERSION >= 0x020100))
+  if (m_trackerType & KLT_TRACKER) {
+    try {
+      vpMbKltTracker::preTracking(*ptr_I);
+    } catch (const vpException &e) {
+      std::cerr << "Error in KLT tracking: " << e.what() << std::endl;
+      throw;
+    }
+  }
+#endif
+
+  if (m_trackerType & DEPTH_NORMAL_TRACKER) {
+    try {
+      vpMbDepthNormalTracker::segmentPointCloud(*point_cloud);
+    } catch (...) {
+      std::cerr << "Error in Depth tracking" << std::endl;
+      throw;
+    }
+  }
+
+  if (m_trackerType & DEPTH_DENSE_TRACKER) {
+    try {
+      vpMbDepthDenseTracker::segmentPointCloud(*point_cloud);
+    } catch (...) {
+      std::cerr << "Error in Depth dense tracking" << std::endl;
+      throw;
+    }
+  }
+}
+
 void vpMbGenericTracker::TrackerWrapper::reInitModel(const vpImage<unsigned char> * const I, const vpImage<vpRGBa> * const I_color,
                                                      const std::string &cad_name, const vpHomogeneousMatrix &cMo, bool verbose,
                                                      const vpHomogeneousMatrix &T)
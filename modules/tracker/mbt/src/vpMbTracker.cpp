@@ -50,7 +50,9 @@
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpDisplay.h>
 #include <visp3/core/vpMath.h>
+#include <visp3/core/vpExponentialMap.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/vision/vpPose.h>
 #ifdef VISP_HAVE_MODULE_GUI
@@ -129,6 +131,27 @@ struct PolygonFaceInfo {
   vpPolygon polygon;
   std::vector<vpPoint> faceCorners;
 };
+
+/*!
+  Velocity twist matrix cVo = [R [t]_x R; 0 R] of the pose cMo, without any
+  memory allocation.
+*/
+void computeVelocityTwist(const vpHomogeneousMatrix &cMo, vpMatrixFixed<6, 6> &cVo)
+{
+  const double *M = cMo.data;
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      cVo[i][j] = cVo[i + 3][j + 3] = M[4 * i + j];
+      cVo[i + 3][j] = 0.;
+    }
+  }
+  const double tx = M[3], ty = M[7], tz = M[11];
+  for (unsigned int j = 0; j < 3; j++) {
+    cVo[0][j + 3] = -tz * M[4 + j] + ty * M[8 + j];
+    cVo[1][j + 3] = tz * M[j] - tx * M[8 + j];
+    cVo[2][j + 3] = -ty * M[j] + tx * M[4 + j];
+  }
+}
 }
 #endif // DOXYGEN_SHOULD_SKIP_THIS
 
@@ -150,7 +173,8 @@ vpMbTracker::vpMbTracker()
     m_projectionErrorFaces(), m_projectionErrorOgreShowConfigDialog(false),
     m_projectionErrorMe(), m_projectionErrorKernelSize(2), m_SobelX(5,5), m_SobelY(5,5),
     m_projectionErrorDisplay(false), m_projectionErrorDisplayLength(20), m_projectionErrorDisplayThickness(1),
-    m_projectionErrorCam(), m_mask(NULL), m_I()
+    m_projectionErrorCam(), m_mask(NULL), m_I(), m_vvsWorkspace(), m_vvsLTLmuI(), m_vvsLTLPinv(), m_vvsVJ(),
+    m_vvsLVJ(), m_vvsLVJTLVJ(), m_vvsLVJTR(), m_vvsDeltaM()
 {
   oJo.eye();
   // Map used to parse additional information in CAO model files,
@@ -2927,62 +2951,173 @@ void vpMbTracker::computeVVSPoseEstimation(const bool isoJoIdentity_, unsigned i
                                            vpColVector &error_prev, vpColVector &LTR, double &mu, vpColVector &v,
                                            const vpColVector *const w, vpColVector *const m_w_prev)
 {
+  switch (m_optimizationMethod) {
+  case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
+    computeVVSVelocity(isoJoIdentity_, L, R, m_lambda, mu, LTL, LTR, v);
+
+    if (iter != 0)
+      mu /= 10.0;
+
+    error_prev = error;
+    if (w != NULL && m_w_prev != NULL)
+      *m_w_prev = *w;
+    break;
+  }
+
+  case vpMbTracker::GAUSS_NEWTON_OPT:
+  default:
+    computeVVSVelocity(isoJoIdentity_, L, R, m_lambda, 0., LTL, LTR, v);
+    break;
+  }
+}
+
+/*!
+  Estimate the velocity of an iteration of the virtual visual servoing as
+  computeVVSPoseEstimation(), but from the normal equations accumulated by the
+  caller.
+
+  \sa computeVVSVelocityFromNormalEquations()
+*/
+void vpMbTracker::computeVVSPoseEstimationFromNormalEquations(const bool isoJoIdentity_, unsigned int iter,
+                                                              const vpMatrix &LTL, const vpColVector &LTR,
+                                                              const vpColVector &error, vpColVector &error_prev,
+                                                              double &mu, vpColVector &v)
+{
+  switch (m_optimizationMethod) {
+  case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
+    computeVVSVelocityFromNormalEquations(isoJoIdentity_, LTL, LTR, m_lambda, mu, v);
+
+    if (iter != 0)
+      mu /= 10.0;
+
+    error_prev = error;
+    break;
+  }
+
+  case vpMbTracker::GAUSS_NEWTON_OPT:
+  default:
+    computeVVSVelocityFromNormalEquations(isoJoIdentity_, LTL, LTR, m_lambda, 0., v);
+    break;
+  }
+}
+
+/*!
+  Compute the velocity of an iteration of the virtual visual servoing, such as
+  \f$ {\bf v} = -\lambda ({\bf L}^T {\bf L} + \mu {\bf I})^+ {\bf L}^T {\bf
+  R} \f$ where \f$ \bf L \f$ is the weighted interaction matrix, multiplied by
+  the velocity twist matrix cVo and oJo when some degrees of freedom are not
+  estimated.
+
+  All the temporaries are members of the class or live on the stack, so that
+  the iterations do not allocate memory once the sizes are stable.
+
+  \param isoJoIdentity_ : True if all the degrees of freedom are estimated.
+  \param L : Weighted interaction matrix.
+  \param R : Weighted residual.
+  \param gain : Gain \f$ \lambda \f$.
+  \param mu : Damping factor \f$ \mu \f$, 0 for a Gauss-Newton iteration.
+  \param LTL : \f$ {\bf L}^T {\bf L} \f$, only updated if \e isoJoIdentity_
+  is true.
+  \param LTR : \f$ {\bf L}^T {\bf R} \f$, only updated if \e isoJoIdentity_
+  is true.
+  \param v : Resulting velocity.
+*/
+void vpMbTracker::computeVVSVelocity(bool isoJoIdentity_, const vpMatrix &L, const vpColVector &R, double gain,
+                                     double mu, vpMatrix &LTL, vpColVector &LTR, vpColVector &v)
+{
+  vpMatrixFixed<6, 6> cVo;
+  const vpMatrix *normal = &LTL;
+  const vpColVector *gradient = &LTR;
+
   if (isoJoIdentity_) {
-    LTL = L.AtA();
+    L.AtA(LTL);
     computeJTR(L, R, LTR);
+  } else {
+    computeVelocityTwist(m_cMo, cVo);
 
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LTL.getRows(), LTL.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LTL + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
+    (cVo * vpMatrixFixed<6, 6>(oJo)).copyTo(m_vvsVJ);
+    vpMatrix::mult2Matrices(L, m_vvsVJ, m_vvsLVJ);
+    m_vvsLVJ.AtA(m_vvsLVJTLVJ);
+    computeJTR(m_vvsLVJ, R, m_vvsLVJTR);
+    normal = &m_vvsLVJTLVJ;
+    gradient = &m_vvsLVJTR;
+  }
 
-      if (iter != 0)
-        mu /= 10.0;
+  solveVVSVelocity(*normal, *gradient, gain, mu, v);
 
-      error_prev = error;
-      if (w != NULL && m_w_prev != NULL)
-        *m_w_prev = *w;
-      break;
-    }
+  if (!isoJoIdentity_) {
+    const vpMatrixFixed<6, 1> v_o(v.data);
+    (cVo * v_o).copyTo(v.data);
+  }
+}
 
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LTL.pseudoInverse(LTL.getRows() * std::numeric_limits<double>::epsilon()) * LTR;
-      break;
-    }
-  } else {
-    vpVelocityTwistMatrix cVo;
-    cVo.buildFrom(m_cMo);
-    vpMatrix LVJ = (L * (cVo * oJo));
-    vpMatrix LVJTLVJ = (LVJ).AtA();
-    vpColVector LVJTR;
-    computeJTR(LVJ, R, LVJTR);
-
-    switch (m_optimizationMethod) {
-    case vpMbTracker::LEVENBERG_MARQUARDT_OPT: {
-      vpMatrix LMA(LVJTLVJ.getRows(), LVJTLVJ.getCols());
-      LMA.eye();
-      vpMatrix LTLmuI = LVJTLVJ + (LMA * mu);
-      v = -m_lambda * LTLmuI.pseudoInverse(LTLmuI.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-
-      if (iter != 0)
-        mu /= 10.0;
-
-      error_prev = error;
-      if (w != NULL && m_w_prev != NULL)
-        *m_w_prev = *w;
-      break;
-    }
-    case vpMbTracker::GAUSS_NEWTON_OPT:
-    default:
-      v = -m_lambda * LVJTLVJ.pseudoInverse(LVJTLVJ.getRows() * std::numeric_limits<double>::epsilon()) * LVJTR;
-      v = cVo * v;
-      break;
-    }
+/*!
+  Compute the velocity of an iteration of the virtual visual servoing as
+  computeVVSVelocity(), but from the normal equations \f$ {\bf L}^T {\bf L}
+  \f$ and \f$ {\bf L}^T {\bf R} \f$ accumulated by the caller, so that the
+  weighted interaction matrix does not need to be stored.
+
+  \param isoJoIdentity_ : True if all the degrees of freedom are estimated.
+  \param LTL : \f$ {\bf L}^T {\bf L} \f$ computed from the weighted
+  interaction matrix.
+  \param LTR : \f$ {\bf L}^T {\bf R} \f$ computed from the weighted
+  interaction matrix and residual.
+  \param gain : Gain \f$ \lambda \f$.
+  \param mu : Damping factor \f$ \mu \f$, 0 for a Gauss-Newton iteration.
+  \param v : Resulting velocity.
+*/
+void vpMbTracker::computeVVSVelocityFromNormalEquations(bool isoJoIdentity_, const vpMatrix &LTL,
+                                                        const vpColVector &LTR, double gain, double mu,
+                                                        vpColVector &v)
+{
+  if (isoJoIdentity_) {
+    solveVVSVelocity(LTL, LTR, gain, mu, v);
+    return;
   }
+
+  // (L V J)^T (L V J) = (V J)^T L^T L (V J)
+  vpMatrixFixed<6, 6> cVo;
+  computeVelocityTwist(m_cMo, cVo);
+  const vpMatrixFixed<6, 6> VJ = cVo * vpMatrixFixed<6, 6>(oJo);
+  const vpMatrixFixed<6, 6> VJt = VJ.t();
+  (VJt * vpMatrixFixed<6, 6>(LTL) * VJ).copyTo(m_vvsLVJTLVJ);
+  m_vvsLVJTR.resize(6, false);
+  (VJt * vpMatrixFixed<6, 1>(LTR.data)).copyTo(m_vvsLVJTR.data);
+
+  solveVVSVelocity(m_vvsLVJTLVJ, m_vvsLVJTR, gain, mu, v);
+
+  const vpMatrixFixed<6, 1> v_o(v.data);
+  (cVo * v_o).copyTo(v.data);
+}
+
+/*!
+  Compute the velocity \f$ {\bf v} = -\lambda ({\bf N} + \mu {\bf I})^+
+  {\bf g} \f$ from the normal matrix \e normal and the gradient \e gradient.
+*/
+void vpMbTracker::solveVVSVelocity(const vpMatrix &normal, const vpColVector &gradient, double gain, double mu,
+                                   vpColVector &v)
+{
+  m_vvsLTLmuI = normal;
+  for (unsigned int i = 0; i < m_vvsLTLmuI.getRows(); i++) {
+    m_vvsLTLmuI[i][i] += mu;
+  }
+  m_vvsLTLmuI.pseudoInverse(m_vvsLTLPinv, m_vvsWorkspace,
+                            m_vvsLTLmuI.getRows() * std::numeric_limits<double>::epsilon());
+
+  vpMatrix::multMatrixVector(m_vvsLTLPinv, gradient, v);
+  v *= -gain;
+}
+
+/*!
+  Update the pose \e M with the velocity \e v estimated by an iteration of the
+  virtual visual servoing, such as \f$ {\bf M} = \exp({\bf v})^{-1} {\bf M}
+  \f$, without any memory allocation.
+*/
+void vpMbTracker::computeVVSPoseUpdate(const vpColVector &v, vpHomogeneousMatrix &M)
+{
+  vpExponentialMap::direct(v, 1.0, m_vvsDeltaM);
+  m_vvsDeltaM.inverse(m_vvsDeltaM);
+  (vpMatrixFixed<4, 4>(m_vvsDeltaM.data) * vpMatrixFixed<4, 4>(M.data)).copyTo(M.data);
 }
 
 void vpMbTracker::computeVVSWeights(vpRobust &robust, const vpColVector &error, vpColVector &w)
@@ -58,7 +58,7 @@ public:
         //<lod>
         m_useLod(false), m_minLineLengthThreshold(50.0), m_minPolygonAreaThreshold(2500.0),
         //<ecm>
-        m_ecm(),
+        m_ecm(), m_edgeNbThreads(1),
         //<klt>
         m_kltMaskBorder(0), m_kltMaxFeatures(0), m_kltWinSize(0), m_kltQualityValue(0.), m_kltMinDist(0.),
         m_kltHarrisParam(0.), m_kltBlockSize(0), m_kltPyramidLevels(0),
@@ -198,6 +198,7 @@ public:
         std::cout << "ecm : contrast : mu1 : " << m_ecm.getMu1() << " (default)" << std::endl;
         std::cout << "ecm : contrast : mu2 : " << m_ecm.getMu2() << " (default)" << std::endl;
         std::cout << "ecm : sample : sample_step : " << m_ecm.getSampleStep() << " (default)" << std::endl;
+        std::cout << "ecm : nb_threads : " << m_edgeNbThreads << " (default)" << std::endl;
       }
 
       if (!klt_node && (m_parserType & KLT_PARSER)) {
@@ -553,6 +554,7 @@ public:
     bool range_node = false;
     bool contrast_node = false;
     bool sample_node = false;
+    bool nb_threads_node = false;
 
     for (pugi::xml_node dataNode = node.first_child(); dataNode; dataNode = dataNode.next_sibling()) {
       if (dataNode.type() == pugi::node_element) {
@@ -579,6 +581,11 @@ public:
             sample_node = true;
             break;
 
+          case nb_threads:
+            m_edgeNbThreads = dataNode.text().as_uint();
+            nb_threads_node = true;
+            break;
+
           default:
             break;
           }
@@ -604,6 +611,11 @@ public:
     if (!sample_node) {
       std::cout << "ecm : sample : sample_step : " << m_ecm.getSampleStep() << " (default)" << std::endl;
     }
+
+    if (!nb_threads_node)
+      std::cout << "ecm : nb_threads : " << m_edgeNbThreads << " (default)" << std::endl;
+    else
+      std::cout << "ecm : nb_threads : " << m_edgeNbThreads << std::endl;
   }
 
   /*!
@@ -1148,6 +1160,7 @@ public:
   void getCameraParameters(vpCameraParameters &cam) const { cam = m_cam; }
 
   void getEdgeMe(vpMe &moving_edge) const { moving_edge = m_ecm; }
+  unsigned int getEdgeNbThreads() const { return m_edgeNbThreads; }
 
   unsigned int getDepthDenseSamplingStepX() const { return m_depthDenseSamplingStepX; }
   unsigned int getDepthDenseSamplingStepY() const { return m_depthDenseSamplingStepY; }
@@ -1219,6 +1232,7 @@ public:
   void setDepthNormalSamplingStepY(unsigned int stepY) { m_depthNormalSamplingStepY = stepY; }
 
   void setEdgeMe(const vpMe &moving_edge) { m_ecm = moving_edge; }
+  void setEdgeNbThreads(unsigned int nbThreads) { m_edgeNbThreads = nbThreads; }
 
   void setFarClippingDistance(const double &fclip) { m_farClipping = fclip; }
 
@@ -1265,6 +1279,8 @@ protected:
   // Edge
   //! Moving edges parameters.
   vpMe m_ecm;
+  //! Number of threads used to track the moving edges
+  unsigned int m_edgeNbThreads;
   // KLT
   //! Border of the mask used on Klt points
   unsigned int m_kltMaskBorder;
@@ -1342,6 +1358,7 @@ protected:
     mu2,
     sample,
     step,
+    nb_threads,
     //<klt>
     klt,
     mask_border,
@@ -1413,6 +1430,7 @@ protected:
     m_nodeMap["mu2"] = mu2;
     m_nodeMap["sample"] = sample;
     m_nodeMap["step"] = step;
+    m_nodeMap["nb_threads"] = nb_threads;
     //<klt>
     m_nodeMap["klt"] = klt;
     m_nodeMap["mask_border"] = mask_border;
@@ -1501,6 +1519,16 @@ void vpMbtXmlGenericParser::getEdgeMe(vpMe &ecm) const
   m_impl->getEdgeMe(ecm);
 }
 
+/*!
+  Get the number of threads used to track the moving edges.
+
+  \sa vpMbEdgeTracker::setNbMovingEdgeThreads()
+*/
+unsigned int vpMbtXmlGenericParser::getEdgeNbThreads() const
+{
+  return m_impl->getEdgeNbThreads();
+}
+
 /*!
   Get depth dense sampling step in X.
 */
@@ -1830,6 +1858,19 @@ void vpMbtXmlGenericParser::setEdgeMe(const vpMe &ecm)
   m_impl->setEdgeMe(ecm);
 }
 
+/*!
+  Set the number of threads used to track the moving edges.
+
+  \param nbThreads : Number of threads, 0 to use vpParallel::getNumThreads()
+  threads.
+
+  \sa vpMbEdgeTracker::setNbMovingEdgeThreads()
+*/
+void vpMbtXmlGenericParser::setEdgeNbThreads(unsigned int nbThreads)
+{
+  m_impl->setEdgeNbThreads(nbThreads);
+}
+
 /*!
   Set the far clipping distance.
 
@@ -0,0 +1,558 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * Description:
+ * Test the depth trackers on a synthetic point cloud of a cube.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testGenericTrackerDepthSynthetic.cpp
+
+  \brief Track a cube in a synthetic point cloud with the depth trackers and
+  check that the different point cloud inputs give the same pose, that the
+  depth and stereo edge cameras processed concurrently give the same pose as
+  sequentially, that the normal equations of the dense depth faces give the
+  same pose as the stacked interaction matrix, and that the moving edges tracked concurrently
+  give the same pose and the same sites as sequentially.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && defined(VISP_HAVE_MODULE_MBT) &&                                                     \
+    (defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_EIGEN3) || defined(VISP_HAVE_OPENCV))
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+#include <visp3/core/vpIoTools.h>
+#include <visp3/core/vpParallel.h>
+#include <visp3/core/vpPointCloud.h>
+#include <visp3/mbt/vpMbDepthDenseTracker.h>
+#include <visp3/mbt/vpMbEdgeTracker.h>
+#include <visp3/mbt/vpMbGenericTracker.h>
+#include <visp3/mbt/vpMbtDistanceLine.h>
+
+namespace
+{
+const unsigned int height = 240, width = 320;
+const double side = 0.1;
+const std::string model_filename = "testGenericTrackerDepthSynthetic_cube.cao";
+
+void writeModel()
+{
+  std::ofstream file(model_filename.c_str());
+  file << "V1\n8\n";
+  file << "0 0 0\n" << -side << " 0 0\n" << -side << " " << side << " 0\n" << "0 " << side << " 0\n";
+  file << "0 0 " << side << "\n" << -side << " 0 " << side << "\n" << -side << " " << side << " " << side << "\n";
+  file << "0 " << side << " " << side << "\n";
+  file << "0\n0\n6\n4 0 4 5 1\n4 1 5 6 2\n4 6 7 3 2\n4 3 7 4 0\n4 0 1 2 3\n4 7 6 5 4\n0\n0\n";
+}
+
+vpCameraParameters camera() { return vpCameraParameters(300, 300, width / 2.0, height / 2.0); }
+
+// Ground truth pose: the cube at 0.45 m, three faces being visible
+vpHomogeneousMatrix truePose()
+{
+  vpHomogeneousMatrix cRo(0, 0, 0, vpMath::rad(35), vpMath::rad(-40), vpMath::rad(15));
+  vpColVector center(4);
+  center[0] = -side / 2;
+  center[1] = side / 2;
+  center[2] = side / 2;
+  center[3] = 1;
+  vpColVector c = cRo * center;
+  return vpHomogeneousMatrix(-c[0], -c[1], 0.45 - c[2], 0, 0, 0) * cRo;
+}
+
+// Cast the ray of the pixel (i, j) on the cube. Return false if the ray does
+// not hit the cube, otherwise the depth of the hit point and the axis of the
+// normal of the face that is hit.
+bool castRay(const vpHomogeneousMatrix &oMc, unsigned int i, unsigned int j, double dc[3], double &t,
+             unsigned int &axis)
+{
+  const vpCameraParameters cam = camera();
+  const double lower[3] = {-side, 0, 0}, upper[3] = {0, side, side};
+
+  dc[0] = (j - cam.get_u0()) / cam.get_px();
+  dc[1] = (i - cam.get_v0()) / cam.get_py();
+  dc[2] = 1;
+  double t_min = 0, t_max = std::numeric_limits<double>::max();
+  axis = 0;
+  for (unsigned int k = 0; k < 3; k++) {
+    const double o = oMc[k][3];
+    const double d = oMc[k][0] * dc[0] + oMc[k][1] * dc[1] + oMc[k][2] * dc[2];
+    if (std::fabs(d) < std::numeric_limits<double>::epsilon()) {
+      if (o < lower[k] || o > upper[k]) {
+        t_max = -1;
+      }
+    } else {
+      const double t1 = (lower[k] - o) / d, t2 = (upper[k] - o) / d;
+      if (std::min(t1, t2) > t_min) {
+        t_min = std::min(t1, t2);
+        axis = k;
+      }
+      t_max = std::min(t_max, std::max(t1, t2));
+    }
+  }
+
+  t = t_min;
+  return t_max >= t_min && t_min > 0;
+}
+
+// Cast the ray of each pixel on the cube, the invalid points having a null depth
+void renderPointCloud(const vpHomogeneousMatrix &cMo, std::vector<vpColVector> &point_cloud)
+{
+  const vpHomogeneousMatrix oMc = cMo.inverse();
+
+  point_cloud.resize(height * width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double dc[3], t_min;
+      unsigned int axis;
+      const bool hit = castRay(oMc, i, j, dc, t_min, axis);
+
+      vpColVector &p = point_cloud[i * width + j];
+      p.resize(4, true);
+      p[3] = 1;
+      if (hit) {
+        // Depth stored as a float, as given by the sensors
+        p[0] = static_cast<float>(t_min * dc[0]);
+        p[1] = static_cast<float>(t_min * dc[1]);
+        p[2] = static_cast<float>(t_min);
+      }
+    }
+  }
+}
+
+// Render the cube with a uniform intensity per face orientation on a dark
+// background
+void renderImage(const vpHomogeneousMatrix &cMo, vpImage<unsigned char> &I)
+{
+  const vpHomogeneousMatrix oMc = cMo.inverse();
+
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      double dc[3], t;
+      unsigned int axis;
+      I[i][j] = castRay(oMc, i, j, dc, t, axis) ? static_cast<unsigned char>(100 + 60 * axis) : 20;
+    }
+  }
+}
+
+void initTracker(vpMbGenericTracker &tracker, const vpHomogeneousMatrix &cMo)
+{
+  tracker.setCameraParameters(camera());
+  tracker.setDepthDenseSamplingStep(2, 2);
+  tracker.setDepthNormalSamplingStep(2, 2);
+  tracker.loadModel(model_filename);
+  tracker.initFromPose(vpImage<unsigned char>(height, width), cMo);
+}
+
+double translationError(const vpHomogeneousMatrix &cMo, const vpHomogeneousMatrix &cMo_truth)
+{
+  return (cMo.getTranslationVector() - cMo_truth.getTranslationVector()).frobeniusNorm();
+}
+
+// Position and state of the moving edges sites of the tracked lines
+std::vector<int> movingEdgeSites(const std::list<vpMbtDistanceLine *> &lines)
+{
+  std::vector<int> sites;
+  for (std::list<vpMbtDistanceLine *>::const_iterator it = lines.begin(); it != lines.end(); ++it) {
+    if (!(*it)->isVisible() || !(*it)->isTracked()) {
+      continue;
+    }
+    for (size_t k = 0; k < (*it)->meline.size(); k++) {
+      const std::vector<vpMeSite> &meSites = (*it)->meline[k]->getMeSites();
+      for (size_t l = 0; l < meSites.size(); l++) {
+        sites.push_back(meSites[l].get_i());
+        sites.push_back(meSites[l].get_j());
+        sites.push_back(meSites[l].getState());
+      }
+    }
+  }
+  return sites;
+}
+
+std::vector<int> movingEdgeSites(const vpMbEdgeTracker &tracker)
+{
+  std::list<vpMbtDistanceLine *> lines;
+  tracker.getLline(lines);
+  return movingEdgeSites(lines);
+}
+} // namespace
+
+TEST_CASE("Point cloud inputs of the depth trackers", "[mbt][depth]")
+{
+  const vpHomogeneousMatrix cMo_truth = truePose();
+  const vpHomogeneousMatrix cMo_init =
+      vpHomogeneousMatrix(0.01, -0.008, 0.012, vpMath::rad(2), vpMath::rad(-1), vpMath::rad(3)) * cMo_truth;
+
+  std::vector<vpColVector> point_cloud;
+  renderPointCloud(cMo_truth, point_cloud);
+  vpPointCloud cloud;
+  cloud.buildFrom(point_cloud, height, width);
+
+  const int types[] = {vpMbGenericTracker::DEPTH_DENSE_TRACKER, vpMbGenericTracker::DEPTH_NORMAL_TRACKER};
+  for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); t++) {
+    vpMbGenericTracker tracker_vector(1, types[t]), tracker_cloud(1, types[t]);
+    initTracker(tracker_vector, cMo_init);
+    initTracker(tracker_cloud, cMo_init);
+
+    std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+    std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+    std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+    std::map<std::string, const vpPointCloud *> mapOfClouds;
+    mapOfImages["Camera"] = NULL;
+    mapOfPointClouds["Camera"] = &point_cloud;
+    mapOfWidths["Camera"] = width;
+    mapOfHeights["Camera"] = height;
+    mapOfClouds["Camera"] = &cloud;
+
+    for (int iter = 0; iter < 5; iter++) {
+      tracker_vector.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+      tracker_cloud.track(mapOfImages, mapOfClouds);
+    }
+
+    INFO("Tracker type: " << types[t]);
+    const vpHomogeneousMatrix cMo_vector = tracker_vector.getPose(), cMo_cloud = tracker_cloud.getPose();
+    CHECK(translationError(cMo_vector, cMo_truth) < 1e-3);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        CHECK(cMo_cloud[i][j] == Approx(cMo_vector[i][j]).margin(1e-9));
+      }
+    }
+  }
+}
+
+TEST_CASE("Cameras processed concurrently", "[mbt][depth][parallel]")
+{
+  const vpHomogeneousMatrix cMo_truth = truePose();
+  const vpHomogeneousMatrix cMo_init =
+      vpHomogeneousMatrix(0.008, 0.01, -0.01, vpMath::rad(-2), vpMath::rad(3), vpMath::rad(1)) * cMo_truth;
+
+  std::vector<std::string> cameraNames;
+  cameraNames.push_back("Camera1");
+  cameraNames.push_back("Camera2");
+  cameraNames.push_back("Camera3");
+  std::vector<int> trackerTypes;
+  trackerTypes.push_back(vpMbGenericTracker::DEPTH_DENSE_TRACKER);
+  trackerTypes.push_back(vpMbGenericTracker::DEPTH_NORMAL_TRACKER);
+  trackerTypes.push_back(vpMbGenericTracker::DEPTH_DENSE_TRACKER | vpMbGenericTracker::DEPTH_NORMAL_TRACKER);
+
+  // Transformations from the reference camera to the other cameras
+  std::map<std::string, vpHomogeneousMatrix> mapOfCameraTransformations;
+  mapOfCameraTransformations["Camera1"] = vpHomogeneousMatrix();
+  mapOfCameraTransformations["Camera2"] = vpHomogeneousMatrix(0.04, 0, 0, 0, vpMath::rad(-5), 0);
+  mapOfCameraTransformations["Camera3"] = vpHomogeneousMatrix(0, -0.03, 0.02, vpMath::rad(4), 0, 0);
+
+  std::map<std::string, std::vector<vpColVector> > mapOfRenderedPointClouds;
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  std::map<std::string, const std::vector<vpColVector> *> mapOfPointClouds;
+  std::map<std::string, unsigned int> mapOfWidths, mapOfHeights;
+  std::map<std::string, vpHomogeneousMatrix> mapOfInitPoses;
+  const vpImage<unsigned char> I(height, width);
+  for (size_t i = 0; i < cameraNames.size(); i++) {
+    const std::string &name = cameraNames[i];
+    renderPointCloud(mapOfCameraTransformations[name] * cMo_truth, mapOfRenderedPointClouds[name]);
+    mapOfImages[name] = &I;
+    mapOfPointClouds[name] = &mapOfRenderedPointClouds[name];
+    mapOfWidths[name] = width;
+    mapOfHeights[name] = height;
+    mapOfInitPoses[name] = mapOfCameraTransformations[name] * cMo_init;
+  }
+
+  // Make sure that the pool has several threads, even on a single core
+  vpParallel::setNumThreads(3);
+
+  vpHomogeneousMatrix cMo_sequential;
+  const unsigned int nbThreads[] = {1, 3};
+  for (size_t t = 0; t < sizeof(nbThreads) / sizeof(nbThreads[0]); t++) {
+    vpMbGenericTracker tracker(cameraNames, trackerTypes);
+    tracker.setCameraParameters(camera());
+    tracker.setCameraTransformationMatrix(mapOfCameraTransformations);
+    tracker.setDepthDenseSamplingStep(2, 2);
+    tracker.setDepthNormalSamplingStep(2, 2);
+    tracker.loadModel(model_filename);
+    tracker.initFromPose(mapOfImages, mapOfInitPoses);
+    tracker.setNbCameraThreads(nbThreads[t]);
+    CHECK(tracker.getNbCameraThreads() == nbThreads[t]);
+
+    for (int iter = 0; iter < 5; iter++) {
+      tracker.track(mapOfImages, mapOfPointClouds, mapOfWidths, mapOfHeights);
+    }
+
+    const vpHomogeneousMatrix cMo = tracker.getPose();
+    INFO("Number of threads: " << nbThreads[t]);
+    CHECK(translationError(cMo, cMo_truth) < 1e-3);
+    if (t == 0) {
+      cMo_sequential = cMo;
+    } else {
+      // The stacking order of the cameras does not depend on the threads
+      for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 4; j++) {
+          CHECK(cMo[i][j] == cMo_sequential[i][j]);
+        }
+      }
+    }
+
+    std::map<std::string, double> mapOfPreTrackingTimes, mapOfVVSTimes, mapOfPostTrackingTimes;
+    tracker.getTrackingTimes(mapOfPreTrackingTimes, mapOfVVSTimes, mapOfPostTrackingTimes);
+    REQUIRE(mapOfPreTrackingTimes.size() == cameraNames.size());
+    for (size_t i = 0; i < cameraNames.size(); i++) {
+      CHECK(mapOfPreTrackingTimes[cameraNames[i]] >= 0);
+      CHECK(mapOfVVSTimes[cameraNames[i]] >= 0);
+      CHECK(mapOfPostTrackingTimes[cameraNames[i]] >= 0);
+    }
+  }
+
+  vpParallel::setNumThreads(0);
+}
+
+TEST_CASE("Stereo edge cameras processed concurrently", "[mbt][edge][parallel]")
+{
+  const vpHomogeneousMatrix cMo_truth = truePose();
+  const vpHomogeneousMatrix cMo_init =
+      vpHomogeneousMatrix(0.003, 0.002, -0.003, vpMath::rad(-1), vpMath::rad(1), vpMath::rad(1)) * cMo_truth;
+
+  std::vector<std::string> cameraNames;
+  cameraNames.push_back("Camera1");
+  cameraNames.push_back("Camera2");
+
+  std::map<std::string, vpHomogeneousMatrix> mapOfCameraTransformations;
+  mapOfCameraTransformations["Camera1"] = vpHomogeneousMatrix();
+  mapOfCameraTransformations["Camera2"] = vpHomogeneousMatrix(0.03, 0, 0, 0, vpMath::rad(-4), 0);
+
+  std::map<std::string, vpImage<unsigned char> > mapOfRenderedImages;
+  std::map<std::string, const vpImage<unsigned char> *> mapOfImages;
+  std::map<std::string, vpHomogeneousMatrix> mapOfInitPoses;
+  for (size_t i = 0; i < cameraNames.size(); i++) {
+    const std::string &name = cameraNames[i];
+    renderImage(mapOfCameraTransformations[name] * cMo_truth, mapOfRenderedImages[name]);
+    mapOfImages[name] = &mapOfRenderedImages[name];
+    mapOfInitPoses[name] = mapOfCameraTransformations[name] * cMo_init;
+  }
+
+  vpMe me;
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+  me.setRange(8);
+  me.setThreshold(1000);
+  me.setMu1(0.5);
+  me.setMu2(0.5);
+  me.setSampleStep(4);
+
+  // Make sure that the pool has several threads, even on a single core
+  vpParallel::setNumThreads(2);
+
+  vpHomogeneousMatrix cMo_sequential;
+  std::vector<int> sites_sequential[2];
+  const unsigned int nbThreads[] = {1, 2};
+  for (size_t t = 0; t < sizeof(nbThreads) / sizeof(nbThreads[0]); t++) {
+    vpMbGenericTracker tracker(cameraNames, std::vector<int>(2, vpMbGenericTracker::EDGE_TRACKER));
+    tracker.setCameraParameters(camera(), camera());
+    tracker.setCameraTransformationMatrix(mapOfCameraTransformations);
+    tracker.setMovingEdge(me);
+    tracker.loadModel(model_filename);
+    tracker.initFromPose(mapOfImages, mapOfInitPoses);
+    tracker.setNbCameraThreads(nbThreads[t]);
+    CHECK(tracker.getNbCameraThreads() == nbThreads[t]);
+
+    for (int iter = 0; iter < 5; iter++) {
+      tracker.track(mapOfImages);
+    }
+
+    const vpHomogeneousMatrix cMo = tracker.getPose();
+    INFO("Number of threads: " << nbThreads[t]);
+    CHECK(translationError(cMo, cMo_truth) < 5e-3);
+    for (size_t i = 0; i < cameraNames.size(); i++) {
+      std::list<vpMbtDistanceLine *> lines;
+      tracker.getLline(cameraNames[i], lines);
+      const std::vector<int> sites = movingEdgeSites(lines);
+      if (t == 0) {
+        sites_sequential[i] = sites;
+        CHECK(!sites.empty());
+      } else {
+        CHECK(sites == sites_sequential[i]);
+      }
+    }
+    if (t == 0) {
+      cMo_sequential = cMo;
+    } else {
+      // Same moving edges, the poses may only differ by the rounding of the
+      // BLAS products
+      for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 4; j++) {
+          CHECK(cMo[i][j] == Approx(cMo_sequential[i][j]).margin(1e-9));
+        }
+      }
+    }
+  }
+
+  vpParallel::setNumThreads(0);
+}
+
+TEST_CASE("Normal equations of the dense depth faces", "[mbt][depth][parallel]")
+{
+  const vpHomogeneousMatrix cMo_truth = truePose();
+  const vpHomogeneousMatrix cMo_init =
+      vpHomogeneousMatrix(-0.01, 0.006, 0.01, vpMath::rad(3), vpMath::rad(2), vpMath::rad(-2)) * cMo_truth;
+
+  std::vector<vpColVector> point_cloud;
+  renderPointCloud(cMo_truth, point_cloud);
+
+  // Make sure that the pool has several threads, even on a single core
+  vpParallel::setNumThreads(3);
+
+  const vpMbTracker::vpMbtOptimizationMethod methods[] = {vpMbTracker::GAUSS_NEWTON_OPT,
+                                                          vpMbTracker::LEVENBERG_MARQUARDT_OPT};
+  for (size_t m = 0; m < sizeof(methods) / sizeof(methods[0]); m++) {
+    vpMbDepthDenseTracker tracker_stacked, tracker_normal;
+    vpMbDepthDenseTracker *trackers[] = {&tracker_stacked, &tracker_normal};
+    for (size_t k = 0; k < 2; k++) {
+      trackers[k]->setCameraParameters(camera());
+      trackers[k]->setDepthDenseSamplingStep(2, 2);
+      trackers[k]->setOptimizationMethod(methods[m]);
+      trackers[k]->loadModel(model_filename);
+      trackers[k]->initFromPose(vpImage<unsigned char>(height, width), cMo_init);
+    }
+    tracker_normal.setUseDepthDenseNormalEquations(true);
+    CHECK(tracker_normal.getUseDepthDenseNormalEquations());
+    CHECK(!tracker_stacked.getUseDepthDenseNormalEquations());
+
+    // The damping of Levenberg-Marquardt slows down the convergence
+    for (int iter = 0; iter < 15; iter++) {
+      tracker_stacked.track(point_cloud, width, height);
+      tracker_normal.track(point_cloud, width, height);
+    }
+
+    INFO("Optimization method: " << methods[m]);
+    const vpHomogeneousMatrix cMo_stacked = tracker_stacked.getPose(), cMo_normal = tracker_normal.getPose();
+    CHECK(translationError(cMo_normal, cMo_truth) < 1e-3);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 4; j++) {
+        CHECK(cMo_normal[i][j] == Approx(cMo_stacked[i][j]).margin(1e-9));
+      }
+    }
+  }
+
+  vpParallel::setNumThreads(0);
+}
+
+TEST_CASE("Moving edges tracked concurrently", "[mbt][edge][parallel]")
+{
+  const vpHomogeneousMatrix cMo_truth = truePose();
+  const vpHomogeneousMatrix cMo_init =
+      vpHomogeneousMatrix(0.003, -0.002, 0.004, vpMath::rad(1), vpMath::rad(-1), vpMath::rad(1)) * cMo_truth;
+
+  vpImage<unsigned char> I;
+  renderImage(cMo_truth, I);
+
+  vpMe me;
+  me.setMaskSize(5);
+  me.setMaskNumber(180);
+  me.setRange(8);
+  me.setThreshold(1000);
+  me.setMu1(0.5);
+  me.setMu2(0.5);
+  me.setSampleStep(4);
+
+  // Make sure that the pool has several threads, even on a single core
+  vpParallel::setNumThreads(4);
+
+  vpHomogeneousMatrix cMo_sequential;
+  unsigned int nbPoints_sequential = 0;
+  std::vector<int> sites_sequential;
+  const unsigned int nbThreads[] = {1, 4};
+  for (size_t t = 0; t < sizeof(nbThreads) / sizeof(nbThreads[0]); t++) {
+    vpMbEdgeTracker tracker;
+    tracker.setCameraParameters(camera());
+    tracker.setMovingEdge(me);
+    tracker.loadModel(model_filename);
+    tracker.initFromPose(I, cMo_init);
+    tracker.setNbMovingEdgeThreads(nbThreads[t]);
+    CHECK(tracker.getNbMovingEdgeThreads() == nbThreads[t]);
+
+    for (int iter = 0; iter < 5; iter++) {
+      tracker.track(I);
+    }
+
+    const vpHomogeneousMatrix cMo = tracker.getPose();
+    INFO("Number of threads: " << nbThreads[t]);
+    CHECK(tracker.getNbPoints() > 0);
+    // The depth of the cube is less accurate from its edges than from its
+    // point cloud
+    CHECK(translationError(cMo, cMo_truth) < 5e-3);
+    if (t == 0) {
+      cMo_sequential = cMo;
+      nbPoints_sequential = tracker.getNbPoints();
+      sites_sequential = movingEdgeSites(tracker);
+      CHECK(!sites_sequential.empty());
+    } else {
+      // Each feature is tracked by a single thread, thus the same moving
+      // edges are found. The poses may only differ by the rounding of the
+      // BLAS products, that depends on the alignment of the matrices.
+      CHECK(tracker.getNbPoints() == nbPoints_sequential);
+      CHECK(movingEdgeSites(tracker) == sites_sequential);
+      for (unsigned int i = 0; i < 3; i++) {
+        for (unsigned int j = 0; j < 4; j++) {
+          CHECK(cMo[i][j] == Approx(cMo_sequential[i][j]).margin(1e-9));
+        }
+      }
+    }
+  }
+
+  vpParallel::setNumThreads(0);
+}
+
+int main(int argc, char *argv[])
+{
+  writeModel();
+
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  vpIoTools::remove(model_filename);
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
@@ -71,7 +71,8 @@ int main()
           !vpMath::equal(me.getThreshold(), me_ref.getThreshold(), eps) ||
           !vpMath::equal(me.getMu1(), me_ref.getMu1(), eps) ||
           !vpMath::equal(me.getMu2(), me_ref.getMu2(), eps) ||
-          !vpMath::equal(me.getSampleStep(), me_ref.getSampleStep(), eps)) {
+          !vpMath::equal(me.getSampleStep(), me_ref.getSampleStep(), eps) ||
+          xml.getEdgeNbThreads() != 1) {
         std::cerr << "Issue when parsing xml: " << filename << " (ME)" << std::endl;
         return EXIT_FAILURE;
       }
@@ -56,6 +56,7 @@
 
 #include <list>
 #include <math.h>
+#include <vector>
 
 /*!
   \class vpMeEllipse
@@ -304,7 +305,7 @@ protected:
   //! Value of sin(e).
   double se;
   //! Stores the value of the \f$ alpha \f$ angle for each vpMeSite.
-  std::list<double> angle;
+  std::vector<double> angle;
   //! Surface
   double m00;
   //! Second order central moments
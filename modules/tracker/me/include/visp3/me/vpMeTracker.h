@@ -53,6 +53,7 @@
 #include <iostream>
 #include <list>
 #include <math.h>
+#include <vector>
 
 /*!
   \class vpMeTracker
@@ -61,6 +62,13 @@
   \brief Contains abstract elements for a Distance to Feature type feature.
 
   2D state = list of points, 3D state = feature
+
+  The moving edges sites are stored contiguously, in the order of the
+  feature, and accessed with getMeSites(). A site rejected by the tracking
+  stays in place with its suppression state, so that the index of each site
+  is stable until suppressPoints() removes all the rejected sites in one pass
+  that keeps the order of the remaining sites. Only the sites that leave the
+  mask are removed by the tracking sweep itself.
 */
 class VISP_EXPORT vpMeTracker : public vpTracker
 {
@@ -70,8 +78,8 @@ public:
 protected:
 #endif
   //! Tracking dependent variables/functions
-  //! List of tracked moving edges points.
-  std::list<vpMeSite> list;
+  //! Tracked moving edges points, stored contiguously.
+  std::vector<vpMeSite> list;
   //! Moving edges initialisation parameters
   vpMe *me;
   unsigned int init_range;
@@ -155,16 +163,31 @@ public:
     Set the list of moving edges
 
     \param l : list of Moving Edges.
+
+    \sa setMeSites(), getMeSites()
   */
-  void setMeList(const std::list<vpMeSite> &l) { list = l; }
+  void setMeList(const std::list<vpMeSite> &l) { list.assign(l.begin(), l.end()); }
 
   /*!
-    Return the list of moving edges
+    Set the moving edges.
 
-    \return List of Moving Edges.
+    \param sites : Moving Edges.
+  */
+  void setMeSites(const std::vector<vpMeSite> &sites) { list = sites; }
+
+  /*!
+    Return the moving edges, stored contiguously.
+
+    \return Moving Edges.
   */
-  inline std::list<vpMeSite> &getMeList() { return list; }
-  inline std::list<vpMeSite> getMeList() const { return list; }
+  inline std::vector<vpMeSite> &getMeSites() { return list; }
+
+  /*!
+    Return the moving edges, stored contiguously.
+
+    \return Moving Edges.
+  */
+  inline const std::vector<vpMeSite> &getMeSites() const { return list; }
 
   /*!
     Return the number of points that has not been suppressed.
@@ -177,6 +200,20 @@ public:
 public:
   int query_range;
   bool display_point; // if 1 (TRUE) displays the line that is being tracked
+
+  /*!
+    \deprecated The moving edges are no longer stored in a list. Use
+    getMeSites() instead, to read or modify them without a copy.
+
+    Return a const copy of the moving edges as a list. Modifying the moving
+    edges through it, for instance getMeList().clear(), does not compile.
+
+    \return List of Moving Edges.
+  */
+  vp_deprecated inline const std::list<vpMeSite> getMeList() const
+  {
+    return std::list<vpMeSite>(list.begin(), list.end());
+  }
 #endif
 };
 
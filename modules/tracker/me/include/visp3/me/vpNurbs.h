@@ -53,6 +53,7 @@
 #include <visp3/me/vpMeSite.h>
 
 #include <list>
+#include <vector>
 
 /*!
   \class vpNurbs
@@ -166,6 +167,7 @@ public:
   void globalCurveInterp(vpList<vpMeSite> &l_crossingPoints);
   void globalCurveInterp(const std::list<vpImagePoint> &l_crossingPoints);
   void globalCurveInterp(const std::list<vpMeSite> &l_crossingPoints);
+  void globalCurveInterp(const std::vector<vpMeSite> &l_crossingPoints);
   void globalCurveInterp();
 
   static void globalCurveApprox(std::vector<vpImagePoint> &l_crossingPoints, unsigned int l_p, unsigned int l_n,
@@ -174,6 +176,7 @@ public:
   void globalCurveApprox(vpList<vpMeSite> &l_crossingPoints, unsigned int n);
   void globalCurveApprox(const std::list<vpImagePoint> &l_crossingPoints, unsigned int n);
   void globalCurveApprox(const std::list<vpMeSite> &l_crossingPoints, unsigned int n);
+  void globalCurveApprox(const std::vector<vpMeSite> &l_crossingPoints, unsigned int n);
   void globalCurveApprox(unsigned int n);
 };
 
@@ -358,7 +358,7 @@ void vpMeEllipse::updateTheta()
 {
   vpMeSite p_me;
   double theta;
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     vpImagePoint iP;
     iP.set_i(p_me.ifloat);
@@ -375,18 +375,17 @@ void vpMeEllipse::updateTheta()
 */
 void vpMeEllipse::suppressPoints()
 {
-  // Loop through list of sites to track
-  std::list<vpMeSite>::iterator itList = list.begin();
-  for (std::list<double>::iterator it = angle.begin(); it != angle.end();) {
-    vpMeSite s = *itList; // current reference pixel
-    if (s.getState() != vpMeSite::NO_SUPPRESSION) {
-      itList = list.erase(itList);
-      it = angle.erase(it);
-    } else {
-      ++itList;
-      ++it;
+  // Compact the remaining sites and their angles in place, in the same order
+  size_t nbSites = 0;
+  for (size_t k = 0; k < angle.size(); k++) {
+    if (list[k].getState() == vpMeSite::NO_SUPPRESSION) {
+      list[nbSites] = list[k];
+      angle[nbSites] = angle[k];
+      nbSites++;
     }
   }
+  list.erase(list.begin() + static_cast<std::ptrdiff_t>(nbSites), list.end());
+  angle.erase(angle.begin() + static_cast<std::ptrdiff_t>(nbSites), angle.end());
 }
 
 /*!
@@ -517,9 +516,9 @@ void vpMeEllipse::setExtremities()
   double jmax = 0;
 
   // Loop through list of sites to track
-  std::list<double>::const_iterator itAngle = angle.begin();
+  std::vector<double>::const_iterator itAngle = angle.begin();
 
-  for (std::list<vpMeSite>::const_iterator itList = list.begin(); itList != list.end(); ++itList) {
+  for (std::vector<vpMeSite>::const_iterator itList = list.begin(); itList != list.end(); ++itList) {
     vpMeSite s = *itList; // current reference pixel
     double alpha = *itAngle;
     if (alpha < alphamin) {
@@ -577,7 +576,7 @@ void vpMeEllipse::leastSquare()
   vpColVector x(5);
 
   unsigned int k = 0;
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
       A[k][0] = vpMath::sqr(p_me.jfloat);
@@ -611,7 +610,7 @@ void vpMeEllipse::leastSquare()
   }
 
   k = 0;
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
       if (w[k] < thresholdWeight) {
@@ -297,7 +297,7 @@ void vpMeLine::leastSquare()
   {
     nos_1 = numberOfSignal();
     unsigned int k = 0;
-    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
         A[k][0] = p_me.ifloat;
@@ -327,7 +327,7 @@ void vpMeLine::leastSquare()
     }
 
     k = 0;
-    for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
         if (w[k] < 0.2) {
@@ -356,7 +356,7 @@ void vpMeLine::leastSquare()
   {
     nos_1 = numberOfSignal();
     unsigned int k = 0;
-    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
         A[k][0] = p_me.jfloat;
@@ -386,7 +386,7 @@ void vpMeLine::leastSquare()
     }
 
     k = 0;
-    for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
       p_me = *it;
       if (p_me.getState() == vpMeSite::NO_SUPPRESSION) {
         if (w[k] < 0.2) {
@@ -477,15 +477,13 @@ void vpMeLine::initTracking(const vpImage<unsigned char> &I, const vpImagePoint
 */
 void vpMeLine::suppressPoints()
 {
-  // Loop through list of sites to track
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();) {
-    vpMeSite s = *it; // current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION)
-      it = list.erase(it);
-    else
-      ++it;
+  // Compact the remaining sites in place, in the same order
+  size_t nbSites = 0;
+  for (size_t k = 0; k < list.size(); k++) {
+    if (list[k].getState() == vpMeSite::NO_SUPPRESSION)
+      list[nbSites++] = list[k];
   }
+  list.erase(list.begin() + static_cast<std::ptrdiff_t>(nbSites), list.end());
 }
 
 /*!
@@ -499,7 +497,7 @@ void vpMeLine::setExtremities()
   double jmax = -1;
 
   // Loop through list of sites to track
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite s = *it; // current reference pixel
     if (s.ifloat < imin) {
       imin = s.ifloat;
@@ -518,7 +516,7 @@ void vpMeLine::setExtremities()
   PExt[1].jfloat = jmax;
 
   if (fabs(imin - imax) < 25) {
-    for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+    for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
       vpMeSite s = *it; // current reference pixel
       if (s.jfloat < jmin) {
         imin = s.ifloat;
@@ -729,7 +727,7 @@ void vpMeLine::updateDelta()
 
   angle_1 = angle_;
 
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     p_me = *it;
     p_me.alpha = delta;
     p_me.mask_sign = sign;
@@ -1190,12 +1188,12 @@ void vpMeLine::display(const vpImage<vpRGBa> &I, const vpMeSite &PExt1, const vp
   \param thickness : Thickness of the line.
 */
 void vpMeLine::display(const vpImage<unsigned char> &I, const vpMeSite &PExt1, const vpMeSite &PExt2,
-                       const std::list<vpMeSite> &site_list, const double &A, const double &B, const double &C,
+                       const std::vector<vpMeSite> &site_list, const double &A, const double &B, const double &C,
                        const vpColor &color, unsigned int thickness)
 {
   vpImagePoint ip;
 
-  for (std::list<vpMeSite>::const_iterator it = site_list.begin(); it != site_list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = site_list.begin(); it != site_list.end(); ++it) {
     vpMeSite pix = *it;
     ip.set_i(pix.ifloat);
     ip.set_j(pix.jfloat);
@@ -1271,12 +1269,12 @@ void vpMeLine::display(const vpImage<unsigned char> &I, const vpMeSite &PExt1, c
   \param thickness : Thickness of the line.
 */
 void vpMeLine::display(const vpImage<vpRGBa> &I, const vpMeSite &PExt1, const vpMeSite &PExt2,
-                       const std::list<vpMeSite> &site_list, const double &A, const double &B, const double &C,
+                       const std::vector<vpMeSite> &site_list, const double &A, const double &B, const double &C,
                        const vpColor &color, unsigned int thickness)
 {
   vpImagePoint ip;
 
-  for (std::list<vpMeSite>::const_iterator it = site_list.begin(); it != site_list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = site_list.begin(); it != site_list.end(); ++it) {
     vpMeSite pix = *it;
     ip.set_i(pix.ifloat);
     ip.set_j(pix.jfloat);
@@ -1328,3 +1326,61 @@ void vpMeLine::display(const vpImage<vpRGBa> &I, const vpMeSite &PExt1, const vp
   ip1.set_j(PExt2.jfloat);
   vpDisplay::displayCross(I, ip1, 10, vpColor::green, thickness);
 }
+
+/*!
+  Display of a moving line thanks to its equation parameters and its
+  extremities with all the site list.
+
+  \param I : The image used as background.
+
+  \param PExt1 : First extrimity
+
+  \param PExt2 : Second extrimity
+
+  \param site_list : vpMeSite list
+
+  \param A : Parameter a of the line equation a*i + b*j + c = 0
+
+  \param B : Parameter b of the line equation a*i + b*j + c = 0
+
+  \param C : Parameter c of the line equation a*i + b*j + c = 0
+
+  \param color : Color used to display the line.
+
+  \param thickness : Thickness of the line.
+*/
+void vpMeLine::display(const vpImage<unsigned char> &I, const vpMeSite &PExt1, const vpMeSite &PExt2,
+                       const std::list<vpMeSite> &site_list, const double &A, const double &B, const double &C,
+                       const vpColor &color, unsigned int thickness)
+{
+  display(I, PExt1, PExt2, std::vector<vpMeSite>(site_list.begin(), site_list.end()), A, B, C, color, thickness);
+}
+
+/*!
+  Display of a moving line thanks to its equation parameters and its
+  extremities with all the site list.
+
+  \param I : The image used as background.
+
+  \param PExt1 : First extrimity
+
+  \param PExt2 : Second extrimity
+
+  \param site_list : vpMeSite list
+
+  \param A : Parameter a of the line equation a*i + b*j + c = 0
+
+  \param B : Parameter b of the line equation a*i + b*j + c = 0
+
+  \param C : Parameter c of the line equation a*i + b*j + c = 0
+
+  \param color : Color used to display the line.
+
+  \param thickness : Thickness of the line.
+*/
+void vpMeLine::display(const vpImage<vpRGBa> &I, const vpMeSite &PExt1, const vpMeSite &PExt2,
+                       const std::list<vpMeSite> &site_list, const double &A, const double &B, const double &C,
+                       const vpColor &color, unsigned int thickness)
+{
+  display(I, PExt1, PExt2, std::vector<vpMeSite>(site_list.begin(), site_list.end()), A, B, C, color, thickness);
+}
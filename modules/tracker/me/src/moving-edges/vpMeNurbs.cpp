@@ -334,14 +334,13 @@ void vpMeNurbs::sample(const vpImage<unsigned char> &I, bool doNotTrack)
 */
 void vpMeNurbs::suppressPoints()
 {
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();) {
-    vpMeSite s = *it; // current reference pixel
-
-    if (s.getState() != vpMeSite::NO_SUPPRESSION) {
-      it = list.erase(it);
-    } else
-      ++it;
+  // Compact the remaining sites in place, in the same order
+  size_t nbSites = 0;
+  for (size_t k = 0; k < list.size(); k++) {
+    if (list[k].getState() == vpMeSite::NO_SUPPRESSION)
+      list[nbSites++] = list[k];
   }
+  list.erase(list.begin() + static_cast<std::ptrdiff_t>(nbSites), list.end());
 }
 
 /*!
@@ -353,7 +352,7 @@ void vpMeNurbs::updateDelta()
   double u = 0.0;
   double d = 1e6;
   double d_1 = 1e6;
-  std::list<vpMeSite>::iterator it = list.begin();
+  std::vector<vpMeSite>::iterator it = list.begin();
 
   vpImagePoint Cu;
   vpImagePoint *der = NULL;
@@ -439,7 +438,7 @@ void vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
         P.track(I, me, false);
 
         if (P.getState() == vpMeSite::NO_SUPPRESSION) {
-          list.push_front(P);
+          list.insert(list.begin(), P);
           beginPtAdded = true;
           pt_max = pt;
           if (vpDEBUG_ENABLE(3)) {
@@ -493,7 +492,7 @@ void vpMeNurbs::seekExtremities(const vpImage<unsigned char> &I)
       endPtFound++;
     me->setRange(memory_range);
   } else {
-    list.pop_front();
+    list.erase(list.begin());
   }
   /*if(begin != NULL)*/ delete[] begin;
   /*if(end != NULL)  */ delete[] end;
@@ -598,7 +597,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     }
 
     if (findCenterPoint(&ip_edges_list)) {
-      for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end();
+      for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end();
            /*++it*/) {
         vpMeSite s = *it;
         vpImagePoint iP(s.ifloat, s.jfloat);
@@ -608,11 +607,11 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
           break;
       }
 
-      std::list<vpMeSite>::iterator itList = list.begin();
+      std::vector<vpMeSite>::iterator itList = list.begin();
       double convlt;
       double delta = 0;
       int nbr = 0;
-      std::list<vpMeSite> addedPt;
+      std::vector<vpMeSite> addedPt;
       for (std::list<vpImagePoint>::const_iterator itEdges = ip_edges_list.begin(); itEdges != ip_edges_list.end();
            ++itEdges) {
         vpMeSite s = *itList;
@@ -622,7 +621,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
         dist = vpMeSite::sqrDistance(s, pix);
         if (dist >= vpMath::sqr(me->getSampleStep()) /*25*/) {
           bool exist = false;
-          for (std::list<vpMeSite>::const_iterator itAdd = addedPt.begin(); itAdd != addedPt.end(); ++itAdd) {
+          for (std::vector<vpMeSite>::const_iterator itAdd = addedPt.begin(); itAdd != addedPt.end(); ++itAdd) {
             dist = vpMeSite::sqrDistance(pix, *itAdd);
             if (dist < vpMath::sqr(me->getSampleStep()) /*25*/)
               exist = true;
@@ -631,10 +630,10 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
             findAngle(I, iPtemp, me, delta, convlt);
             pix.init(iPtemp.get_i(), iPtemp.get_j(), delta, convlt);
             pix.setDisplay(selectDisplay);
-            --itList;
-            list.insert(itList, pix);
+            // Insert before the first site kept, after the sites already added
+            itList = list.insert(itList, pix);
             ++itList;
-            addedPt.push_front(pix);
+            addedPt.push_back(pix);
             nbr++;
           }
         }
@@ -642,7 +641,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2 = list.begin();
+      std::vector<vpMeSite>::iterator itList2 = list.begin();
       for (int j = 0; j < nbr; j++) {
         vpMeSite s = *itList2;
         s.track(I, me, false);
@@ -737,33 +736,33 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
     if (findCenterPoint(&ip_edges_list)) {
       //      list.end();
       vpMeSite s;
-      while (true) //{//!list.outside())
+      while (!list.empty()) //{//!list.outside())
       {
         s = list.back(); // list.value() ;
         vpImagePoint iP(s.ifloat, s.jfloat);
         if (inRectangle(iP, rect)) {
-          list.erase(list.end());
+          list.pop_back();
           //          list.end();
         } else
           break;
       }
 
-      std::list<vpMeSite>::iterator itList = list.end();
-      --itList; // Move on the last element
+      // The sites are added at the end: keep the index of the last site
+      const size_t lastIndex = list.size() - 1;
       double convlt;
       double delta;
       int nbr = 0;
-      std::list<vpMeSite> addedPt;
+      std::vector<vpMeSite> addedPt;
       for (std::list<vpImagePoint>::const_iterator itEdges = ip_edges_list.begin(); itEdges != ip_edges_list.end();
            ++itEdges) {
-        s = *itList;
+        s = list[lastIndex];
         vpImagePoint iPtemp = *itEdges + topLeft;
         vpMeSite pix;
         pix.init(iPtemp.get_i(), iPtemp.get_j(), 0);
         dist = vpMeSite::sqrDistance(s, pix);
         if (dist >= vpMath::sqr(me->getSampleStep())) {
           bool exist = false;
-          for (std::list<vpMeSite>::const_iterator itAdd = addedPt.begin(); itAdd != addedPt.end(); ++itAdd) {
+          for (std::vector<vpMeSite>::const_iterator itAdd = addedPt.begin(); itAdd != addedPt.end(); ++itAdd) {
             dist = vpMeSite::sqrDistance(pix, *itAdd);
             if (dist < vpMath::sqr(me->getSampleStep()))
               exist = true;
@@ -781,7 +780,7 @@ void vpMeNurbs::seekExtremitiesCanny(const vpImage<unsigned char> & /* I */)
 
       unsigned int memory_range = me->getRange();
       me->setRange(3);
-      std::list<vpMeSite>::iterator itList2 = list.end();
+      std::vector<vpMeSite>::iterator itList2 = list.end();
       --itList2; // Move to the last element
       for (int j = 0; j < nbr; j++) {
         vpMeSite me_s = *itList2;
@@ -836,17 +835,15 @@ void vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
 
   int n = (int)numberOfSignal();
 
-  //  list.front();
-  std::list<vpMeSite>::iterator it = list.begin();
-  std::list<vpMeSite>::iterator itNext = list.begin();
-  ++itNext;
-
   unsigned int range_tmp = me->getRange();
   me->setRange(2);
 
-  while (itNext != list.end() && n <= me->getPointsToTrack()) {
-    vpMeSite s = *it;          // current reference pixel
-    vpMeSite s_next = *itNext; // current reference pixel
+  // The sites are accessed by index since the insertions invalidate the
+  // iterators
+  size_t k = 0;
+  while (k + 1 < list.size() && n <= me->getPointsToTrack()) {
+    vpMeSite s = list[k];          // current reference pixel
+    vpMeSite s_next = list[k + 1]; // current reference pixel
 
     double d = vpMeSite::sqrDistance(s, s_next);
     if (d > 4 * vpMath::sqr(me->getSampleStep()) && d < 1600) {
@@ -896,7 +893,8 @@ void vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
             pix.setDisplay(selectDisplay);
             pix.track(I, me, false);
             if (pix.getState() == vpMeSite::NO_SUPPRESSION) {
-              list.insert(it, pix);
+              list.insert(list.begin() + static_cast<std::ptrdiff_t>(k), pix);
+              k++;
               iP_1 = iP[0];
             }
           }
@@ -907,8 +905,7 @@ void vpMeNurbs::localReSample(const vpImage<unsigned char> &I)
         }
       }
     }
-    ++it;
-    ++itNext;
+    k++;
   }
   me->setRange(range_tmp);
 }
@@ -940,8 +937,8 @@ void vpMeNurbs::supressNearPoints()
       list.next() ;
   }
 #endif
-  std::list<vpMeSite>::const_iterator it = list.begin();
-  std::list<vpMeSite>::iterator itNext = list.begin();
+  std::vector<vpMeSite>::const_iterator it = list.begin();
+  std::vector<vpMeSite>::iterator itNext = list.begin();
   ++itNext;
   for (; itNext != list.end();) {
     vpMeSite s = *it;          // current reference pixel
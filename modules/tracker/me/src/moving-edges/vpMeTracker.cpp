@@ -182,7 +182,7 @@ void vpMeTracker::initTracking(const vpImage<unsigned char> &I)
   int d = 0;
 
   // Loop through list of sites to track
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite refp = *it; // current reference pixel
 
     d++;
@@ -261,10 +261,11 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
 
   nGoodElement = 0;
 
-  // Loop through list of sites to track
-  std::list<vpMeSite>::iterator it = list.begin();
-  while (it != list.end()) {
-    vpMeSite s = *it; // current reference pixel
+  // Loop through list of sites to track. The sites that leave the mask are
+  // removed by compacting the remaining sites in place, in the same order.
+  size_t nbSites = 0;
+  for (size_t k = 0; k < list.size(); k++) {
+    vpMeSite s = list[k]; // current reference pixel
 
     // If element hasn't been suppressed
     if (s.getState() == vpMeSite::NO_SUPPRESSION) {
@@ -294,18 +295,15 @@ void vpMeTracker::track(const vpImage<unsigned char> &I)
           }
 #endif
         }
-        *it = s;
-        ++it;
-      }
-      else {
-        // Site outside mask: it is no more tracked.
-        it = list.erase(it);
+        list[nbSites++] = s;
       }
+      // Otherwise the site is outside the mask: it is no more tracked.
     }
     else {
-      ++it;
+      list[nbSites++] = s;
     }
   }
+  list.erase(list.begin() + static_cast<std::ptrdiff_t>(nbSites), list.end());
 }
 
 /*!
@@ -331,7 +329,7 @@ void vpMeTracker::display(const vpImage<unsigned char> &I)
     std::cout << " There are " << list.size() << " sites in the list " << std::endl;
   }
 #endif
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite p_me = *it;
     p_me.display(I);
   }
@@ -339,7 +337,7 @@ void vpMeTracker::display(const vpImage<unsigned char> &I)
 
 void vpMeTracker::display(const vpImage<vpRGBa> &I)
 {
-  for (std::list<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::const_iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite p_me = *it;
     p_me.display(I);
   }
@@ -353,7 +351,7 @@ void vpMeTracker::display(const vpImage<vpRGBa> &I)
 */
 void vpMeTracker::display(const vpImage<unsigned char> &I, vpColVector &w, unsigned int &index_w)
 {
-  for (std::list<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
+  for (std::vector<vpMeSite>::iterator it = list.begin(); it != list.end(); ++it) {
     vpMeSite P = *it;
 
     if (P.getState() == vpMeSite::NO_SUPPRESSION) {
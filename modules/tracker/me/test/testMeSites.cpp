@@ -0,0 +1,225 @@
+/****************************************************************************
+ *
+ * ViSP, open source Visual Servoing Platform software.
+ * Copyright (C) 2005 - 2019 by Inria. All rights reserved.
+ *
+ * This software is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ * See the file LICENSE.txt at the root directory of this source
+ * distribution for additional information about the GNU GPL.
+ *
+ * For using ViSP with software that can not be combined with the GNU
+ * GPL, please contact Inria about acquiring a ViSP Professional
+ * Edition License.
+ *
+ * See http://visp.inria.fr for more information.
+ *
+ * This software was developed at:
+ * Inria Rennes - Bretagne Atlantique
+ * Campus Universitaire de Beaulieu
+ * 35042 Rennes Cedex
+ * France
+ *
+ * If you have questions regarding the use of this file, please contact
+ * Inria at visp@inria.fr
+ *
+ * This file is provided AS IS with NO WARRANTY OF ANY KIND, INCLUDING THE
+ * WARRANTY OF DESIGN, MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE.
+ * Description:
+ * Test the moving edges sites of the line and Nurbs trackers on synthetic
+ * images.
+ *
+ *****************************************************************************/
+
+/*!
+  \example testMeSites.cpp
+
+  \brief Track a line and a Nurbs on synthetic images and check the moving
+  edges sites: suppressed sites keep their index until suppressPoints()
+  removes them, in one pass that keeps the order of the remaining sites.
+*/
+
+#include <visp3/core/vpConfig.h>
+
+#if defined(VISP_HAVE_CATCH2) && (defined(VISP_HAVE_LAPACK) || defined(VISP_HAVE_EIGEN3) || defined(VISP_HAVE_OPENCV))
+#define CATCH_CONFIG_RUNNER
+#include <catch.hpp>
+
+#include <cmath>
+
+#include <visp3/core/vpImage.h>
+#include <visp3/core/vpImagePoint.h>
+#include <visp3/me/vpMeLine.h>
+#include <visp3/me/vpMeNurbs.h>
+
+namespace
+{
+const unsigned int height = 240, width = 320;
+
+// Column of the edge of the tilted half plane at row i
+double edgeColumn(double i, double shift) { return 100 + 0.3 * i + shift; }
+
+void renderTiltedEdge(vpImage<unsigned char> &I, double shift)
+{
+  I.resize(height, width);
+  for (unsigned int i = 0; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = j < edgeColumn(i, shift) ? 30 : 200;
+    }
+  }
+}
+
+void renderHorizontalEdge(vpImage<unsigned char> &I, unsigned int row)
+{
+  I.resize(height, width, 0);
+  for (unsigned int i = row; i < height; i++) {
+    for (unsigned int j = 0; j < width; j++) {
+      I[i][j] = 255;
+    }
+  }
+}
+
+void initMe(vpMe &me)
+{
+  me.setRange(10);
+  me.setThreshold(15000);
+  me.setSampleStep(10);
+  me.setPointsToTrack(20);
+}
+
+/*
+  Turn some sites into tombstones, check that they keep their index until
+  suppressPoints() and that suppressPoints() keeps the remaining sites in order.
+*/
+template <class Tracker> void checkSuppressPoints(Tracker &tracker)
+{
+  std::vector<vpMeSite> &sites = tracker.getMeSites();
+  const size_t nbSites = sites.size();
+  REQUIRE(nbSites > 6);
+
+  std::vector<vpMeSite> remaining;
+  for (size_t k = 0; k < nbSites; k++) {
+    if (k % 3 == 1) {
+      sites[k].setState(vpMeSite::THRESHOLD);
+    } else if (k % 3 == 2 && k < nbSites / 2) {
+      sites[k].setState(vpMeSite::CONSTRAST);
+    } else {
+      remaining.push_back(sites[k]);
+    }
+  }
+
+  // Before suppressPoints() the suppressed sites stay in place with their state
+  CHECK(tracker.getMeSites().size() == nbSites);
+  CHECK(tracker.totalNumberOfSignal() == nbSites);
+  CHECK(tracker.numberOfSignal() == remaining.size());
+  for (size_t k = 0; k < nbSites; k++) {
+    vpMeSite::vpMeSiteState expected = vpMeSite::NO_SUPPRESSION;
+    if (k % 3 == 1) {
+      expected = vpMeSite::THRESHOLD;
+    } else if (k % 3 == 2 && k < nbSites / 2) {
+      expected = vpMeSite::CONSTRAST;
+    }
+    CHECK(tracker.getMeSites()[k].getState() == expected);
+  }
+
+  tracker.suppressPoints();
+
+  const std::vector<vpMeSite> &compacted = tracker.getMeSites();
+  REQUIRE(compacted.size() == remaining.size());
+  CHECK(tracker.numberOfSignal() == remaining.size());
+  for (size_t k = 0; k < compacted.size(); k++) {
+    CHECK(compacted[k].getState() == vpMeSite::NO_SUPPRESSION);
+    CHECK(compacted[k].get_i() == remaining[k].get_i());
+    CHECK(compacted[k].get_j() == remaining[k].get_j());
+  }
+}
+} // namespace
+
+TEST_CASE("Moving edges sites of a tracked line", "[me]")
+{
+  vpImage<unsigned char> I;
+  renderTiltedEdge(I, 0);
+
+  vpMe me;
+  initMe(me);
+  vpMeLine line;
+  line.setMe(&me);
+  line.initTracking(I, vpImagePoint(40, edgeColumn(40, 0)), vpImagePoint(200, edgeColumn(200, 0)));
+
+  // The edge moves by one pixel per image
+  for (int iter = 1; iter <= 5; iter++) {
+    renderTiltedEdge(I, iter);
+    line.track(I);
+
+    INFO("Image " << iter);
+    const std::vector<vpMeSite> &sites = line.getMeSites();
+    REQUIRE(sites.size() > 10);
+    CHECK(line.numberOfSignal() == sites.size());
+    for (size_t k = 0; k < sites.size(); k++) {
+      CHECK(sites[k].getState() == vpMeSite::NO_SUPPRESSION);
+      CHECK(std::fabs(sites[k].get_j() - edgeColumn(sites[k].get_i(), iter)) < 2);
+    }
+  }
+
+  checkSuppressPoints(line);
+
+  // The line is still tracked from the remaining sites
+  renderTiltedEdge(I, 6);
+  line.track(I);
+  CHECK(line.getMeSites().size() > 10);
+  CHECK(line.numberOfSignal() == line.getMeSites().size());
+}
+
+TEST_CASE("Moving edges sites of a tracked Nurbs", "[me]")
+{
+  vpImage<unsigned char> I;
+  renderHorizontalEdge(I, 100);
+
+  vpMe me;
+  initMe(me);
+  vpMeNurbs meNurbs;
+  meNurbs.setNbControlPoints(4);
+  meNurbs.setMe(&me);
+
+  std::list<vpImagePoint> ipList;
+  ipList.push_back(vpImagePoint(100, 60));
+  ipList.push_back(vpImagePoint(100, 120));
+  ipList.push_back(vpImagePoint(100, 180));
+  ipList.push_back(vpImagePoint(100, 240));
+  meNurbs.initTracking(I, ipList);
+
+  for (unsigned int iter = 1; iter <= 5; iter++) {
+    renderHorizontalEdge(I, 100 + iter);
+    meNurbs.track(I);
+
+    INFO("Image " << iter);
+    const std::vector<vpMeSite> &sites = meNurbs.getMeSites();
+    REQUIRE(sites.size() > 6);
+    for (size_t k = 0; k < sites.size(); k++) {
+      CHECK(sites[k].getState() == vpMeSite::NO_SUPPRESSION);
+      CHECK(std::abs(sites[k].get_i() - static_cast<int>(100 + iter)) <= 1);
+    }
+  }
+
+  checkSuppressPoints(meNurbs);
+}
+
+int main(int argc, char *argv[])
+{
+  Catch::Session session; // There must be exactly one instance
+
+  // Let Catch (using Clara) parse the command line
+  session.applyCommandLine(argc, argv);
+
+  int numFailed = session.run();
+
+  // numFailed is clamped to 255 as some unices only use the lower 8 bits.
+  // This clamping has already been applied, so just return it here
+  // You can also do any post run clean-up here
+  return numFailed;
+}
+#else
+int main() { return 0; }
+#endif
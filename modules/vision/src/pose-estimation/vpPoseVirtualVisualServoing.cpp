@@ -42,6 +42,7 @@
 */
 
 #include <visp3/core/vpExponentialMap.h>
+#include <visp3/core/vpMatrixWorkspace.h>
 #include <visp3/core/vpPoint.h>
 #include <visp3/core/vpRobust.h>
 #include <visp3/vision/vpPose.h>
@@ -70,6 +71,11 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
     vpColVector sd(2 * nb), s(2 * nb);
     vpColVector v;
 
+    // To avoid memory allocations at each iteration
+    vpMatrix Lp;
+    vpMatrixWorkspace workspace;
+    vpHomogeneousMatrix dMo;
+
     vpPoint P;
     std::list<vpPoint> lP;
 
@@ -118,23 +124,25 @@ void vpPose::poseVirtualVS(vpHomogeneousMatrix &cMo)
 
         k += 1;
       }
-      err = s - sd;
+      vpMatrix::sub2Matrices(s, sd, err);
 
       // compute the residual
       r = err.sumSquare();
 
       // compute the pseudo inverse of the interaction matrix
-      vpMatrix Lp;
-      L.pseudoInverse(Lp, 1e-16);
+      L.pseudoInverse(Lp, workspace, 1e-16);
 
       // compute the VVS control law
-      v = -lambda * Lp * err;
+      vpMatrix::multMatrixVector(Lp, err, v);
+      v *= -lambda;
 
       // std::cout << "r=" << r <<std::endl ;
       // update the pose
 
       cMoPrev = cMo;
-      cMo = vpExponentialMap::direct(v).inverse() * cMo;
+      vpExponentialMap::direct(v, 1.0, dMo);
+      dMo.inverse(cMo);
+      cMo *= cMoPrev;
 
       if (iter++ > vvsIterMax) {
         break;
@@ -47,6 +47,7 @@
 
 #include <visp3/core/vpColVector.h>
 #include <visp3/core/vpMatrix.h>
+#include <visp3/core/vpMatrixFixed.h>
 
 // Display Issue
 
@@ -144,6 +145,31 @@ public:
 protected:
   void resetFlags();
 
+  /*!
+    Copy in \e L the rows of the complete interaction matrix \e Lfull that are
+    selected in \e select, row \e i being selected by FEATURE_LINE[i]. The
+    interaction matrix is computed on the stack and \e L is allocated only once.
+  */
+  template <unsigned int N>
+  static void selectInteraction(const vpMatrixFixed<N, 6> &Lfull, unsigned int select, vpMatrix &L)
+  {
+    unsigned int nrows = 0;
+    for (unsigned int i = 0; i < N; i++) {
+      if (FEATURE_LINE[i] & select) {
+        nrows++;
+      }
+    }
+    L.resize(nrows, 6, false, false);
+    for (unsigned int i = 0, r = 0; i < N; i++) {
+      if (FEATURE_LINE[i] & select) {
+        for (unsigned int j = 0; j < 6; j++) {
+          L[r][j] = Lfull[i][j];
+        }
+        r++;
+      }
+    }
+  }
+
 protected:
   vpBasicFeatureDeallocatorType deallocate;
 };
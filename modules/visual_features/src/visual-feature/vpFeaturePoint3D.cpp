@@ -231,8 +231,6 @@ vpMatrix vpFeaturePoint3D::interaction(unsigned int select)
 {
   vpMatrix L;
 
-  L.resize(0, 6);
-
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
       if (flags[i] == false) {
@@ -261,46 +259,21 @@ vpMatrix vpFeaturePoint3D::interaction(unsigned int select)
   double Y = get_Y();
   double Z = get_Z();
 
-  if (vpFeaturePoint3D::selectX() & select) {
-    vpMatrix Lx(1, 6);
-    Lx = 0;
-
-    Lx[0][0] = -1;
-    Lx[0][1] = 0;
-    Lx[0][2] = 0;
-    Lx[0][3] = 0;
-    Lx[0][4] = -Z;
-    Lx[0][5] = Y;
+  vpMatrixFixed<3, 6> Lxyz;
 
-    L = vpMatrix::stack(L, Lx);
-  }
+  Lxyz[0][0] = -1;
+  Lxyz[0][4] = -Z;
+  Lxyz[0][5] = Y;
 
-  if (vpFeaturePoint3D::selectY() & select) {
-    vpMatrix Ly(1, 6);
-    Ly = 0;
+  Lxyz[1][1] = -1;
+  Lxyz[1][3] = Z;
+  Lxyz[1][5] = -X;
 
-    Ly[0][0] = 0;
-    Ly[0][1] = -1;
-    Ly[0][2] = 0;
-    Ly[0][3] = Z;
-    Ly[0][4] = 0;
-    Ly[0][5] = -X;
+  Lxyz[2][2] = -1;
+  Lxyz[2][3] = -Y;
+  Lxyz[2][4] = X;
 
-    L = vpMatrix::stack(L, Ly);
-  }
-  if (vpFeaturePoint3D::selectZ() & select) {
-    vpMatrix Lz(1, 6);
-    Lz = 0;
-
-    Lz[0][0] = 0;
-    Lz[0][1] = 0;
-    Lz[0][2] = -1;
-    Lz[0][3] = -Y;
-    Lz[0][4] = X;
-    Lz[0][5] = 0;
-
-    L = vpMatrix::stack(L, Lz);
-  }
+  selectInteraction(Lxyz, select, L);
   return L;
 }
 
@@ -407,9 +407,7 @@ double vpFeatureThetaU::get_TUz() const { return s[2]; }
 */
 vpMatrix vpFeatureThetaU::interaction(unsigned int select)
 {
-
   vpMatrix L;
-  L.resize(0, 6);
 
   if (deallocate == vpBasicFeature::user) {
     for (unsigned int i = 0; i < nbParameters; i++) {
@@ -436,25 +434,27 @@ vpMatrix vpFeatureThetaU::interaction(unsigned int select)
   }
 
   // Lw computed using Lw = [theta/2 u]_x +/- (I + alpha [u]_x [u]_x)
-  vpColVector u(3);
-  for (unsigned int i = 0; i < 3; i++) {
-    u[i] = s[i] / 2.0;
-  }
-
-  vpMatrix Lw(3, 3);
-  Lw = vpColVector::skew(u); /* [theta/2  u]_x */
-
-  vpMatrix U2(3, 3);
+  vpMatrixFixed<3, 3> Lw; /* [theta/2  u]_x */
+  Lw[0][1] = -s[2] / 2.0;
+  Lw[0][2] = s[1] / 2.0;
+  Lw[1][0] = s[2] / 2.0;
+  Lw[1][2] = -s[0] / 2.0;
+  Lw[2][0] = -s[1] / 2.0;
+  Lw[2][1] = s[0] / 2.0;
+
+  vpMatrixFixed<3, 3> U2;
   U2.eye();
 
   double theta = sqrt(s.sumSquare());
   if (theta >= 1e-6) {
-    for (unsigned int i = 0; i < 3; i++)
-      u[i] = s[i] / theta;
-
-    vpMatrix skew_u;
-    skew_u = vpColVector::skew(u);
-    U2 += (1 - vpMath::sinc(theta) / vpMath::sqr(vpMath::sinc(theta / 2.0))) * skew_u * skew_u;
+    vpMatrixFixed<3, 3> skew_u;
+    skew_u[0][1] = -s[2] / theta;
+    skew_u[0][2] = s[1] / theta;
+    skew_u[1][0] = s[2] / theta;
+    skew_u[1][2] = -s[0] / theta;
+    skew_u[2][0] = -s[1] / theta;
+    skew_u[2][1] = s[0] / theta;
+    U2 += (skew_u * skew_u) * (1 - vpMath::sinc(theta) / vpMath::sqr(vpMath::sinc(theta / 2.0)));
   }
 
   if (rotation == cdRc) {
@@ -464,41 +464,14 @@ vpMatrix vpFeatureThetaU::interaction(unsigned int select)
   }
 
   // This version is a simplification
-  if (vpFeatureThetaU::selectTUx() & select) {
-    vpMatrix Lx(1, 6);
-
-    Lx[0][0] = 0;
-    Lx[0][1] = 0;
-    Lx[0][2] = 0;
-    for (int i = 0; i < 3; i++)
-      Lx[0][i + 3] = Lw[0][i];
-
-    L = vpMatrix::stack(L, Lx);
-  }
-
-  if (vpFeatureThetaU::selectTUy() & select) {
-    vpMatrix Ly(1, 6);
-
-    Ly[0][0] = 0;
-    Ly[0][1] = 0;
-    Ly[0][2] = 0;
-    for (int i = 0; i < 3; i++)
-      Ly[0][i + 3] = Lw[1][i];
-
-    L = vpMatrix::stack(L, Ly);
+  vpMatrixFixed<3, 6> Lxyz;
+  for (unsigned int i = 0; i < 3; i++) {
+    for (unsigned int j = 0; j < 3; j++) {
+      Lxyz[i][j + 3] = Lw[i][j];
+    }
   }
 
-  if (vpFeatureThetaU::selectTUz() & select) {
-    vpMatrix Lz(1, 6);
-
-    Lz[0][0] = 0;
-    Lz[0][1] = 0;
-    Lz[0][2] = 0;
-    for (int i = 0; i < 3; i++)
-      Lz[0][i + 3] = Lw[2][i];
-
-    L = vpMatrix::stack(L, Lz);
-  }
+  selectInteraction(Lxyz, select, L);
 
   return L;
 }
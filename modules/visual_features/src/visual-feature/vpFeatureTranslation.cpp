@@ -301,7 +301,6 @@ double vpFeatureTranslation::get_Tz() const { return s[2]; }
 */
 vpMatrix vpFeatureTranslation::interaction(unsigned int select)
 {
-
   vpMatrix L;
   L.resize(0, 6);
 
@@ -321,120 +320,32 @@ vpMatrix vpFeatureTranslation::interaction(unsigned int select)
     resetFlags();
   }
 
+  vpMatrixFixed<3, 6> Lt;
+
   if (translation == cdMc) {
     // This version is a simplification
-    if (vpFeatureTranslation::selectTx() & select) {
-      vpMatrix Lx(1, 6);
-
-      for (int i = 0; i < 3; i++)
-        Lx[0][i] = f2Mf1[0][i];
-      Lx[0][3] = 0;
-      Lx[0][4] = 0;
-      Lx[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lx);
-    }
-
-    if (vpFeatureTranslation::selectTy() & select) {
-      vpMatrix Ly(1, 6);
-
-      for (int i = 0; i < 3; i++)
-        Ly[0][i] = f2Mf1[1][i];
-      Ly[0][3] = 0;
-      Ly[0][4] = 0;
-      Ly[0][5] = 0;
-
-      L = vpMatrix::stack(L, Ly);
-    }
-
-    if (vpFeatureTranslation::selectTz() & select) {
-      vpMatrix Lz(1, 6);
-
-      for (int i = 0; i < 3; i++)
-        Lz[0][i] = f2Mf1[2][i];
-      Lz[0][3] = 0;
-      Lz[0][4] = 0;
-      Lz[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lz);
+    for (unsigned int i = 0; i < 3; i++) {
+      for (unsigned int j = 0; j < 3; j++) {
+        Lt[i][j] = f2Mf1[i][j];
+      }
     }
   }
-  if (translation == cMcd) {
+  if (translation == cMcd || translation == cMo) {
     // This version is a simplification
-    if (vpFeatureTranslation::selectTx() & select) {
-      vpMatrix Lx(1, 6);
-      Lx[0][0] = -1;
-      Lx[0][1] = 0;
-      Lx[0][2] = 0;
-      Lx[0][3] = 0;
-      Lx[0][4] = -s[2];
-      Lx[0][5] = s[1];
-
-      L = vpMatrix::stack(L, Lx);
-    }
+    Lt[0][0] = -1;
+    Lt[0][4] = -s[2];
+    Lt[0][5] = s[1];
 
-    if (vpFeatureTranslation::selectTy() & select) {
-      vpMatrix Ly(1, 6);
-      Ly[0][0] = 0;
-      Ly[0][1] = -1;
-      Ly[0][2] = 0;
-      Ly[0][3] = s[2];
-      Ly[0][4] = 0;
-      Ly[0][5] = -s[0];
+    Lt[1][1] = -1;
+    Lt[1][3] = s[2];
+    Lt[1][5] = -s[0];
 
-      L = vpMatrix::stack(L, Ly);
-    }
-
-    if (vpFeatureTranslation::selectTz() & select) {
-      vpMatrix Lz(1, 6);
-      Lz[0][0] = 0;
-      Lz[0][1] = 0;
-      Lz[0][2] = -1;
-      Lz[0][3] = -s[1];
-      Lz[0][4] = s[0];
-      Lz[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lz);
-    }
+    Lt[2][2] = -1;
+    Lt[2][3] = -s[1];
+    Lt[2][4] = s[0];
   }
-
-  if (translation == cMo) {
-    // This version is a simplification
-    if (vpFeatureTranslation::selectTx() & select) {
-      vpMatrix Lx(1, 6);
-      Lx[0][0] = -1;
-      Lx[0][1] = 0;
-      Lx[0][2] = 0;
-      Lx[0][3] = 0;
-      Lx[0][4] = -s[2];
-      Lx[0][5] = s[1];
-
-      L = vpMatrix::stack(L, Lx);
-    }
-
-    if (vpFeatureTranslation::selectTy() & select) {
-      vpMatrix Ly(1, 6);
-      Ly[0][0] = 0;
-      Ly[0][1] = -1;
-      Ly[0][2] = 0;
-      Ly[0][3] = s[2];
-      Ly[0][4] = 0;
-      Ly[0][5] = -s[0];
-
-      L = vpMatrix::stack(L, Ly);
-    }
-
-    if (vpFeatureTranslation::selectTz() & select) {
-      vpMatrix Lz(1, 6);
-      Lz[0][0] = 0;
-      Lz[0][1] = 0;
-      Lz[0][2] = -1;
-      Lz[0][3] = -s[1];
-      Lz[0][4] = s[0];
-      Lz[0][5] = 0;
-
-      L = vpMatrix::stack(L, Lz);
-    }
+  if (translation == cdMc || translation == cMcd || translation == cMo) {
+    selectInteraction(Lt, select, L);
   }
 
   return L;